@@ -13,6 +13,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 15,	2019	<MLS> Moved Json code to JsonResponse.c
 //*	Apr 15,	2019	<MLS> Change to send directly to the socket instead of memory buffer
@@ -47,6 +48,9 @@
 //*	May 15,	2024	<MLS> Added JsonResponse_Add_Uint32()
 //*	May 17,	2024	<MLS> Added httpRetCode to JsonResponse_FinishHeader()
 //*	May 17,	2024	<MLS> Added httpRetCode to JsonResponse_Add_Finish()
+//*	Oct 18,	2026	<AGT> Added JsonResponse_SetKeepAlive() & JsonResponse_ResponseWasFramed()
+//*	Oct 18,	2026	<AGT> JsonResponse_FinishHeader() now does HTTP/1.1 keep-alive when requested
+//*	Oct 18,	2026	<AGT> Added JsonResponse_SetCaptureBuffer() for the static response cache
 //*****************************************************************************
 
 
@@ -88,6 +92,49 @@
 #include 	"JsonDefs.h"
 #include	"JsonResponse.h"
 
+//*****************************************************************************
+//*	keep-alive state for the request being processed by this thread.
+//*	A response can only be kept alive if the header has the correct Content-Length,
+//*	i.e. nothing was transmitted before the header was built.
+static	__thread	bool	gKeepAliveRequested		=	false;
+static	__thread	bool	gPartialXmitDone		=	false;
+static	__thread	bool	gResponseWasFramed		=	false;
+
+//*	if set, JsonResponse_Add_Finish() saves a copy of the json body here
+static	__thread	char	*gCaptureBuffer			=	NULL;
+static	__thread	int		gCaptureBufferLen		=	0;
+
+//*****************************************************************************
+//*	called at the start of each request
+//*****************************************************************************
+void	JsonResponse_SetKeepAlive(const bool keepAlive)
+{
+	gKeepAliveRequested	=	keepAlive;
+	gPartialXmitDone	=	false;
+	gResponseWasFramed	=	false;
+}
+
+//*****************************************************************************
+//*	the next call to JsonResponse_Add_Finish() on this thread copies the json body
+//*	into captureBuffer. If it does not fit, or part of it has already been sent,
+//*	captureBuffer is returned empty. Pass NULL to cancel.
+//*****************************************************************************
+void	JsonResponse_SetCaptureBuffer(char *captureBuffer, const int captureBufferLen)
+{
+	gCaptureBuffer		=	captureBuffer;
+	gCaptureBufferLen	=	captureBufferLen;
+	if (gCaptureBuffer != NULL)
+	{
+		gCaptureBuffer[0]	=	0;
+	}
+}
+
+//*****************************************************************************
+bool	JsonResponse_ResponseWasFramed(void)
+{
+	return(gResponseWasFramed);
+}
+
 
 //*****************************************************************************
 void	JsonResponse_CreateHeader(char *jsonTextBuffer)
@@ -111,14 +158,16 @@ char	lineBuff[64];
 	{
 		contentLen	=	strlen(jsonTextBuffer);
 #ifdef _INCLUDE_HTTP_HEADER_
+		//*	an empty buffer means the data is going to be streamed after the header
+		gResponseWasFramed	=	(gKeepAliveRequested && (contentLen > 0) && (gPartialXmitDone == false));
 		jsonHdrBUffer[0]	=	0;
 		if (httpRetCode == 200)
 		{
-			strcpy(lineBuff,	"HTTP/1.0 200 OK\r\n");
+			strcpy(lineBuff,	(gResponseWasFramed ? "HTTP/1.1 200 OK\r\n" : "HTTP/1.0 200 OK\r\n"));
 		}
 		else
 		{
-			sprintf(lineBuff, "HTTP/1.0 %d BadRequest\r\n", httpRetCode);
+			sprintf(lineBuff, "%s %d BadRequest\r\n", (gResponseWasFramed ? "HTTP/1.1" : "HTTP/1.0"), httpRetCode);
 		}
 		strcat(jsonHdrBUffer,	lineBuff);
 		if (contentLen > 0)
@@ -126,6 +175,14 @@ char	lineBuff[64];
 			sprintf(lineBuff,		"Content-Length: %d\r\n", contentLen);
 			strcat(jsonHdrBUffer,	lineBuff);
 		}
+		if (gResponseWasFramed)
+		{
+			strcat(jsonHdrBUffer,	"Connection: keep-alive\r\n");
+		}
+		else if (gKeepAliveRequested)
+		{
+			strcat(jsonHdrBUffer,	"Connection: close\r\n");
+		}
 		else
 		{
 		//	sprintf(lineBuff,		"Content-Length: %d\r\n", -1);
@@ -165,7 +222,8 @@ int		bytesWritten	=	0;
 				CONSOLE_DEBUG_W_NUM("len of jsonTextBuffer\t=", strlen(jsonTextBuffer));
 			}
 			//*	transmit the packet and reset
-			bytesWritten	=	write(socketFD, jsonTextBuffer, bufLen);
+			bytesWritten		=	write(socketFD, jsonTextBuffer, bufLen);
+			gPartialXmitDone	=	true;
 		//	CONSOLE_DEBUG(__FUNCTION__);
 			if (bytesWritten < 0)
 			{
@@ -623,6 +681,15 @@ int		bytesWritten	=	0;
 	if (jsonTextBuffer != NULL)
 	{
 		fullDataBuffer[0]	=	0;
+		if (gCaptureBuffer != NULL)
+		{
+			if ((gPartialXmitDone == false) && (strlen(jsonTextBuffer) < (size_t)gCaptureBufferLen))
+			{
+				strcpy(gCaptureBuffer, jsonTextBuffer);
+			}
+			gCaptureBuffer		=	NULL;
+			gCaptureBufferLen	=	0;
+		}
 		strcat(jsonTextBuffer, "}\r\n");
 
 		if (strlen(jsonTextBuffer) >= sizeof(fullDataBuffer))
@@ -100,6 +100,13 @@ int		JsonResponse_Add_RawText(	const int		socketFD,
 int		JsonResponse_SendTextBuffer(const int		socketFD,
 									char			*jsonTextBuffer);
 
+//*	HTTP/1.1 keep-alive, per thread
+void	JsonResponse_SetKeepAlive(const bool keepAlive);
+bool	JsonResponse_ResponseWasFramed(void);
+
+//*	static response cache, per thread
+void	JsonResponse_SetCaptureBuffer(char *captureBuffer, const int captureBufferLen);
+
 #define	INCLUDE_COMMA	true
 #define	NO_COMMA		false
 
@@ -13,11 +13,13 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Sep  5,	2021	<MLS> Added httpCmdString to TYPE_GetPutRequestData struct
 //*	Nov 29,	2022	<MLS> Added httpUserAgent to TYPE_GetPutRequestData struct
 //*	Nov 29,	2022	<MLS> Added clientIs_xxx  to TYPE_GetPutRequestData struct
 //*	May 17,	2024	<MLS> Added httpRetCode to TYPE_GetPutRequestData struct
+//*	Oct 18,	2026	<AGT> Added argIndex to TYPE_GetPutRequestData struct
 //*****************************************************************************
 //#include	"RequestData.h"
 
@@ -57,6 +59,27 @@ typedef enum
 } TYPE_Client;
 
 
+//*****************************************************************************
+//*	the keyword=value pairs in contentData, parsed once for each request
+//*	the offsets are into contentData, see RequestArgs_Parse()
+#define	kMaxRequestArgs		32
+typedef struct	//	TYPE_RequestArg
+{
+	short			keyOffset;
+	short			keyLen;
+	short			valueOffset;
+	short			valueLen;
+	unsigned int	keyHash;			//*	case insensitive
+} TYPE_RequestArg;
+
+//*****************************************************************************
+typedef struct	//	TYPE_RequestArgIndex
+{
+	bool			argsValid;			//*	false = search contentData the old way
+	int				argCount;
+	TYPE_RequestArg	argList[kMaxRequestArgs];
+} TYPE_RequestArgIndex;
+
 //*****************************************************************************
 typedef struct	//	TYPE_GetPutRequestData
 {
@@ -78,6 +101,7 @@ typedef struct	//	TYPE_GetPutRequestData
 	char				cmdBuffer[kMaxCommandLen];
 	char				deviceCommand[kMaxCommandLen];
 	char				contentData[kContentDataLen];
+	TYPE_RequestArgIndex	argIndex;
 	TYPE_ASCOM_STATUS	alpacaErrCode;
 	char				alpacaErrMsg[256];
 	char				ClientTransactionIDstr[64];
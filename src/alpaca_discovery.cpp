@@ -13,10 +13,12 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	May  3,	2020	<MLS> Created alpacadriver_discovery.cpp
 //*	May  3,	2020	<MLS> Added SendDiscoveryQuery() and supporting routines
 //*	May  3,	2020	<MLS> Added ProcessDiscovery()
+//*	Oct 18,	2026	<AGT> Use SJP_AddToken() for the external IP list
 //*****************************************************************************
 //*	This set of routines allow a driver to discover other devices and query them
 //*****************************************************************************
@@ -79,7 +81,7 @@ int					closeRetCode;
 			if (rcvCnt > 0)
 			{
 				buf[rcvCnt]	=	0;
-				SJP_Init(&jsonParser);
+				SJP_Reset(&jsonParser);
 				SJP_ParseData(&jsonParser, buf);
 				//*	we have the IP address of the device in "fromAddress"
 				//*	find the port from the JSON data
@@ -166,7 +168,7 @@ int				deviceNumber;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	validData	=	GetJsonResponse(	deviceAddress,
 										ipPortNumber,
 										"/management/v1/configureddevices",
@@ -253,15 +255,13 @@ int					ipPortNumber;
 			slen	=	strlen(lineBuff);
 			if ((slen > 6) && (lineBuff[0] != '#'))
 			{
-				SJP_Init(&jsonParser);
+				SJP_Reset(&jsonParser);
 				inet_pton(AF_INET, lineBuff, &(from.sin_addr));
 
 				inet_ntop(AF_INET, &(from.sin_addr), outputIPaddr, INET_ADDRSTRLEN);
 				CONSOLE_DEBUG_W_STR("outputIPaddr\t\t=",		outputIPaddr);
 
-				strcpy(jsonParser.dataList[0].keyword, "ALPACAPORT");
-				strcpy(jsonParser.dataList[0].valueString, "6800");
-				jsonParser.tokenCount_Data	=	1;
+				SJP_AddToken(&jsonParser, "ALPACAPORT", "6800");
 
 				QueryConfiguredDevices(&from, ipPortNumber);
 		//-		AddUnitToList(&from, &jsonParser);
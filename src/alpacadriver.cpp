@@ -30,6 +30,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul msproul@skychariot.com
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr  5,	2019	<MLS> Attended lecture by Bob Denny introducing Alpaca protocol
 //*	Apr  9,	2019	<MLS> Created alpacadriver.c
@@ -200,6 +201,21 @@
 //*	Jan  4,	2025	<MLS> Added Supported Devices Table
 //*	Jan  4,	2025	<MLS> Added AddSupportedDevice() & DumpSupportedDeviceList()
 //*	Jan 10,	2025	<MLS> Added _ENABLE_CPU_NANOSECS_DISPLAY_
+//*	Oct 18,	2026	<AGT> Socket server now uses a pool of worker threads
+//*	Oct 18,	2026	<AGT> Commands to each device are serialized with cDeviceMutex
+//*	Oct 18,	2026	<AGT> Added IsConcurrentCommand() for long running transfers
+//*	Oct 18,	2026	<AGT> Added static response cache for description, driverinfo etc
+//*	Oct 18,	2026	<AGT> Added -w option to set number of socket worker threads
+//*	Oct 18,	2026	<AGT> AlpacaCallback() passes HTTP/1.1 keep-alive state to and from JsonResponse
+//*	Oct 18,	2026	<AGT> Added -f option to set the number of camera frame buffers
+//*	Oct 18,	2026	<AGT> FindCmdFromTable() now uses hashed command tables
+//*	Oct 18,	2026	<AGT> Fixed FindCmdFromTable() returning get_put from the wrong table
+//*	Oct 18,	2026	<AGT> Added GetKeyWordArgument(reqData...) using the pre-parsed keyword list
+//*	Oct 18,	2026	<AGT> Added request latency histograms, RecordCmdLatency()
+//*	Oct 18,	2026	<AGT> Added /metrics (Prometheus text format)
+//*	Oct 18,	2026	<AGT> Response cache hits are now counted in the command stats
+//*	Oct 18,	2026	<AGT> Fixed GetKeyWordArgument(reqData...) recursing forever with more than kMaxRequestArgs args
+//*	Oct 18,	2026	<AGT> Added ProcessCommand_SendResponse(), shared by all drivers and the response cache
 //*****************************************************************************
 //*	to install code blocks 20
 //*	Step 1: sudo add-apt-repository ppa:codeblocks-devs/release
@@ -246,6 +262,7 @@
 #include	"alpacadriver.h"
 #include	"alpacadriver_gps.h"
 #include	"alpacadriver_helper.h"
+#include	"alpacadriver_dispatch.h"
 #include	"eventlogging.h"
 #include	"socket_listen.h"
 #include	"discoverythread.h"
@@ -360,6 +377,18 @@ char			gHostName[48]								=	"";
 char			gUserAgentAlpacaPiStr[80]					=	"";
 int				gUserAgentCounters[kHTTPclient_last];
 int				gHTTP_OptionsRequestCnt						=	0;
+int				gSocketWorkerThreadCnt						=	0;		//*	0 means use the default
+int				gFrameRingDepth								=	0;		//*	0 means use the default
+TYPE_LatencyHistogram	gAllRequestLatency;									//*	every http request, not just the alpaca commands
+
+//*****************************************************************************
+//*	per command state, one copy per socket worker thread
+thread_local bool	AlpacaDriver::cSendJSONresponse			=	true;
+thread_local bool	AlpacaDriver::cHttpHeaderSent			=	false;
+thread_local int	AlpacaDriver::cCurrentCmdNum			=	-1;
+#ifdef _ENABLE_BANDWIDTH_LOGGING_
+thread_local int	AlpacaDriver::cBytesWrittenForThisCmd	=	0;
+#endif // _ENABLE_BANDWIDTH_LOGGING_
 
 #ifdef _ENABLE_BANDWIDTH_LOGGING_
 	int				gTimeUnitsSinceTopOfHour	=	0;
@@ -584,6 +613,9 @@ int		iii;
 	{
 		memset(&cDeviceCmdStats[iii], 0, sizeof(TYPE_CMD_STATS));
 	}
+	memset(&cDeviceLatency,		0, sizeof(cDeviceLatency));
+	memset(cCommonCmdLatency,	0, sizeof(cCommonCmdLatency));
+	memset(cDeviceCmdLatency,	0, sizeof(cDeviceCmdLatency));
 	GetAlpacaName(argDeviceType, cAlpacaName);
 	LogEvent(	cAlpacaName,
 				"Created",
@@ -596,6 +628,26 @@ int		iii;
 	cDriverThreadKeepRunning	=	false;
 	cDriverThreadID				=	0;
 
+	//-----------------------------------------------------------------
+	//*	multi-threaded server support
+	pthread_mutex_init(&cDeviceMutex,	NULL);
+	pthread_mutex_init(&cTransferMutex,	NULL);
+
+	//-----------------------------------------------------------------
+	//*	static response cache
+	pthread_mutex_init(&cResponseCacheMutex,	NULL);
+	memset((void *)cResponseCache, 0, sizeof(cResponseCache));
+	cResponseCacheCnt			=	0;
+	cResponseCacheHits			=	0;
+	cResponseCacheMisses		=	0;
+	cResponseCacheInvalidates	=	0;
+	cResponseIncludesContentData	=	false;
+	ResponseCache_Register("description");
+	ResponseCache_Register("driverinfo");
+	ResponseCache_Register("driverversion");
+	ResponseCache_Register("interfaceversion");
+	ResponseCache_Register("supportedactions");
+
 #ifdef _ENABLE_BANDWIDTH_LOGGING_
 	BandWidthStatsInit();
 #endif // _ENABLE_BANDWIDTH_LOGGING_
@@ -625,6 +677,18 @@ int	iii;
 			gAlpacaDeviceList[iii]	=	NULL;
 		}
 	}
+	pthread_mutex_destroy(&cDeviceMutex);
+	pthread_mutex_destroy(&cTransferMutex);
+
+	for (iii=0; iii<cResponseCacheCnt; iii++)
+	{
+		if (cResponseCache[iii].jsonBody != NULL)
+		{
+			free(cResponseCache[iii].jsonBody);
+			cResponseCache[iii].jsonBody	=	NULL;
+		}
+	}
+	pthread_mutex_destroy(&cResponseCacheMutex);
 }
 
 
@@ -667,6 +731,227 @@ int			returnCode;
 	return(returnCode);
 }
 
+//**************************************************************************************
+//*	returns true if this command can run at the same time as other commands to this device.
+//*	This is for long running, read only commands such as image downloads.
+//*	The command must not change the state of the device.
+//**************************************************************************************
+bool	AlpacaDriver::IsConcurrentCommand(TYPE_GetPutRequestData *reqData)
+{
+	return(false);
+}
+
+//**************************************************************************************
+//*	add a command to the list of responses that can be cached.
+//*	Only use this for GET commands whose response does not depend on the arguments
+//**************************************************************************************
+void	AlpacaDriver::ResponseCache_Register(const char *commandName)
+{
+	pthread_mutex_lock(&cResponseCacheMutex);
+	if ((commandName != NULL) && (strlen(commandName) < sizeof(cResponseCache[0].commandName)))
+	{
+		if (cResponseCacheCnt < kMaxResponseCacheEntries)
+		{
+			strcpy(cResponseCache[cResponseCacheCnt].commandName, commandName);
+			cResponseCache[cResponseCacheCnt].cmdNum	=	-1;
+			cResponseCache[cResponseCacheCnt].valid		=	false;
+			cResponseCacheCnt++;
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_STR("Response cache is full, cannot add", commandName);
+		}
+	}
+	pthread_mutex_unlock(&cResponseCacheMutex);
+}
+
+//**************************************************************************************
+//*	commandName == NULL invalidates everything
+//**************************************************************************************
+void	AlpacaDriver::ResponseCache_Invalidate(const char *commandName)
+{
+int		iii;
+
+	pthread_mutex_lock(&cResponseCacheMutex);
+	for (iii=0; iii<cResponseCacheCnt; iii++)
+	{
+		if ((commandName == NULL) || (strcmp(cResponseCache[iii].commandName, commandName) == 0))
+		{
+			cResponseCache[iii].valid	=	false;
+		}
+	}
+	cResponseCacheInvalidates++;
+	pthread_mutex_unlock(&cResponseCacheMutex);
+}
+
+//**************************************************************************************
+//*	returns the cache index for this request or -1 if it is not cacheable
+//**************************************************************************************
+int	AlpacaDriver::ResponseCache_FindEntry(TYPE_GetPutRequestData *reqData, uint32_t *invalidateCnt)
+{
+int		cacheIdx;
+int		iii;
+
+	cacheIdx	=	-1;
+	if (reqData->get_putIndicator == 'G')
+	{
+		pthread_mutex_lock(&cResponseCacheMutex);
+		for (iii=0; iii<cResponseCacheCnt; iii++)
+		{
+			if (strcmp(cResponseCache[iii].commandName, reqData->deviceCommand) == 0)
+			{
+				cacheIdx	=	iii;
+				break;
+			}
+		}
+		*invalidateCnt	=	cResponseCacheInvalidates;
+		pthread_mutex_unlock(&cResponseCacheMutex);
+	}
+	return(cacheIdx);
+}
+
+//*****************************************************************************
+//*	sends the end of the JSON response, transaction IDs and error info.
+//*	used by the drivers ProcessCommand() and by ResponseCache_Send()
+//*****************************************************************************
+void	AlpacaDriver::ProcessCommand_SendResponse(	TYPE_GetPutRequestData	*reqData,
+													const TYPE_ASCOM_STATUS	alpacaErrCode,
+													const char				*alpacaErrMsg)
+{
+int		mySocket;
+
+	mySocket				=	reqData->socket;
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
+															reqData->jsonTextBuffer,
+															kMaxJsonBuffLen,
+															"ClientTransactionID",
+															reqData->ClientTransactionID,
+															INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
+															reqData->jsonTextBuffer,
+															kMaxJsonBuffLen,
+															"ServerTransactionID",
+															gServerTransactionID,
+															INCLUDE_COMMA);
+
+	if (cResponseIncludesContentData && (strlen(reqData->contentData) > 0))
+	{
+		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
+																reqData->jsonTextBuffer,
+																kMaxJsonBuffLen,
+																"ContentData",
+																reqData->contentData,
+																INCLUDE_COMMA);
+	}
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
+															reqData->jsonTextBuffer,
+															kMaxJsonBuffLen,
+															"ErrorNumber",
+															alpacaErrCode,
+															INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
+															reqData->jsonTextBuffer,
+															kMaxJsonBuffLen,
+															"ErrorMessage",
+															alpacaErrMsg,
+															NO_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
+															reqData->httpRetCode,
+															reqData->jsonTextBuffer,
+															(cHttpHeaderSent == false));	//*	required for long JSON output
+}
+
+//**************************************************************************************
+//*	sends the cached body followed by the transaction IDs for this request.
+//*	returns false if the entry is not valid, the caller has to process the command
+//**************************************************************************************
+bool	AlpacaDriver::ResponseCache_Send(TYPE_GetPutRequestData *reqData, const int cacheIdx)
+{
+bool	entryValid;
+int		cmdNum;
+
+	entryValid	=	false;
+	cmdNum		=	-1;
+	pthread_mutex_lock(&cResponseCacheMutex);
+	if ((cacheIdx >= 0) && (cacheIdx < cResponseCacheCnt))
+	{
+		if (cResponseCache[cacheIdx].valid && (cResponseCache[cacheIdx].bodyLen < kMaxJsonBuffLen))
+		{
+			memcpy(reqData->jsonTextBuffer, cResponseCache[cacheIdx].jsonBody, cResponseCache[cacheIdx].bodyLen);
+			reqData->jsonTextBuffer[cResponseCache[cacheIdx].bodyLen]	=	0;
+			cmdNum		=	cResponseCache[cacheIdx].cmdNum;
+			entryValid	=	true;
+			cResponseCacheHits++;
+		}
+		else
+		{
+			cResponseCacheMisses++;
+		}
+	}
+	pthread_mutex_unlock(&cResponseCacheMutex);
+
+	if (entryValid)
+	{
+		ProcessCommand_SendResponse(reqData, kASCOM_Err_Success, "");
+		reqData->alpacaErrMsg[0]	=	0;
+		if (cmdNum >= 0)
+		{
+			RecordCmdStats(cmdNum, reqData->get_putIndicator, kASCOM_Err_Success);
+		}
+	}
+	return(entryValid);
+}
+
+//**************************************************************************************
+//*	jsonBody is the complete body captured from JsonResponse_Add_Finish(),
+//*	only the part before the transaction IDs is saved
+//**************************************************************************************
+void	AlpacaDriver::ResponseCache_Save(const int cacheIdx, const char *jsonBody, const uint32_t invalidateCnt)
+{
+const char	*transactionIDptr;
+int			bodyLen;
+
+	transactionIDptr	=	strstr(jsonBody, "\"ClientTransactionID\"");
+	if (transactionIDptr != NULL)
+	{
+		//*	back up to the start of the line
+		while ((transactionIDptr > jsonBody) && (transactionIDptr[-1] != '\n'))
+		{
+			transactionIDptr--;
+		}
+		bodyLen	=	transactionIDptr - jsonBody;
+
+		pthread_mutex_lock(&cResponseCacheMutex);
+		//*	if something got invalidated while the command was being processed,
+		//*	the response may already be out of date
+		if ((cacheIdx >= 0) && (cacheIdx < cResponseCacheCnt) && (invalidateCnt == cResponseCacheInvalidates))
+		{
+			if (cResponseCache[cacheIdx].bodyAllocSize <= bodyLen)
+			{
+				if (cResponseCache[cacheIdx].jsonBody != NULL)
+				{
+					free(cResponseCache[cacheIdx].jsonBody);
+				}
+				cResponseCache[cacheIdx].jsonBody		=	(char *)malloc(bodyLen + 1);
+				cResponseCache[cacheIdx].bodyAllocSize	=	(cResponseCache[cacheIdx].jsonBody != NULL) ? (bodyLen + 1) : 0;
+			}
+			if (cResponseCache[cacheIdx].jsonBody != NULL)
+			{
+				memcpy(cResponseCache[cacheIdx].jsonBody, jsonBody, bodyLen);
+				cResponseCache[cacheIdx].jsonBody[bodyLen]	=	0;
+				cResponseCache[cacheIdx].bodyLen			=	bodyLen;
+				cResponseCache[cacheIdx].cmdNum				=	cCurrentCmdNum;
+				cResponseCache[cacheIdx].valid				=	true;
+			}
+		}
+		pthread_mutex_unlock(&cResponseCacheMutex);
+	}
+}
+
 //**************************************************************************************
 TYPE_ASCOM_STATUS	AlpacaDriver::ProcessCommand(TYPE_GetPutRequestData *reqData)
 {
@@ -1420,7 +1705,7 @@ bool				foundKeyWord;
 char				argumentString[32];
 bool				liveWindowFlg;
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Live",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -1899,6 +2184,8 @@ void	AlpacaDriver::RecordCmdStats(int cmdNum, char getput, TYPE_ASCOM_STATUS alp
 {
 int		tblIdx;
 
+	//*	so RecordCmdLatency() knows which command this was
+	cCurrentCmdNum	=	cmdNum;
 	//*	check for common command index ( > 1000)
 	if (cmdNum >= kCmd_Common_action)
 	{
@@ -1947,6 +2234,184 @@ int		tblIdx;
 	}
 }
 
+//*****************************************************************************
+//*	called after the command has been processed and the response has been sent.
+//*	the command number comes from the RecordCmdStats() call in ProcessCommand()
+//*****************************************************************************
+void	AlpacaDriver::RecordCmdLatency(TYPE_ASCOM_STATUS alpacaErrCode)
+{
+uint64_t	startTime_us;
+uint64_t	elapsed_us;
+bool		isError;
+int			tblIdx;
+
+	startTime_us	=	SocketListen_GetRequestStartTime_us();
+	if (startTime_us > 0)
+	{
+		elapsed_us	=	LatencyHistogram_GetTime_us() - startTime_us;
+		isError		=	(alpacaErrCode != kASCOM_Err_Success);
+		LatencyHistogram_Record(&cDeviceLatency, elapsed_us, cBytesWrittenForThisCmd, isError);
+		if (cCurrentCmdNum >= kCmd_Common_action)
+		{
+			tblIdx	=	cCurrentCmdNum - kCmd_Common_action;
+			if (tblIdx < kCommonCmdCnt)
+			{
+				LatencyHistogram_Record(&cCommonCmdLatency[tblIdx], elapsed_us, cBytesWrittenForThisCmd, isError);
+			}
+		}
+		else if ((cCurrentCmdNum >= 0) && (cCurrentCmdNum < kDeviceCmdCnt))
+		{
+			LatencyHistogram_Record(&cDeviceCmdLatency[cCurrentCmdNum], elapsed_us, cBytesWrittenForThisCmd, isError);
+		}
+	}
+}
+
+//*****************************************************************************
+//*	entryIdx steps through the common commands and then the device commands
+//*	returns false if there is no such command or it has never been used
+//*****************************************************************************
+bool	AlpacaDriver::GetCmdLatencySnapshot(const int entryIdx, char *cmdName, TYPE_LatencyHistogram *snapshot)
+{
+bool	foundIt;
+char	getPutIndicator;
+
+	foundIt	=	false;
+	if ((entryIdx >= 0) && (entryIdx < kCommonCmdCnt))
+	{
+		foundIt	=	GetCmdNameFromTable((kCmd_Common_action + entryIdx), cmdName, gCommonCmdTable, &getPutIndicator);
+		if (foundIt)
+		{
+			LatencyHistogram_Snapshot(&cCommonCmdLatency[entryIdx], snapshot);
+		}
+	}
+	else if ((entryIdx >= kCommonCmdCnt) && (entryIdx < (kCommonCmdCnt + kDeviceCmdCnt)))
+	{
+		foundIt	=	GetCmdNameFromMyCmdTable((entryIdx - kCommonCmdCnt), cmdName, &getPutIndicator);
+		if (foundIt)
+		{
+			LatencyHistogram_Snapshot(&cDeviceCmdLatency[entryIdx - kCommonCmdCnt], snapshot);
+		}
+	}
+	return(foundIt && (snapshot->count > 0));
+}
+
+//*****************************************************************************
+//*	Prometheus text format, only the commands that have been used are listed
+//*****************************************************************************
+void	AlpacaDriver::OutputMetrics_Prometheus(const int socketFD, const int metricFamily)
+{
+TYPE_LatencyHistogram	snapshot;
+char					cmdName[64];
+char					labelString[160];
+char					metricsBuffer[4096];
+int						iii;
+
+	if (metricFamily == kMetric_DeviceLatency)
+	{
+		LatencyHistogram_Snapshot(&cDeviceLatency, &snapshot);
+		if (snapshot.count > 0)
+		{
+			sprintf(labelString, "device=\"%s\",devnum=\"%d\"", cAlpacaDeviceString, cAlpacaDeviceNum);
+			if (LatencyHistogram_FormatPrometheus(	&snapshot,
+													"alpacapi_device_request_duration_seconds",
+													labelString,
+													metricsBuffer,
+													sizeof(metricsBuffer)) > 0)
+			{
+				SocketWriteData(socketFD,	metricsBuffer);
+			}
+		}
+	}
+	else
+	{
+		for (iii=0; iii < (kCommonCmdCnt + kDeviceCmdCnt); iii++)
+		{
+			if (GetCmdLatencySnapshot(iii, cmdName, &snapshot))
+			{
+				sprintf(labelString, "device=\"%s\",devnum=\"%d\",command=\"%s\"",
+										cAlpacaDeviceString,
+										cAlpacaDeviceNum,
+										cmdName);
+				metricsBuffer[0]	=	0;
+				switch(metricFamily)
+				{
+					case kMetric_CmdLatency:
+						LatencyHistogram_FormatPrometheus(	&snapshot,
+															"alpacapi_request_duration_seconds",
+															labelString,
+															metricsBuffer,
+															sizeof(metricsBuffer));
+						break;
+
+					case kMetric_CmdErrors:
+						sprintf(metricsBuffer, "alpacapi_request_errors_total{%s} %u\n", labelString, snapshot.errorCnt);
+						break;
+
+					case kMetric_CmdBytesSent:
+						sprintf(metricsBuffer, "alpacapi_response_bytes_total{%s} %llu\n",
+												labelString,
+												(unsigned long long)snapshot.bytesSent);
+						break;
+				}
+				if (strlen(metricsBuffer) > 0)
+				{
+					SocketWriteData(socketFD,	metricsBuffer);
+				}
+			}
+		}
+	}
+}
+
+//*****************************************************************************
+//*	one JSON object per command, for /management/v1/metrics
+//*****************************************************************************
+void	AlpacaDriver::OutputMetrics_JSON(TYPE_GetPutRequestData *reqData, bool *firstEntry)
+{
+TYPE_LatencyHistogram	snapshot;
+char					cmdName[64];
+char					lineBuffer[512];
+int						iii;
+bool					entryValid;
+
+	for (iii = -1; iii < (kCommonCmdCnt + kDeviceCmdCnt); iii++)
+	{
+		//*	-1 is the total for the device
+		if (iii < 0)
+		{
+			strcpy(cmdName, "all");
+			LatencyHistogram_Snapshot(&cDeviceLatency, &snapshot);
+			entryValid	=	(snapshot.count > 0);
+		}
+		else
+		{
+			entryValid	=	GetCmdLatencySnapshot(iii, cmdName, &snapshot);
+		}
+		if (entryValid)
+		{
+			sprintf(lineBuffer,	"%s\t\t{\"Device\":\"%s\",\"DeviceNumber\":%d,\"Command\":\"%s\","
+								"\"Count\":%u,\"Errors\":%u,\"BytesSent\":%llu,"
+								"\"Mean_us\":%llu,\"P50_us\":%u,\"P90_us\":%u,\"P99_us\":%u,\"Max_us\":%u}",
+								((*firstEntry) ? "\r\n" : ",\r\n"),
+								cAlpacaDeviceString,
+								cAlpacaDeviceNum,
+								cmdName,
+								snapshot.count,
+								snapshot.errorCnt,
+								(unsigned long long)snapshot.bytesSent,
+								(unsigned long long)(snapshot.sum_us / snapshot.count),
+								LatencyHistogram_Percentile(&snapshot, 50.0),
+								LatencyHistogram_Percentile(&snapshot, 90.0),
+								LatencyHistogram_Percentile(&snapshot, 99.0),
+								snapshot.max_us);
+			JsonResponse_Add_RawText(	reqData->socket,
+										reqData->jsonTextBuffer,
+										kMaxJsonBuffLen,
+										lineBuffer);
+			*firstEntry	=	false;
+		}
+	}
+}
+
 
 
 #pragma mark -
@@ -2817,6 +3282,77 @@ int		iii;
 	//	CONSOLE_DEBUG("reqData is NULL");
 	}
 }
+
+//*****************************************************************************
+static const char	gMetricsHeader[]	=
+{
+	"HTTP/1.0 200 OK\r\n"
+	"Content-Type: text/plain; version=0.0.4\r\n"
+	"Connection: close\r\n"
+	"\r\n"
+};
+
+//*****************************************************************************
+//*	/metrics	Prometheus text format
+//*	the times are from the accept to the last byte of the response written
+//*****************************************************************************
+static void	SendMetrics_Prometheus(TYPE_GetPutRequestData *reqData)
+{
+TYPE_LatencyHistogram	snapshot;
+char					metricsBuffer[4096];
+int						mySocketFD;
+int						metricFamily;
+int						iii;
+
+	mySocketFD	=	reqData->socket;
+	SocketWriteData(mySocketFD,	gMetricsHeader);
+
+	SocketWriteData(mySocketFD,	"# HELP alpacapi_http_request_duration_seconds All http requests, accept to last byte written\n");
+	SocketWriteData(mySocketFD,	"# TYPE alpacapi_http_request_duration_seconds histogram\n");
+	LatencyHistogram_Snapshot(&gAllRequestLatency, &snapshot);
+	if (LatencyHistogram_FormatPrometheus(	&snapshot,
+											"alpacapi_http_request_duration_seconds",
+											"server=\"alpacapi\"",
+											metricsBuffer,
+											sizeof(metricsBuffer)) > 0)
+	{
+		SocketWriteData(mySocketFD,	metricsBuffer);
+	}
+
+	for (metricFamily=0; metricFamily<kMetric_last; metricFamily++)
+	{
+		switch(metricFamily)
+		{
+			case kMetric_CmdLatency:
+				SocketWriteData(mySocketFD,	"# HELP alpacapi_request_duration_seconds Alpaca command time, accept to last byte written\n");
+				SocketWriteData(mySocketFD,	"# TYPE alpacapi_request_duration_seconds histogram\n");
+				break;
+
+			case kMetric_DeviceLatency:
+				SocketWriteData(mySocketFD,	"# HELP alpacapi_device_request_duration_seconds All commands to a device, accept to last byte written\n");
+				SocketWriteData(mySocketFD,	"# TYPE alpacapi_device_request_duration_seconds histogram\n");
+				break;
+
+			case kMetric_CmdErrors:
+				SocketWriteData(mySocketFD,	"# HELP alpacapi_request_errors_total Alpaca commands that returned an error\n");
+				SocketWriteData(mySocketFD,	"# TYPE alpacapi_request_errors_total counter\n");
+				break;
+
+			case kMetric_CmdBytesSent:
+				SocketWriteData(mySocketFD,	"# HELP alpacapi_response_bytes_total Response bytes sent\n");
+				SocketWriteData(mySocketFD,	"# TYPE alpacapi_response_bytes_total counter\n");
+				break;
+		}
+		for (iii=0; iii<gDeviceCnt; iii++)
+		{
+			if (gAlpacaDeviceList[iii] != NULL)
+			{
+				gAlpacaDeviceList[iii]->OutputMetrics_Prometheus(mySocketFD, metricFamily);
+			}
+		}
+	}
+}
+
 //*****************************************************************************
 static char	gDocsIntro[]	=
 {
@@ -3228,18 +3764,57 @@ static TYPE_ASCOM_STATUS	ProcessAlpacaCommand(	AlpacaDriver			*alpacaDevice,
 													long					byteCount)
 {
 TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_InternalError;
+pthread_mutex_t		*deviceLockPtr;
+int					cacheIdx;
+uint32_t			invalidateCnt;
+char				capturedBody[kMaxJsonBuffLen];
 
 	if ((alpacaDevice != NULL) && (reqData != NULL))
 	{
+		//*	the socket server is multi-threaded, only one command at a time per device
+		if (alpacaDevice->IsConcurrentCommand(reqData))
+		{
+			deviceLockPtr	=	&alpacaDevice->cTransferMutex;
+		}
+		else
+		{
+			deviceLockPtr	=	&alpacaDevice->cDeviceMutex;
+		}
+		pthread_mutex_lock(deviceLockPtr);
 
 		alpacaDevice->cBytesWrittenForThisCmd	=	0;
 		alpacaDevice->cHttpHeaderSent			=	false;
+		alpacaDevice->cCurrentCmdNum			=	-1;
 
 //		CONSOLE_DEBUG("Calling ProcessCommand() ---------------------------------------------");
 //		CONSOLE_DEBUG_W_STR("cAlpacaName         \t=",	alpacaDevice->cAlpacaName);
 //		CONSOLE_DEBUG_W_STR("deviceCommand       \t=",	reqData->deviceCommand);
 		alpacaDevice->cSendJSONresponse	=	true;
-		alpacaErrCode					=	alpacaDevice->ProcessCommand(reqData);
+
+		//*	static properties are sent from the response cache,
+		//*	this skips the command table lookup and all of the formatting
+		invalidateCnt	=	0;
+		cacheIdx		=	alpacaDevice->ResponseCache_FindEntry(reqData, &invalidateCnt);
+		if ((cacheIdx >= 0) && alpacaDevice->ResponseCache_Send(reqData, cacheIdx))
+		{
+			alpacaErrCode	=	kASCOM_Err_Success;
+		}
+		else
+		{
+			if (cacheIdx >= 0)
+			{
+				JsonResponse_SetCaptureBuffer(capturedBody, sizeof(capturedBody));
+			}
+			alpacaErrCode	=	alpacaDevice->ProcessCommand(reqData);
+			if (cacheIdx >= 0)
+			{
+				JsonResponse_SetCaptureBuffer(NULL, 0);
+				if ((alpacaErrCode == kASCOM_Err_Success) && (strlen(capturedBody) > 0))
+				{
+					alpacaDevice->ResponseCache_Save(cacheIdx, capturedBody, invalidateCnt);
+				}
+			}
+		}
 		if (alpacaErrCode == kASCOM_Err_Success)
 		{
 			//*	record the time of the last successful command
@@ -3252,6 +3827,8 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_InternalError;
 		}
 		alpacaDevice->cTotalCmdsProcessed++;
 		alpacaDevice->cTotalBytesRcvd	+=	byteCount;
+		//*	the response has been written by now
+		alpacaDevice->RecordCmdLatency(alpacaErrCode);
 
 		reqData->alpacaErrCode	=	alpacaErrCode;
 		//*	are we conform logging
@@ -3273,6 +3850,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_InternalError;
 			alpacaDevice->cBW_BytesSent[gTimeUnitsSinceTopOfHour]		+=	alpacaDevice->cBytesWrittenForThisCmd;
 		}
 #endif // _ENABLE_BANDWIDTH_LOGGING_
+		pthread_mutex_unlock(deviceLockPtr);
 	}
 
 	return(alpacaErrCode);
@@ -3378,8 +3956,12 @@ int					iii;
 		{
 			if (gAlpacaDeviceList[iii]->cDeviceType == kDeviceType_Management)
 			{
+				pthread_mutex_lock(&gAlpacaDeviceList[iii]->cDeviceMutex);
 				gAlpacaDeviceList[iii]->cHttpHeaderSent			=	false;
+				gAlpacaDeviceList[iii]->cBytesWrittenForThisCmd	=	0;
+				gAlpacaDeviceList[iii]->cCurrentCmdNum			=	-1;
 				alpacaErrCode	=	gAlpacaDeviceList[iii]->ProcessCommand(reqData);
+				gAlpacaDeviceList[iii]->RecordCmdLatency(alpacaErrCode);
 				gAlpacaDeviceList[iii]->cTotalCmdsProcessed++;
 				if (alpacaErrCode!= kASCOM_Err_Success)
 				{
@@ -3394,6 +3976,7 @@ int					iii;
 		//-			gAlpacaDeviceList[iii]->cBW_BytesSent[gTimeUnitsSinceTopOfHour];
 				}
 #endif // _ENABLE_BANDWIDTH_LOGGING_
+				pthread_mutex_unlock(&gAlpacaDeviceList[iii]->cDeviceMutex);
 				break;
 			}
 		}
@@ -3444,7 +4027,9 @@ bool				deviceFound;
 //					CONSOLE_DEBUG("Calling Setup_ProcessCommand() ---------------------------------------------");
 //					CONSOLE_DEBUG_W_STR("cAlpacaName         \t=",	gAlpacaDeviceList[iii]->cAlpacaName);
 //					CONSOLE_DEBUG_W_STR("deviceCommand       \t=",	reqData->deviceCommand);
+					pthread_mutex_lock(&gAlpacaDeviceList[iii]->cDeviceMutex);
 					gAlpacaDeviceList[iii]->Setup_ProcessCommand(reqData);
+					pthread_mutex_unlock(&gAlpacaDeviceList[iii]->cDeviceMutex);
 					break;
 				}
 			}
@@ -3461,6 +4046,7 @@ static	FILE	*gIPlogFilePointer		=	NULL;
 static	bool	gIPlogNeedsToBeOpened	=	true;
 static	long	gIPlogWriteCount		=	0;
 static	short	gCurrentDayOfMonth		=	-1;
+static	pthread_mutex_t	gIPlogMutex		=	PTHREAD_MUTEX_INITIALIZER;
 //*****************************************************************************
 static void	LogRequest(TYPE_GetPutRequestData	*reqData)
 {
@@ -3895,6 +4481,7 @@ typedef enum
 	kRequestType_GPS,
 	kRequestType_TopLevel,
 	kRequestType_HTML,
+	kRequestType_Metrics,
 
 	kRequestType_Form,
 
@@ -3925,6 +4512,7 @@ static TYPE_Request	gRequestType[]	=
 
 	{	"form",			kRequestType_Form		},
 	{	"html",			kRequestType_HTML		},
+	{	"metrics",		kRequestType_Metrics	},
 
 	{	"",				kRequestType_Invalid	},
 	{	"",				kRequestType_Invalid	},
@@ -4183,10 +4771,12 @@ char				*delimPtr;
 	{
 		reqData->contentData[iii-1]	=	0;
 	}
+	//*	split out the keyword=value pairs once, the drivers look them up from this list
+	RequestArgs_Parse(reqData->contentData, &reqData->argIndex);
 
 	//------------------------------------------------------------------
 	//*	Check for client ID
-	foundKeyWord	=	GetKeyWordArgument(reqData->contentData, "ClientID", argumentString, 31);
+	foundKeyWord	=	GetKeyWordArgument(reqData, "ClientID", argumentString, 31);
 	if (foundKeyWord)
 	{
 		gClientID	=	atoi(argumentString);
@@ -4201,7 +4791,7 @@ char				*delimPtr;
 	//*	Check for ClientTransactionID
 	reqData->ClientTransactionID	=	67890;	//*	set the default (fake out conformU)
 	reqData->ClientTransactionID	=	1234;	//*	set the default (fake out conformU)
-	foundKeyWord	=	GetKeyWordArgument(reqData->contentData, "ClientTransactionID", argumentString, 31, kIgnoreCase);
+	foundKeyWord	=	GetKeyWordArgument(reqData, "ClientTransactionID", argumentString, 31, kIgnoreCase);
 	if (foundKeyWord)
 	{
 	int	myClientTransactionID;
@@ -4281,7 +4871,9 @@ int	iii;
 	ParseHTMLdataIntoReqStruct(htmlData, &reqData);
 
 	requestType	=	ParseAlpacaRequest(&reqData);
+	pthread_mutex_lock(&gIPlogMutex);
 	LogRequest(&reqData);
+	pthread_mutex_unlock(&gIPlogMutex);
 
 	parseChrPtr			=	htmlData;
 	parseChrPtr			+=	3;
@@ -4365,6 +4957,11 @@ int	iii;
 			OutputHTML_html(&reqData);
 			break;
 
+		//*	request latency in Prometheus text format
+		case kRequestType_Metrics:
+			SendMetrics_Prometheus(&reqData);
+			break;
+
 		//*	this is for testing, will be deleted later
 		case kRequestType_Form:
 			OutputHTML_Form(&reqData);
@@ -4489,6 +5086,9 @@ CONSOLE_DEBUG_W_STR("\r\n", htmlData);
 //	CONSOLE_DEBUG("Timing Start----------------------");
 //	SETUP_TIMING();
 
+	//*	the JSON response code needs to know if it can leave the connection open
+	JsonResponse_SetKeepAlive(SocketListen_ClientWantsKeepAlive());
+
 	if ((strncmp(htmlData, "GET", 3) == 0) || (strncmp(htmlData, "PUT", 3) == 0))
 	{
 //		CONSOLE_DEBUG("Calling ProcessGetPutRequest");
@@ -4510,6 +5110,16 @@ CONSOLE_DEBUG_W_STR("\r\n", htmlData);
 		CONSOLE_DEBUG_W_STR("Invalid HTML get/put command\t=\r\n",	htmlData);
 		CONSOLE_DEBUG_W_LONG("byteCount\t=",	byteCount);
 	}
+	SocketListen_SetResponseFramed(JsonResponse_ResponseWasFramed());
+
+	//*	all of the response has been written, returnCode is the alpaca error code
+	if (SocketListen_GetRequestStartTime_us() > 0)
+	{
+		LatencyHistogram_Record(&gAllRequestLatency,
+								(LatencyHistogram_GetTime_us() - SocketListen_GetRequestStartTime_us()),
+								0,
+								(returnCode > 0));
+	}
 
 
 //	DEBUG_TIMING(__FUNCTION__);
@@ -4525,6 +5135,10 @@ static void	*ListenThread(void *arg)
 //	CONSOLE_DEBUG(__FUNCTION__);
 
 	SocketListen_SetCallback(&AlpacaCallback);
+	if (gSocketWorkerThreadCnt > 0)
+	{
+		SocketListen_SetWorkerCount(gSocketWorkerThreadCnt);
+	}
 
 	SocketListen_Init(gAlpacaListenPort);
 
@@ -4544,6 +5158,7 @@ static void	PrintHelp(const char *appName)
 	printf("\t%-20s\t%s\r\n",	"-c",				"Conform logging, log ALL commands to disk");
 	printf("\t%-20s\t%s\r\n",	"-d",				"Display images as they are taken");
 	printf("\t%-20s\t%s\r\n",	"-e",				"Error logging, log errors commands to disk");
+	printf("\t%-20s\t%s\r\n",	"-f <count>",		"number of camera frame buffers (2-16)");
 #ifdef _ENABLE_GLOBAL_GPS_
 	printf("\t%-20s\t%s\r\n",	"-g",				"Enable GPS via serial port (/dev/ttyS0)");
 	printf("\t%-20s\t%s\r\n",	"-g1",				"Sets baud rate to 19200");
@@ -4560,6 +5175,7 @@ static void	PrintHelp(const char *appName)
 	printf("\t%-20s\t%s\r\n",	"-s",				"Simulate camera image");
 	printf("\t%-20s\t%s\r\n",	"-t <profile>",		"Which telescope profile to use");
 	printf("\t%-20s\t%s\r\n",	"-v",				"verbose (more console messages default)");
+	printf("\t%-20s\t%s\r\n",	"-w <count>",		"number of socket worker threads (default 6)");
 }
 
 #ifdef _ENABLE_GLOBAL_GPS_
@@ -4618,6 +5234,20 @@ int		newListenPort;
 					gDisplayImage	=	true;
 					break;
 
+				//	"-f" specifies the number of camera frame buffers
+				case 'f':
+					if (isdigit(argv[iii][2]))
+					{
+						gFrameRingDepth	=	atoi(&argv[iii][2]);
+					}
+					else if (iii < (argc -1))
+					{
+						iii++;
+						gFrameRingDepth	=	atoi(argv[iii]);
+					}
+					CONSOLE_DEBUG_W_NUM("gFrameRingDepth\t=", gFrameRingDepth);
+					break;
+
 		#ifdef _ENABLE_GLOBAL_GPS_
 				//	-g	means enable local GPS
 				case 'g':
@@ -4700,6 +5330,20 @@ int		newListenPort;
 				case 'v':
 					gVerbose	=	true;
 					break;
+
+				//	"-w" specifies the number of socket worker threads
+				case 'w':
+					if (isdigit(argv[iii][2]))
+					{
+						gSocketWorkerThreadCnt	=	atoi(&argv[iii][2]);
+					}
+					else if (iii < (argc -1))
+					{
+						iii++;
+						gSocketWorkerThreadCnt	=	atoi(argv[iii]);
+					}
+					CONSOLE_DEBUG_W_NUM("gSocketWorkerThreadCnt\t=", gSocketWorkerThreadCnt);
+					break;
 			}
 		}
 	}
@@ -5336,70 +5980,11 @@ uint32_t	milliSecs;
 
 //*****************************************************************************
 //*	returns -1 if not found
+//*	the tables are hashed the first time they are used, see alpacadriver_dispatch.c
 //*****************************************************************************
 int	FindCmdFromTable(const char *theCmd, const TYPE_CmdEntry *theCmdTable, int *cmdType)
 {
-int		iii;
-int		cmdEnumValue;
-
-	cmdEnumValue	=	-1;
-	iii				=	0;
-	while ((theCmdTable[iii].commandName[0] != 0) && (cmdEnumValue < 0))
-	{
-		if (strcasecmp(theCmd, theCmdTable[iii].commandName) == 0)
-		{
-			cmdEnumValue	=	theCmdTable[iii].enumValue;
-			if (cmdType != NULL)
-			{
-				*cmdType	=	theCmdTable[iii].get_put;
-			}
-		}
-		iii++;
-	}
-
-	//*	if we haven't found the command, look it up in the common table
-	if (cmdEnumValue < 0)
-	{
-		iii				=	0;
-		while ((gCommonCmdTable[iii].commandName[0] != 0) && (cmdEnumValue < 0))
-		{
-			if (strcasecmp(theCmd, gCommonCmdTable[iii].commandName) == 0)
-			{
-				cmdEnumValue	=	gCommonCmdTable[iii].enumValue;
-				if (cmdType != NULL)
-				{
-					*cmdType	=	theCmdTable[iii].get_put;
-				}
-			}
-			iii++;
-		}
-	}
-	return(cmdEnumValue);
-}
-
-//*****************************************************************************
-static void	GenerateInvertedCase(const char *charStr, char *invertedStr)
-{
-int	sLen;
-int	iii;
-
-	sLen	=	strlen(charStr);
-	for (iii=0; iii<sLen; iii++)
-	{
-		if (isupper(charStr[iii]))
-		{
-			invertedStr[iii]	=	tolower(charStr[iii]);
-		}
-		else if (islower(charStr[iii]))
-		{
-			invertedStr[iii]	=	toupper(charStr[iii]);
-		}
-		else
-		{
-			invertedStr[iii]	=	charStr[iii];
-		}
-	}
-	invertedStr[iii]	=	0;
+	return(CmdTableIndex_Find(theCmd, theCmdTable, gCommonCmdTable, cmdType));
 }
 
 //*****************************************************************************
@@ -5429,7 +6014,6 @@ char	myArgString[256];
 int		myArgLength;
 int		ccc;
 char	theChar;
-char	invertedCaseKeyWord[64];
 #ifdef _DEBUG_CONFORM_
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_STR("dataSource\t=", dataSource);
@@ -5440,8 +6024,6 @@ char	invertedCaseKeyWord[64];
 	foundKeyWord	=	false;
 	if ((dataSource != NULL) && (keyword != NULL) && (argument != NULL))
 	{
-		GenerateInvertedCase(keyword, invertedCaseKeyWord);
-
 		//*	this steps through the string looking for keywords
 		//*	Once the keyword is found, it MUST be followed by an "="
 		dataSrcLen	=	strlen(dataSource);
@@ -5533,6 +6115,46 @@ char	invertedCaseKeyWord[64];
 	return(foundKeyWord);
 }
 
+//*****************************************************************************
+//*	Same as above, but uses the keyword list that was parsed when the request came in
+//*****************************************************************************
+bool	GetKeyWordArgument(	const TYPE_GetPutRequestData	*reqData,
+							const char						*keyword,
+							char							*argument,
+							const int						maxArgLen,
+							const bool						ingoreCase,
+							const bool						argIsNumeric)
+{
+bool	foundKeyWord;
+
+	if ((reqData != NULL) && (keyword != NULL) && (argument != NULL) && reqData->argIndex.argsValid)
+	{
+		foundKeyWord	=	RequestArgs_Find(	reqData->contentData,
+												&reqData->argIndex,
+												keyword,
+												argument,
+												maxArgLen,
+												ingoreCase,
+												argIsNumeric);
+	}
+	else if (reqData != NULL)
+	{
+		//*	too many arguments to index, scan the string the old way
+		foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+												keyword,
+												argument,
+												maxArgLen,
+												ingoreCase,
+												argIsNumeric);
+	}
+	else
+	{
+		CONSOLE_DEBUG("reqData is null");
+		foundKeyWord	=	false;
+	}
+	return(foundKeyWord);
+}
+
 //**************************************************************************************
 //*	Count devices by type
 //**************************************************************************************
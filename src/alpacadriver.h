@@ -16,6 +16,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Aug 30,	2019	<MLS> Started on alpaca driver base class
 //*	Jan 17,	2020	<MLS> Added magic cookie for object validation
@@ -32,6 +33,13 @@
 //*	Nov 28,	2022	<MLS> Added cLastDeviceErrMsg
 //*	Sep 20,	2023	<MLS> Moved camera read thread to base class
 //*	Apr 29,	2024	<MLS> Added cSendJSONresponse to handle setupdialog
+//*	Oct 18,	2026	<AGT> Per command state (cSendJSONresponse etc) is now thread_local
+//*	Oct 18,	2026	<AGT> Added cDeviceMutex and cTransferMutex for multi-threaded server
+//*	Oct 18,	2026	<AGT> Added IsConcurrentCommand()
+//*	Oct 18,	2026	<AGT> Added static response cache (ResponseCache_xxx())
+//*	Oct 18,	2026	<AGT> Added GetKeyWordArgument() that takes TYPE_GetPutRequestData
+//*	Oct 18,	2026	<AGT> Added per command latency histograms (RecordCmdLatency())
+//*	Oct 18,	2026	<AGT> Added ProcessCommand_SendResponse()
 //*****************************************************************************
 //#include	"alpacadriver.h"
 
@@ -101,6 +109,10 @@
 	#include	"gps_data.h"
 #endif
 
+#ifndef _LATENCY_HISTOGRAM_H_
+	#include	"latency_histogram.h"
+#endif
+
 
 
 #ifdef _USE_OPENCV_
@@ -152,6 +164,20 @@ typedef struct	//	TYPE_CMD_STATS
 
 } TYPE_CMD_STATS;
 
+//*	the common command enums start at kCmd_Common_action
+#define	kCommonCmdCnt	(kCmd_Common_last - kCmd_Common_action)
+
+//*	for OutputMetrics_Prometheus(), each metric has to be output as one group
+enum
+{
+	kMetric_CmdLatency	=	0,
+	kMetric_DeviceLatency,
+	kMetric_CmdErrors,
+	kMetric_CmdBytesSent,
+
+	kMetric_last
+};
+
 
 #define	kMagicCookieValue	0x55AA7777
 
@@ -159,6 +185,23 @@ typedef struct	//	TYPE_CMD_STATS
 #define	kDeviceVersionStrLen	64
 #define	kDeviceSerialNumStrLen	64
 
+//**************************************************************************************
+//*	pre-rendered responses for properties that almost never change.
+//*	jsonBody is everything up to where the transaction IDs go,
+//*	the transaction IDs and error info are added for each request
+#define	kMaxResponseCacheEntries	12
+
+//**************************************************************************************
+typedef struct
+{
+	char	commandName[32];
+	int		cmdNum;				//*	for the command statistics, -1 until the first response is saved
+	bool	valid;
+	int		bodyLen;
+	int		bodyAllocSize;
+	char	*jsonBody;
+} TYPE_ResponseCache;
+
 
 //**************************************************************************************
 enum DeviceConnectionType
@@ -191,6 +234,7 @@ class AlpacaDriver
 
 		virtual	TYPE_ASCOM_STATUS		ProcessCommand(			TYPE_GetPutRequestData *reqData);
 				TYPE_ASCOM_STATUS		ProcessCommand_Common(	TYPE_GetPutRequestData *reqData, const int cmdEnum, char *alpacaErrMsg);
+				void					ProcessCommand_SendResponse(TYPE_GetPutRequestData *reqData, const TYPE_ASCOM_STATUS alpacaErrCode, const char *alpacaErrMsg);
 
 				TYPE_ASCOM_STATUS		Get_Connected(			TYPE_GetPutRequestData *reqData, char *alpacaErrMsg, const char *responseString);
 				TYPE_ASCOM_STATUS		Put_Connected(			TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
@@ -247,8 +291,10 @@ class AlpacaDriver
 				TYPE_CommonProperties	cCommonProp;
 				const TYPE_CmdEntry		*cDriverCmdTablePtr;
 
-				bool				cSendJSONresponse;		//*	False for setupdialog and camera binary data
-				bool				cHttpHeaderSent;
+				//*	The socket server runs each connection on its own worker thread,
+				//*	these describe the command currently being processed by THIS thread
+		static	thread_local bool	cSendJSONresponse;		//*	False for setupdialog and camera binary data
+		static	thread_local bool	cHttpHeaderSent;
 				bool				cRunStartupOperations;
 				bool				cVerboseDebug;
 				uint32_t			cMagicCookie;			//*	used to validate objects
@@ -281,9 +327,35 @@ class AlpacaDriver
 				int					cBW_CmdsReceived[kMaxBandWidthSamples];
 				int					cBW_BytesReceived[kMaxBandWidthSamples];
 				int					cBW_BytesSent[kMaxBandWidthSamples];
-				int					cBytesWrittenForThisCmd;
+		static	thread_local int	cBytesWrittenForThisCmd;
 #endif // _ENABLE_BANDWIDTH_LOGGING_
 
+				//=========================================================
+				//*	multi-threaded server support
+				//*	commands to a device are serialized with cDeviceMutex.
+				//*	Long running read only commands (i.e. image downloads) are
+				//*	serialized with cTransferMutex instead so that status requests
+				//*	to the same device are not held up by the transfer.
+		virtual	bool				IsConcurrentCommand(TYPE_GetPutRequestData *reqData);
+				pthread_mutex_t		cDeviceMutex;
+				pthread_mutex_t		cTransferMutex;
+
+				//=========================================================
+				//*	static response cache, entries are filled by the first GET
+				//*	and must be invalidated by the driver when the value changes
+				void				ResponseCache_Register(const char *commandName);
+				void				ResponseCache_Invalidate(const char *commandName = NULL);
+				int					ResponseCache_FindEntry(TYPE_GetPutRequestData *reqData, uint32_t *invalidateCnt);
+				bool				ResponseCache_Send(TYPE_GetPutRequestData *reqData, const int cacheIdx);
+				void				ResponseCache_Save(const int cacheIdx, const char *jsonBody, const uint32_t invalidateCnt);
+				pthread_mutex_t		cResponseCacheMutex;
+				TYPE_ResponseCache	cResponseCache[kMaxResponseCacheEntries];
+				int					cResponseCacheCnt;
+				uint32_t			cResponseCacheHits;
+				uint32_t			cResponseCacheMisses;
+				uint32_t			cResponseCacheInvalidates;
+				bool				cResponseIncludesContentData;	//*	true if ProcessCommand_SendResponse() echoes ContentData
+
 				//=========================================================
 				//*	command statistics
 				int					cTotalCmdsProcessed;
@@ -293,6 +365,17 @@ class AlpacaDriver
 				TYPE_CMD_STATS		cCommonCmdStats[kCmd_Common_last];
 				TYPE_CMD_STATS		cDeviceCmdStats[kDeviceCmdCnt];
 
+				//*	request latency, timed from the accept to the last byte written.
+				//*	The histograms are updated with atomic adds, no locking needed
+				void				RecordCmdLatency(TYPE_ASCOM_STATUS alpacaErrCode);
+				bool				GetCmdLatencySnapshot(const int entryIdx, char *cmdName, TYPE_LatencyHistogram *snapshot);
+				void				OutputMetrics_Prometheus(const int socketFD, const int metricFamily);
+				void				OutputMetrics_JSON(TYPE_GetPutRequestData *reqData, bool *firstEntry);
+		static	thread_local int	cCurrentCmdNum;			//*	set by RecordCmdStats(), -1 = unknown
+				TYPE_LatencyHistogram	cDeviceLatency;
+				TYPE_LatencyHistogram	cCommonCmdLatency[kCommonCmdCnt];
+				TYPE_LatencyHistogram	cDeviceCmdLatency[kDeviceCmdCnt];
+
 				//=========================================================
 				//*	discovery routines, allow a device to look for other devices
 				bool					SendDiscoveryQuery(void);
@@ -415,6 +498,7 @@ extern	AlpacaDriver	*gAlpacaDeviceList[];
 extern	int				gDeviceCnt;
 extern	bool			gLiveView;
 extern	bool			gAutoExposure;
+extern	int				gFrameRingDepth;
 extern	bool			gDisplayImage;
 extern	bool			gSimulateCameraImage;
 extern	bool			gVerbose;
@@ -433,6 +517,7 @@ extern	bool			gConformLogging;	//*	log all commands to log file to match up with
 extern	char			gFullVersionString[];
 extern	char			gHostName[];
 extern	const char		gHtmlHeader_html[];
+extern	TYPE_LatencyHistogram	gAllRequestLatency;
 
 #ifdef __cplusplus
 	extern "C" {
@@ -460,6 +545,14 @@ void			AddSupportedDevice(TYPE_DEVICETYPE argDeviceType, const char *manufacture
 }
 #endif
 
+//*	uses the keyword list parsed by ParseAlpacaRequest(), see alpacadriver_dispatch.c
+bool	GetKeyWordArgument(	const TYPE_GetPutRequestData	*reqData,
+							const char						*keyword,
+							char							*argument,
+							const int						maxArgLen,
+							const bool						ingoreCase=false,
+							const bool						argIsNumeric=false);
+
 
 #endif	//	_ALPACA_DRIVER_H_
 
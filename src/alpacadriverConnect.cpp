@@ -22,9 +22,11 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul msproul@skychariot.com
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jun 18,	2023	<MLS> Created alpacadriverConnect.cpp
 //*	Jun 18,	2023	<MLS> Added Put_Connect(), Put_Disconnect(), Get_Connecting()
+//*	Oct 18,	2026	<AGT> Connecting/disconnecting invalidates the static response cache
 //*****************************************************************************
 
 #define _ENABLE_CONSOLE_DEBUG_
@@ -63,7 +65,7 @@ bool				connectFlag;
 char				argumentString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Connected",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -77,6 +79,7 @@ char				argumentString[32];
 			if (connectFlag)
 			{
 				AlpacaConnect();
+				ResponseCache_Invalidate();
 				LogEvent(	reqData->deviceType,
 							"Connect",
 							NULL,
@@ -87,6 +90,7 @@ char				argumentString[32];
 			else
 			{
 				AlpacaDisConnect();
+				ResponseCache_Invalidate();
 				LogEvent(	reqData->deviceType,
 							"Dis-Connect",
 							NULL,
@@ -159,6 +163,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_NotImplemented;
 bool				isConnected;
 
 	isConnected				=	AlpacaConnect();
+	ResponseCache_Invalidate();
 	if (isConnected)
 	{
 		cCommonProp.Connected	=	true;
@@ -174,6 +179,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_NotImplemented;
 bool				disconnectOK;
 
 	disconnectOK				=	AlpacaDisConnect();
+	ResponseCache_Invalidate();
 	if (disconnectOK)
 	{
 		cCommonProp.Connected	=	false;
@@ -0,0 +1,846 @@
+//*****************************************************************************
+//*
+//*	Name:			alpacadriver_dispatch.c
+//*
+//*	Author:			agent (C) 2026
+//*
+//*	Description:	Command table and request argument lookups for the drivers
+//*
+//*	Usage notes:	FindCmdFromTable() used to strcasecmp() its way through the
+//*					device command table and then the common command table.
+//*					Each table now gets a case insensitive hash index the first time
+//*					it is used, the device commands are entered first so they still
+//*					win over a common command with the same name.
+//*
+//*					GetKeyWordArgument() used to re-scan the whole query string
+//*					for every keyword. The query string is now split into
+//*					keyword/value pairs once per request (RequestArgs_Parse())
+//*					using the same rules, and the lookups just compare the keywords.
+//*
+//*					make dispatchbench to compare against the original code
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created alpacadriver_dispatch.c
+//*****************************************************************************
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<stdbool.h>
+#include	<string.h>
+#include	<strings.h>
+#include	<pthread.h>
+
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"alpacadriver_helper.h"
+#include	"RequestData.h"
+#include	"alpacadriver_dispatch.h"
+
+//*****************************************************************************
+typedef struct
+{
+	const TYPE_CmdEntry	*cmdTable;
+	const TYPE_CmdEntry	*commonCmdTable;
+	unsigned int		hashMask;			//*	table size - 1, the size is a power of 2
+	const TYPE_CmdEntry	**hashTable;		//*	NULL = empty slot
+} TYPE_CmdTableIndex;
+
+//*	the entries are only added, never removed.
+//*	gCmdTableIndexCnt is read without the lock, it is only bumped after the entry is complete
+static	TYPE_CmdTableIndex	gCmdTableIndex[kMaxCmdTableIndexes];
+static	int					gCmdTableIndexCnt	=	0;
+static	pthread_mutex_t		gCmdTableIndexMutex	=	PTHREAD_MUTEX_INITIALIZER;
+
+//*****************************************************************************
+//*	FNV-1a, case insensitive.
+//*	(c | 0x20) is lower case for letters and leaves the rest alone as far as
+//*	strcasecmp() is concerned, it only has to be the same for strings that match
+//*****************************************************************************
+static inline unsigned int	HashKeyword(const char *keyword, const int keyLen)
+{
+unsigned int	hashValue;
+int				iii;
+
+	hashValue	=	2166136261u;
+	for (iii=0; iii<keyLen; iii++)
+	{
+		hashValue	^=	((unsigned char)keyword[iii] | 0x20);
+		hashValue	*=	16777619u;
+	}
+	return(hashValue);
+}
+
+//*****************************************************************************
+static const TYPE_CmdEntry	*HashLookup(const TYPE_CmdTableIndex *cmdIndex, const char *theCmd)
+{
+const TYPE_CmdEntry	*foundEntry;
+unsigned int		slotIdx;
+
+	foundEntry	=	NULL;
+	slotIdx		=	HashKeyword(theCmd, strlen(theCmd)) & cmdIndex->hashMask;
+	while ((foundEntry == NULL) && (cmdIndex->hashTable[slotIdx] != NULL))
+	{
+		if (strcasecmp(theCmd, cmdIndex->hashTable[slotIdx]->commandName) == 0)
+		{
+			foundEntry	=	cmdIndex->hashTable[slotIdx];
+		}
+		slotIdx	=	(slotIdx + 1) & cmdIndex->hashMask;
+	}
+	return(foundEntry);
+}
+
+//*****************************************************************************
+//*	the first entry with a given name wins, same as the linear search
+//*****************************************************************************
+static void	HashInsert(TYPE_CmdTableIndex *cmdIndex, const TYPE_CmdEntry *cmdEntry)
+{
+unsigned int		slotIdx;
+
+	if (HashLookup(cmdIndex, cmdEntry->commandName) == NULL)
+	{
+		slotIdx	=	HashKeyword(cmdEntry->commandName, strlen(cmdEntry->commandName)) & cmdIndex->hashMask;
+		while (cmdIndex->hashTable[slotIdx] != NULL)
+		{
+			slotIdx	=	(slotIdx + 1) & cmdIndex->hashMask;
+		}
+		cmdIndex->hashTable[slotIdx]	=	cmdEntry;
+	}
+}
+
+//*****************************************************************************
+static int	CountCmdEntries(const TYPE_CmdEntry *cmdTable)
+{
+int		entryCnt;
+
+	entryCnt	=	0;
+	if (cmdTable != NULL)
+	{
+		while (cmdTable[entryCnt].commandName[0] != 0)
+		{
+			entryCnt++;
+		}
+	}
+	return(entryCnt);
+}
+
+//*****************************************************************************
+//*	returns false if out of memory
+//*****************************************************************************
+static bool	BuildCmdTableIndex(	TYPE_CmdTableIndex	*cmdIndex,
+								const TYPE_CmdEntry	*theCmdTable,
+								const TYPE_CmdEntry	*commonCmdTable)
+{
+int				entryCnt;
+int				commonCnt;
+unsigned int	hashSize;
+int				iii;
+
+	entryCnt	=	CountCmdEntries(theCmdTable);
+	commonCnt	=	CountCmdEntries(commonCmdTable);
+
+	//*	keep it at least half empty so the probe sequences stay short
+	hashSize	=	16;
+	while (hashSize < (unsigned int)(2 * (entryCnt + commonCnt)))
+	{
+		hashSize	*=	2;
+	}
+	cmdIndex->cmdTable			=	theCmdTable;
+	cmdIndex->commonCmdTable	=	commonCmdTable;
+	cmdIndex->hashMask			=	hashSize - 1;
+	cmdIndex->hashTable			=	(const TYPE_CmdEntry **)calloc(hashSize, sizeof(TYPE_CmdEntry *));
+	if (cmdIndex->hashTable != NULL)
+	{
+		for (iii=0; iii<entryCnt; iii++)
+		{
+			HashInsert(cmdIndex, &theCmdTable[iii]);
+		}
+		for (iii=0; iii<commonCnt; iii++)
+		{
+			HashInsert(cmdIndex, &commonCmdTable[iii]);
+		}
+	}
+	return(cmdIndex->hashTable != NULL);
+}
+
+//*****************************************************************************
+//*	returns NULL if the table could not be indexed
+//*****************************************************************************
+static const TYPE_CmdTableIndex	*GetCmdTableIndex(const TYPE_CmdEntry *theCmdTable, const TYPE_CmdEntry *commonCmdTable)
+{
+const TYPE_CmdTableIndex	*cmdIndex;
+int							indexCnt;
+int							iii;
+
+	cmdIndex	=	NULL;
+	indexCnt	=	__atomic_load_n(&gCmdTableIndexCnt, __ATOMIC_ACQUIRE);
+	iii			=	0;
+	while ((cmdIndex == NULL) && (iii < indexCnt))
+	{
+		if ((gCmdTableIndex[iii].cmdTable == theCmdTable) && (gCmdTableIndex[iii].commonCmdTable == commonCmdTable))
+		{
+			cmdIndex	=	&gCmdTableIndex[iii];
+		}
+		iii++;
+	}
+
+	if (cmdIndex == NULL)
+	{
+		//*	first time for this table, another thread may be building it right now
+		pthread_mutex_lock(&gCmdTableIndexMutex);
+		iii	=	0;
+		while ((cmdIndex == NULL) && (iii < gCmdTableIndexCnt))
+		{
+			if ((gCmdTableIndex[iii].cmdTable == theCmdTable) && (gCmdTableIndex[iii].commonCmdTable == commonCmdTable))
+			{
+				cmdIndex	=	&gCmdTableIndex[iii];
+			}
+			iii++;
+		}
+		if ((cmdIndex == NULL) && (gCmdTableIndexCnt < kMaxCmdTableIndexes))
+		{
+			if (BuildCmdTableIndex(&gCmdTableIndex[gCmdTableIndexCnt], theCmdTable, commonCmdTable))
+			{
+				cmdIndex	=	&gCmdTableIndex[gCmdTableIndexCnt];
+				__atomic_store_n(&gCmdTableIndexCnt, (gCmdTableIndexCnt + 1), __ATOMIC_RELEASE);
+			}
+			else
+			{
+				CONSOLE_DEBUG("Failed to allocate command table index");
+			}
+		}
+		pthread_mutex_unlock(&gCmdTableIndexMutex);
+	}
+	return(cmdIndex);
+}
+
+//*****************************************************************************
+//*	used if there are more tables than kMaxCmdTableIndexes
+//*****************************************************************************
+static const TYPE_CmdEntry	*LinearCmdSearch(const char *theCmd, const TYPE_CmdEntry *cmdTable)
+{
+const TYPE_CmdEntry	*foundEntry;
+int					iii;
+
+	foundEntry	=	NULL;
+	iii			=	0;
+	while ((foundEntry == NULL) && (cmdTable != NULL) && (cmdTable[iii].commandName[0] != 0))
+	{
+		if (strcasecmp(theCmd, cmdTable[iii].commandName) == 0)
+		{
+			foundEntry	=	&cmdTable[iii];
+		}
+		iii++;
+	}
+	return(foundEntry);
+}
+
+//*****************************************************************************
+//*	returns -1 if not found
+//*****************************************************************************
+int	CmdTableIndex_Find(	const char			*theCmd,
+						const TYPE_CmdEntry	*theCmdTable,
+						const TYPE_CmdEntry	*commonCmdTable,
+						int					*cmdType)
+{
+const TYPE_CmdTableIndex	*cmdIndex;
+const TYPE_CmdEntry			*foundEntry;
+int							cmdEnumValue;
+
+	cmdIndex	=	GetCmdTableIndex(theCmdTable, commonCmdTable);
+	if (cmdIndex != NULL)
+	{
+		foundEntry	=	HashLookup(cmdIndex, theCmd);
+	}
+	else
+	{
+		foundEntry	=	LinearCmdSearch(theCmd, theCmdTable);
+		if (foundEntry == NULL)
+		{
+			foundEntry	=	LinearCmdSearch(theCmd, commonCmdTable);
+		}
+	}
+
+	cmdEnumValue	=	-1;
+	if (foundEntry != NULL)
+	{
+		cmdEnumValue	=	foundEntry->enumValue;
+		if (cmdType != NULL)
+		{
+			*cmdType	=	foundEntry->get_put;
+		}
+	}
+	return(cmdEnumValue);
+}
+
+//*****************************************************************************
+//*	Splits "keyword=value&keyword=value" into pairs, following the same rules
+//*	as the original GetKeyWordArgument() scan:
+//*		the keyword ends at "=", "&" or a control char
+//*		the value ends at "&", a space or a control char
+//*	If there are more than kMaxRequestArgs pairs, argsValid is false and the
+//*	lookups fall back to scanning the string.
+//*****************************************************************************
+void	RequestArgs_Parse(const char *contentData, TYPE_RequestArgIndex *argIndex)
+{
+int				dataSrcLen;
+int				iii;
+int				keyStart;
+int				keyLen;
+unsigned int	keyHash;
+int				valueStart;
+char			theChar;
+TYPE_RequestArg	*theArg;
+
+	argIndex->argsValid	=	true;
+	argIndex->argCount	=	0;
+	dataSrcLen			=	strlen(contentData);
+	keyStart			=	0;
+	keyHash				=	2166136261u;
+	iii					=	0;
+	while (iii <= dataSrcLen)
+	{
+		theChar	=	contentData[iii];
+		if ((theChar == '=') || (theChar == '&') || (theChar < 0x20))
+		{
+			keyLen	=	iii - keyStart;
+			if (theChar == '=')
+			{
+				iii	+=	1;			//*	skip the "="
+			}
+			valueStart	=	iii;
+			while ((contentData[iii] > 0x20) && (contentData[iii] != '&'))
+			{
+				iii++;
+			}
+			//*	an empty keyword can never be asked for
+			if (keyLen > 0)
+			{
+				if (argIndex->argCount < kMaxRequestArgs)
+				{
+					theArg				=	&argIndex->argList[argIndex->argCount];
+					theArg->keyOffset	=	keyStart;
+					theArg->keyLen		=	keyLen;
+					theArg->valueOffset	=	valueStart;
+					theArg->valueLen	=	iii - valueStart;
+					theArg->keyHash		=	keyHash;
+					argIndex->argCount++;
+				}
+				else
+				{
+					argIndex->argsValid	=	false;
+				}
+			}
+			keyStart	=	iii + 1;
+			keyHash		=	2166136261u;
+		}
+		else
+		{
+			//*	same as HashKeyword()
+			keyHash	^=	((unsigned char)theChar | 0x20);
+			keyHash	*=	16777619u;
+		}
+		iii++;
+	}
+}
+
+//*****************************************************************************
+//*	same results as GetKeyWordArgument() on the original string
+//*****************************************************************************
+bool	RequestArgs_Find(	const char					*contentData,
+							const TYPE_RequestArgIndex	*argIndex,
+							const char					*keyword,
+							char						*argument,
+							const int					maxArgLen,
+							const bool					ingoreCase,
+							const bool					argIsNumeric)
+{
+const TYPE_RequestArg	*theArg;
+bool					foundKeyWord;
+int						keyLen;
+unsigned int			keyHash;
+int						copyLen;
+int						iii;
+
+	foundKeyWord	=	false;
+	keyLen			=	strlen(keyword);
+	keyHash			=	HashKeyword(keyword, keyLen);
+	if (contentData[0] != 0)
+	{
+		argument[0]	=	0;
+	}
+	iii	=	0;
+	while ((foundKeyWord == false) && (iii < argIndex->argCount))
+	{
+		theArg	=	&argIndex->argList[iii];
+		if ((theArg->keyHash == keyHash) && (theArg->keyLen == keyLen))
+		{
+			//*	conformU wants us accept any case on GET and strict case on PUT
+			if ((strncmp(&contentData[theArg->keyOffset], keyword, keyLen) == 0) ||
+				(ingoreCase && (strncasecmp(&contentData[theArg->keyOffset], keyword, keyLen) == 0)))
+			{
+				foundKeyWord	=	true;
+				//*	leave room for the null termination
+				copyLen			=	theArg->valueLen;
+				if (copyLen > (maxArgLen - 2))
+				{
+					copyLen	=	maxArgLen - 2;
+				}
+				if (copyLen < 0)
+				{
+					copyLen	=	0;
+				}
+				memcpy(argument, &contentData[theArg->valueOffset], copyLen);
+				argument[copyLen]	=	0;
+				//*	in order to handle the comma char as a decimal point for Europe
+				if (argIsNumeric)
+				{
+					for (copyLen=0; argument[copyLen] != 0; copyLen++)
+					{
+						if (argument[copyLen] == ',')
+						{
+							argument[copyLen]	=	'.';	//*	replace with period
+						}
+					}
+				}
+			}
+		}
+		iii++;
+	}
+	return(foundKeyWord);
+}
+
+
+#ifdef _INCLUDE_DISPATCH_MAIN_
+//*****************************************************************************
+//*	make dispatchbench
+//*	compares the lookups against copies of the original linear searches
+//*****************************************************************************
+#include	<sys/time.h>
+#include	<ctype.h>
+
+#include	"common_AlpacaCmds.cpp"
+#include	"camera_AlpacaCmds.cpp"
+#include	"telescope_AlpacaCmds.cpp"
+
+#define	kBenchLoopCnt	200000
+
+//*****************************************************************************
+static double	GetElapsedMilliSecs(struct timeval *startTime)
+{
+struct timeval	endTime;
+
+	gettimeofday(&endTime, NULL);
+	return(((endTime.tv_sec - startTime->tv_sec) * 1000.0) + ((endTime.tv_usec - startTime->tv_usec) / 1000.0));
+}
+
+//*****************************************************************************
+//*	copy of the original FindCmdFromTable() from alpacadriver.cpp
+//*	(with the get_put from the common table fixed)
+//*****************************************************************************
+static int	OriginalFindCmdFromTable(const char *theCmd, const TYPE_CmdEntry *theCmdTable, int *cmdType)
+{
+int		iii;
+int		cmdEnumValue;
+
+	cmdEnumValue	=	-1;
+	iii				=	0;
+	while ((theCmdTable[iii].commandName[0] != 0) && (cmdEnumValue < 0))
+	{
+		if (strcasecmp(theCmd, theCmdTable[iii].commandName) == 0)
+		{
+			cmdEnumValue	=	theCmdTable[iii].enumValue;
+			*cmdType		=	theCmdTable[iii].get_put;
+		}
+		iii++;
+	}
+	if (cmdEnumValue < 0)
+	{
+		iii				=	0;
+		while ((gCommonCmdTable[iii].commandName[0] != 0) && (cmdEnumValue < 0))
+		{
+			if (strcasecmp(theCmd, gCommonCmdTable[iii].commandName) == 0)
+			{
+				cmdEnumValue	=	gCommonCmdTable[iii].enumValue;
+				*cmdType		=	gCommonCmdTable[iii].get_put;
+			}
+			iii++;
+		}
+	}
+	return(cmdEnumValue);
+}
+
+//*****************************************************************************
+//*	copy of the original GetKeyWordArgument() from alpacadriver.cpp
+//*****************************************************************************
+static bool	OriginalGetKeyWordArgument(	const char	*dataSource,
+										const char	*keyword,
+										char		*argument,
+										const int	maxArgLen,
+										const bool	ingoreCase,
+										const bool	argIsNumeric)
+{
+int		dataSrcLen;
+int		iii;
+int		jjj;
+bool	foundKeyWord;
+char	myKeyWord[256];
+char	myArgString[256];
+int		ccc;
+char	theChar;
+
+	foundKeyWord	=	false;
+	dataSrcLen		=	strlen(dataSource);
+	if (dataSrcLen > 0)
+	{
+		argument[0]	=	0;
+		iii			=	0;
+		ccc			=	0;
+		while ((foundKeyWord == false) && (iii <= dataSrcLen))
+		{
+			theChar	=	dataSource[iii];
+			if ((theChar == '=') || (theChar == '&') || (theChar < 0x20))
+			{
+				myKeyWord[ccc]		=	0;
+				if (dataSource[iii] == '=')
+				{
+					iii			+=	1;
+				}
+				jjj				=	0;
+				myArgString[0]	=	0;
+				while ((dataSource[iii] > 0x20) && (dataSource[iii] != '&') && (jjj < (maxArgLen - 2)))
+				{
+					myArgString[jjj]	=	dataSource[iii];
+					myArgString[jjj+1]	=	0;
+					iii++;
+					jjj++;
+				}
+				if ((strcmp(myKeyWord, keyword) == 0) ||
+					((strcasecmp(myKeyWord, keyword) == 0) && ingoreCase))
+				{
+					foundKeyWord	=	true;
+					if (argIsNumeric)
+					{
+						for (jjj=0; myArgString[jjj] != 0; jjj++)
+						{
+							if (myArgString[jjj] == ',')
+							{
+								myArgString[jjj]	=	'.';
+							}
+						}
+					}
+					strcpy(argument, myArgString);
+				}
+				ccc	=	0;
+			}
+			else
+			{
+				myKeyWord[ccc]		=	theChar;
+				myKeyWord[ccc+1]	=	0;
+				ccc++;
+			}
+			iii++;
+		}
+	}
+	return(foundKeyWord);
+}
+
+//*****************************************************************************
+static void	MixCase(const char *srcString, char *mixedString, const int seed)
+{
+int		iii;
+
+	for (iii=0; srcString[iii] != 0; iii++)
+	{
+		mixedString[iii]	=	((iii + seed) & 1) ? toupper(srcString[iii]) : srcString[iii];
+	}
+	mixedString[iii]	=	0;
+}
+
+//*****************************************************************************
+static const char	*gTestContent[]	=
+{
+	"ClientID=18194&ClientTransactionID=31&Duration=2.5&Light=true",
+	"Duration1=3&Duration=1,75&light=False&ClientTransactionID=7&ClientID=1",
+	"RightAscension=12.5&Declination=-45.25&ClientID=2&ClientTransactionID=1002",
+	"clienttransactionid=99&Connected=True",
+	"Object=M31&Prefix=m31_&Suffix=&Telescope=Newt 10&ClientID=3",
+	"ClientID=1&&=7&Name=abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz&Flag",
+	"ClientID=4&Position=1000 HTTP/1.1",
+	"",
+	NULL
+};
+
+//*****************************************************************************
+static const char	*gTestKeyWords[]	=
+{
+	"ClientID",
+	"ClientTransactionID",
+	"Duration",
+	"Duration1",
+	"Light",
+	"RightAscension",
+	"Declination",
+	"Connected",
+	"Object",
+	"Prefix",
+	"Suffix",
+	"Telescope",
+	"Name",
+	"Flag",
+	"Position",
+	"NotThere",
+	NULL
+};
+
+//*****************************************************************************
+static int	CheckCommands(const TYPE_CmdEntry *cmdTable, const TYPE_CmdEntry *otherTable)
+{
+int		errorCnt;
+int		iii;
+int		seed;
+int		origEnum;
+int		newEnum;
+int		origType;
+int		newType;
+char	mixedCmd[64];
+
+	errorCnt	=	0;
+	for (iii=0; otherTable[iii].commandName[0] != 0; iii++)
+	{
+		for (seed=0; seed<2; seed++)
+		{
+			MixCase(otherTable[iii].commandName, mixedCmd, seed);
+			origType	=	-1;
+			newType		=	-1;
+			origEnum	=	OriginalFindCmdFromTable(mixedCmd, cmdTable, &origType);
+			newEnum		=	CmdTableIndex_Find(mixedCmd, cmdTable, gCommonCmdTable, &newType);
+			if ((origEnum != newEnum) || (origType != newType))
+			{
+				printf("Command mismatch on %s: %d/%d %d/%d\r\n", mixedCmd, origEnum, newEnum, origType, newType);
+				errorCnt++;
+			}
+		}
+	}
+	origEnum	=	OriginalFindCmdFromTable("nosuchcommand", cmdTable, &origType);
+	newEnum		=	CmdTableIndex_Find("nosuchcommand", cmdTable, gCommonCmdTable, &newType);
+	if (origEnum != newEnum)
+	{
+		printf("Command mismatch on nosuchcommand\r\n");
+		errorCnt++;
+	}
+	return(errorCnt);
+}
+
+//*****************************************************************************
+static int	CheckArguments(void)
+{
+TYPE_RequestArgIndex	argIndex;
+int						errorCnt;
+int						contentIdx;
+int						keywordIdx;
+int						option;
+int						maxArgLen;
+bool					origFound;
+bool					newFound;
+char					origArg[64];
+char					newArg[64];
+char					mixedKey[64];
+
+	errorCnt	=	0;
+	for (contentIdx=0; gTestContent[contentIdx] != NULL; contentIdx++)
+	{
+		RequestArgs_Parse(gTestContent[contentIdx], &argIndex);
+		for (keywordIdx=0; gTestKeyWords[keywordIdx] != NULL; keywordIdx++)
+		{
+			//*	bit 0 = mixed case keyword, bit 1 = ignore case, bit 2 = numeric, bit 3 = short buffer
+			for (option=0; option<16; option++)
+			{
+				maxArgLen	=	(option & 8) ? 8 : sizeof(origArg);
+				if (option & 1)
+				{
+					MixCase(gTestKeyWords[keywordIdx], mixedKey, 1);
+				}
+				else
+				{
+					strcpy(mixedKey, gTestKeyWords[keywordIdx]);
+				}
+				strcpy(origArg, "unchanged");
+				strcpy(newArg, "unchanged");
+				origFound	=	OriginalGetKeyWordArgument(	gTestContent[contentIdx], mixedKey, origArg,
+															maxArgLen, (option & 2), (option & 4));
+				newFound	=	RequestArgs_Find(	gTestContent[contentIdx], &argIndex, mixedKey, newArg,
+												maxArgLen, (option & 2), (option & 4));
+				if ((origFound != newFound) || (strcmp(origArg, newArg) != 0))
+				{
+					printf("Argument mismatch on \"%s\" %s option %d: %d \"%s\" %d \"%s\"\r\n",
+												gTestContent[contentIdx], mixedKey, option,
+												origFound, origArg, newFound, newArg);
+					errorCnt++;
+				}
+			}
+		}
+	}
+	return(errorCnt);
+}
+
+//*****************************************************************************
+//*	more than kMaxRequestArgs pairs, the index is not valid and
+//*	GetKeyWordArgument(reqData...) has to scan contentData the old way
+//*****************************************************************************
+static int	CheckManyArguments(void)
+{
+TYPE_RequestArgIndex	argIndex;
+int						errorCnt;
+int						argNum;
+int						contentLen;
+bool					foundKeyWord;
+char					contentData[1024];
+char					keyword[32];
+char					expectedArg[32];
+char					argument[32];
+
+	errorCnt	=	0;
+	contentLen	=	0;
+	for (argNum=0; argNum<(kMaxRequestArgs + 8); argNum++)
+	{
+		contentLen	+=	sprintf(&contentData[contentLen], "%sArg%d=%d", ((argNum > 0) ? "&" : ""), argNum, argNum * 10);
+	}
+	RequestArgs_Parse(contentData, &argIndex);
+	if (argIndex.argsValid || (argIndex.argCount != kMaxRequestArgs))
+	{
+		printf("%d args: argsValid=%d argCount=%d\r\n", (kMaxRequestArgs + 8), argIndex.argsValid, argIndex.argCount);
+		errorCnt++;
+	}
+	for (argNum=0; argNum<(kMaxRequestArgs + 8); argNum++)
+	{
+		sprintf(keyword,		"Arg%d",	argNum);
+		sprintf(expectedArg,	"%d",		argNum * 10);
+		strcpy(argument, "unchanged");
+		if (argIndex.argsValid)
+		{
+			foundKeyWord	=	RequestArgs_Find(contentData, &argIndex, keyword, argument, sizeof(argument), false, false);
+		}
+		else
+		{
+			foundKeyWord	=	OriginalGetKeyWordArgument(contentData, keyword, argument, sizeof(argument), false, false);
+		}
+		if ((foundKeyWord == false) || (strcmp(argument, expectedArg) != 0))
+		{
+			printf("%d args: %s found=%d \"%s\"\r\n", (kMaxRequestArgs + 8), keyword, foundKeyWord, argument);
+			errorCnt++;
+		}
+	}
+	return(errorCnt);
+}
+
+//*****************************************************************************
+//*	what every PUT goes through, find the command, ClientID, ClientTransactionID
+//*	and the 2 arguments the command needs
+//*****************************************************************************
+static const char	*gBenchCommands[]	=
+{
+	"exposuretime",	"startexposure",	"imagearray",	"camerastate",	"connected",
+	"description",	"binx",				"gain",			"percentcompleted",	"supportedactions",
+	NULL
+};
+
+//*****************************************************************************
+int	main(int argc, char *argv[])
+{
+TYPE_RequestArgIndex	argIndex;
+struct timeval			startTime;
+const char				*contentData;
+int						errorCnt;
+int						loopCnt;
+int						cmdIdx;
+int						cmdType;
+int						checkSum_Original;
+int						checkSum_New;
+double					milliSecs_CmdOriginal;
+double					milliSecs_CmdNew;
+double					milliSecs_ArgOriginal;
+double					milliSecs_ArgNew;
+char					argumentString[64];
+
+	errorCnt	=	0;
+	errorCnt	+=	CheckCommands(gCameraCmdTable,		gCameraCmdTable);
+	errorCnt	+=	CheckCommands(gCameraCmdTable,		gCommonCmdTable);
+	errorCnt	+=	CheckCommands(gCameraCmdTable,		gTelescopeCmdTable);
+	errorCnt	+=	CheckCommands(gTelescopeCmdTable,	gTelescopeCmdTable);
+	errorCnt	+=	CheckCommands(gTelescopeCmdTable,	gCommonCmdTable);
+	errorCnt	+=	CheckCommands(gTelescopeCmdTable,	gCameraCmdTable);
+	errorCnt	+=	CheckArguments();
+	errorCnt	+=	CheckManyArguments();
+	printf("Equivalence check: %d errors\r\n", errorCnt);
+
+	//*	command lookup
+	checkSum_Original	=	0;
+	gettimeofday(&startTime, NULL);
+	for (loopCnt=0; loopCnt<kBenchLoopCnt; loopCnt++)
+	{
+		for (cmdIdx=0; gBenchCommands[cmdIdx] != NULL; cmdIdx++)
+		{
+			checkSum_Original	+=	OriginalFindCmdFromTable(gBenchCommands[cmdIdx], gCameraCmdTable, &cmdType);
+		}
+	}
+	milliSecs_CmdOriginal	=	GetElapsedMilliSecs(&startTime);
+
+	checkSum_New	=	0;
+	gettimeofday(&startTime, NULL);
+	for (loopCnt=0; loopCnt<kBenchLoopCnt; loopCnt++)
+	{
+		for (cmdIdx=0; gBenchCommands[cmdIdx] != NULL; cmdIdx++)
+		{
+			checkSum_New	+=	CmdTableIndex_Find(gBenchCommands[cmdIdx], gCameraCmdTable, gCommonCmdTable, &cmdType);
+		}
+	}
+	milliSecs_CmdNew	=	GetElapsedMilliSecs(&startTime);
+	if (checkSum_Original != checkSum_New)
+	{
+		printf("Command checksum mismatch\r\n");
+		errorCnt++;
+	}
+
+	//*	argument lookups for a typical PUT
+	contentData			=	"ClientID=18194&ClientTransactionID=31&Duration=2.5&Light=true";
+	checkSum_Original	=	0;
+	gettimeofday(&startTime, NULL);
+	for (loopCnt=0; loopCnt<kBenchLoopCnt; loopCnt++)
+	{
+		checkSum_Original	+=	OriginalGetKeyWordArgument(contentData, "ClientID", argumentString, 31, false, false);
+		checkSum_Original	+=	OriginalGetKeyWordArgument(contentData, "ClientTransactionID", argumentString, 31, true, false);
+		checkSum_Original	+=	OriginalGetKeyWordArgument(contentData, "Duration", argumentString, 31, false, true);
+		checkSum_Original	+=	OriginalGetKeyWordArgument(contentData, "Light", argumentString, 31, false, false);
+	}
+	milliSecs_ArgOriginal	=	GetElapsedMilliSecs(&startTime);
+
+	checkSum_New	=	0;
+	gettimeofday(&startTime, NULL);
+	for (loopCnt=0; loopCnt<kBenchLoopCnt; loopCnt++)
+	{
+		RequestArgs_Parse(contentData, &argIndex);
+		checkSum_New	+=	RequestArgs_Find(contentData, &argIndex, "ClientID", argumentString, 31, false, false);
+		checkSum_New	+=	RequestArgs_Find(contentData, &argIndex, "ClientTransactionID", argumentString, 31, true, false);
+		checkSum_New	+=	RequestArgs_Find(contentData, &argIndex, "Duration", argumentString, 31, false, true);
+		checkSum_New	+=	RequestArgs_Find(contentData, &argIndex, "Light", argumentString, 31, false, false);
+	}
+	milliSecs_ArgNew	=	GetElapsedMilliSecs(&startTime);
+	if (checkSum_Original != checkSum_New)
+	{
+		printf("Argument checksum mismatch\r\n");
+		errorCnt++;
+	}
+
+	printf("Command lookup (ns per command)   original %7.1f   hashed %7.1f\r\n",
+							(milliSecs_CmdOriginal * 1.0e6) / (kBenchLoopCnt * cmdIdx),
+							(milliSecs_CmdNew * 1.0e6) / (kBenchLoopCnt * cmdIdx));
+	printf("4 arguments (ns per request)      original %7.1f   parsed %7.1f\r\n",
+							(milliSecs_ArgOriginal * 1.0e6) / kBenchLoopCnt,
+							(milliSecs_ArgNew * 1.0e6) / kBenchLoopCnt);
+	return(errorCnt);
+}
+#endif	//	_INCLUDE_DISPATCH_MAIN_
@@ -0,0 +1,51 @@
+//*****************************************************************************
+//*	Name:			alpacadriver_dispatch.h
+//*
+//*	Author:			agent
+//*
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created alpacadriver_dispatch.h
+//*****************************************************************************
+//#include	"alpacadriver_dispatch.h"
+
+#ifndef _ALPACADRIVER_DISPATCH_H_
+#define	_ALPACADRIVER_DISPATCH_H_
+
+#ifndef _ALPACA_HELPER_H_
+	#include	"alpacadriver_helper.h"
+#endif
+
+#ifndef _REQUESTDATA_H_
+	#include	"RequestData.h"
+#endif
+
+#define	kMaxCmdTableIndexes		32		//*	one for each command table that is looked up
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//*	returns -1 if not found, the device table is checked before the common table
+int		CmdTableIndex_Find(	const char			*theCmd,
+							const TYPE_CmdEntry	*theCmdTable,
+							const TYPE_CmdEntry	*commonCmdTable,
+							int					*cmdType);
+
+void	RequestArgs_Parse(const char *contentData, TYPE_RequestArgIndex *argIndex);
+bool	RequestArgs_Find(	const char					*contentData,
+							const TYPE_RequestArgIndex	*argIndex,
+							const char					*keyword,
+							char						*argument,
+							const int					maxArgLen,
+							const bool					ingoreCase,
+							const bool					argIsNumeric);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif		//	_ALPACADRIVER_DISPATCH_H_
@@ -0,0 +1,653 @@
+//*****************************************************************************
+//*
+//*	Name:			async_com.c
+//*
+//*	Author:			agent (C) 2026
+//*
+//*	Description:	Pipelined command/response transport for serial ports and TCP sockets
+//*
+//*	Usage notes:	The old way was to send one command, then read one char at a time
+//*					until the response was complete or the read timed out, with a
+//*					usleep() after every command. The LX200 code read until the socket
+//*					timeout, so every command took 1/2 second.
+//*
+//*					Commands are now queued with AsyncCom_QueueCmd(), up to maxInFlight
+//*					of them are written to the device in one write() and the responses
+//*					are matched to the commands in order as the data comes in.
+//*					The protocol supplies a framer that says where each response ends.
+//*					Each command has its own time out, the done proc gets called
+//*					with the response or the reason it failed.
+//*
+//*					AsyncCom_Process() should only be called from one thread,
+//*					commands can be queued from any thread.
+//*
+//*					The responses are matched by order, so a time out fails every command
+//*					in flight, not just the oldest one, a late response would otherwise be
+//*					taken as the answer to the next command. Nothing more is sent until
+//*					the line has been quiet for kAsyncDrainQuiet_ms, anything that comes
+//*					in until then is thrown away.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created async_com.c
+//*	Oct 18,	2026	<AGT> A time out fails every command in flight and drains the line
+//*****************************************************************************
+
+//#define	_DEBUG_ASYNC_COM_
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<unistd.h>
+#include	<stdbool.h>
+#include	<stdint.h>
+#include	<string.h>
+#include	<time.h>
+#include	<errno.h>
+#include	<fcntl.h>
+#include	<poll.h>
+#include	<pthread.h>
+#include	<sys/types.h>
+#include	<sys/stat.h>
+#include	<sys/socket.h>
+
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"async_com.h"
+
+#define	kAsyncWriteTimeOut_ms	100
+
+//*****************************************************************************
+static long	GetAsyncMilliSecs(void)
+{
+struct timespec	currentTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+	return((currentTime.tv_sec * 1000L) + (currentTime.tv_nsec / 1000000L));
+}
+
+//*****************************************************************************
+//*	the default framer handles the common cases,
+//*	a protocol framer can handle its own types and call this for the rest
+//*****************************************************************************
+int	AsyncCom_DefaultFramer(const char *rxData, const int rxLen, const int responseType, const char terminator)
+{
+int		frameLen;
+int		iii;
+
+	frameLen	=	0;
+	switch(responseType)
+	{
+		case kAsyncResp_None:
+			break;
+
+		case kAsyncResp_OneChar:
+			if (rxLen > 0)
+			{
+				frameLen	=	1;
+			}
+			break;
+
+		case kAsyncResp_Terminated:
+		default:
+			iii	=	0;
+			while ((frameLen == 0) && (iii < rxLen))
+			{
+				if (rxData[iii] == terminator)
+				{
+					frameLen	=	iii + 1;
+				}
+				iii++;
+			}
+			break;
+	}
+	return(frameLen);
+}
+
+//*****************************************************************************
+void	AsyncCom_Init(	TYPE_ASYNCCOM	*asyncCom,
+						AsyncFramerProc	framerProc,
+						const char		terminator,
+						const int		maxInFlight)
+{
+int		iii;
+
+	memset((void *)asyncCom, 0, sizeof(TYPE_ASYNCCOM));
+	asyncCom->fileDesc		=	-1;
+	asyncCom->terminator	=	terminator;
+	asyncCom->framerProc	=	(framerProc != NULL) ? framerProc : AsyncCom_DefaultFramer;
+	asyncCom->maxInFlight	=	maxInFlight;
+	if (asyncCom->maxInFlight < 1)
+	{
+		asyncCom->maxInFlight	=	1;
+	}
+	if (asyncCom->maxInFlight > kAsyncMaxCmds)
+	{
+		asyncCom->maxInFlight	=	kAsyncMaxCmds;
+	}
+	pthread_mutex_init(&asyncCom->queueMutex, NULL);
+
+	if (pipe(asyncCom->wakeUpPipe) == 0)
+	{
+		for (iii=0; iii<2; iii++)
+		{
+			fcntl(asyncCom->wakeUpPipe[iii], F_SETFL, (fcntl(asyncCom->wakeUpPipe[iii], F_GETFL) | O_NONBLOCK));
+		}
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_NUM("pipe() failed, errno\t=", errno);
+		asyncCom->wakeUpPipe[0]	=	-1;
+		asyncCom->wakeUpPipe[1]	=	-1;
+	}
+}
+
+//*****************************************************************************
+//*	the file descriptor still belongs to the caller, it is not closed here
+//*****************************************************************************
+void	AsyncCom_Open(TYPE_ASYNCCOM *asyncCom, const int fileDesc)
+{
+struct stat	fileStatus;
+
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	asyncCom->fileDesc	=	fileDesc;
+	asyncCom->isSocket	=	false;
+	if (fstat(fileDesc, &fileStatus) == 0)
+	{
+		asyncCom->isSocket	=	S_ISSOCK(fileStatus.st_mode);
+	}
+	asyncCom->rxLen			=	0;
+	asyncCom->inFlightCnt	=	0;
+	asyncCom->drainUntil_ms	=	0;
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+}
+
+//*****************************************************************************
+//*	removes the oldest command and calls its done proc
+//*****************************************************************************
+static void	FinishOldestCmd(TYPE_ASYNCCOM *asyncCom, const char *responseString, const int status)
+{
+TYPE_ASYNC_CMD	asyncCmd;
+bool			cmdValid;
+
+	cmdValid	=	false;
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	if (asyncCom->queuedCnt > 0)
+	{
+		asyncCmd				=	asyncCom->cmdQueue[asyncCom->queueHead];
+		asyncCom->queueHead		=	(asyncCom->queueHead + 1) % kAsyncMaxCmds;
+		asyncCom->queuedCnt--;
+		if (asyncCom->inFlightCnt > 0)
+		{
+			asyncCom->inFlightCnt--;
+		}
+		cmdValid	=	true;
+	}
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+
+	//*	called without the lock so that the done proc can queue more commands
+	if (cmdValid && (asyncCmd.doneProc != NULL))
+	{
+		asyncCmd.doneProc(	asyncCmd.userData,
+							asyncCmd.cmdID,
+							asyncCmd.cmdString,
+							((responseString != NULL) ? responseString : ""),
+							status);
+	}
+}
+
+//*****************************************************************************
+//*	anything in flight or waiting gets kAsyncStatus_Closed
+//*****************************************************************************
+void	AsyncCom_Close(TYPE_ASYNCCOM *asyncCom)
+{
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	asyncCom->fileDesc	=	-1;
+	asyncCom->rxLen		=	0;
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+
+	while (AsyncCom_PendingCnt(asyncCom) > 0)
+	{
+		FinishOldestCmd(asyncCom, NULL, kAsyncStatus_Closed);
+	}
+}
+
+//*****************************************************************************
+//*	returns false if the queue is full or the command is too long
+//*****************************************************************************
+bool	AsyncCom_QueueCmd(	TYPE_ASYNCCOM	*asyncCom,
+							const char		*cmdString,
+							const int		cmdID,
+							const int		responseType,
+							const int		timeOut_ms,
+							AsyncDoneProc	doneProc,
+							void			*userData)
+{
+TYPE_ASYNC_CMD	*asyncCmd;
+int				cmdLen;
+bool			queuedOK;
+char			wakeUpChar;
+ssize_t			bytesWritten;
+
+	queuedOK	=	false;
+	cmdLen		=	strlen(cmdString);
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	if ((asyncCom->queuedCnt < kAsyncMaxCmds) && (cmdLen < kAsyncMaxCmdLen))
+	{
+		asyncCmd	=	&asyncCom->cmdQueue[(asyncCom->queueHead + asyncCom->queuedCnt) % kAsyncMaxCmds];
+		strcpy(asyncCmd->cmdString, cmdString);
+		asyncCmd->cmdLen		=	cmdLen;
+		asyncCmd->cmdID			=	cmdID;
+		asyncCmd->responseType	=	responseType;
+		asyncCmd->timeOut_ms	=	(timeOut_ms > 0) ? timeOut_ms : kAsyncDefaultTimeOut_ms;
+		asyncCmd->sentTime_ms	=	0;
+		asyncCmd->doneProc		=	doneProc;
+		asyncCmd->userData		=	userData;
+		asyncCom->queuedCnt++;
+		queuedOK	=	true;
+	}
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+
+	if (queuedOK)
+	{
+		if (asyncCom->wakeUpPipe[1] >= 0)
+		{
+			wakeUpChar		=	'W';
+			bytesWritten	=	write(asyncCom->wakeUpPipe[1], &wakeUpChar, 1);
+			(void)bytesWritten;		//*	if the pipe is full, there is already a wake up pending
+		}
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_STR("Command queue full, dropped\t=", cmdString);
+	}
+	return(queuedOK);
+}
+
+//*****************************************************************************
+//*	removes the commands that have not been sent yet, i.e. for abort
+//*	returns the number removed
+//*****************************************************************************
+int	AsyncCom_Flush(TYPE_ASYNCCOM *asyncCom)
+{
+TYPE_ASYNC_CMD	flushedCmds[kAsyncMaxCmds];
+int				flushedCnt;
+int				iii;
+
+	flushedCnt	=	0;
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	for (iii=asyncCom->inFlightCnt; iii<asyncCom->queuedCnt; iii++)
+	{
+		flushedCmds[flushedCnt++]	=	asyncCom->cmdQueue[(asyncCom->queueHead + iii) % kAsyncMaxCmds];
+	}
+	asyncCom->queuedCnt	=	asyncCom->inFlightCnt;
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+
+	for (iii=0; iii<flushedCnt; iii++)
+	{
+		if (flushedCmds[iii].doneProc != NULL)
+		{
+			flushedCmds[iii].doneProc(	flushedCmds[iii].userData,
+										flushedCmds[iii].cmdID,
+										flushedCmds[iii].cmdString,
+										"",
+										kAsyncStatus_Flushed);
+		}
+	}
+	return(flushedCnt);
+}
+
+//*****************************************************************************
+int	AsyncCom_PendingCnt(TYPE_ASYNCCOM *asyncCom)
+{
+int		pendingCnt;
+
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	pendingCnt	=	asyncCom->queuedCnt;
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+	return(pendingCnt);
+}
+
+//*****************************************************************************
+static bool	WriteAll(TYPE_ASYNCCOM *asyncCom, const char *xmitBuffer, const int xmitLen)
+{
+struct pollfd	pollFD;
+int				xmitSent;
+ssize_t			bytesWritten;
+bool			writeOK;
+
+	xmitSent	=	0;
+	writeOK		=	true;
+	while (writeOK && (xmitSent < xmitLen))
+	{
+		if (asyncCom->isSocket)
+		{
+			bytesWritten	=	send(asyncCom->fileDesc, &xmitBuffer[xmitSent], (xmitLen - xmitSent), MSG_NOSIGNAL);
+		}
+		else
+		{
+			bytesWritten	=	write(asyncCom->fileDesc, &xmitBuffer[xmitSent], (xmitLen - xmitSent));
+		}
+		if (bytesWritten > 0)
+		{
+			xmitSent	+=	bytesWritten;
+		}
+		else if ((bytesWritten < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+		{
+			pollFD.fd		=	asyncCom->fileDesc;
+			pollFD.events	=	POLLOUT;
+			pollFD.revents	=	0;
+			writeOK			=	(poll(&pollFD, 1, kAsyncWriteTimeOut_ms) > 0);
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("write failed, errno\t=", errno);
+			writeOK	=	false;
+		}
+	}
+	return(writeOK);
+}
+
+//*****************************************************************************
+//*	all of the commands that fit in the pipeline go out in one write
+//*****************************************************************************
+static bool	SendWaitingCmds(TYPE_ASYNCCOM *asyncCom, const long currentMilliSecs)
+{
+char			xmitBuffer[kAsyncMaxCmds * kAsyncMaxCmdLen];
+int				xmitLen;
+TYPE_ASYNC_CMD	*asyncCmd;
+bool			writeOK;
+
+	xmitLen	=	0;
+	pthread_mutex_lock(&asyncCom->queueMutex);
+	while ((asyncCom->inFlightCnt < asyncCom->queuedCnt) && (asyncCom->inFlightCnt < asyncCom->maxInFlight))
+	{
+		asyncCmd	=	&asyncCom->cmdQueue[(asyncCom->queueHead + asyncCom->inFlightCnt) % kAsyncMaxCmds];
+		memcpy(&xmitBuffer[xmitLen], asyncCmd->cmdString, asyncCmd->cmdLen);
+		xmitLen					+=	asyncCmd->cmdLen;
+		asyncCmd->sentTime_ms	=	currentMilliSecs;
+		asyncCom->inFlightCnt++;
+		asyncCom->cmdsSentCnt++;
+	}
+	pthread_mutex_unlock(&asyncCom->queueMutex);
+
+	writeOK	=	true;
+	if (xmitLen > 0)
+	{
+	#ifdef _DEBUG_ASYNC_COM_
+		xmitBuffer[xmitLen]	=	0;
+		CONSOLE_DEBUG_W_STR("xmit\t=", xmitBuffer);
+	#endif
+		writeOK	=	WriteAll(asyncCom, xmitBuffer, xmitLen);
+	}
+	return(writeOK);
+}
+
+//*****************************************************************************
+static void	RemoveRxData(TYPE_ASYNCCOM *asyncCom, const int removeCnt)
+{
+	if (removeCnt >= asyncCom->rxLen)
+	{
+		asyncCom->rxLen	=	0;
+	}
+	else
+	{
+		asyncCom->rxLen	-=	removeCnt;
+		memmove(asyncCom->rxBuffer, &asyncCom->rxBuffer[removeCnt], asyncCom->rxLen);
+	}
+	asyncCom->rxBuffer[asyncCom->rxLen]	=	0;
+}
+
+//*****************************************************************************
+static void	DiscardRxData(TYPE_ASYNCCOM *asyncCom, const int discardCnt)
+{
+	asyncCom->discardedByteCnt	+=	(discardCnt < asyncCom->rxLen) ? discardCnt : asyncCom->rxLen;
+	RemoveRxData(asyncCom, discardCnt);
+}
+
+//*****************************************************************************
+//*	matches the received data to the commands in flight, oldest first
+//*	returns the number of commands finished
+//*****************************************************************************
+static int	ProcessRxData(TYPE_ASYNCCOM *asyncCom, const long currentMilliSecs)
+{
+char			responseString[kAsyncMaxResponseLen];
+bool			headInFlight;
+int				responseType;
+long			sentTime_ms;
+int				frameLen;
+int				copyLen;
+int				finishedCnt;
+bool			keepGoing;
+
+	finishedCnt	=	0;
+	keepGoing	=	true;
+	while (keepGoing)
+	{
+		pthread_mutex_lock(&asyncCom->queueMutex);
+		headInFlight	=	(asyncCom->inFlightCnt > 0);
+		responseType	=	asyncCom->cmdQueue[asyncCom->queueHead].responseType;
+		sentTime_ms		=	asyncCom->cmdQueue[asyncCom->queueHead].sentTime_ms;
+		pthread_mutex_unlock(&asyncCom->queueMutex);
+
+		if (headInFlight == false)
+		{
+			//*	nobody asked for this
+			if (asyncCom->rxLen > 0)
+			{
+				DiscardRxData(asyncCom, asyncCom->rxLen);
+			}
+			keepGoing	=	false;
+		}
+		else if (responseType == kAsyncResp_None)
+		{
+			FinishOldestCmd(asyncCom, NULL, kAsyncStatus_OK);
+			finishedCnt++;
+		}
+		else if (asyncCom->rxLen == 0)
+		{
+			keepGoing	=	false;
+		}
+		else
+		{
+			frameLen	=	asyncCom->framerProc(asyncCom->rxBuffer, asyncCom->rxLen, responseType, asyncCom->terminator);
+			if (frameLen > 0)
+			{
+				copyLen	=	(frameLen < kAsyncMaxResponseLen) ? frameLen : (kAsyncMaxResponseLen - 1);
+				memcpy(responseString, asyncCom->rxBuffer, copyLen);
+				responseString[copyLen]	=	0;
+				RemoveRxData(asyncCom, frameLen);
+
+				asyncCom->responseCnt++;
+				if ((currentMilliSecs - sentTime_ms) > asyncCom->maxResponse_ms)
+				{
+					asyncCom->maxResponse_ms	=	currentMilliSecs - sentTime_ms;
+				}
+			#ifdef _DEBUG_ASYNC_COM_
+				CONSOLE_DEBUG_W_STR("response\t=", responseString);
+			#endif
+				FinishOldestCmd(asyncCom, responseString, kAsyncStatus_OK);
+				finishedCnt++;
+			}
+			else if (frameLen < 0)
+			{
+				DiscardRxData(asyncCom, -frameLen);
+			}
+			else
+			{
+				//*	not all here yet, if the buffer is full it is never going to be
+				if (asyncCom->rxLen >= kAsyncRxBuffLen)
+				{
+					CONSOLE_DEBUG("Receive buffer full without a complete response");
+					DiscardRxData(asyncCom, asyncCom->rxLen);
+				}
+				keepGoing	=	false;
+			}
+		}
+	}
+	return(finishedCnt);
+}
+
+//*****************************************************************************
+//*	sends what it can, waits up to maxWait_ms for data or a new command,
+//*	calls the done procs for everything that finished.
+//*	returns the number of commands finished, -1 if the connection failed
+//*****************************************************************************
+int	AsyncCom_Process(TYPE_ASYNCCOM *asyncCom, const int maxWait_ms)
+{
+struct pollfd	pollFDs[2];
+int				pollCnt;
+int				pollRetCode;
+int				waitTime_ms;
+long			currentMilliSecs;
+long			deadline_ms;
+bool			headInFlight;
+bool			headTimedOut;
+int				inFlightCnt;
+bool			connectionOK;
+int				finishedCnt;
+ssize_t			readCnt;
+char			drainBuffer[32];
+
+	finishedCnt		=	0;
+	connectionOK	=	(asyncCom->fileDesc >= 0);
+	if (connectionOK)
+	{
+		currentMilliSecs	=	GetAsyncMilliSecs();
+		if ((asyncCom->drainUntil_ms > 0) && (currentMilliSecs >= asyncCom->drainUntil_ms))
+		{
+			//*	the line has gone quiet, the late responses are done
+			asyncCom->drainUntil_ms	=	0;
+		}
+		if (asyncCom->drainUntil_ms == 0)
+		{
+			connectionOK		=	SendWaitingCmds(asyncCom, currentMilliSecs);
+		}
+		finishedCnt			+=	ProcessRxData(asyncCom, currentMilliSecs);
+	}
+
+	if (connectionOK)
+	{
+		//*	dont wait past the time out of the oldest command or the end of the drain
+		waitTime_ms	=	maxWait_ms;
+		pthread_mutex_lock(&asyncCom->queueMutex);
+		headInFlight	=	(asyncCom->inFlightCnt > 0);
+		deadline_ms		=	asyncCom->cmdQueue[asyncCom->queueHead].sentTime_ms +
+							asyncCom->cmdQueue[asyncCom->queueHead].timeOut_ms;
+		pthread_mutex_unlock(&asyncCom->queueMutex);
+		if (asyncCom->drainUntil_ms > 0)
+		{
+			headInFlight	=	true;
+			deadline_ms		=	asyncCom->drainUntil_ms;
+		}
+		if (headInFlight && ((deadline_ms - currentMilliSecs) < waitTime_ms))
+		{
+			waitTime_ms	=	deadline_ms - currentMilliSecs;
+			if (waitTime_ms < 0)
+			{
+				waitTime_ms	=	0;
+			}
+		}
+
+		pollFDs[0].fd		=	asyncCom->fileDesc;
+		pollFDs[0].events	=	POLLIN;
+		pollFDs[0].revents	=	0;
+		pollCnt				=	1;
+		if (asyncCom->wakeUpPipe[0] >= 0)
+		{
+			pollFDs[1].fd		=	asyncCom->wakeUpPipe[0];
+			pollFDs[1].events	=	POLLIN;
+			pollFDs[1].revents	=	0;
+			pollCnt				=	2;
+		}
+		pollRetCode	=	poll(pollFDs, pollCnt, waitTime_ms);
+		if (pollRetCode > 0)
+		{
+			if ((pollCnt > 1) && (pollFDs[1].revents & POLLIN))
+			{
+				while (read(asyncCom->wakeUpPipe[0], drainBuffer, sizeof(drainBuffer)) > 0)
+				{
+					//*	the commands get sent next time through
+				}
+			}
+			if (pollFDs[0].revents & (POLLIN | POLLHUP | POLLERR))
+			{
+				readCnt	=	read(	asyncCom->fileDesc,
+									&asyncCom->rxBuffer[asyncCom->rxLen],
+									(kAsyncRxBuffLen - asyncCom->rxLen));
+				if (readCnt > 0)
+				{
+					asyncCom->rxLen						+=	readCnt;
+					asyncCom->rxBuffer[asyncCom->rxLen]	=	0;
+					if (asyncCom->drainUntil_ms > 0)
+					{
+						//*	still getting late responses, start the quiet time over
+						asyncCom->drainUntil_ms	=	GetAsyncMilliSecs() + kAsyncDrainQuiet_ms;
+					}
+				}
+				else if ((readCnt == 0) && (asyncCom->isSocket || (pollFDs[0].revents & POLLHUP)))
+				{
+					CONSOLE_DEBUG("Connection closed by the device");
+					connectionOK	=	false;
+				}
+				else if ((readCnt < 0) && (errno != EAGAIN) && (errno != EINTR))
+				{
+					CONSOLE_DEBUG_W_NUM("read failed, errno\t=", errno);
+					connectionOK	=	false;
+				}
+			}
+		}
+		else if ((pollRetCode < 0) && (errno != EINTR))
+		{
+			CONSOLE_DEBUG_W_NUM("poll failed, errno\t=", errno);
+			connectionOK	=	false;
+		}
+
+		currentMilliSecs	=	GetAsyncMilliSecs();
+		finishedCnt			+=	ProcessRxData(asyncCom, currentMilliSecs);
+
+		//*	check the time out of the oldest command
+		pthread_mutex_lock(&asyncCom->queueMutex);
+		inFlightCnt		=	asyncCom->inFlightCnt;
+		headTimedOut	=	(inFlightCnt > 0) &&
+							((currentMilliSecs - asyncCom->cmdQueue[asyncCom->queueHead].sentTime_ms) >=
+								asyncCom->cmdQueue[asyncCom->queueHead].timeOut_ms);
+		pthread_mutex_unlock(&asyncCom->queueMutex);
+		if (headTimedOut)
+		{
+		#ifdef _DEBUG_ASYNC_COM_
+			CONSOLE_DEBUG_W_STR("Timed out\t=", asyncCom->cmdQueue[asyncCom->queueHead].cmdString);
+		#endif
+			asyncCom->timeOutCnt++;
+			//*	the responses can no longer be matched by order,
+			//*	so everything in flight fails and the late responses get thrown away
+			DiscardRxData(asyncCom, asyncCom->rxLen);
+			asyncCom->drainUntil_ms	=	currentMilliSecs + kAsyncDrainQuiet_ms;
+			while (inFlightCnt > 0)
+			{
+				FinishOldestCmd(asyncCom, NULL, kAsyncStatus_TimeOut);
+				finishedCnt++;
+				inFlightCnt--;
+			}
+		}
+	}
+	return(connectionOK ? finishedCnt : -1);
+}
+
+//*****************************************************************************
+//*	call from the destructor of the owner
+//*****************************************************************************
+void	AsyncCom_Release(TYPE_ASYNCCOM *asyncCom)
+{
+	AsyncCom_Close(asyncCom);
+	if (asyncCom->wakeUpPipe[0] >= 0)
+	{
+		close(asyncCom->wakeUpPipe[0]);
+		close(asyncCom->wakeUpPipe[1]);
+		asyncCom->wakeUpPipe[0]	=	-1;
+		asyncCom->wakeUpPipe[1]	=	-1;
+	}
+	pthread_mutex_destroy(&asyncCom->queueMutex);
+}
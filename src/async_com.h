@@ -0,0 +1,150 @@
+//*****************************************************************************
+//*	Name:			async_com.h
+//*
+//*	Author:			agent
+//*
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created async_com.h
+//*	Oct 18,	2026	<AGT> Added drainUntil_ms, a time out fails every command in flight
+//*****************************************************************************
+//#include	"async_com.h"
+
+#ifndef _ASYNC_COM_H_
+#define	_ASYNC_COM_H_
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
+#ifndef _STDBOOL_H
+	#include	<stdbool.h>
+#endif
+
+#ifndef _PTHREAD_H
+	#include	<pthread.h>
+#endif
+
+#define	kAsyncMaxCmds				32
+#define	kAsyncMaxCmdLen				48
+#define	kAsyncMaxResponseLen		128
+#define	kAsyncRxBuffLen				512
+#define	kAsyncDefaultInFlight		4
+#define	kAsyncDefaultTimeOut_ms		1000
+#define	kAsyncDrainQuiet_ms			100		//*	after a time out, the line has to be quiet this long
+
+//*****************************************************************************
+//*	what kind of response the command gets back,
+//*	the protocol framer can define its own starting at kAsyncResp_Protocol
+//*****************************************************************************
+enum
+{
+	kAsyncResp_None	=	0,		//*	nothing comes back, done as soon as it is written
+	kAsyncResp_Terminated,		//*	ends with the terminator char, i.e. '#'
+	kAsyncResp_OneChar,			//*	exactly one char, i.e. LX200 "0" or "1"
+
+	kAsyncResp_Protocol	=	16
+};
+
+//*****************************************************************************
+enum
+{
+	kAsyncStatus_OK	=	0,
+	kAsyncStatus_TimeOut,
+	kAsyncStatus_Flushed,		//*	removed from the queue before it was sent
+	kAsyncStatus_WriteErr,
+	kAsyncStatus_Closed			//*	the connection was closed with the command in flight
+};
+
+//*****************************************************************************
+//*	returns the length of the response at the start of rxData,
+//*	0 if it is not all here yet, < 0 to throw away that many chars
+//*****************************************************************************
+typedef int		(*AsyncFramerProc)(const char *rxData, const int rxLen, const int responseType, const char terminator);
+
+//*****************************************************************************
+//*	called from AsyncCom_Process() as each command finishes,
+//*	responseString is empty unless status is kAsyncStatus_OK
+//*****************************************************************************
+typedef void	(*AsyncDoneProc)(	void		*userData,
+									const int	cmdID,
+									const char	*cmdString,
+									const char	*responseString,
+									const int	status);
+
+//*****************************************************************************
+typedef struct
+{
+	char			cmdString[kAsyncMaxCmdLen];		//*	exactly what gets written
+	int				cmdLen;
+	int				cmdID;							//*	for use by the caller
+	int				responseType;
+	int				timeOut_ms;
+	long			sentTime_ms;
+	AsyncDoneProc	doneProc;
+	void			*userData;
+} TYPE_ASYNC_CMD;
+
+//*****************************************************************************
+typedef struct
+{
+	int				fileDesc;
+	bool			isSocket;
+	char			terminator;
+	int				maxInFlight;
+	AsyncFramerProc	framerProc;
+	int				wakeUpPipe[2];			//*	wakes up AsyncCom_Process() when a command is queued
+
+	pthread_mutex_t	queueMutex;
+	TYPE_ASYNC_CMD	cmdQueue[kAsyncMaxCmds];	//*	ring buffer, oldest first
+	int				queueHead;
+	int				queuedCnt;				//*	in flight + waiting
+	int				inFlightCnt;			//*	the first inFlightCnt have been written
+
+	char			rxBuffer[kAsyncRxBuffLen + 1];
+	int				rxLen;
+	long			drainUntil_ms;			//*	after a time out, nothing is sent until then, 0 = not draining
+
+	//*	statistics
+	uint32_t		cmdsSentCnt;
+	uint32_t		responseCnt;
+	uint32_t		timeOutCnt;
+	uint32_t		discardedByteCnt;
+	uint32_t		maxResponse_ms;
+} TYPE_ASYNCCOM;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+void	AsyncCom_Init(		TYPE_ASYNCCOM	*asyncCom,
+							AsyncFramerProc	framerProc,
+							const char		terminator,
+							const int		maxInFlight);
+void	AsyncCom_Open(		TYPE_ASYNCCOM *asyncCom, const int fileDesc);
+void	AsyncCom_Close(		TYPE_ASYNCCOM *asyncCom);
+void	AsyncCom_Release(	TYPE_ASYNCCOM *asyncCom);
+bool	AsyncCom_QueueCmd(	TYPE_ASYNCCOM	*asyncCom,
+							const char		*cmdString,
+							const int		cmdID,
+							const int		responseType,
+							const int		timeOut_ms,
+							AsyncDoneProc	doneProc,
+							void			*userData);
+int		AsyncCom_Flush(		TYPE_ASYNCCOM *asyncCom);
+int		AsyncCom_PendingCnt(TYPE_ASYNCCOM *asyncCom);
+
+//*	returns the number of commands finished, -1 if the connection failed
+int		AsyncCom_Process(	TYPE_ASYNCCOM *asyncCom, const int maxWait_ms);
+
+int		AsyncCom_DefaultFramer(const char *rxData, const int rxLen, const int responseType, const char terminator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif		//	_ASYNC_COM_H_
@@ -270,38 +270,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ClientTransactionID",
-																reqData->ClientTransactionID,
-																INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ServerTransactionID",
-																gServerTransactionID,
-																INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ErrorNumber",
-																alpacaErrCode,
-																INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ErrorMessage",
-																alpacaErrMsg,
-																NO_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -448,7 +417,7 @@ bool				dataValid;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	//*	we have to find the "Brightness" string
-	brightnessFound		=	GetKeyWordArgument(	reqData->contentData,
+	brightnessFound		=	GetKeyWordArgument(	reqData,
 												"Brightness",
 												brightnessString,
 												(sizeof(brightnessString) -1),
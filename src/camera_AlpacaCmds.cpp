@@ -3,6 +3,7 @@
 //*		This file is used by both the driver and the controller
 //*****************************************************************************
 //*	Jul  1,	2023	<MLS> Created camera_AlpacaCmds.cpp
+//*	Oct 18,	2026	<AGT> Added savequeue command
 //*****************************************************************************
 
 
@@ -103,6 +104,7 @@ TYPE_CmdEntry	gCameraCmdTable[]	=
 
 	{	"savedimages",				kCmd_Camera_savedimages,			kCmdType_GET	},
 	{	"savenextimage",			kCmd_Camera_savenextimage,			kCmdType_PUT	},
+	{	"savequeue",				kCmd_Camera_savequeue,				kCmdType_GET	},
 	{	"settelescopeinfo",			kCmd_Camera_settelescopeinfo,		kCmdType_PUT	},
 	{	"startsequence",			kCmd_Camera_startsequence,			kCmdType_PUT	},
 	{	"startvideo",				kCmd_Camera_startvideo,				kCmdType_PUT	},
@@ -2,6 +2,7 @@
 //*	camera_AlpacaCmds.h
 //*****************************************************************************
 //*	Jun 30,	2023	<MLS> Created camera_AlpacaCmds.h
+//*	Oct 18,	2026	<AGT> Added kCmd_Camera_savequeue
 //*****************************************************************************
 //#include	"camera_AlpacaCmds.h"
 
@@ -121,6 +122,7 @@ enum
 	kCmd_Camera_saveasRAW,
 	kCmd_Camera_savedimages,
 	kCmd_Camera_savenextimage,
+	kCmd_Camera_savequeue,
 	kCmd_Camera_startsequence,
 	kCmd_Camera_startvideo,
 	kCmd_Camera_stopvideo,
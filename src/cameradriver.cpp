@@ -31,6 +31,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 14,	2019	<MLS> Created cameradriver.cpp
 //*	Apr 15,	2019	<MLS> Added command table for camera
@@ -220,6 +221,20 @@
 //*	Jun 28,	2024	<MLS> Removed all "if (reqData != NULL)" from cameradriver.cpp
 //*	Jul  6,	2024	<EZT> Several fixes dealing with tranmitted data size of binary image data
 //*	Nov 22,	2024	<MLS> Reverted back to 8 bit RGB binary images, need 32 bit official simulator to fully test
+//*	Oct 18,	2026	<AGT> Added IsConcurrentCommand() so status requests are not blocked by image downloads
+//*	Oct 18,	2026	<AGT> Send_imagearray_xxx() now use the streaming encoder in imagearray_json.c
+//*	Oct 18,	2026	<AGT> Added Init_JsonImageEncoder()
+//*	Oct 18,	2026	<AGT> Get_Imagearray_Binary() no longer allocates a buffer for every download
+//*	Oct 18,	2026	<AGT> Added BuildBinaryImage_Cached(), ImageBytes payload is built once per frame
+//*	Oct 18,	2026	<AGT> ImageBytes headers and payload are now sent with writev()
+//*	Oct 18,	2026	<AGT> Added savequeue command, images are now saved by the save queue threads
+//*	Oct 18,	2026	<AGT> AllocateImageBuffer() now sizes the slots of the frame buffer ring
+//*	Oct 18,	2026	<AGT> Added FrameRing_xxx(), image downloads hold a reference to the frame they are sending
+//*	Oct 18,	2026	<AGT> Frames are dropped when every ring slot is in use, slots in use are never re-used
+//*	Oct 18,	2026	<AGT> readoutmodes, gains & offsets are sent from the static response cache
+//*	Oct 18,	2026	<AGT> Keyword lookups use the parsed request keyword list
+//*	Oct 18,	2026	<AGT> A ring overrun only drops the frame, it no longer resets the image mode
+//*	Oct 18,	2026	<AGT> BuildBinaryImage_xxx() check that the whole pixel fits before writing it
 //*****************************************************************************
 //*	Jan  1,	2119	<TODO> ----------------------------------------
 //*	Jun 26,	2119	<TODO> Add support for sub frames
@@ -241,6 +256,8 @@
 #include	<sys/time.h>
 #include	<sys/stat.h>
 #include	<sys/types.h>
+#include	<sys/uio.h>
+#include	<sys/mman.h>
 #include	<time.h>
 #include	<unistd.h>
 
@@ -438,6 +455,7 @@ CameraDriver::CameraDriver(void)
 	:AlpacaDriver(kDeviceType_Camera)
 {
 int			mkdirErrCode;
+int			iii;
 char		myImageDataDir[]	=	"/media/pi/rpdata/imagedata";
 
 	CONSOLE_DEBUG(__FUNCTION__);
@@ -522,11 +540,53 @@ char		myImageDataDir[]	=	"/media/pi/rpdata/imagedata";
 	cVideoDuration_secs				=	0;
 	cTotalFramesSaved				=	0;
 	cFramesRead						=	0;
+
+	//*	the save queue threads are not started until the first image is saved
+	cSaveQueueRunning				=	false;
+	cSaveQueueStopping				=	false;
+	cSaveWorkerCnt					=	0;
+	cSaveQueueHead					=	0;
+	cSaveQueueCount					=	0;
+	cSaveFramesInUse				=	0;
+	memset((void *)cSaveFrames,			0, sizeof(cSaveFrames));
+	memset((void *)cSaveQueue,			0, sizeof(cSaveQueue));
+	memset((void *)&cSaveQueueStats,	0, sizeof(TYPE_SaveQueueStats));
+	for (iii=0; iii<kSaveQueueDepth; iii++)
+	{
+		cSaveFrames[iii].frameRingIdx	=	-1;
+	}
+	pthread_mutex_init(&cSaveQueueMutex, NULL);
+	pthread_cond_init(&cSaveQueueCondition, NULL);
+	pthread_cond_init(&cSaveFrameFreeCondition, NULL);
 	cFrameRate						=	0.0;
 	//*	init the data buffers to nothing
 	cInternalCameraState			=	kCameraState_Idle;
 	cCameraDataBuffer				=	NULL;
 	cCameraBGRbuffer				=	NULL;
+	cCameraBGRbuffSize				=	0;
+	cJsonImageWorkBuff				=	NULL;
+	cJsonImageWorkBuffSize			=	0;
+	memset((void *)&cBinaryImageCache, 0, sizeof(TYPE_BinaryImageCache));
+
+	//*	the frame ring slots are not allocated until the first image is read
+	memset((void *)cFrameRing,			0, sizeof(cFrameRing));
+	memset((void *)&cFrameRingStats,	0, sizeof(TYPE_FrameRingStats));
+	pthread_mutex_init(&cFrameRingMutex, NULL);
+	pthread_cond_init(&cFrameRingCondition, NULL);
+	cFrameRingDepth					=	kFrameRingDefaultDepth;
+	if ((gFrameRingDepth >= 2) && (gFrameRingDepth <= kFrameRingMaxDepth))
+	{
+		cFrameRingDepth				=	gFrameRingDepth;
+	}
+	cFrameRingWriteIdx				=	0;
+	cFrameRingReadyIdx				=	-1;
+	memset((void *)&cImageStats,	0, sizeof(TYPE_ImageStats));
+
+	//*	lists that do not change once the camera is opened
+	cResponseIncludesContentData	=	true;
+	ResponseCache_Register("readoutmodes");
+	ResponseCache_Register("gains");
+	ResponseCache_Register("offsets");
 
 	cCameraDataBuffLen				=	0;
 	cAutoAdjustExposure				=	gAutoExposure;
@@ -645,7 +705,6 @@ char		myImageDataDir[]	=	"/media/pi/rpdata/imagedata";
 	cFilterWheelInfoValid	=	false;
 
 #ifdef _ENABLE_FITS_
-int	iii;
 	//*	initialize the fits header data
 	for (iii = 0; iii < kMaxFitsRecords; iii++)
 	{
@@ -695,6 +754,11 @@ CameraDriver::~CameraDriver(void)
 	//*	this really never gets called since we dont really have an exit command
 	CONSOLE_DEBUG(__FUNCTION__);
 	Cooler_TurnOff();
+
+	SaveQueue_Stop();
+	pthread_mutex_destroy(&cSaveQueueMutex);
+	pthread_cond_destroy(&cSaveQueueCondition);
+	pthread_cond_destroy(&cSaveFrameFreeCondition);
 }
 
 //*****************************************************************************
@@ -832,6 +896,26 @@ void	CameraDriver::SetFileNameSuffix(const char *newFNsuffix)
 
 #pragma mark -
 
+//*****************************************************************************
+//*	image downloads can take several seconds, they only read the image buffer
+//*	so they are allowed to run while other commands are processed
+//*****************************************************************************
+bool	CameraDriver::IsConcurrentCommand(TYPE_GetPutRequestData *reqData)
+{
+bool	isConcurrent;
+
+	isConcurrent	=	false;
+	if (reqData->get_putIndicator == 'G')
+	{
+		if ((strcasecmp(reqData->deviceCommand, "imagearray") == 0) ||
+			(strcasecmp(reqData->deviceCommand, "imagearrayvariant") == 0))
+		{
+			isConcurrent	=	true;
+		}
+	}
+	return(isConcurrent);
+}
+
 //*****************************************************************************
 TYPE_ASCOM_STATUS	CameraDriver::ProcessCommand(TYPE_GetPutRequestData *reqData)
 {
@@ -1449,6 +1533,18 @@ char				httpHeader[500];
 			alpacaErrCode	=	Get_SavedImages(reqData, alpacaErrMsg, gValueString);
 			break;
 
+		case kCmd_Camera_savequeue:
+			if (reqData->get_putIndicator == 'G')
+			{
+				alpacaErrCode	=	Get_SaveQueue(reqData, alpacaErrMsg);
+			}
+			else
+			{
+				alpacaErrCode	=	kASCOM_Err_InvalidOperation;
+				GENERATE_ALPACAPI_ERRMSG(alpacaErrMsg, "Put not supported");
+			}
+			break;
+
 
 		case kCmd_Camera_savenextimage:
 			if (reqData->get_putIndicator == 'P')
@@ -1615,54 +1711,7 @@ char				httpHeader[500];
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-											reqData->jsonTextBuffer,
-											kMaxJsonBuffLen,
-											"ClientTransactionID",
-											reqData->ClientTransactionID,
-											INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-											reqData->jsonTextBuffer,
-											kMaxJsonBuffLen,
-											"ServerTransactionID",
-											gServerTransactionID,
-											INCLUDE_COMMA);
-
-		//*	this is for debugging with CONFORUM 2024-06-25
-		if (true)
-		{
-			if (strlen(reqData->contentData) > 0)
-			{
-				cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(		mySocket,
-													reqData->jsonTextBuffer,
-													kMaxJsonBuffLen,
-													"ContentData",
-													reqData->contentData,
-													INCLUDE_COMMA);
-			}
-		}
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-											reqData->jsonTextBuffer,
-											kMaxJsonBuffLen,
-											"ErrorNumber",
-											alpacaErrCode,
-											INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
-											reqData->jsonTextBuffer,
-											kMaxJsonBuffLen,
-											"ErrorMessage",
-											alpacaErrMsg,
-											NO_COMMA);
-
-
-		//CONSOLE_DEBUG_W_NUM("len of jsonTextBuffer\t=", strlen(reqData->jsonTextBuffer));
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 
 //	if (cmdEnumValue != kCmd_Camera_imagearray)
@@ -1689,17 +1738,17 @@ char				httpHeader[500];
 }
 
 //*****************************************************************************
-static void	ProcessTelescopeKeyWord(	const char			*sourceData,
-										const char			*keyword,
-										char				*returnString,
-										const unsigned int	maxLen)
+static void	ProcessTelescopeKeyWord(	const TYPE_GetPutRequestData	*reqData,
+										const char						*keyword,
+										char							*returnString,
+										const unsigned int				maxLen)
 {
 bool	keywordFound;
 char	myValueString[256];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 	memset(myValueString, 0, sizeof(myValueString));
-	keywordFound		=	GetKeyWordArgument(	sourceData,
+	keywordFound		=	GetKeyWordArgument(	reqData,
 												keyword,
 												myValueString,
 												(sizeof(myValueString) -1),
@@ -1738,14 +1787,14 @@ double	myExposureDuration_secs;
 double	myExposure_usecs;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Object",		cObjectName,			kObjectNameMaxLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Prefix",		cFileNamePrefix,		kFileNamePrefixMaxLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Suffix",		cFileNameSuffix,		kFileNamePrefixMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Object",		cObjectName,			kObjectNameMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Prefix",		cFileNamePrefix,		kFileNamePrefixMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Suffix",		cFileNameSuffix,		kFileNamePrefixMaxLen);
 
 //		CONSOLE_DEBUG_W_STR("Suffix", cFileNameSuffix);
 
 
-	durationFound		=	GetKeyWordArgument(	reqData->contentData,
+	durationFound		=	GetKeyWordArgument(	reqData,
 												"Duration",
 												duarationString,
 												(sizeof(duarationString) -1),
@@ -1867,7 +1916,7 @@ int					newBinValue;
 
 //printf("cmd : %s\n", reqData->contentData);
 //	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"BinX",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -1927,7 +1976,7 @@ char				argumentString[32];
 bool				foundKeyWord;
 int					newBinValue;
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"BinY",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -2197,7 +2246,7 @@ bool				newCoolerState;
 //	CONSOLE_DEBUG(__FUNCTION__);
 	if (cIsCoolerCam)
 	{
-		foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+		foundKeyWord	=	GetKeyWordArgument(	reqData,
 												"CoolerOn",
 												argumentString,
 												(sizeof(argumentString) -1));
@@ -2407,7 +2456,7 @@ char				gainString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	gainFound		=	GetKeyWordArgument(	reqData->contentData,
+	gainFound		=	GetKeyWordArgument(	reqData,
 											"Gain",
 											gainString,
 											(sizeof(gainString) -1));
@@ -2624,7 +2673,7 @@ int					newValue;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"NumX",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -2675,7 +2724,7 @@ int					newValue;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"NumY",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -2749,7 +2798,7 @@ int					newValue;
 bool				validData;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Offset",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -2922,7 +2971,7 @@ int					newValue;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"StartX",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -2975,7 +3024,7 @@ int					newValue;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"StartY",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -3116,13 +3165,13 @@ char				durationString[32];
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	//*	"Direction=1&Duration=2&ClientID=34&ClientTransactionID=56"
-	directionFound	=	GetKeyWordArgument(	reqData->contentData,
+	directionFound	=	GetKeyWordArgument(	reqData,
 											"Direction",
 											directionString,
 											(sizeof(directionString) -1),
 											kRequireCase);
 
-	durationFound	=	GetKeyWordArgument(	reqData->contentData,
+	durationFound	=	GetKeyWordArgument(	reqData,
 											"Duration",
 											durationString,
 											(sizeof(durationString) -1),
@@ -3306,7 +3355,7 @@ TYPE_IMAGE_TYPE		newImageType;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	readOutFound		=	GetKeyWordArgument(	reqData->contentData,
+	readOutFound		=	GetKeyWordArgument(	reqData,
 												"ReadoutMode",
 												readOutModeString,
 												(sizeof(readOutModeString) -1));
@@ -3466,7 +3515,7 @@ double				newSetCCDvalue;
 //	CONSOLE_DEBUG_W_STR("contentData\t=",	reqData->contentData);
 	if (cCameraProp.CanSetCCDtemperature)
 	{
-		setCCDtempFound	=	GetKeyWordArgument(	reqData->contentData,
+		setCCDtempFound	=	GetKeyWordArgument(	reqData,
 												"SetCCDTemperature",
 												setCCDtempString,
 												(sizeof(setCCDtempString) -1),
@@ -3588,7 +3637,7 @@ bool				lightFrame;
 	ProcessExposureOptions(reqData);
 	//-----------------------------------------------------------------
 	lightFrame	=	true;
-	lightFound	=	GetKeyWordArgument(	reqData->contentData,
+	lightFound	=	GetKeyWordArgument(	reqData,
 										"Light",
 										lightString,
 										(sizeof(lightString) -1));
@@ -3610,7 +3659,7 @@ bool				lightFrame;
 	}
 
 	//-----------------------------------------------------------------
-	durationFound	=	GetKeyWordArgument(	reqData->contentData,
+	durationFound	=	GetKeyWordArgument(	reqData,
 											"Duration",
 											duarationString,
 											(sizeof(duarationString) -1),
@@ -3808,7 +3857,7 @@ char				mySubDurationString[32];
 	GENERATE_ALPACAPI_ERRMSG(alpacaErrMsg, "SubExposureDuration not supported")
 	return(kASCOM_Err_NotImplemented);
 
-	subDurationFound	=	GetKeyWordArgument(	reqData->contentData,
+	subDurationFound	=	GetKeyWordArgument(	reqData,
 												"SubExposureDuration",
 												mySubDurationString,
 												(sizeof(mySubDurationString) -1),
@@ -4001,7 +4050,8 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_NotImplemented;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_Raw8(	unsigned char 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_Raw8(	const unsigned char	*pixelBuffer,
+											unsigned char 	*binaryDataBuffer,
 											int				startOffset,
 											int				bufferSize)
 {
@@ -4012,7 +4062,7 @@ int		pixelIndex;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
@@ -4021,7 +4071,7 @@ int		pixelIndex;
 			{
 				if (ccc < bufferSize)
 				{
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff);
 				}
 				pixelIndex	+=	cLastExposure_ROIinfo.currentROIwidth;
 			}
@@ -4029,7 +4079,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4037,7 +4087,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_Raw8_16bit(	unsigned char	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_Raw8_16bit(	const unsigned char	*pixelBuffer,
+												unsigned char	*binaryDataBuffer,
 												int				startOffset,
 												int				bufferSize)
 {
@@ -4048,18 +4099,18 @@ int		pixelIndex;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
 			pixelIndex	=	xxx;
 			for (yyy=0; yyy < cLastExposure_ROIinfo.currentROIheight; yyy++)
 			{
-				if (ccc < bufferSize)
+				if ((ccc + 2) <= bufferSize)
 				{
 					//*	its little endian, 16 bit
 					binaryDataBuffer[ccc++]	=	0;
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff);
 				}
 				else
 				{
@@ -4071,7 +4122,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4079,7 +4130,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_Raw8_32bit(	unsigned char	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_Raw8_32bit(	const unsigned char	*pixelBuffer,
+												unsigned char	*binaryDataBuffer,
 												int				startOffset,
 												int				bufferSize)
 {
@@ -4090,18 +4142,18 @@ int		pixelIndex;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
 			pixelIndex	=	xxx;
 			for (yyy=0; yyy < cLastExposure_ROIinfo.currentROIheight; yyy++)
 			{
-				if (ccc < bufferSize)
+				if ((ccc + 4) <= bufferSize)
 				{
 					//*	its little endian, 16 bit value in 32 bit word
 					binaryDataBuffer[ccc++]	=	0;
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff);
 					binaryDataBuffer[ccc++]	=	0;
 					binaryDataBuffer[ccc++]	=	0;
 				}
@@ -4115,7 +4167,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4131,7 +4183,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_Raw16(	unsigned char 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_Raw16(	const unsigned char	*pixelBuffer,
+											unsigned char 	*binaryDataBuffer,
 											int				startOffset,
 											int				bufferSize)
 {
@@ -4142,7 +4195,7 @@ int		pixelIndex;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
@@ -4150,12 +4203,12 @@ int		pixelIndex;
 			{
 				pixelIndex	=	yyy * cLastExposure_ROIinfo.currentROIwidth * 2;
 				pixelIndex	+=	xxx * 2;
-				if (ccc < bufferSize)
+				if ((ccc + 2) <= bufferSize)
 				{
 					//*	the outgoing data is little-endian 16 bit
 					//*	we are converting an 8 bit value to a 16 bit value, unsigned
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex++] & 0x00ff);
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex++] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex++] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex++] & 0x00ff);
 				}
 
 			//	pixelIndex++;
@@ -4164,7 +4217,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4172,7 +4225,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_Raw32(	unsigned char 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_Raw32(	const unsigned char	*pixelBuffer,
+											unsigned char 	*binaryDataBuffer,
 											int				startOffset,
 											int				bufferSize)
 {
@@ -4183,7 +4237,7 @@ int		pixelIndex;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
@@ -4191,14 +4245,14 @@ int		pixelIndex;
 			{
 				pixelIndex	=	yyy * cLastExposure_ROIinfo.currentROIwidth * 2;
 				pixelIndex	+=	xxx * 2;
-				if (ccc < bufferSize)
+				if ((ccc + 4) <= bufferSize)
 				{
 					//*	the outgoing data is little-endian 32 bit
 					//*	we are converting a 16 bit value to a 32 bit value, unsigned
 					binaryDataBuffer[ccc++]	=	0;
 					binaryDataBuffer[ccc++]	=	0;
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex++] & 0x00ff);
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex++] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex++] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex++] & 0x00ff);
 				}
 
 			//	pixelIndex++;
@@ -4207,7 +4261,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4215,7 +4269,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_RGB24(	unsigned char 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_RGB24(	const unsigned char	*pixelBuffer,
+											unsigned char 	*binaryDataBuffer,
 											int				startOffset,
 											int				bufferSize)
 {
@@ -4227,23 +4282,23 @@ int		pixelIndex;
 	CONSOLE_DEBUG(__FUNCTION__);
 
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
 		{
 			pixelIndex	=	xxx * 3;
 			for (yyy=0; yyy < cLastExposure_ROIinfo.currentROIheight; yyy++)
 			{
-				if (ccc < bufferSize)
+				if ((ccc + 3) <= bufferSize)
 				{
 					//*	red data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 2] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 2] & 0x00ff);
 
 					//*	green data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 1] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 1] & 0x00ff);
 
 					//*	blue data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff);
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff);
 				}
 				pixelIndex	+=	cLastExposure_ROIinfo.currentROIwidth * 3;
 			}
@@ -4251,7 +4306,7 @@ int		pixelIndex;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4259,7 +4314,8 @@ int		pixelIndex;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_RGB24_32bit(	uint32_t 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_RGB24_32bit(	const unsigned char	*pixelBuffer,
+												uint32_t 	*binaryDataBuffer,
 												int			startOffset,
 												int			bufferSize)
 {
@@ -4272,7 +4328,7 @@ int		pixelCntMax;
 	CONSOLE_DEBUG(__FUNCTION__);
 
 	ccc	=	startOffset;
-	if (cCameraDataBuffer != NULL)
+	if (pixelBuffer != NULL)
 	{
 		pixelCntMax	=	bufferSize / 4;
 		for (xxx=0; xxx<cLastExposure_ROIinfo.currentROIwidth; xxx++)
@@ -4280,17 +4336,17 @@ int		pixelCntMax;
 			pixelIndex	=	xxx * 3;
 			for (yyy=0; yyy < cLastExposure_ROIinfo.currentROIheight; yyy++)
 			{
-				if (ccc < pixelCntMax)
+				if ((ccc + 3) <= pixelCntMax)
 				{
 					//*	openCV uses BGR instead of RGB
 					//*	red data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 2] & 0x00ff) << 24;
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 2] & 0x00ff) << 24;
 
 					//*	green data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 1] & 0x00ff) << 24;
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 1] & 0x00ff) << 24;
 
 					//*	blue data
-					binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff) << 24;
+					binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff) << 24;
 				}
 				pixelIndex	+=	cLastExposure_ROIinfo.currentROIwidth * 3;
 			}
@@ -4298,7 +4354,7 @@ int		pixelCntMax;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("pixelBuffer is NULL");
 	}
 	return(ccc);
 }
@@ -4306,7 +4362,8 @@ int		pixelCntMax;
 //*****************************************************************************
 //*	returns byte count
 //*****************************************************************************
-int	CameraDriver::BuildBinaryImage_RGBx16(	unsigned char 	*binaryDataBuffer,
+int	CameraDriver::BuildBinaryImage_RGBx16(	const unsigned char	*pixelBuffer,
+											unsigned char 	*binaryDataBuffer,
 											int				startOffset,
 											int				bufferSize)
 {
@@ -4323,20 +4380,20 @@ int		pixelIndex;
 		pixelIndex	=	xxx * 3;
 		for (yyy=0; yyy < cLastExposure_ROIinfo.currentROIheight; yyy++)
 		{
-			if (ccc < bufferSize)
+			if ((ccc + 6) <= bufferSize)
 			{
 				//*	output data is 16 bit, little endian, we have RGB 24 bit (3 bytes)
 				//*	red data
 				binaryDataBuffer[ccc++]	=	0;
-				binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 2] & 0x00ff);
+				binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 2] & 0x00ff);
 
 				//*	green data
 				binaryDataBuffer[ccc++]	=	0;
-				binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex + 1] & 0x00ff);
+				binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex + 1] & 0x00ff);
 
 				//*	blue data
 				binaryDataBuffer[ccc++]	=	0;
-				binaryDataBuffer[ccc++]	=	(cCameraDataBuffer[pixelIndex] & 0x00ff);
+				binaryDataBuffer[ccc++]	=	(pixelBuffer[pixelIndex] & 0x00ff);
 			}
 			pixelIndex	+=	cLastExposure_ROIinfo.currentROIwidth * 3;
 		}
@@ -4364,6 +4421,175 @@ static void	GetAlpacaImageDataTypeString(int dataType, char *dataTypeString)
 
 //*****************************************************************************
 //*	https://ascom-standards.org/Developer/AlpacaImageBytes.pdf
+//*****************************************************************************
+//*	returns the number of bytes sent
+//*****************************************************************************
+static size_t	WriteVectorToSocket(const int socketFD, struct iovec *ioVector, int ioCount)
+{
+size_t	totalBytesWritten;
+ssize_t	bytesWritten;
+
+	totalBytesWritten	=	0;
+	while (ioCount > 0)
+	{
+		bytesWritten	=	writev(socketFD, ioVector, ioCount);
+		if (bytesWritten > 0)
+		{
+			totalBytesWritten	+=	bytesWritten;
+			//*	skip over what was sent, large images rarely go in one call
+			while ((ioCount > 0) && (bytesWritten >= (ssize_t)ioVector->iov_len))
+			{
+				bytesWritten	-=	ioVector->iov_len;
+				ioVector++;
+				ioCount--;
+			}
+			if (ioCount > 0)
+			{
+				ioVector->iov_base	=	(char *)ioVector->iov_base + bytesWritten;
+				ioVector->iov_len	-=	bytesWritten;
+			}
+		}
+		else if ((bytesWritten < 0) && (errno == EINTR))
+		{
+			//*	try again
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("writev() failed, errno\t=", errno);
+			break;
+		}
+	}
+	return(totalBytesWritten);
+}
+
+//*****************************************************************************
+//*	Builds the ImageBytes image data in cBinaryImageCache.dataBuffer,
+//*	if it is already there for this frame, nothing is done.
+//*	returns the number of bytes of image data, 0 on failure
+//*****************************************************************************
+size_t	CameraDriver::BuildBinaryImage_Cached(const int transmissionType, const size_t imageDataLen)
+{
+unsigned char	*newBuffer;
+int				returnedDataLen;
+int				frameRingIdx;
+unsigned char	*pixelBuffer;
+
+	if ((cBinaryImageCache.dataLen == imageDataLen) &&
+		(cBinaryImageCache.transmissionType					==	transmissionType) &&
+		(cBinaryImageCache.imageType						==	cLastExposure_ROIinfo.currentROIimageType) &&
+		(cBinaryImageCache.roiWidth							==	cLastExposure_ROIinfo.currentROIwidth) &&
+		(cBinaryImageCache.roiHeight						==	cLastExposure_ROIinfo.currentROIheight) &&
+		(cBinaryImageCache.frameNumber						==	cFramesRead) &&
+		(cBinaryImageCache.exposureStartTime.tv_sec			==	cCameraProp.Lastexposure_StartTime.tv_sec) &&
+		(cBinaryImageCache.exposureStartTime.tv_usec		==	cCameraProp.Lastexposure_StartTime.tv_usec) &&
+		(cBinaryImageCache.exposureEndTime.tv_sec			==	cCameraProp.Lastexposure_EndTime.tv_sec) &&
+		(cBinaryImageCache.exposureEndTime.tv_usec			==	cCameraProp.Lastexposure_EndTime.tv_usec))
+	{
+		CONSOLE_DEBUG("Re-using ImageBytes data from previous download");
+		return(cBinaryImageCache.dataLen);
+	}
+
+	cBinaryImageCache.dataLen	=	0;
+	if (imageDataLen > cBinaryImageCache.bufferSize)
+	{
+		//*	only grows, the next image is usually the same size
+		newBuffer	=	(unsigned char *)realloc(cBinaryImageCache.dataBuffer, imageDataLen);
+		if (newBuffer == NULL)
+		{
+			CONSOLE_DEBUG_W_SIZE("Failed to allocate data buffer of size", imageDataLen);
+			return(0);
+		}
+		cBinaryImageCache.dataBuffer	=	newBuffer;
+		cBinaryImageCache.bufferSize	=	imageDataLen;
+	}
+
+	//*	hold on to the frame so the camera can not read the next one into it while we are working
+	frameRingIdx	=	FrameRing_AcquireReady();
+	pixelBuffer		=	NULL;
+	if (frameRingIdx >= 0)
+	{
+		pixelBuffer	=	cFrameRing[frameRingIdx].dataBuffer;
+	}
+
+	returnedDataLen	=	0;
+	switch(cLastExposure_ROIinfo.currentROIimageType)
+	{
+		case kImageType_RAW8:
+		case kImageType_Y8:
+		case kImageType_MONO8:
+			CONSOLE_DEBUG("kImageType_RAW8");
+			switch (transmissionType)
+			{
+				case kAlpacaImageData_Byte:
+					returnedDataLen	=	BuildBinaryImage_Raw8(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+					break;
+
+				case kAlpacaImageData_Int16:
+					returnedDataLen	=	BuildBinaryImage_Raw8_16bit(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+					break;
+
+				case kAlpacaImageData_Int32:
+					returnedDataLen	=	BuildBinaryImage_Raw8_32bit(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+					break;
+
+				default:
+					CONSOLE_DEBUG_W_NUM("Image type not handled:", transmissionType);
+					returnedDataLen	=	0;
+					break;
+			}
+			break;
+
+		case kImageType_RAW16:
+			CONSOLE_DEBUG("kImageType_RAW16");
+			if (transmissionType == kAlpacaImageData_Int32)
+			{
+				returnedDataLen	=	BuildBinaryImage_Raw32(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+			}
+			else
+			{
+				returnedDataLen	=	BuildBinaryImage_Raw16(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+			}
+			break;
+
+		case kImageType_RGB24:
+			//*	fix by EZT 7/6/2024
+			CONSOLE_DEBUG("kImageType_RGB24");
+			returnedDataLen	=	BuildBinaryImage_RGB24(pixelBuffer, cBinaryImageCache.dataBuffer, 0, imageDataLen);
+			break;
+
+		default:
+			CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIimageType\t=",	cLastExposure_ROIinfo.currentROIimageType);
+			CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIwidth    \t=",	cLastExposure_ROIinfo.currentROIwidth);
+			CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIheight   \t=",	cLastExposure_ROIinfo.currentROIheight);
+			returnedDataLen	=	0;
+			break;
+	}
+	if (frameRingIdx >= 0)
+	{
+		FrameRing_Release(frameRingIdx);
+	}
+	CONSOLE_DEBUG_W_SIZE("imageDataLen   \t\t=",	imageDataLen);
+	CONSOLE_DEBUG_W_NUM( "returnedDataLen\t\t=",	returnedDataLen);
+
+	if (returnedDataLen > 0)
+	{
+		//*	unused bytes are sent as zero, same as the old calloc() buffer
+		if ((size_t)returnedDataLen < imageDataLen)
+		{
+			memset(cBinaryImageCache.dataBuffer + returnedDataLen, 0, imageDataLen - returnedDataLen);
+		}
+		cBinaryImageCache.dataLen			=	imageDataLen;
+		cBinaryImageCache.transmissionType	=	transmissionType;
+		cBinaryImageCache.imageType			=	cLastExposure_ROIinfo.currentROIimageType;
+		cBinaryImageCache.roiWidth			=	cLastExposure_ROIinfo.currentROIwidth;
+		cBinaryImageCache.roiHeight			=	cLastExposure_ROIinfo.currentROIheight;
+		cBinaryImageCache.frameNumber		=	cFramesRead;
+		cBinaryImageCache.exposureStartTime	=	cCameraProp.Lastexposure_StartTime;
+		cBinaryImageCache.exposureEndTime	=	cCameraProp.Lastexposure_EndTime;
+	}
+	return(cBinaryImageCache.dataLen);
+}
+
 //*****************************************************************************
 TYPE_ASCOM_STATUS	CameraDriver::Get_Imagearray_Binary(TYPE_GetPutRequestData *reqData, char *alpacaErrMsg)
 {
@@ -4373,13 +4599,12 @@ int					bytesPerPixel;
 int					totalPixels;
 int					dataPayloadSize;
 size_t				bufferSize;
-unsigned char 		*binaryDataBuffer;
-int					imgDataOffset;
+size_t				imageDataLen;
 size_t				bytesWritten;
 char				httpHeader[1024];
 char				lineBuff[128];
 size_t				httpHeaderSize;
-int					returnedDataLen;
+struct iovec		ioVector[3];
 char				dataTypeString[32];
 bool				xmit16BitAs32Bit	=	false;
 
@@ -4523,148 +4748,34 @@ bool				xmit16BitAs32Bit	=	false;
 	//*	make sure we have valid data
 	if ((cCameraDataBuffer != NULL) && (totalPixels > 0))
 	{
-		//*	allocate one big buffer and put the entire image into it
-		binaryDataBuffer	=	(unsigned char *)calloc((bufferSize + 1000), 1);
-		if (binaryDataBuffer != NULL)
+		imageDataLen	=	dataPayloadSize - sizeof(TYPE_BinaryImageHdr);
+		CONSOLE_DEBUG_W_NUM("currentROIimageType    \t=",	cLastExposure_ROIinfo.currentROIimageType);
+		CONSOLE_DEBUG_W_NUM("TransmissionElementType\t=",	binaryImageHdr.TransmissionElementType);
+		if (BuildBinaryImage_Cached(binaryImageHdr.TransmissionElementType, imageDataLen) == imageDataLen)
 		{
-			//*	copy the HTTP header
-			memcpy(binaryDataBuffer, httpHeader, httpHeaderSize);
-
-//			CONSOLE_DEBUG_W_STR("binaryDataBuffer\t=",			binaryDataBuffer);
-			//*	copy over the header
-			memcpy(&binaryDataBuffer[httpHeaderSize], &binaryImageHdr, sizeof(TYPE_BinaryImageHdr));
-
-			//*	imgDataOffset is the index to put the image data
-			imgDataOffset		=	httpHeaderSize;
-			imgDataOffset		+=	sizeof(TYPE_BinaryImageHdr);
-
-			CONSOLE_DEBUG_W_SIZE("httpHeaderSize             \t=",	httpHeaderSize);
-			CONSOLE_DEBUG_W_SIZE("sizeof(TYPE_BinaryImageHdr)\t=",	sizeof(TYPE_BinaryImageHdr));
-			CONSOLE_DEBUG_W_NUM("imgDataOffset               \t=",	imgDataOffset);
-
-			//*	now copy the image over
-			returnedDataLen	=	0;
-			CONSOLE_DEBUG_W_NUM("currentROIimageType    \t=",	cLastExposure_ROIinfo.currentROIimageType);
-			CONSOLE_DEBUG_W_NUM("TransmissionElementType\t=",	binaryImageHdr.TransmissionElementType);
+			//*	HTTP header, image header and the image data go out in one call
+			ioVector[0].iov_base	=	httpHeader;
+			ioVector[0].iov_len		=	httpHeaderSize;
+			ioVector[1].iov_base	=	&binaryImageHdr;
+			ioVector[1].iov_len		=	sizeof(TYPE_BinaryImageHdr);
+			ioVector[2].iov_base	=	cBinaryImageCache.dataBuffer;
+			ioVector[2].iov_len		=	imageDataLen;
 
-			switch(cLastExposure_ROIinfo.currentROIimageType)
+			CONSOLE_DEBUG_W_SIZE("Writting to TCP socket, bufferSize\t=", bufferSize);
+			bytesWritten	=	WriteVectorToSocket(reqData->socket, ioVector, 3);
+			CONSOLE_DEBUG_W_SIZE("bytesWritten\t\t=", bytesWritten);
+			if (bytesWritten < bufferSize)
 			{
-				case kImageType_RAW8:
-				case kImageType_Y8:
-				case kImageType_MONO8:
-					CONSOLE_DEBUG("kImageType_RAW8");
-					switch (binaryImageHdr.TransmissionElementType)
-					{
-						case kAlpacaImageData_Byte:
-							returnedDataLen	=	BuildBinaryImage_Raw8(binaryDataBuffer, imgDataOffset, bufferSize);
-							break;
-
-						case kAlpacaImageData_Int16:
-							returnedDataLen	=	BuildBinaryImage_Raw8_16bit(binaryDataBuffer, imgDataOffset, bufferSize);
-							break;
-
-						case kAlpacaImageData_Int32:
-							returnedDataLen	=	BuildBinaryImage_Raw8_32bit(binaryDataBuffer, imgDataOffset, bufferSize);
-							break;
-
-						default:
-							CONSOLE_DEBUG_W_NUM("Image type not handled:", binaryImageHdr.TransmissionElementType);
-							returnedDataLen	=	0;
-							break;
-					}
-					CONSOLE_DEBUG_W_SIZE("bufferSize     \t\t=",	bufferSize);
-					CONSOLE_DEBUG_W_NUM( "returnedDataLen\t\t=",	returnedDataLen);
-					break;
-
-				case kImageType_RAW16:
-					CONSOLE_DEBUG("kImageType_RAW16");
-					if (xmit16BitAs32Bit)
-					{
-						returnedDataLen	=	BuildBinaryImage_Raw32(binaryDataBuffer, imgDataOffset, bufferSize);
-					}
-					else
-					{
-						returnedDataLen	=	BuildBinaryImage_Raw16(binaryDataBuffer, imgDataOffset, bufferSize);
-					}
-					break;
-
-				case kImageType_RGB24:
-					//*	fix by EZT 7/6/2024
-					CONSOLE_DEBUG("kImageType_RGB24");
-					//if (bytesPerPixel == 3)
-					//{
-					//	returnedDataLen	=	BuildBinaryImage_RGB24(binaryDataBuffer, imgDataOffset, bufferSize);
-					//}
-					//else
-					//{
-					//+	binaryImageHdr.TransmissionElementType	=	kAlpacaImageData_Int32;	//	Element type as sent over the network
-					//+	returnedDataLen	=	BuildBinaryImage_RGB24_32bit((uint32_t *)binaryDataBuffer, imgDataOffset, bufferSize);
-						returnedDataLen	=	BuildBinaryImage_RGB24(binaryDataBuffer, imgDataOffset, bufferSize);
-					//}
-					break;
-
-				default:
-					CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIimageType\t=",	cLastExposure_ROIinfo.currentROIimageType);
-					CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIwidth    \t=",	cLastExposure_ROIinfo.currentROIwidth);
-					CONSOLE_DEBUG_W_NUM("cLastExposure_ROIinfo.currentROIheight   \t=",	cLastExposure_ROIinfo.currentROIheight);
-				//	CONSOLE_ABORT(__FUNCTION__);
-					returnedDataLen	=	0;
-					break;
-			}
-
-			CONSOLE_DEBUG_W_SIZE("bufferSize\t\t=", bufferSize);
-			//*	if the data buffer is small, send it as one block
-		//	if (bufferSize < (20 * 1000000))
-			if (1)
-			{
-				CONSOLE_DEBUG_W_SIZE("Writting to TCP socket, bufferSize\t=", bufferSize);
-				bytesWritten	=	write(reqData->socket, binaryDataBuffer, bufferSize);
-				CONSOLE_DEBUG_W_SIZE("bytesWritten\t\t=", bytesWritten);
-				if (bytesWritten < bufferSize)
-				{
-					CONSOLE_DEBUG("FAILED!!! to transmit entire data block!!!!!!!!!!!!!!!");
-				}
-				else
-				{
-					alpacaErrCode	=	kASCOM_Err_Success;
-				}
+				CONSOLE_DEBUG("FAILED!!! to transmit entire data block!!!!!!!!!!!!!!!");
 			}
 			else
 			{
-			//*	send the data as multiple blocks
-			size_t			totalBytesWritten;
-			size_t			bytesPerBlock;
-			size_t			dataLeftToSend;
-			unsigned char 	*dataPointer;
-
-				CONSOLE_DEBUG("transmitting image data in blocks");
-			#define		kXmitBlockSize	(2 * 1000000)
-				totalBytesWritten	=	0;
-				dataPointer			=	binaryDataBuffer;
-				while (totalBytesWritten < bufferSize)
-				{
-					dataLeftToSend		=	bufferSize - totalBytesWritten;
-					if (dataLeftToSend > kXmitBlockSize)
-					{
-						bytesPerBlock	=	kXmitBlockSize;
-					}
-					else
-					{
-						bytesPerBlock	=	dataLeftToSend;
-					}
-					CONSOLE_DEBUG_W_SIZE("write() bytesPerBlock\t\t=", bytesPerBlock);
-					bytesWritten		=	write(reqData->socket, dataPointer, bytesPerBlock);
-					totalBytesWritten	+=	bytesWritten;
-					dataPointer			+=	bytesWritten;
-
-					CONSOLE_DEBUG_W_SIZE("bytesWritten\t\t=", bytesWritten);
-				}
+				alpacaErrCode	=	kASCOM_Err_Success;
 			}
-			free(binaryDataBuffer);
 		}
 		else
 		{
-			CONSOLE_DEBUG_W_SIZE("Failed to allocate data buffer of size", bufferSize);
+			CONSOLE_DEBUG("Failed to build binary image data");
 		}
 	}
 	else
@@ -4685,6 +4796,8 @@ char				imageTimeString[64];
 double				exposureTimeSecs;
 int					imgRank;
 char				httpHeader[500];
+int					frameRingIdx;
+unsigned char		*pixelBuffer;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_STR("htmlData\t=",		reqData->htmlData);
@@ -4743,9 +4856,11 @@ char				httpHeader[500];
 	CONSOLE_DEBUG_W_NUM("pixelCount\t=", pixelCount);
 
 	CONSOLE_DEBUG_W_NUM("cCameraProp.ImageReady\t=", cCameraProp.ImageReady);
-//	CONSOLE_DEBUG_W_HEX("cCameraDataBuffer\t=", cCameraDataBuffer);
-	if (cCameraProp.ImageReady && (cCameraDataBuffer != NULL))
+	//*	hold on to the frame until it has been sent
+	frameRingIdx	=	FrameRing_AcquireReady();
+	if (cCameraProp.ImageReady && (frameRingIdx >= 0))
 	{
+		pixelBuffer		=	cFrameRing[frameRingIdx].dataBuffer;
 		alpacaErrCode	=	kASCOM_Err_Success;
 		//========================================================================================
 		//*	record the image type
@@ -4818,7 +4933,7 @@ char				httpHeader[500];
 			case kImageType_MONO8:
 				CONSOLE_DEBUG("kImageType_RAW8");
 				Send_imagearray_raw8(	mySocket,
-										cCameraDataBuffer,
+										pixelBuffer,
 										cLastExposure_ROIinfo.currentROIheight,		//*	# of rows
 										cLastExposure_ROIinfo.currentROIwidth,		//*	# of columns
 										pixelCount);
@@ -4827,7 +4942,7 @@ char				httpHeader[500];
 			case kImageType_RAW16:
 				CONSOLE_DEBUG("kImageType_RAW16");
 				Send_imagearray_raw16(	mySocket,
-										(uint16_t *)cCameraDataBuffer,
+										(uint16_t *)pixelBuffer,
 										cLastExposure_ROIinfo.currentROIheight,		//*	# of rows
 										cLastExposure_ROIinfo.currentROIwidth,		//*	# of columns
 										pixelCount);
@@ -4837,7 +4952,7 @@ char				httpHeader[500];
 				CONSOLE_DEBUG("kImageType_RGB24");
 
 				Send_imagearray_rgb24(	mySocket,
-										cCameraDataBuffer,
+										pixelBuffer,
 										cLastExposure_ROIinfo.currentROIheight,		//*	# of rows
 										cLastExposure_ROIinfo.currentROIwidth,		//*	# of columns
 										pixelCount);
@@ -4862,6 +4977,10 @@ char				httpHeader[500];
 		GENERATE_ALPACAPI_ERRMSG(alpacaErrMsg, "No image to get");
 		CONSOLE_DEBUG(alpacaErrMsg);
 	}
+	if (frameRingIdx >= 0)
+	{
+		FrameRing_Release(frameRingIdx);
+	}
 
 	DumpRequestStructure(__FUNCTION__, reqData);
 
@@ -4898,6 +5017,35 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
 }
 
 
+//*****************************************************************************
+//*	the work buffer is kept from one download to the next,
+//*	it only gets re-allocated if the image gets taller
+//*****************************************************************************
+bool	CameraDriver::Init_JsonImageEncoder(	TYPE_ImageArrayJson	*encoder,
+												const int			socketFD,
+												const int			numRows,
+												const int			valuesPerPixel)
+{
+size_t	workBuffSize;
+
+	workBuffSize	=	ImageArrayJson_GetWorkBuffSize(numRows, valuesPerPixel);
+	if (workBuffSize > cJsonImageWorkBuffSize)
+	{
+		if (cJsonImageWorkBuff != NULL)
+		{
+			free(cJsonImageWorkBuff);
+		}
+		cJsonImageWorkBuff		=	malloc(workBuffSize);
+		cJsonImageWorkBuffSize	=	(cJsonImageWorkBuff != NULL) ? workBuffSize : 0;
+	}
+	return(ImageArrayJson_Init(	encoder,
+								socketFD,
+								cJsonImageWorkBuff,
+								cJsonImageWorkBuffSize,
+								numRows,
+								valuesPerPixel));
+}
+
 //*****************************************************************************
 void	CameraDriver::Send_imagearray_rgb24(	const int		socketFD,
 												unsigned char	*pixelPtr,
@@ -4905,92 +5053,27 @@ void	CameraDriver::Send_imagearray_rgb24(	const int		socketFD,
 												const int		numClms,
 												const int		pixelCount)
 {
-unsigned char	*myPixelPtr;
-uint32_t		pixelValue_Red;
-uint32_t		pixelValue_Grn;
-uint32_t		pixelValue_Blu;
-char			lineBuff[256];
-int				xxx;
-int				yyy;
-int				bufLen;
-int				bytesWritten;
-char			longBuffer[1024];
-int				dataElementCnt;
-int				pixelIndex;
-int				totalValuesWritten;
+TYPE_ImageArrayJson	encoder;
+long				totalValuesWritten;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_NUM("numRows\t=", numRows);
 	CONSOLE_DEBUG_W_NUM("numClms\t=", numClms);
 
 	totalValuesWritten	=	0;
-	myPixelPtr			=	pixelPtr;
-	if (myPixelPtr != NULL)
+	if (Init_JsonImageEncoder(&encoder, socketFD, numRows, 3))
 	{
-		totalValuesWritten	=	0;
-		dataElementCnt		=	0;
-		longBuffer[0]		=	0;
-		//*	step across from left to right
-		for (xxx=0; xxx < numClms; xxx++)
+		totalValuesWritten	=	ImageArrayJson_Send_RGB24(&encoder, pixelPtr, numRows, numClms);
+		if (encoder.writeError)
 		{
-			if ((xxx % 100) == 0)
-			{
-				CONSOLE_DEBUG_W_NUM("xxx\t=", xxx);
-			}
-			strcpy(longBuffer, "[\n");
-			dataElementCnt	=	0;
-			pixelIndex		=	xxx * 3;
-			//*	step through the rows (going from top to bottom)
-			for (yyy=0; yyy < numRows; yyy++)
-			{
-				//*	openCV uses BGR instead of RGB
-				//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
-				pixelValue_Red		=	((myPixelPtr[pixelIndex + 2] & 0x00ff) << 8);
-				pixelValue_Grn		=	((myPixelPtr[pixelIndex + 1] & 0x00ff) << 8);
-				pixelValue_Blu		=	((myPixelPtr[pixelIndex + 0] & 0x00ff) << 8);
-
-				//	[65535,65535,65535],
-				sprintf(lineBuff, "[%d,%d,%d]", pixelValue_Red, pixelValue_Grn, pixelValue_Blu);
-				if (yyy < (numRows - 1))
-				{
-					strcat(lineBuff, ",");
-				}
-				strcat(longBuffer, lineBuff);
-				dataElementCnt++;
-				if (dataElementCnt >= 50)
-				{
-				//	printf("xxx=%3d\t>>%s\r\n", xxx, longBuffer);
-					strcat(longBuffer, "\n");
-					bufLen			=	strlen(longBuffer);
-					bytesWritten	=	write(socketFD, longBuffer, bufLen);
-					dataElementCnt	=	0;
-					longBuffer[0]	=	0;
-				}
-				//*	advance to the next row
-				pixelIndex	+=	(3 * numClms);
-
-				totalValuesWritten++;
-			}
-			if (xxx < (numClms - 1))
-			{
-				strcat(longBuffer, "],\n");
-			}
-			else
-			{
-				strcat(longBuffer, "]\n");
-			}
-			bufLen			=	strlen(longBuffer);
-			bytesWritten	=	write(socketFD, longBuffer, bufLen);
-			dataElementCnt	=	0;
-			longBuffer[0]	=	0;
-			if (bytesWritten <= 0)
-			{
-				CONSOLE_DEBUG("Write Error");
-			}
+			CONSOLE_DEBUG("Write Error");
 		}
-		CONSOLE_DEBUG(__FUNCTION__);
 	}
-	CONSOLE_DEBUG_W_NUM("totalValuesWritten\t=", totalValuesWritten);
+	else
+	{
+		CONSOLE_DEBUG("Failed to allocate JSON image buffer");
+	}
+	CONSOLE_DEBUG_W_LONG("totalValuesWritten\t=", totalValuesWritten);
 	CONSOLE_DEBUG("Done");
 }
 
@@ -5001,81 +5084,28 @@ void	CameraDriver::Send_imagearray_raw8(		const int		socketFD,
 												const int		numClms,
 												const int		pixelCount)
 {
-unsigned char	*myPixelPtr;
-int				pixelValue;
-char			lineBuff[256];
-int				xxx;
-int				yyy;
-int				bufLen;
-int				bytesWritten;
-char			longBuffer[2048];
-int				dataElementCnt;
-int				pixelIndex;
-int				totalValuesWritten;
+TYPE_ImageArrayJson	encoder;
+long				totalValuesWritten;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_NUM("numRows\t=", numRows);
 	CONSOLE_DEBUG_W_NUM("numClms\t=", numClms);
 
 	totalValuesWritten	=	0;
-	myPixelPtr			=	pixelPtr;
-	if (myPixelPtr != NULL)
+	if (Init_JsonImageEncoder(&encoder, socketFD, numRows, 1))
 	{
-		totalValuesWritten	=	0;
-		dataElementCnt		=	0;
-		longBuffer[0]		=	0;
 		//*	Alpaca JSON has column order first, i.e. all the pixels down the first column, then then the 2nd column etc...
-		for (xxx=0; xxx < numClms; xxx++)
+		totalValuesWritten	=	ImageArrayJson_Send_Raw8(&encoder, pixelPtr, numRows, numClms);
+		if (encoder.writeError)
 		{
-			if ((xxx % 500) == 0)
-			{
-				CONSOLE_DEBUG_W_NUM("xxx\t=", xxx);
-			}
-
-			strcpy(longBuffer, "[");
-			dataElementCnt	=	0;
-			pixelIndex		=	xxx;
-			//*	stop at n-1 so we can do the last one without a comma
-			for (yyy=0; yyy < (numRows - 1); yyy++)
-			{
-				pixelValue		=	((myPixelPtr[pixelIndex] & 0x00ff) << 8);
-				sprintf(lineBuff, "%d,", pixelValue);
-				strcat(longBuffer, lineBuff);
-				bufLen	=	strlen(longBuffer);
-
-				dataElementCnt++;
-				if (dataElementCnt >= 100)
-				{
-					strcat(longBuffer, "\n");
-					bufLen			=	strlen(longBuffer);
-					bytesWritten	=	write(socketFD, longBuffer, bufLen);
-					dataElementCnt	=	0;
-					longBuffer[0]	=	0;
-				}
-				pixelIndex	+=	numClms;
-
-				totalValuesWritten++;
-			}
-			//*	now do the last one WITHOUT the comma
-			pixelValue		=	((myPixelPtr[pixelIndex] & 0x00ff) << 8);
-			sprintf(lineBuff, "%d]", pixelValue);
-			totalValuesWritten++;
-			if (xxx < (numClms - 1))
-			{
-				strcat(lineBuff, ",");
-			}
-			strcat(lineBuff, "\n");
-
-			strcat(longBuffer, lineBuff);
-			bufLen			=	strlen(longBuffer);
-			bytesWritten	=	write(socketFD, longBuffer, bufLen);
-			if (bytesWritten <= 0)
-			{
-				CONSOLE_DEBUG("Write Error");
-			}
+			CONSOLE_DEBUG("Write Error");
 		}
 	}
-	CONSOLE_DEBUG_W_NUM("totalValuesWritten\t=", totalValuesWritten);
+	else
+	{
+		CONSOLE_DEBUG("Failed to allocate JSON image buffer");
+	}
+	CONSOLE_DEBUG_W_LONG("totalValuesWritten\t=", totalValuesWritten);
 	CONSOLE_DEBUG("Done");
 }
 
@@ -5087,77 +5117,27 @@ void	CameraDriver::Send_imagearray_raw16(	const int	socketFD,
 												const int	numClms,
 												const int	pixelCount)
 {
-uint16_t		*myPixelPtr;
-uint32_t		pixelValue;
-char			lineBuff[256];
-int				xxx;
-int				yyy;
-int				bufLen;
-int				bytesWritten;
-char			longBuffer[1024];
-int				dataElementCnt;
-int				pixelIndex;
-int				totalValuesWritten;
+TYPE_ImageArrayJson	encoder;
+long				totalValuesWritten;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_NUM("numRows\t=", numRows);
 	CONSOLE_DEBUG_W_NUM("numClms\t=", numClms);
 
 	totalValuesWritten	=	0;
-	myPixelPtr			=	pixelPtr;
-	if (myPixelPtr != NULL)
+	if (Init_JsonImageEncoder(&encoder, socketFD, numRows, 1))
 	{
-		totalValuesWritten	=	0;
-		dataElementCnt		=	0;
-		longBuffer[0]		=	0;
-		for (xxx=0; xxx < numClms; xxx++)
+		totalValuesWritten	=	ImageArrayJson_Send_Raw16(&encoder, pixelPtr, numRows, numClms);
+		if (encoder.writeError)
 		{
-			if ((xxx % 500) == 0)
-			{
-				CONSOLE_DEBUG_W_NUM("xxx\t=", xxx);
-			}
-			strcpy(longBuffer, "[");
-			dataElementCnt	=	0;
-			pixelIndex		=	xxx;
-			//*	stop at n-1 so we can do the last one without a comma
-			for (yyy=0; yyy < (numRows - 1); yyy++)
-			{
-				pixelValue		=	((myPixelPtr[pixelIndex] & 0x0ffff));
-				sprintf(lineBuff, "%d,", pixelValue);
-				strcat(longBuffer, lineBuff);
-				dataElementCnt++;
-				if (dataElementCnt >= 100)
-				{
-					strcat(longBuffer, "\n");
-					bufLen			=	strlen(longBuffer);
-					bytesWritten	=	write(socketFD, longBuffer, bufLen);
-					dataElementCnt	=	0;
-					longBuffer[0]	=	0;
-				}
-				pixelIndex	+=	numClms;
-
-				totalValuesWritten++;
-			}
-			//*	now do the last one WITHOUT the comma
-			pixelValue		=	((myPixelPtr[pixelIndex] & 0x0ffff));
-			sprintf(lineBuff, "%d]", pixelValue);
-			totalValuesWritten++;
-			if (xxx < (numClms - 1))
-			{
-				strcat(lineBuff, ",");
-			}
-			strcat(lineBuff, "\n");
-
-			strcat(longBuffer, lineBuff);
-			bufLen			=	strlen(longBuffer);
-			bytesWritten	=	write(socketFD, longBuffer, bufLen);
-			if (bytesWritten <= 0)
-			{
-				CONSOLE_DEBUG("Write Error");
-			}
+			CONSOLE_DEBUG("Write Error");
 		}
 	}
-	CONSOLE_DEBUG_W_NUM("totalValuesWritten\t=", totalValuesWritten);
+	else
+	{
+		CONSOLE_DEBUG("Failed to allocate JSON image buffer");
+	}
+	CONSOLE_DEBUG_W_LONG("totalValuesWritten\t=", totalValuesWritten);
 	CONSOLE_DEBUG("Done");
 }
 
@@ -5179,6 +5159,7 @@ char				lineBuff[256];
 char				imageTimeString[256];
 double				exposureTimeSecs;
 TYPE_ASCOM_STATUS	tempSensorErr;
+int					frameRingIdx;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	gImageDownloadInProgress	=	true;
@@ -5233,7 +5214,9 @@ TYPE_ASCOM_STATUS	tempSensorErr;
 	CONSOLE_DEBUG_W_NUM("pixelCount\t=", pixelCount);
 
 	CONSOLE_DEBUG_W_NUM("cCameraProp.ImageReady\t=", cCameraProp.ImageReady);
-	if (cCameraProp.ImageReady && (cCameraDataBuffer != NULL))
+	//*	hold on to the frame until it has been sent
+	frameRingIdx	=	FrameRing_AcquireReady();
+	if (cCameraProp.ImageReady && (frameRingIdx >= 0))
 	{
 		//========================================================================================
 		//*	record the image type
@@ -5279,7 +5262,7 @@ TYPE_ASCOM_STATUS	tempSensorErr;
 										reqData->jsonTextBuffer,
 										kBuffSize_MaxSpeed,
 										gValueString);
-		pixelPtr	=	cCameraDataBuffer;
+		pixelPtr	=	cFrameRing[frameRingIdx].dataBuffer;
 		CONSOLE_DEBUG_W_NUM("pixelCount\t=", pixelCount);
 
 		//*	Flush the json buffer
@@ -5378,6 +5361,10 @@ TYPE_ASCOM_STATUS	tempSensorErr;
 		alpacaErrCode	=	kASCOM_Err_InvalidOperation;
 		GENERATE_ALPACAPI_ERRMSG(alpacaErrMsg, "No image available");
 	}
+	if (frameRingIdx >= 0)
+	{
+		FrameRing_Release(frameRingIdx);
+	}
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, "--exit");
 	gImageDownloadInProgress	=	false;
 	return(alpacaErrCode);
@@ -5617,7 +5604,7 @@ bool				validTrueFalse;
 //	CONSOLE_DEBUG(__FUNCTION__);
 	if (cCameraProp.CanFastReadout)
 	{
-		fastReadOutFound	=	GetKeyWordArgument(	reqData->contentData,
+		fastReadOutFound	=	GetKeyWordArgument(	reqData,
 												"FastReadout",
 												myFastReadOutStr,
 												(sizeof(myFastReadOutStr) -1));
@@ -5682,7 +5669,7 @@ char				myRefID[32];
 //	CONSOLE_DEBUG(__FUNCTION__);
 	strcpy(myRefID, "not specified");
 	alpacaErrCode	=	kASCOM_Err_Success;
-	refIDFound		=	GetKeyWordArgument(	reqData->contentData,
+	refIDFound		=	GetKeyWordArgument(	reqData,
 											"RefID",
 											myRefID,
 											(sizeof(myRefID) -1));
@@ -5702,15 +5689,15 @@ char				myRefID[32];
 		}
 	}
 
-	ProcessTelescopeKeyWord(reqData->contentData,	"Telescope",	cTelescopeModel,		kTelescopeDefMaxStrLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Instrument",	cTS_info.instrument,	kTelescopeDefMaxStrLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Focuser",		cTS_info.focuser,		kTelescopeDefMaxStrLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Filterwheel",	cTS_info.filterwheel,	kTelescopeDefMaxStrLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Object",		cObjectName,			kObjectNameMaxLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Prefix",		cFileNamePrefix,		kFileNamePrefixMaxLen);
-	ProcessTelescopeKeyWord(reqData->contentData,	"Suffix",		cFileNameSuffix,		kFileNamePrefixMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Telescope",	cTelescopeModel,		kTelescopeDefMaxStrLen);
+	ProcessTelescopeKeyWord(reqData,	"Instrument",	cTS_info.instrument,	kTelescopeDefMaxStrLen);
+	ProcessTelescopeKeyWord(reqData,	"Focuser",		cTS_info.focuser,		kTelescopeDefMaxStrLen);
+	ProcessTelescopeKeyWord(reqData,	"Filterwheel",	cTS_info.filterwheel,	kTelescopeDefMaxStrLen);
+	ProcessTelescopeKeyWord(reqData,	"Object",		cObjectName,			kObjectNameMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Prefix",		cFileNamePrefix,		kFileNamePrefixMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"Suffix",		cFileNameSuffix,		kFileNamePrefixMaxLen);
 
-	ProcessTelescopeKeyWord(reqData->contentData,	"auxtext",		cAuxTextTag,			kAuxiliaryTextMaxLen);
+	ProcessTelescopeKeyWord(reqData,	"auxtext",		cAuxTextTag,			kAuxiliaryTextMaxLen);
 
 //		CONSOLE_DEBUG_W_STR("cTS_info.instrument\t=",	cTS_info.instrument);
 
@@ -5749,7 +5736,7 @@ bool				newLiveModeState;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	liveModeFound		=	GetKeyWordArgument(	reqData->contentData,
+	liveModeFound		=	GetKeyWordArgument(	reqData,
 												"Livemode",
 												livemodeString,
 												(sizeof(livemodeString) -1));
@@ -5830,7 +5817,7 @@ long				exposureDuration_us;	//*	micro seconds
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	durationFound		=	GetKeyWordArgument(	reqData->contentData,
+	durationFound		=	GetKeyWordArgument(	reqData,
 												"Duration",
 												duarationString,
 												(sizeof(duarationString) -1),
@@ -5896,7 +5883,7 @@ char				saveAllFoundString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	saveAllFound		=	GetKeyWordArgument(	reqData->contentData,
+	saveAllFound		=	GetKeyWordArgument(	reqData,
 												"saveallimages",
 												saveAllFoundString,
 												(sizeof(saveAllFoundString) -1));
@@ -5942,7 +5929,7 @@ char				saveAsFitsString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	saveAsFitsFound		=	GetKeyWordArgument(	reqData->contentData,
+	saveAsFitsFound		=	GetKeyWordArgument(	reqData,
 												"saveasfits",
 												saveAsFitsString,
 												(sizeof(saveAsFitsString) -1));
@@ -5988,7 +5975,7 @@ char				saveAsJPEGString[32];
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	saveAsJPEGFound		=	GetKeyWordArgument(	reqData->contentData,
+	saveAsJPEGFound		=	GetKeyWordArgument(	reqData,
 												"saveasjpeg",
 												saveAsJPEGString,
 												(sizeof(saveAsJPEGString) -1));
@@ -6036,7 +6023,7 @@ char				saveAsPNGString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	saveAsPNGFound		=	GetKeyWordArgument(	reqData->contentData,
+	saveAsPNGFound		=	GetKeyWordArgument(	reqData,
 												"saveaspng",
 												saveAsPNGString,
 												(sizeof(saveAsPNGString) -1));
@@ -6082,7 +6069,7 @@ char				saveAsRawString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	saveAsRawFound		=	GetKeyWordArgument(	reqData->contentData,
+	saveAsRawFound		=	GetKeyWordArgument(	reqData,
 												"saveasraw",
 												saveAsRawString,
 												(sizeof(saveAsRawString) -1));
@@ -6177,18 +6164,18 @@ double				deltaExp_secs;
 	ProcessExposureOptions(reqData);
 
 
-	sequenceCntFound	=	GetKeyWordArgument(	reqData->contentData,
+	sequenceCntFound	=	GetKeyWordArgument(	reqData,
 													"Count",
 													countString,
 													(sizeof(countString) -1));
 
-	delayFound			=	GetKeyWordArgument(	reqData->contentData,
+	delayFound			=	GetKeyWordArgument(	reqData,
 												"Delay",
 												delayString,
 												(sizeof(delayString) -1),
 												kArgumentIsNumeric);
 
-	deltaDurationFound	=	GetKeyWordArgument(	reqData->contentData,
+	deltaDurationFound	=	GetKeyWordArgument(	reqData,
 												"DeltaDuration",
 												deltaDurationString,
 												(sizeof(deltaDurationString) -1),
@@ -6237,11 +6224,15 @@ double				deltaExp_secs;
 
 //*****************************************************************************
 //*	if buffer size is <= zero, figure out the size
+//*	The buffer is the current write slot of the frame ring, the slot only gets
+//*	re-allocated if it is not big enough.
 //*****************************************************************************
 bool	CameraDriver::AllocateImageBuffer(long bufferSize)
 {
-int32_t		myBufferSize;
-bool		successFlag;
+int32_t			myBufferSize;
+bool			successFlag;
+bool			slotIsFree;
+TYPE_FrameSlot	*frameSlot;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
@@ -6254,43 +6245,308 @@ bool		successFlag;
 	{
 		myBufferSize	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize * 4;
 	}
-	if ((cCameraDataBuffer != NULL) && (myBufferSize <= cCameraDataBuffLen))
+
+	pthread_mutex_lock(&cFrameRingMutex);
+	slotIsFree	=	true;
+	frameSlot	=	&cFrameRing[cFrameRingWriteIdx];
+	if ((frameSlot->refCount > 0) || (cFrameRingWriteIdx == cFrameRingReadyIdx))
+	{
+		//*	not called from the state machine, dont write over a frame that is in use
+		slotIsFree	=	FrameRing_SelectWriteSlot();
+		frameSlot	=	&cFrameRing[cFrameRingWriteIdx];
+	}
+
+	if (slotIsFree == false)
+	{
+		//*	every slot is still in use, the caller must not read into any of them
+		CONSOLE_DEBUG("No free frame buffer");
+		successFlag	=	false;
+	}
+	else if ((frameSlot->dataBuffer != NULL) && (myBufferSize <= frameSlot->bufferLen))
 	{
 		//*	everything is OK
-//		CONSOLE_DEBUG_W_LONG("everything is OK, current buff size\t=", cCameraDataBuffLen);
+//		CONSOLE_DEBUG_W_LONG("everything is OK, current buff size\t=", frameSlot->bufferLen);
 		successFlag			=	true;
 	}
 	else
 	{
-		if (cCameraDataBuffer != NULL)
-		{
-			CONSOLE_DEBUG("Freeing existing buffer");
-			//*	buffer is not big enough, free it so we can allocate a new one
-			free(cCameraDataBuffer);
-			cCameraDataBuffer	=	NULL;
-			cCameraDataBuffLen	=	0;
-		}
-
 		CONSOLE_DEBUG_W_NUM("myBufferSize\t=", myBufferSize);
-		cCameraDataBuffer	=	(unsigned char *)malloc(myBufferSize + 128);
-		if (cCameraDataBuffer != NULL)
+		successFlag			=	FrameRing_AllocSlot(frameSlot, myBufferSize);
+		if (successFlag)
 		{
 			CONSOLE_DEBUG("cCameraDataBuffer allocated");
-			cCameraDataBuffLen	=	myBufferSize;
-			successFlag			=	true;
 		}
 		else
 		{
 			CONSOLE_DEBUG("cCameraDataBuffer FAILED");
-			cCameraDataBuffLen	=	0;
-			successFlag			=	false;
 		}
 	}
+	if (slotIsFree)
+	{
+		cCameraDataBuffer	=	frameSlot->dataBuffer;
+		cCameraDataBuffLen	=	frameSlot->bufferLen;
+	}
+	else
+	{
+		cCameraDataBuffer	=	NULL;
+	}
+	pthread_mutex_unlock(&cFrameRingMutex);
+
 //	CONSOLE_DEBUG(__FUNCTION__);
 	return(successFlag);
 }
 
+#pragma mark -
+#pragma mark Frame buffer ring
+#define	kHugePageSize	(2 * 1024 * 1024)
+
+//*****************************************************************************
+//*	(re)allocate the buffer for a slot, the slot must not be in use.
+//*	Big frames come from huge pages if the system has any reserved,
+//*	walking the whole frame (column order, stats, FITS) then needs far fewer TLB entries.
+//*****************************************************************************
+bool	CameraDriver::FrameRing_AllocSlot(TYPE_FrameSlot *frameSlot, long bufferSize)
+{
+size_t	allocSize;
+void	*newBuffer;
+bool	successFlag;
+
+	FrameRing_FreeSlot(frameSlot);
+
+	allocSize	=	bufferSize + 128;
+	newBuffer	=	NULL;
+#ifdef MAP_HUGETLB
+	if (allocSize >= kHugePageSize)
+	{
+	size_t	hugeSize;
 
+		hugeSize	=	(allocSize + kHugePageSize - 1) & ~((size_t)kHugePageSize - 1);
+		newBuffer	=	mmap(NULL, hugeSize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
+		if (newBuffer != MAP_FAILED)
+		{
+			allocSize				=	hugeSize;
+			frameSlot->hugePages	=	true;
+			cFrameRingStats.hugePageAllocs++;
+		}
+		else
+		{
+			//*	no huge pages available, fall back to normal memory
+			newBuffer	=	NULL;
+		}
+	}
+#endif // MAP_HUGETLB
+	if (newBuffer == NULL)
+	{
+		newBuffer	=	malloc(allocSize);
+	}
+
+	if (newBuffer != NULL)
+	{
+		frameSlot->dataBuffer	=	(unsigned char *)newBuffer;
+		frameSlot->bufferLen	=	bufferSize;
+		frameSlot->allocSize	=	allocSize;
+		cFrameRingStats.allocations++;
+		successFlag				=	true;
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_LONG("Failed to allocate frame buffer, size\t=", bufferSize);
+		successFlag				=	false;
+	}
+	return(successFlag);
+}
+
+//*****************************************************************************
+void	CameraDriver::FrameRing_FreeSlot(TYPE_FrameSlot *frameSlot)
+{
+	if (frameSlot->dataBuffer != NULL)
+	{
+		if (frameSlot->hugePages)
+		{
+			munmap(frameSlot->dataBuffer, frameSlot->allocSize);
+		}
+		else
+		{
+			free(frameSlot->dataBuffer);
+		}
+	}
+	frameSlot->dataBuffer	=	NULL;
+	frameSlot->bufferLen	=	0;
+	frameSlot->allocSize	=	0;
+	frameSlot->hugePages	=	false;
+}
+
+//*****************************************************************************
+//*	cFrameRingMutex must be locked
+//*	A slot is free if no one has a reference to it and it is not the latest frame.
+//*	Slots that are already big enough are used first so the ring only grows
+//*	to the number of frames that are actually in use at the same time.
+//*	returns -1 if there are no free slots
+//*****************************************************************************
+int	CameraDriver::FrameRing_FindFreeSlot(void)
+{
+int		slotIdx;
+int		iii;
+
+	slotIdx	=	-1;
+	if ((cFrameRing[cFrameRingWriteIdx].refCount == 0) && (cFrameRingWriteIdx != cFrameRingReadyIdx))
+	{
+		slotIdx	=	cFrameRingWriteIdx;
+	}
+	else
+	{
+		for (iii=0; iii<cFrameRingDepth; iii++)
+		{
+			if ((cFrameRing[iii].refCount == 0) && (iii != cFrameRingReadyIdx))
+			{
+				if (cFrameRing[iii].bufferLen >= cCameraDataBuffLen)
+				{
+					slotIdx	=	iii;
+					break;
+				}
+				else if (slotIdx < 0)
+				{
+					slotIdx	=	iii;
+				}
+			}
+		}
+	}
+	return(slotIdx);
+}
+
+//*****************************************************************************
+//*	cFrameRingMutex must be locked
+//*	Moves cFrameRingWriteIdx to a free slot, waits for one if they are all in use.
+//*	The new slot is made the same size as the previous one.
+//*	returns false if no slot was freed up in time, the write slot is left alone,
+//*	a slot with a reference is never written into or re-allocated.
+//*****************************************************************************
+bool	CameraDriver::FrameRing_SelectWriteSlot(void)
+{
+int				slotIdx;
+int				waitCnt;
+long			neededBuffLen;
+struct timespec	waitTime;
+bool			slotOK;
+
+	neededBuffLen	=	cCameraDataBuffLen;
+	slotIdx			=	FrameRing_FindFreeSlot();
+	if (slotIdx < 0)
+	{
+		cFrameRingStats.ringFullWaits++;
+	}
+	waitCnt	=	0;
+	while ((slotIdx < 0) && (waitCnt < kFrameRingMaxWaitSecs))
+	{
+		clock_gettime(CLOCK_REALTIME, &waitTime);
+		waitTime.tv_sec++;
+		pthread_cond_timedwait(&cFrameRingCondition, &cFrameRingMutex, &waitTime);
+		slotIdx	=	FrameRing_FindFreeSlot();
+		waitCnt++;
+	}
+
+	if (slotIdx >= 0)
+	{
+		cFrameRingWriteIdx	=	slotIdx;
+		slotOK				=	true;
+		if ((neededBuffLen > 0) && (cFrameRing[cFrameRingWriteIdx].bufferLen < neededBuffLen))
+		{
+			slotOK	=	FrameRing_AllocSlot(&cFrameRing[cFrameRingWriteIdx], neededBuffLen);
+		}
+		cCameraDataBuffer	=	cFrameRing[cFrameRingWriteIdx].dataBuffer;
+		cCameraDataBuffLen	=	cFrameRing[cFrameRingWriteIdx].bufferLen;
+	}
+	else
+	{
+		//*	someone is holding on to every frame, this frame has to be dropped
+		CONSOLE_DEBUG("Frame ring is full, dropping the frame");
+		cFrameRingStats.ringOverruns++;
+		slotOK	=	false;
+	}
+	return(slotOK);
+}
+
+//*****************************************************************************
+//*	called by the state machine before the image is read from the camera
+//*	returns false if there is no free slot to read the image into
+//*****************************************************************************
+bool	CameraDriver::FrameRing_NextWriteSlot(void)
+{
+bool	slotOK;
+
+	//*	a slot with no buffer yet is fine, AllocateImageBuffer() sizes it
+	pthread_mutex_lock(&cFrameRingMutex);
+	slotOK	=	FrameRing_SelectWriteSlot();
+	pthread_mutex_unlock(&cFrameRingMutex);
+	return(slotOK);
+}
+
+//*****************************************************************************
+//*	the frame in the write slot is complete, it is now the one that gets downloaded
+//*****************************************************************************
+void	CameraDriver::FrameRing_FrameComplete(void)
+{
+	pthread_mutex_lock(&cFrameRingMutex);
+	cFrameRingReadyIdx								=	cFrameRingWriteIdx;
+	cFrameRing[cFrameRingReadyIdx].frameNumber		=	cFramesRead;
+	cFrameRingStats.framesCompleted++;
+	pthread_mutex_unlock(&cFrameRingMutex);
+
+	//*	the stats are for the previous frame
+	cImageStats.valid	=	false;
+}
+
+//*****************************************************************************
+//*	returns the slot index of the latest frame with a reference added, -1 if none
+//*	FrameRing_Release() must be called when done with it
+//*****************************************************************************
+int	CameraDriver::FrameRing_AcquireReady(void)
+{
+int		slotIdx;
+int		slotsInUse;
+int		iii;
+
+	pthread_mutex_lock(&cFrameRingMutex);
+	slotIdx	=	cFrameRingReadyIdx;
+	if ((slotIdx >= 0) && (cFrameRing[slotIdx].dataBuffer != NULL))
+	{
+		cFrameRing[slotIdx].refCount++;
+
+		slotsInUse	=	0;
+		for (iii=0; iii<cFrameRingDepth; iii++)
+		{
+			if (cFrameRing[iii].refCount > 0)
+			{
+				slotsInUse++;
+			}
+		}
+		if (slotsInUse > cFrameRingStats.maxSlotsInUse)
+		{
+			cFrameRingStats.maxSlotsInUse	=	slotsInUse;
+		}
+	}
+	else
+	{
+		slotIdx	=	-1;
+	}
+	pthread_mutex_unlock(&cFrameRingMutex);
+	return(slotIdx);
+}
+
+//*****************************************************************************
+void	CameraDriver::FrameRing_Release(const int slotIdx)
+{
+	if ((slotIdx >= 0) && (slotIdx < kFrameRingMaxDepth))
+	{
+		pthread_mutex_lock(&cFrameRingMutex);
+		if (cFrameRing[slotIdx].refCount > 0)
+		{
+			cFrameRing[slotIdx].refCount--;
+		}
+		pthread_cond_broadcast(&cFrameRingCondition);
+		pthread_mutex_unlock(&cFrameRingMutex);
+	}
+}
 
 #pragma mark -
 #pragma mark Video commands
@@ -6312,7 +6568,7 @@ char				filePath[128];
 	//*	look for parameters in the request
 	ProcessExposureOptions(reqData);
 
-	recTimeFound	=	GetKeyWordArgument(	reqData->contentData,
+	recTimeFound	=	GetKeyWordArgument(	reqData,
 											"recordtime",
 											recordTimeStr,
 											(sizeof(recordTimeStr) -1),
@@ -6788,13 +7044,15 @@ int					mySocketFD;
 void	CameraDriver::OutputHTML_Part2(TYPE_GetPutRequestData *reqData)
 {
 char	lineBuffer[512];
+char	jpegImageName[256];
 
 	//===============================================================
 	//*	display the most recent jpeg image
-	if (strlen(cLastJpegImageName) > 0)
+	GetLastJpegImageName(jpegImageName, sizeof(jpegImageName));
+	if (strlen(jpegImageName) > 0)
 	{
 		SocketWriteData(reqData->socket,	"<CENTER>\r\n");
-		sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	cLastJpegImageName);
+		sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	jpegImageName);
 		SocketWriteData(reqData->socket,	lineBuffer);
 		SocketWriteData(reqData->socket,	"</CENTER>\r\n");
 	}
@@ -7181,6 +7439,7 @@ char	myImageTypeStr[16];
 //			CONSOLE_DEBUG_W_STR("myImageTypeStr\t=", myImageTypeStr);
 			strcpy(cCameraProp.ReadOutModes[readOutModeIdx].modeStr,	myImageTypeStr);
 		}
+		ResponseCache_Invalidate("readoutmodes");
 	}
 	else
 	{
@@ -7397,72 +7656,87 @@ TYPE_ASCOM_STATUS	alpacaErrCode;
 
 		case kExposure_Success:
 			CONSOLE_DEBUG("kExposure_Success");
-			cFramesRead++;
-			if (gVerbose)
-			{
-				CONSOLE_DEBUG_W_LONG("Done Taking picture, frame#", cFramesRead);
-			}
-
 			cWorkingLoopCnt		=	0;
-			//*	Extract Image
-			alpacaErrCode		=	Read_ImageData();
-			if (alpacaErrCode == kASCOM_Err_Success)
-			{
-				//*	record the time the exposure ended
-				gettimeofday(&cCameraProp.Lastexposure_EndTime, NULL);
-				cNewImageReadyToDisplay		=	true;
-				cCameraProp.ImageReady		=	true;
-//				CONSOLE_DEBUG("cCameraProp.ImageReady set to TRUE!!!!!!!!!!!!!!");
-
-				if (cImageMode == kImageMode_Live)
+			//*	Extract Image, into a slot that no one else is using
+			if (FrameRing_NextWriteSlot() == false)
+			{
+				//*	every frame is still being downloaded or saved, drop this one.
+				//*	This is not a camera error, video/live/sequence keep going
+				pthread_mutex_lock(&cFrameRingMutex);
+				cFrameRingStats.droppedFrames++;
+				pthread_mutex_unlock(&cFrameRingMutex);
+				if (gVerbose)
 				{
-				double	secondsOfExposure;
-
-					secondsOfExposure	=	millis() / 1000;
-					if (secondsOfExposure < 1.0)
-					{
-						secondsOfExposure	=	1.0;
-					}
-					cFrameRate	=	(cFramesRead * 1.0) / secondsOfExposure;
+					CONSOLE_DEBUG_W_LONG("No free frame buffer, frame dropped, total dropped\t=", cFrameRingStats.droppedFrames);
 				}
-		#ifdef _USE_OPENCV_
-				CreateOpenCVImage(cCameraDataBuffer);
-			#ifdef _IMAGE_OVERLAY_
-				if (cOverlayMode)
+			}
+			else
+			{
+				cFramesRead++;
+				if (gVerbose)
 				{
-					DrawOverlayOntoImage();
+					CONSOLE_DEBUG_W_LONG("Done Taking picture, frame#", cFramesRead);
 				}
+				alpacaErrCode	=	Read_ImageData();
+				if (alpacaErrCode == kASCOM_Err_Success)
+				{
+					FrameRing_FrameComplete();
+					//*	record the time the exposure ended
+					gettimeofday(&cCameraProp.Lastexposure_EndTime, NULL);
+					cNewImageReadyToDisplay		=	true;
+					cCameraProp.ImageReady		=	true;
+	//				CONSOLE_DEBUG("cCameraProp.ImageReady set to TRUE!!!!!!!!!!!!!!");
+
+					if (cImageMode == kImageMode_Live)
+					{
+					double	secondsOfExposure;
+
+						secondsOfExposure	=	millis() / 1000;
+						if (secondsOfExposure < 1.0)
+						{
+							secondsOfExposure	=	1.0;
+						}
+						cFrameRate	=	(cFramesRead * 1.0) / secondsOfExposure;
+					}
+			#ifdef _USE_OPENCV_
+					CreateOpenCVImage(cCameraDataBuffer);
+				#ifdef _IMAGE_OVERLAY_
+					if (cOverlayMode)
+					{
+						DrawOverlayOntoImage();
+					}
+				#endif
 			#endif
-		#endif
 
-				if (cSaveNextImage || cSaveAllImages)
-				{
-					SaveImageData();
-				}
-				else
-				{
-	//				CONSOLE_DEBUG("Image not saved");
-				}
+					if (cSaveNextImage || cSaveAllImages)
+					{
+						SaveImageData();
+					}
+					else
+					{
+		//				CONSOLE_DEBUG("Image not saved");
+					}
 
-				//*	check to see if we are in auto exposure adjustment
-				if (cAutoAdjustExposure)
-				{
-					AutoAdjustExposure();
-				}
+					//*	check to see if we are in auto exposure adjustment
+					if (cAutoAdjustExposure)
+					{
+						AutoAdjustExposure();
+					}
 
-			#ifdef _USE_OPENCV_
-				//*	check for live window
-				if (cLiveController != NULL)
+				#ifdef _USE_OPENCV_
+					//*	check for live window
+					if (cLiveController != NULL)
+					{
+						UpdateLiveWindow();
+					}
+				#endif
+				}
+				else
 				{
-					UpdateLiveWindow();
+					CONSOLE_DEBUG_W_NUM("Read_ImageData returned Alpaca error#", alpacaErrCode);
+					CONSOLE_DEBUG("Resetting to single image mode");
+					cImageMode				=	kImageMode_Single;
 				}
-			#endif
-			}
-			else
-			{
-				CONSOLE_DEBUG_W_NUM("Read_ImageData returned Alpaca error#", alpacaErrCode);
-				CONSOLE_DEBUG("Resetting to single image mode");
-				cImageMode				=	kImageMode_Single;
 			}
 
 			cInternalCameraState	=	kCameraState_Idle;
@@ -7949,7 +8223,7 @@ char				argumentString[32];
 bool				foundKeyWord;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"autoexposure",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -7989,7 +8263,7 @@ char				argumentString[32];
 bool				foundKeyWord;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"displayImage",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -8018,7 +8292,7 @@ bool				foundKeyWord;
 //	CONSOLE_DEBUG(__FUNCTION__);
 	//---------------------------------------------------------------------------
 	//*	look for camera
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"includecamera",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -8029,7 +8303,7 @@ bool				foundKeyWord;
 	}
 	//---------------------------------------------------------------------------
 	//*	look for filter
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"includefilter",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -8039,7 +8313,7 @@ bool				foundKeyWord;
 	}
 	//---------------------------------------------------------------------------
 	//*	look for RefID
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"includerefid",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -8049,7 +8323,7 @@ bool				foundKeyWord;
 	}
 	//---------------------------------------------------------------------------
 	//*	look for serial number
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"includeserialnum",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -8136,7 +8410,7 @@ int					newFlipMode;
 	{
 		CONSOLE_DEBUG(reqData->contentData);
 		//*	look for filter
-		foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+		foundKeyWord	=	GetKeyWordArgument(	reqData,
 												"flip",
 												argumentString,
 												(sizeof(argumentString) -1));
@@ -9167,6 +9441,7 @@ bool	foundFlag	=	true;
 		case kCmd_Camera_rgbarray:
 		case kCmd_Camera_savedimages:
 		case kCmd_Camera_savenextimage:
+		case kCmd_Camera_savequeue:
 		case kCmd_Camera_stopvideo:
 		case kCmd_Camera_readall:
 			strcpy(agumentString, "-none-");
@@ -7,6 +7,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Aug 26,	2019	<MLS> Created cameradriver.h
 //*	Oct  2,	2019	<MLS> Added image data buffer to base class
@@ -29,6 +30,11 @@
 //*	Jun  4,	2023	<MLS> Added cSaveAsFITS, cSaveAsJPEG, cSaveAsPNG, cSaveAsRAW
 //*	Aug 31,	2023	<MLS> Adding support for GPS, specifically the QHY174-GPS
 //*	Apr 19,	2024	<MLS> Added kImageType_MONO8
+//*	Oct 18,	2026	<AGT> Added cJsonImageWorkBuff for the JSON imagearray encoder
+//*	Oct 18,	2026	<AGT> Added TYPE_BinaryImageCache
+//*	Oct 18,	2026	<AGT> Added TYPE_SaveFrame and the asynchronous save queue
+//*	Oct 18,	2026	<AGT> Added TYPE_FrameSlot, the camera data buffer is now a ring of frames
+//*	Oct 18,	2026	<AGT> Added TYPE_ImageStats, all of the image analysis is done in one pass
 //*****************************************************************************
 //#include	"cameradriver.h"
 
@@ -95,6 +101,10 @@
 
 #include	"camera_defs.h"
 
+#ifndef _IMAGEARRAY_JSON_H_
+	#include	"imagearray_json.h"
+#endif
+
 #define	kImageDataDir_Default		"imagedata"
 
 extern	char	gImageDataDir[];
@@ -114,6 +124,62 @@ typedef enum
 	kCameraState_last
 } TYPE_CAMERA_STATE;
 
+//*****************************************************************************
+//*	The ImageBytes payload is column order, so it can never be sent directly from the
+//*	camera buffer. It is built once per frame into a buffer that is kept from one
+//*	download to the next, every client that asks for the same frame gets the same data
+//*****************************************************************************
+typedef struct
+{
+	unsigned char	*dataBuffer;
+	size_t			bufferSize;
+	size_t			dataLen;				//*	0 if nothing valid is in the buffer
+	//*	what is in the buffer
+	struct timeval	exposureStartTime;
+	struct timeval	exposureEndTime;
+	long			frameNumber;
+	int				imageType;
+	int				roiWidth;
+	int				roiHeight;
+	int				transmissionType;
+} TYPE_BinaryImageCache;
+
+//*****************************************************************************
+//*	Frame buffer ring
+//*	Each frame is read from the camera into a free slot of a small ring of buffers.
+//*	Anything that uses a frame after the camera thread is done with it (downloads,
+//*	the save queue) takes a reference to the slot, the camera never reads into a
+//*	slot that has a reference or holds the most recent frame.
+//*	Slots are allocated the first time they are needed and only re-allocated if the
+//*	image gets bigger. cCameraDataBuffer always points to the slot being read into.
+//*	If every slot is still in use after kFrameRingMaxWaitSecs the frame is dropped.
+//*****************************************************************************
+#define	kFrameRingMaxDepth		16
+#define	kFrameRingDefaultDepth	(kSaveQueueDepth + 2)	//*	full save queue + latest frame + next frame
+#define	kFrameRingMaxWaitSecs	5						//*	how long to wait for a free slot
+
+typedef struct	//	TYPE_FrameSlot
+{
+	unsigned char	*dataBuffer;
+	long			bufferLen;				//*	usable length
+	size_t			allocSize;				//*	what was actually allocated
+	bool			hugePages;				//*	true if mmap()'ed from huge pages
+	int				refCount;				//*	number of users of this frame
+	long			frameNumber;			//*	cFramesRead when the frame was completed
+} TYPE_FrameSlot;
+
+//*****************************************************************************
+typedef struct	//	TYPE_FrameRingStats
+{
+	long		framesCompleted;
+	long		allocations;
+	long		hugePageAllocs;
+	long		ringFullWaits;			//*	number of times the camera had to wait for a free slot
+	long		ringOverruns;			//*	number of times there was no free slot after waiting
+	long		droppedFrames;			//*	frames from the camera that were skipped because of an overrun
+	int			maxSlotsInUse;
+} TYPE_FrameRingStats;
+
 
 
 //*****************************************************************************
@@ -201,6 +267,7 @@ typedef struct	//	TYPE_FILENAME
 //#define	kNumSupportedFormats	8
 #define	kMaxCameraNameLen		64
 #define	kObjectNameMaxLen		31
+#define	kFileNameRootMaxLen		256
 #define	kTelescopeNameMaxLen	80
 #define	kFileNamePrefixMaxLen	16
 
@@ -209,6 +276,148 @@ typedef struct	//	TYPE_FILENAME
 #define	SAVE_AVI	true
 
 
+//*****************************************************************************
+//*	Image statistics, calculated in one pass over the frame and kept until the next frame.
+//*	For RGB images, min, max, mean and std dev are over all 3 colors.
+//*	For 16 bit images, the histogram is based on the high 8 bits.
+//*****************************************************************************
+typedef struct	//	TYPE_ImageStats
+{
+	bool			valid;
+	long			frameNumber;			//*	cFramesRead when the stats were calculated
+	int				imageType;
+	uint32_t		pixelCount;
+	uint32_t		minPixelValue;
+	uint32_t		maxPixelValue;
+	uint32_t		saturatedPixCnt;
+	double			saturationPrcnt;
+	double			meanValue;
+	double			stdDevValue;
+	uint8_t			maxRedValue;
+	uint8_t			maxGrnValue;
+	uint8_t			maxBluValue;
+	uint8_t			maxGryValue;
+	int32_t			histogramLum[256];
+	int32_t			histogramRed[256];
+	int32_t			histogramGrn[256];
+	int32_t			histogramBlu[256];
+	int				threadCnt;				//*	how many threads it was split across
+	uint32_t		calcMillis;
+} TYPE_ImageStats;
+
+//*****************************************************************************
+//*	Asynchronous save queue
+//*	When an image is to be saved, a reference to the image data and everything the
+//*	save routines need to know about it is put into a frame taken from a small pool.
+//*	The save worker threads write the files while the camera goes on to the next exposure.
+//*	If all of the frames are in use, the camera waits for one to be released.
+//*****************************************************************************
+#define	kSaveQueueDepth			4
+#define	kSaveWorkerThreadCnt	2
+
+//*	timing is kept for each stage of the save
+enum
+{
+	kSaveStage_Snapshot	=	0,		//*	copying the frame (camera thread)
+	kSaveStage_Queued,				//*	time waiting in the queue
+	kSaveStage_IMU,
+	kSaveStage_OpenCV,
+	kSaveStage_FITS,
+	kSaveStage_Total,				//*	from the time it was queued until the last file was written
+
+	kSaveStage_last
+};
+
+//*****************************************************************************
+typedef enum
+{
+	kSaveFrame_Free	=	0,
+	kSaveFrame_Capture,
+	kSaveFrame_Queued,
+	kSaveFrame_Saving
+
+} TYPE_SAVE_FRAME_STATE;
+
+//*****************************************************************************
+typedef struct	//	TYPE_SaveFrame
+{
+	TYPE_SAVE_FRAME_STATE	frameState;
+	bool					ownsBuffers;			//*	false if the buffers belong to the camera
+	int						frameRingIdx;			//*	frame ring slot the pixels are in, -1 if none
+	unsigned char			*pixelBuffer;
+	long					pixelBufferSize;
+	long					pixelDataLen;
+	unsigned char			*pixelCopyBuffer;		//*	only used if the frame is not in the ring
+	long					pixelCopyBufferSize;
+	unsigned char			*bgrBuffer;				//*	Blue, Green, Red planes for FITS
+	long					bgrBufferSize;
+#if defined(_USE_OPENCV_) && (defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4))
+	cv::Mat					*openCVimagePtr;		//*	copy of the openCV image (with overlay)
+#endif
+
+	//*	everything about the frame that can change when the next exposure starts
+	TYPE_CameraProperties	cameraProp;
+	TYPE_IMAGE_TYPE			imageType;
+	TYPE_IMAGE_MODE			imageMode;
+	int						imageSeqNumber;
+	int						numFramesRequested;
+	double					frameRate;
+	long					frameNumber;
+	char					objectName[kObjectNameMaxLen + 1];
+	char					fileNameRoot[kFileNameRootMaxLen];
+	bool					saveAsFITS;
+	bool					saveAsJPEG;
+	bool					saveAsPNG;
+	bool					ccdTempValid;
+
+	//*	image analysis, calculated before the frame is queued
+	uint32_t				minPixelValue;
+	uint32_t				maxPixelValue;
+	uint32_t				saturationPixCount;
+	double					saturationPrcnt;
+	double					meanPixelValue;
+	double					stdDevPixelValue;
+	int32_t					minHistogramValue;
+	int32_t					peakHistogramValue;
+	int32_t					maxHistogramValue;
+
+#ifdef _ENABLE_IMU_
+	bool					imuEulerValid;
+	bool					imuQuatValid;
+	double					imuHeading;
+	double					imuRoll;
+	double					imuPitch;
+	double					imuWWW;
+	double					imuXXX;
+	double					imuYYY;
+	double					imuZZZ;
+	int						imuCalGyro;
+	int						imuCalAcce;
+	int						imuCalMagn;
+	int						imuCalSyst;
+#endif
+
+	//*	other data products for the FITS header
+	TYPE_FILENAME			otherDataProducts[kMaxDataProducts];
+	int						otherDataCnt;
+
+	uint32_t				stageStartMillis;
+	uint32_t				stageMillis[kSaveStage_last];
+} TYPE_SaveFrame;
+
+//*****************************************************************************
+typedef struct	//	TYPE_SaveQueueStats
+{
+	long		framesQueued;
+	long		framesSaved;
+	long		queueFullWaits;			//*	number of times the camera had to wait for a free frame
+	int			maxQueueDepth;
+	uint32_t	lastMillis[kSaveStage_last];
+	uint32_t	maxMillis[kSaveStage_last];
+	double		sumMillis[kSaveStage_last];		//*	for calculating the average
+} TYPE_SaveQueueStats;
+
+
 
 //**************************************************************************************
 //*	image flip, this is the ZWO definition, we will adopt that
@@ -236,6 +445,7 @@ class CameraDriver: public AlpacaDriver
 		virtual	bool				AlpacaConnect(void);
 		virtual	bool				AlpacaDisConnect(void);
 		virtual	TYPE_ASCOM_STATUS	ProcessCommand(TYPE_GetPutRequestData *reqData);
+		virtual	bool				IsConcurrentCommand(TYPE_GetPutRequestData *reqData);
 		virtual	void				OutputHTML(TYPE_GetPutRequestData *reqData);
 		virtual	void				OutputHTML_Part2(TYPE_GetPutRequestData *reqData);
 		virtual bool				GetCommandArgumentString(const int cmdNumber, char *agumentString, char *commentString);
@@ -259,6 +469,7 @@ class CameraDriver: public AlpacaDriver
 
 				void	SaveImageData(void);
 				void	SaveNextImage(void);
+				void	SaveQueue_WorkerLoop(void);
 				void	SetLastExposureInfo(void);
 	protected:
 		//*	Camera routines for all cameras
@@ -361,14 +572,15 @@ class CameraDriver: public AlpacaDriver
 
 		TYPE_ASCOM_STATUS	Get_Imagearray_JSON(	TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
 		TYPE_ASCOM_STATUS	Get_Imagearray_Binary(	TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
-		int					BuildBinaryImage_Raw8(			unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_Raw8_16bit(	unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_Raw8_32bit(	unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_Raw16(			unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_Raw32(			unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_RGB24(			unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_RGB24_32bit(	uint32_t		*binaryDataBuffer, int startOffset, int bufferSize);
-		int					BuildBinaryImage_RGBx16(		unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_Raw8(			const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_Raw8_16bit(	const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_Raw8_32bit(	const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_Raw16(			const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_Raw32(			const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_RGB24(			const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_RGB24_32bit(	const unsigned char *pixelBuffer, uint32_t		*binaryDataBuffer, int startOffset, int bufferSize);
+		int					BuildBinaryImage_RGBx16(		const unsigned char *pixelBuffer, unsigned char	*binaryDataBuffer, int startOffset, int bufferSize);
+		size_t				BuildBinaryImage_Cached(		const int transmissionType, const size_t imageDataLen);
 
 		//-------------------------------------------------------------------------------------------------
 		//*	Added by MLS
@@ -435,12 +647,25 @@ virtual	TYPE_ASCOM_STATUS	Get_Readall(			TYPE_GetPutRequestData *reqData, char *
 
 
 				bool	AllocateImageBuffer(long bufferSize);
+				//*	frame buffer ring
+				bool	FrameRing_AllocSlot(TYPE_FrameSlot *frameSlot, long bufferSize);
+				void	FrameRing_FreeSlot(TYPE_FrameSlot *frameSlot);
+				int		FrameRing_FindFreeSlot(void);
+				bool	FrameRing_SelectWriteSlot(void);
+				bool	FrameRing_NextWriteSlot(void);
+				void	FrameRing_FrameComplete(void);
+				int		FrameRing_AcquireReady(void);
+				void	FrameRing_Release(const int slotIdx);
 
 				void	GenerateFileNameRoot(void);
 				void	WriteFireCaptureTextFile(void);
-				void	WriteIMUtextFile(void);
+				void	WriteIMUtextFile(TYPE_SaveFrame *saveFrame);
 
 
+				bool	Init_JsonImageEncoder(	TYPE_ImageArrayJson	*encoder,
+												const int			socketFD,
+												const int			numRows,
+												const int			valuesPerPixel);
 				void	Send_imagearray_rgb24(	const int		socketFD,
 												unsigned char	*pixelPtr,
 												const int		numRows,
@@ -460,28 +685,42 @@ virtual	TYPE_ASCOM_STATUS	Get_Readall(			TYPE_GetPutRequestData *reqData, char *
 				void	Send_RGBarray_rgb24(const int socketFD, unsigned char *pixelPtr, const int pixelCount);
 				void	Send_RGBarray_raw8(const int socketFD, unsigned char *pixelPtr, const int pixelCount);
 
+				//*	asynchronous save queue
+				void	SaveQueue_Start(void);
+				void	SaveQueue_Stop(void);
+				TYPE_SaveFrame	*SaveQueue_GetFreeFrame(void);
+				void	SaveQueue_Push(TYPE_SaveFrame *saveFrame);
+				void	SaveQueue_ReleaseFrame(TYPE_SaveFrame *saveFrame);
+				void	SaveFrame_Capture(TYPE_SaveFrame *saveFrame, const bool copyImageData);
+				void	SaveFrame_CaptureFitsInfo(TYPE_SaveFrame *saveFrame);
+				void	SetLastJpegImageName(const char *imageName);
+				void	GetLastJpegImageName(char *imageName, const int maxLen);
+				void	SaveFrame_WriteFiles(TYPE_SaveFrame *saveFrame);
+				TYPE_ASCOM_STATUS	Get_SaveQueue(TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
+
 			#ifdef _ENABLE_FITS_
 				int		SaveImageAsFITS(bool headerOnly=false);
-				void	CreateFitsBGRimage(void);
+				int		SaveImageAsFITS_Frame(TYPE_SaveFrame *saveFrame, bool headerOnly);
+				void	CreateFitsBGRimage(TYPE_SaveFrame *saveFrame);
 				void	WriteFITS_Seperator(fitsfile *fitsFilePtr, const char *blockName);
 
-				void	WriteFITS_CameraInfo(		fitsfile *fitsFilePtr);
+				void	WriteFITS_CameraInfo(		fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame);
 				void	WriteFITS_EnvironmentInfo(	fitsfile *fitsFilePtr);
 				void	WriteFITS_FilterwheelInfo(	fitsfile *fitsFilePtr);
 				void	WriteFITS_FocuserInfo(		fitsfile *fitsFilePtr);
-				void	WriteFITS_ObservationInfo(	fitsfile *fitsFilePtr, bool includeAnalysis);
+				void	WriteFITS_ObservationInfo(	fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame, bool includeAnalysis);
 				void	WriteFITS_ObservatoryInfo(	fitsfile *fitsFilePtr);
 				void	WriteFITS_RotatorInfo(		fitsfile *fitsFilePtr);
 				void	WriteFITS_SoftwareInfo(		fitsfile *fitsFilePtr);
-				void	WriteFITS_TelescopeInfo(	fitsfile *fitsFilePtr);
+				void	WriteFITS_TelescopeInfo(	fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame);
 				void	WriteFITS_VersionInfo(		fitsfile *fitsFilePtr);
-				void	WriteFITS_MoonInfo(			fitsfile *fitsFilePtr);
+				void	WriteFITS_MoonInfo(			fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame);
 				void	WriteFITS_GPSinfo(			fitsfile *fitsFilePtr);
 				void	WriteFITS_QHY_GPSinfo(		fitsfile *fitsFilePtr);
 				void	WriteFITS_Global_GPSinfo(	fitsfile *fitsFilePtr);
 
 			#ifdef _ENABLE_IMU_
-				void	WriteFITS_IMUinfo(			fitsfile *fitsFilePtr);
+				void	WriteFITS_IMUinfo(			fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame);
 			#endif
 
 				TYPE_ASCOM_STATUS	Get_FitsHeader(TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
@@ -530,6 +769,9 @@ virtual	TYPE_ASCOM_STATUS	Get_Readall(			TYPE_GetPutRequestData *reqData, char *
 		void			DisplayLiveImage_wSideBar(void);
 		int				CreateOpenCVImage(const unsigned char *imageDataPtr);
 		int				SaveOpenCVImage(void);
+	#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+		int				SaveOpenCVImage_Frame(TYPE_SaveFrame *saveFrame);
+	#endif
 		void			SetOpenCVcallbackFunction(const char *windowName);
 		void			ProcessMouseEvent(int event, int xxx, int yyy, int flags);
 		void			DrawOpenCVoverlay(void);
@@ -549,6 +791,7 @@ virtual	TYPE_ASCOM_STATUS	Get_Readall(			TYPE_GetPutRequestData *reqData, char *
 	#endif	//	_USE_OPENCV_
 		//*****************************************************************************
 		//*	image analysis routines
+		void			CalculateImageStats(void);
 		uint32_t		CalculateMaxPixValue(void);
 		uint32_t		CalculateMinPixValue(void);
 		uint32_t		CountSaturationPixels(void);
@@ -693,6 +936,22 @@ protected:
 	long				cCameraDataBuffLen;
 	unsigned char		*cCameraDataBuffer;
 	unsigned char		*cCameraBGRbuffer;			//*	Blue, Green, Red, for FITS
+	long				cCameraBGRbuffSize;
+	void				*cJsonImageWorkBuff;		//*	re-used by the JSON imagearray encoder
+	TYPE_BinaryImageCache	cBinaryImageCache;		//*	last ImageBytes payload that was sent
+	size_t				cJsonImageWorkBuffSize;
+
+	//===========================================================================
+	//*	frame buffer ring, cCameraDataBuffer points to cFrameRing[cFrameRingWriteIdx]
+	pthread_mutex_t		cFrameRingMutex;
+	pthread_cond_t		cFrameRingCondition;		//*	signaled when a reference is released
+	TYPE_FrameSlot		cFrameRing[kFrameRingMaxDepth];
+	int					cFrameRingDepth;
+	int					cFrameRingWriteIdx;			//*	slot the camera reads into
+	int					cFrameRingReadyIdx;			//*	most recent complete frame, -1 if none
+	TYPE_FrameRingStats	cFrameRingStats;
+
+	TYPE_ImageStats		cImageStats;				//*	analysis of the most recent frame
 
 	int					cAVIfourCC;					//*	the fourCC mode used in the avi file
 
@@ -724,6 +983,22 @@ protected:
 
 	int					cTotalFramesSaved;
 
+	//===========================================================================
+	//*	asynchronous save queue
+	bool				cSaveQueueRunning;
+	bool				cSaveQueueStopping;			//*	tells the worker threads to exit
+	int					cSaveWorkerCnt;				//*	number of worker threads that were started
+	pthread_mutex_t		cSaveQueueMutex;
+	pthread_cond_t		cSaveQueueCondition;		//*	signaled when a frame is queued
+	pthread_cond_t		cSaveFrameFreeCondition;	//*	signaled when a frame is released
+	pthread_t			cSaveWorkerThreadIDs[kSaveWorkerThreadCnt];
+	TYPE_SaveFrame		cSaveFrames[kSaveQueueDepth];
+	TYPE_SaveFrame		*cSaveQueue[kSaveQueueDepth];
+	int					cSaveQueueHead;
+	int					cSaveQueueCount;
+	int					cSaveFramesInUse;
+	TYPE_SaveQueueStats	cSaveQueueStats;
+
 	//===========================================================================
 	//*	data for taking video
 	int					cNumVideoFramesSaved;
@@ -745,8 +1020,8 @@ protected:
 	TYPE_FilenameOptions	cFN;
 
 	char					cObjectName[kObjectNameMaxLen + 1];
-	char					cFileNameRoot[256];
-	char					cLastJpegImageName[256];
+	char					cFileNameRoot[kFileNameRootMaxLen];
+	char					cLastJpegImageName[256];	//*	written by the save threads, protected by cSaveQueueMutex
 	char					cFileNamePrefix[kFileNamePrefixMaxLen + 1];
 	char					cFileNameSuffix[kFileNamePrefixMaxLen + 1];
 
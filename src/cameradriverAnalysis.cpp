@@ -30,6 +30,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Nov 24,	2019	<MLS> Created cameradriverAnalysis.cpp
 //*	Nov 24,	2019	<MLS> Started on camera analysis code
@@ -45,12 +46,24 @@
 //*	Jan 12,	2020	<MLS> Added better limit checking to AutoAdjustExposure()
 //*	Feb 15,	2020	<MLS> Fixed negative exposure bug in AutoAdjustExposure()
 //*	Apr 22,	2024	<MLS> Added support for kImageType_MONO8 (8 bit image type)
+//*	Oct 18,	2026	<AGT> Added CalculateImageStats(), one pass for everything, split across cores
+//*	Oct 18,	2026	<AGT> The other analysis routines now use the stats for the current frame
 //**************************************************************************
 
 #ifdef _ENABLE_CAMERA_
 
 #include	<stdio.h>
+#include	<stdlib.h>
 #include	<string.h>
+#include	<math.h>
+#include	<unistd.h>
+#include	<pthread.h>
+
+#if defined(__SSE2__)
+	#include	<emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include	<arm_neon.h>
+#endif
 
 #if defined(__arm__)
 	#include <wiringPi.h>
@@ -61,270 +74,541 @@
 
 #include	"alpacadriver.h"
 #include	"alpacadriver_helper.h"
+#include	"helper_functions.h"
 #include	"cameradriver.h"
 
 
 
+#define	kImageStatsMaxThreads		4
+#define	kImageStatsMinPixPerThread	(512 * 1024)	//*	not worth starting a thread for less than this
+#define	kHistSubTables				4				//*	consecutive pixels go into different tables
+
 //**************************************************************************
-//*	Calculate the minimum pixel value for the current data buffer
+//*	Each thread does a band of rows, the results are combined when they are all done.
+//*	Incrementing the same histogram bin for consecutive pixels (very common in
+//*	astro images) stalls waiting for the previous store, so each histogram is kept
+//*	in several sub tables that are added together at the end.
 //**************************************************************************
-uint32_t	CameraDriver::CalculateMinPixValue(void)
+typedef struct
 {
-uint32_t		minPixelValue;
-uint32_t		imageDataLen;
-uint32_t		currPixValue;
+	const uint8_t	*pixelPtr;
+	uint32_t		pixelCount;
+	int				imageType;
+	uint32_t		minPixelValue;			//*	16 bit only, 8 bit comes from the histogram
+	uint32_t		maxPixelValue;
+	uint32_t		saturatedPixCnt;		//*	16 bit and RGB
+	uint64_t		pixelSum;				//*	16 bit only
+	uint64_t		pixelSumSqr;
+	uint32_t		histogram[3][kHistSubTables][256];	//*	[0] is lum or red, [1] grn, [2] blu
+} TYPE_StatsSlice;
+
+//**************************************************************************
+static void	StatsSlice_Mono8(TYPE_StatsSlice *slice)
+{
+const uint8_t	*pixPtr;
+uint32_t		(*histogram)[256];
 uint32_t		ii;
-uint32_t		cc;
-uint16_t		*imageDataPtr16bit;
-uint8_t			*imageDataPtr8bit;
-uint32_t		redValue;
-uint32_t		grnValue;
-uint32_t		bluValue;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
+	pixPtr		=	slice->pixelPtr;
+	histogram	=	slice->histogram[0];
+	ii			=	0;
+	while ((ii + 4) <= slice->pixelCount)
+	{
+		histogram[0][pixPtr[ii + 0]]++;
+		histogram[1][pixPtr[ii + 1]]++;
+		histogram[2][pixPtr[ii + 2]]++;
+		histogram[3][pixPtr[ii + 3]]++;
+		ii	+=	4;
+	}
+	while (ii < slice->pixelCount)
+	{
+		histogram[0][pixPtr[ii]]++;
+		ii++;
+	}
+}
 
-	minPixelValue	=	65535;
-	imageDataLen	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
+//**************************************************************************
+//*	openCV uses BGR instead of RGB
+//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
+//**************************************************************************
+static void	StatsSlice_RGB24(TYPE_StatsSlice *slice)
+{
+const uint8_t	*pixPtr;
+uint32_t		ii;
+uint32_t		subTbl;
+uint32_t		saturatedPixCnt;
+uint8_t			redValue;
+uint8_t			grnValue;
+uint8_t			bluValue;
 
-	if (cCameraDataBuffer != NULL)
+	pixPtr			=	slice->pixelPtr;
+	saturatedPixCnt	=	0;
+	for (ii=0; ii<slice->pixelCount; ii++)
 	{
-		GetImage_ROI_info();
-
-		switch(cROIinfo.currentROIimageType)
+		bluValue	=	pixPtr[0];
+		grnValue	=	pixPtr[1];
+		redValue	=	pixPtr[2];
+		subTbl		=	ii & 0x01;
+		slice->histogram[0][subTbl][redValue]++;
+		slice->histogram[1][subTbl][grnValue]++;
+		slice->histogram[2][subTbl][bluValue]++;
+		//*	if any of the 3 RGB values is 255, then that pixel is at saturation
+		if ((redValue == 0x0ff) || (grnValue == 0x0ff) || (bluValue == 0x0ff))
 		{
-			case kImageType_RAW8:
-			case kImageType_MONO8:
-			case kImageType_Y8:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					currPixValue	=	imageDataPtr8bit[ii] & 0x00ff;
-					if (currPixValue < minPixelValue)
-					{
-						minPixelValue	=	currPixValue;
-					}
-				}
-				break;
-
-			case kImageType_RAW16:
-				imageDataPtr16bit	=	(uint16_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					currPixValue	=	imageDataPtr16bit[ii] & 0x00ffff;
-					if (currPixValue < minPixelValue)
-					{
-						minPixelValue	=	currPixValue;
-					}
-				}
-				break;
-
-
-			case kImageType_RGB24:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				cc					=	0;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					redValue	=	imageDataPtr8bit[cc + 0] & 0x00ff;
-					grnValue	=	imageDataPtr8bit[cc + 1] & 0x00ff;
-					bluValue	=	imageDataPtr8bit[cc + 2] & 0x00ff;
-					if (redValue < minPixelValue)
-					{
-						minPixelValue	=	redValue;
-					}
-					if (grnValue < minPixelValue)
-					{
-						minPixelValue	=	grnValue;
-					}
-					if (bluValue < minPixelValue)
-					{
-						minPixelValue	=	bluValue;
-					}
-					cc	+=	3;
-				}
-				break;
-
-			default:
-				minPixelValue	=	0;
-				break;
-
+			saturatedPixCnt++;
 		}
-
+		pixPtr	+=	3;
 	}
-	CONSOLE_DEBUG_W_NUM("minPixelValue\t=",	minPixelValue);
-	return(minPixelValue);
+	slice->saturatedPixCnt	=	saturatedPixCnt;
 }
 
 //**************************************************************************
-//*	Calculate the maximum pixel value for the current data buffer
+//*	the histogram uses the high 8 bits, everything else uses the full value.
+//*	min and max are done 8 pixels at a time with SSE2 or NEON if we have it
 //**************************************************************************
-uint32_t	CameraDriver::CalculateMaxPixValue(void)
+static void	StatsSlice_Raw16(TYPE_StatsSlice *slice)
 {
-uint32_t		maxPixelValue;
-uint32_t		imageDataLen;
-uint32_t		currPixValue;
+const uint16_t	*pixPtr;
+uint32_t		(*histogram)[256];
 uint32_t		ii;
-uint32_t		cc;
-uint16_t		*imageDataPtr16bit;
-uint8_t			*imageDataPtr8bit;
-uint32_t		redValue;
-uint32_t		grnValue;
-uint32_t		bluValue;
-
-//	CONSOLE_DEBUG(__FUNCTION__);
+uint32_t		jj;
+uint32_t		pixValue;
+uint32_t		minPixelValue;
+uint32_t		maxPixelValue;
+uint32_t		saturatedPixCnt;
+uint64_t		pixelSum;
+uint64_t		pixelSumSqr;
+uint16_t		vectorValues[8];
 
+	pixPtr			=	(const uint16_t *)slice->pixelPtr;
+	histogram		=	slice->histogram[0];
+	minPixelValue	=	0x0ffff;
 	maxPixelValue	=	0;
-	imageDataLen	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
-
-	if (cCameraDataBuffer != NULL)
+	saturatedPixCnt	=	0;
+	pixelSum		=	0;
+	pixelSumSqr		=	0;
+	ii				=	0;
+
+#if defined(__SSE2__)
+	//*	SSE2 only has signed 16 bit min/max, flipping the top bit makes unsigned values compare correctly
+	__m128i	signBias	=	_mm_set1_epi16((short)0x8000);
+	__m128i	minVector	=	_mm_set1_epi16((short)0x7fff);
+	__m128i	maxVector	=	_mm_set1_epi16((short)0x8000);
+	__m128i	pixVector;
+
+	while ((ii + 8) <= slice->pixelCount)
 	{
-		GetImage_ROI_info();
+		pixVector	=	_mm_xor_si128(_mm_loadu_si128((const __m128i *)&pixPtr[ii]), signBias);
+		minVector	=	_mm_min_epi16(minVector, pixVector);
+		maxVector	=	_mm_max_epi16(maxVector, pixVector);
+		for (jj=0; jj<8; jj++)
+		{
+			pixValue		=	pixPtr[ii + jj];
+			histogram[jj & 0x03][pixValue >> 8]++;
+			pixelSum		+=	pixValue;
+			pixelSumSqr		+=	(uint64_t)pixValue * pixValue;
+			saturatedPixCnt	+=	(pixValue == 0x0ffff);
+		}
+		ii	+=	8;
+	}
+	_mm_storeu_si128((__m128i *)vectorValues, _mm_xor_si128(minVector, signBias));
+	for (jj=0; jj<8; jj++)
+	{
+		if (vectorValues[jj] < minPixelValue)
+		{
+			minPixelValue	=	vectorValues[jj];
+		}
+	}
+	_mm_storeu_si128((__m128i *)vectorValues, _mm_xor_si128(maxVector, signBias));
+	for (jj=0; jj<8; jj++)
+	{
+		if (vectorValues[jj] > maxPixelValue)
+		{
+			maxPixelValue	=	vectorValues[jj];
+		}
+	}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	uint16x8_t	minVector	=	vdupq_n_u16(0x0ffff);
+	uint16x8_t	maxVector	=	vdupq_n_u16(0);
+	uint16x8_t	pixVector;
 
-		switch(cROIinfo.currentROIimageType)
+	while ((ii + 8) <= slice->pixelCount)
+	{
+		pixVector	=	vld1q_u16(&pixPtr[ii]);
+		minVector	=	vminq_u16(minVector, pixVector);
+		maxVector	=	vmaxq_u16(maxVector, pixVector);
+		for (jj=0; jj<8; jj++)
 		{
-			case kImageType_RAW8:
-			case kImageType_MONO8:
-			case kImageType_Y8:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					currPixValue	=	imageDataPtr8bit[ii] & 0x00ff;
-					if (currPixValue > maxPixelValue)
-					{
-						maxPixelValue	=	currPixValue;
-					}
-				}
-				break;
+			pixValue		=	pixPtr[ii + jj];
+			histogram[jj & 0x03][pixValue >> 8]++;
+			pixelSum		+=	pixValue;
+			pixelSumSqr		+=	(uint64_t)pixValue * pixValue;
+			saturatedPixCnt	+=	(pixValue == 0x0ffff);
+		}
+		ii	+=	8;
+	}
+	vst1q_u16(vectorValues, minVector);
+	for (jj=0; jj<8; jj++)
+	{
+		if (vectorValues[jj] < minPixelValue)
+		{
+			minPixelValue	=	vectorValues[jj];
+		}
+	}
+	vst1q_u16(vectorValues, maxVector);
+	for (jj=0; jj<8; jj++)
+	{
+		if (vectorValues[jj] > maxPixelValue)
+		{
+			maxPixelValue	=	vectorValues[jj];
+		}
+	}
+#else
+	(void)vectorValues;
+#endif
 
-			case kImageType_RAW16:
-				imageDataPtr16bit	=	(uint16_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					currPixValue	=	imageDataPtr16bit[ii] & 0x00ffff;
-					if (currPixValue > maxPixelValue)
-					{
-						maxPixelValue	=	currPixValue;
-					}
-				}
-				break;
+	//*	whatever is left over (or all of it if there is no SIMD)
+	while (ii < slice->pixelCount)
+	{
+		pixValue		=	pixPtr[ii];
+		histogram[ii & 0x03][pixValue >> 8]++;
+		pixelSum		+=	pixValue;
+		pixelSumSqr		+=	(uint64_t)pixValue * pixValue;
+		saturatedPixCnt	+=	(pixValue == 0x0ffff);
+		if (pixValue < minPixelValue)
+		{
+			minPixelValue	=	pixValue;
+		}
+		if (pixValue > maxPixelValue)
+		{
+			maxPixelValue	=	pixValue;
+		}
+		ii++;
+	}
+	slice->minPixelValue	=	minPixelValue;
+	slice->maxPixelValue	=	maxPixelValue;
+	slice->saturatedPixCnt	=	saturatedPixCnt;
+	slice->pixelSum			=	pixelSum;
+	slice->pixelSumSqr		=	pixelSumSqr;
+}
 
+//**************************************************************************
+static void	*StatsSlice_Thread(void *arg)
+{
+TYPE_StatsSlice	*slice;
 
-			case kImageType_RGB24:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				cc					=	0;
-				for (ii=0; ii<imageDataLen; ii++)
-				{
-					redValue	=	imageDataPtr8bit[cc + 0] & 0x00ff;
-					grnValue	=	imageDataPtr8bit[cc + 1] & 0x00ff;
-					bluValue	=	imageDataPtr8bit[cc + 2] & 0x00ff;
-					if (redValue > maxPixelValue)
-					{
-						maxPixelValue	=	redValue;
-					}
-					if (grnValue > maxPixelValue)
-					{
-						maxPixelValue	=	grnValue;
-					}
-					if (bluValue > maxPixelValue)
-					{
-						maxPixelValue	=	bluValue;
-					}
-					cc	+=	3;
-				}
-				break;
+	slice	=	(TYPE_StatsSlice *)arg;
+	switch(slice->imageType)
+	{
+		case kImageType_RAW8:
+		case kImageType_MONO8:
+		case kImageType_Y8:
+			StatsSlice_Mono8(slice);
+			break;
 
-			default:
-				maxPixelValue	=	0;
-				break;
+		case kImageType_RAW16:
+			StatsSlice_Raw16(slice);
+			break;
 
-		}
+		case kImageType_RGB24:
+			StatsSlice_RGB24(slice);
+			break;
 
+		default:
+			break;
 	}
-//	CONSOLE_DEBUG_W_INT32("maxPixelValue\t=", maxPixelValue);
-	return(maxPixelValue);
+	return(NULL);
 }
 
+//**************************************************************************
+//*	adds the sub tables of every slice into one histogram
+//**************************************************************************
+static void	StatsSlice_MergeHistogram(	TYPE_StatsSlice	*slices,
+										const int		sliceCnt,
+										const int		colorIdx,
+										int32_t			*histogram)
+{
+int			sss;
+int			ttt;
+int			iii;
+
+	memset(histogram, 0, 256 * sizeof(int32_t));
+	for (sss=0; sss<sliceCnt; sss++)
+	{
+		for (ttt=0; ttt<kHistSubTables; ttt++)
+		{
+			for (iii=0; iii<256; iii++)
+			{
+				histogram[iii]	+=	slices[sss].histogram[colorIdx][ttt][iii];
+			}
+		}
+	}
+}
 
 //**************************************************************************
-//*	Count the number of pixels at saturation
-//*		for raw8, a saturated pixel is one that has a value of 255
-//*		for raw16, a saturated pixel is one that has a value of 65535
-//*		for RGB24, if any of the 3 RGB values is 255, then that pixel is at saturation
+//*	min, max, sum and sum of the squares from a histogram of 8 bit values
 //**************************************************************************
-uint32_t	CameraDriver::CountSaturationPixels(void)
+static void	AddHistogramToStats(const int32_t	*histogram,
+								uint32_t		*minPixelValue,
+								uint32_t		*maxPixelValue,
+								uint64_t		*pixelSum,
+								uint64_t		*pixelSumSqr)
 {
-uint32_t		imageDataLen;
-uint32_t		currPixValue;
-uint32_t		saturatedPixCnt;
-uint32_t		ii;
-uint32_t		cc;
-uint32_t		redValue;
-uint32_t		grnValue;
-uint32_t		bluValue;
-uint16_t		*imageDataPtr16bit;
-uint8_t			*imageDataPtr8bit;
+uint32_t	iii;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
+	for (iii=0; iii<256; iii++)
+	{
+		if (histogram[iii] > 0)
+		{
+			if (iii < *minPixelValue)
+			{
+				*minPixelValue	=	iii;
+			}
+			if (iii > *maxPixelValue)
+			{
+				*maxPixelValue	=	iii;
+			}
+			*pixelSum		+=	(uint64_t)histogram[iii] * iii;
+			*pixelSumSqr	+=	(uint64_t)histogram[iii] * iii * iii;
+		}
+	}
+}
 
-	imageDataLen	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
-	saturatedPixCnt	=	0;
+//**************************************************************************
+static uint8_t	HighestHistogramValue(const int32_t *histogram)
+{
+int		iii;
+uint8_t	highestValue;
 
-	if (cCameraDataBuffer != NULL)
+	highestValue	=	0;
+	for (iii=255; iii>0; iii--)
 	{
-		GetImage_ROI_info();
+		if (histogram[iii] > 0)
+		{
+			highestValue	=	iii;
+			break;
+		}
+	}
+	return(highestValue);
+}
+
+//**************************************************************************
+//*	Calculates everything about the current data buffer in one pass, split across
+//*	the available cores. The results are kept until the next frame is read so
+//*	the auto exposure, the FITS header and the live window can all use them.
+//**************************************************************************
+void	CameraDriver::CalculateImageStats(void)
+{
+TYPE_StatsSlice	*slices;
+pthread_t		threadIDs[kImageStatsMaxThreads];
+bool			threadRunning[kImageStatsMaxThreads];
+int				sliceCnt;
+int				sss;
+int				iii;
+int				bytesPerPixel;
+int				rowsPerSlice;
+int				startRow;
+int				rowCnt;
+long			cpuCnt;
+uint32_t		pixelCount;
+uint32_t		sampleCount;
+uint64_t		pixelSum;
+uint64_t		pixelSumSqr;
+double			variance;
+uint32_t		startMillis;
+
+	GetImage_ROI_info();
+	if ((cImageStats.valid == false) ||
+		(cImageStats.frameNumber != cFramesRead) ||
+		(cImageStats.imageType != cROIinfo.currentROIimageType))
+	{
+		startMillis	=	millis();
+
+		memset((void *)&cImageStats, 0, sizeof(TYPE_ImageStats));
+		cImageStats.frameNumber		=	cFramesRead;
+		cImageStats.imageType		=	cROIinfo.currentROIimageType;
+		cImageStats.minPixelValue	=	0x0ffff;
+		cImageStats.maxPixelValue	=	0;
 
 		switch(cROIinfo.currentROIimageType)
 		{
+			case kImageType_RAW16:	bytesPerPixel	=	2;	break;
+			case kImageType_RGB24:	bytesPerPixel	=	3;	break;
 			case kImageType_RAW8:
 			case kImageType_MONO8:
-			case kImageType_Y8:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
+			case kImageType_Y8:		bytesPerPixel	=	1;	break;
+			default:				bytesPerPixel	=	0;	break;
+		}
+		pixelCount	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
+		if ((bytesPerPixel > 0) && ((long)(pixelCount * bytesPerPixel) > cCameraDataBuffLen))
+		{
+			CONSOLE_DEBUG("Image is bigger than the data buffer");
+			pixelCount	=	0;
+		}
+
+		slices	=	NULL;
+		if ((cCameraDataBuffer != NULL) && (bytesPerPixel > 0) && (pixelCount > 0))
+		{
+			//*	figure out how many threads to use
+			sliceCnt	=	1;
+			cpuCnt		=	sysconf(_SC_NPROCESSORS_ONLN);
+			while (((sliceCnt * 2) <= kImageStatsMaxThreads) &&
+					((sliceCnt * 2) <= cpuCnt) &&
+					((pixelCount / (sliceCnt * 2)) >= kImageStatsMinPixPerThread))
+			{
+				sliceCnt	*=	2;
+			}
+			slices	=	(TYPE_StatsSlice *)calloc(sliceCnt, sizeof(TYPE_StatsSlice));
+		}
+
+		if (slices != NULL)
+		{
+			//*	split it up by rows
+			rowsPerSlice	=	(cCameraProp.CameraYsize + sliceCnt - 1) / sliceCnt;
+			startRow		=	0;
+			for (sss=0; sss<sliceCnt; sss++)
+			{
+				rowCnt	=	rowsPerSlice;
+				if ((startRow + rowCnt) > cCameraProp.CameraYsize)
 				{
-					currPixValue	=	imageDataPtr8bit[ii] & 0x00ff;
-					if (currPixValue == 0x0ff)
-					{
-						saturatedPixCnt++;
-					}
+					rowCnt	=	cCameraProp.CameraYsize - startRow;
 				}
-				break;
+				slices[sss].imageType	=	cROIinfo.currentROIimageType;
+				slices[sss].pixelPtr	=	cCameraDataBuffer + ((long)startRow * cCameraProp.CameraXsize * bytesPerPixel);
+				slices[sss].pixelCount	=	rowCnt * cCameraProp.CameraXsize;
+				startRow				+=	rowCnt;
+			}
 
-			case kImageType_RAW16:
-				imageDataPtr16bit	=	(uint16_t *)cCameraDataBuffer;
-				for (ii=0; ii<imageDataLen; ii++)
+			//*	the first slice is done on this thread
+			for (sss=1; sss<sliceCnt; sss++)
+			{
+				threadRunning[sss]	=	(pthread_create(&threadIDs[sss], NULL, &StatsSlice_Thread, &slices[sss]) == 0);
+				if (threadRunning[sss] == false)
 				{
-					currPixValue	=	imageDataPtr16bit[ii] & 0x00ffff;
-					if (currPixValue == 0x0ffff)
-					{
-						saturatedPixCnt++;
-					}
+					StatsSlice_Thread(&slices[sss]);
 				}
-				break;
-
-
-			case kImageType_RGB24:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				cc					=	0;
-				for (ii=0; ii<imageDataLen; ii++)
+			}
+			StatsSlice_Thread(&slices[0]);
+			for (sss=1; sss<sliceCnt; sss++)
+			{
+				if (threadRunning[sss])
 				{
-					redValue	=	imageDataPtr8bit[cc + 0] & 0x00ff;
-					grnValue	=	imageDataPtr8bit[cc + 1] & 0x00ff;
-					bluValue	=	imageDataPtr8bit[cc + 2] & 0x00ff;
-					if ((redValue == 0x0ff) || (grnValue == 0x0ff) || (bluValue == 0x0ff))
+					pthread_join(threadIDs[sss], NULL);
+				}
+			}
+
+			//*	put the pieces together
+			pixelSum	=	0;
+			pixelSumSqr	=	0;
+			sampleCount	=	pixelCount;
+			for (sss=0; sss<sliceCnt; sss++)
+			{
+				cImageStats.saturatedPixCnt	+=	slices[sss].saturatedPixCnt;
+			}
+			switch(cROIinfo.currentROIimageType)
+			{
+				case kImageType_RAW8:
+				case kImageType_MONO8:
+				case kImageType_Y8:
+					StatsSlice_MergeHistogram(slices, sliceCnt, 0, cImageStats.histogramLum);
+					AddHistogramToStats(cImageStats.histogramLum,
+										&cImageStats.minPixelValue,
+										&cImageStats.maxPixelValue,
+										&pixelSum,
+										&pixelSumSqr);
+					cImageStats.saturatedPixCnt	=	cImageStats.histogramLum[255];
+					cImageStats.maxGryValue		=	cImageStats.maxPixelValue;
+					break;
+
+				case kImageType_RAW16:
+					StatsSlice_MergeHistogram(slices, sliceCnt, 0, cImageStats.histogramLum);
+					for (sss=0; sss<sliceCnt; sss++)
 					{
-						saturatedPixCnt++;
+						if (slices[sss].minPixelValue < cImageStats.minPixelValue)
+						{
+							cImageStats.minPixelValue	=	slices[sss].minPixelValue;
+						}
+						if (slices[sss].maxPixelValue > cImageStats.maxPixelValue)
+						{
+							cImageStats.maxPixelValue	=	slices[sss].maxPixelValue;
+						}
+						pixelSum	+=	slices[sss].pixelSum;
+						pixelSumSqr	+=	slices[sss].pixelSumSqr;
 					}
-					cc	+=	3;
-				}
-				break;
+					break;
+
+				case kImageType_RGB24:
+					StatsSlice_MergeHistogram(slices, sliceCnt, 0, cImageStats.histogramRed);
+					StatsSlice_MergeHistogram(slices, sliceCnt, 1, cImageStats.histogramGrn);
+					StatsSlice_MergeHistogram(slices, sliceCnt, 2, cImageStats.histogramBlu);
+					AddHistogramToStats(cImageStats.histogramRed, &cImageStats.minPixelValue, &cImageStats.maxPixelValue, &pixelSum, &pixelSumSqr);
+					AddHistogramToStats(cImageStats.histogramGrn, &cImageStats.minPixelValue, &cImageStats.maxPixelValue, &pixelSum, &pixelSumSqr);
+					AddHistogramToStats(cImageStats.histogramBlu, &cImageStats.minPixelValue, &cImageStats.maxPixelValue, &pixelSum, &pixelSumSqr);
+					cImageStats.maxRedValue	=	HighestHistogramValue(cImageStats.histogramRed);
+					cImageStats.maxGrnValue	=	HighestHistogramValue(cImageStats.histogramGrn);
+					cImageStats.maxBluValue	=	HighestHistogramValue(cImageStats.histogramBlu);
+					//*	the luminance is the average of the 3 colors
+					for (iii=0; iii<256; iii++)
+					{
+						cImageStats.histogramLum[iii]	=	(cImageStats.histogramRed[iii] +
+															cImageStats.histogramGrn[iii] +
+															cImageStats.histogramBlu[iii]) / 3;
+					}
+					sampleCount	=	pixelCount * 3;
+					break;
 
-			default:
-				saturatedPixCnt	=	0;
-				break;
+				default:
+					break;
+			}
+			free(slices);
 
+			cImageStats.pixelCount		=	pixelCount;
+			cImageStats.saturationPrcnt	=	(cImageStats.saturatedPixCnt * 100.0) / pixelCount;
+			cImageStats.meanValue		=	(1.0 * pixelSum) / sampleCount;
+			variance					=	((1.0 * pixelSumSqr) / sampleCount) - (cImageStats.meanValue * cImageStats.meanValue);
+			if (variance > 0.0)
+			{
+				cImageStats.stdDevValue	=	sqrt(variance);
+			}
+			cImageStats.threadCnt		=	sliceCnt;
 		}
+		cImageStats.calcMillis	=	millis() - startMillis;
+		cImageStats.valid		=	true;
+		CONSOLE_DEBUG_W_NUM("calcMillis\t=",	cImageStats.calcMillis);
 	}
+}
 
-	return(saturatedPixCnt);
+//**************************************************************************
+//*	Calculate the minimum pixel value for the current data buffer
+//**************************************************************************
+uint32_t	CameraDriver::CalculateMinPixValue(void)
+{
+	CalculateImageStats();
+	CONSOLE_DEBUG_W_NUM("minPixelValue\t=",	cImageStats.minPixelValue);
+	return(cImageStats.minPixelValue);
+}
+
+//**************************************************************************
+//*	Calculate the maximum pixel value for the current data buffer
+//**************************************************************************
+uint32_t	CameraDriver::CalculateMaxPixValue(void)
+{
+	CalculateImageStats();
+//	CONSOLE_DEBUG_W_INT32("maxPixelValue\t=", cImageStats.maxPixelValue);
+	return(cImageStats.maxPixelValue);
+}
+
+
+//**************************************************************************
+//*	Count the number of pixels at saturation
+//*		for raw8, a saturated pixel is one that has a value of 255
+//*		for raw16, a saturated pixel is one that has a value of 65535
+//*		for RGB24, if any of the 3 RGB values is 255, then that pixel is at saturation
+//**************************************************************************
+uint32_t	CameraDriver::CountSaturationPixels(void)
+{
+	CalculateImageStats();
+	return(cImageStats.saturatedPixCnt);
 }
 
 
@@ -338,20 +622,13 @@ uint8_t			*imageDataPtr8bit;
 //**************************************************************************
 double	CameraDriver::CalculateSaturation(void)
 {
-double			saturatedPrct;
-uint32_t		saturatedPixCnt;
-uint32_t		imageDataLen;
-
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	saturatedPixCnt	=	CountSaturationPixels();
-	imageDataLen	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
-	saturatedPrct	=	(saturatedPixCnt * 100.0) / imageDataLen;
-
-//	CONSOLE_DEBUG_W_INT32("saturatedPixCnt\t=",	saturatedPixCnt);
-//	CONSOLE_DEBUG_W_DBL("saturatedPrct\t=",		saturatedPrct);
+	CalculateImageStats();
+//	CONSOLE_DEBUG_W_INT32("saturatedPixCnt\t=",	cImageStats.saturatedPixCnt);
+//	CONSOLE_DEBUG_W_DBL("saturatedPrct\t=",		cImageStats.saturationPrcnt);
 
-	return(saturatedPrct);
+	return(cImageStats.saturationPrcnt);
 }
 
 
@@ -548,16 +825,7 @@ long			exposureAdjustment_us;	//*	micro-seconds
 //*****************************************************************************
 void	CameraDriver::CalculateHistogramArray(void)
 {
-int32_t			imageDataLen;
-int32_t			currPixValue;
 int32_t			iii;
-int32_t			ccc;
-uint16_t		*imageDataPtr16bit;
-uint8_t			*imageDataPtr8bit;
-int32_t			redValue;
-int32_t			grnValue;
-int32_t			bluValue;
-int32_t			lumValue;		//*	luminance value
 int32_t			peakPixelIdx;
 int32_t			peakPixelCount;
 bool			lookingForMin;
@@ -567,102 +835,22 @@ bool			lookingForMin;
 	CONSOLE_DEBUG(__FUNCTION__);
 	START_TIMING();
 
-	imageDataLen	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
-
-	if (cCameraDataBuffer != NULL)
+	CalculateImageStats();
+	if (cImageStats.pixelCount > 0)
 	{
 		cPeakHistogramValue	=	0;
 		cMaxHistogramValue	=	0;
 		cMaxHistogramPixCnt	=	0;
-		cMaxRedValue		=	0;
-		cMaxGrnValue		=	0;
-		cMaxBluValue		=	0;
-		cMaxGryValue		=	0;
-
-		//*	clear out the histogram data array
-		memset(cHistogramLum,	0,	sizeof(cHistogramLum));
-		memset(cHistogramRed,	0,	sizeof(cHistogramRed));
-		memset(cHistogramGrn,	0,	sizeof(cHistogramGrn));
-		memset(cHistogramBlu,	0,	sizeof(cHistogramBlu));
-
-		//*	figure out what type of image it is
-		GetImage_ROI_info();
-		switch(cROIinfo.currentROIimageType)
-		{
-			case kImageType_RAW8:
-			case kImageType_MONO8:
-			case kImageType_Y8:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				for (iii=0; iii<imageDataLen; iii++)
-				{
-					currPixValue	=	imageDataPtr8bit[iii] & 0x00ff;
-
-					cHistogramLum[currPixValue]++;
-
-					if (currPixValue > cMaxGryValue)
-					{
-						cMaxGryValue	=	currPixValue;
-					}
-				}
-				break;
-
-			case kImageType_RAW16:
-				imageDataPtr16bit	=	(uint16_t *)cCameraDataBuffer;
-				for (iii=0; iii<imageDataLen; iii++)
-				{
-					//*	for 16 bit data, we shift it right 8 bits
-					currPixValue	=	imageDataPtr16bit[iii] & 0x00ffff;
-					currPixValue	=	(currPixValue >> 8) & 0x00ff;
-					cHistogramLum[currPixValue]++;
-				}
-				break;
+		cMaxRedValue		=	cImageStats.maxRedValue;
+		cMaxGrnValue		=	cImageStats.maxGrnValue;
+		cMaxBluValue		=	cImageStats.maxBluValue;
+		cMaxGryValue		=	cImageStats.maxGryValue;
 
+		memcpy(cHistogramLum,	cImageStats.histogramLum,	sizeof(cHistogramLum));
+		memcpy(cHistogramRed,	cImageStats.histogramRed,	sizeof(cHistogramRed));
+		memcpy(cHistogramGrn,	cImageStats.histogramGrn,	sizeof(cHistogramGrn));
+		memcpy(cHistogramBlu,	cImageStats.histogramBlu,	sizeof(cHistogramBlu));
 
-			case kImageType_RGB24:
-				imageDataPtr8bit	=	(uint8_t *)cCameraDataBuffer;
-				ccc					=	0;
-				for (iii=0; iii<imageDataLen; iii++)
-				{
-					//*	openCV uses BGR instead of RGB
-					//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
-					bluValue	=	imageDataPtr8bit[ccc + 0] & 0x00ff;
-					grnValue	=	imageDataPtr8bit[ccc + 1] & 0x00ff;
-					redValue	=	imageDataPtr8bit[ccc + 2] & 0x00ff;
-					cHistogramRed[redValue]++;
-					cHistogramGrn[grnValue]++;
-					cHistogramBlu[bluValue]++;
-
-					if (redValue > cMaxRedValue)
-					{
-						cMaxRedValue	=	redValue;
-					}
-					if (grnValue > cMaxGrnValue)
-					{
-						cMaxGrnValue	=	grnValue;
-					}
-					if (bluValue > cMaxBluValue)
-					{
-						cMaxBluValue	=	bluValue;
-					}
-					ccc	+=	3;
-				}
-				//*	now calculate the luminance
-				for (iii=0; iii<256; iii++)
-				{
-					lumValue	=	cHistogramRed[iii];
-					lumValue	+=	cHistogramGrn[iii];
-					lumValue	+=	cHistogramBlu[iii];
-					lumValue	=	(lumValue / 3);
-
-					cHistogramLum[iii]	=	lumValue;
-				}
-
-				break;
-
-			default:
-				break;
-
-		}
 		//*	now go through the array and find the peak value and max value
 		peakPixelIdx		=	-1;
 		peakPixelCount		=	0;
@@ -719,7 +907,7 @@ bool			lookingForMin;
 	}
 	else
 	{
-		CONSOLE_DEBUG("cCameraDataBuffer is NULL");
+		CONSOLE_DEBUG("No image data");
 	}
 }
 
@@ -1398,6 +1398,7 @@ ASI_ERROR_CODE		asiErrorCode;
 int					numberOfCtrls;
 ASI_CONTROL_CAPS	controlCaps;
 char				lineBuffer[256];
+char				jpegImageName[256];
 char				asiImageTypeString[16];
 int					currentROIwidth;
 int					currentROIheight;
@@ -1589,10 +1590,11 @@ int					mySocketFD;
 
 		//*-----------------------------------------------------------
 		//*	display the most recent jpeg image
-		if (strlen(cLastJpegImageName) > 0)
+		GetLastJpegImageName(jpegImageName, sizeof(jpegImageName));
+		if (strlen(jpegImageName) > 0)
 		{
 			SocketWriteData(mySocketFD,	"<TR><TD COLSPAN=8><CENTER>\r\n");
-			sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	cLastJpegImageName);
+			sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	jpegImageName);
 			SocketWriteData(mySocketFD,	lineBuffer);
 		//	SocketWriteData(mySocketFD,	"<img src=../image.jpg width=75\%>\r\n");
 			SocketWriteData(mySocketFD,	"</TD></TR>\r\n");
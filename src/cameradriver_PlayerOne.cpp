@@ -1350,6 +1350,7 @@ int					currentROIwidth;
 int					currentROIheight;
 int					currentROIbin;
 int					mySocketFD;
+char				jpegImageName[256];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
@@ -1450,10 +1451,11 @@ int					mySocketFD;
 	}
 	//*-----------------------------------------------------------
 	//*	display the most recent jpeg image
-	if (strlen(cLastJpegImageName) > 0)
+	GetLastJpegImageName(jpegImageName, sizeof(jpegImageName));
+	if (strlen(jpegImageName) > 0)
 	{
 		SocketWriteData(mySocketFD,	"<TR><TD COLSPAN=8><CENTER>\r\n");
-		sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	cLastJpegImageName);
+		sprintf(lineBuffer,	"\t<img src=../%s width=75%%>\r\n",	jpegImageName);
 		SocketWriteData(mySocketFD,	lineBuffer);
 	//	SocketWriteData(mySocketFD,	"<img src=../image.jpg width=75\%>\r\n");
 		SocketWriteData(mySocketFD,	"</TD></TR>\r\n");
@@ -27,6 +27,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr  7,	2022	<MLS> Created cameradriver_QSI.cpp
 //*	Apr  8,	2022	<MLS> Got QSI library to compile and install
@@ -44,6 +45,7 @@
 //*	Jun 28,	2024	<MLS> cCommonProp.Connected set to false if QSI_NOTCONNECTED error occurs
 //*	Jul  4,	2024	<MLS> Implemented Read_SensorTargetTemp() && Write_SensorTargetTemp()
 //*	Jan  5,	2025	<MLS> New version of QSI SDK available v2024.09.05.77
+//*	Oct 18,	2026	<AGT> Invalidate cached description after reading it from the camera
 //*****************************************************************************
 //	https://qsimaging.com/drivers-software/
 //	https://downloads.atik-cameras.com/QSI_SDK_Linux-2024.09.05.77.tar.gz
@@ -454,6 +456,7 @@ std::string		lastError("");
 	if (qsi_Result == QSI_OK)
 	{
 		strcpy(cCommonProp.Description,		desc.c_str());
+		ResponseCache_Invalidate("description");
 		CONSOLE_DEBUG_W_STR("QSI-Description\t\t\t=",	cCommonProp.Description);
 	}
 	else if (qsi_Result == QSI_NOTCONNECTED)
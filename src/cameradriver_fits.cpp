@@ -32,6 +32,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Nov  2,	2019	<MLS> Added SaveImageAsFITS()
 //*	Nov  3,	2019	<MLS> Added support for FITS file output
@@ -106,6 +107,9 @@
 //*	Apr 22,	2024	<MLS> Added support for kImageType_MONO8 (8 bit image type)
 //*	Nov 18,	2024	<MLS> Added local path option for saving file in case specified path fails
 //*	Dec  2,	2024	<MLS> Added COPYRGHT to FITS header
+//*	Oct 18,	2026	<AGT> Added SaveImageAsFITS_Frame(), FITS data now comes from a TYPE_SaveFrame
+//*	Oct 18,	2026	<AGT> CCD temperature is now read when the frame is captured
+//*	Oct 18,	2026	<AGT> Added DATAMEAN and DATASDEV to the FITS header
 //*****************************************************************************
 //*	https://heasarc.gsfc.nasa.gov/docs/software/fitsio/c/c_user/cfitsio.html
 //*****************************************************************************
@@ -118,6 +122,7 @@
 #include	<stdio.h>
 #include	<stdlib.h>
 #include	<string.h>
+#include	<pthread.h>
 
 #if defined(__arm__)
 	#include <wiringPi.h>
@@ -165,6 +170,9 @@
 	#endif // _ENABLE_FILTERWHEEL_
 #endif // defined
 
+//*	FITS files can be written from the camera thread and the save queue threads
+static	pthread_mutex_t	gFitsMutex	=	PTHREAD_MUTEX_INITIALIZER;
+
 
 //*****************************************************************************
 static void	FormatLatLonString(double latLonValue, char *latLonString)
@@ -404,6 +412,26 @@ void	CameraDriver::UpdateRotatorLink(void)
 //*****************************************************************************
 int	CameraDriver::SaveImageAsFITS(bool headerOnly)
 {
+TYPE_SaveFrame	saveFrame;
+int				returnCode;
+
+	//*	save what is in the camera buffer now, the data is not copied
+	SaveFrame_Capture(&saveFrame, false);
+	SaveFrame_CaptureFitsInfo(&saveFrame);
+	returnCode	=	SaveImageAsFITS_Frame(&saveFrame, headerOnly);
+
+	//*	hang on to the BGR buffer for next time
+	cCameraBGRbuffer	=	saveFrame.bgrBuffer;
+	cCameraBGRbuffSize	=	saveFrame.bgrBufferSize;
+	return(returnCode);
+}
+
+//*****************************************************************************
+//*	this can be called from a save worker thread,
+//*	everything about the image has to come from saveFrame
+//*****************************************************************************
+int	CameraDriver::SaveImageAsFITS_Frame(TYPE_SaveFrame *saveFrame, bool headerOnly)
+{
 fitsfile		*fitsFilePtr;
 int				fitsRetCode;
 int				fitsStatus;
@@ -424,11 +452,11 @@ uint32_t		deltaMillisecs;
 int				iii;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
+	//*	cfitsio is not always built thread safe, and cFitsHeader is shared
+	pthread_mutex_lock(&gFitsMutex);
 	startMillisecs	=	millis();
 
-	GenerateFileNameRoot();
-	strcpy(imageFileName, cFileNameRoot);
-	strcpy(imageFileName, cFileNameRoot);
+	strcpy(imageFileName, saveFrame->fileNameRoot);
 	strcat(imageFileName, ".fits");
 
 	strcpy(imageFilePath, gImageDataDir);
@@ -443,8 +471,8 @@ int				iii;
 
 
 
-	naxes[0]		=	cCameraProp.CameraXsize;
-	naxes[1]		=	cCameraProp.CameraYsize;
+	naxes[0]		=	saveFrame->cameraProp.CameraXsize;
+	naxes[1]		=	saveFrame->cameraProp.CameraYsize;
 	naxes[2]		=	3;				//*	only used for color RGB images (3 planes)
 	axisCnt			=	2;				//*	for all formats except RGB
 	fits_bitpix		=	SHORT_IMG;
@@ -454,7 +482,7 @@ int				iii;
 	//*	for information about the BZERO data element, refer to
 	//*		https://docs.astropy.org/en/stable/io/fits/usage/image.html
 
-	switch(cROIinfo.currentROIimageType)
+	switch(saveFrame->imageType)
 	{
 		case kImageType_RAW8:
 		case kImageType_MONO8:
@@ -546,7 +574,7 @@ int				iii;
 
 		//============================================================
 		//*	output info about the observation
-		WriteFITS_ObservationInfo(fitsFilePtr, (headerOnly == false));
+		WriteFITS_ObservationInfo(fitsFilePtr, saveFrame, (headerOnly == false));
 
 		//*	leave FILENAME here so we dont have to pass the filename to the routine
 		fitsStatus	=	0;
@@ -554,7 +582,7 @@ int				iii;
 												imageFileName,
 												"Orig filename", &fitsStatus);
 		//*	were any other data products created
-		if (cOtherDataCnt > 0)
+		if (saveFrame->otherDataCnt > 0)
 		{
 		char	tagString[64];
 
@@ -563,12 +591,12 @@ int				iii;
 													(char *)"Other data products created",
 													NULL, &fitsStatus);
 
-			for (iii=0; iii<cOtherDataCnt; iii++)
+			for (iii=0; iii<saveFrame->otherDataCnt; iii++)
 			{
 				sprintf(tagString, "FILENAM%d", (iii + 1));
 				fits_write_key(fitsFilePtr, TSTRING,	tagString,
-														cOtherDataProducts[iii].filename,
-														cOtherDataProducts[iii].comment,
+														saveFrame->otherDataProducts[iii].filename,
+														saveFrame->otherDataProducts[iii].comment,
 														&fitsStatus);
 			}
 		}
@@ -582,8 +610,7 @@ int				iii;
 
 		if (headerOnly)
 		{
-			strcpy(aviFileName, cFileNameRoot);
-			strcpy(aviFileName, cFileNameRoot);
+			strcpy(aviFileName, saveFrame->fileNameRoot);
 			strcat(aviFileName, ".avi");
 
 			fitsStatus	=	0;
@@ -594,18 +621,18 @@ int				iii;
 
 		//============================================================
 		//*	Camera info
-		WriteFITS_CameraInfo(fitsFilePtr);
+		WriteFITS_CameraInfo(fitsFilePtr, saveFrame);
 
 		//============================================================
 		//*	Telescope info
-		WriteFITS_TelescopeInfo(fitsFilePtr);
+		WriteFITS_TelescopeInfo(fitsFilePtr, saveFrame);
 
 #ifdef _ENABLE_IMU_
 		//============================================================
 		//*	Telescope info
 		if (IMU_IsAvailable())
 		{
-			WriteFITS_IMUinfo(fitsFilePtr);
+			WriteFITS_IMUinfo(fitsFilePtr, saveFrame);
 		}
 #endif
 
@@ -631,7 +658,7 @@ int				iii;
 
 		//============================================================
 		//*	Moon information
-		WriteFITS_MoonInfo(fitsFilePtr);
+		WriteFITS_MoonInfo(fitsFilePtr, saveFrame);
 
 		//============================================================
 		//*	GPS information
@@ -650,13 +677,13 @@ int				iii;
 		WriteFITS_Seperator(fitsFilePtr, "");
 		//------------------------------------------------------------------------
 		//*	now deal with the image data
-		if ((cCameraDataBuffer != NULL) && (headerOnly == false))
+		if ((saveFrame->pixelBuffer != NULL) && (headerOnly == false))
 		{
 		LONGLONG		nelements;
 		long			fpixelArray[4];
 
 //			CONSOLE_DEBUG("Writing image data to FITS file");
-			nelements	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
+			nelements	=	saveFrame->cameraProp.CameraXsize * saveFrame->cameraProp.CameraYsize;
 
 
 			fpixelArray[0]	=	1;
@@ -664,7 +691,7 @@ int				iii;
 			fpixelArray[2]	=	1;		//*	RGB images only
 			fitsStatus		=	0;
 //			CONSOLE_DEBUG_W_INT32("nelements\t=", (long)nelements);
-			switch(cROIinfo.currentROIimageType)
+			switch(saveFrame->imageType)
 			{
 				case kImageType_RAW8:
 				case kImageType_RAW16:
@@ -673,23 +700,23 @@ int				iii;
 														fitsDataType,
 														fpixelArray,
 														nelements,
-														cCameraDataBuffer,
+														saveFrame->pixelBuffer,
 														&fitsStatus);
 					break;
 
 
 				//	Fits doesn't support RGB, it has to be 3 arrays, B, G, R
 				case kImageType_RGB24:
-					CreateFitsBGRimage();
+					CreateFitsBGRimage(saveFrame);
 //					CONSOLE_DEBUG(__FUNCTION__);
-					if (cCameraBGRbuffer != NULL)
+					if (saveFrame->bgrBuffer != NULL)
 					{
-						nelements		=	3 * cCameraProp.CameraXsize * cCameraProp.CameraYsize;
+						nelements		=	3 * saveFrame->cameraProp.CameraXsize * saveFrame->cameraProp.CameraYsize;
 						fitsRetCode		=	fits_write_pix(	fitsFilePtr,
 												fitsDataType,
 												fpixelArray,
 												nelements,
-												cCameraBGRbuffer,
+												saveFrame->bgrBuffer,
 												&fitsStatus);
 					}
 					break;
@@ -790,6 +817,7 @@ int				iii;
 	deltaMillisecs	=	stopMillisecs - startMillisecs;
 	CONSOLE_DEBUG_W_NUM("Time to save FITS file (milliseconds)\t=",	deltaMillisecs);
 
+	pthread_mutex_unlock(&gFitsMutex);
 	return(0);
 
 }
@@ -899,13 +927,12 @@ char	lineBuff[128];
 #pragma mark -
 
 //*****************************************************************************
-void	CameraDriver::WriteFITS_CameraInfo(fitsfile *fitsFilePtr)
+void	CameraDriver::WriteFITS_CameraInfo(fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame)
 {
 int		fitsStatus;
 char	stringBuf[128];
 double	megaPixels;
 int		intValue;
-int		ccdTempErrCode;
 char	instrumentString[128];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
@@ -964,34 +991,34 @@ char	instrumentString[128];
 	}
 	//-------------------------------------------------------------------------------
 	//*	Camera FPGA version (QHY, TOUPTEK)
-	if (strlen(cCameraProp.FPGAversion) > 0)
+	if (strlen(saveFrame->cameraProp.FPGAversion) > 0)
 	{
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr,	TSTRING,
 									"CAMFPGA",
-									cCameraProp.FPGAversion,
+									saveFrame->cameraProp.FPGAversion,
 									"Camera FPGA version", &fitsStatus);
 	}
 	//-------------------------------------------------------------------------------
 	//*	Camera production date (TOUPTEK)
-	if (strlen(cCameraProp.ProductionDate) > 0)
+	if (strlen(saveFrame->cameraProp.ProductionDate) > 0)
 	{
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr,	TSTRING,
 									"CAMPROD",
-									cCameraProp.ProductionDate,
+									saveFrame->cameraProp.ProductionDate,
 									"Camera Production Date", &fitsStatus);
 	}
 
 	//-------------------------------------------------------------------------------
 	//*	output info about the sensor
-	if (strlen(cCameraProp.SensorName) > 0)
+	if (strlen(saveFrame->cameraProp.SensorName) > 0)
 	{
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TSTRING, "DETECTOR",	cCameraProp.SensorName,		NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TSTRING, "DETECTOR",	saveFrame->cameraProp.SensorName,		NULL, &fitsStatus);
 	}
 
-	sprintf(stringBuf, "[1:%d,1:%d]", cCameraProp.CameraXsize, cCameraProp.CameraYsize);
+	sprintf(stringBuf, "[1:%d,1:%d]", saveFrame->cameraProp.CameraXsize, saveFrame->cameraProp.CameraYsize);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING, "DETSIZE",	stringBuf,		"Detector size", &fitsStatus);
 
@@ -1002,79 +1029,79 @@ char	instrumentString[128];
 
 	//-------------------------------------------------------------------------------
 	fitsStatus	=	0;
-	fits_write_key(fitsFilePtr, TINT,		"IMAGEW",	&cCameraProp.CameraXsize,	NULL, &fitsStatus);
+	fits_write_key(fitsFilePtr, TINT,		"IMAGEW",	&saveFrame->cameraProp.CameraXsize,	NULL, &fitsStatus);
 
 	fitsStatus	=	0;
-	fits_write_key(fitsFilePtr, TINT,		"IMAGEH",	&cCameraProp.CameraYsize,	NULL, &fitsStatus);
+	fits_write_key(fitsFilePtr, TINT,		"IMAGEH",	&saveFrame->cameraProp.CameraYsize,	NULL, &fitsStatus);
 
 
 	//-------------------------------------------------------------------------------
 	//*	image mode from camera
-	GetImageTypeString(cROIinfo.currentROIimageType, stringBuf);
+	GetImageTypeString(saveFrame->imageType, stringBuf);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"IMGTYPE",
 											stringBuf,
 											"Image mode from camera", &fitsStatus);
 
 	//-------------------------------------------------------------------------------
-	ccdTempErrCode	=	Read_SensorTemp();
-	if (ccdTempErrCode == 0)
+	//*	the temperature was read when the frame was captured
+	if (saveFrame->ccdTempValid)
 	{
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TDOUBLE,	"CCD-TEMP",
-												&cCameraProp.CCDtemperature,
+												&saveFrame->cameraProp.CCDtemperature,
 												"Degrees C", &fitsStatus);
 	}
 
 	//-------------------------------------------------------------------------------
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TDOUBLE,	"XPIXSZ",
-											&cCameraProp.PixelSizeX,
+											&saveFrame->cameraProp.PixelSizeX,
 											"X Pixel size in microns", &fitsStatus);
 
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TDOUBLE,	"YPIXSZ",
-											&cCameraProp.PixelSizeY,
+											&saveFrame->cameraProp.PixelSizeY,
 											"Y Pixel size in microns", &fitsStatus);
 
 
 	fitsStatus	=	0;
-	fits_write_key(fitsFilePtr, TINT,		"XBINNING",	&cCameraProp.BinX,	NULL, &fitsStatus);
+	fits_write_key(fitsFilePtr, TINT,		"XBINNING",	&saveFrame->cameraProp.BinX,	NULL, &fitsStatus);
 
 	fitsStatus	=	0;
-	fits_write_key(fitsFilePtr, TINT,		"YBINNING",	&cCameraProp.BinY,	NULL, &fitsStatus);
+	fits_write_key(fitsFilePtr, TINT,		"YBINNING",	&saveFrame->cameraProp.BinY,	NULL, &fitsStatus);
 
 	//-------------------------------------------------------------------------------
 	//*	record the Electrons per ADU, if present
-	if (cCameraProp.ElectronsPerADU > 0.0)
+	if (saveFrame->cameraProp.ElectronsPerADU > 0.0)
 	{
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TDOUBLE,	"EGAIN",
-												&cCameraProp.ElectronsPerADU,
+												&saveFrame->cameraProp.ElectronsPerADU,
 												"Electrons Per ADU",
 												&fitsStatus);
 	}
 
 	//-------------------------------------------------------------------------------
 	//*	record the camera gain, if present
-	if (cCameraProp.GainMax > 0)
+	if (saveFrame->cameraProp.GainMax > 0)
 	{
-		sprintf(stringBuf, "Camera gain [%d:%d]", cCameraProp.GainMin, cCameraProp.GainMax);
+		sprintf(stringBuf, "Camera gain [%d:%d]", saveFrame->cameraProp.GainMin, saveFrame->cameraProp.GainMax);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr,		TINT,		"GAIN",
-													&cCameraProp.Gain,
+													&saveFrame->cameraProp.Gain,
 													stringBuf,
 													&fitsStatus);
 	}
 
 	//-------------------------------------------------------------------------------
 	//*	record the pixel offset, if present
-	if (cCameraProp.OffsetMax > 0)
+	if (saveFrame->cameraProp.OffsetMax > 0)
 	{
-		sprintf(stringBuf, "Camera offset [%d:%d]", cCameraProp.OffsetMin, cCameraProp.OffsetMax);
+		sprintf(stringBuf, "Camera offset [%d:%d]", saveFrame->cameraProp.OffsetMin, saveFrame->cameraProp.OffsetMax);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr,		TINT,		"OFFSET",
-													&cCameraProp.Offset,
+													&saveFrame->cameraProp.Offset,
 													stringBuf,
 													&fitsStatus);
 	}
@@ -1082,7 +1109,7 @@ char	instrumentString[128];
 	//-------------------------------------------------------------------------------
 	//*	ATIK dusk software uses this keyword
 	intValue	=	cIsColorCam;
-	if (cROIinfo.currentROIimageType == kImageType_RGB24)
+	if (saveFrame->imageType == kImageType_RGB24)
 	{
 		intValue	=	true;
 	}
@@ -1106,7 +1133,7 @@ char	instrumentString[128];
 	//*	readout mode is defined by SBIG
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr,		TINT,		"READOUTM",
-												&cCameraProp.ReadOutMode,
+												&saveFrame->cameraProp.ReadOutMode,
 												"TBD",
 												&fitsStatus);
 
@@ -1142,20 +1169,20 @@ char	instrumentString[128];
 
 	//-------------------------------------------------------------------------------
 	//*	sensor name
-	if (strlen(cCameraProp.SensorName) > 0)
+	if (strlen(saveFrame->cameraProp.SensorName) > 0)
 	{
 		strcpy(stringBuf, "Camera Sensor: ");
-		strcat(stringBuf, cCameraProp.SensorName);
+		strcat(stringBuf, saveFrame->cameraProp.SensorName);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TSTRING, "COMMENT",	stringBuf,		NULL, &fitsStatus);
 	}
 
 	//-------------------------------------------------------------------------------
-	sprintf(stringBuf, "Camera image size: %d x %d", cCameraProp.CameraXsize, cCameraProp.CameraYsize);
+	sprintf(stringBuf, "Camera image size: %d x %d", saveFrame->cameraProp.CameraXsize, saveFrame->cameraProp.CameraYsize);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING, "COMMENT",	stringBuf,		NULL, &fitsStatus);
 
-	megaPixels	=	(1.0 * cCameraProp.CameraXsize * cCameraProp.CameraYsize) / (1024 * 1024);
+	megaPixels	=	(1.0 * saveFrame->cameraProp.CameraXsize * saveFrame->cameraProp.CameraYsize) / (1024 * 1024);
 	sprintf(stringBuf, "Camera image size: %1.1f megapixels", megaPixels);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING, "COMMENT",	stringBuf,		NULL, &fitsStatus);
@@ -1190,18 +1217,18 @@ char	instrumentString[128];
 	fits_write_key(fitsFilePtr, TSTRING, "COMMENT",	stringBuf,		NULL, &fitsStatus);
 
 	//-------------------------------------------------------------------------------
-	sprintf(stringBuf, "Image Shutter: %d microseconds ", cCameraProp.Lastexposure_duration_us);
+	sprintf(stringBuf, "Image Shutter: %d microseconds ", saveFrame->cameraProp.Lastexposure_duration_us);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING, "COMMENT",	stringBuf,		NULL, &fitsStatus);
 
 
 	//-------------------------------------------------------------------------------
 	//*	this was kept here so we dont have to read the CCD temperature twice
-	if (ccdTempErrCode == 0)
+	if (saveFrame->ccdTempValid)
 	{
 		sprintf(stringBuf, "Image Sensor Temperature: %1.1f deg C, %1.1f deg F",
-									cCameraProp.CCDtemperature,
-									((cCameraProp.CCDtemperature * 9.0/5.0) + 32.0));
+									saveFrame->cameraProp.CCDtemperature,
+									((saveFrame->cameraProp.CCDtemperature * 9.0/5.0) + 32.0));
 	}
 	else
 	{
@@ -1708,7 +1735,7 @@ char	stringBuf[128];
 
 
 //*****************************************************************************
-void	CameraDriver::WriteFITS_ObservationInfo(fitsfile *fitsFilePtr, bool includeAnalysis)
+void	CameraDriver::WriteFITS_ObservationInfo(fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame, bool includeAnalysis)
 {
 int				fitsStatus;
 double			exposureTime_Secs;
@@ -1730,7 +1757,7 @@ struct tm		myLocalTime;
 
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"OBJECT",
-											cObjectName,
+											saveFrame->objectName,
 											"Observation title", &fitsStatus);
 
 	if (strlen(gObseratorySettings.Observer) > 0)
@@ -1746,12 +1773,12 @@ struct tm		myLocalTime;
 	}
 
 	//*	format the time of exposure start
-	FormatTimeStringISO8601(&cCameraProp.Lastexposure_StartTime, stringBuf);
+	FormatTimeStringISO8601(&saveFrame->cameraProp.Lastexposure_StartTime, stringBuf);
 //	CONSOLE_DEBUG_W_STR("stringBuf:", stringBuf);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING, "DATE-OBS",	stringBuf,		"UTC date of observation", &fitsStatus);
 
-	gmtime_r(&cCameraProp.Lastexposure_StartTime.tv_sec, &utcTime);
+	gmtime_r(&saveFrame->cameraProp.Lastexposure_StartTime.tv_sec, &utcTime);
 	CalcSiderealTime(&utcTime, &siderealTime, gObseratorySettings.Longitude_deg);
 	FormatTimeString_TM(&siderealTime, stringBuf);
 	fitsStatus	=	0;
@@ -1761,7 +1788,7 @@ struct tm		myLocalTime;
 
 	//==============================================================
 	//*	include the local time as well
-	localTime		=	localtime(&cCameraProp.Lastexposure_StartTime.tv_sec);
+	localTime		=	localtime(&saveFrame->cameraProp.Lastexposure_StartTime.tv_sec);
 	FormatTimeString_TM(localTime, stringBuf);
 
 	fitsStatus	=	0;
@@ -1779,13 +1806,13 @@ struct tm		myLocalTime;
 											&fitsStatus);
 
 	//==============================================================
-	modifiedJulianDate	=	Julian_CalcMJD(&cCameraProp.Lastexposure_StartTime);
+	modifiedJulianDate	=	Julian_CalcMJD(&saveFrame->cameraProp.Lastexposure_StartTime);
 	fitsStatus			=	0;
 	fits_write_key(fitsFilePtr, TDOUBLE,	"MJD-OBS",
 											&modifiedJulianDate,
 											"MJD of observation", &fitsStatus);
 
-	modifiedJulianDate	=	Julian_CalcMJD(&cCameraProp.Lastexposure_EndTime);
+	modifiedJulianDate	=	Julian_CalcMJD(&saveFrame->cameraProp.Lastexposure_EndTime);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TDOUBLE,	"MJDEND",
 											&modifiedJulianDate,
@@ -1793,31 +1820,31 @@ struct tm		myLocalTime;
 
 	//==============================================================
 	fitsStatus	=	0;
-	exposureTime_Secs	=	(cCameraProp.Lastexposure_duration_us * 1.0) / 1000000.0;
+	exposureTime_Secs	=	(saveFrame->cameraProp.Lastexposure_duration_us * 1.0) / 1000000.0;
 	fits_write_key(fitsFilePtr, TDOUBLE,	"EXPTIME",
 											&exposureTime_Secs,
 											"Exposure time (seconds)", &fitsStatus);
 
-	if ((cImageMode == kImageMode_Sequence) && (cImageSeqNumber > 0))
+	if ((saveFrame->imageMode == kImageMode_Sequence) && (saveFrame->imageSeqNumber > 0))
 	{
-		sprintf(stringBuf, "Image Sequence Number (of %d)", cNumFramesRequested);
+		sprintf(stringBuf, "Image Sequence Number (of %d)", saveFrame->numFramesRequested);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TINT,		"IMAGEID",
-												&cImageSeqNumber,
+												&saveFrame->imageSeqNumber,
 												stringBuf,
 												&fitsStatus);
 	}
-	else if (cCameraProp.SavedImageCnt > 1)
+	else if (saveFrame->cameraProp.SavedImageCnt > 1)
 	{
-		sprintf(stringBuf, "Frames saved: %d", cCameraProp.SavedImageCnt);
+		sprintf(stringBuf, "Frames saved: %d", saveFrame->cameraProp.SavedImageCnt);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												stringBuf,
 												NULL, &fitsStatus);
 
-		if (cFrameRate > 0.01)
+		if (saveFrame->frameRate > 0.01)
 		{
-			sprintf(stringBuf, "Frame rate: %1.2f (fps)", cFrameRate);
+			sprintf(stringBuf, "Frame rate: %1.2f (fps)", saveFrame->frameRate);
 			fitsStatus	=	0;
 			fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 													stringBuf,
@@ -1831,7 +1858,7 @@ struct tm		myLocalTime;
 		//============================================================
 		//*	Image analysis stuff
 
-		minmaxPixelValue	=	CalculateMinPixValue();
+		minmaxPixelValue	=	saveFrame->minPixelValue;
 		if (minmaxPixelValue < 65535)
 		{
 			fitsStatus	=	0;
@@ -1840,7 +1867,7 @@ struct tm		myLocalTime;
 												"Minimum pixel value", &fitsStatus);
 		}
 
-		minmaxPixelValue	=	CalculateMaxPixValue();
+		minmaxPixelValue	=	saveFrame->maxPixelValue;
 		if (minmaxPixelValue > 0)
 		{
 			fitsStatus	=	0;
@@ -1849,7 +1876,7 @@ struct tm		myLocalTime;
 												"Maximum pixel value", &fitsStatus);
 		}
 
-		if (cROIinfo.currentROIimageType == kImageType_RAW16)
+		if (saveFrame->imageType == kImageType_RAW16)
 		{
 			staurationValue	=	0x0ffff;
 		}
@@ -1863,30 +1890,40 @@ struct tm		myLocalTime;
 											&staurationValue,
 											"Saturation Value", &fitsStatus);
 
-		saturationPixCount	=	CountSaturationPixels();
+		saturationPixCount	=	saveFrame->saturationPixCount;
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TINT,	"SATPIXEL",
 											&saturationPixCount,
 											"Saturation pixel count", &fitsStatus);
 
-		saturationPrcnt		=	CalculateSaturation();
+		saturationPrcnt		=	saveFrame->saturationPrcnt;
 //		CONSOLE_DEBUG_W_DBL("saturationPrcnt\t: ",		saturationPrcnt);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TDOUBLE,	"SATUPRCT",
 												&saturationPrcnt,
 												"Percentage of pixels at saturation", &fitsStatus);
 
+		WriteFitsDoubleValue(		fitsFilePtr,
+									"DATAMEAN",
+									saveFrame->meanPixelValue,
+									"Mean pixel value");
+
+		WriteFitsDoubleValue(		fitsFilePtr,
+									"DATASDEV",
+									saveFrame->stdDevPixelValue,
+									"Standard deviation of the pixel values");
+
 		//---------------------------------------------------------------------------------------
 		//*	Histogram information
-		//*	this histogram was already calculated before the FITS routine was called.
-		if (cROIinfo.currentROIimageType == kImageType_RAW16)
+		//*	the analysis was done when the frame was captured.
+		if (saveFrame->imageType == kImageType_RAW16)
 		{
 			fitsStatus	=	0;
 			fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 													(char *)"For 16 bit data, the histogram is based on the high 8 bits",
 													NULL, &fitsStatus);
 		}
-		else if (cROIinfo.currentROIimageType == kImageType_RGB24)
+		else if (saveFrame->imageType == kImageType_RGB24)
 		{
 			fitsStatus	=	0;
 			fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
@@ -1894,19 +1931,19 @@ struct tm		myLocalTime;
 													NULL, &fitsStatus);
 		}
 
-		sprintf(stringBuf, "Min histogram value: %d", cMinHistogramValue);
+		sprintf(stringBuf, "Min histogram value: %d", saveFrame->minHistogramValue);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												stringBuf,
 												NULL, &fitsStatus);
 
-		sprintf(stringBuf, "Peak histogram value: %d", cPeakHistogramValue);
+		sprintf(stringBuf, "Peak histogram value: %d", saveFrame->peakHistogramValue);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												stringBuf,
 												NULL, &fitsStatus);
 
-		sprintf(stringBuf, "Max histogram value: %d", cMaxHistogramValue);
+		sprintf(stringBuf, "Max histogram value: %d", saveFrame->maxHistogramValue);
 		fitsStatus	=	0;
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												stringBuf,
@@ -2094,7 +2131,7 @@ char	fitsVersionStr[32];
 }
 
 //*****************************************************************************
-void	CameraDriver::WriteFITS_TelescopeInfo(fitsfile *fitsFilePtr)
+void	CameraDriver::WriteFITS_TelescopeInfo(fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame)
 {
 int		ii;
 int		fitsStatus;
@@ -2192,15 +2229,15 @@ double	f_ratio;
 													stringBuf,
 													NULL, &fitsStatus);
 
-			angularResolution_perPixel	=	Calc_AngularResolutionPerPixel(cTS_info.focalLen_mm, cCameraProp.PixelSizeX);
+			angularResolution_perPixel	=	Calc_AngularResolutionPerPixel(cTS_info.focalLen_mm, saveFrame->cameraProp.PixelSizeX);
 			sprintf(stringBuf, "Angular resolution per pixel: %5.4f (arc-seconds / pixel)",	angularResolution_perPixel);
 			fitsStatus	=	0;
 			fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 													stringBuf,
 													NULL, &fitsStatus);
 
-			fov_arcSeconds_X	=	Calc_FieldOfView_arcSecs(cTS_info.focalLen_mm, cCameraProp.PixelSizeX, cCameraProp.CameraXsize);
-			fov_arcSeconds_Y	=	Calc_FieldOfView_arcSecs(cTS_info.focalLen_mm, cCameraProp.PixelSizeX, cCameraProp.CameraYsize);
+			fov_arcSeconds_X	=	Calc_FieldOfView_arcSecs(cTS_info.focalLen_mm, saveFrame->cameraProp.PixelSizeX, saveFrame->cameraProp.CameraXsize);
+			fov_arcSeconds_Y	=	Calc_FieldOfView_arcSecs(cTS_info.focalLen_mm, saveFrame->cameraProp.PixelSizeX, saveFrame->cameraProp.CameraYsize);
 			sprintf(stringBuf, "Field of view: %1.1f x %1.1f (arc-minutes)", (fov_arcSeconds_X / 60.0), (fov_arcSeconds_Y / 60.0));
 			fitsStatus	=	0;
 			fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
@@ -2292,7 +2329,7 @@ int		fitsStatus;
 }
 
 //*****************************************************************************
-void	CameraDriver::WriteFITS_MoonInfo(fitsfile *fitsFilePtr)
+void	CameraDriver::WriteFITS_MoonInfo(fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame)
 {
 int				fitsStatus;
 struct tm		*linuxTime;
@@ -2311,8 +2348,8 @@ TYPE_MoonPhase	moonPhaseInfo;
 	WriteFITS_Seperator(fitsFilePtr, "Moon Info");
 	//-------------------------------------------------------------
 	//*	use the start of exposure time
-	linuxTime		=	gmtime(&cCameraProp.Lastexposure_StartTime.tv_sec);
-	FormatTimeStringISO8601(&cCameraProp.Lastexposure_StartTime, timeString);
+	linuxTime		=	gmtime(&saveFrame->cameraProp.Lastexposure_StartTime.tv_sec);
+	FormatTimeStringISO8601(&saveFrame->cameraProp.Lastexposure_StartTime, timeString);
 
 	currentYear		=	(1900 + linuxTime->tm_year);
 	currentMonth	=	(1 + linuxTime->tm_mon);
@@ -2548,7 +2585,7 @@ TYPE_MoonPhase	moonPhaseInfo;
 
 #ifdef _ENABLE_IMU_
 //**************************************************************************
-void	CameraDriver::WriteFITS_IMUinfo(fitsfile *fitsFilePtr)
+void	CameraDriver::WriteFITS_IMUinfo(fitsfile *fitsFilePtr, TYPE_SaveFrame *saveFrame)
 {
 int		fitsStatus;
 char	lineBuff[80];
@@ -2562,20 +2599,20 @@ char	lineBuff[80];
 											(char *)"Using bno055 sensor attached to camera",
 											NULL, &fitsStatus);
 
-	if (cIMU_EulerValid)
+	if (saveFrame->imuEulerValid)
 	{
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												(char *)"IMU Euler Data",
 												NULL, &fitsStatus);
 		//*	use the values that were read when the image was taken
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_HEAD",	&cIMU_Heading,	NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_HEAD",	&saveFrame->imuHeading,	NULL, &fitsStatus);
 
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_ROLL",	&cIMU_Roll,		NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_ROLL",	&saveFrame->imuRoll,		NULL, &fitsStatus);
 
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_PTCH",	&cIMU_Pitch,		NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_PTCH",	&saveFrame->imuPitch,		NULL, &fitsStatus);
 	}
 	else
 	{
@@ -2584,7 +2621,7 @@ char	lineBuff[80];
 												NULL, &fitsStatus);
 	}
 
-	if (cIMU_QuatValid)
+	if (saveFrame->imuQuatValid)
 	{
 		fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",
 												(char *)"IMU Quaternion Data",
@@ -2592,16 +2629,16 @@ char	lineBuff[80];
 
 		//*	use the values that were read when the image was taken
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_W",	&cIMU_www,	NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_W",	&saveFrame->imuWWW,	NULL, &fitsStatus);
 
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_X",	&cIMU_xxx,	NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_X",	&saveFrame->imuXXX,	NULL, &fitsStatus);
 
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_Y",	&cIMU_yyy,	NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_Y",	&saveFrame->imuYYY,	NULL, &fitsStatus);
 
 		fitsStatus	=	0;
-		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_Z",	&cIMU_zzz,	NULL, &fitsStatus);
+		fits_write_key(fitsFilePtr, TDOUBLE,	"IMU_Z",	&saveFrame->imuZZZ,	NULL, &fitsStatus);
 	}
 	else
 	{
@@ -2617,19 +2654,19 @@ char	lineBuff[80];
 											NULL, &fitsStatus);
 
 	//*	use the values that were read when the image was taken
-	sprintf(lineBuff,	"IMU-Cal-Gyro=%d",	cIMU_Cal_Gyro);
+	sprintf(lineBuff,	"IMU-Cal-Gyro=%d",	saveFrame->imuCalGyro);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",	lineBuff,	NULL, &fitsStatus);
 
-	sprintf(lineBuff,	"IMU-Cal-Acce=%d",	cIMU_Cal_Acce);
+	sprintf(lineBuff,	"IMU-Cal-Acce=%d",	saveFrame->imuCalAcce);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",	lineBuff,	NULL, &fitsStatus);
 
-	sprintf(lineBuff,	"IMU-Cal-Magn=%d",	cIMU_Cal_Magn);
+	sprintf(lineBuff,	"IMU-Cal-Magn=%d",	saveFrame->imuCalMagn);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",	lineBuff,	NULL, &fitsStatus);
 
-	sprintf(lineBuff,	"IMU-Cal-Syst=%d",	cIMU_Cal_Syst);
+	sprintf(lineBuff,	"IMU-Cal-Syst=%d",	saveFrame->imuCalSyst);
 	fitsStatus	=	0;
 	fits_write_key(fitsFilePtr, TSTRING,	"COMMENT",	lineBuff,	NULL, &fitsStatus);
 }
@@ -2694,7 +2731,7 @@ int				leftOverCount;
 #endif
 
 //*****************************************************************************
-void		CameraDriver::CreateFitsBGRimage(void)
+void		CameraDriver::CreateFitsBGRimage(TYPE_SaveFrame *saveFrame)
 {
 long			frameBufSize;
 long			iii;
@@ -2702,22 +2739,34 @@ long			ppp;
 unsigned char	*redBufPtr;
 unsigned char	*grnBufPtr;
 unsigned char	*bluBufPtr;
+unsigned char	*srcBufPtr;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	frameBufSize	=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
-	if (cCameraDataBuffer != NULL)
+	frameBufSize	=	saveFrame->cameraProp.CameraXsize * saveFrame->cameraProp.CameraYsize;
+	srcBufPtr		=	saveFrame->pixelBuffer;
+	if (srcBufPtr != NULL)
 	{
-		if (cCameraBGRbuffer == NULL)
+		//*	the buffer is kept with the frame, it only gets re-allocated if the image got bigger
+		if (saveFrame->bgrBufferSize < ((frameBufSize * 3) + 100))
 		{
-			cCameraBGRbuffer	=	(unsigned char *)malloc((frameBufSize * 3) + 100);
+			if (saveFrame->bgrBuffer != NULL)
+			{
+				free(saveFrame->bgrBuffer);
+			}
+			saveFrame->bgrBufferSize	=	(frameBufSize * 3) + 100;
+			saveFrame->bgrBuffer		=	(unsigned char *)malloc(saveFrame->bgrBufferSize);
+			if (saveFrame->bgrBuffer == NULL)
+			{
+				saveFrame->bgrBufferSize	=	0;
+			}
 		}
 
-		if (cCameraBGRbuffer != NULL)
+		if (saveFrame->bgrBuffer != NULL)
 		{
-			bluBufPtr	=	cCameraBGRbuffer;
-			grnBufPtr	=	cCameraBGRbuffer + frameBufSize;
-			redBufPtr	=	cCameraBGRbuffer + frameBufSize + frameBufSize;
+			bluBufPtr	=	saveFrame->bgrBuffer;
+			grnBufPtr	=	saveFrame->bgrBuffer + frameBufSize;
+			redBufPtr	=	saveFrame->bgrBuffer + frameBufSize + frameBufSize;
 		#ifdef __ARM_NEON
 			//:2379 [CreateFitsBGRimage  ] CreateFitsBGRimage
 			//:2402 [CreateFitsBGRimage  ] Using CPU to Deinterleave 307
@@ -2734,7 +2783,7 @@ unsigned char	*bluBufPtr;
 			{
 				CONSOLE_DEBUG("Using NEON instructions for de-interleave");
 
-				NEON_Deinterleave_RGB(cCameraDataBuffer, redBufPtr, grnBufPtr, bluBufPtr, frameBufSize);
+				NEON_Deinterleave_RGB(srcBufPtr, redBufPtr, grnBufPtr, bluBufPtr, frameBufSize);
 			}
 			else
 		#endif // __ARM_NEON
@@ -2743,16 +2792,16 @@ unsigned char	*bluBufPtr;
 				iii	=	0;
 				for (ppp=0; ppp<frameBufSize; ppp++)
 				{
-					redBufPtr[ppp]	=	cCameraDataBuffer[iii++];
-					grnBufPtr[ppp]	=	cCameraDataBuffer[iii++];
-					bluBufPtr[ppp]	=	cCameraDataBuffer[iii++];
+					redBufPtr[ppp]	=	srcBufPtr[iii++];
+					grnBufPtr[ppp]	=	srcBufPtr[iii++];
+					bluBufPtr[ppp]	=	srcBufPtr[iii++];
 				}
 				DEBUG_TIMING("Using CPU to Deinterleave");
 			}
 		}
 		else
 		{
-			CONSOLE_DEBUG("Failed to allocated cCameraBGRbuffer");
+			CONSOLE_DEBUG("Failed to allocate BGR buffer");
 		}
 
 	}
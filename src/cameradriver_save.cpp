@@ -25,6 +25,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jan 30,	2020	<MLS> Created cameradriver_save.cpp
 //*	Jan 30,	2020	<MLS> Added SaveImageData(), AddToDataProductsList()
@@ -37,6 +38,14 @@
 //*	Jul 25,	2022	<MLS> Increased # of decimal points in WriteIMUtextFile()
 //*	Oct  5,	2022	<MLS> Added ReadIMUdata()
 //*	Jun 13,	2023	<MLS> Added checking for valid IMU
+//*	Oct 18,	2026	<AGT> Added asynchronous save queue with its own worker threads
+//*	Oct 18,	2026	<AGT> SaveImageData() now takes a snapshot of the frame and queues it
+//*	Oct 18,	2026	<AGT> Added SaveFrame_Capture(), SaveFrame_WriteFiles(), Get_SaveQueue()
+//*	Oct 18,	2026	<AGT> Added SaveOpenCVImage_Frame()
+//*	Oct 18,	2026	<AGT> Save frames hold a reference to the frame ring slot instead of copying the pixels
+//*	Oct 18,	2026	<AGT> SaveFrame_Capture() uses the stats from CalculateImageStats()
+//*	Oct 18,	2026	<AGT> Added SaveQueue_Stop(), the save threads are joined when the camera is deleted
+//*	Oct 18,	2026	<AGT> Only the FITS saves read the sensor temp and calculate the image stats
 //*****************************************************************************
 
 #ifdef _ENABLE_CAMERA_
@@ -45,7 +54,9 @@
 //#define	_ENABLE_PNG_
 
 #include	<stdio.h>
+#include	<stdlib.h>
 #include	<string.h>
+#include	<pthread.h>
 
 #define _ENABLE_CONSOLE_DEBUG_
 #include	"ConsoleDebug.h"
@@ -62,6 +73,7 @@
 #include	"alpacadriver.h"
 #include	"alpacadriver_helper.h"
 #include	"cameradriver.h"
+#include	"JsonResponse.h"
 
 #ifdef _ENABLE_STAR_SEARCH_
 	//*	this is totally experimental and is not part of the normal release
@@ -72,10 +84,16 @@
 	#include "imu_lib_bno055.h"
 #endif
 
+//*****************************************************************************
+//*	Called from the camera state machine when an image is to be saved.
+//*	Everything that has to be done at the time the image was taken is done here,
+//*	the files are written by the save queue worker threads.
 //*****************************************************************************
 void	CameraDriver::SaveImageData(void)
 {
-int		iii;
+int				iii;
+TYPE_SaveFrame	*saveFrame;
+uint32_t		snapshotStartMillis;
 
 
 	CONSOLE_DEBUG_W_NUM("cSaveNextImage\t=", cSaveNextImage);
@@ -93,12 +111,16 @@ int		iii;
 
 	if (cCameraDataBuffer != NULL)
 	{
+		snapshotStartMillis	=	millis();
+
+		//*	all of the files for this image get the same name
+		GenerateFileNameRoot();
+
 	#ifdef _ENABLE_IMU_
 		//*	we want to do this first so the readings are closest to the time we took the picture
 		if (IMU_IsAvailable())
 		{
 			ReadIMUdata();
-			WriteIMUtextFile();
 		}
 	#endif
 
@@ -109,7 +131,8 @@ int		iii;
 	#endif // _INCLUDE_HISTOGRAM_
 
 
-	#ifdef _USE_OPENCV_
+	#if defined(_USE_OPENCV_) && !defined(_USE_OPENCV_CPP_) && (CV_MAJOR_VERSION < 4)
+		//*	the "C" interface image is not copied into the save frame, save it now
 		if (cSaveAsJPEG || cSaveAsPNG)
 		{
 			SaveOpenCVImage();
@@ -132,13 +155,34 @@ int		bytesPerPixel;
 //			SaveImageRaw();
 //		}
 
-	//*	we want FITS to be last so it can include info about other save data products
-	#ifdef _ENABLE_FITS_
-		if (cSaveAsFITS)
+		//*	take a snapshot of the frame and hand it to the save queue
+		saveFrame	=	SaveQueue_GetFreeFrame();
+		if (saveFrame != NULL)
 		{
-			SaveImageAsFITS();
+			SaveFrame_Capture(saveFrame, true);
+			if (cSaveAsFITS)
+			{
+				SaveFrame_CaptureFitsInfo(saveFrame);
+			}
+			saveFrame->stageMillis[kSaveStage_Snapshot]	=	millis() - snapshotStartMillis;
+			SaveQueue_Push(saveFrame);
 		}
-	#endif // _ENABLE_FITS_
+		else
+		{
+		TYPE_SaveFrame	liveFrame;
+
+			//*	the save queue is not available, do it the old way
+			CONSOLE_DEBUG("Save queue not available, saving from the camera buffer");
+			SaveFrame_Capture(&liveFrame, false);
+			if (cSaveAsFITS)
+			{
+				SaveFrame_CaptureFitsInfo(&liveFrame);
+			}
+			SaveFrame_WriteFiles(&liveFrame);
+			cCameraBGRbuffer	=	liveFrame.bgrBuffer;
+			cCameraBGRbuffSize	=	liveFrame.bgrBufferSize;
+		}
+
 	#if defined(_JETSON_) && defined(_FIND_STARS_)
 		long	keyPointCnt;
 		char	imageFilePath[128];
@@ -173,6 +217,642 @@ int		bytesPerPixel;
 
 }
 
+//*****************************************************************************
+static void	SaveFrame_AddDataProduct(	TYPE_SaveFrame	*saveFrame,
+										const char		*newDataProductName,
+										const char		*newDatacomment)
+{
+	if (saveFrame->otherDataCnt < kMaxDataProducts)
+	{
+		if (strlen(newDataProductName) < kMaxFileNameLen)
+		{
+			strcpy(saveFrame->otherDataProducts[saveFrame->otherDataCnt].filename, newDataProductName);
+			if (newDatacomment != NULL)
+			{
+				strcpy(saveFrame->otherDataProducts[saveFrame->otherDataCnt].comment, newDatacomment);
+			}
+			saveFrame->otherDataCnt++;
+		}
+	}
+	else
+	{
+		CONSOLE_DEBUG("otherDataProducts list is full");
+	}
+}
+
+//*****************************************************************************
+//*	Fill in the save frame with everything the save routines need.
+//*	If copyImageData is false, the frame points to the camera's buffers,
+//*	this is used when saving from the camera thread (i.e. AVI header)
+//*****************************************************************************
+void	CameraDriver::SaveFrame_Capture(TYPE_SaveFrame *saveFrame, const bool copyImageData)
+{
+long	imageDataLen;
+int		bytesPerPixel;
+
+	if (copyImageData == false)
+	{
+		memset((void *)saveFrame, 0, sizeof(TYPE_SaveFrame));
+	}
+
+	switch(cROIinfo.currentROIimageType)
+	{
+		case kImageType_RAW16:	bytesPerPixel	=	2;	break;
+		case kImageType_RGB24:	bytesPerPixel	=	3;	break;
+		default:				bytesPerPixel	=	1;	break;
+	}
+	imageDataLen	=	(long)cCameraProp.CameraXsize * cCameraProp.CameraYsize * bytesPerPixel;
+	if (imageDataLen > cCameraDataBuffLen)
+	{
+		imageDataLen	=	cCameraDataBuffLen;
+	}
+
+	if (copyImageData)
+	{
+		saveFrame->ownsBuffers	=	true;
+		//*	the camera does not read into a slot that has a reference,
+		//*	so the pixels do not have to be copied
+		saveFrame->frameRingIdx	=	FrameRing_AcquireReady();
+		if (saveFrame->frameRingIdx >= 0)
+		{
+			saveFrame->pixelBuffer		=	cFrameRing[saveFrame->frameRingIdx].dataBuffer;
+			saveFrame->pixelBufferSize	=	cFrameRing[saveFrame->frameRingIdx].bufferLen;
+			saveFrame->pixelDataLen		=	imageDataLen;
+		}
+		else
+		{
+			//*	the frame is not in the ring, take a copy
+			//*	the copy buffer stays with the frame, it only gets re-allocated if the image got bigger
+			if (saveFrame->pixelCopyBufferSize < imageDataLen)
+			{
+				if (saveFrame->pixelCopyBuffer != NULL)
+				{
+					free(saveFrame->pixelCopyBuffer);
+				}
+				saveFrame->pixelCopyBufferSize	=	imageDataLen;
+				saveFrame->pixelCopyBuffer		=	(unsigned char *)malloc(saveFrame->pixelCopyBufferSize);
+				if (saveFrame->pixelCopyBuffer == NULL)
+				{
+					CONSOLE_DEBUG("Failed to allocate save frame buffer");
+					saveFrame->pixelCopyBufferSize	=	0;
+				}
+			}
+			saveFrame->pixelBuffer		=	saveFrame->pixelCopyBuffer;
+			saveFrame->pixelBufferSize	=	saveFrame->pixelCopyBufferSize;
+			saveFrame->pixelDataLen		=	0;
+			if ((saveFrame->pixelBuffer != NULL) && (cCameraDataBuffer != NULL))
+			{
+				memcpy(saveFrame->pixelBuffer, cCameraDataBuffer, imageDataLen);
+				saveFrame->pixelDataLen	=	imageDataLen;
+			}
+		}
+	#if defined(_USE_OPENCV_) && (defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4))
+		if ((cSaveAsJPEG || cSaveAsPNG) && (cOpenCV_ImagePtr != NULL))
+		{
+			if (saveFrame->openCVimagePtr == NULL)
+			{
+				saveFrame->openCVimagePtr	=	new cv::Mat();
+			}
+			//*	copyTo() re-uses the memory if the size has not changed
+			cOpenCV_ImagePtr->copyTo(*saveFrame->openCVimagePtr);
+		}
+	#endif
+	}
+	else
+	{
+		saveFrame->ownsBuffers		=	false;
+		saveFrame->frameRingIdx		=	-1;
+		saveFrame->pixelBuffer		=	cCameraDataBuffer;
+		saveFrame->pixelBufferSize	=	cCameraDataBuffLen;
+		saveFrame->pixelDataLen		=	imageDataLen;
+		saveFrame->bgrBuffer		=	cCameraBGRbuffer;
+		saveFrame->bgrBufferSize	=	cCameraBGRbuffSize;
+	#if defined(_USE_OPENCV_) && (defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4))
+		saveFrame->openCVimagePtr	=	cOpenCV_ImagePtr;
+	#endif
+	}
+
+	saveFrame->cameraProp			=	cCameraProp;
+	saveFrame->imageType			=	cROIinfo.currentROIimageType;
+	saveFrame->imageMode			=	cImageMode;
+	saveFrame->imageSeqNumber		=	cImageSeqNumber;
+	saveFrame->numFramesRequested	=	cNumFramesRequested;
+	saveFrame->frameRate			=	cFrameRate;
+	saveFrame->frameNumber			=	cFramesRead;
+	saveFrame->saveAsFITS			=	cSaveAsFITS;
+	saveFrame->saveAsJPEG			=	cSaveAsJPEG;
+	saveFrame->saveAsPNG			=	cSaveAsPNG;
+	strcpy(saveFrame->objectName,	cObjectName);
+	strcpy(saveFrame->fileNameRoot,	cFileNameRoot);
+
+	saveFrame->ccdTempValid			=	false;
+#ifdef _INCLUDE_HISTOGRAM_
+	saveFrame->minHistogramValue	=	cMinHistogramValue;
+	saveFrame->peakHistogramValue	=	cPeakHistogramValue;
+	saveFrame->maxHistogramValue	=	cMaxHistogramValue;
+#endif
+
+#ifdef _ENABLE_IMU_
+	saveFrame->imuEulerValid		=	cIMU_EulerValid;
+	saveFrame->imuQuatValid			=	cIMU_QuatValid;
+	saveFrame->imuHeading			=	cIMU_Heading;
+	saveFrame->imuRoll				=	cIMU_Roll;
+	saveFrame->imuPitch				=	cIMU_Pitch;
+	saveFrame->imuWWW				=	cIMU_www;
+	saveFrame->imuXXX				=	cIMU_xxx;
+	saveFrame->imuYYY				=	cIMU_yyy;
+	saveFrame->imuZZZ				=	cIMU_zzz;
+	saveFrame->imuCalGyro			=	cIMU_Cal_Gyro;
+	saveFrame->imuCalAcce			=	cIMU_Cal_Acce;
+	saveFrame->imuCalMagn			=	cIMU_Cal_Magn;
+	saveFrame->imuCalSyst			=	cIMU_Cal_Syst;
+#endif
+
+	//*	anything that was already saved from the camera thread
+	memcpy(saveFrame->otherDataProducts, cOtherDataProducts, sizeof(cOtherDataProducts));
+	saveFrame->otherDataCnt	=	cOtherDataCnt;
+}
+
+//*****************************************************************************
+//*	The sensor temperature and the image analysis are only used in the FITS header,
+//*	this is only called when a FITS file is going to be written.
+//*	The camera can only be talked to from the camera thread.
+//*****************************************************************************
+void	CameraDriver::SaveFrame_CaptureFitsInfo(TYPE_SaveFrame *saveFrame)
+{
+	if (Read_SensorTemp() == kASCOM_Err_Success)
+	{
+		saveFrame->ccdTempValid				=	true;
+		saveFrame->cameraProp.CCDtemperature	=	cCameraProp.CCDtemperature;
+	}
+
+	//*	they were all calculated in one pass, usually before we got here
+	CalculateImageStats();
+	saveFrame->minPixelValue		=	cImageStats.minPixelValue;
+	saveFrame->maxPixelValue		=	cImageStats.maxPixelValue;
+	saveFrame->saturationPixCount	=	cImageStats.saturatedPixCnt;
+	saveFrame->saturationPrcnt		=	cImageStats.saturationPrcnt;
+	saveFrame->meanPixelValue		=	cImageStats.meanValue;
+	saveFrame->stdDevPixelValue		=	cImageStats.stdDevValue;
+}
+
+//*****************************************************************************
+//*	the save threads write the name, the web server reads it
+//*****************************************************************************
+void	CameraDriver::SetLastJpegImageName(const char *imageName)
+{
+	pthread_mutex_lock(&cSaveQueueMutex);
+	strncpy(cLastJpegImageName, imageName, (sizeof(cLastJpegImageName) - 1));
+	cLastJpegImageName[sizeof(cLastJpegImageName) - 1]	=	0;
+	pthread_mutex_unlock(&cSaveQueueMutex);
+}
+
+//*****************************************************************************
+void	CameraDriver::GetLastJpegImageName(char *imageName, const int maxLen)
+{
+	pthread_mutex_lock(&cSaveQueueMutex);
+	strncpy(imageName, cLastJpegImageName, (maxLen - 1));
+	imageName[maxLen - 1]	=	0;
+	pthread_mutex_unlock(&cSaveQueueMutex);
+}
+
+//*****************************************************************************
+//*	Write all of the files for one frame.
+//*	This runs on a save queue thread, it must only use what is in saveFrame
+//*	FITS is last so it can include info about the other data products
+//*****************************************************************************
+void	CameraDriver::SaveFrame_WriteFiles(TYPE_SaveFrame *saveFrame)
+{
+uint32_t	stageStartMillis;
+
+	stageStartMillis	=	millis();
+#ifdef _ENABLE_IMU_
+	if (IMU_IsAvailable())
+	{
+		WriteIMUtextFile(saveFrame);
+	}
+#endif
+	saveFrame->stageMillis[kSaveStage_IMU]		=	millis() - stageStartMillis;
+
+	stageStartMillis	=	millis();
+#if defined(_USE_OPENCV_) && (defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4))
+	if (saveFrame->saveAsJPEG || saveFrame->saveAsPNG)
+	{
+		SaveOpenCVImage_Frame(saveFrame);
+	}
+#endif
+	saveFrame->stageMillis[kSaveStage_OpenCV]	=	millis() - stageStartMillis;
+
+	stageStartMillis	=	millis();
+#ifdef _ENABLE_FITS_
+	if (saveFrame->saveAsFITS)
+	{
+		SaveImageAsFITS_Frame(saveFrame, false);
+	}
+#endif // _ENABLE_FITS_
+	saveFrame->stageMillis[kSaveStage_FITS]		=	millis() - stageStartMillis;
+}
+
+#pragma mark -
+//*****************************************************************************
+static void	*SaveQueue_WorkerThread(void *arg)
+{
+CameraDriver	*cameraDriver;
+
+	cameraDriver	=	(CameraDriver *)arg;
+	cameraDriver->SaveQueue_WorkerLoop();
+	return(NULL);
+}
+
+//*****************************************************************************
+void	CameraDriver::SaveQueue_Start(void)
+{
+int		iii;
+int		threadErr;
+int		threadCnt;
+
+	threadCnt	=	0;
+	for (iii=0; iii<kSaveWorkerThreadCnt; iii++)
+	{
+		threadErr	=	pthread_create(&cSaveWorkerThreadIDs[threadCnt], NULL, &SaveQueue_WorkerThread, this);
+		if (threadErr == 0)
+		{
+			threadCnt++;
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("Failed to create save queue thread, err=", threadErr);
+		}
+	}
+	cSaveWorkerCnt		=	threadCnt;
+	cSaveQueueRunning	=	(threadCnt > 0);
+	CONSOLE_DEBUG_W_NUM("Save queue threads started\t=", threadCnt);
+}
+
+//*****************************************************************************
+//*	the worker threads finish what is already in the queue and then exit
+//*****************************************************************************
+void	CameraDriver::SaveQueue_Stop(void)
+{
+int		iii;
+
+	pthread_mutex_lock(&cSaveQueueMutex);
+	cSaveQueueStopping	=	true;
+	pthread_cond_broadcast(&cSaveQueueCondition);
+	pthread_cond_broadcast(&cSaveFrameFreeCondition);
+	pthread_mutex_unlock(&cSaveQueueMutex);
+
+	for (iii=0; iii<cSaveWorkerCnt; iii++)
+	{
+		pthread_join(cSaveWorkerThreadIDs[iii], NULL);
+	}
+	cSaveWorkerCnt		=	0;
+	cSaveQueueRunning	=	false;
+
+	//*	the buffers that belong to the frames
+	for (iii=0; iii<kSaveQueueDepth; iii++)
+	{
+		if (cSaveFrames[iii].pixelCopyBuffer != NULL)
+		{
+			free(cSaveFrames[iii].pixelCopyBuffer);
+			cSaveFrames[iii].pixelCopyBuffer	=	NULL;
+		}
+		if (cSaveFrames[iii].ownsBuffers)
+		{
+			if (cSaveFrames[iii].bgrBuffer != NULL)
+			{
+				free(cSaveFrames[iii].bgrBuffer);
+				cSaveFrames[iii].bgrBuffer	=	NULL;
+			}
+		#if defined(_USE_OPENCV_) && (defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4))
+			if (cSaveFrames[iii].openCVimagePtr != NULL)
+			{
+				delete cSaveFrames[iii].openCVimagePtr;
+				cSaveFrames[iii].openCVimagePtr	=	NULL;
+			}
+		#endif
+		}
+	}
+}
+
+//*****************************************************************************
+//*	returns a frame that is not in use, waits if they are all in use.
+//*	returns NULL if the save queue could not be started
+//*****************************************************************************
+TYPE_SaveFrame	*CameraDriver::SaveQueue_GetFreeFrame(void)
+{
+TYPE_SaveFrame	*saveFrame;
+int				iii;
+
+	if ((cSaveQueueRunning == false) && (cSaveQueueStopping == false))
+	{
+		SaveQueue_Start();
+		if (cSaveQueueRunning == false)
+		{
+			return(NULL);
+		}
+	}
+
+	saveFrame	=	NULL;
+	pthread_mutex_lock(&cSaveQueueMutex);
+	if (cSaveFramesInUse >= kSaveQueueDepth)
+	{
+		cSaveQueueStats.queueFullWaits++;
+		CONSOLE_DEBUG("Save queue is full, waiting for a frame to be released");
+		while ((cSaveFramesInUse >= kSaveQueueDepth) && (cSaveQueueStopping == false))
+		{
+			pthread_cond_wait(&cSaveFrameFreeCondition, &cSaveQueueMutex);
+		}
+	}
+	for (iii=0; (iii<kSaveQueueDepth) && (cSaveQueueStopping == false); iii++)
+	{
+		if (cSaveFrames[iii].frameState == kSaveFrame_Free)
+		{
+			saveFrame				=	&cSaveFrames[iii];
+			saveFrame->frameState	=	kSaveFrame_Capture;
+			cSaveFramesInUse++;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&cSaveQueueMutex);
+	return(saveFrame);
+}
+
+//*****************************************************************************
+void	CameraDriver::SaveQueue_Push(TYPE_SaveFrame *saveFrame)
+{
+int		tailIdx;
+
+	pthread_mutex_lock(&cSaveQueueMutex);
+	saveFrame->frameState		=	kSaveFrame_Queued;
+	saveFrame->stageStartMillis	=	millis();
+	tailIdx						=	(cSaveQueueHead + cSaveQueueCount) % kSaveQueueDepth;
+	cSaveQueue[tailIdx]			=	saveFrame;
+	cSaveQueueCount++;
+	cSaveQueueStats.framesQueued++;
+	if (cSaveQueueCount > cSaveQueueStats.maxQueueDepth)
+	{
+		cSaveQueueStats.maxQueueDepth	=	cSaveQueueCount;
+	}
+	pthread_cond_signal(&cSaveQueueCondition);
+	pthread_mutex_unlock(&cSaveQueueMutex);
+}
+
+//*****************************************************************************
+void	CameraDriver::SaveQueue_ReleaseFrame(TYPE_SaveFrame *saveFrame)
+{
+int		iii;
+
+	//*	let the camera have the frame buffer back
+	if (saveFrame->frameRingIdx >= 0)
+	{
+		FrameRing_Release(saveFrame->frameRingIdx);
+		saveFrame->frameRingIdx	=	-1;
+		saveFrame->pixelBuffer	=	NULL;
+	}
+
+	pthread_mutex_lock(&cSaveQueueMutex);
+	saveFrame->stageMillis[kSaveStage_Total]	=	millis() - saveFrame->stageStartMillis;
+	for (iii=0; iii<kSaveStage_last; iii++)
+	{
+		cSaveQueueStats.lastMillis[iii]	=	saveFrame->stageMillis[iii];
+		cSaveQueueStats.sumMillis[iii]	+=	saveFrame->stageMillis[iii];
+		if (saveFrame->stageMillis[iii] > cSaveQueueStats.maxMillis[iii])
+		{
+			cSaveQueueStats.maxMillis[iii]	=	saveFrame->stageMillis[iii];
+		}
+	}
+	cSaveQueueStats.framesSaved++;
+
+	saveFrame->frameState	=	kSaveFrame_Free;
+	cSaveFramesInUse--;
+	pthread_cond_signal(&cSaveFrameFreeCondition);
+	pthread_mutex_unlock(&cSaveQueueMutex);
+}
+
+//*****************************************************************************
+//*	each frame is saved by one thread, more than one frame can be saved at a time
+//*****************************************************************************
+void	CameraDriver::SaveQueue_WorkerLoop(void)
+{
+TYPE_SaveFrame	*saveFrame;
+bool			keepRunning;
+
+	keepRunning	=	true;
+	while (keepRunning)
+	{
+		saveFrame	=	NULL;
+		pthread_mutex_lock(&cSaveQueueMutex);
+		while ((cSaveQueueCount == 0) && (cSaveQueueStopping == false))
+		{
+			pthread_cond_wait(&cSaveQueueCondition, &cSaveQueueMutex);
+		}
+		if (cSaveQueueCount > 0)
+		{
+			saveFrame				=	cSaveQueue[cSaveQueueHead];
+			cSaveQueueHead			=	(cSaveQueueHead + 1) % kSaveQueueDepth;
+			cSaveQueueCount--;
+			saveFrame->frameState	=	kSaveFrame_Saving;
+		}
+		else
+		{
+			//*	stopping and the queue is empty
+			keepRunning	=	false;
+		}
+		pthread_mutex_unlock(&cSaveQueueMutex);
+
+		if (saveFrame != NULL)
+		{
+			saveFrame->stageMillis[kSaveStage_Queued]	=	millis() - saveFrame->stageStartMillis;
+			SaveFrame_WriteFiles(saveFrame);
+			SaveQueue_ReleaseFrame(saveFrame);
+		}
+	}
+}
+
+//*****************************************************************************
+static const char	*gSaveStageNames[]	=
+{
+	"snapshot",
+	"queued",
+	"imu",
+	"opencv",
+	"fits",
+	"total",
+};
+
+//*****************************************************************************
+TYPE_ASCOM_STATUS	CameraDriver::Get_SaveQueue(TYPE_GetPutRequestData *reqData, char *alpacaErrMsg)
+{
+TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
+TYPE_SaveQueueStats	queueStats;
+TYPE_FrameRingStats	ringStats;
+int					queueDepth;
+int					framesInUse;
+int					slotsAllocated;
+int					iii;
+char				keywordString[48];
+double				averageMillis;
+
+	pthread_mutex_lock(&cSaveQueueMutex);
+	queueStats	=	cSaveQueueStats;
+	queueDepth	=	cSaveQueueCount;
+	framesInUse	=	cSaveFramesInUse;
+	pthread_mutex_unlock(&cSaveQueueMutex);
+
+	pthread_mutex_lock(&cFrameRingMutex);
+	ringStats		=	cFrameRingStats;
+	slotsAllocated	=	0;
+	for (iii=0; iii<cFrameRingDepth; iii++)
+	{
+		if (cFrameRing[iii].dataBuffer != NULL)
+		{
+			slotsAllocated++;
+		}
+	}
+	pthread_mutex_unlock(&cFrameRingMutex);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"queuedepth",
+									queueDepth,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framesinuse",
+									framesInUse,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"queuesize",
+									kSaveQueueDepth,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"maxqueuedepth",
+									queueStats.maxQueueDepth,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framesqueued",
+									queueStats.framesQueued,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framessaved",
+									queueStats.framesSaved,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"queuefullwaits",
+									queueStats.queueFullWaits,
+									INCLUDE_COMMA);
+
+	//*	frame buffer ring
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebuffers",
+									cFrameRingDepth,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebuffersallocated",
+									slotsAllocated,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebufferallocations",
+									ringStats.allocations,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebufferhugepages",
+									ringStats.hugePageAllocs,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebuffermaxinuse",
+									ringStats.maxSlotsInUse,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebufferfullwaits",
+									ringStats.ringFullWaits,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framebufferoverruns",
+									ringStats.ringOverruns,
+									INCLUDE_COMMA);
+
+	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+									reqData->jsonTextBuffer,
+									kMaxJsonBuffLen,
+									"framesdropped",
+									ringStats.droppedFrames,
+									INCLUDE_COMMA);
+
+	//*	timing for each stage, milliseconds
+	for (iii=0; iii<kSaveStage_last; iii++)
+	{
+		sprintf(keywordString, "%s-last-ms", gSaveStageNames[iii]);
+		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+										reqData->jsonTextBuffer,
+										kMaxJsonBuffLen,
+										keywordString,
+										queueStats.lastMillis[iii],
+										INCLUDE_COMMA);
+
+		averageMillis	=	0.0;
+		if (queueStats.framesSaved > 0)
+		{
+			averageMillis	=	queueStats.sumMillis[iii] / queueStats.framesSaved;
+		}
+		sprintf(keywordString, "%s-avg-ms", gSaveStageNames[iii]);
+		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Double(reqData->socket,
+										reqData->jsonTextBuffer,
+										kMaxJsonBuffLen,
+										keywordString,
+										averageMillis,
+										INCLUDE_COMMA);
+
+		sprintf(keywordString, "%s-max-ms", gSaveStageNames[iii]);
+		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	reqData->socket,
+										reqData->jsonTextBuffer,
+										kMaxJsonBuffLen,
+										keywordString,
+										queueStats.maxMillis[iii],
+										INCLUDE_COMMA);
+	}
+	return(alpacaErrCode);
+}
+
 //*****************************************************************************
 void	CameraDriver::AddToDataProductsList(const char *newDataProductName, const char *newDatacomment)
 {
@@ -334,6 +1014,22 @@ int				imageDataLen;
 //*****************************************************************************
 int	CameraDriver::SaveOpenCVImage(void)
 {
+TYPE_SaveFrame	saveFrame;
+int				returnCode;
+
+	SaveFrame_Capture(&saveFrame, false);
+	returnCode	=	SaveOpenCVImage_Frame(&saveFrame);
+
+	memcpy(cOtherDataProducts, saveFrame.otherDataProducts, sizeof(cOtherDataProducts));
+	cOtherDataCnt	=	saveFrame.otherDataCnt;
+	return(returnCode);
+}
+
+//*****************************************************************************
+//*	using "C++" interface, this can be called from a save queue thread
+//*****************************************************************************
+int	CameraDriver::SaveOpenCVImage_Frame(TYPE_SaveFrame *saveFrame)
+{
 int			bytesPerPixel;
 int			openCVerr;
 char		imageFileName[64];
@@ -342,31 +1038,31 @@ char		imageFilePath[128];
 	CONSOLE_DEBUG_W_STR(__FUNCTION__, "Using C++ openCV calls");
 	SETUP_TIMING();
 
-	if (cOpenCV_ImagePtr != NULL)
+	if (saveFrame->openCVimagePtr != NULL)
 	{
 
-		bytesPerPixel		=	cOpenCV_ImagePtr->step[1];
+		bytesPerPixel		=	saveFrame->openCVimagePtr->step[1];
 		CONSOLE_DEBUG_W_NUM("bytesPerPixel\t=",	bytesPerPixel);
 		if (bytesPerPixel != 0)
 		{
 			//--------------------------------------------------------------------------------------------
 			//*	JPEG does not work on 16 bit images
-			if (cSaveAsJPEG && (bytesPerPixel != 2))
+			if (saveFrame->saveAsJPEG && (bytesPerPixel != 2))
 			{
 				//*	save as JPEG
-				strcpy(imageFileName, cFileNameRoot);
+				strcpy(imageFileName, saveFrame->fileNameRoot);
 				strcat(imageFileName, ".jpg");
 
 				strcpy(imageFilePath, gImageDataDir);
 				strcat(imageFilePath, "/");
 				strcat(imageFilePath, imageFileName);
 
-				strcpy(cLastJpegImageName, imageFilePath);	//*	save the full image path for the web server
+				SetLastJpegImageName(imageFilePath);	//*	save the full image path for the web server
 
-				openCVerr	=	cv::imwrite(imageFilePath, *cOpenCV_ImagePtr);
+				openCVerr	=	cv::imwrite(imageFilePath, *saveFrame->openCVimagePtr);
 				if (openCVerr == 1)
 				{
-					AddToDataProductsList(imageFileName, "JPEG image-openCV");
+					SaveFrame_AddDataProduct(saveFrame, imageFileName, "JPEG image-openCV");
 				}
 				else
 				{
@@ -375,24 +1071,24 @@ char		imageFilePath[128];
 			}
 
 			//--------------------------------------------------------------------------------------------
-			if (cSaveAsPNG)
+			if (saveFrame->saveAsPNG)
 			{
 //				SETUP_TIMING();
 //				//*	OpenCV png file creation takes WAY too long, use caution
 //				START_TIMING();
 
 				//*	save as png
-				strcpy(imageFileName, cFileNameRoot);
+				strcpy(imageFileName, saveFrame->fileNameRoot);
 				strcat(imageFileName, ".png");
 
 				strcpy(imageFilePath, gImageDataDir);
 				strcat(imageFilePath, "/");
 				strcat(imageFilePath, imageFileName);
 
-				openCVerr	=	cv::imwrite(imageFilePath, *cOpenCV_ImagePtr);
+				openCVerr	=	cv::imwrite(imageFilePath, *saveFrame->openCVimagePtr);
 				if (openCVerr == 1)
 				{
-					AddToDataProductsList(imageFileName, "PNG image-openCV");
+					SaveFrame_AddDataProduct(saveFrame, imageFileName, "PNG image-openCV");
 				}
 				else
 				{
@@ -411,7 +1107,7 @@ char		imageFilePath[128];
 	}
 	else
 	{
-		CONSOLE_DEBUG("cOpenCV_ImagePtr is NULL!!!!!!");
+		CONSOLE_DEBUG("openCVimagePtr is NULL!!!!!!");
 	}
 	return(0);
 }
@@ -585,7 +1281,7 @@ int			quality[3] = {16, 200, 0};
 			strcat(imageFilePath, "/");
 			strcat(imageFilePath, imageFileName);
 
-			strcpy(cLastJpegImageName, imageFilePath);	//*	save the full image path for the web server
+			SetLastJpegImageName(imageFilePath);	//*	save the full image path for the web server
 			openCVerr	=	cvSaveImage(imageFilePath, cOpenCV_ImagePtr, quality);
 			if (openCVerr == 1)
 			{
@@ -610,7 +1306,7 @@ int			quality[3] = {16, 200, 0};
 			strcat(imageFilePath, "/");
 			strcat(imageFilePath, imageFileName);
 
-			strcpy(cLastJpegImageName, imageFilePath);	//*	save the full image path for the web server
+			SetLastJpegImageName(imageFilePath);	//*	save the full image path for the web server
 			openCVerr	=	cvSaveImage(imageFilePath, cOpenCV_ImagePtr, quality);
 			DEBUG_TIMING("Time to create PNG file=");
 			if (openCVerr == 1)
@@ -851,7 +1547,7 @@ int		imuRetCode;
 }
 
 //**************************************************************************
-void	CameraDriver::WriteIMUtextFile(void)
+void	CameraDriver::WriteIMUtextFile(TYPE_SaveFrame *saveFrame)
 {
 char	imageFileName[64];
 char	imageFilePath[128];
@@ -859,7 +1555,7 @@ FILE	*filePointer;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	strcpy(imageFileName, cFileNameRoot);
+	strcpy(imageFileName, saveFrame->fileNameRoot);
 	strcat(imageFileName, "-imu.txt");
 
 
@@ -870,38 +1566,38 @@ FILE	*filePointer;
 	if (filePointer != NULL)
 	{
 		fprintf(filePointer, "#using bno055 sensor\r\n");
-		fprintf(filePointer, "Image   =%s\r\n",		cFileNameRoot);
-		if (cIMU_EulerValid)
+		fprintf(filePointer, "Image   =%s\r\n",		saveFrame->fileNameRoot);
+		if (saveFrame->imuEulerValid)
 		{
-			fprintf(filePointer, "Heading =%3.5f\r\n",	cIMU_Heading);
-			fprintf(filePointer, "Roll    =%3.5f\r\n",	cIMU_Roll);
-			fprintf(filePointer, "Pitch   =%3.5f\r\n",	cIMU_Pitch);
+			fprintf(filePointer, "Heading =%3.5f\r\n",	saveFrame->imuHeading);
+			fprintf(filePointer, "Roll    =%3.5f\r\n",	saveFrame->imuRoll);
+			fprintf(filePointer, "Pitch   =%3.5f\r\n",	saveFrame->imuPitch);
 		}
 		else
 		{
 			fprintf(filePointer, "Error getting IMU data\r\n");
 		}
 
-		if (cIMU_QuatValid)
+		if (saveFrame->imuQuatValid)
 		{
-			fprintf(filePointer, "www   =%3.5f\r\n",	cIMU_www);
-			fprintf(filePointer, "xxx   =%3.5f\r\n",	cIMU_xxx);
-			fprintf(filePointer, "yyy   =%3.5f\r\n",	cIMU_yyy);
-			fprintf(filePointer, "zzz   =%3.5f\r\n",	cIMU_zzz);
+			fprintf(filePointer, "www   =%3.5f\r\n",	saveFrame->imuWWW);
+			fprintf(filePointer, "xxx   =%3.5f\r\n",	saveFrame->imuXXX);
+			fprintf(filePointer, "yyy   =%3.5f\r\n",	saveFrame->imuYYY);
+			fprintf(filePointer, "zzz   =%3.5f\r\n",	saveFrame->imuZZZ);
 		}
 		else
 		{
 			fprintf(filePointer, "Error getting IMU data\r\n");
 		}
 		fprintf(filePointer,	"IMU-Calibration values 0=uncalibrated 3 = fully calibrated\r\n");
-		fprintf(filePointer,	"IMU-Cal-Gyro   =%d\r\n",	cIMU_Cal_Gyro);
-		fprintf(filePointer,	"IMU-Cal-Acce   =%d\r\n",	cIMU_Cal_Acce);
-		fprintf(filePointer,	"IMU-Cal-Magn   =%d\r\n",	cIMU_Cal_Magn);
-		fprintf(filePointer,	"IMU-Cal-Syst   =%d\r\n",	cIMU_Cal_Syst);
+		fprintf(filePointer,	"IMU-Cal-Gyro   =%d\r\n",	saveFrame->imuCalGyro);
+		fprintf(filePointer,	"IMU-Cal-Acce   =%d\r\n",	saveFrame->imuCalAcce);
+		fprintf(filePointer,	"IMU-Cal-Magn   =%d\r\n",	saveFrame->imuCalMagn);
+		fprintf(filePointer,	"IMU-Cal-Syst   =%d\r\n",	saveFrame->imuCalSyst);
 
 		fclose(filePointer);
 
-		AddToDataProductsList(imageFileName, "IMU data");
+		SaveFrame_AddDataProduct(saveFrame, imageFileName, "IMU data");
 	}
 	else
 	{
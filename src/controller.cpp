@@ -115,6 +115,9 @@
 //*	Mar 21,	2024	<MLS> Added DrawWidgetTextBox_MonoSpace()
 //*	Mar 26,	2024	<MLS> Added RunFastBackgroundTasks()
 //*	Mar 27,	2024	<MLS> Added SetRunFastBackgroundMode()
+//*	Oct 18,	2026	<AGT> AlpacaGetStatus() now uses one request per poll when possible
+//*	Oct 18,	2026	<AGT> Poll interval now adapts to how fast the values are changing
+//*	Oct 18,	2026	<AGT> AlpacaGetStatus() no longer ignores a failed "connected" read
 //*****************************************************************************
 
 
@@ -439,6 +442,15 @@ char		myWindowName[128];
 	cContlerCreated_milliSecs	=	millis();
 	cLastUpdate_milliSecs		=	millis();
 	cUpdateDelta_secs			=	kDefaultUpdateDelta;	//*	update delay default value
+	cPollInterval_ms			=	kDefaultUpdateDelta * 1000;
+	cPollCycleCnt				=	0;
+	cPollValuesHash				=	0;
+	cPollPrevValuesHash			=	0;
+	cPollHashUpdated			=	false;
+	cPollChangedCnt				=	0;
+	cPollUnchangedCnt			=	0;
+	cPollDeviceStateDone		=	false;
+	cDeviceStateHandledCnt		=	0;
 	cDeviceStateTabNum			=	-1;
 	cDeviceStateNameStart		=	-1;
 	cDeviceStateValueStart		=	-1;
@@ -974,18 +986,35 @@ bool	Controller::AlpacaGetStatus_OneAAT(void)
 bool	Controller::AlpacaGetStatus(void)
 {
 bool	validData;
+bool	connectedValid;
 bool	previousOnLineState;
 
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, cWindowName);
 	previousOnLineState	=   cOnLine;
+	cPollCycleCnt++;
+	//*	one request per poll if at all possible
 	if (cHas_readall)
 	{
 		validData	=	AlpacaGetStatus_ReadAll(cAlpacaDeviceTypeStr, cAlpacaDevNum);
 	}
+	else if (cHas_DeviceState && cOnLine && (cDeviceStateHandledCnt > 0))
+	{
+		//*	devicestate has all of the operational values,
+		//*	the rest of the properties only need to be read once in a while
+		validData				=	AlpacaGetStatus_DeviceState();
+		cPollDeviceStateDone	=	true;
+		if (validData && ((cPollCycleCnt % kPollOneAATCycles) == 0))
+		{
+			connectedValid	=	AlpacaGetCommonConnectedState(cAlpacaDeviceTypeStr);
+			validData		=	AlpacaGetStatus_OneAAT();	//*	One At A Time
+			validData		=	(validData && connectedValid);
+		}
+	}
 	else
 	{
-		validData	=	AlpacaGetCommonConnectedState(cAlpacaDeviceTypeStr);
-		validData	=	AlpacaGetStatus_OneAAT();	//*	One At A Time
+		connectedValid	=	AlpacaGetCommonConnectedState(cAlpacaDeviceTypeStr);
+		validData		=	AlpacaGetStatus_OneAAT();	//*	One At A Time
+		validData		=	(validData && connectedValid);
 	}
 	GetStatus_SubClass();
 	if (validData)
@@ -999,6 +1028,11 @@ bool	previousOnLineState;
 	}
 	else
 	{
+		if (cOnLine)
+		{
+			//*	it may come back with a different driver, check what it supports again
+			AlpacaInvalidateEndPointCache();
+		}
 		cOnLine	=	false;
 	}
 	if (cOnLine != previousOnLineState)
@@ -1067,18 +1101,24 @@ void	Controller::RunBackgroundTasks(const char *callingFunction, bool enableDebu
 
 
 #ifdef _CONTROLLER_USES_ALPACA_
-uint32_t	deltaSeconds;
+uint32_t	deltaMillis;
 bool		validData;
 bool		needToUpdate;
 uint32_t	currentMillis;
 
 	needToUpdate	=	false;
 	currentMillis	=	millis();
-	deltaSeconds	=	(currentMillis - cLastUpdate_milliSecs) / 1000;
+	deltaMillis		=	currentMillis - cLastUpdate_milliSecs;
 
-	if ((deltaSeconds >= cUpdateDelta_secs) || cForceAlpacaUpdate)	//*	force update is set when a switch is clicked
+	if ((deltaMillis >= cPollInterval_ms) || cForceAlpacaUpdate)	//*	force update is set when a switch is clicked
 	{
 		needToUpdate		=	true;
+		if (cForceAlpacaUpdate)
+		{
+			//*	something was clicked, go back to the normal rate
+			cPollInterval_ms	=	cUpdateDelta_secs * 1000;
+			cPollUnchangedCnt	=	0;
+		}
 		cForceAlpacaUpdate	=	false;
 	}
 
@@ -1091,17 +1131,9 @@ uint32_t	currentMillis;
 		//*	is the IP address valid
 		if (cValidIPaddr)
 		{
-			//*	does this device have "DeviceState"
-			if (cOnLine && cHas_DeviceState)
-			{
-				validData	=	AlpacaGetStatus_DeviceState();
-			}
-//			else if (cAlpacaDeviceType != kDeviceType_Management)
-//			{
-//				CONSOLE_DEBUG_W_BOOL("cOnLine         \t=", cOnLine);
-//				CONSOLE_DEBUG_W_BOOL("cHas_DeviceState\t=", cHas_DeviceState);
-//				CONSOLE_DEBUG_W_BOOL("cValidIPaddr    \t=", cValidIPaddr);
-//			}
+			cPollValuesHash			=	0;
+			cPollHashUpdated		=	false;
+			cPollDeviceStateDone	=	false;
 			//----------------------------------
 			validData		=	AlpacaGetStatus();
 
@@ -1109,6 +1141,17 @@ uint32_t	currentMillis;
 			{
 			//	CONSOLE_DEBUG("Failed to get data");
 			}
+			//*	readall already has everything, devicestate is only needed
+			//*	if it was not used above or its tab is being displayed
+			if (cOnLine && cHas_DeviceState && (cPollDeviceStateDone == false))
+			{
+				if ((cHas_readall == false) ||
+					((cDeviceStateTabNum > 0) && (cCurrentTabNum == cDeviceStateTabNum)))
+				{
+					validData	=	AlpacaGetStatus_DeviceState();
+				}
+			}
+			AlpacaUpdatePollInterval();
 //			CONSOLE_DEBUG("Calling UpdateStatusData()");
 			UpdateStatusData();
 			UpdateConnectedStatusIndicator();
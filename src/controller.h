@@ -2,6 +2,7 @@
 //*****************************************************************************
 //*	Dec  7,	2022	<MLS> Changed kDefaultUpdateDelta from 4 to 5 (seconds)
 //*	Dec 20,	2022	<MLS> Added cHas_temperaturelog
+//*	Oct 18,	2026	<AGT> Added adaptive status poll interval (cPollInterval_ms)
 //*****************************************************************************
 
 //#include	"controller.h"
@@ -79,6 +80,13 @@
 //#define	kButtonCnt	30
 
 #define	kDefaultUpdateDelta	5
+
+//*	status poll engine
+#define	kPollMinInterval_ms		1000	//*	never poll faster than this, even when things are changing
+#define	kPollIdleMax_ms			30000	//*	idle polls slow down to this at the most
+#define	kPollIdleMultiplier		4		//*	or this times the normal rate, whichever is less
+#define	kPollIdleCycles			3		//*	number of unchanged polls before slowing down
+#define	kPollOneAATCycles		6		//*	with devicestate only, the rest gets read every Nth poll
 #define	kLineBufSize		512
 
 //*****************************************************************************
@@ -411,6 +419,18 @@ class Controller
 		uint32_t			cLastUpdate_milliSecs;
 		uint32_t			cUpdateDelta_secs;		//*	time between updates for this controller
 
+		//*	status poll engine, cUpdateDelta_secs is the normal rate,
+		//*	the actual interval adapts to how fast the values are changing
+		uint32_t			cPollInterval_ms;
+		uint32_t			cPollCycleCnt;
+		uint32_t			cPollValuesHash;		//*	hash of the values returned this poll cycle
+		uint32_t			cPollPrevValuesHash;
+		bool				cPollHashUpdated;
+		int					cPollChangedCnt;
+		int					cPollUnchangedCnt;
+		bool				cPollDeviceStateDone;
+		int					cDeviceStateHandledCnt;	//*	entries processed by the last devicestate read
+
 		//*	alpacapi extra information
 		char				cRemote_Platform[128];
 		char				cRemote_CPUinfo[128];
@@ -467,6 +487,9 @@ class Controller
 															bool			reportError=false);
 
 				bool	AlpacaCheckForDeviceState(void);
+				void	AlpacaInvalidateEndPointCache(void);
+				void	AlpacaPollHashValue(const char *keywordString, const char *valueString);
+				void	AlpacaUpdatePollInterval(void);
 				bool	AlpacaGetStatus_DeviceState(void);
 				bool	AlpacaGetStatus_DeviceState(	const char	*deviceTypeStr,
 														const int deviceNum);
@@ -58,6 +58,9 @@
 //*	Jul  1,	2023	<MLS> Added SetCommandLookupTable() with TYPE_CmdEntry
 //*	Jul  1,	2023	<MLS> Added LookupCmdInCmdTable()
 //*	Jul  1,	2023	<MLS> Added SetAlternateLookupTable()
+//*	Oct 18,	2026	<AGT> Added end point cache, supportedactions/devicestate only get asked once
+//*	Oct 18,	2026	<AGT> Added AlpacaPollHashValue() and AlpacaUpdatePollInterval()
+//*	Oct 18,	2026	<AGT> Fixed devicestate command table lookup using "VALUE" instead of the name
 //*****************************************************************************
 
 #ifdef _CONTROLLER_USES_ALPACA_
@@ -68,6 +71,7 @@
 #include	<unistd.h>
 #include	<sys/time.h>
 #include	<errno.h>
+#include	<pthread.h>
 
 
 
@@ -91,6 +95,267 @@ static uint32_t		gClientTransactionID	=	1;
 #include	"common_AlpacaCmds.h"
 #include	"common_AlpacaCmds.cpp"
 
+//*****************************************************************************
+//*	End point cache
+//*	supportedactions and devicestate support do not change while a device is on line,
+//*	this keeps every window that talks to the same device from asking again.
+//*****************************************************************************
+#define	kMaxEndPointCache			64
+#define	kEndPointActionsBuffLen		1024
+
+typedef struct
+{
+	in_addr_t	ipAddress;
+	int			port;
+	int			deviceNum;
+	char		deviceTypeStr[48];
+	bool		supportedActionsValid;
+	char		supportedActions[kEndPointActionsBuffLen];	//*	comma separated list
+	int			deviceStateStatus;							//*	-1 = unknown, 0 = no, 1 = yes
+} TYPE_EndPointCache;
+
+static TYPE_EndPointCache	gEndPointCache[kMaxEndPointCache];
+static int					gEndPointCacheCnt		=	0;
+static pthread_mutex_t		gEndPointCacheMutex		=	PTHREAD_MUTEX_INITIALIZER;
+
+//*****************************************************************************
+//*	must be called with the mutex locked, returns NULL if the table is full
+//*****************************************************************************
+static TYPE_EndPointCache	*EndPointCache_Find(sockaddr_in	*deviceAddress,
+												const int	devicePort,
+												const char	*deviceTypeStr,
+												const int	deviceNum,
+												const bool	createEntry)
+{
+TYPE_EndPointCache	*cacheEntry;
+int					iii;
+
+	cacheEntry	=	NULL;
+	for (iii=0; (iii < gEndPointCacheCnt) && (cacheEntry == NULL); iii++)
+	{
+		if ((gEndPointCache[iii].ipAddress == deviceAddress->sin_addr.s_addr) &&
+			(gEndPointCache[iii].port == devicePort) &&
+			(gEndPointCache[iii].deviceNum == deviceNum) &&
+			(strcasecmp(gEndPointCache[iii].deviceTypeStr, deviceTypeStr) == 0))
+		{
+			cacheEntry	=	&gEndPointCache[iii];
+		}
+	}
+	if ((cacheEntry == NULL) && createEntry && (gEndPointCacheCnt < kMaxEndPointCache))
+	{
+		cacheEntry	=	&gEndPointCache[gEndPointCacheCnt];
+		memset(cacheEntry, 0, sizeof(TYPE_EndPointCache));
+		cacheEntry->ipAddress			=	deviceAddress->sin_addr.s_addr;
+		cacheEntry->port				=	devicePort;
+		cacheEntry->deviceNum			=	deviceNum;
+		cacheEntry->deviceStateStatus	=	-1;
+		strncpy(cacheEntry->deviceTypeStr, deviceTypeStr, (sizeof(cacheEntry->deviceTypeStr) - 1));
+		gEndPointCacheCnt++;
+	}
+	return(cacheEntry);
+}
+
+//*****************************************************************************
+//*	copies the cached supportedactions list, returns false if it is not known yet
+//*****************************************************************************
+static bool	EndPointCache_GetActions(	sockaddr_in	*deviceAddress,
+										const int	devicePort,
+										const char	*deviceTypeStr,
+										const int	deviceNum,
+										char		*actionsList)
+{
+TYPE_EndPointCache	*cacheEntry;
+bool				foundIt;
+
+	foundIt	=	false;
+	pthread_mutex_lock(&gEndPointCacheMutex);
+	cacheEntry	=	EndPointCache_Find(deviceAddress, devicePort, deviceTypeStr, deviceNum, false);
+	if ((cacheEntry != NULL) && cacheEntry->supportedActionsValid)
+	{
+		strcpy(actionsList, cacheEntry->supportedActions);
+		foundIt	=	true;
+	}
+	pthread_mutex_unlock(&gEndPointCacheMutex);
+	return(foundIt);
+}
+
+//*****************************************************************************
+static void	EndPointCache_SetActions(	sockaddr_in	*deviceAddress,
+										const int	devicePort,
+										const char	*deviceTypeStr,
+										const int	deviceNum,
+										const char	*actionsList)
+{
+TYPE_EndPointCache	*cacheEntry;
+
+	pthread_mutex_lock(&gEndPointCacheMutex);
+	cacheEntry	=	EndPointCache_Find(deviceAddress, devicePort, deviceTypeStr, deviceNum, true);
+	if (cacheEntry != NULL)
+	{
+		strncpy(cacheEntry->supportedActions, actionsList, (kEndPointActionsBuffLen - 1));
+		cacheEntry->supportedActions[kEndPointActionsBuffLen - 1]	=	0;
+		cacheEntry->supportedActionsValid							=	true;
+		//*	if it is listed, we know it is there
+		if (strcasestr(actionsList, "devicestate") != NULL)
+		{
+			cacheEntry->deviceStateStatus	=	1;
+		}
+	}
+	pthread_mutex_unlock(&gEndPointCacheMutex);
+}
+
+//*****************************************************************************
+static int	EndPointCache_GetDeviceState(	sockaddr_in	*deviceAddress,
+											const int	devicePort,
+											const char	*deviceTypeStr,
+											const int	deviceNum)
+{
+TYPE_EndPointCache	*cacheEntry;
+int					deviceStateStatus;
+
+	deviceStateStatus	=	-1;
+	pthread_mutex_lock(&gEndPointCacheMutex);
+	cacheEntry	=	EndPointCache_Find(deviceAddress, devicePort, deviceTypeStr, deviceNum, false);
+	if (cacheEntry != NULL)
+	{
+		deviceStateStatus	=	cacheEntry->deviceStateStatus;
+	}
+	pthread_mutex_unlock(&gEndPointCacheMutex);
+	return(deviceStateStatus);
+}
+
+//*****************************************************************************
+static void	EndPointCache_SetDeviceState(	sockaddr_in	*deviceAddress,
+											const int	devicePort,
+											const char	*deviceTypeStr,
+											const int	deviceNum,
+											const bool	hasDeviceState)
+{
+TYPE_EndPointCache	*cacheEntry;
+
+	pthread_mutex_lock(&gEndPointCacheMutex);
+	cacheEntry	=	EndPointCache_Find(deviceAddress, devicePort, deviceTypeStr, deviceNum, true);
+	if (cacheEntry != NULL)
+	{
+		cacheEntry->deviceStateStatus	=	hasDeviceState ? 1 : 0;
+	}
+	pthread_mutex_unlock(&gEndPointCacheMutex);
+}
+
+//*****************************************************************************
+void	Controller::AlpacaInvalidateEndPointCache(void)
+{
+TYPE_EndPointCache	*cacheEntry;
+
+	pthread_mutex_lock(&gEndPointCacheMutex);
+	cacheEntry	=	EndPointCache_Find(&cDeviceAddress, cPort, cAlpacaDeviceTypeStr, cAlpacaDevNum, false);
+	if (cacheEntry != NULL)
+	{
+		cacheEntry->supportedActionsValid	=	false;
+		cacheEntry->deviceStateStatus		=	-1;
+	}
+	pthread_mutex_unlock(&gEndPointCacheMutex);
+}
+
+//*****************************************************************************
+//*	these change on every response and would make it look like something is moving
+static const char	*gPollVolatileKeys[]	=
+{
+	"ClientTransactionID",
+	"ServerTransactionID",
+	"UTCDATE",
+	"TimeStamp",
+	NULL
+};
+
+//*****************************************************************************
+//*	adds one keyword/value pair to the hash for this poll cycle
+//*****************************************************************************
+void	Controller::AlpacaPollHashValue(const char *keywordString, const char *valueString)
+{
+int			iii;
+uint32_t	hashValue;
+bool		volatileKey;
+
+	volatileKey	=	false;
+	iii			=	0;
+	while ((gPollVolatileKeys[iii] != NULL) && (volatileKey == false))
+	{
+		volatileKey	=	(strcasecmp(keywordString, gPollVolatileKeys[iii]) == 0);
+		iii++;
+	}
+	if (volatileKey == false)
+	{
+		//*	FNV-1a
+		hashValue	=	cPollValuesHash ^ 2166136261u;
+		while (*keywordString != 0)
+		{
+			hashValue	=	(hashValue ^ (uint8_t)*keywordString++) * 16777619u;
+		}
+		while (*valueString != 0)
+		{
+			hashValue	=	(hashValue ^ (uint8_t)*valueString++) * 16777619u;
+		}
+		cPollValuesHash		=	hashValue;
+		cPollHashUpdated	=	true;
+	}
+}
+
+//*****************************************************************************
+//*	called after each poll cycle
+//*	values changing two polls in a row speeds up to half the normal rate,
+//*	nothing changing for a while slows down gradually
+//*****************************************************************************
+void	Controller::AlpacaUpdatePollInterval(void)
+{
+uint32_t	normal_ms;
+uint32_t	fast_ms;
+uint32_t	idle_ms;
+
+	normal_ms	=	cUpdateDelta_secs * 1000;
+	fast_ms		=	normal_ms / 2;
+	if (fast_ms < kPollMinInterval_ms)
+	{
+		fast_ms	=	(normal_ms < kPollMinInterval_ms) ? normal_ms : kPollMinInterval_ms;
+	}
+	idle_ms		=	normal_ms * kPollIdleMultiplier;
+	if (idle_ms > kPollIdleMax_ms)
+	{
+		idle_ms	=	(normal_ms > kPollIdleMax_ms) ? normal_ms : kPollIdleMax_ms;
+	}
+
+	if (cPollHashUpdated == false)
+	{
+		//*	nothing to compare (One At A Time), stay at the normal rate
+		cPollInterval_ms	=	normal_ms;
+	}
+	else if (cPollValuesHash != cPollPrevValuesHash)
+	{
+		cPollChangedCnt++;
+		cPollUnchangedCnt	=	0;
+		cPollInterval_ms	=	(cPollChangedCnt >= 2) ? fast_ms : normal_ms;
+	}
+	else
+	{
+		cPollChangedCnt	=	0;
+		cPollUnchangedCnt++;
+		if (cPollUnchangedCnt >= kPollIdleCycles)
+		{
+			cPollInterval_ms	=	(cPollInterval_ms * 3) / 2;
+		}
+	}
+	//*	the subclass may have changed cUpdateDelta_secs, keep it in range
+	if (cPollInterval_ms < fast_ms)
+	{
+		cPollInterval_ms	=	fast_ms;
+	}
+	if (cPollInterval_ms > idle_ms)
+	{
+		cPollInterval_ms	=	idle_ms;
+	}
+	cPollPrevValuesHash	=	cPollValuesHash;
+}
+
 //*****************************************************************************
 void	Controller::SetCommandLookupTable(TYPE_CmdEntry *newLookupTable)
 {
@@ -448,6 +713,11 @@ SJP_Parser_t	jsonParser;
 bool			validData;
 char			alpacaString[128];
 int				jjj;
+char			actionsList[kEndPointActionsBuffLen];
+char			*actionPtr;
+char			*nextActionPtr;
+int				actionsLen;
+int				valueLen;
 
 	if (gVerbose)
 	{
@@ -461,52 +731,90 @@ int				jjj;
 		CONSOLE_DEBUG_W_NUM("deviceNum=", deviceNum);
 	}
 
-	//===============================================================
-	//*	get supportedactions
-	SJP_Init(&jsonParser);
-//	CONSOLE_DEBUG("Dumping EMPTY Json parser");
-//	SJP_DumpJsonData(&jsonParser);
-//	CONSOLE_DEBUG_W_NUM("tokenCount_Data\t=", jsonParser.tokenCount_Data);
-	sprintf(alpacaString,	"/api/v1/%s/%d/supportedactions", deviceTypeStr, deviceNum);
-	validData	=	GetJsonResponse(	deviceAddress,
-										devicePort,
-										alpacaString,
-										NULL,
-										&jsonParser);
-	if (validData)
+	//*	has this device already been asked by this or another window
+	if (EndPointCache_GetActions(deviceAddress, devicePort, deviceTypeStr, deviceNum, actionsList))
 	{
-		jjj	=	0;
-		while (jjj < jsonParser.tokenCount_Data)
+		actionPtr	=	actionsList;
+		while (*actionPtr != 0)
 		{
-//			if (strcmp(deviceTypeStr, "dome") == 0)
-//			{
-//				CONSOLE_DEBUG_W_NUM("jjj\t=", jjj);
-//				CONSOLE_DEBUG_W_2STR("kw:val=", jsonParser.dataList[jjj].keyword,
-//												jsonParser.dataList[jjj].valueString);
-//			}
-			if (strcasecmp(jsonParser.dataList[jjj].keyword, "ARRAY") == 0)
+			nextActionPtr	=	strchr(actionPtr, ',');
+			if (nextActionPtr != NULL)
 			{
-				jjj++;	//*	skip over the ARRAY entry
-
-//				CONSOLE_DEBUG_W_NUM("ARRAY found, jjj\t=", jjj);
-//				CONSOLE_DEBUG_W_STR("keyword\t=", jsonParser.dataList[jjj].keyword);
-				while ((jjj < jsonParser.tokenCount_Data) &&
-						(jsonParser.dataList[jjj].keyword[0] != ']'))
-				{
-//					CONSOLE_DEBUG_W_STR("Calling AlpacaProcessSupportedActions", deviceTypeStr);
-					AlpacaProcessSupportedActions(	deviceTypeStr,
-													deviceNum,
-													jsonParser.dataList[jjj].valueString);
-					jjj++;
-				}
+				*nextActionPtr	=	0;
+				nextActionPtr++;
+			}
+			else
+			{
+				nextActionPtr	=	actionPtr + strlen(actionPtr);
 			}
-			jjj++;
+			AlpacaProcessSupportedActions(deviceTypeStr, deviceNum, actionPtr);
+			actionPtr	=	nextActionPtr;
 		}
+		validData	=	true;
 	}
 	else
 	{
-		CONSOLE_DEBUG("Read failure - supportedactions");
-		cReadFailureCnt++;
+		//===============================================================
+		//*	get supportedactions
+		actionsList[0]	=	0;
+		actionsLen		=	0;
+		SJP_Reset(&jsonParser);
+//		CONSOLE_DEBUG("Dumping EMPTY Json parser");
+//		SJP_DumpJsonData(&jsonParser);
+//		CONSOLE_DEBUG_W_NUM("tokenCount_Data\t=", jsonParser.tokenCount_Data);
+		sprintf(alpacaString,	"/api/v1/%s/%d/supportedactions", deviceTypeStr, deviceNum);
+		validData	=	GetJsonResponse(	deviceAddress,
+											devicePort,
+											alpacaString,
+											NULL,
+											&jsonParser);
+		if (validData)
+		{
+			jjj	=	0;
+			while (jjj < jsonParser.tokenCount_Data)
+			{
+//				if (strcmp(deviceTypeStr, "dome") == 0)
+//				{
+//					CONSOLE_DEBUG_W_NUM("jjj\t=", jjj);
+//					CONSOLE_DEBUG_W_2STR("kw:val=", jsonParser.dataList[jjj].keyword,
+//													jsonParser.dataList[jjj].valueString);
+//				}
+				if (strcasecmp(jsonParser.dataList[jjj].keyword, "ARRAY") == 0)
+				{
+					jjj++;	//*	skip over the ARRAY entry
+
+//					CONSOLE_DEBUG_W_NUM("ARRAY found, jjj\t=", jjj);
+//					CONSOLE_DEBUG_W_STR("keyword\t=", jsonParser.dataList[jjj].keyword);
+					while ((jjj < jsonParser.tokenCount_Data) &&
+							(jsonParser.dataList[jjj].keyword[0] != ']'))
+					{
+//						CONSOLE_DEBUG_W_STR("Calling AlpacaProcessSupportedActions", deviceTypeStr);
+						AlpacaProcessSupportedActions(	deviceTypeStr,
+														deviceNum,
+														jsonParser.dataList[jjj].valueString);
+						//*	save the list for the next time
+						valueLen	=	strlen(jsonParser.dataList[jjj].valueString);
+						if ((valueLen > 0) && ((actionsLen + valueLen + 2) < kEndPointActionsBuffLen))
+						{
+							if (actionsLen > 0)
+							{
+								actionsList[actionsLen++]	=	',';
+							}
+							strcpy(&actionsList[actionsLen], jsonParser.dataList[jjj].valueString);
+							actionsLen	+=	valueLen;
+						}
+						jjj++;
+					}
+				}
+				jjj++;
+			}
+			EndPointCache_SetActions(deviceAddress, devicePort, deviceTypeStr, deviceNum, actionsList);
+		}
+		else
+		{
+			CONSOLE_DEBUG("Read failure - supportedactions");
+			cReadFailureCnt++;
+		}
 	}
 //	CONSOLE_DEBUG(__FUNCTION__);
 	return(validData);
@@ -636,7 +944,7 @@ int				notHandledCnt;
 	CONSOLE_DEBUG_W_STR("Requesting 'readall' for", deviceTypeStr);
 #endif
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/readall", deviceTypeStr, deviceNum);
 	validData	=	GetJsonResponse(	deviceAddress,
 										devicePort,
@@ -666,6 +974,8 @@ int				notHandledCnt;
 			//*	check for valid string
 			if (strlen(jsonParser.dataList[jjj].keyword) > 0)
 			{
+				//*	this is how the poll engine tells if anything is changing
+				AlpacaPollHashValue(jsonParser.dataList[jjj].keyword, jsonParser.dataList[jjj].valueString);
 				//*	special debugging
 //				if (cAlpacaDeviceType == kDeviceType_Telescope)
 //				{
@@ -927,7 +1237,7 @@ int			dataStrLen;
 
 	if (jsonParser  != NULL)
 	{
-		SJP_Init(jsonParser);
+		SJP_Reset(jsonParser);
 
 		sprintf(alpacaString, "/api/v1/%s/%d/%s", alpacaDevice, alpacaDevNum, alpacaCmd);
 
@@ -1050,7 +1360,7 @@ bool			myReturnDataIsValid	=	true;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, alpacaDevNum, alpacaCmd);
 //	CONSOLE_DEBUG_W_STR("alpacaString\t=",	alpacaString);
 
@@ -1111,7 +1421,7 @@ int				jjj;
 bool			myReturnDataIsValid	=	true;
 
 	//*	set the default valid data flag to TRUE
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, cAlpacaDevNum, alpacaCmd);
 	if (gVerbose)
 	{
@@ -1187,7 +1497,7 @@ int				jjj;
 bool			myReturnDataIsValid	=	true;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, cAlpacaDevNum, alpacaCmd);
 
 	validData	=	GetJsonResponse(	&deviceAddress,
@@ -1245,7 +1555,7 @@ int				jjj;
 bool			myReturnDataIsValid	=	true;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, cAlpacaDevNum, alpacaCmd);
 
 //	Set_SendRequestLibDebug(true);
@@ -1312,7 +1622,7 @@ double			myDoubleValue;
 bool			myReturnDataIsValid	=	true;
 
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, alpacaDevNum, alpacaCmd);
 //	CONSOLE_DEBUG_W_STR("alpacaString\t=",	alpacaString);
 	validData	=	GetJsonResponse(	&deviceAddress,
@@ -1402,7 +1712,7 @@ double			myDoubleValue;
 bool			myReturnDataIsValid	=	true;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, cAlpacaDevNum, alpacaCmd);
 
 	validData	=	GetJsonResponse(	&cDeviceAddress,
@@ -1472,7 +1782,7 @@ bool			myBooleanValue;
 bool			myReturnDataIsValid	=	true;
 
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, alpacaDevNum, alpacaCmd);
 	if (gVerbose)
 	{
@@ -1545,7 +1855,7 @@ bool			myBooleanValue;
 bool			myReturnDataIsValid	=	true;
 
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", alpacaDevice, cAlpacaDevNum, alpacaCmd);
 	if (printDebug)
 	{
@@ -1716,7 +2026,7 @@ char			alpacaString[128];
 	//*	 if it has readall, then it has cpustats
 	if (cHas_readall)
 	{
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		//	http://wo102:6800/api/v1/management/0/cpustats
 		sprintf(alpacaString,	"/api/v1/management/%d/cpustats", 0);	//*	the device number for management is always 0
 
@@ -2089,7 +2399,7 @@ int				jjj;
 
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, cWindowName);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	validData	=	GetJsonResponse(	&cDeviceAddress,
 										cPort,
 										"/management/v1/configureddevices",
@@ -2117,28 +2427,40 @@ bool	Controller::AlpacaCheckForDeviceState(void)
 SJP_Parser_t	jsonParser;
 char			alpacaString[128];
 bool			validData;
+int				deviceStateStatus;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	SJP_Init(&jsonParser);
-	sprintf(alpacaString,	"/api/v1/%s/%d/devicestate", cAlpacaDeviceTypeStr, cAlpacaDevNum);
+	deviceStateStatus	=	EndPointCache_GetDeviceState(&cDeviceAddress, cPort, cAlpacaDeviceTypeStr, cAlpacaDevNum);
+	if (deviceStateStatus >= 0)
+	{
+		//*	we already know the answer
+		cHas_DeviceState	=	(deviceStateStatus > 0);
+	}
+	else
+	{
+		SJP_Reset(&jsonParser);
+		sprintf(alpacaString,	"/api/v1/%s/%d/devicestate", cAlpacaDeviceTypeStr, cAlpacaDevNum);
 
-	CONSOLE_DEBUG_W_STR("cAlpacaDeviceTypeStr\t=", cAlpacaDeviceTypeStr);
-	CONSOLE_DEBUG_W_NUM("cAlpacaDevNum        \t=", cAlpacaDevNum);
-	CONSOLE_DEBUG(alpacaString);
+		CONSOLE_DEBUG_W_STR("cAlpacaDeviceTypeStr\t=", cAlpacaDeviceTypeStr);
+		CONSOLE_DEBUG_W_NUM("cAlpacaDevNum        \t=", cAlpacaDevNum);
+		CONSOLE_DEBUG(alpacaString);
 
-	validData	=	GetJsonResponse(	&cDeviceAddress,
-										cPort,
-										alpacaString,
-										NULL,
-										&jsonParser);
-	if (validData)
-	{
-//		SJP_DumpJsonData(&jsonParser, __FUNCTION__);
-		cLastAlpacaErrNum	=	AlpacaCheckForErrors(&jsonParser, cLastAlpacaErrStr, true);
-		CONSOLE_DEBUG_W_NUM("devicestate returned: cLastAlpacaErrNum\t=", cLastAlpacaErrNum);
-		if (cLastAlpacaErrNum == kASCOM_Err_Success)
+		validData	=	GetJsonResponse(	&cDeviceAddress,
+											cPort,
+											alpacaString,
+											NULL,
+											&jsonParser);
+		if (validData)
 		{
-			cHas_DeviceState	=	true;
+//			SJP_DumpJsonData(&jsonParser, __FUNCTION__);
+			cLastAlpacaErrNum	=	AlpacaCheckForErrors(&jsonParser, cLastAlpacaErrStr, true);
+			CONSOLE_DEBUG_W_NUM("devicestate returned: cLastAlpacaErrNum\t=", cLastAlpacaErrNum);
+			if (cLastAlpacaErrNum == kASCOM_Err_Success)
+			{
+				cHas_DeviceState	=	true;
+			}
+			//*	only remember the answer if the device responded
+			EndPointCache_SetDeviceState(&cDeviceAddress, cPort, cAlpacaDeviceTypeStr, cAlpacaDevNum, cHas_DeviceState);
 		}
 	}
 	CONSOLE_DEBUG_W_BOOL("cHas_DeviceState   \t=",	cHas_DeviceState);
@@ -2161,17 +2483,18 @@ int				jjj;
 bool			foundName;
 bool			foundValue;
 char			nameString[64];
-char			valueString[128];
+char			valueString[kSJP_MaxValueLen];
 int				valuePairIdx;
 int				keywordEnum;
 bool			dataWasHandled;
+int				handledCnt;
 
 //	CONSOLE_DEBUG(cWindowName);
 //	CONSOLE_DEBUG_W_STR("Requesting 'DeviceState' for", deviceTypeStr);
 //	CONSOLE_DEBUG_W_NUM("on port                     ", devicePort);
 //	CONSOLE_DEBUG_W_BOOL("enableDebug                ", enableDebug);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/devicestate", deviceTypeStr, deviceNum);
 //	CONSOLE_DEBUG_W_STR("alpacaString\t=", alpacaString);
 
@@ -2190,6 +2513,7 @@ bool			dataWasHandled;
 		foundName		=	false;
 		foundValue		=	false;
 		valuePairIdx	=	0;
+		handledCnt		=	0;
 		cLastAlpacaErrNum	=	kASCOM_Err_Success;
 		for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
 		{
@@ -2211,31 +2535,38 @@ bool			dataWasHandled;
 			}
 			if (foundName && foundValue)
 			{
+				AlpacaPollHashValue(nameString, valueString);
+				dataWasHandled	=	false;
 				//*	is the command table present
 				if (cCommandEntryPtr != NULL)
 				{
-					keywordEnum	=	LookupCmdInCmdTable(jsonParser.dataList[jjj].keyword, cCommandEntryPtr);
+					//*	look up the name, not the "VALUE" keyword
+					keywordEnum	=	LookupCmdInCmdTable(nameString, cCommandEntryPtr);
 					if (keywordEnum >= 0)
 					{
 						dataWasHandled	=	AlpacaProcessReadAllIdx(deviceTypeStr,
 																	deviceNum,
 																	keywordEnum,
-																	jsonParser.dataList[jjj].valueString);
+																	valueString);
 						if (dataWasHandled == false)
 						{
-							CONSOLE_DEBUG_W_STR("NOT HANDLED", jsonParser.dataList[jjj].keyword);
+							CONSOLE_DEBUG_W_STR("NOT HANDLED", nameString);
 						}
 					}
 				}
 				else
 				{
 	//				CONSOLE_DEBUG_W_STR(nameString, valueString);
-					AlpacaProcessReadAll(	deviceTypeStr,
-											deviceNum,
-											nameString,
-											valueString);
+					dataWasHandled	=	AlpacaProcessReadAll(	deviceTypeStr,
+															deviceNum,
+															nameString,
+															valueString);
 
 				}
+				if (dataWasHandled)
+				{
+					handledCnt++;
+				}
 				//*	this will allow the controller to update the DeviceState window if it wants to
 				UpdateDeviceStateEntry(valuePairIdx, nameString, valueString);
 				valuePairIdx++;
@@ -2244,6 +2575,8 @@ bool			dataWasHandled;
 				foundValue	=	false;
 			}
 		}
+		//*	if nothing was handled, the poll engine can not rely on devicestate for this controller
+		cDeviceStateHandledCnt	=	handledCnt;
 	}
 	else
 	{
@@ -26,6 +26,9 @@
 //*	May 18,	2022	<MLS> Added AlpacaGetImageArray_Binary_Int32()
 //*	Feb 19,	2023	<MLS> Added AlpacaGetImageArray_Binary_Int16()
 //*	Feb 19,	2023	<MLS> Changed byte order in 32 bit integer image read
+//*	Oct 18,	2026	<AGT> Decoding directly into the openCV image, no more TYPE_ImageArray
+//*	Oct 18,	2026	<AGT> Added AlpacaGetImageArray_BinaryBulk(), one buffer, large reads, single pass convert
+//*	Oct 18,	2026	<AGT> Int32 and JSON downloads are kept at 16 bits when the data needs it
 //*****************************************************************************
 
 #include	<string.h>
@@ -52,6 +55,8 @@
 #include	"controller_camera.h"
 
 #define		kImageArrayBuffSize	15000
+#define		kBulkRecvChunkSize	(1024L * 1024L)	//*	bytes per recv() in the ImageBytes bulk download
+#define		kBulkStripWidth		32				//*	columns converted together
 
 
 
@@ -455,42 +460,282 @@ int		byte2;
 #endif // 0
 
 //*****************************************************************************
-void	ControllerCamera::AlpacaGetImageArray_Binary_Byte(	TYPE_ImageArray	*imageArray,
-															int				imageArrayLen)
+//*	the data values are 16 bits unless useLowByte is set
+//*****************************************************************************
+static inline int	DownloadValueTo8Bit(TYPE_ImageDownloadBuf *dlBuf, const int dataValue)
+{
+	return(dlBuf->useLowByte ? (dataValue & 0x00ff) : ((dataValue >> 8) & 0x00ff));
+}
+
+//*****************************************************************************
+//*	stepping DOWN the column, then ACROSS the field
+//*****************************************************************************
+static inline void	NextDownloadPixel(TYPE_ImageDownloadBuf *dlBuf)
+{
+	if (dlBuf->xxx < dlBuf->width)
+	{
+		dlBuf->yyy++;
+		dlBuf->pixelPtr	+=	dlBuf->rowStride;
+		if (dlBuf->yyy >= dlBuf->height)
+		{
+			dlBuf->yyy		=	0;
+			dlBuf->xxx++;
+			dlBuf->pixelPtr	=	dlBuf->pixelData + (dlBuf->xxx * dlBuf->bytesPerPixel);
+		}
+	}
+}
+
+//*****************************************************************************
+//*	rgbIdx 0=red, 1=green, 2=blue, the pixel is NOT advanced
+//*****************************************************************************
+static inline void	StoreColorValue(TYPE_ImageDownloadBuf *dlBuf, const int rgbIdx, const int dataValue)
+{
+	if ((dlBuf->xxx < dlBuf->width) && (rgbIdx >= 0) && (rgbIdx < 3))
+	{
+		switch(dlBuf->bytesPerPixel)
+		{
+			case 1:
+				if (rgbIdx == 1)
+				{
+					dlBuf->pixelPtr[0]	=	DownloadValueTo8Bit(dlBuf, dataValue);
+				}
+				break;
+
+			case 2:
+				if (rgbIdx == 0)
+				{
+					*((uint16_t *)dlBuf->pixelPtr)	=	dataValue & 0x00ffff;
+				}
+				break;
+
+			case 3:
+				//*	openCV uses BGR instead of RGB
+				//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
+				dlBuf->pixelPtr[2 - rgbIdx]	=	DownloadValueTo8Bit(dlBuf, dataValue);
+				break;
+		}
+	}
+}
+
+//*****************************************************************************
+//*	stores the value and advances to the next pixel
+//*****************************************************************************
+static inline void	StoreMonoValue(TYPE_ImageDownloadBuf *dlBuf, const int dataValue)
+{
+int		pixValue;
+
+	if (dlBuf->xxx < dlBuf->width)
+	{
+		if (dataValue > dlBuf->maxValue)
+		{
+			dlBuf->maxValue	=	dataValue;
+		}
+		switch(dlBuf->bytesPerPixel)
+		{
+			case 1:
+				dlBuf->pixelPtr[0]	=	DownloadValueTo8Bit(dlBuf, dataValue);
+				break;
+
+			case 2:
+				*((uint16_t *)dlBuf->pixelPtr)	=	dataValue & 0x00ffff;
+				break;
+
+			case 3:
+				pixValue			=	DownloadValueTo8Bit(dlBuf, dataValue);
+				dlBuf->pixelPtr[0]	=	pixValue;
+				dlBuf->pixelPtr[1]	=	pixValue;
+				dlBuf->pixelPtr[2]	=	pixValue;
+				break;
+		}
+		NextDownloadPixel(dlBuf);
+	}
+}
+
+//*****************************************************************************
+//*	Creates the image the data is downloaded into, the smallest format that
+//*	holds the data is used, 8 bit mono, 16 bit mono or 24 bit color.
+//*	Binary data goes by the TransmissionElementType, anything wider than a byte
+//*	is 16 bit (the ASCOM standard is Int32).
+//*	JSON does not say, MaxADU is used if the camera reported it, otherwise
+//*	it is 16 bit and ReduceDownloadImage() drops it to 8 bit if the values fit.
+//*	Called once the rank and data type are known
+//*****************************************************************************
+bool	ControllerCamera::CreateDownloadImage(const int imgRank, const bool binaryData)
+{
+int		imgWidth;
+int		imgHeight;
+int		bytesPerPixel;
+bool	useLowByte;
+bool	imageOK;
+
+	useLowByte	=	cDownloadBuf.useLowByte;
+	ReleaseDownloadImage();
+
+	imageOK		=	false;
+	imgWidth	=	cCameraProp.CameraXsize;
+	imgHeight	=	cCameraProp.CameraYsize;
+	if ((cBinaryImageHdr.Dimension1 > 0) && (cBinaryImageHdr.Dimension2 > 0))
+	{
+		imgWidth	=	cBinaryImageHdr.Dimension1;
+		imgHeight	=	cBinaryImageHdr.Dimension2;
+	}
+
+	if (imgRank == 3)
+	{
+		bytesPerPixel	=	3;
+	}
+	else if (useLowByte)
+	{
+		//*	the caller asked for 8 bit
+		bytesPerPixel	=	1;
+	}
+	else if (binaryData)
+	{
+		switch(cBinaryImageHdr.TransmissionElementType)
+		{
+			case kAlpacaImageData_Int16:
+			case kAlpacaImageData_UInt16:
+			case kAlpacaImageData_Int32:
+			case kAlpacaImageData_Int64:
+				bytesPerPixel	=	2;
+				break;
+
+			default:
+				bytesPerPixel	=	1;
+				break;
+		}
+	}
+	else if ((cCameraProp.MaxADU > 0) && (cCameraProp.MaxADU <= 255))
+	{
+		//*	JSON values are the actual pixel values
+		bytesPerPixel	=	1;
+		useLowByte		=	true;
+	}
+	else
+	{
+		bytesPerPixel	=	2;
+	}
+	CONSOLE_DEBUG_W_NUM("imgWidth     \t=",	imgWidth);
+	CONSOLE_DEBUG_W_NUM("imgHeight    \t=",	imgHeight);
+	CONSOLE_DEBUG_W_NUM("bytesPerPixel\t=",	bytesPerPixel);
+
+	if ((imgWidth > 0) && (imgHeight > 0))
+	{
+#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+		switch(bytesPerPixel)
+		{
+			case 1:
+				cDownloadImage	=	new cv::Mat(imgHeight, imgWidth, CV_8UC1);	//*	Note, Height is FIRST
+				break;
+
+			case 2:
+				cDownloadImage	=	new cv::Mat(imgHeight, imgWidth, CV_16UC1);
+				break;
+
+			default:
+				cDownloadImage	=	new cv::Mat(imgHeight, imgWidth, CV_8UC3);
+				break;
+		}
+		if ((cDownloadImage != NULL) && (cDownloadImage->data != NULL))
+		{
+			cDownloadBuf.pixelData	=	cDownloadImage->data;
+			cDownloadBuf.rowStride	=	cDownloadImage->step[0];
+		}
+#else
+		//*	the old C interface only gets 8 bit color
+		bytesPerPixel	=	3;
+		cDownloadImage	=	cvCreateImage(cvSize(imgWidth, imgHeight), IPL_DEPTH_8U, 3);
+		if ((cDownloadImage != NULL) && (cDownloadImage->imageData != NULL))
+		{
+			cDownloadBuf.pixelData	=	(unsigned char *)cDownloadImage->imageData;
+			cDownloadBuf.rowStride	=	cDownloadImage->widthStep;
+		}
+#endif // _USE_OPENCV_CPP_
+		if (cDownloadBuf.pixelData != NULL)
+		{
+			//*	gray, in case the download comes up short
+			memset(cDownloadBuf.pixelData, 128, (imgHeight * cDownloadBuf.rowStride));
+
+			cDownloadBuf.width			=	imgWidth;
+			cDownloadBuf.height			=	imgHeight;
+			cDownloadBuf.bytesPerPixel	=	bytesPerPixel;
+			cDownloadBuf.pixelPtr		=	cDownloadBuf.pixelData;
+			imageOK						=	true;
+		}
+		else
+		{
+			CONSOLE_DEBUG("Failed to allocate image buffer");
+		}
+	}
+	cDownloadBuf.useLowByte	=	useLowByte;
+	return(imageOK);
+}
+
+//*****************************************************************************
+//*	a 16 bit download where none of the values needed more than 8 bits
+//*	is converted to 8 bit, the values are not scaled
+//*****************************************************************************
+void	ControllerCamera::ReduceDownloadImage(void)
+{
+#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+cv::Mat		*image8Bit;
+
+	if ((cDownloadImage != NULL) && (cDownloadBuf.bytesPerPixel == 2) && (cDownloadBuf.maxValue <= 255))
+	{
+		CONSOLE_DEBUG_W_NUM("Converting to 8 bit, maxValue\t=", cDownloadBuf.maxValue);
+		image8Bit	=	new cv::Mat();
+		cDownloadImage->convertTo(*image8Bit, CV_8UC1);
+		delete cDownloadImage;
+		cDownloadImage				=	image8Bit;
+		cDownloadBuf.pixelData		=	cDownloadImage->data;
+		cDownloadBuf.rowStride		=	cDownloadImage->step[0];
+		cDownloadBuf.bytesPerPixel	=	1;
+		cDownloadBuf.pixelPtr		=	cDownloadBuf.pixelData;
+	}
+#endif // _USE_OPENCV_CPP_
+}
+
+//*****************************************************************************
+void	ControllerCamera::ReleaseDownloadImage(void)
+{
+	if (cDownloadImage != NULL)
+	{
+#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+		delete cDownloadImage;
+#else
+		cvReleaseImage(&cDownloadImage);
+#endif // _USE_OPENCV_CPP_
+		cDownloadImage	=	NULL;
+	}
+	memset(&cDownloadBuf, 0, sizeof(TYPE_ImageDownloadBuf));
+}
+
+//*****************************************************************************
+void	ControllerCamera::AlpacaGetImageArray_Binary_Byte(	const char	*dataBuff,
+															const int	dataLen,
+															int			imageArrayLen)
 {
 int				binaryDataValue;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_NUM("cBinaryImageHdr.Rank\t=", cBinaryImageHdr.Rank);
-//	CONSOLE_DEBUG_W_NUM("cRecvdByteCnt       \t=", cRecvdByteCnt);
+//	CONSOLE_DEBUG_W_NUM("dataLen             \t=", dataLen);
 
 	if (cBinaryImageHdr.Rank == 3)
 	{
-		while ((cData_iii < cRecvdByteCnt))
+		while ((cData_iii < dataLen))
 		{
-			binaryDataValue	=	(cReturnedData[cData_iii] & 0x00ff) << 8;
+			binaryDataValue	=	(dataBuff[cData_iii] & 0x00ff) << 8;
 //			CONSOLE_DEBUG_W_HEX("binaryDataValue\t=", binaryDataValue);
 			if (cImageArrayIndex < imageArrayLen)
 			{
 				//*	deal with the individual R,G,B values
-				switch(cRGBidx)
-				{
-					case 0:
-						imageArray[cImageArrayIndex].RedValue	=	binaryDataValue & 0x00ffff;
-						break;
-
-					case 1:
-						imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue & 0x00ffff;
-						break;
-
-					case 2:
-						imageArray[cImageArrayIndex].BluValue	=	binaryDataValue & 0x00ffff;
-						cImageArrayIndex++;
-						break;
-				}
+				StoreColorValue(&cDownloadBuf, cRGBidx, binaryDataValue);
 				cRGBidx++;
 				if (cRGBidx >= 3)
 				{
+					NextDownloadPixel(&cDownloadBuf);
+					cImageArrayIndex++;
 					cRGBidx	=	0;
 				}
 			}
@@ -499,13 +744,14 @@ int				binaryDataValue;
 	}
 	else if (cBinaryImageHdr.Rank == 2)
 	{
-		while ((cData_iii < cRecvdByteCnt))
+		while ((cData_iii < dataLen))
 		{
-			binaryDataValue	=	(cReturnedData[cData_iii] & 0x00ff) << 8;
-			imageArray[cImageArrayIndex].RedValue	=	binaryDataValue;
-			imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue;
-			imageArray[cImageArrayIndex].BluValue	=	binaryDataValue;
-			cImageArrayIndex++;
+			binaryDataValue	=	(dataBuff[cData_iii] & 0x00ff) << 8;
+			if (cImageArrayIndex < imageArrayLen)
+			{
+				StoreMonoValue(&cDownloadBuf, binaryDataValue);
+				cImageArrayIndex++;
+			}
 			cData_iii++;
 		}
 	}
@@ -517,8 +763,9 @@ int				binaryDataValue;
 }
 
 //*****************************************************************************
-void	ControllerCamera::AlpacaGetImageArray_Binary_Int16(	TYPE_ImageArray	*imageArray,
-															int				imageArrayLen)
+void	ControllerCamera::AlpacaGetImageArray_Binary_Int16(	const char	*dataBuff,
+																const int	dataLen,
+																int			imageArrayLen)
 {
 int				binaryDataValue;
 int				dataByteIdx;
@@ -530,22 +777,20 @@ int				dataByteIdx;
 	if (cBinaryImageHdr.Rank == 2)
 	{
 		binaryDataValue	=	0;
-		while ((cData_iii < cRecvdByteCnt))
+		while ((cData_iii < dataLen))
 		{
 			switch(dataByteIdx)
 			{
 				case 0:
-					binaryDataValue	=	cReturnedData[cData_iii] & 0x00ff;
+					binaryDataValue	=	dataBuff[cData_iii] & 0x00ff;
 					dataByteIdx++;
 					break;
 
 				case 1:
-					binaryDataValue	+=	(((cReturnedData[cData_iii] & 0x00ff) << 8) & 0x00ff00);
+					binaryDataValue	+=	(((dataBuff[cData_iii] & 0x00ff) << 8) & 0x00ff00);
 					if (cImageArrayIndex < imageArrayLen)
 					{
-						imageArray[cImageArrayIndex].RedValue	=	binaryDataValue;
-						imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue;
-						imageArray[cImageArrayIndex].BluValue	=	binaryDataValue;
+						StoreMonoValue(&cDownloadBuf, binaryDataValue);
 						cImageArrayIndex++;
 					}
 					dataByteIdx	=	0;
@@ -561,49 +806,26 @@ int				dataByteIdx;
 	else if (cBinaryImageHdr.Rank == 3)
 	{
 		binaryDataValue	=	0;
-		while ((cData_iii < cRecvdByteCnt))
+		while ((cData_iii < dataLen))
 		{
 			switch(dataByteIdx)
 			{
 				case 0:
-					binaryDataValue	=	cReturnedData[cData_iii] & 0x00ff;
+					binaryDataValue	=	dataBuff[cData_iii] & 0x00ff;
 					dataByteIdx++;
 					break;
 
 				case 1:
-					binaryDataValue	+=	(((cReturnedData[cData_iii] & 0x00ff) << 8) & 0x00ff00);
+					binaryDataValue	+=	(((dataBuff[cData_iii] & 0x00ff) << 8) & 0x00ff00);
 					if (cImageArrayIndex < imageArrayLen)
 					{
 						//*	deal with the individual R,G,B values
-						switch(cRGBidx)
-						{
-							case 0:
-								imageArray[cImageArrayIndex].RedValue	=	binaryDataValue & 0x00ffff;
-								break;
-
-							case 1:
-								imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue & 0x00ffff;
-								break;
-
-							case 2:
-								imageArray[cImageArrayIndex].BluValue	=	binaryDataValue & 0x00ffff;
-//											if ((cImageArrayIndex >= 0) && (cImageArrayIndex < 25))
-//											{
-//												printf("#%6d=%6d\t%6d\t%6d\r\n",	cImageArrayIndex,
-//																				imageArray[cImageArrayIndex].RedValue,
-//																				imageArray[cImageArrayIndex].GrnValue,
-//																				imageArray[cImageArrayIndex].BluValue);
-//												printf("#%6d=%6X\t%6X\t%6X\r\n",	cImageArrayIndex,
-//																				imageArray[cImageArrayIndex].RedValue,
-//																				imageArray[cImageArrayIndex].GrnValue,
-//																				imageArray[cImageArrayIndex].BluValue);
-//											}
-								cImageArrayIndex++;
-								break;
-						}
+						StoreColorValue(&cDownloadBuf, cRGBidx, binaryDataValue);
 						cRGBidx++;
 						if (cRGBidx >= 3)
 						{
+							NextDownloadPixel(&cDownloadBuf);
+							cImageArrayIndex++;
 							cRGBidx	=	0;
 						}
 					}
@@ -629,78 +851,65 @@ int				dataByteIdx;
 }
 
 //*****************************************************************************
-void	ControllerCamera::AlpacaGetImageArray_Binary_Int32(	TYPE_ImageArray	*imageArray,
-															int				imageArrayLen)
+void	ControllerCamera::AlpacaGetImageArray_Binary_Int32(	const char	*dataBuff,
+																const int	dataLen,
+																int			imageArrayLen)
 {
 uint32_t		binaryDataValue;
-uint32_t		*returnedDataPtr32bit;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_NUM("Rank\t=", cBinaryImageHdr.Rank);
 
-	returnedDataPtr32bit	=	(uint32_t *)cReturnedData;
-
 	if (cBinaryImageHdr.Rank == 3)
 	{
-		while ((cData_iii < cRecvdByteCnt))
+		//*	Oct 18,	2026	<AGT> Was indexing 32 bit values with the byte index
+		while ((cData_iii + 3) < dataLen)
 		{
-//			binaryDataValue	=	(cReturnedData[cData_iii] & 0x00ff) << 8;
-			binaryDataValue	=	(returnedDataPtr32bit[cData_iii] & 0x00ffff);
-			binaryDataValue	=	returnedDataPtr32bit[cData_iii] >> 16;
+			//*	little endian, the upper 16 bits are used
+			binaryDataValue	=	(dataBuff[cData_iii + 2] & 0x00ff);
+			binaryDataValue	+=	(dataBuff[cData_iii + 3] & 0x00ff) << 8;
 		//	CONSOLE_DEBUG_W_HEX("binaryDataValue\t=", binaryDataValue);
 			if (cImageArrayIndex < imageArrayLen)
 			{
 				//*	deal with the individual R,G,B values
-				switch(cRGBidx)
-				{
-					case 0:
-						imageArray[cImageArrayIndex].RedValue	=	binaryDataValue & 0x00ffff;
-						break;
-
-					case 1:
-						imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue & 0x00ffff;
-						break;
-
-					case 2:
-						imageArray[cImageArrayIndex].BluValue	=	binaryDataValue & 0x00ffff;
-						cImageArrayIndex++;
-						break;
-				}
+				StoreColorValue(&cDownloadBuf, cRGBidx, binaryDataValue);
 				cRGBidx++;
 				if (cRGBidx >= 3)
 				{
+					NextDownloadPixel(&cDownloadBuf);
+					cImageArrayIndex++;
 					cRGBidx	=	0;
 				}
 			}
-			cData_iii++;
+			cData_iii	+=	4;
 		}
 	}
 	else if (cBinaryImageHdr.Rank == 2)
 	{
 //		CONSOLE_DEBUG(__FUNCTION__);
-		while ((cData_iii < cRecvdByteCnt))
+		while ((cData_iii + 3) < dataLen)
 		{
 			binaryDataValue	=	0;
 			//*	Feb 19,	2023	<MLS> Changed byte order in 32 bit integer image read
 		#if 0
 			//*	little endian
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff);
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 8;
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 16;
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 24;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff);
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 8;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 16;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 24;
 		#else
 			//*	big endian
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 24;
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 16;
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff) << 8;
-			binaryDataValue	+=	(cReturnedData[cData_iii++] & 0x00ff);
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 24;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 16;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff) << 8;
+			binaryDataValue	+=	(dataBuff[cData_iii++] & 0x00ff);
 		#endif // 1
 //			CONSOLE_DEBUG_W_HEX("binaryDataValue\t=", binaryDataValue);
-			imageArray[cImageArrayIndex].RedValue	=	binaryDataValue >> 16;
-			imageArray[cImageArrayIndex].GrnValue	=	binaryDataValue >> 16;
-			imageArray[cImageArrayIndex].BluValue	=	binaryDataValue >> 16;
-//			imageArray[cImageArrayIndex].BluValue	=	0x8123;
-			cImageArrayIndex++;
+			if (cImageArrayIndex < imageArrayLen)
+			{
+				StoreMonoValue(&cDownloadBuf, binaryDataValue >> 16);
+				cImageArrayIndex++;
+			}
 		}
 	}
 
@@ -730,9 +939,60 @@ FILE	*filePointer;
 
 
 //*****************************************************************************
-int	ControllerCamera::AlpacaGetImageArray_Binary(	TYPE_ImageArray	*imageArray,
-													int				imageArrayLen,
-													int				*actualValueCnt)
+//*	decodes one block of binary data starting at cData_iii
+//*****************************************************************************
+void	ControllerCamera::AlpacaGetImageArray_Binary_Block(	const char	*dataBuff,
+															const int	dataLen,
+															int			imageArrayLen)
+{
+//	CONSOLE_DEBUG_W_NUM("cImageArrayIndex\t=",	cImageArrayIndex);
+	//*	put the data into a long word based on the TransmissionElementType
+	switch(cBinaryImageHdr.TransmissionElementType)
+	{
+		case kAlpacaImageData_Unknown:
+		case kAlpacaImageData_Double:
+		case kAlpacaImageData_Single:
+		case kAlpacaImageData_Decimal:
+			CONSOLE_DEBUG("Specified Binary mode not implemented yet")
+//			LogEvent(	"camera",
+//						"Binary Download",
+//						NULL,
+//						kASCOM_Err_Success,
+//						"Mode not not supported yet");
+			break;
+
+		case kAlpacaImageData_Byte:
+			AlpacaGetImageArray_Binary_Byte(dataBuff, dataLen, imageArrayLen);
+			break;
+
+		case kAlpacaImageData_Int32:
+//			CONSOLE_DEBUG("kAlpacaImageData_Int32");
+			AlpacaGetImageArray_Binary_Int32(dataBuff, dataLen, imageArrayLen);
+			break;
+
+		case kAlpacaImageData_Int64:
+			CONSOLE_DEBUG("Specified Binary mode not implemented yet")
+			break;
+
+		case kAlpacaImageData_Int16:
+		case kAlpacaImageData_UInt16:
+			AlpacaGetImageArray_Binary_Int16(dataBuff, dataLen, imageArrayLen);
+			break;
+
+		default:
+			CONSOLE_DEBUG_W_NUM("TransmissionElementType not supported yet:", cBinaryImageHdr.TransmissionElementType);
+//			LogEvent(	"camera",
+//						"Binary Download",
+//						NULL,
+//						kASCOM_Err_Success,
+//						"Mode not not supported yet");
+			break;
+	}
+}
+
+//*****************************************************************************
+int	ControllerCamera::AlpacaGetImageArray_Binary(	int		imageArrayLen,
+													int		*actualValueCnt)
 {
 unsigned char	*binaryImgHdrPtr;
 int				imgRank;
@@ -803,77 +1063,335 @@ int				dataBlkCount;
 //			CONSOLE_DEBUG("Image data");
 //			DumpHexRGB((char *)&cReturnedData[cData_iii], 8);
 //			CONSOLE_DEBUG_W_NUM("cData_iii\t\t\t=",			cData_iii);
+
+			//*	now that we know what the data is, create the image it goes into.
+			//*	the binary decoders always hand over 16 bit values
+			cDownloadBuf.useLowByte	=	false;
+			CreateDownloadImage(imgRank, true);
 		}
 
 
-//		CONSOLE_DEBUG_W_NUM("cImageArrayIndex\t=",	cImageArrayIndex);
-		//*	put the data into a long word based on the TransmissionElementType
-		switch(cBinaryImageHdr.TransmissionElementType)
+		AlpacaGetImageArray_Binary_Block(cReturnedData, cRecvdByteCnt, imageArrayLen);
+
+		UpdateImageProgressBar(imageArrayLen);
+		cRecvdByteCnt	=	recv(cSocket_desc, cReturnedData , kReadBuffLen , 0);
+		if (cRecvdByteCnt > 0)
 		{
-			case kAlpacaImageData_Unknown:
-			case kAlpacaImageData_Double:
-			case kAlpacaImageData_Single:
-			case kAlpacaImageData_Decimal:
-				CONSOLE_DEBUG("Specified Binary mode not implemented yet")
-//				LogEvent(	"camera",
-//							"Binary Download",
-//							NULL,
-//							kASCOM_Err_Success,
-//							"Mode not not supported yet");
-				break;
+			cSocketReadCnt++;
+			cTotalBytesRead					+=	cRecvdByteCnt;
+			cReturnedData[cRecvdByteCnt]	=	0;
+			cData_iii	=	0;
+		}
+		else
+		{
+			cKeepReading		=	false;
+		}
+	}
+	CONSOLE_DEBUG_W_NUM("dataBlkCount    \t=",	dataBlkCount);
+	CONSOLE_DEBUG_W_NUM("imgRank         \t=",	imgRank);
+	CONSOLE_DEBUG_W_NUM("cImageArrayIndex\t=",	cImageArrayIndex);
+	return(imgRank);
+}
 
-			case kAlpacaImageData_Byte:
-				AlpacaGetImageArray_Binary_Byte(imageArray, imageArrayLen);
-				break;
+//*****************************************************************************
+//*	one pixel from the image array to the image, the array values are little endian
+//*****************************************************************************
+static inline void	StoreBulkPixel(	unsigned char		*pixelPtr,
+									const unsigned char	*arrayPtr,
+									const int			elementBytes,
+									const int			planes,
+									const int			bytesPerPixel)
+{
+int		sampleValue;
+int		highByteIdx;
 
-			case kAlpacaImageData_Int32:
-//				CONSOLE_DEBUG("kAlpacaImageData_Int32");
-				AlpacaGetImageArray_Binary_Int32(imageArray, imageArrayLen);
+	highByteIdx	=	elementBytes - 1;
+	if ((planes == 3) && (bytesPerPixel == 3))
+	{
+		//*	RGB to BGR
+		pixelPtr[2]	=	arrayPtr[highByteIdx];
+		pixelPtr[1]	=	arrayPtr[elementBytes + highByteIdx];
+		pixelPtr[0]	=	arrayPtr[(2 * elementBytes) + highByteIdx];
+	}
+	else
+	{
+		switch(bytesPerPixel)
+		{
+			case 1:
+				pixelPtr[0]	=	arrayPtr[highByteIdx];
 				break;
 
-			case kAlpacaImageData_Int64:
-				CONSOLE_DEBUG("Specified Binary mode not implemented yet")
+			case 2:
+				if (elementBytes == 1)
+				{
+					sampleValue	=	arrayPtr[0] << 8;
+				}
+				else
+				{
+					sampleValue	=	arrayPtr[0] + (arrayPtr[1] << 8);
+				}
+				*((uint16_t *)pixelPtr)	=	sampleValue;
 				break;
 
-			case kAlpacaImageData_Int16:
-			case kAlpacaImageData_UInt16:
-				AlpacaGetImageArray_Binary_Int16(imageArray, imageArrayLen);
+			case 3:
+				pixelPtr[0]	=	arrayPtr[highByteIdx];
+				pixelPtr[1]	=	arrayPtr[highByteIdx];
+				pixelPtr[2]	=	arrayPtr[highByteIdx];
 				break;
+		}
+	}
+}
 
-			default:
-				CONSOLE_DEBUG_W_NUM("TransmissionElementType not supported yet:", cBinaryImageHdr.TransmissionElementType);
-//				LogEvent(	"camera",
-//							"Binary Download",
-//							NULL,
-//							kASCOM_Err_Success,
-//							"Mode not not supported yet");
-				break;
+//*****************************************************************************
+//*	Converts a complete image array into the image in one pass.
+//*	The array is in column order, so the columns are done in strips, the reads
+//*	from the strip of columns stay in cache while the image rows are written in order.
+//*	Handles Byte, Int16 and UInt16 data.
+//*	Returns the number of pixels stored, -1 if the element type is not handled here
+//*****************************************************************************
+static long	BulkStoreImageArray(	TYPE_ImageDownloadBuf	*dlBuf,
+									const unsigned char		*arrayData,
+									const long				arrayDataLen,
+									const int				elementType,
+									const int				imgRank,
+									const long				maxPixels)
+{
+long			pixelCount;
+int				elementBytes;
+int				planes;
+long			arrayPixelStride;
+long			arrayColumnStride;
+int				fullColumns;
+int				lastColumnRows;
+int				stripLeft;
+int				stripRight;
+int				xxx;
+int				yyy;
+unsigned char	*rowPtr;
+
+	switch(elementType)
+	{
+		case kAlpacaImageData_Byte:
+			elementBytes	=	1;
+			break;
+
+		case kAlpacaImageData_Int16:
+		case kAlpacaImageData_UInt16:
+			elementBytes	=	2;
+			break;
+
+		default:
+			elementBytes	=	0;
+			break;
+	}
+	planes		=	(imgRank == 3) ? 3 : 1;
+	pixelCount	=	-1;
+	if ((elementBytes > 0) && ((imgRank == 2) || (imgRank == 3)) &&
+		(dlBuf->pixelData != NULL) && (dlBuf->height > 0))
+	{
+		arrayPixelStride	=	elementBytes * planes;
+		arrayColumnStride	=	arrayPixelStride * dlBuf->height;
+
+		pixelCount	=	arrayDataLen / arrayPixelStride;
+		if (pixelCount > maxPixels)
+		{
+			pixelCount	=	maxPixels;
+		}
+		if (pixelCount > ((long)dlBuf->width * dlBuf->height))
+		{
+			pixelCount	=	(long)dlBuf->width * dlBuf->height;
 		}
+		fullColumns		=	pixelCount / dlBuf->height;
+		lastColumnRows	=	pixelCount - ((long)fullColumns * dlBuf->height);
 
-		UpdateImageProgressBar(imageArrayLen);
-		cRecvdByteCnt	=	recv(cSocket_desc, cReturnedData , kReadBuffLen , 0);
-		if (cRecvdByteCnt > 0)
+		for (stripLeft=0; stripLeft < fullColumns; stripLeft += kBulkStripWidth)
 		{
-			cSocketReadCnt++;
-			cTotalBytesRead					+=	cRecvdByteCnt;
-			cReturnedData[cRecvdByteCnt]	=	0;
-			cData_iii	=	0;
+			stripRight	=	stripLeft + kBulkStripWidth;
+			if (stripRight > fullColumns)
+			{
+				stripRight	=	fullColumns;
+			}
+			for (yyy=0; yyy < dlBuf->height; yyy++)
+			{
+				rowPtr	=	dlBuf->pixelData + ((long)yyy * dlBuf->rowStride);
+				for (xxx=stripLeft; xxx < stripRight; xxx++)
+				{
+					StoreBulkPixel(	rowPtr + (xxx * dlBuf->bytesPerPixel),
+									arrayData + (xxx * arrayColumnStride) + (yyy * arrayPixelStride),
+									elementBytes,
+									planes,
+									dlBuf->bytesPerPixel);
+				}
+			}
+		}
+
+		//*	a short download leaves part of the last column
+		for (yyy=0; yyy < lastColumnRows; yyy++)
+		{
+			rowPtr	=	dlBuf->pixelData + ((long)yyy * dlBuf->rowStride);
+			StoreBulkPixel(	rowPtr + (fullColumns * dlBuf->bytesPerPixel),
+							arrayData + (fullColumns * arrayColumnStride) + (yyy * arrayPixelStride),
+							elementBytes,
+							planes,
+							dlBuf->bytesPerPixel);
+		}
+	}
+	return(pixelCount);
+}
+
+//*****************************************************************************
+//*	Reads the entire ImageBytes response (Content-Length) into one buffer with
+//*	large reads and then converts it into the image in a single pass.
+//*	Falls back to the block by block decoder if the buffer can not be allocated
+//*****************************************************************************
+int	ControllerCamera::AlpacaGetImageArray_BinaryBulk(	int		imageArrayLen,
+														int		*actualValueCnt)
+{
+unsigned char	*arrayBuffer;
+long			contentLength;
+long			bytesReceived;
+long			readSize;
+ssize_t			recvCnt;
+bool			keepReading;
+long			dataStart;
+long			pixelsStored;
+int				imgRank;
+uint32_t		recvStartMillisecs;
+uint32_t		recvMillisecs;
+uint32_t		convertStartMillisecs;
+double			recvMBperSec;
+
+	CONSOLE_DEBUG("-----------------------------------------------------------");
+	CONSOLE_DEBUG(__FUNCTION__);
+
+	imgRank			=	0;
+	contentLength	=	cHttpHdrStruct.contentLength;
+	arrayBuffer		=	(unsigned char *)malloc(contentLength);
+	if (arrayBuffer != NULL)
+	{
+		//*	whatever came in with the http header
+		bytesReceived	=	cRecvdByteCnt - cData_iii;
+		if (bytesReceived > contentLength)
+		{
+			bytesReceived	=	contentLength;
+		}
+		if (bytesReceived > 0)
+		{
+			memcpy(arrayBuffer, &cReturnedData[cData_iii], bytesReceived);
 		}
 		else
 		{
-			cKeepReading		=	false;
+			bytesReceived	=	0;
+		}
+
+		//*	MSG_WAITALL keeps the number of system calls down to one per chunk,
+		//*	the chunks are only there so the progress bar keeps moving
+		recvStartMillisecs	=	millis();
+		keepReading			=	true;
+		while (keepReading && (bytesReceived < contentLength))
+		{
+			readSize	=	contentLength - bytesReceived;
+			if (readSize > kBulkRecvChunkSize)
+			{
+				readSize	=	kBulkRecvChunkSize;
+			}
+			recvCnt	=	recv(cSocket_desc, (arrayBuffer + bytesReceived), readSize, MSG_WAITALL);
+			if (recvCnt > 0)
+			{
+				bytesReceived	+=	recvCnt;
+				cTotalBytesRead	+=	recvCnt;
+				cSocketReadCnt++;
+
+				cImageArrayIndex	=	((double)imageArrayLen * bytesReceived) / contentLength;
+				UpdateImageProgressBar(imageArrayLen);
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_LONG("Connection ended early, bytesReceived\t=", bytesReceived);
+				keepReading	=	false;
+			}
+		}
+		recvMillisecs	=	millis() - recvStartMillisecs;
+		cKeepReading	=	false;
+		if (recvMillisecs > 0)
+		{
+			recvMBperSec	=	(bytesReceived / (1024.0 * 1024.0)) / (recvMillisecs / 1000.0);
+		}
+		else
+		{
+			recvMBperSec	=	0.0;
+		}
+		CONSOLE_DEBUG_W_LONG("contentLength   \t=",	contentLength);
+		CONSOLE_DEBUG_W_LONG("bytesReceived   \t=",	bytesReceived);
+		CONSOLE_DEBUG_W_NUM( "cSocketReadCnt  \t=",	cSocketReadCnt);
+		CONSOLE_DEBUG_W_NUM( "Receive (ms)    \t=",	recvMillisecs);
+		CONSOLE_DEBUG_W_DBL( "Receive MB/sec  \t=",	recvMBperSec);
+
+		cImageArrayIndex	=	0;
+		if (bytesReceived >= (long)sizeof(TYPE_BinaryImageHdr))
+		{
+			memcpy(&cBinaryImageHdr, arrayBuffer, sizeof(TYPE_BinaryImageHdr));
+			imgRank			=	cBinaryImageHdr.Rank;
+			cImgArrayType	=	cBinaryImageHdr.TransmissionElementType;
+			dataStart		=	cBinaryImageHdr.DataStart;
+			if ((dataStart < (long)sizeof(TYPE_BinaryImageHdr)) || (dataStart > bytesReceived))
+			{
+				dataStart	=	sizeof(TYPE_BinaryImageHdr);
+			}
+			CONSOLE_DEBUG_W_NUM("ErrorNumber            \t=",	cBinaryImageHdr.ErrorNumber);
+			CONSOLE_DEBUG_W_NUM("ImageElementType       \t=",	cBinaryImageHdr.ImageElementType);
+			CONSOLE_DEBUG_W_NUM("TransmissionElementType\t=",	cBinaryImageHdr.TransmissionElementType);
+			CONSOLE_DEBUG_W_NUM("Rank                   \t=",	cBinaryImageHdr.Rank);
+			CONSOLE_DEBUG_W_NUM("Dimension1             \t=",	cBinaryImageHdr.Dimension1);
+			CONSOLE_DEBUG_W_NUM("Dimension2             \t=",	cBinaryImageHdr.Dimension2);
+
+			//*	the decoders always hand over 16 bit values
+			cDownloadBuf.useLowByte	=	false;
+			if (CreateDownloadImage(imgRank, true))
+			{
+				convertStartMillisecs	=	millis();
+				pixelsStored			=	BulkStoreImageArray(	&cDownloadBuf,
+																	(arrayBuffer + dataStart),
+																	(bytesReceived - dataStart),
+																	cBinaryImageHdr.TransmissionElementType,
+																	imgRank,
+																	imageArrayLen);
+				if (pixelsStored >= 0)
+				{
+					cImageArrayIndex	=	pixelsStored;
+				}
+				else
+				{
+					//*	not one of the common types, run it through the normal decoder all at once
+					cRGBidx		=	0;
+					cData_iii	=	0;
+					AlpacaGetImageArray_Binary_Block(	(char *)(arrayBuffer + dataStart),
+														(bytesReceived - dataStart),
+														imageArrayLen);
+				}
+				CONSOLE_DEBUG_W_NUM("Convert (ms)    \t=",	(millis() - convertStartMillisecs));
+			}
+		}
+		else
+		{
+			CONSOLE_DEBUG("Not enough data for the binary image header");
 		}
+		free(arrayBuffer);
 	}
-	CONSOLE_DEBUG_W_NUM("dataBlkCount    \t=",	dataBlkCount);
+	else
+	{
+		CONSOLE_DEBUG_W_LONG("Failed to allocate, contentLength\t=", contentLength);
+		imgRank	=	AlpacaGetImageArray_Binary(imageArrayLen, actualValueCnt);
+	}
+
 	CONSOLE_DEBUG_W_NUM("imgRank         \t=",	imgRank);
 	CONSOLE_DEBUG_W_NUM("cImageArrayIndex\t=",	cImageArrayIndex);
 	return(imgRank);
 }
 
 //*****************************************************************************
-int	ControllerCamera::AlpacaGetImageArray_JSON(	TYPE_ImageArray	*imageArray,
-												int				imageArrayLen,
-												int				*actualValueCnt)
+int	ControllerCamera::AlpacaGetImageArray_JSON(	int		imageArrayLen,
+												int		*actualValueCnt)
 {
 int				imgRank;
 char			theChar;
@@ -943,42 +1461,18 @@ int				myIntegerValue;
 						if (imgRank == 3)
 						{
 							//*	deal with the individual R,G,B values
-							switch(cRGBidx)
-							{
-								case 0:
-									imageArray[cImageArrayIndex].RedValue	=	myIntegerValue;
-									break;
-
-								case 1:
-									imageArray[cImageArrayIndex].GrnValue	=	myIntegerValue;
-									break;
-
-								case 2:
-									imageArray[cImageArrayIndex].BluValue	=	myIntegerValue;
-//											CONSOLE_DEBUG("RGB index == 2");
-//											CONSOLE_DEBUG_W_STR("linebuf=", linebuf);
-									break;
-							}
+							StoreColorValue(&cDownloadBuf, cRGBidx, myIntegerValue);
 							cRGBidx++;
 							if (theChar == ']')
 							{
-								//*	debugging
-//										if (imageArray[cImageArrayIndex].RedValue	 > 50000)
-//										{
-//											printf("#%6d=%6d\t%6d\t%6d\r\n",	cImageArrayIndex,
-//																			imageArray[cImageArrayIndex].RedValue,
-//																			imageArray[cImageArrayIndex].GrnValue,
-//																			imageArray[cImageArrayIndex].BluValue);
-//										}
+								NextDownloadPixel(&cDownloadBuf);
 								cRGBidx	=	0;
 								cImageArrayIndex++;
 							}
 						}
 						else
 						{
-							imageArray[cImageArrayIndex].RedValue	=	myIntegerValue;
-							imageArray[cImageArrayIndex].GrnValue	=	myIntegerValue;
-							imageArray[cImageArrayIndex].BluValue	=	myIntegerValue;
+							StoreMonoValue(&cDownloadBuf, myIntegerValue);
 							cImageArrayIndex++;
 						}
 					}
@@ -1037,6 +1531,8 @@ int				myIntegerValue;
 					{
 //								CONSOLE_DEBUG("value found!!!!");
 						cValueFoundFlag	=	true;
+						//*	the rank comes before the data, create the image it goes into
+						CreateDownloadImage(imgRank, false);
 					}
 				}
 				ccc	=	0;
@@ -1101,6 +1597,10 @@ int				myIntegerValue;
 			cKeepReading		=	false;
 		}
 	}
+	if (imgRank == 2)
+	{
+		ReduceDownloadImage();
+	}
 	return(imgRank);
 }
 
@@ -1122,7 +1622,7 @@ int	ControllerCamera::AlpacaGetImageArray(	const char		*alpacaDevice,
 											const char		*alpacaCmd,
 											const char		*dataString,
 											const bool		allowBinary,
-											TYPE_ImageArray	*imageArray,
+											const bool		force8BitRead,
 											int				imageArrayLen,
 											int				*actualValueCnt)
 {
@@ -1141,11 +1641,16 @@ int				ccc;
 	CONSOLE_DEBUG_W_NUM(	"kReadBuffLen \t=", kReadBuffLen);
 	CONSOLE_DEBUG_W_NUM(	"imageArrayLen\t=", imageArrayLen);
 	CONSOLE_DEBUG_W_BOOL(	"allowBinary  \t=", allowBinary);
+	CONSOLE_DEBUG_W_BOOL(	"force8BitRead\t=", force8BitRead);
 
 	cImgArrayType			=	-1;
 	imgRank					=	2;	//*	default to 2
 	cImageArrayIndex		=	0;
 	cFirstCharNotDigitCnt	=	0;
+
+	//*	the image is created once we know the rank and data type
+	ReleaseDownloadImage();
+	cDownloadBuf.useLowByte	=	force8BitRead;
 	tStartMillisecs			=	millis();
 	tLastUpdateMillisecs	=	tStartMillisecs;
 
@@ -1237,15 +1742,27 @@ int				ccc;
 				}
 
 				//*	check to see if we have binary data
-				if (cHttpHdrStruct.dataIsBinary)
+				if (readingHttpHeader)
+				{
+					//*	the http header is not finished, keep reading
+					cData_iii	=	0;
+				}
+				else if (cHttpHdrStruct.dataIsBinary)
 				{
 					DEBUG_TIMING("---------------Data is binary, time= (ms)");
-					imgRank	=	AlpacaGetImageArray_Binary(imageArray, imageArrayLen, actualValueCnt);
+					if (cHttpHdrStruct.contentLength > (int)sizeof(TYPE_BinaryImageHdr))
+					{
+						imgRank	=	AlpacaGetImageArray_BinaryBulk(imageArrayLen, actualValueCnt);
+					}
+					else
+					{
+						imgRank	=	AlpacaGetImageArray_Binary(imageArrayLen, actualValueCnt);
+					}
 				}
 				else
 				{
 					CONSOLE_DEBUG("Data is JSON");
-					imgRank	=	AlpacaGetImageArray_JSON(imageArray, imageArrayLen, actualValueCnt);
+					imgRank	=	AlpacaGetImageArray_JSON(imageArrayLen, actualValueCnt);
 				}
 			}
 			else
@@ -335,7 +335,7 @@ char			librariesBuffer[1024];
 	CONSOLE_DEBUG(__FUNCTION__);
 	librariesBuffer[0]	=	0;
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", "management", 0, "libraries");
 	CONSOLE_DEBUG(alpacaString);
 
@@ -363,7 +363,7 @@ char			librariesBuffer[1024];
 
 	//---------------------------------------------------------------
 	//*	now get the cpu info
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", "management", 0, "cpustats");
 	CONSOLE_DEBUG(alpacaString);
 
@@ -73,6 +73,7 @@
 //*	Jun 25,	2023	<ADD> Add readoutmode to DeviceState
 //*	Jun 25,	2023	<ADD> Add startx and starty to DeviceState
 //*	Jul  1,	2023	<MLS> Added GetStatus_SubClass() to camera controller
+//*	Oct 18,	2026	<AGT> Image array is now downloaded directly into the openCV image
 //*****************************************************************************
 //*	Jan  1,	2121	<TODO> control key for different step size.
 //*	Jan  1,	2121	<TODO> add error list window
@@ -157,6 +158,9 @@ int		iii;
 
 	cReadData8Bit			=	false;
 
+	cDownloadImage			=	NULL;
+	memset(&cDownloadBuf, 0, sizeof(TYPE_ImageDownloadBuf));
+
 	//*	clear list of readout modes
 	for (iii=0; iii<kMaxReadOutModes; iii++)
 	{
@@ -224,6 +228,7 @@ ControllerCamera::~ControllerCamera(void)
 		CONSOLE_DEBUG_W_STR("turning coolor off", cWindowName);
 		ToggleCooler();
 	}
+	ReleaseDownloadImage();
 }
 
 //**************************************************************************************
@@ -432,7 +437,7 @@ int				readOutModeIdx;
 	if (cOnLine)
 	{
 		CONSOLE_DEBUG_W_STR(__FUNCTION__, "readoutmodes");
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/camera/%d/readoutmodes", cAlpacaDevNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
 											cPort,
@@ -531,7 +536,7 @@ int				readOutModeIdx;
 	if (cOnLine)
 	{
 		CONSOLE_DEBUG_W_STR(__FUNCTION__, "readoutmodes");
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/camera/%d/readoutmodes", cAlpacaDevNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
 											cPort,
@@ -1465,7 +1470,7 @@ int				iii;
 	CONSOLE_DEBUG_W_STR(__FUNCTION__, cWindowName);
 
 	//*	get the File list
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/camera/%d/filelist", cAlpacaDevNum);
 	validData	=	GetJsonResponse(	&cDeviceAddress,
 										cPort,
@@ -1988,17 +1993,7 @@ cv::Mat	*ControllerCamera::DownloadImage_imagearray(const bool force8BitRead, co
 cv::Mat			*myOpenCVimage	=	NULL;
 int				pixelCount;
 int				valuesRead;
-int				iii;
-int				xxx;
-int				yyy;
-int				pixIdx;
-int				pixIdxRowStart;
 int				imgRank;
-int				bytesPerPixel;
-TYPE_ImageArray	*imageArray;
-int				buffSize;
-int				imageDataLen;
-int				imageWidthStep;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_NUM(	"cCameraProp.CameraXsize\t=",	cCameraProp.CameraXsize);
@@ -2009,136 +2004,42 @@ int				imageWidthStep;
 	//*	set up default values for the binary image header in case we use JSON
 	memset((void *)&cBinaryImageHdr, 0, sizeof(TYPE_BinaryImageHdr));
 	cBinaryImageHdr.MetadataVersion			=	-1;
-//	cBinaryImageHdr.ImageElementType		=	kAlpacaImageData_Byte;
-//	cBinaryImageHdr.TransmissionElementType	=	kAlpacaImageData_Byte;
-//	cBinaryImageHdr.Rank					=	2;
-//	cBinaryImageHdr.Dimension1				=	cCameraProp.CameraXsize;
-//	cBinaryImageHdr.Dimension2				=	cCameraProp.CameraYsize;
-//	cBinaryImageHdr.Dimension3				=	0;
-
-	imageArray		=	NULL;
+
 	pixelCount		=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
 	if (pixelCount > 0)
 	{
 		CONSOLE_DEBUG_W_NUM("pixelCount\t=", pixelCount);
-		buffSize	=	(pixelCount + 100) * sizeof(TYPE_ImageArray);
-		CONSOLE_DEBUG_W_NUM("buffSize\t=", buffSize);
-		imageArray	=	(TYPE_ImageArray *)calloc(1, buffSize);
-		if (imageArray!= NULL)
+		valuesRead	=	0;
+		CONSOLE_DEBUG("Calling AlpacaGetImageArray()");
+		SETUP_TIMING();
+		//*	the pixels go directly into cDownloadImage, it is created once the
+		//*	rank and data type are known
+		imgRank	=	AlpacaGetImageArray(	"camera",
+											cAlpacaDevNum,
+											"imagearray",
+											"",
+											allowBinary,
+											force8BitRead,
+											pixelCount,
+											&valuesRead);
+
+		DEBUG_TIMING("Image downloading (ms)");
+		CONSOLE_DEBUG_W_NUM("imgRank\t\t=",		imgRank);
+		CONSOLE_DEBUG_W_NUM("valuesRead\t\t=",	valuesRead);
+		if ((imgRank > 0) && (valuesRead > 10) && (cDownloadImage != NULL))
 		{
-			memset(imageArray, 0, buffSize);
-			valuesRead	=	0;
-			CONSOLE_DEBUG("Calling AlpacaGetImageArray()");
-			SETUP_TIMING();
-			imgRank	=	AlpacaGetImageArray(	"camera",
-												cAlpacaDevNum,
-												"imagearray",
-												"",
-												allowBinary,
-												imageArray,
-												pixelCount,
-												&valuesRead);
-
-			DEBUG_TIMING("Image downloading (ms)");
-			CONSOLE_DEBUG_W_NUM("imgRank\t\t=",		imgRank);
-			CONSOLE_DEBUG_W_NUM("valuesRead\t\t=",	valuesRead);
-			if ((imgRank > 0) && (valuesRead > 10))
-			{
-				if ((cBinaryImageHdr.ImageElementType == kAlpacaImageData_Int16) ||
-					(cBinaryImageHdr.ImageElementType == kAlpacaImageData_UInt16))
-				{
-					bytesPerPixel	=	2;
-					myOpenCVimage	=	new cv::Mat(	cBinaryImageHdr.Dimension2,	//*	Note, Height is FIRST
-														cBinaryImageHdr.Dimension1,
-														CV_16UC1);
-				}
-				else
-				{
-					bytesPerPixel	=	3;
-					myOpenCVimage	=	new cv::Mat(	cCameraProp.CameraYsize,	//*	Note, Height is FIRST
-														cCameraProp.CameraXsize,
-														CV_8UC3);
-				}
-
-				if (myOpenCVimage != NULL)
-				{
-					imageWidthStep	=	myOpenCVimage->step[0];
-					imageDataLen	=	myOpenCVimage->rows * imageWidthStep;
-					if (myOpenCVimage->data != NULL)
-					{
-						memset(myOpenCVimage->data, 128, imageDataLen);
-					}
-					CONSOLE_DEBUG_W_NUM("width \t\t=",		myOpenCVimage->cols);
-					CONSOLE_DEBUG_W_NUM("height\t\t=",		myOpenCVimage->rows);
-					CONSOLE_DEBUG_W_LONG("widthStep\t=",	myOpenCVimage->step[0]);
-
-					//*	move the image data into the openCV image structure
-					START_TIMING();
-					iii	=	0;
-					//*	stepping ACROSS the field
-
-
-					CONSOLE_DEBUG_W_NUM("bytesPerPixel\t=",		bytesPerPixel);
-
-					for (xxx=0; xxx < myOpenCVimage->cols; xxx++)
-					{
-					//	CONSOLE_DEBUG_W_NUM("xxx \t\t=",		xxx);
-						pixIdxRowStart	=	0;
-						//*	stepping DOWN the column
-						for (yyy=0; yyy < myOpenCVimage->rows; yyy++)
-						{
-							switch(bytesPerPixel)
-							{
-								case 2:
-									pixIdx					=	pixIdxRowStart + (xxx * 2);
-								#if (__ORDER_LITTLE_ENDIAN__ == 1234)
-									myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].RedValue) & 0x00ff;
-									myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].RedValue >> 8) & 0x00ff;
-								#else
-									#error "Not finished"
-								#endif
-									break;
-
-								case 3:
-									pixIdx	=	pixIdxRowStart + (xxx * 3);
-
-									//*	openCV uses BGR instead of RGB
-									//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
-
-									if (force8BitRead)
-									{
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].BluValue) & 0x00ff;
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].GrnValue) & 0x00ff;
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].RedValue) & 0x00ff;
-									}
-									else
-									{
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].BluValue >> 8) & 0x00ff;
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].GrnValue >> 8) & 0x00ff;
-										myOpenCVimage->data[pixIdx++]	=	(imageArray[iii].RedValue >> 8) & 0x00ff;
-									}
-									break;
-							}
-
-							iii++;
-							//*	advance to the next row
-							pixIdxRowStart	+=	imageWidthStep;
-						}
-					}
-					DEBUG_TIMING("Image stuffing (ms)");
-					CONSOLE_DEBUG_W_NUM("iii\t\t=",		iii);
-				}
-			}
-			else
-			{
-				CONSOLE_DEBUG("imgRank is invalid");
-			}
-			free(imageArray);
+			//*	the caller owns it now
+			myOpenCVimage	=	cDownloadImage;
+			cDownloadImage	=	NULL;
+			CONSOLE_DEBUG_W_NUM("width \t\t=",		myOpenCVimage->cols);
+			CONSOLE_DEBUG_W_NUM("height\t\t=",		myOpenCVimage->rows);
+			CONSOLE_DEBUG_W_LONG("widthStep\t=",	myOpenCVimage->step[0]);
 		}
 		else
 		{
-			CONSOLE_DEBUG("Failed to allocate image buffer");
+			CONSOLE_DEBUG("imgRank is invalid");
 		}
+		ReleaseDownloadImage();
 	}
 	else
 	{
@@ -2153,15 +2054,7 @@ IplImage	*ControllerCamera::DownloadImage_imagearray(const bool force8BitRead, c
 IplImage		*myOpenCVimage	=	NULL;
 int				pixelCount;
 int				valuesRead;
-int				iii;
-int				xxx;
-int				yyy;
-int				pixIdx;
-int				pixIdxRowStart;
 int				imgRank;
-TYPE_ImageArray	*imageArray;
-int				buffSize;
-
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_NUM("cCameraProp.CameraXsize\t=",	cCameraProp.CameraXsize);
@@ -2169,95 +2062,42 @@ int				buffSize;
 	CONSOLE_DEBUG_W_NUM("force8BitRead\t\t=",	force8BitRead);
 	CONSOLE_DEBUG_W_NUM("allowBinary\t\t=",		allowBinary);
 
-	imageArray		=	NULL;
+	memset((void *)&cBinaryImageHdr, 0, sizeof(TYPE_BinaryImageHdr));
+	cBinaryImageHdr.MetadataVersion			=	-1;
+
 	pixelCount		=	cCameraProp.CameraXsize * cCameraProp.CameraYsize;
 	if (pixelCount > 0)
 	{
 		CONSOLE_DEBUG_W_NUM("pixelCount\t=", pixelCount);
-		buffSize	=	(pixelCount + 100) * sizeof(TYPE_ImageArray);
-		CONSOLE_DEBUG_W_NUM("buffSize\t=", buffSize);
-//		imageArray	=	(TYPE_ImageArray *)malloc(buffSize);
-		imageArray	=	(TYPE_ImageArray *)calloc(1, buffSize);
-		if (imageArray!= NULL)
+		valuesRead	=	0;
+		CONSOLE_DEBUG("Calling AlpacaGetImageArray()");
+		SETUP_TIMING();
+		imgRank	=	AlpacaGetImageArray(	"camera",
+											cAlpacaDevNum,
+											"imagearray",
+											"",
+											allowBinary,
+											force8BitRead,
+											pixelCount,
+											&valuesRead);
+
+		DEBUG_TIMING("Image downloading (ms)");
+		CONSOLE_DEBUG_W_NUM("imgRank\t\t=",		imgRank);
+		CONSOLE_DEBUG_W_NUM("valuesRead\t\t=",	valuesRead);
+		if ((imgRank > 0) && (valuesRead > 10) && (cDownloadImage != NULL))
 		{
-			memset(imageArray, 0, buffSize);
-			valuesRead	=	0;
-			CONSOLE_DEBUG("Calling AlpacaGetImageArray()");
-			SETUP_TIMING();
-			imgRank	=	AlpacaGetImageArray(	"camera",
-												cAlpacaDevNum,
-												"imagearray",
-												"",
-												allowBinary,
-												imageArray,
-												pixelCount,
-												&valuesRead);
-
-			DEBUG_TIMING("Image downloading (ms)");
-			CONSOLE_DEBUG_W_NUM("imgRank\t\t=",		imgRank);
-			CONSOLE_DEBUG_W_NUM("valuesRead\t\t=",	valuesRead);
-			if ((imgRank > 0) && (valuesRead > 10))
-			{
-				myOpenCVimage	=	cvCreateImage(cvSize(	cCameraProp.CameraXsize, cCameraProp.CameraYsize),
-															IPL_DEPTH_8U,
-															3);
-				if (myOpenCVimage != NULL)
-				{
-					if (myOpenCVimage->imageData != NULL)
-					{
-						memset(myOpenCVimage->imageData, 128, (myOpenCVimage->height * myOpenCVimage->widthStep));
-					}
-					CONSOLE_DEBUG_W_NUM("width \t\t=",	myOpenCVimage->width);
-					CONSOLE_DEBUG_W_NUM("height\t\t=",	myOpenCVimage->height);
-					CONSOLE_DEBUG_W_NUM("widthStep\t=",	myOpenCVimage->widthStep);
-
-					//*	move the image data into the openCV image structure
-					START_TIMING();
-					iii	=	0;
-					//*	stepping ACROSS the field
-					for (xxx=0; xxx < myOpenCVimage->width; xxx++)
-					{
-						pixIdxRowStart	=	0;
-						//*	stepping DOWN the column
-						for (yyy=0; yyy < myOpenCVimage->height; yyy++)
-						{
-							pixIdx	=	pixIdxRowStart + (xxx * 3);
-
-							//*	openCV uses BGR instead of RGB
-							//*	https://docs.opencv.org/master/df/d24/tutorial_js_image_display.html
-
-							if (force8BitRead)
-							{
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].BluValue) & 0x00ff;
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].GrnValue) & 0x00ff;
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].RedValue) & 0x00ff;
-							}
-							else
-							{
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].BluValue >> 8) & 0x00ff;
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].GrnValue >> 8) & 0x00ff;
-								myOpenCVimage->imageData[pixIdx++]	=	(imageArray[iii].RedValue >> 8) & 0x00ff;
-							}
-
-							iii++;
-							//*	advance to the next row
-							pixIdxRowStart	+=	myOpenCVimage->widthStep;
-						}
-					}
-					DEBUG_TIMING("Image stuffing (ms)");
-					CONSOLE_DEBUG_W_NUM("iii\t\t=",		iii);
-				}
-			}
-			else
-			{
-				CONSOLE_DEBUG("imgRank is invalid");
-			}
-			free(imageArray);
+			//*	the caller owns it now
+			myOpenCVimage	=	cDownloadImage;
+			cDownloadImage	=	NULL;
+			CONSOLE_DEBUG_W_NUM("width \t\t=",	myOpenCVimage->width);
+			CONSOLE_DEBUG_W_NUM("height\t\t=",	myOpenCVimage->height);
+			CONSOLE_DEBUG_W_NUM("widthStep\t=",	myOpenCVimage->widthStep);
 		}
 		else
 		{
-			CONSOLE_DEBUG("Failed to allocate image buffer");
+			CONSOLE_DEBUG("imgRank is invalid");
 		}
+		ReleaseDownloadImage();
 	}
 	else
 	{
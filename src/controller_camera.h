@@ -37,6 +37,26 @@ typedef struct
 	bool	hasPNG;
 } TYPE_REMOTE_FILE;
 
+//**************************************************************************************
+//*	where the downloaded image array goes.
+//*	The image array is sent in column order, so the pixels are stored straight into
+//*	the rows of the openCV image as they arrive at the native depth of the data,
+//*	there is no intermediate array
+//**************************************************************************************
+typedef struct
+{
+	unsigned char	*pixelData;			//*	top left pixel
+	int				width;
+	int				height;
+	int				rowStride;			//*	bytes per row
+	int				bytesPerPixel;		//*	1=mono 8 bit, 2=mono 16 bit, 3=BGR 24 bit
+	bool			useLowByte;			//*	values are 0-255 instead of 0-65535
+	int				maxValue;			//*	largest mono value stored
+	int				xxx;				//*	where the next pixel goes
+	int				yyy;
+	unsigned char	*pixelPtr;
+} TYPE_ImageDownloadBuf;
+
 //*****************************************************************************
 typedef struct
 {
@@ -230,24 +250,22 @@ class ControllerCamera: public Controller
 												const char		*alpacaCmd,
 												const char		*dataString,
 												const bool		allowBinary,
-												TYPE_ImageArray	*imageArray,
+												const bool		force8BitRead,
 												int				arrayLength,
 												int				*actualValueCnt);
-				int		AlpacaGetImageArray_JSON(	TYPE_ImageArray	*imageArray,
-													int				arrayLength,
-													int				*actualValueCnt);
-				void	AlpacaGetImageArray_Binary_Byte(	TYPE_ImageArray	*imageArray,
-															int				arrayLength);
-
-				void	AlpacaGetImageArray_Binary_Int16(	TYPE_ImageArray	*imageArray,
-															int				arrayLength);
-
-				void	AlpacaGetImageArray_Binary_Int32(	TYPE_ImageArray	*imageArray,
-															int				arrayLength);
-
-				int		AlpacaGetImageArray_Binary(			TYPE_ImageArray	*imageArray,
-															int				arrayLength,
-															int				*actualValueCnt);
+				int		AlpacaGetImageArray_JSON(			int		arrayLength,
+															int		*actualValueCnt);
+				void	AlpacaGetImageArray_Binary_Byte(	const char *dataBuff, const int dataLen, int arrayLength);
+				void	AlpacaGetImageArray_Binary_Int16(	const char *dataBuff, const int dataLen, int arrayLength);
+				void	AlpacaGetImageArray_Binary_Int32(	const char *dataBuff, const int dataLen, int arrayLength);
+				void	AlpacaGetImageArray_Binary_Block(	const char *dataBuff, const int dataLen, int arrayLength);
+				int		AlpacaGetImageArray_Binary(			int		arrayLength,
+															int		*actualValueCnt);
+				int		AlpacaGetImageArray_BinaryBulk(		int		arrayLength,
+															int		*actualValueCnt);
+				bool	CreateDownloadImage(const int imgRank, const bool binaryData);
+				void	ReduceDownloadImage(void);
+				void	ReleaseDownloadImage(void);
 
 				void	UpdateImageProgressBar(int maxArrayLength);
 
@@ -269,6 +287,12 @@ class ControllerCamera: public Controller
 				int						cImgArrayType;
 				int						cRGBidx;
 				char					cReturnedData[kReadBuffLen + 10];
+				TYPE_ImageDownloadBuf	cDownloadBuf;
+			#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+				cv::Mat					*cDownloadImage;
+			#else
+				IplImage				*cDownloadImage;
+			#endif
 
 				uint32_t				tStartMillisecs;
 				uint32_t				tCurrentMillisecs;
@@ -465,7 +465,7 @@ TYPE_ShutterStatus	newShutterStatus;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/%s/%d/%s", "shutter", cShutterAlpacaDevNum, "readall");
 
 	validData	=	GetJsonResponse(	&cShutterDeviceAddress,
@@ -533,7 +533,7 @@ char			myDataString[512];
 	CONSOLE_DEBUG_W_STR(__FUNCTION__, alpacaDevice);
 	CONSOLE_DEBUG_W_STR(__FUNCTION__, alpacaCmd);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 
 	sprintf(alpacaString, "/api/v1/%s/%d/%s", alpacaDevice, cShutterAlpacaDevNum, alpacaCmd);
 	if (strlen(dataString) > 0)
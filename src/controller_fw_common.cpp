@@ -70,7 +70,7 @@ char			returnDataString[128];
 #endif
 	//===============================================================
 	//*	get the filter wheel names
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/filterwheel/%d/names", cAlpacaDevNum);
 	validData	=	GetJsonResponse(	&cDeviceAddress,
 										cPort,
@@ -139,7 +139,7 @@ char			returnDataString[128];
 	}
 	//===============================================================
 	//*	get the filter focus offsets
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	sprintf(alpacaString,	"/api/v1/filterwheel/%d/focusoffsets", cAlpacaDevNum);
 	validData	=	GetJsonResponse(	&cDeviceAddress,
 										cPort,
@@ -43,6 +43,7 @@
 //*	May  5,	2024	<MLS> Changed DrawTitleBlock_FITS() to DrawTitleBlock_ImageHeader()
 //*	May  5,	2024	<MLS> Added image header support for NASA PDS images
 //*	May  5,	2024	<MLS> Added RunFastBackgroundTasks() to controller_image.cpp
+//*	Oct 18,	2026	<AGT> cOriginalImage now shares the pixel data instead of making a copy
 //*****************************************************************************
 
 #ifdef _ENABLE_CTRL_IMAGE_
@@ -711,7 +712,9 @@ bool	validImg;
 	if (newOpenCVImage != NULL)
 	{
 
-		cOriginalImage	=	newOpenCVImage->clone();
+		//*	this shares the pixel data with the supplied image (reference counted),
+		//*	a downloaded image can be very large and we dont need a second copy
+		cOriginalImage	=	*newOpenCVImage;
 //		openCVerr		=	cv::imwrite("cOriginalImage.jpg", cOriginalImage);
 		//*	ok, now its time to CREATE our own image, we are going to make it the same as the
 		//*	supplied image
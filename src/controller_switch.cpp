@@ -264,7 +264,7 @@ bool			myCanWriteFlag;
 //		CONSOLE_DEBUG(__FUNCTION__);
 		//===============================================================================
 		//*	get the switch name
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/switch/%d/getswitchname?Id=%d", cAlpacaDevNum, switchNum);
 		sprintf(dataString,		"Id=%d", switchNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
@@ -290,7 +290,7 @@ bool			myCanWriteFlag;
 
 		//===============================================================================
 		//*	get the switch description
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/switch/%d/getswitchdescription?Id=%d", cAlpacaDevNum, switchNum);
 //		sprintf(dataString,		"Id=%d", switchNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
@@ -432,7 +432,7 @@ int				switchValue;
 //		CONSOLE_DEBUG_W_NUM("working on switch #", switchNum);
 		//-------------------------------------------------------------------------------
 		//*	get the switch state
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/switch/%d/getswitch?Id=%d", cAlpacaDevNum, switchNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
 											cPort,
@@ -475,7 +475,7 @@ int				switchValue;
 
 		//-------------------------------------------------------------------------------
 		//*	get the switch value
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/switch/%d/getswitchvalue?Id=%d", cAlpacaDevNum, switchNum);
 		validData	=	GetJsonResponse(	&cDeviceAddress,
 											cPort,
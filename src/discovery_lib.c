@@ -13,6 +13,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb 11,	2020	<MLS> Created discover_lib.c to re-organize code for multiple apps
 //*	Feb 23,	2020	<MLS> Added LookupNames() to link /etc/hosts to ip addresses
@@ -26,6 +27,8 @@
 //*	Jun 29,	2023	<MLS> Fixed bug AddUnitToList(): 2 ports on same IP not recognized
 //*	Jul  8,	2023	<MLS> Added DumpRemoteDevice()
 //*	Apr 14,	2024	<MLS> Added DumpAlpacaUnit()
+//*	Oct 18,	2026	<AGT> Use SJP_AddToken() for the external IP list
+//*	Oct 18,	2026	<AGT> PollAllDevices() now uses discovery_poller, removed SendGetRequest()
 //*****************************************************************************
 
 
@@ -54,6 +57,7 @@
 #include	"alpaca_defs.h"
 #include	"discovery_lib.h"
 #include	"sendrequest_lib.h"
+#include	"discovery_poller.h"
 
 
 
@@ -244,128 +248,51 @@ char			myVersionString[64];
 }
 
 //*****************************************************************************
-static void	SendGetRequest(TYPE_ALPACA_UNIT *theUnit, const char *sendData)
+static void	PollDoneProc_AlpacaUnit(TYPE_POLL_REQUEST *pollRequest, SJP_Parser_t *jsonParser)
 {
-int					socket_desc;
-struct sockaddr_in	remoteDev;
-int					connRetCode;
-int					sendRetCode;
-int					closeRetCode;
-int					shutDownRetCode;
-int					recvByteCnt;
-char				returnedData[kReadBuffLen];
-char				xmitBuffer[kReadBuffLen];
-SJP_Parser_t		jsonParser;
-char				ipAddrSt[32];
-struct timeval		timeoutLength;
-int					setOptRetCode;
-
-	CONSOLE_DEBUG(__FUNCTION__);
-	CONSOLE_DEBUG_W_NUM("kReadBuffLen\t=", kReadBuffLen);
-
-	if (theUnit->deviceAddress.sin_addr.s_addr != 0)
+	if (pollRequest->validData)
 	{
-		inet_ntop(AF_INET, &(theUnit->deviceAddress.sin_addr), ipAddrSt, INET_ADDRSTRLEN);
-		CONSOLE_DEBUG_W_STR("Sending get request to", ipAddrSt);
-
-		socket_desc	=	socket(AF_INET , SOCK_STREAM , 0);
-		if (socket_desc >= 0)
-		{
-			//*	set a timeout
-			timeoutLength.tv_sec	=	1;
-			timeoutLength.tv_usec	=	0;
-			setOptRetCode			=	setsockopt(	socket_desc,
-													SOL_SOCKET,
-													SO_RCVTIMEO,
-													&timeoutLength,
-													sizeof(timeoutLength));
-			if (setOptRetCode < 0)
-			{
-				perror("setsockopt(SO_BROADCAST) failed");
-			}
-
-			remoteDev.sin_addr.s_addr	=	theUnit->deviceAddress.sin_addr.s_addr;
-			remoteDev.sin_family		=	AF_INET;
-			remoteDev.sin_port			=	htons(theUnit->port);
-			//*	Connect to remote device
-			connRetCode	=	connect(socket_desc , (struct sockaddr *)&remoteDev , sizeof(remoteDev));
-			if (connRetCode >= 0)
-			{
-				strcpy(xmitBuffer, "GET ");
-				strcat(xmitBuffer, sendData);
-
-				strcat(xmitBuffer, " HTTP/1.1");
-				strcat(xmitBuffer, "\r\n");
-				strcat(xmitBuffer, "Host: 127.0.0.1:6800");
-				strcat(xmitBuffer, "\r\n");
-				strcat(xmitBuffer, "Connection: keep-alive");
-				strcat(xmitBuffer, "\r\n");
-				strcat(xmitBuffer, "Accept: text/html,application/json");
-				strcat(xmitBuffer, "User-Agent: AlpacaPi");
-				strcat(xmitBuffer, "\r\n");
-				strcat(xmitBuffer, "\r\n");
-
-				sendRetCode	=	send(socket_desc , xmitBuffer , strlen(xmitBuffer) , 0);
-				if (sendRetCode >= 0)
-				{
-					recvByteCnt	=	recv(socket_desc, returnedData , kReadBuffLen , 0);
-					if (recvByteCnt >= 0)
-					{
-						returnedData[recvByteCnt]	=	0;
-	//					printf("%s\r\n", returnedData);
-						SJP_Init(&jsonParser);
-						SJP_ParseData(&jsonParser, returnedData);
-	//					SJP_DumpJsonData(&jsonParser);
-
-						ExtractDevicesFromJSON(&jsonParser, theUnit);
-					}
-				}
-				shutDownRetCode	=	shutdown(socket_desc, SHUT_RDWR);
-				if (shutDownRetCode != 0)
-				{
-					CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
-					CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-				}
-				closeRetCode	=	close(socket_desc);
-				if (closeRetCode != 0)
-				{
-					CONSOLE_DEBUG_W_NUM("closeRetCode\t=", closeRetCode);
-					CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-				}
-			}
-			else if (errno == ECONNREFUSED)
-			{
-				CONSOLE_DEBUG_W_NUM("connect refused", (theUnit->deviceAddress.sin_addr.s_addr >> 24));
-			}
-			else
-			{
-	//			CONSOLE_DEBUG("connect error");
-	//			CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-			}
-		}
-	}
-	else
-	{
-		CONSOLE_DEBUG("Cannot sent request to 0.0.0.0");
-//		CONSOLE_ABORT(__FUNCTION__);
+		ExtractDevicesFromJSON(jsonParser, &gAlpacaUnitList[pollRequest->userIndex]);
 	}
 }
 
+//*****************************************************************************
+//*	all of the units are queried at the same time
 //*****************************************************************************
 static void	PollAllDevices(void)
 {
-int		iii;
+TYPE_POLL_REQUEST	*pollRequests;
+int					requestCnt;
+int					iii;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	for (iii=0; iii<gAlpacaUnitCnt; iii++)
+	pollRequests	=	(TYPE_POLL_REQUEST *)malloc(kMaxAlpacaIPaddrCnt * sizeof(TYPE_POLL_REQUEST));
+	if (pollRequests != NULL)
 	{
-	//	SendGetRequest(&gAlpacaUnitList[iii], "/api/v1/management/0/configureddevices");
-		SendGetRequest(&gAlpacaUnitList[iii], "/management/v1/configureddevices");
-	//	usleep(100);
+		requestCnt	=	0;
+		for (iii=0; iii<gAlpacaUnitCnt; iii++)
+		{
+			if (gAlpacaUnitList[iii].deviceAddress.sin_addr.s_addr != 0)
+			{
+			//	"/api/v1/management/0/configureddevices"
+				DiscoveryPoller_InitRequest(	&pollRequests[requestCnt],
+												&gAlpacaUnitList[iii].deviceAddress,
+												gAlpacaUnitList[iii].port,
+												"/management/v1/configureddevices",
+												iii,
+												0);
+				requestCnt++;
+			}
+			else
+			{
+				CONSOLE_DEBUG("Cannot sent request to 0.0.0.0");
+			}
+		}
+		DiscoveryPoller_Run(pollRequests, requestCnt, &PollDoneProc_AlpacaUnit);
+		free(pollRequests);
 	}
 }
 
-
 //*****************************************************************************
 //*	a unit is a single IP address that speaks alpaca
 //*****************************************************************************
@@ -646,6 +573,7 @@ int					alpacaIPaddrCnt;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
+	SJP_Init(&jsonParser);
 	alpacaIPaddrCnt	=	0;
 
 	//*	send the broadcast message to everyone
@@ -670,7 +598,6 @@ int					alpacaIPaddrCnt;
 			readBuffer[rcvCnt]	=	0;
 //				CONSOLE_DEBUG("We have data");
 //				CONSOLE_DEBUG_W_STR("readBuffer=", readBuffer);
-			SJP_Init(&jsonParser);
 			SJP_ParseData(&jsonParser, readBuffer);
 //			SJP_DumpJsonData(&jsonParser);
 
@@ -701,6 +628,7 @@ int					alpacaIPaddrCnt;
 //		CONSOLE_DEBUG_W_NUM("from.sin_addr=", ((from.sin_addr.s_addr) & 0x0ff));
 
 	}
+	SJP_Release(&jsonParser);
 
 	ReadExternalIPlist();
 
@@ -730,6 +658,7 @@ struct sockaddr_in	from;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
+	SJP_Init(&jsonParser);
 	//*	see if there is a file listing extra IP address
 	filePointer	=	fopen(fileName, "r");
 	if (filePointer != NULL)
@@ -750,15 +679,13 @@ struct sockaddr_in	from;
 			slen	=	strlen(lineBuff);
 			if ((slen > 6) && (lineBuff[0] != '#'))
 			{
-				SJP_Init(&jsonParser);
+				SJP_Reset(&jsonParser);
 				inet_pton(AF_INET, lineBuff, &(from.sin_addr));
 
 				inet_ntop(AF_INET, &(from.sin_addr), outputIPaddr, INET_ADDRSTRLEN);
 				CONSOLE_DEBUG_W_STR("outputIPaddr\t\t=",		outputIPaddr);
 
-				strcpy(jsonParser.dataList[0].keyword, "ALPACAPORT");
-				strcpy(jsonParser.dataList[0].valueString, "6800");
-				jsonParser.tokenCount_Data	=	1;
+				SJP_AddToken(&jsonParser, "ALPACAPORT", "6800");
 
 //				SJP_DumpJsonData(&jsonParser);
 				AddUnitToList(&from, &jsonParser);
@@ -766,6 +693,7 @@ struct sockaddr_in	from;
 		}
 		fclose(filePointer);
 	}
+	SJP_Release(&jsonParser);
 }
 
 //*****************************************************************************
@@ -0,0 +1,635 @@
+//*****************************************************************************
+//*
+//*	Name:			discovery_poller.c
+//*
+//*	Author:			agent (C) 2026
+//*
+//*	Description:	Sends the periodic GET requests to all of the alpaca units in parallel
+//*
+//*	Usage notes:	The old way was one blocking connect/send/recv after another,
+//*					one unit that was turned off held up the whole list for the
+//*					length of the socket timeout.
+//*					All of the sockets are now non-blocking and watched with epoll,
+//*					up to gMaxInFlight requests are outstanding at once and only
+//*					one request at a time goes to each host.
+//*					The whole list now takes about as long as the slowest unit.
+//*
+//*					A host that fails is skipped until its backoff time has passed,
+//*					the backoff doubles for each failure in a row.
+//*					Hearing from the host (i.e. discovery response) clears the backoff.
+//*
+//*					Not re-entrant, only call DiscoveryPoller_Run() from one thread.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created discovery_poller.c
+//*****************************************************************************
+
+//#define	_DEBUG_POLLER_
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<unistd.h>
+#include	<stdbool.h>
+#include	<string.h>
+#include	<time.h>
+#include	<errno.h>
+#include	<sys/types.h>
+#include	<sys/socket.h>
+#include	<sys/epoll.h>
+#include	<arpa/inet.h>
+#include	<netinet/in.h>
+
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"json_parse.h"
+#include	"sendrequest_lib.h"
+#include	"discovery_poller.h"
+
+#define	kPollXmitBuffLen	512
+
+//*****************************************************************************
+//*	one for each request that is in flight
+//*****************************************************************************
+typedef struct
+{
+	bool	inUse;
+	int		xmitLen;
+	int		xmitSent;
+	int		recvByteCnt;
+	char	xmitBuffer[kPollXmitBuffLen];
+	char	returnedData[kReadBuffLen + 1];
+} TYPE_POLL_SLOT;
+
+//*****************************************************************************
+typedef struct
+{
+	struct sockaddr_in	deviceAddress;
+	int					port;
+	int					healthState;
+	int					failCnt;			//*	failures in a row
+	time_t				nextAttemptTime;	//*	0 = no backoff
+	long				lastResponse_ms;
+	bool				busy;				//*	a request is in flight to this host
+} TYPE_POLL_HOST;
+
+static	TYPE_POLL_SLOT	gPollSlots[kPollMaxInFlight];
+static	TYPE_POLL_HOST	gPollHosts[kPollMaxHosts];
+static	int				gPollHostCnt	=	0;
+static	int				gMaxInFlight	=	kPollDefaultInFlight;
+
+//*****************************************************************************
+static long	GetPollMilliSecs(void)
+{
+struct timespec	currentTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+	return((currentTime.tv_sec * 1000L) + (currentTime.tv_nsec / 1000000L));
+}
+
+//*****************************************************************************
+//*	returns NULL if the host table is full, the host is then never backed off
+//*****************************************************************************
+static TYPE_POLL_HOST	*FindPollHost(const struct sockaddr_in *deviceAddress, const int port, const bool addIfMissing)
+{
+TYPE_POLL_HOST	*pollHost;
+int				iii;
+
+	pollHost	=	NULL;
+	iii			=	0;
+	while ((pollHost == NULL) && (iii < gPollHostCnt))
+	{
+		if ((gPollHosts[iii].deviceAddress.sin_addr.s_addr == deviceAddress->sin_addr.s_addr) &&
+			(gPollHosts[iii].port == port))
+		{
+			pollHost	=	&gPollHosts[iii];
+		}
+		iii++;
+	}
+	if ((pollHost == NULL) && addIfMissing && (gPollHostCnt < kPollMaxHosts))
+	{
+		pollHost	=	&gPollHosts[gPollHostCnt];
+		memset((void *)pollHost, 0, sizeof(TYPE_POLL_HOST));
+		pollHost->deviceAddress	=	*deviceAddress;
+		pollHost->port			=	port;
+		pollHost->healthState	=	kPollHealth_Unknown;
+		gPollHostCnt++;
+	}
+	return(pollHost);
+}
+
+//*****************************************************************************
+static void	UpdateHostHealth(TYPE_POLL_HOST *pollHost, const bool validData, const long elapsed_ms)
+{
+int		backoffSecs;
+int		iii;
+char	ipString[INET_ADDRSTRLEN];
+
+	if (validData)
+	{
+		if (pollHost->healthState == kPollHealth_Down)
+		{
+			inet_ntop(AF_INET, &pollHost->deviceAddress.sin_addr, ipString, INET_ADDRSTRLEN);
+			CONSOLE_DEBUG_W_STR("Host is responding again:", ipString);
+		}
+		pollHost->healthState		=	kPollHealth_OK;
+		pollHost->failCnt			=	0;
+		pollHost->nextAttemptTime	=	0;
+		pollHost->lastResponse_ms	=	elapsed_ms;
+	}
+	else
+	{
+		pollHost->failCnt++;
+		backoffSecs	=	kPollBackoffStart_Secs;
+		iii			=	1;
+		while ((iii < pollHost->failCnt) && (backoffSecs < kPollBackoffMax_Secs))
+		{
+			backoffSecs	*=	2;
+			iii++;
+		}
+		if (backoffSecs > kPollBackoffMax_Secs)
+		{
+			backoffSecs	=	kPollBackoffMax_Secs;
+		}
+		pollHost->nextAttemptTime	=	time(NULL) + backoffSecs;
+		if (pollHost->failCnt >= kPollHostDownCount)
+		{
+			if (pollHost->healthState != kPollHealth_Down)
+			{
+				inet_ntop(AF_INET, &pollHost->deviceAddress.sin_addr, ipString, INET_ADDRSTRLEN);
+				CONSOLE_DEBUG_W_STR("Host is not responding, backing off:", ipString);
+			}
+			pollHost->healthState	=	kPollHealth_Down;
+		}
+		else
+		{
+			pollHost->healthState	=	kPollHealth_Failing;
+		}
+	}
+}
+
+//*****************************************************************************
+static int	AllocatePollSlot(void)
+{
+int		slotIdx;
+int		iii;
+
+	slotIdx	=	-1;
+	iii		=	0;
+	while ((slotIdx < 0) && (iii < gMaxInFlight))
+	{
+		if (gPollSlots[iii].inUse == false)
+		{
+			slotIdx	=	iii;
+		}
+		iii++;
+	}
+	return(slotIdx);
+}
+
+//*****************************************************************************
+//*	closes the socket, updates the host health and calls the done proc
+//*****************************************************************************
+static void	FinishRequest(	int					epollFD,
+							TYPE_POLL_REQUEST	*pollRequest,
+							const bool			validData,
+							SJP_Parser_t		*jsonParser,
+							PollDoneProc		doneProc)
+{
+TYPE_POLL_SLOT	*pollSlot;
+TYPE_POLL_HOST	*pollHost;
+
+	pollSlot	=	&gPollSlots[pollRequest->slotIdx];
+	if (pollRequest->socketDesc >= 0)
+	{
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, pollRequest->socketDesc, NULL);
+		shutdown(pollRequest->socketDesc, SHUT_RDWR);
+		close(pollRequest->socketDesc);
+		pollRequest->socketDesc	=	-1;
+	}
+	pollRequest->pollState	=	kPollState_Done;
+	pollRequest->validData	=	validData;
+	pollRequest->elapsed_ms	=	GetPollMilliSecs() - pollRequest->startTime_ms;
+
+	pollHost	=	FindPollHost(&pollRequest->deviceAddress, pollRequest->port, true);
+	if (pollHost != NULL)
+	{
+		pollHost->busy	=	false;
+		UpdateHostHealth(pollHost, validData, pollRequest->elapsed_ms);
+	}
+
+	SJP_Reset(jsonParser);
+	if (validData)
+	{
+		pollSlot->returnedData[pollSlot->recvByteCnt]	=	0;
+		SJP_ParseData(jsonParser, pollSlot->returnedData);
+	}
+	else
+	{
+	char	ipString[INET_ADDRSTRLEN];
+	char	errMsgString[128];
+
+		inet_ntop(AF_INET, &pollRequest->deviceAddress.sin_addr, ipString, INET_ADDRSTRLEN);
+		sprintf(errMsgString, "No valid data from %s:%d (%ld ms)", ipString, pollRequest->port, pollRequest->elapsed_ms);
+		CONSOLE_DEBUG(errMsgString);
+	}
+	if (doneProc != NULL)
+	{
+		doneProc(pollRequest, jsonParser);
+	}
+	pollSlot->inUse	=	false;
+}
+
+//*****************************************************************************
+//*	returns false if the request could not even be started
+//*****************************************************************************
+static bool	StartRequest(int epollFD, TYPE_POLL_REQUEST *pollRequest, const int slotIdx)
+{
+TYPE_POLL_SLOT		*pollSlot;
+struct sockaddr_in	remoteDev;
+struct epoll_event	pollEvent;
+int					connRetCode;
+bool				startedOK;
+char				ipString[INET_ADDRSTRLEN];
+
+	startedOK					=	false;
+	pollSlot					=	&gPollSlots[slotIdx];
+	pollSlot->inUse				=	true;
+	pollSlot->xmitSent			=	0;
+	pollSlot->recvByteCnt		=	0;
+	pollSlot->returnedData[0]	=	0;
+
+	//*	HTTP/1.0 so the server closes the connection when it is done
+	inet_ntop(AF_INET, &pollRequest->deviceAddress.sin_addr, ipString, INET_ADDRSTRLEN);
+	pollSlot->xmitLen	=	snprintf(	pollSlot->xmitBuffer,
+										kPollXmitBuffLen,
+										"GET %s HTTP/1.0\r\n"
+										"Host: %s:%d\r\n"
+										"%s"
+										"Accept: text/html,application/json\r\n"
+										"Connection: close\r\n"
+										"\r\n",
+										pollRequest->urlString,
+										ipString,
+										pollRequest->port,
+										gUserAgentAlpacaPiStr);
+	if (pollSlot->xmitLen >= kPollXmitBuffLen)
+	{
+		pollSlot->xmitLen	=	kPollXmitBuffLen - 1;
+	}
+
+	pollRequest->slotIdx		=	slotIdx;
+	pollRequest->startTime_ms	=	GetPollMilliSecs();
+	pollRequest->pollState		=	kPollState_Connecting;
+	pollRequest->socketDesc		=	socket(AF_INET, (SOCK_STREAM | SOCK_NONBLOCK), 0);
+	if (pollRequest->socketDesc >= 0)
+	{
+		memset((void *)&remoteDev, 0, sizeof(remoteDev));
+		remoteDev.sin_addr.s_addr	=	pollRequest->deviceAddress.sin_addr.s_addr;
+		remoteDev.sin_family		=	AF_INET;
+		remoteDev.sin_port			=	htons(pollRequest->port);
+		connRetCode	=	connect(pollRequest->socketDesc, (struct sockaddr *)&remoteDev, sizeof(remoteDev));
+		if ((connRetCode == 0) || (errno == EINPROGRESS))
+		{
+			//*	writable means the connect finished, one way or the other
+			memset((void *)&pollEvent, 0, sizeof(pollEvent));
+			pollEvent.events	=	EPOLLOUT;
+			pollEvent.data.ptr	=	pollRequest;
+			if (epoll_ctl(epollFD, EPOLL_CTL_ADD, pollRequest->socketDesc, &pollEvent) == 0)
+			{
+				startedOK	=	true;
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_NUM("epoll_ctl() failed, errno\t=", errno);
+			}
+		}
+	}
+	return(startedOK);
+}
+
+//*****************************************************************************
+//*	returns true when the request is finished, validData is set
+//*****************************************************************************
+static bool	HandlePollEvent(int epollFD, TYPE_POLL_REQUEST *pollRequest, const unsigned int events, bool *validData)
+{
+TYPE_POLL_SLOT		*pollSlot;
+struct epoll_event	pollEvent;
+int					socketErr;
+socklen_t			socketErrLen;
+int					byteCnt;
+bool				requestFinished;
+bool				keepReading;
+
+	pollSlot		=	&gPollSlots[pollRequest->slotIdx];
+	requestFinished	=	false;
+	*validData		=	false;
+
+	if (pollRequest->pollState == kPollState_Connecting)
+	{
+		socketErr		=	0;
+		socketErrLen	=	sizeof(socketErr);
+		getsockopt(pollRequest->socketDesc, SOL_SOCKET, SO_ERROR, &socketErr, &socketErrLen);
+		if (socketErr == 0)
+		{
+			pollRequest->pollState	=	kPollState_Sending;
+		}
+		else
+		{
+		#ifdef _DEBUG_POLLER_
+			CONSOLE_DEBUG_W_NUM("connect failed, errno\t=", socketErr);
+		#endif
+			requestFinished	=	true;
+		}
+	}
+
+	if (pollRequest->pollState == kPollState_Sending)
+	{
+		byteCnt	=	send(	pollRequest->socketDesc,
+							(pollSlot->xmitBuffer + pollSlot->xmitSent),
+							(pollSlot->xmitLen - pollSlot->xmitSent),
+							MSG_NOSIGNAL);
+		if (byteCnt > 0)
+		{
+			pollSlot->xmitSent	+=	byteCnt;
+			if (pollSlot->xmitSent >= pollSlot->xmitLen)
+			{
+				pollRequest->pollState	=	kPollState_Receiving;
+
+				memset((void *)&pollEvent, 0, sizeof(pollEvent));
+				pollEvent.events	=	EPOLLIN | EPOLLRDHUP;
+				pollEvent.data.ptr	=	pollRequest;
+				epoll_ctl(epollFD, EPOLL_CTL_MOD, pollRequest->socketDesc, &pollEvent);
+			}
+		}
+		else if ((byteCnt < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+		{
+			CONSOLE_DEBUG_W_NUM("send() error", errno);
+			requestFinished	=	true;
+		}
+	}
+	else if ((pollRequest->pollState == kPollState_Receiving) && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+	{
+		//*	read until the server closes the connection or the buffer is full
+		keepReading	=	true;
+		while (keepReading)
+		{
+			byteCnt	=	recv(	pollRequest->socketDesc,
+								(pollSlot->returnedData + pollSlot->recvByteCnt),
+								(kReadBuffLen - pollSlot->recvByteCnt),
+								0);
+			if (byteCnt > 0)
+			{
+				pollSlot->recvByteCnt	+=	byteCnt;
+				if (pollSlot->recvByteCnt >= kReadBuffLen)
+				{
+					keepReading		=	false;
+					requestFinished	=	true;
+					*validData		=	true;
+				}
+			}
+			else if (byteCnt == 0)
+			{
+				keepReading		=	false;
+				requestFinished	=	true;
+				*validData		=	true;
+			}
+			else
+			{
+				keepReading	=	false;
+				if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+				{
+					requestFinished	=	true;
+					*validData		=	(pollSlot->recvByteCnt > 0);
+				}
+			}
+		}
+	}
+	return(requestFinished);
+}
+
+//*****************************************************************************
+void	DiscoveryPoller_InitRequest(	TYPE_POLL_REQUEST			*pollRequest,
+										const struct sockaddr_in	*deviceAddress,
+										const int					port,
+										const char					*urlString,
+										const int					userIndex,
+										const int					userTag)
+{
+	memset((void *)pollRequest, 0, sizeof(TYPE_POLL_REQUEST));
+	pollRequest->deviceAddress	=	*deviceAddress;
+	pollRequest->port			=	port;
+	pollRequest->userIndex		=	userIndex;
+	pollRequest->userTag		=	userTag;
+	pollRequest->socketDesc		=	-1;
+	pollRequest->slotIdx		=	-1;
+	strncpy(pollRequest->urlString, urlString, (kPollMaxURLlen - 1));
+}
+
+//*****************************************************************************
+//*	Runs all of the requests and returns when they are all done.
+//*	doneProc is called from this thread as each one finishes, in the order
+//*	they finish, not the order of the list.
+//*****************************************************************************
+int	DiscoveryPoller_Run(TYPE_POLL_REQUEST *requestList, const int requestCnt, PollDoneProc doneProc)
+{
+int					epollFD;
+struct epoll_event	pollEvents[kPollMaxInFlight];
+int					eventCnt;
+int					waitTime_ms;
+int					timeLeft_ms;
+int					finishedCnt;
+int					inFlightCnt;
+int					validCnt;
+int					slotIdx;
+int					iii;
+long				currentTime_ms;
+bool				validData;
+TYPE_POLL_HOST		*pollHost;
+TYPE_POLL_REQUEST	*pollRequest;
+SJP_Parser_t		jsonParser;
+
+#ifdef _DEBUG_POLLER_
+	CONSOLE_DEBUG_W_NUM(__FUNCTION__, requestCnt);
+#endif
+	validCnt	=	0;
+	epollFD		=	epoll_create1(0);
+	if (epollFD >= 0)
+	{
+		SJP_Init(&jsonParser);
+	#ifdef _DEBUG_POLLER_
+		long	runStartTime_ms	=	GetPollMilliSecs();
+	#endif
+		finishedCnt		=	0;
+		inFlightCnt		=	0;
+		for (iii=0; iii<gMaxInFlight; iii++)
+		{
+			gPollSlots[iii].inUse	=	false;
+		}
+		for (iii=0; iii<gPollHostCnt; iii++)
+		{
+			gPollHosts[iii].busy	=	false;
+		}
+		for (iii=0; iii<requestCnt; iii++)
+		{
+			requestList[iii].pollState	=	kPollState_Waiting;
+			requestList[iii].validData	=	false;
+			requestList[iii].socketDesc	=	-1;
+		}
+
+		while (finishedCnt < requestCnt)
+		{
+			//-----------------------------------------------------------
+			//*	start as many as we are allowed to
+			//*	a host that fails during this run gets backed off, so the rest of
+			//*	its requests are skipped instead of waiting for the same timeout
+			iii	=	0;
+			while ((iii < requestCnt) && (inFlightCnt < gMaxInFlight))
+			{
+				pollRequest	=	&requestList[iii];
+				if (pollRequest->pollState == kPollState_Waiting)
+				{
+					pollHost	=	FindPollHost(&pollRequest->deviceAddress, pollRequest->port, true);
+					if ((pollHost != NULL) && (pollHost->nextAttemptTime > time(NULL)))
+					{
+						pollRequest->pollState	=	kPollState_Skipped;
+						finishedCnt++;
+					}
+					else if ((pollHost == NULL) || (pollHost->busy == false))
+					{
+						slotIdx	=	AllocatePollSlot();
+						if (slotIdx >= 0)
+						{
+							if (pollHost != NULL)
+							{
+								pollHost->busy	=	true;
+							}
+							inFlightCnt++;
+							if (StartRequest(epollFD, pollRequest, slotIdx) == false)
+							{
+								FinishRequest(epollFD, pollRequest, false, &jsonParser, doneProc);
+								inFlightCnt--;
+								finishedCnt++;
+							}
+						}
+					}
+				}
+				iii++;
+			}
+
+			//-----------------------------------------------------------
+			//*	wait no longer than the next time out
+			currentTime_ms	=	GetPollMilliSecs();
+			waitTime_ms		=	kPollRequestTimeOut_ms;
+			for (iii=0; iii<requestCnt; iii++)
+			{
+				pollRequest	=	&requestList[iii];
+				if ((pollRequest->pollState >= kPollState_Connecting) && (pollRequest->pollState <= kPollState_Receiving))
+				{
+					if (pollRequest->pollState == kPollState_Connecting)
+					{
+						timeLeft_ms	=	(pollRequest->startTime_ms + kPollConnectTimeOut_ms) - currentTime_ms;
+					}
+					else
+					{
+						timeLeft_ms	=	(pollRequest->startTime_ms + kPollRequestTimeOut_ms) - currentTime_ms;
+					}
+					if (timeLeft_ms < waitTime_ms)
+					{
+						waitTime_ms	=	(timeLeft_ms > 0) ? timeLeft_ms : 0;
+					}
+				}
+			}
+
+			if (inFlightCnt > 0)
+			{
+				eventCnt	=	epoll_wait(epollFD, pollEvents, kPollMaxInFlight, waitTime_ms);
+				for (iii=0; iii<eventCnt; iii++)
+				{
+					pollRequest	=	(TYPE_POLL_REQUEST *)pollEvents[iii].data.ptr;
+					if (HandlePollEvent(epollFD, pollRequest, pollEvents[iii].events, &validData))
+					{
+						FinishRequest(epollFD, pollRequest, validData, &jsonParser, doneProc);
+						if (validData)
+						{
+							validCnt++;
+						}
+						inFlightCnt--;
+						finishedCnt++;
+					}
+				}
+				if ((eventCnt < 0) && (errno != EINTR))
+				{
+					CONSOLE_DEBUG_W_NUM("epoll_wait() failed, errno\t=", errno);
+				}
+			}
+
+			//-----------------------------------------------------------
+			//*	check for time outs
+			currentTime_ms	=	GetPollMilliSecs();
+			for (iii=0; iii<requestCnt; iii++)
+			{
+				pollRequest	=	&requestList[iii];
+				if (((pollRequest->pollState == kPollState_Connecting) &&
+						(currentTime_ms >= (pollRequest->startTime_ms + kPollConnectTimeOut_ms))) ||
+					(((pollRequest->pollState == kPollState_Sending) || (pollRequest->pollState == kPollState_Receiving)) &&
+						(currentTime_ms >= (pollRequest->startTime_ms + kPollRequestTimeOut_ms))))
+				{
+				#ifdef _DEBUG_POLLER_
+					CONSOLE_DEBUG_W_STR("Timed out:", pollRequest->urlString);
+				#endif
+					//*	whatever we have so far is better than nothing
+					validData	=	((pollRequest->pollState == kPollState_Receiving) &&
+									(gPollSlots[pollRequest->slotIdx].recvByteCnt > 0));
+					FinishRequest(epollFD, pollRequest, validData, &jsonParser, doneProc);
+					if (validData)
+					{
+						validCnt++;
+					}
+					inFlightCnt--;
+					finishedCnt++;
+				}
+			}
+		}
+		SJP_Release(&jsonParser);
+		close(epollFD);
+
+	#ifdef _DEBUG_POLLER_
+		CONSOLE_DEBUG_W_NUM("validCnt      \t=", validCnt);
+		CONSOLE_DEBUG_W_LONG("Total time ms\t=", (GetPollMilliSecs() - runStartTime_ms));
+	#endif
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_NUM("epoll_create1() failed, errno\t=", errno);
+		validCnt	=	-1;
+	}
+	return(validCnt);
+}
+
+//*****************************************************************************
+void	DiscoveryPoller_SetMaxInFlight(const int maxInFlight)
+{
+	if ((maxInFlight >= 1) && (maxInFlight <= kPollMaxInFlight))
+	{
+		gMaxInFlight	=	maxInFlight;
+	}
+}
+
+//*****************************************************************************
+//*	we heard from this host some other way, no need to wait out the backoff
+//*****************************************************************************
+void	DiscoveryPoller_HostIsAlive(const struct sockaddr_in *deviceAddress, const int port)
+{
+TYPE_POLL_HOST	*pollHost;
+
+	pollHost	=	FindPollHost(deviceAddress, port, false);
+	if (pollHost != NULL)
+	{
+		pollHost->failCnt			=	0;
+		pollHost->nextAttemptTime	=	0;
+	}
+}
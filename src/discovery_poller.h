@@ -0,0 +1,111 @@
+//*****************************************************************************
+//*	Name:			discovery_poller.h
+//*
+//*	Author:			agent
+//*
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created discovery_poller.h
+//*****************************************************************************
+//#include	"discovery_poller.h"
+
+#ifndef _DISCOVERY_POLLER_H_
+#define	_DISCOVERY_POLLER_H_
+
+#ifndef _ARPA_INET_H
+	#include	<arpa/inet.h>
+#endif
+
+#ifndef _STDBOOL_H
+	#include	<stdbool.h>
+#endif
+
+#ifndef _JSON_PARSE_H_
+	#include	"json_parse.h"
+#endif
+
+#define	kPollDefaultInFlight		32
+#define	kPollMaxInFlight			64
+#define	kPollConnectTimeOut_ms		2000
+#define	kPollRequestTimeOut_ms		5000		//*	from the start of the connect
+#define	kPollBackoffStart_Secs		60			//*	doubled for each failure in a row
+#define	kPollBackoffMax_Secs		(15 * 60)
+#define	kPollHostDownCount			3			//*	failures in a row before a host is "down"
+#define	kPollMaxHosts				256
+#define	kPollMaxURLlen				128
+
+//*****************************************************************************
+//*	host health, kept by the poller for each IP address:port
+//*****************************************************************************
+enum
+{
+	kPollHealth_Unknown	=	0,
+	kPollHealth_OK,
+	kPollHealth_Failing,
+	kPollHealth_Down
+
+};
+
+//*****************************************************************************
+enum
+{
+	kPollState_Waiting	=	0,
+	kPollState_Connecting,
+	kPollState_Sending,
+	kPollState_Receiving,
+	kPollState_Done,
+	kPollState_Skipped			//*	host is backing off, the done proc is not called
+
+};
+
+//*****************************************************************************
+typedef struct
+{
+	//*	set by DiscoveryPoller_InitRequest()
+	struct sockaddr_in	deviceAddress;
+	int					port;
+	char				urlString[kPollMaxURLlen];
+	int					userIndex;			//*	for use by the caller, i.e. index into the unit list
+	int					userTag;			//*	for use by the caller, i.e. which request this is
+
+	//*	filled in by the poller
+	int					pollState;
+	bool				validData;
+	int					socketDesc;
+	int					slotIdx;
+	long				startTime_ms;
+	long				elapsed_ms;
+} TYPE_POLL_REQUEST;
+
+//*****************************************************************************
+//*	called from DiscoveryPoller_Run() as each request finishes.
+//*	jsonParser only has data if pollRequest->validData is true
+//*****************************************************************************
+typedef void (*PollDoneProc)(TYPE_POLL_REQUEST *pollRequest, SJP_Parser_t *jsonParser);
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+void	DiscoveryPoller_InitRequest(	TYPE_POLL_REQUEST			*pollRequest,
+										const struct sockaddr_in	*deviceAddress,
+										const int					port,
+										const char					*urlString,
+										const int					userIndex,
+										const int					userTag);
+
+//*	returns the number of requests that returned valid data, -1 if epoll failed
+int		DiscoveryPoller_Run(TYPE_POLL_REQUEST *requestList, const int requestCnt, PollDoneProc doneProc);
+void	DiscoveryPoller_SetMaxInFlight(const int maxInFlight);
+void	DiscoveryPoller_HostIsAlive(const struct sockaddr_in *deviceAddress, const int port);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif		//	_DISCOVERY_POLLER_H_
@@ -7,6 +7,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Oct 20,	2019	<MLS> Added DiscoveryThread()
 //*	Jan 23,	2020	<MLS> Started on live discovery of other devices
@@ -34,6 +35,9 @@
 //*	Dec 22,	2022	<MLS> Added WakeUpDiscoveryThread()
 //*	Feb 10,	2024	<MLS> Added GetLibraryInfo()
 //*	May 15,	2024	<MLS> Added _DEBUG_DISCOVERY_
+//*	Oct 18,	2026	<AGT> Use SJP_AddToken() for the external IP list
+//*	Oct 18,	2026	<AGT> PollAllDevices() & GetInformationFromOtherDevices() now use discovery_poller
+//*	Oct 18,	2026	<AGT> Removed GetJsonResponse() & SendGetRequest()
 //*****************************************************************************
 
 //#define		_DEBUG_DISCOVERY_
@@ -70,6 +74,7 @@
 #include	"sendrequest_lib.h"
 #include	"linuxerrors.h"
 #include	"helper_functions.h"
+#include	"discovery_poller.h"
 
 #ifdef _INCLUDE_CTRL_MAIN_
 	#include	"controller_startup.h"
@@ -548,148 +553,21 @@ int					setOptRetCode;
 }
 
 //*****************************************************************************
-static bool	GetJsonResponse(	struct sockaddr_in	*deviceAddress,
-								const int			port,
-								const char			*sendData,
-								SJP_Parser_t		*jsonParser)
-{
-bool				validData;
-int					socket_desc;
-struct sockaddr_in	remoteDev;
-int					connRetCode;
-int					sendRetCode;
-int					closeRetCode;
-int					shutdownRetCode;
-int					recvByteCnt;
-char				returnedData[kReadBuffLen];
-char				xmitBuffer[kReadBuffLen];
-int					setOptRetCode;
-char				errorString[64];
-
-#ifdef _DEBUG_DISCOVERY_
-	CONSOLE_DEBUG(__FUNCTION__);
-	CONSOLE_DEBUG_W_NUM(	"kReadBuffLen        \t=",	kReadBuffLen);
-	CONSOLE_DEBUG_W_SIZE(	"sizeof(returnedData)\t=",	sizeof(returnedData));
-#endif
-
-	validData	=	false;
-	socket_desc	=	socket(AF_INET , SOCK_STREAM , 0);
-	if (socket_desc >= 0)
-	{
-		//*	Mar 13,	2021	<MLS> Added timeout to GetJsonResponse()
-		//*	Jun 25,	2023	<MLS> Increased GetJsonResponse() to 5 seconds (was 3)
-		//*	set a timeout
-		setOptRetCode	=	SetSocketTimeouts(socket_desc, 5);
-		if (setOptRetCode != 0)
-		{
-			CONSOLE_DEBUG("SetSocketTimeouts() returned error");
-		}
-
-		remoteDev.sin_addr.s_addr	=	deviceAddress->sin_addr.s_addr;
-		remoteDev.sin_family		=	AF_INET;
-		remoteDev.sin_port			=	htons(port);
-		//*	Connect to remote device
-		connRetCode	=	connect(socket_desc , (struct sockaddr *)&remoteDev , sizeof(remoteDev));
-		if (connRetCode >= 0)
-		{
-			strcpy(xmitBuffer, "GET ");
-			strcat(xmitBuffer, sendData);
-
-			strcat(xmitBuffer, " HTTP/1.0\r\n");
-			strcat(xmitBuffer, "Host: 127.0.0.1:6800\r\n");
-//			strcat(xmitBuffer, "User-Agent: AlpacaPi\r\n");
-			strcat(xmitBuffer,	gUserAgentAlpacaPiStr);
-			strcat(xmitBuffer, "Accept: text/html,application/json\r\n");
-			strcat(xmitBuffer, "\r\n");
-
-			sendRetCode	=	send(socket_desc , xmitBuffer , strlen(xmitBuffer) , 0);
-			if (sendRetCode >= 0)
-			{
-				recvByteCnt	=	recv(socket_desc, returnedData, kReadBuffLen , 0);
-				if (recvByteCnt >= 0)
-				{
-					validData					=	true;
-					returnedData[recvByteCnt]	=	0;
-//					printf("%s\r\n", returnedData);
-					SJP_Init(jsonParser);
-					SJP_ParseData(jsonParser, returnedData);
-//					SJP_DumpJsonData(jsonParser);
-				}
-			}
-			else
-			{
-				CONSOLE_DEBUG_W_NUM("send() error", errno);
-			}
-			shutdownRetCode	=	shutdown(socket_desc, SHUT_RDWR);
-			if (shutdownRetCode != 0)
-			{
-			//	CONSOLE_DEBUG_W_NUM("shutdown() error", errno);
-				GetLinuxErrorString(errno, errorString);
-				CONSOLE_DEBUG_W_STR("shutdown() error: Error message\t\t=",	errorString);
-			}
-		}
-		else if (errno == ECONNREFUSED)
-		{
-		char	ipString[32];
-
-			PrintIPaddressToString(deviceAddress->sin_addr.s_addr, ipString);
-			sprintf(errorString, "connect refused by %s:%d", ipString, port);
-			CONSOLE_DEBUG(errorString);
-		}
-		else
-		{
-
-		//	CONSOLE_DEBUG("connect error");
-		//	CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-			GetLinuxErrorString(errno, errorString);
-			CONSOLE_DEBUG_W_STR("Connect error: ErrMsg=",	errorString);
-		}
-		//*	Moved 2/4/2021
-		closeRetCode	=	close(socket_desc);
-		if (closeRetCode != 0)
-		{
-			CONSOLE_DEBUG("Close error");
-		}
-	}
-	return(validData);
-}
-
-
+//*	userTag values for the poll requests
 //*****************************************************************************
-static void	SendGetRequest(TYPE_ALPACA_UNIT *theDevice, const char *sendData)
+enum
 {
-bool				validData;
-SJP_Parser_t		jsonParser;
-char				ipString[32];
-char				errMsgString[64];
-
-#ifdef _DEBUG_DISCOVERY_
-	CONSOLE_DEBUG(__FUNCTION__);
-#endif
+	kPollReq_ConfiguredDevices	=	0,
+	kPollReq_Libraries,
+	kPollReq_CPUstats,
+	kPollReq_ObsCondDescription,
+	kPollReq_ObsCondPressure,
+	kPollReq_ObsCondHumidity
+};
 
-	validData	=	GetJsonResponse(	&theDevice->deviceAddress,
-										theDevice->port,
-										sendData,
-										&jsonParser);
-	if (validData)
-	{
-//		CONSOLE_DEBUG(sendData);
-//		SJP_DumpJsonData(&jsonParser, __FUNCTION__);
-
-		ExtractDevicesFromJSON(&jsonParser, theDevice);
-		theDevice->queryOKcnt++;
-		theDevice->currentlyActive	=	true;
-	}
-	else
-	{
-		inet_ntop(AF_INET, &theDevice->deviceAddress.sin_addr, ipString, INET_ADDRSTRLEN);
-		sprintf(errMsgString, "No valid data from %s:%d", ipString, theDevice->port);
-		CONSOLE_DEBUG(errMsgString);
+#define	kMaxPollRequests	(kMaxAlpacaIPaddrCnt * 3)
 
-		theDevice->queryERRcnt++;
-		theDevice->currentlyActive	=	false;
-	}
-}
+static	TYPE_POLL_REQUEST	gPollRequests[kMaxPollRequests];
 
 #if 0
 //*****************************************************************************
@@ -712,110 +590,155 @@ int		iii;
 // 7=LIBRARY-3           	software-cfitsio-4.0
 // 8=LIBRARY-4           	software-opencv-4.5.1
 //*****************************************************************************
-static void	GetLibraryInfo(TYPE_ALPACA_UNIT *alpacaUnit)
+static void	ProcessLibraryInfo(TYPE_ALPACA_UNIT *alpacaUnit, SJP_Parser_t *jsonParser)
 {
 int				jjj;
-bool			validData;
-SJP_Parser_t	jsonParser;
 char			*valuePtr;
 
-	validData	=	GetJsonResponse(	&alpacaUnit->deviceAddress,
-										alpacaUnit->port,
-										"/api/v1/management/0/libraries",
-										&jsonParser);
-	if (validData)
+	for (jjj=0; jjj<jsonParser->tokenCount_Data; jjj++)
 	{
-		for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
+		//*	is this a library response
+		if (strncasecmp(jsonParser->dataList[jjj].keyword, "LIBRARY", 7) == 0)
 		{
-			//*	is this a library response
-			if (strncasecmp(jsonParser.dataList[jjj].keyword, "LIBRARY", 7) == 0)
+			valuePtr	=	strchr(jsonParser->dataList[jjj].valueString, '-');
+			if (valuePtr != NULL)
 			{
-				valuePtr	=	strchr(jsonParser.dataList[jjj].valueString, '-');
-				if (valuePtr != NULL)
+				valuePtr	+=	1;
+				if (strncasecmp(jsonParser->dataList[jjj].valueString, "software-opencv", 15) == 0)
 				{
-					valuePtr	+=	1;
-					if (strncasecmp(jsonParser.dataList[jjj].valueString, "software-opencv", 15) == 0)
-					{
-						strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_OpenCV].SoftwareVerStr, valuePtr);
-					}
-					else if (strncasecmp(jsonParser.dataList[jjj].valueString, "software-cfitsio", 16) == 0)
-					{
-						strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_Fits].SoftwareVerStr, valuePtr);
-					}
-					else if (strncasecmp(jsonParser.dataList[jjj].valueString, "software-wiringPi", 17) == 0)
-					{
-						strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_WiringPi].SoftwareVerStr, valuePtr);
-					}
+					strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_OpenCV].SoftwareVerStr, valuePtr);
+				}
+				else if (strncasecmp(jsonParser->dataList[jjj].valueString, "software-cfitsio", 16) == 0)
+				{
+					strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_Fits].SoftwareVerStr, valuePtr);
+				}
+				else if (strncasecmp(jsonParser->dataList[jjj].valueString, "software-wiringPi", 17) == 0)
+				{
+					strcpy(alpacaUnit->SoftwareVersion[kSoftwareVers_WiringPi].SoftwareVerStr, valuePtr);
 				}
-			}
-			else if (strcasecmp(jsonParser.dataList[jjj].keyword, "hardware") == 0)
-			{
-				//*	this is the hardware response
-				strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Hardware].SoftwareVerStr,
-						jsonParser.dataList[jjj].valueString);
 			}
 		}
+		else if (strcasecmp(jsonParser->dataList[jjj].keyword, "hardware") == 0)
+		{
+			//*	this is the hardware response
+			strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Hardware].SoftwareVerStr,
+					jsonParser->dataList[jjj].valueString);
+		}
 	}
-	alpacaUnit->SoftwareVersionOK	=	true;
 }
 
 //*****************************************************************************
-static void	GetCPUstats(TYPE_ALPACA_UNIT *alpacaUnit)
+static void	ProcessCPUstats(TYPE_ALPACA_UNIT *alpacaUnit, SJP_Parser_t *jsonParser)
 {
 int				jjj;
-bool			validData;
-SJP_Parser_t	jsonParser;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
-	validData	=	GetJsonResponse(	&alpacaUnit->deviceAddress,
-										alpacaUnit->port,
-										"/api/v1/management/0/cpustats",
-										&jsonParser);
-	if (validData)
+	for (jjj=0; jjj<jsonParser->tokenCount_Data; jjj++)
 	{
-		for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
+		//*	is this a hardware response
+		if (strcasecmp(jsonParser->dataList[jjj].keyword, "hardware") == 0)
 		{
-			//*	is this a hardware response
-			if (strcasecmp(jsonParser.dataList[jjj].keyword, "hardware") == 0)
+			strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Hardware].SoftwareVerStr,
+					jsonParser->dataList[jjj].valueString);
+		}
+		else if (strcasecmp(jsonParser->dataList[jjj].keyword, "platform") == 0)
+		{
+//			strcpy(alpacaUnit->Platform, jsonParser->dataList[jjj].valueString);
+			strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Platform].SoftwareVerStr,
+					jsonParser->dataList[jjj].valueString);
+		}
+	}
+}
+
+//*****************************************************************************
+//*	called by the poller as each unit request finishes
+//*****************************************************************************
+static void	PollDoneProc_AlpacaUnit(TYPE_POLL_REQUEST *pollRequest, SJP_Parser_t *jsonParser)
+{
+TYPE_ALPACA_UNIT	*alpacaUnit;
+
+	alpacaUnit	=	&gAlpacaUnitList[pollRequest->userIndex];
+	switch(pollRequest->userTag)
+	{
+		case kPollReq_ConfiguredDevices:
+			if (pollRequest->validData)
 			{
-				strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Hardware].SoftwareVerStr,
-						jsonParser.dataList[jjj].valueString);
+//				SJP_DumpJsonData(jsonParser, __FUNCTION__);
+				ExtractDevicesFromJSON(jsonParser, alpacaUnit);
+				alpacaUnit->queryOKcnt++;
+				alpacaUnit->currentlyActive	=	true;
 			}
-			else if (strcasecmp(jsonParser.dataList[jjj].keyword, "platform") == 0)
+			else
 			{
-//				strcpy(alpacaUnit->Platform, jsonParser.dataList[jjj].valueString);
-				strcpy(	alpacaUnit->SoftwareVersion[kSoftwareVers_Platform].SoftwareVerStr,
-						jsonParser.dataList[jjj].valueString);
+				alpacaUnit->queryERRcnt++;
+				alpacaUnit->currentlyActive	=	false;
 			}
-		}
+			break;
+
+		case kPollReq_Libraries:
+			if (pollRequest->validData)
+			{
+				ProcessLibraryInfo(alpacaUnit, jsonParser);
+				alpacaUnit->SoftwareVersionOK	=	true;
+			}
+			break;
+
+		case kPollReq_CPUstats:
+			if (pollRequest->validData)
+			{
+				ProcessCPUstats(alpacaUnit, jsonParser);
+			}
+			break;
 	}
 }
 
+//*****************************************************************************
+//*	All of the units are polled at the same time, one that is off line
+//*	no longer holds up the rest of them.
 //*****************************************************************************
 static void	PollAllDevices(void)
 {
 int				iii;
+int				requestCnt;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_NUM("gAlpacaUnitCnt\t=", gAlpacaUnitCnt);
+	requestCnt	=	0;
 	for (iii=0; iii<gAlpacaUnitCnt; iii++)
 	{
-		if (gAlpacaUnitList[iii].noResponseCnt == 0)
+		if ((gAlpacaUnitList[iii].noResponseCnt == 0) && (requestCnt < kMaxPollRequests))
 		{
-			SendGetRequest(&gAlpacaUnitList[iii], "/management/v1/configureddevices");
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gAlpacaUnitList[iii].deviceAddress,
+											gAlpacaUnitList[iii].port,
+											"/management/v1/configureddevices",
+											iii,
+											kPollReq_ConfiguredDevices);
+			requestCnt++;
 		}
 		//-----------------------------------------------------------
 		//*	check for software versions
-		if (gAlpacaUnitList[iii].SoftwareVersionOK == false)
+		if ((gAlpacaUnitList[iii].SoftwareVersionOK == false) && ((requestCnt + 1) < kMaxPollRequests))
 		{
-			GetLibraryInfo(&gAlpacaUnitList[iii]);
-			GetCPUstats(&gAlpacaUnitList[iii]);
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gAlpacaUnitList[iii].deviceAddress,
+											gAlpacaUnitList[iii].port,
+											"/api/v1/management/0/libraries",
+											iii,
+											kPollReq_Libraries);
+			requestCnt++;
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gAlpacaUnitList[iii].deviceAddress,
+											gAlpacaUnitList[iii].port,
+											"/api/v1/management/0/cpustats",
+											iii,
+											kPollReq_CPUstats);
+			requestCnt++;
 		}
 	}
+	DiscoveryPoller_Run(gPollRequests, requestCnt, &PollDoneProc_AlpacaUnit);
 //	CONSOLE_DEBUG_W_NUM("gRemoteCnt\t=", gRemoteCnt);
 }
 
-
 #ifdef LOG_DISCOVERED_IP_ADDRS
 #ifdef _ENABLE_SKYTRAVEL_
 //*****************************************************************************
@@ -993,6 +916,8 @@ int		alpacaListenPort;
 	{
 		//*	set the last time we heard from it
 		gAlpacaUnitList[theDeviceIdx].noResponseCnt	=	0;
+		//*	it answered, no need to wait out the poller backoff
+		DiscoveryPoller_HostIsAlive(deviceAddress, alpacaListenPort);
 	}
 }
 
@@ -1024,151 +949,154 @@ char	ipAddrSt[32];
 
 
 
+#ifdef _ENABLE_CAMERA_
 //*****************************************************************************
-//*	step through the other devices and see if there is any info we want.
-static	void GetInformationFromOtherDevices(void)
+//*	results from the observingconditions devices, one entry per gRemoteList[] entry
+//*****************************************************************************
+typedef struct
 {
-int				ii;
-//char			ipAddressStr[32];
-#ifdef _ENABLE_CAMERA_
-	int				jjj;
-	SJP_Parser_t	jsonParser;
-	bool			validData;
-	bool			domeInfo;
-	double			pressure_kPa;
-	double			humidity;
-#endif // _ENABLE_CAMERA_
+	bool	domeInfo;
+	bool	pressureValid;
+	double	pressure_kPa;
+	bool	humidityValid;
+	double	humidity;
+} TYPE_OBSCOND_POLL;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
-//	CONSOLE_DEBUG_W_NUM("gRemoteCnt\t=", gRemoteCnt);
-	for (ii=0; ii<gRemoteCnt; ii++)
-	{
-	#ifdef _ENABLE_SKYTRAVEL_
-	//	CONSOLE_DEBUG_W_STR("device type\t=", gRemoteList[ii].deviceTypeStr);
+static	TYPE_OBSCOND_POLL	gObsCondPoll[kMaxAlpacaDeviceCnt];
 
-//		inet_ntop(AF_INET, &gRemoteList[ii].deviceAddress.sin_addr, ipAddressStr, INET_ADDRSTRLEN);
+//*****************************************************************************
+static void	PollDoneProc_ObsConditions(TYPE_POLL_REQUEST *pollRequest, SJP_Parser_t *jsonParser)
+{
+TYPE_OBSCOND_POLL	*obsCondPoll;
+int					jjj;
 
-//		printf("%-17s\t%-17s\t%-17s\t%-17s\t\r\n",	ipAddressStr,
-//													gRemoteList[ii].deviceTypeStr,
-//													gRemoteList[ii].deviceNameStr,
-//													gRemoteList[ii].versionString);
-	#endif
-	#ifdef _ENABLE_CAMERA_
-		if ((gRemoteList[ii].notSeenCounter == 0) &&
-			(strcmp(gRemoteList[ii].deviceTypeStr, "observingconditions") == 0))
+	obsCondPoll	=	&gObsCondPoll[pollRequest->userIndex];
+	if (pollRequest->validData)
+	{
+		for (jjj=0; jjj<jsonParser->tokenCount_Data; jjj++)
 		{
-			domeInfo	=	false;
-			//------------------------------------------------
-			//*	description
-			//*	we need the description to know if it is indoor or outdoor
-			//*	http://192.168.1.166:6800/api/v1/observingconditions/0/description
-			SJP_Init(&jsonParser);
-			validData	=	GetJsonResponse(	&gRemoteList[ii].deviceAddress,
-												gRemoteList[ii].port,
-												"/api/v1/observingconditions/0/description",
-												&jsonParser);
-			if (validData)
+			if (strcmp(jsonParser->dataList[jjj].keyword, "VALUE") == 0)
 			{
-				//*	we have valid description
-				for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
+				switch(pollRequest->userTag)
 				{
-					if (strcmp(jsonParser.dataList[jjj].keyword, "VALUE") == 0)
-					{
-						if (strncasecmp(jsonParser.dataList[jjj].valueString, "dome", 4) == 0)
+					case kPollReq_ObsCondDescription:
+						//*	we need the description to know if it is indoor or outdoor
+						if (strncasecmp(jsonParser->dataList[jjj].valueString, "dome", 4) == 0)
 						{
 	//						CONSOLE_DEBUG("We have DOME environmental information");
-							domeInfo	=	true;
+							obsCondPoll->domeInfo	=	true;
 						}
-					}
+						break;
+
+					case kPollReq_ObsCondPressure:
+						//*	the response is in hectoPascals
+						obsCondPoll->pressure_kPa	=	atof(jsonParser->dataList[jjj].valueString) / 10.0;
+						obsCondPoll->pressureValid	=	(obsCondPoll->pressure_kPa > 0.0);
+						break;
+
+					case kPollReq_ObsCondHumidity:
+						obsCondPoll->humidity		=	atof(jsonParser->dataList[jjj].valueString);
+						obsCondPoll->humidityValid	=	(obsCondPoll->humidity > 0.0);
+						break;
 				}
 			}
-			else
-			{
-				CONSOLE_DEBUG("No valid data");
-			}
+		}
+	}
+}
+#endif // _ENABLE_CAMERA_
 
-			//------------------------------------------------
-			//	pressure
-			SJP_Init(&jsonParser);
-			validData	=	GetJsonResponse(	&gRemoteList[ii].deviceAddress,
-												gRemoteList[ii].port,
-												"/api/v1/observingconditions/0/pressure",
-												&jsonParser);
-			if (validData)
+//*****************************************************************************
+//*	step through the other devices and see if there is any info we want.
+//*	all of the requests are sent at once, the dome/site decision needs the
+//*	description so the results are applied after they have all come back
+//*****************************************************************************
+static	void GetInformationFromOtherDevices(void)
+{
+#ifdef _ENABLE_CAMERA_
+	int				ii;
+	int				requestCnt;
+
+//	CONSOLE_DEBUG(__FUNCTION__);
+//	CONSOLE_DEBUG_W_NUM("gRemoteCnt\t=", gRemoteCnt);
+	requestCnt	=	0;
+	for (ii=0; ii<gRemoteCnt; ii++)
+	{
+		memset((void *)&gObsCondPoll[ii], 0, sizeof(TYPE_OBSCOND_POLL));
+		if ((gRemoteList[ii].notSeenCounter == 0) &&
+			(strcmp(gRemoteList[ii].deviceTypeStr, "observingconditions") == 0) &&
+			((requestCnt + 2) < kMaxPollRequests))
+		{
+			//*	http://192.168.1.166:6800/api/v1/observingconditions/0/description
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gRemoteList[ii].deviceAddress,
+											gRemoteList[ii].port,
+											"/api/v1/observingconditions/0/description",
+											ii,
+											kPollReq_ObsCondDescription);
+			requestCnt++;
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gRemoteList[ii].deviceAddress,
+											gRemoteList[ii].port,
+											"/api/v1/observingconditions/0/pressure",
+											ii,
+											kPollReq_ObsCondPressure);
+			requestCnt++;
+			DiscoveryPoller_InitRequest(	&gPollRequests[requestCnt],
+											&gRemoteList[ii].deviceAddress,
+											gRemoteList[ii].port,
+											"/api/v1/observingconditions/0/humidity",
+											ii,
+											kPollReq_ObsCondHumidity);
+			requestCnt++;
+		}
+	}
+	if (requestCnt > 0)
+	{
+		DiscoveryPoller_Run(gPollRequests, requestCnt, &PollDoneProc_ObsConditions);
+	}
+
+	for (ii=0; ii<gRemoteCnt; ii++)
+	{
+		//------------------------------------------------
+		//	pressure
+		if (gObsCondPoll[ii].pressureValid)
+		{
+			if (gObsCondPoll[ii].domeInfo)
 			{
-				//*	we have valid pressure
-				for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
-				{
-					if (strcmp(jsonParser.dataList[jjj].keyword, "VALUE") == 0)
-					{
-						//*	the response is in hectoPascals
-						pressure_kPa	=	atof(jsonParser.dataList[jjj].valueString) / 10.0;
-						if (pressure_kPa > 0.0)
-						{
-							if (domeInfo)
-							{
-								gEnvData.domeDataValid		=	true;
-								gEnvData.domePressure_kPa	=	pressure_kPa;
-								gettimeofday(&gEnvData.domeLastUpdate, NULL);
-
-								strcpy(gEnvData.domeDataSource, "Data source: Remote R-Pi with sensehat");
-							}
-							else
-							{
-								gEnvData.siteDataValid		=	true;
-								gEnvData.sitePressure_kPa	=	pressure_kPa;
-								gettimeofday(&gEnvData.siteLastUpdate, NULL);
-							}
-						}
-					}
-				}
+				gEnvData.domeDataValid		=	true;
+				gEnvData.domePressure_kPa	=	gObsCondPoll[ii].pressure_kPa;
+				gettimeofday(&gEnvData.domeLastUpdate, NULL);
+
+				strcpy(gEnvData.domeDataSource, "Data source: Remote R-Pi with sensehat");
 			}
 			else
 			{
-				CONSOLE_DEBUG("No valid data");
+				gEnvData.siteDataValid		=	true;
+				gEnvData.sitePressure_kPa	=	gObsCondPoll[ii].pressure_kPa;
+				gettimeofday(&gEnvData.siteLastUpdate, NULL);
 			}
+		}
 
-			//------------------------------------------------
-			//	humidity
-			SJP_Init(&jsonParser);
-			validData	=	GetJsonResponse(	&gRemoteList[ii].deviceAddress,
-												gRemoteList[ii].port,
-												"/api/v1/observingconditions/0/humidity",
-												&jsonParser);
-			if (validData)
+		//------------------------------------------------
+		//	humidity
+		if (gObsCondPoll[ii].humidityValid)
+		{
+		//	CONSOLE_DEBUG_W_DBL("Valid humidity data=", gObsCondPoll[ii].humidity);
+			if (gObsCondPoll[ii].domeInfo)
 			{
-				//*	we have valid humidity
-				for (jjj=0; jjj<jsonParser.tokenCount_Data; jjj++)
-				{
-					if (strcmp(jsonParser.dataList[jjj].keyword, "VALUE") == 0)
-					{
-						humidity	=	atof(jsonParser.dataList[jjj].valueString);
-						if (humidity > 0.0)
-						{
-						//	CONSOLE_DEBUG_W_DBL("Valid humidity data=", humidity);
-							if (domeInfo)
-							{
-								gEnvData.domeDataValid		=	true;
-								gEnvData.domeHumidity		=	humidity;
-								gettimeofday(&gEnvData.domeLastUpdate, NULL);
-							}
-							else
-							{
-								gEnvData.siteDataValid		=	true;
-								gEnvData.siteHumidity		=	humidity;
-								gettimeofday(&gEnvData.siteLastUpdate, NULL);
-							}
-						}
-					}
-				}
+				gEnvData.domeDataValid		=	true;
+				gEnvData.domeHumidity		=	gObsCondPoll[ii].humidity;
+				gettimeofday(&gEnvData.domeLastUpdate, NULL);
 			}
 			else
 			{
-				CONSOLE_DEBUG("No valid data");
+				gEnvData.siteDataValid		=	true;
+				gEnvData.siteHumidity		=	gObsCondPoll[ii].humidity;
+				gettimeofday(&gEnvData.siteLastUpdate, NULL);
 			}
 		}
-	#endif
 	}
+#endif // _ENABLE_CAMERA_
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, "Exit");
 }
 
@@ -1260,6 +1188,7 @@ bool				validLocalAddress;
 		exit(EXIT_FAILURE);
 	}
 
+	SJP_Init(&jsonParser);
 	sendtoRetCode	=	0;
 	while (gDiscoveryThreadKeepRunning && (sendtoRetCode >= 0))
 	{
@@ -1296,7 +1225,6 @@ bool				validLocalAddress;
 			if (rcvCnt > 0)
 			{
 				buf[rcvCnt]	=	0;
-				SJP_Init(&jsonParser);
 				SJP_ParseData(&jsonParser, buf);
 //				SJP_DumpJsonData(&jsonParser);
 
@@ -1341,6 +1269,7 @@ bool				validLocalAddress;
 	//	CONSOLE_DEBUG("Done sleeping");
 	}
 
+	SJP_Release(&jsonParser);
 	CONSOLE_DEBUG("Thread exit!!!!!!!!");
 
 	gDiscoveryThreadIsRunning	=	false;
@@ -1377,6 +1306,7 @@ char				*colonPtr;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
+	SJP_Init(&jsonParser);
 	//*	see if there is a file listing extra IP address
 	filePointer	=	fopen(fileName, "r");
 	if (filePointer != NULL)
@@ -1426,10 +1356,8 @@ char				*colonPtr;
 				inet_ntop(AF_INET, &(from.sin_addr), outputIPaddrStr, INET_ADDRSTRLEN);
 //				CONSOLE_DEBUG_W_STR("outputIPaddrStr\t\t=",		outputIPaddrStr);
 
-				SJP_Init(&jsonParser);
-				strcpy(jsonParser.dataList[0].keyword, "ALPACAPORT");
-				strcpy(jsonParser.dataList[0].valueString, portNumStr);
-				jsonParser.tokenCount_Data	=	1;
+				SJP_Reset(&jsonParser);
+				SJP_AddToken(&jsonParser, "ALPACAPORT", portNumStr);
 
 				AddIPaddressToList(&from, &jsonParser);
 			}
@@ -1440,6 +1368,7 @@ char				*colonPtr;
 	{
 		CONSOLE_DEBUG_W_STR("File Not found\t=",	fileName);
 	}
+	SJP_Release(&jsonParser);
 }
 
 //**************************************************************************************
@@ -651,45 +651,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ClientTransactionID",
-																reqData->ClientTransactionID,
-																INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ServerTransactionID",
-																gServerTransactionID,
-																INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ErrorNumber",
-																alpacaErrCode,
-																INCLUDE_COMMA);
-
-	//	cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-	//								reqData->jsonTextBuffer,
-	//								kMaxJsonBuffLen,
-	//								"NewState",
-	//								domeState,
-	//								INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
-																reqData->jsonTextBuffer,
-																kMaxJsonBuffLen,
-																"ErrorMessage",
-																alpacaErrMsg,
-																NO_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -1183,7 +1145,7 @@ bool				foundKeyWord;
 bool				newSlavedValue;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Slaved",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -1419,7 +1381,7 @@ bool				foundKeyWord;
 	CONSOLE_DEBUG(__FUNCTION__);
 	cTimeOfLastMoveCmd		=	time(NULL);
 	//*	look for Azimuth
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Azimuth",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -1494,7 +1456,7 @@ bool				foundKeyWord;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	//*	look for Azimuth
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Azimuth",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -82,7 +82,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
 	int					alpacaReturnCode;
 
 		CONSOLE_DEBUG("Using remote shutter info");
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/%s/%d/openshutter", "shutter", 0);
 		validData	=	SendPutCommand(	&cShutterDeviceAddress,
 											cShutterPort,
@@ -148,7 +148,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
 	int					alpacaReturnCode;
 
 		CONSOLE_DEBUG("Using remote shutter info");
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/%s/%d/closeshutter", "shutter", 0);
 		validData	=	SendPutCommand(	&cShutterDeviceAddress,
 											cShutterPort,
@@ -213,7 +213,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
 	int					alpacaReturnCode;
 
 		CONSOLE_DEBUG("Using remote shutter info");
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/%s/%d/abortslew", "shutter", 0);
 		validData	=	SendPutCommand(	&cShutterDeviceAddress,
 										cShutterPort,
@@ -284,7 +284,7 @@ int					jjj;
 
 		//===============================================================
 		//*	get readall
-		SJP_Init(&jsonParser);
+		SJP_Reset(&jsonParser);
 		sprintf(alpacaString,	"/api/v1/%s/%d/readall", "shutter", 0);
 		validData	=	GetJsonResponse(	&shutterAddr,
 											shutterPort,
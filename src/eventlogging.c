@@ -16,9 +16,11 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	May 21,	2019	<MLS> Created eventlogging.c
 //*	May 22,	2019	<MLS> Added SendHtmlLog()
+//*	Oct 18,	2026	<AGT> Added mutex to LogEvent(), it is now called from multiple threads
 //*****************************************************************************
 
 
@@ -29,6 +31,7 @@
 //#include	<ctype.h>
 //#include	<stdint.h>
 #include	<time.h>
+#include	<pthread.h>
 //#include	<unistd.h>
 
 
@@ -63,6 +66,8 @@ typedef struct
 TYPE_EVENTLOG	gEventLog[kMaxLogEntries];
 int				gLogIndex	=	0;
 
+static pthread_mutex_t	gEventLogMutex	=	PTHREAD_MUTEX_INITIALIZER;
+
 //**************************************************************************
 //*	if the log files up, we will dump the first half and continue
 static void	FlushHalfLog(void)
@@ -86,6 +91,7 @@ void	LogEvent(	const char				*eventName,
 					const TYPE_ASCOM_STATUS	alpacaErrCode,
 					const char				*errorString)
 {
+	pthread_mutex_lock(&gEventLogMutex);
 	if (gLogIndex < kMaxLogEntries)
 	{
 		memset(&gEventLog[gLogIndex], 0, sizeof(TYPE_EVENTLOG));
@@ -117,6 +123,7 @@ void	LogEvent(	const char				*eventName,
 			FlushHalfLog();
 		}
 	}
+	pthread_mutex_unlock(&gEventLogMutex);
 }
 
 //**************************************************************************
@@ -21,12 +21,14 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Sep 19,	2023	<MLS> Purchased QHY 7 pos 2 inch filter wheel used from CloudyNights
 //*	Sep 20,	2023	<MLS> Created filterwheeldriver_QHY.cpp
 //*	Sep 20,	2023	<MLS> Added driver thread to QHY filter wheel
 //*	Sep 20,	2023	<MLS> QHY filter wheel fully working
 //*	Sep 20,	2023	<MLS> SUPPORTED: QHY filter wheel
+//*	Oct 18,	2026	<AGT> Invalidate cached description after reading the firmware version
 //*****************************************************************************
 
 #ifdef _ENABLE_FILTERWHEEL_QHY_
@@ -293,6 +295,7 @@ int		totalBytesRead;
 		CONSOLE_DEBUG_W_STR("VRS",	readBuffer);
 		strcpy(cCommonProp.Description, "QHY filterwheel, FW-Ver:");
 		strcat(cCommonProp.Description, readBuffer);
+		ResponseCache_Invalidate("description");
 	}
 	CONSOLE_DEBUG_W_STR("cCommonProp.Description",	cCommonProp.Description);
 
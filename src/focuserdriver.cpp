@@ -313,39 +313,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ClientTransactionID",
-										reqData->ClientTransactionID,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ServerTransactionID",
-										gServerTransactionID,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ErrorNumber",
-										alpacaErrCode,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ErrorMessage",
-										alpacaErrMsg,
-										NO_COMMA);
-
-		//*	Nov  8,	2022	<MLS> Fixed bug in JSON for temperatureLog in all drivers.
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));	//*	required for long JSON output
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -485,7 +453,7 @@ bool				foundKeyWord;
 char				argumentString[32];
 bool				validData;
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"TempComp",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -593,7 +561,7 @@ int32_t				newPosition;
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, "**********************************************************");
 //	SETUP_TIMING();
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -630,7 +598,7 @@ bool				foundKeyWord;
 char				argumentString[32];
 int32_t				newPosition;
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1));
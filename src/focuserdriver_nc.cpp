@@ -29,6 +29,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Dec  4,	2019	<MLS> Started working on moonlite focuser
 //*	Dec  5,	2019	<MLS> Looking into talking to /dev/ttyUSBx directly (FTDI chip)
@@ -53,6 +54,9 @@
 //*	Nov 30,	2022	<MLS> Added ProcessQueuedCommands() & ProcessPeriodicRequests()
 //*	Jun 10,	2023	<MLS> Modified to use usbmanager functions to get the right /dev/ttyUSBn port
 //*	Jun 16,	2023	<MLS> Using old moonlite discover method as backup to usbmanager method
+//*	Oct 18,	2026	<AGT> Position/moving/switch requests are now pipelined using async_com
+//*	Oct 18,	2026	<AGT> Position is read back to back while moving instead of every 500 ms
+//*	Oct 18,	2026	<AGT> Added QueuePeriodicRequests() & ProcessCmdResponse()
 //*****************************************************************************
 //	Full step size for the Ultra high res stepper motor is .00004" per step.
 //	The regular high res stepper motor runs as .00016" per step in Full step mode.
@@ -176,6 +180,9 @@ FocuserMoonLite::FocuserMoonLite(const char *devicePath)
 	cLastTimeMilSecs_Position	=	0;
 	cInvalidStringErrCnt		=	0;
 
+	AsyncCom_Init(&cAsyncCom, MoonLite_Framer, '#', kAsyncDefaultInFlight);
+	cAsyncComOpen				=	false;
+
 	CONSOLE_DEBUG_W_STR("port is", devicePath);
 	OpenFocuserConnection(devicePath);
 
@@ -228,6 +235,7 @@ FocuserMoonLite::FocuserMoonLite(const char *devicePath)
 FocuserMoonLite::~FocuserMoonLite(void)
 {
 	CONSOLE_DEBUG(__FUNCTION__);
+	AsyncCom_Release(&cAsyncCom);
 	MoonLite_CloseFocuserConnection(&cMoonliteCom);
 }
 
@@ -290,6 +298,8 @@ bool	openOK;
 		CONSOLE_DEBUG_W_STR("cDeviceVersion",	cDeviceVersion);
 		CONSOLE_DEBUG_W_STR("cDeviceSerialNum",	cDeviceSerialNum);
 		cFileDesc	=	cMoonliteCom.fileDesc;
+		AsyncCom_Open(&cAsyncCom, cMoonliteCom.fileDesc);
+		cAsyncComOpen	=	true;
 
 	#ifdef	_ENABLE_ROTATOR_
 		if (cMoonliteCom.model == kMoonLite_NiteCrawler)
@@ -361,7 +371,6 @@ void	FocuserMoonLite::ProcessPeriodicRequests(void)
 bool				validFlag;
 uint32_t			currentMillis;
 uint32_t			currentSeconds;
-bool				isMovingFlag;
 double				myFocusTemp;
 double				myFocusVoltage;
 
@@ -406,94 +415,191 @@ double				myFocusVoltage;
 	}
 
 	//===============================================================
-	//*	get the position information every 200 milliseconds (5 times a second)
-	if ((currentMillis - cLastTimeMilSecs_Position) > 500)
+	//*	get the position information every 500 milliseconds,
+	//*	while anything is moving, ask again as soon as the answers are in.
+	//*	The answers are handled by ProcessCmdResponse()
+	if (cAsyncComOpen && (cFocuserProp.IsMoving || cRotatorProp.IsMoving || cAuxIsMoving ||
+		((currentMillis - cLastTimeMilSecs_Position) > 500)))
 	{
-		GetPosition(1, &cFocuserProp.Position);
-		if (cFocuserSupportsRotation)
-		{
-			GetPosition(2, &cRotatorPosition);
-		}
-		if (cFocuserSupportsAux)
-		{
-			GetPosition(3, &cAuxPosition);
-		}
+		QueuePeriodicRequests();
+		cLastTimeMilSecs_Position	=	currentMillis;
+	}
+}
 
+//*****************************************************************************
+static void	MoonLiteCmdDoneProc(	void		*userData,
+									const int	cmdID,
+									const char	*cmdString,
+									const char	*responseString,
+									const int	status)
+{
+	((FocuserMoonLite *)userData)->ProcessCmdResponse(cmdID, cmdString, responseString, status);
+}
 
-		//-------------------------------------------------------
-		//*	check to see if the focuser is moving...
-		validFlag	=	MoonLite_GetMovingState(&cMoonliteCom,
-												1,
-												&isMovingFlag);
-		if (validFlag)
+//*****************************************************************************
+void	FocuserMoonLite::QueueRequest(const char *theCommand, const int cmdID)
+{
+char	cmdBuffer[32];
+
+	MoonLite_FormatCommand(&cMoonliteCom, theCommand, cmdBuffer);
+	AsyncCom_QueueCmd(	&cAsyncCom,
+						cmdBuffer,
+						cmdID,
+						kAsyncResp_Terminated,
+						kMoonLiteTimeOut_ms,
+						MoonLiteCmdDoneProc,
+						this);
+}
+
+//*****************************************************************************
+//*	these all go out in one write
+//*****************************************************************************
+void	FocuserMoonLite::QueuePeriodicRequests(void)
+{
+char	cmdBuffer[16];
+
+	if (MoonLite_GetPositionCmd(&cMoonliteCom, 1, cmdBuffer))
+	{
+		QueueRequest(cmdBuffer, kMoonLiteCmd_Position1);
+	}
+	if (cFocuserSupportsRotation && MoonLite_GetPositionCmd(&cMoonliteCom, 2, cmdBuffer))
+	{
+		QueueRequest(cmdBuffer, kMoonLiteCmd_Position2);
+	}
+	if (cFocuserSupportsAux && MoonLite_GetPositionCmd(&cMoonliteCom, 3, cmdBuffer))
+	{
+		QueueRequest(cmdBuffer, kMoonLiteCmd_Position3);
+	}
+
+	//*	check to see if the focuser is moving...
+	//*	this is after the positions so the moving checks are done with the new positions
+	if (MoonLite_GetMovingStateCmd(&cMoonliteCom, 1, cmdBuffer))
+	{
+		QueueRequest(cmdBuffer, kMoonLiteCmd_MovingState);
+	}
+
+	//===============================================================
+	if (cMoonliteCom.model == kMoonLite_NiteCrawler)
+	{
+		//*	if anything is moving, get the switch bits
+		//*	The GS query the switch status for the limit and rotation home switches:
+		//*	b0	=	Rotation switch
+		//*	b1	=	Out limit switch
+		//*	b2	=	In limit switch
+		//*
+		//*	GA is the AUX channel switch status:
+		//*	b0	=	Out limit
+		//*	b1	=	In lmit
+		if (cFocuserProp.IsMoving || cRotatorProp.IsMoving || cAuxIsMoving)
 		{
-			if (isMovingFlag != cFocuserProp.IsMoving)
-			{
-				CONSOLE_DEBUG(			"isMoving Changed state");
-				CONSOLE_DEBUG_W_BOOL(	"Previous state\t=", cFocuserProp.IsMoving);
-				CONSOLE_DEBUG_W_BOOL(	"New state     \t=", isMovingFlag);
-			}
-			cFocuserProp.IsMoving	=	isMovingFlag;
+			QueueRequest("GS", kMoonLiteCmd_Switches);
+			QueueRequest("GA", kMoonLiteCmd_AuxSwitches);
 		}
+	}
+}
 
-		cPrevFocuserPosition	=	cFocuserProp.Position;
+//*****************************************************************************
+void	FocuserMoonLite::CheckRotatorAuxMoving(void)
+{
+	//*	check to see if the rotator moving...
+	if (cRotatorPosition != cPrevRotatorPosition)
+	{
+		cRotatorProp.IsMoving	=	true;
+		CONSOLE_DEBUG_W_NUM("pos2=", cRotatorPosition);
+	}
+	else
+	{
+		cRotatorProp.IsMoving	=	false;
+	}
+	cPrevRotatorPosition		=	cRotatorPosition;
+
+	//*	check to see if the Aux moving...
+	if (cAuxPosition != cPrevAuxPosition)
+	{
+		cAuxIsMoving	=	true;
+		CONSOLE_DEBUG_W_NUM("pos3=", cAuxPosition);
+	}
+	else
+	{
+		cAuxIsMoving	=	false;
+	}
+	cPrevAuxPosition		=	cAuxPosition;
+}
 
+//*****************************************************************************
+//*	called from AsyncCom_Process() in RunStateMachine()
+//*****************************************************************************
+void	FocuserMoonLite::ProcessCmdResponse(	const int	cmdID,
+												const char	*cmdString,
+												const char	*responseString,
+												const int	status)
+{
+bool			validFlag;
+bool			isMovingFlag;
+unsigned char	switchBits;
 
-		//-------------------------------------------------------
-		if (cFocuserSupportsRotation)
-		{
-			//*	check to see if the rotator moving...
-			if (cRotatorPosition != cPrevRotatorPosition)
-			{
-				cRotatorProp.IsMoving	=	true;
-				CONSOLE_DEBUG_W_NUM("pos2=", cRotatorPosition);
-			}
-			else
-			{
-				cRotatorProp.IsMoving	=	false;
-			}
-			cPrevRotatorPosition		=	cRotatorPosition;
+	validFlag	=	false;
+	if (status == kAsyncStatus_OK)
+	{
+		validFlag	=	MoonLite_CheckResponse(&cMoonliteCom, responseString);
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_STR("No response\t=", cmdString);
+	}
 
-			//*	check to see if the Aux moving...
-			if (cAuxPosition != cPrevAuxPosition)
-			{
-				cAuxIsMoving	=	true;
-				CONSOLE_DEBUG_W_NUM("pos3=", cAuxPosition);
-			}
-			else
-			{
-				cAuxIsMoving	=	false;
-			}
-			cPrevAuxPosition		=	cAuxPosition;
-		}
-		//===============================================================
-		if (cMoonliteCom.model == kMoonLite_NiteCrawler)
+	if (validFlag)
+	{
+		switch(cmdID)
 		{
-			//*	if anything is moving, get the switch bits
-			//*	The GS query the switch status for the limit and rotation home switches:
-			//*	b0	=	Rotation switch
-			//*	b1	=	Out limit switch
-			//*	b2	=	In limit switch
-			//*
-			//*	GA is the AUX channel switch status:
-			//*	b0	=	Out limit
-			//*	b1	=	In lmit
-			if (cFocuserProp.IsMoving || cRotatorProp.IsMoving || cAuxIsMoving)
-			{
-			unsigned char	switchBits;
-
-				validFlag	=	MoonLite_GetSwiches(&cMoonliteCom,	&switchBits);
-	//			CONSOLE_DEBUG_W_HEX("switchBits\t=", switchBits);
-				cSwitchROT	=	((switchBits & 0x01) ? true : false);
-				cSwitchOUT	=	((switchBits & 0x02) ? true : false);
-				cSwitchIN	=	((switchBits & 0x04) ? true : false);
+			case kMoonLiteCmd_Position1:
+				cFocuserProp.Position	=	MoonLite_ParsePosition(&cMoonliteCom, responseString);
+				break;
+
+			case kMoonLiteCmd_Position2:
+				cRotatorPosition		=	MoonLite_ParsePosition(&cMoonliteCom, responseString);
+				break;
+
+			case kMoonLiteCmd_Position3:
+				cAuxPosition			=	MoonLite_ParsePosition(&cMoonliteCom, responseString);
+				break;
+
+			case kMoonLiteCmd_MovingState:
+				isMovingFlag	=	(atoi(responseString) != 0);
+				//*	a move that has not been sent yet is still a move
+				if (cSendMoveCmd == false)
+				{
+					if (isMovingFlag != cFocuserProp.IsMoving)
+					{
+						CONSOLE_DEBUG(			"isMoving Changed state");
+						CONSOLE_DEBUG_W_BOOL(	"Previous state\t=", cFocuserProp.IsMoving);
+						CONSOLE_DEBUG_W_BOOL(	"New state     \t=", isMovingFlag);
+					}
+					cFocuserProp.IsMoving	=	isMovingFlag;
+				}
+				cPrevFocuserPosition	=	cFocuserProp.Position;
 
-				validFlag	=	MoonLite_GetAuxSwiches(&cMoonliteCom,	&switchBits);
-				cSwitchAUX1	=	((switchBits & 0x01) ? true : false);
-				cSwitchAUX2	=	((switchBits & 0x02) ? true : false);
-			}
+				if (cFocuserSupportsRotation)
+				{
+					CheckRotatorAuxMoving();
+				}
+				break;
+
+			case kMoonLiteCmd_Switches:
+				switchBits				=	atoi(responseString);
+				cMoonliteCom.switchBits	=	switchBits;
+				cSwitchROT				=	((switchBits & 0x01) ? true : false);
+				cSwitchOUT				=	((switchBits & 0x02) ? true : false);
+				cSwitchIN				=	((switchBits & 0x04) ? true : false);
+				break;
+
+			case kMoonLiteCmd_AuxSwitches:
+				switchBits					=	atoi(responseString);
+				cMoonliteCom.auxSwitchBits	=	switchBits;
+				cSwitchAUX1					=	((switchBits & 0x01) ? true : false);
+				cSwitchAUX2					=	((switchBits & 0x02) ? true : false);
+				break;
 		}
-		cLastTimeMilSecs_Position	=	currentMillis;
 	}
 }
 
@@ -501,18 +607,38 @@ double				myFocusVoltage;
 int32_t	FocuserMoonLite::RunStateMachine(void)
 {
 
+int32_t	delayMicroSecs;
+
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	if (cSendHaltCmd || cSendMoveCmd)
+	//*	this never waits, it handles whatever has come in
+	if (cAsyncComOpen)
 	{
-		ProcessQueuedCommands();
+		if (AsyncCom_Process(&cAsyncCom, 0) < 0)
+		{
+			CONSOLE_DEBUG("Connection to focuser failed");
+		}
 	}
-	else
+
+	//*	the other commands still wait for their answer, so only when nothing is in flight
+	if (AsyncCom_PendingCnt(&cAsyncCom) == 0)
 	{
-		ProcessPeriodicRequests();
+		if (cSendHaltCmd || cSendMoveCmd)
+		{
+			ProcessQueuedCommands();
+		}
+		else
+		{
+			ProcessPeriodicRequests();
+		}
 	}
 
-	return(100 * 1000);
+	delayMicroSecs	=	100 * 1000;
+	if (AsyncCom_PendingCnt(&cAsyncCom) > 0)
+	{
+		delayMicroSecs	=	2 * 1000;
+	}
+	return(delayMicroSecs);
 }
 
 
@@ -26,8 +26,25 @@
 
 #include	"moonlite_com.h"
 
+#ifndef _ASYNC_COM_H_
+	#include	"async_com.h"
+#endif
+
 int	CreateFocuserObjects_MoonLite(void);
 
+//*****************************************************************************
+//*	the cmdID values for the periodic requests
+enum
+{
+	kMoonLiteCmd_Position1	=	1,
+	kMoonLiteCmd_Position2,
+	kMoonLiteCmd_Position3,
+	kMoonLiteCmd_MovingState,
+	kMoonLiteCmd_Switches,
+	kMoonLiteCmd_AuxSwitches
+};
+#define	kMoonLiteTimeOut_ms		500
+
 
 //**************************************************************************************
 class FocuserMoonLite: public FocuserDriver
@@ -47,6 +64,11 @@ class FocuserMoonLite: public FocuserDriver
 		virtual	TYPE_ASCOM_STATUS	SetStepperPosition(const int axisNumber, const int32_t newPosition);
 		virtual	TYPE_ASCOM_STATUS	HaltStepper(const int axisNumber);
 
+				void				ProcessCmdResponse(	const int	cmdID,
+														const char	*cmdString,
+														const char	*responseString,
+														const int	status);
+
 	protected:
 		bool			OpenFocuserConnection(const char *usbPortPath);		//*	returns true if open succeeded.
 		void			SendCommand(const char *theCommand);
@@ -56,6 +78,9 @@ class FocuserMoonLite: public FocuserDriver
 		//*	these get called from RunStateMachine()
 		void			ProcessQueuedCommands(void);
 		void			ProcessPeriodicRequests(void);
+		void			QueuePeriodicRequests(void);
+		void			QueueRequest(const char *theCommand, const int cmdID);
+		void			CheckRotatorAuxMoving(void);
 
 		int				cFileDesc;	//*	port file descriptor
 
@@ -63,6 +88,10 @@ class FocuserMoonLite: public FocuserDriver
 
 		TYPE_MOONLITECOM	cMoonliteCom;
 
+		//*	the position requests are pipelined, see QueuePeriodicRequests()
+		TYPE_ASYNCCOM		cAsyncCom;
+		bool				cAsyncComOpen;
+
 		//*	command queue data
 		bool			cSendHaltCmd;
 		int				cHaltCmdAxis;
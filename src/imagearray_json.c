@@ -0,0 +1,420 @@
+//**************************************************************************
+//*	Name:			imagearray_json.c
+//*
+//*	Author:			agent
+//*
+//*	Description:	Fast encoder for the Alpaca JSON imagearray
+//*
+//*	Limitations:	pixel values must fit in 16 bits (8 bit data is scaled by 256)
+//*
+//*	Usage notes:	The Alpaca JSON image array is in column order, i.e. all of the
+//*					pixels down the first column, then the 2nd column etc.
+//*					Stepping through the image that way touches a different cache line
+//*					for every pixel, so a strip of columns is first copied (row by row)
+//*					into a small transposed buffer and then formatted from there.
+//*
+//*					Values are formatted with a table driven integer to ascii routine
+//*					straight into large output chunks, no sprintf(), no strcat().
+//*					The chunks are sent with one writev() call when they are all full.
+//*
+//*					The work buffer is supplied by the caller so that it can be
+//*					re-used from one image to the next.
+//*****************************************************************************
+//*	AlpacaPi is an open source project written in C/C++
+//*
+//*	Use of this source code for private or individual use is granted
+//*	Use of this source code, in whole or in part for commercial purpose requires
+//*	written agreement in advance.
+//*
+//*	You may use or modify this source code in any way you find useful, provided
+//*	that you agree that the author(s) have no warranty, obligations or liability.  You
+//*	must determine the suitability of this source code for your use.
+//*
+//*	Redistributions of this source code must retain this copyright notice.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created imagearray_json.c
+//*****************************************************************************
+
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<string.h>
+#include	<stdbool.h>
+#include	<stdint.h>
+#include	<unistd.h>
+#include	<errno.h>
+#include	<sys/uio.h>
+
+//#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"imagearray_json.h"
+
+//*	longest text for one pixel, "[65535,65535,65535],"
+#define	kMaxPixelTextLen	24
+
+enum
+{
+	kPixelFmt_Raw8	=	0,
+	kPixelFmt_Raw16,
+	kPixelFmt_RGB24
+};
+
+//*****************************************************************************
+static const char	gTwoDigits[]	=
+{
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899"
+};
+
+//*****************************************************************************
+//*	writes the decimal value (0 -> 65535) and returns the new end of the buffer
+//*****************************************************************************
+static inline char	*PutUint16(char *textPtr, uint32_t value)
+{
+uint32_t	hiPart;
+
+	if (value >= 10000)
+	{
+		hiPart		=	value / 10000;			//*	1 digit (max 6)
+		value		-=	hiPart * 10000;
+		*textPtr++	=	'0' + hiPart;
+		hiPart		=	value / 100;
+		value		-=	hiPart * 100;
+		memcpy(textPtr,		&gTwoDigits[hiPart * 2], 2);
+		memcpy(textPtr + 2,	&gTwoDigits[value * 2], 2);
+		textPtr		+=	4;
+	}
+	else if (value >= 1000)
+	{
+		hiPart		=	value / 100;
+		value		-=	hiPart * 100;
+		memcpy(textPtr,		&gTwoDigits[hiPart * 2], 2);
+		memcpy(textPtr + 2,	&gTwoDigits[value * 2], 2);
+		textPtr		+=	4;
+	}
+	else if (value >= 100)
+	{
+		hiPart		=	value / 100;
+		value		-=	hiPart * 100;
+		*textPtr++	=	'0' + hiPart;
+		memcpy(textPtr,		&gTwoDigits[value * 2], 2);
+		textPtr		+=	2;
+	}
+	else if (value >= 10)
+	{
+		memcpy(textPtr,		&gTwoDigits[value * 2], 2);
+		textPtr		+=	2;
+	}
+	else
+	{
+		*textPtr++	=	'0' + value;
+	}
+	return(textPtr);
+}
+
+//*****************************************************************************
+size_t	ImageArrayJson_GetWorkBuffSize(const int numRows, const int valuesPerPixel)
+{
+size_t	workBuffSize;
+
+	workBuffSize	=	(kImgJson_ChunkCnt * kImgJson_ChunkSize);
+	workBuffSize	+=	(size_t)kImgJson_StripClms * numRows * valuesPerPixel * sizeof(uint16_t);
+	return(workBuffSize);
+}
+
+//*****************************************************************************
+//*	returns false if the work buffer is too small for even one column
+//*****************************************************************************
+bool	ImageArrayJson_Init(TYPE_ImageArrayJson	*encoder,
+							const int			socketFD,
+							void				*workBuffer,
+							const size_t		workBuffSize,
+							const int			numRows,
+							const int			valuesPerPixel)
+{
+char	*buffPtr;
+size_t	stripBuffSize;
+size_t	columnSize;
+int		iii;
+
+	memset(encoder, 0, sizeof(TYPE_ImageArrayJson));
+	encoder->socketFD	=	socketFD;
+	buffPtr				=	(char *)workBuffer;
+	for (iii=0; iii<kImgJson_ChunkCnt; iii++)
+	{
+		encoder->chunkBuff[iii]	=	buffPtr;
+		buffPtr					+=	kImgJson_ChunkSize;
+	}
+	encoder->stripBuff		=	(uint16_t *)buffPtr;
+	encoder->stripMaxClms	=	0;
+	columnSize				=	(size_t)numRows * valuesPerPixel * sizeof(uint16_t);
+	if ((workBuffer != NULL) && (columnSize > 0) &&
+		(workBuffSize > (kImgJson_ChunkCnt * kImgJson_ChunkSize)))
+	{
+		stripBuffSize			=	workBuffSize - (kImgJson_ChunkCnt * kImgJson_ChunkSize);
+		encoder->stripMaxClms	=	stripBuffSize / columnSize;
+		if (encoder->stripMaxClms > kImgJson_StripClms)
+		{
+			encoder->stripMaxClms	=	kImgJson_StripClms;
+		}
+	}
+	return(encoder->stripMaxClms > 0);
+}
+
+//*****************************************************************************
+//*	send all of the chunks that have data, writev() may not send everything at once
+//*****************************************************************************
+static void	FlushChunks(TYPE_ImageArrayJson *encoder)
+{
+struct iovec	ioVector[kImgJson_ChunkCnt];
+struct iovec	*ioPtr;
+int				ioCount;
+ssize_t			bytesWritten;
+int				iii;
+
+	ioCount	=	0;
+	for (iii=0; iii<=encoder->currentChunk; iii++)
+	{
+		if (encoder->chunkLen[iii] > 0)
+		{
+			ioVector[ioCount].iov_base	=	encoder->chunkBuff[iii];
+			ioVector[ioCount].iov_len	=	encoder->chunkLen[iii];
+			ioCount++;
+		}
+		encoder->chunkLen[iii]	=	0;
+	}
+	encoder->currentChunk	=	0;
+
+	ioPtr	=	ioVector;
+	while ((ioCount > 0) && (encoder->writeError == false))
+	{
+		bytesWritten	=	writev(encoder->socketFD, ioPtr, ioCount);
+		if (bytesWritten > 0)
+		{
+			encoder->totalBytesWritten	+=	bytesWritten;
+			//*	skip over what was sent
+			while ((ioCount > 0) && (bytesWritten >= (ssize_t)ioPtr->iov_len))
+			{
+				bytesWritten	-=	ioPtr->iov_len;
+				ioPtr++;
+				ioCount--;
+			}
+			if (ioCount > 0)
+			{
+				ioPtr->iov_base	=	(char *)ioPtr->iov_base + bytesWritten;
+				ioPtr->iov_len	-=	bytesWritten;
+			}
+		}
+		else if ((bytesWritten < 0) && (errno == EINTR))
+		{
+			//*	try again
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("writev() failed, errno\t=", errno);
+			encoder->writeError	=	true;
+		}
+	}
+}
+
+//*****************************************************************************
+//*	returns a pointer to where the next text goes, making sure there is room for
+//*	at least one pixel plus the end of the column
+//*****************************************************************************
+static inline char	*GetTextPtr(TYPE_ImageArrayJson *encoder)
+{
+	if ((encoder->chunkLen[encoder->currentChunk] + kMaxPixelTextLen) > kImgJson_ChunkSize)
+	{
+		encoder->currentChunk++;
+		if (encoder->currentChunk >= kImgJson_ChunkCnt)
+		{
+			encoder->currentChunk	=	kImgJson_ChunkCnt - 1;
+			FlushChunks(encoder);
+		}
+	}
+	return(encoder->chunkBuff[encoder->currentChunk] + encoder->chunkLen[encoder->currentChunk]);
+}
+
+//*****************************************************************************
+static inline void	SetTextEnd(TYPE_ImageArrayJson *encoder, const char *textPtr)
+{
+	encoder->chunkLen[encoder->currentChunk]	=	textPtr - encoder->chunkBuff[encoder->currentChunk];
+}
+
+//*****************************************************************************
+//*	copy a strip of columns into the strip buffer in column order,
+//*	reading the image one row at a time
+//*****************************************************************************
+static void	TransposeStrip(	TYPE_ImageArrayJson	*encoder,
+							const void			*pixelPtr,
+							const int			pixelFormat,
+							const int			numRows,
+							const int			numClms,
+							const int			startClm,
+							const int			stripClms)
+{
+const uint8_t	*rowPtr8;
+const uint16_t	*rowPtr16;
+uint16_t		*stripPtr;
+int				xxx;
+int				yyy;
+
+	switch(pixelFormat)
+	{
+		case kPixelFmt_Raw8:
+			for (yyy=0; yyy<numRows; yyy++)
+			{
+				rowPtr8		=	(const uint8_t *)pixelPtr + ((size_t)yyy * numClms) + startClm;
+				stripPtr	=	encoder->stripBuff + yyy;
+				for (xxx=0; xxx<stripClms; xxx++)
+				{
+					*stripPtr	=	(uint16_t)(rowPtr8[xxx] << 8);
+					stripPtr	+=	numRows;
+				}
+			}
+			break;
+
+		case kPixelFmt_Raw16:
+			for (yyy=0; yyy<numRows; yyy++)
+			{
+				rowPtr16	=	(const uint16_t *)pixelPtr + ((size_t)yyy * numClms) + startClm;
+				stripPtr	=	encoder->stripBuff + yyy;
+				for (xxx=0; xxx<stripClms; xxx++)
+				{
+					*stripPtr	=	rowPtr16[xxx];
+					stripPtr	+=	numRows;
+				}
+			}
+			break;
+
+		case kPixelFmt_RGB24:
+			//*	openCV uses BGR instead of RGB
+			for (yyy=0; yyy<numRows; yyy++)
+			{
+				rowPtr8		=	(const uint8_t *)pixelPtr + ((((size_t)yyy * numClms) + startClm) * 3);
+				stripPtr	=	encoder->stripBuff + (yyy * 3);
+				for (xxx=0; xxx<stripClms; xxx++)
+				{
+					stripPtr[0]	=	(uint16_t)(rowPtr8[2] << 8);
+					stripPtr[1]	=	(uint16_t)(rowPtr8[1] << 8);
+					stripPtr[2]	=	(uint16_t)(rowPtr8[0] << 8);
+					rowPtr8		+=	3;
+					stripPtr	+=	numRows * 3;
+				}
+			}
+			break;
+	}
+}
+
+//*****************************************************************************
+static long	SendImageArray(	TYPE_ImageArrayJson	*encoder,
+							const void			*pixelPtr,
+							const int			pixelFormat,
+							const int			numRows,
+							const int			numClms)
+{
+const uint16_t	*valuePtr;
+char			*textPtr;
+int				startClm;
+int				stripClms;
+int				xxx;
+int				yyy;
+
+	if ((pixelPtr == NULL) || (encoder->stripMaxClms <= 0) || (numRows <= 0))
+	{
+		CONSOLE_DEBUG("Invalid arguments");
+		return(0);
+	}
+	for (startClm=0; (startClm < numClms) && (encoder->writeError == false); startClm += stripClms)
+	{
+		stripClms	=	numClms - startClm;
+		if (stripClms > encoder->stripMaxClms)
+		{
+			stripClms	=	encoder->stripMaxClms;
+		}
+		TransposeStrip(encoder, pixelPtr, pixelFormat, numRows, numClms, startClm, stripClms);
+
+		valuePtr	=	encoder->stripBuff;
+		for (xxx=0; xxx<stripClms; xxx++)
+		{
+			textPtr		=	GetTextPtr(encoder);
+			*textPtr++	=	'[';
+			for (yyy=0; yyy<numRows; yyy++)
+			{
+				if (yyy > 0)
+				{
+					*textPtr++	=	',';
+				}
+				if (pixelFormat == kPixelFmt_RGB24)
+				{
+					*textPtr++	=	'[';
+					textPtr		=	PutUint16(textPtr, *valuePtr++);
+					*textPtr++	=	',';
+					textPtr		=	PutUint16(textPtr, *valuePtr++);
+					*textPtr++	=	',';
+					textPtr		=	PutUint16(textPtr, *valuePtr++);
+					*textPtr++	=	']';
+				}
+				else
+				{
+					textPtr		=	PutUint16(textPtr, *valuePtr++);
+				}
+				SetTextEnd(encoder, textPtr);
+				textPtr		=	GetTextPtr(encoder);
+			}
+			*textPtr++	=	']';
+			if ((startClm + xxx) < (numClms - 1))
+			{
+				*textPtr++	=	',';
+			}
+			*textPtr++	=	'\n';
+			SetTextEnd(encoder, textPtr);
+		}
+		encoder->totalValuesWritten	+=	(long)stripClms * numRows;
+	}
+	FlushChunks(encoder);
+	return(encoder->totalValuesWritten);
+}
+
+//*****************************************************************************
+//*	8 bit values are scaled to 16 bits, same as the binary image
+//*****************************************************************************
+long	ImageArrayJson_Send_Raw8(		TYPE_ImageArrayJson	*encoder,
+										const uint8_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms)
+{
+	return(SendImageArray(encoder, pixelPtr, kPixelFmt_Raw8, numRows, numClms));
+}
+
+//*****************************************************************************
+long	ImageArrayJson_Send_Raw16(		TYPE_ImageArrayJson	*encoder,
+										const uint16_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms)
+{
+	return(SendImageArray(encoder, pixelPtr, kPixelFmt_Raw16, numRows, numClms));
+}
+
+//*****************************************************************************
+//*	each pixel is sent as [red,green,blue]
+//*****************************************************************************
+long	ImageArrayJson_Send_RGB24(		TYPE_ImageArrayJson	*encoder,
+										const uint8_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms)
+{
+	return(SendImageArray(encoder, pixelPtr, kPixelFmt_RGB24, numRows, numClms));
+}
@@ -0,0 +1,79 @@
+//**************************************************************************
+//*	Name:			imagearray_json.h
+//*
+//*	Author:			agent
+//*
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created imagearray_json.h
+//*****************************************************************************
+//#include	"imagearray_json.h"
+
+#ifndef _IMAGEARRAY_JSON_H_
+#define	_IMAGEARRAY_JSON_H_
+
+#ifndef _STDBOOL_H
+	#include	<stdbool.h>
+#endif
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
+#include	<stddef.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+//*	output is collected in chunks and written with a single writev() when they are all full
+#define	kImgJson_ChunkSize		(64 * 1024)
+#define	kImgJson_ChunkCnt		8
+//*	number of columns transposed at one time
+#define	kImgJson_StripClms		16
+
+//*****************************************************************************
+typedef struct	//	TYPE_ImageArrayJson
+{
+	int			socketFD;
+	char		*chunkBuff[kImgJson_ChunkCnt];
+	int			chunkLen[kImgJson_ChunkCnt];
+	int			currentChunk;
+	uint16_t	*stripBuff;
+	int			stripMaxClms;
+	long		totalBytesWritten;
+	long		totalValuesWritten;
+	bool		writeError;
+} TYPE_ImageArrayJson;
+
+
+size_t	ImageArrayJson_GetWorkBuffSize(	const int			numRows,
+										const int			valuesPerPixel);
+bool	ImageArrayJson_Init(			TYPE_ImageArrayJson	*encoder,
+										const int			socketFD,
+										void				*workBuffer,
+										const size_t		workBuffSize,
+										const int			numRows,
+										const int			valuesPerPixel);
+
+long	ImageArrayJson_Send_Raw8(		TYPE_ImageArrayJson	*encoder,
+										const uint8_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms);
+long	ImageArrayJson_Send_Raw16(		TYPE_ImageArrayJson	*encoder,
+										const uint16_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms);
+long	ImageArrayJson_Send_RGB24(		TYPE_ImageArrayJson	*encoder,
+										const uint8_t		*pixelPtr,
+										const int			numRows,
+										const int			numClms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	//	_IMAGEARRAY_JSON_H_
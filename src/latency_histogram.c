@@ -0,0 +1,224 @@
+//*****************************************************************************
+//*
+//*	Name:			latency_histogram.c
+//*
+//*	Author:			agent (C) 2026
+//*
+//*	Description:	Lock free latency histograms for the request statistics
+//*
+//*	Usage notes:	The socket worker threads record into the same histograms at
+//*					the same time, every update is a single atomic add so there
+//*					is nothing to lock. A reader may see a request that is half
+//*					recorded, LatencyHistogram_Snapshot() recalculates the count
+//*					from the buckets so that the output is always consistent.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created latency_histogram.c
+//*****************************************************************************
+
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<stdint.h>
+#include	<stdbool.h>
+#include	<string.h>
+#include	<time.h>
+
+#include	"latency_histogram.h"
+
+//*****************************************************************************
+//*	CLOCK_MONOTONIC so that setting the system time does not show up as latency
+//*****************************************************************************
+uint64_t	LatencyHistogram_GetTime_us(void)
+{
+struct timespec	timeNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &timeNow);
+	return(((uint64_t)timeNow.tv_sec * 1000000) + (timeNow.tv_nsec / 1000));
+}
+
+//*****************************************************************************
+int	LatencyHistogram_BucketIndex(const uint64_t value_us)
+{
+int		bucketIdx;
+int		highBit;
+
+	if (value_us < kLatencySubBuckets)
+	{
+		bucketIdx	=	value_us;
+	}
+	else if (value_us >= (1ULL << kLatencyMaxPower))
+	{
+		bucketIdx	=	kLatencyBucketCnt - 1;
+	}
+	else
+	{
+		highBit		=	63 - __builtin_clzll(value_us);
+		bucketIdx	=	((highBit - kLatencySubBucketBits + 1) << kLatencySubBucketBits) +
+						((value_us >> (highBit - kLatencySubBucketBits)) & (kLatencySubBuckets - 1));
+	}
+	return(bucketIdx);
+}
+
+//*****************************************************************************
+//*	the smallest value that goes in this bucket
+//*****************************************************************************
+uint64_t	LatencyHistogram_BucketStart(const int bucketIdx)
+{
+uint64_t	startValue;
+int			highBit;
+
+	if (bucketIdx < kLatencySubBuckets)
+	{
+		startValue	=	bucketIdx;
+	}
+	else
+	{
+		highBit		=	(bucketIdx >> kLatencySubBucketBits) + kLatencySubBucketBits - 1;
+		startValue	=	(uint64_t)(kLatencySubBuckets + (bucketIdx & (kLatencySubBuckets - 1))) << (highBit - kLatencySubBucketBits);
+	}
+	return(startValue);
+}
+
+//*****************************************************************************
+void	LatencyHistogram_Record(	TYPE_LatencyHistogram	*histogram,
+									const uint64_t			elapsed_us,
+									const uint32_t			bytesSent,
+									const bool				isError)
+{
+uint32_t	elapsed32;
+uint32_t	currentMax;
+
+	elapsed32	=	(elapsed_us > 0xffffffff) ? 0xffffffff : elapsed_us;
+
+	__atomic_fetch_add(&histogram->buckets[LatencyHistogram_BucketIndex(elapsed_us)], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&histogram->count,		1,				__ATOMIC_RELAXED);
+	__atomic_fetch_add(&histogram->sum_us,		elapsed_us,		__ATOMIC_RELAXED);
+	__atomic_fetch_add(&histogram->bytesSent,	bytesSent,		__ATOMIC_RELAXED);
+	if (isError)
+	{
+		__atomic_fetch_add(&histogram->errorCnt, 1, __ATOMIC_RELAXED);
+	}
+
+	//*	only loops if another thread changed the max at the same time
+	currentMax	=	__atomic_load_n(&histogram->max_us, __ATOMIC_RELAXED);
+	while ((elapsed32 > currentMax) &&
+			(__atomic_compare_exchange_n(&histogram->max_us, &currentMax, elapsed32, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == false))
+	{
+		//*	currentMax was updated by the failed exchange
+	}
+}
+
+//*****************************************************************************
+void	LatencyHistogram_Snapshot(const TYPE_LatencyHistogram *histogram, TYPE_LatencyHistogram *snapshot)
+{
+int		iii;
+
+	snapshot->count		=	0;
+	for (iii=0; iii<kLatencyBucketCnt; iii++)
+	{
+		snapshot->buckets[iii]	=	__atomic_load_n(&histogram->buckets[iii], __ATOMIC_RELAXED);
+		snapshot->count			+=	snapshot->buckets[iii];
+	}
+	snapshot->errorCnt	=	__atomic_load_n(&histogram->errorCnt,	__ATOMIC_RELAXED);
+	snapshot->max_us	=	__atomic_load_n(&histogram->max_us,		__ATOMIC_RELAXED);
+	snapshot->sum_us	=	__atomic_load_n(&histogram->sum_us,		__ATOMIC_RELAXED);
+	snapshot->bytesSent	=	__atomic_load_n(&histogram->bytesSent,	__ATOMIC_RELAXED);
+}
+
+//*****************************************************************************
+//*	returns the top of the bucket the percentile falls in, never more than the max
+//*	percentile is 0.0 -> 100.0
+//*****************************************************************************
+uint32_t	LatencyHistogram_Percentile(const TYPE_LatencyHistogram *snapshot, const double percentile)
+{
+uint64_t	targetCount;
+uint64_t	runningCount;
+uint64_t	value_us;
+int			iii;
+
+	value_us	=	0;
+	if (snapshot->count > 0)
+	{
+		targetCount	=	((percentile * snapshot->count) / 100.0) + 0.5;
+		if (targetCount < 1)
+		{
+			targetCount	=	1;
+		}
+		runningCount	=	0;
+		iii				=	0;
+		while ((iii < (kLatencyBucketCnt - 1)) && ((runningCount + snapshot->buckets[iii]) < targetCount))
+		{
+			runningCount	+=	snapshot->buckets[iii];
+			iii++;
+		}
+		value_us	=	LatencyHistogram_BucketStart(iii + 1) - 1;
+		if (value_us > snapshot->max_us)
+		{
+			value_us	=	snapshot->max_us;
+		}
+	}
+	return(value_us);
+}
+
+//*****************************************************************************
+//*	Prometheus text format, the "le" buckets are every power of 2 from 16 us up,
+//*	the finer buckets are only used for the percentiles.
+//*	labelString is i.e.		device="camera",command="imagearray"
+//*	returns the number of chars in outputBuffer, 0 if it did not fit
+//*****************************************************************************
+int	LatencyHistogram_FormatPrometheus(	const TYPE_LatencyHistogram	*snapshot,
+										const char					*metricName,
+										const char					*labelString,
+										char						*outputBuffer,
+										const int					maxLen)
+{
+int			outputLen;
+int			lineLen;
+int			powerOf2;
+int			bucketIdx;
+int			nextBucketIdx;
+uint64_t	cumulativeCnt;
+bool		bufferFull;
+
+	outputLen		=	0;
+	cumulativeCnt	=	0;
+	bucketIdx		=	0;
+	bufferFull		=	false;
+	for (powerOf2=4; (powerOf2 <= kLatencyMaxPower) && (bufferFull == false); powerOf2++)
+	{
+		nextBucketIdx	=	LatencyHistogram_BucketIndex(1ULL << powerOf2);
+		while (bucketIdx < nextBucketIdx)
+		{
+			cumulativeCnt	+=	snapshot->buckets[bucketIdx];
+			bucketIdx++;
+		}
+		lineLen	=	snprintf(	&outputBuffer[outputLen], (maxLen - outputLen),
+								"%s_bucket{%s,le=\"%.6f\"} %llu\n",
+								metricName, labelString,
+								((double)(1ULL << powerOf2) / 1000000.0),
+								(unsigned long long)cumulativeCnt);
+		bufferFull	=	(lineLen >= (maxLen - outputLen));
+		outputLen	+=	lineLen;
+	}
+	if (bufferFull == false)
+	{
+		lineLen	=	snprintf(	&outputBuffer[outputLen], (maxLen - outputLen),
+								"%s_bucket{%s,le=\"+Inf\"} %u\n"
+								"%s_sum{%s} %.6f\n"
+								"%s_count{%s} %u\n",
+								metricName, labelString, snapshot->count,
+								metricName, labelString, ((double)snapshot->sum_us / 1000000.0),
+								metricName, labelString, snapshot->count);
+		bufferFull	=	(lineLen >= (maxLen - outputLen));
+		outputLen	+=	lineLen;
+	}
+	if (bufferFull)
+	{
+		outputLen		=	0;
+		outputBuffer[0]	=	0;
+	}
+	return(outputLen);
+}
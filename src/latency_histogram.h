@@ -0,0 +1,76 @@
+//*****************************************************************************
+//*	Name:			latency_histogram.h
+//*
+//*	Author:			agent
+//*
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created latency_histogram.h
+//*****************************************************************************
+//#include	"latency_histogram.h"
+
+#ifndef _LATENCY_HISTOGRAM_H_
+#define	_LATENCY_HISTOGRAM_H_
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
+#ifndef _STDBOOL_H
+	#include	<stdbool.h>
+#endif
+
+//*****************************************************************************
+//*	log-linear buckets, in micro-seconds
+//*		0 to 3 us are 1 us wide
+//*		after that each power of 2 is split into kLatencySubBuckets
+//*	so the bucket width is never more than 25% of the value.
+//*	The last bucket is everything 2^kLatencyMaxPower us (134 secs) or longer
+//*****************************************************************************
+#define	kLatencySubBucketBits	2
+#define	kLatencySubBuckets		(1 << kLatencySubBucketBits)
+#define	kLatencyMaxPower		27
+#define	kLatencyBucketCnt		(((kLatencyMaxPower - kLatencySubBucketBits + 1) * kLatencySubBuckets) + 1)
+
+//*****************************************************************************
+//*	All of the updates are atomic adds, there are no locks.
+//*	Readers should use LatencyHistogram_Snapshot()
+//*****************************************************************************
+typedef struct	//	TYPE_LatencyHistogram
+{
+	uint32_t	count;
+	uint32_t	errorCnt;
+	uint32_t	max_us;
+	uint64_t	sum_us;
+	uint64_t	bytesSent;
+	uint32_t	buckets[kLatencyBucketCnt];
+} TYPE_LatencyHistogram;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+uint64_t	LatencyHistogram_GetTime_us(void);
+void		LatencyHistogram_Record(	TYPE_LatencyHistogram	*histogram,
+										const uint64_t			elapsed_us,
+										const uint32_t			bytesSent,
+										const bool				isError);
+void		LatencyHistogram_Snapshot(const TYPE_LatencyHistogram *histogram, TYPE_LatencyHistogram *snapshot);
+int			LatencyHistogram_BucketIndex(const uint64_t value_us);
+uint64_t	LatencyHistogram_BucketStart(const int bucketIdx);
+uint32_t	LatencyHistogram_Percentile(const TYPE_LatencyHistogram *snapshot, const double percentile);
+int			LatencyHistogram_FormatPrometheus(	const TYPE_LatencyHistogram	*snapshot,
+												const char					*metricName,
+												const char					*labelString,
+												char						*outputBuffer,
+												const int					maxLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif		//	_LATENCY_HISTOGRAM_H_
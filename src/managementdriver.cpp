@@ -23,6 +23,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Nov 20,	2019	<MLS> Created managementdriver.cpp
 //*	Nov 21,	2019	<MLS> management driver working
@@ -40,6 +41,7 @@
 //*	Dec 22,	2022	<MLS> Added timestamp to configured devices output
 //*	May 18,	2024	<MLS> Added _DEBUG_MANAGEMENT_
 //*	Jun 28,	2024	<MLS> Removed all "if (reqData != NULL)" from managementdriver.cpp
+//*	Oct 18,	2026	<AGT> Added metrics command, Get_Metrics(), request latency per command
 //*****************************************************************************
 
 //#define	_DEBUG_MANAGEMENT_
@@ -81,6 +83,7 @@ static TYPE_CmdEntry	gManagementCmdTable[]	=
 	{	"cpustats",				kCmd_Managment_cpustats,			kCmdType_GET	},
 	{	"libraries",			kCmd_Managment_libraries,			kCmdType_GET	},
 	{	"readall",				kCmd_Managment_readall,				kCmdType_GET	},
+	{	"metrics",				kCmd_Managment_metrics,				kCmdType_GET	},
 
 	{	"",						-1,	0x00	}
 };
@@ -276,6 +279,10 @@ int					mySocket;
 			alpacaErrCode	=	Get_Readall(reqData, alpacaErrMsg);
 			break;
 
+		case kCmd_Managment_metrics:
+			alpacaErrCode	=	Get_Metrics(reqData, alpacaErrMsg);
+			break;
+
 
 
 		//----------------------------------------------------------------------------------------
@@ -299,42 +306,11 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ClientTransactionID",
-									reqData->ClientTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ServerTransactionID",
-									gServerTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Int32(	mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorNumber",
-								alpacaErrCode,
-								INCLUDE_COMMA);
-
-		JsonResponse_Add_String(mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorMessage",
-								alpacaErrMsg,
-								NO_COMMA);
-
 	#ifdef _DEBUG_MANAGEMENT_
-		CONSOLE_DEBUG("Calling JsonResponse_Add_Finish()");
+		CONSOLE_DEBUG("Calling ProcessCommand_SendResponse()");
 		CONSOLE_DEBUG_W_BOOL("cHttpHeaderSent\t=", cHttpHeaderSent);
 	#endif
-		JsonResponse_Add_Finish(mySocket,
-								reqData->httpRetCode,
-								reqData->jsonTextBuffer,
-								(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	else
 	{
@@ -703,6 +679,44 @@ char				lineBuff2[128];
 	return(alpacaErrCode);
 }
 
+//*****************************************************************************
+//*	the same numbers as /metrics, one entry for each device and command
+//*	that has been used. Times are in micro-seconds
+//*****************************************************************************
+TYPE_ASCOM_STATUS	ManagementDriver::Get_Metrics(TYPE_GetPutRequestData	*reqData,
+										char					*alpacaErrMsg)
+{
+TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_Success;
+int					iii;
+bool				firstEntry;
+
+#ifdef _DEBUG_MANAGEMENT_
+	CONSOLE_DEBUG(__FUNCTION__);
+#endif
+	JsonResponse_Add_ArrayStart(reqData->socket,
+								reqData->jsonTextBuffer,
+								kMaxJsonBuffLen,
+								"Value");
+
+	firstEntry	=	true;
+	for (iii=0; iii<gDeviceCnt; iii++)
+	{
+		if (gAlpacaDeviceList[iii] != NULL)
+		{
+			gAlpacaDeviceList[iii]->OutputMetrics_JSON(reqData, &firstEntry);
+		}
+	}
+	JsonResponse_Add_RawText(	reqData->socket,
+								reqData->jsonTextBuffer,
+								kMaxJsonBuffLen,
+								"\r\n");
+
+	JsonResponse_Add_ArrayEnd(	reqData->socket,
+								reqData->jsonTextBuffer,
+								kMaxJsonBuffLen,
+								INCLUDE_COMMA);
+	return(alpacaErrCode);
+}
 
 //*****************************************************************************
 TYPE_ASCOM_STATUS	ManagementDriver::Get_Readall(TYPE_GetPutRequestData *reqData, char *alpacaErrMsg)
@@ -16,8 +16,10 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Nov 20,	2019	<MLS> Created managment driver
+//*	Oct 18,	2026	<AGT> Added kCmd_Managment_metrics
 //*****************************************************************************
 //#include	"managementdriver.h"
 
@@ -56,6 +58,7 @@ class ManagementDriver: public AlpacaDriver
 			TYPE_ASCOM_STATUS		Get_Description(		TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
 			TYPE_ASCOM_STATUS		Get_Configureddevices(	TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
 			TYPE_ASCOM_STATUS		Get_Libraries(			TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
+			TYPE_ASCOM_STATUS		Get_Metrics(			TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
 	virtual	TYPE_ASCOM_STATUS		Get_Readall(			TYPE_GetPutRequestData *reqData, char *alpacaErrMsg);
 
 							void	ReportOneDevice(		TYPE_GetPutRequestData *reqData, AlpacaDriver *devicePtr, bool includeComma);
@@ -74,6 +77,7 @@ enum
 	kCmd_Managment_cpustats,
 	kCmd_Managment_libraries,
 	kCmd_Managment_readall,
+	kCmd_Managment_metrics,
 
 
 	kCmd_Managment_last
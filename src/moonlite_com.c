@@ -14,6 +14,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb 21,	2020	<MLS> Created moonlite_com.c
 //*	Feb 21,	2020	<MLS> Moving moonlite serial code to separate file
@@ -33,6 +34,9 @@
 //*	Nov 27,	2022	<MLS> Added more debugging to USB_SendCommand()
 //*	Nov 28,	2022	<MLS> Added MoonLite_GetMovingState()
 //*	Dec 11,	2022	<MLS> Fixed sign error for HiRes in MoonLite_GetTemperature()
+//*	Oct 18,	2026	<AGT> Added MoonLite_FormatCommand() & MoonLite_CheckResponse()
+//*	Oct 18,	2026	<AGT> Added MoonLite_GetPositionCmd() & MoonLite_GetMovingStateCmd()
+//*	Oct 18,	2026	<AGT> Added MoonLite_ParsePosition() & MoonLite_Framer() for pipelined reads
 //*****************************************************************************
 
 #if defined(_ENABLE_FOCUSER_MOONLITE_) || defined(_ENABLE_ROTATOR_NITECRAWLER_) || defined(_ENABLE_CTRL_FOCUSERS_)
@@ -484,11 +488,8 @@ bool	MoonLite_SendCommand(	TYPE_MOONLITECOM	*moonliteCom,
 								char				*returnString)
 {
 int		readCnt;
-char	cmdBuffer[8];
 char	readBuffer[48];
 bool	validFlag;
-int		poundSignCnt;
-int		ii;
 
 	validFlag	=	false;
 	if (moonliteCom != NULL)
@@ -505,36 +506,11 @@ int		ii;
 				readBuffer[readCnt]	=	0;
 //				CONSOLE_DEBUG_W_NUM("readCnt\t=", readCnt);
 //				CONSOLE_DEBUG_W_STR("readBuffer\t=", readBuffer);
-				//*	make sure there is a '#' at the end
-				if (readBuffer[readCnt - 1] == '#')
-				{
-					//*	now double check to make sure there is only one "#"
-					poundSignCnt	=	0;
-					for (ii=0; ii<readCnt; ii++)
-					{
-						if (readBuffer[ii] == '#')
-						{
-							poundSignCnt++;
-						}
-					}
-					if (poundSignCnt == 1)
-					{
-						//*	we have valid data
-						validFlag		=	true;
-						strcpy(returnString, readBuffer);
-					}
-					else
-					{
-						CONSOLE_DEBUG_W_STR("Invalid string=", readBuffer);
-						CONSOLE_DEBUG_W_STR("cmdBuffer=", cmdBuffer);
-						moonliteCom->invalidStringErrCnt++;
-					}
-				}
-				else
+				validFlag	=	MoonLite_CheckResponse(moonliteCom, readBuffer);
+				if (validFlag)
 				{
-				//	CONSOLE_DEBUG_W_STR("Invalid string=", readBuffer);
-				//	CONSOLE_DEBUG_W_STR("cmdBuffer=", cmdBuffer);
-					moonliteCom->invalidStringErrCnt++;
+					//*	we have valid data
+					strcpy(returnString, readBuffer);
 				}
 			}
 			else
@@ -577,24 +553,63 @@ int	iii;
 }
 
 //*****************************************************************************
+//*	the response must end with exactly one '#'
 //*	returns true if valid
 //*****************************************************************************
-bool	MoonLite_GetPosition(	TYPE_MOONLITECOM	*moonliteCom,
-								const int			axisNumber,
-								int32_t				*valueToUpdate)
+bool	MoonLite_CheckResponse(TYPE_MOONLITECOM *moonliteCom, const char *responseString)
 {
-char	resultsBuffer[48];
 bool	validFlag;
-char	cmdBuffer[8];
-int		ccc;
+int		poundSignCnt;
+int		sLen;
+int		ii;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
-	MoonLite_FlushReadBuffer(moonliteCom);
+	validFlag	=	false;
+	sLen		=	strlen(responseString);
+	//*	make sure there is a '#' at the end
+	if ((sLen > 0) && (responseString[sLen - 1] == '#'))
+	{
+		//*	now double check to make sure there is only one "#"
+		poundSignCnt	=	0;
+		for (ii=0; ii<sLen; ii++)
+		{
+			if (responseString[ii] == '#')
+			{
+				poundSignCnt++;
+			}
+		}
+		if (poundSignCnt == 1)
+		{
+			validFlag	=	true;
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_STR("Invalid string=", responseString);
+			CONSOLE_DEBUG_W_STR("gLastCmdSent=", gLastCmdSent);
+			moonliteCom->invalidStringErrCnt++;
+		}
+	}
+	else
+	{
+		moonliteCom->invalidStringErrCnt++;
+	}
+	return(validFlag);
+}
+
+//*****************************************************************************
+//*	builds the get position command, without the ':' and '#'
+//*	returns false if the model does not have that axis
+//*****************************************************************************
+bool	MoonLite_GetPositionCmd(	TYPE_MOONLITECOM	*moonliteCom,
+									const int			axisNumber,
+									char				*cmdBuffer)
+{
+bool	validFlag;
+int		ccc;
 
+	validFlag	=	false;
 	if ((moonliteCom->model == kMoonLite_NiteCrawler) ||
 		((moonliteCom->model == kMoonLite_HighRes) && (axisNumber == 1)))
 	{
-		//*	send GetPosition command
 		ccc	=	0;
 		if (moonliteCom->model == kMoonLite_NiteCrawler)
 		{
@@ -604,20 +619,52 @@ int		ccc;
 		cmdBuffer[ccc++]	=	'G';
 		cmdBuffer[ccc++]	=	'P';
 		cmdBuffer[ccc++]	=	0;
+		validFlag			=	true;
+	}
+	return(validFlag);
+}
+
+//*****************************************************************************
+//*	NiteCrawler is decimal, HiRes is hex
+//*****************************************************************************
+int32_t	MoonLite_ParsePosition(TYPE_MOONLITECOM *moonliteCom, const char *responseString)
+{
+int32_t	position;
 
+	if (moonliteCom->model == kMoonLite_NiteCrawler)
+	{
+		position	=	atoi(responseString);
+	}
+	else
+	{
+		position	=	hextoi(responseString);
+	}
+	return(position);
+}
+
+//*****************************************************************************
+//*	returns true if valid
+//*****************************************************************************
+bool	MoonLite_GetPosition(	TYPE_MOONLITECOM	*moonliteCom,
+								const int			axisNumber,
+								int32_t				*valueToUpdate)
+{
+char	resultsBuffer[48];
+bool	validFlag;
+char	cmdBuffer[8];
+
+//	CONSOLE_DEBUG(__FUNCTION__);
+	MoonLite_FlushReadBuffer(moonliteCom);
+
+	validFlag	=	MoonLite_GetPositionCmd(moonliteCom, axisNumber, cmdBuffer);
+	if (validFlag)
+	{
 //		CONSOLE_DEBUG_W_STR("cmdBuffer\t=", cmdBuffer);
 		validFlag	=	MoonLite_SendCommand(moonliteCom, cmdBuffer, resultsBuffer);
 		if (validFlag)
 		{
 //			CONSOLE_DEBUG_W_STR("resultsBuffer\t=", resultsBuffer);
-			if (moonliteCom->model == kMoonLite_NiteCrawler)
-			{
-				*valueToUpdate	=	atoi(resultsBuffer);
-			}
-			else
-			{
-				*valueToUpdate	=	hextoi(resultsBuffer);
-			}
+			*valueToUpdate	=	MoonLite_ParsePosition(moonliteCom, resultsBuffer);
 		}
 		else
 		{
@@ -628,7 +675,6 @@ int		ccc;
 	else
 	{
 		CONSOLE_DEBUG("Invalid request");
-		validFlag	=	false;
 	}
 	return(validFlag);
 }
@@ -642,22 +688,17 @@ int		ccc;
 //*
 //*	returns true if valid
 //*****************************************************************************
-bool	MoonLite_GetMovingState(	TYPE_MOONLITECOM	*moonliteCom,
+bool	MoonLite_GetMovingStateCmd(	TYPE_MOONLITECOM	*moonliteCom,
 									const int			axisNumber,
-									bool				*isMoving)
+									char				*cmdBuffer)
 {
-char	resultsBuffer[48];
 bool	validFlag;
-char	cmdBuffer[8];
 int		ccc;
-int		returnValue;
-
-//	CONSOLE_DEBUG(__FUNCTION__);
 
+	validFlag	=	false;
 	if ((moonliteCom->model == kMoonLite_NiteCrawler) ||
 		((moonliteCom->model == kMoonLite_HighRes) && (axisNumber == 1)))
 	{
-		//*	send GetPosition command
 		ccc	=	0;
 		if (moonliteCom->model == kMoonLite_NiteCrawler)
 		{
@@ -672,14 +713,30 @@ int		returnValue;
 		}
 		//*	send GM or GI
 		cmdBuffer[ccc++]	=	0;
+		validFlag			=	true;
+	}
+	return(validFlag);
+}
+
+//*****************************************************************************
+bool	MoonLite_GetMovingState(	TYPE_MOONLITECOM	*moonliteCom,
+									const int			axisNumber,
+									bool				*isMoving)
+{
+char	resultsBuffer[48];
+bool	validFlag;
+char	cmdBuffer[8];
+
+//	CONSOLE_DEBUG(__FUNCTION__);
 
+	validFlag	=	MoonLite_GetMovingStateCmd(moonliteCom, axisNumber, cmdBuffer);
+	if (validFlag)
+	{
 		validFlag	=	MoonLite_SendCommand(moonliteCom, cmdBuffer, resultsBuffer);
 		if (validFlag)
 		{
 //			CONSOLE_DEBUG_W_STR("resultsBuffer\t=", resultsBuffer);
-			returnValue	=	atoi(resultsBuffer);
-
-			if (returnValue == 0)
+			if (atoi(resultsBuffer) == 0)
 			{
 				*isMoving	=	false;
 			}
@@ -698,7 +755,6 @@ int		returnValue;
 	else
 	{
 		CONSOLE_DEBUG("Invalid request");
-		validFlag	=	false;
 	}
 	return(validFlag);
 }
@@ -1134,6 +1190,57 @@ int		ccc;
 }
 
 
+//**************************************************************************************
+//*	adds the ':' (not used by the NiteCrawler) and the '#'
+//*	returns the length of the command
+//**************************************************************************************
+int	MoonLite_FormatCommand(TYPE_MOONLITECOM *moonliteCom, const char *theCommand, char *cmdBuffer)
+{
+	if (moonliteCom->model != kMoonLite_NiteCrawler)
+	{
+		strcpy(cmdBuffer, ":");
+		strcat(cmdBuffer, theCommand);
+	}
+	else
+	{
+		strcpy(cmdBuffer, theCommand);
+	}
+	strcat(cmdBuffer, "#");
+	strcpy(gLastCmdSent, cmdBuffer);	//*	keep a copy of the last command for debugging
+	return(strlen(cmdBuffer));
+}
+
+//**************************************************************************************
+//*	for reading more than one response at a time, the signature matches AsyncFramerProc
+//*	returns the length of the response, 0 if not complete, < 0 to throw away a NAK
+//**************************************************************************************
+int	MoonLite_Framer(const char *rxData, const int rxLen, const int responseType, const char terminator)
+{
+int		frameLen;
+int		iii;
+
+	(void)responseType;		//*	all of the responses end with the terminator
+	frameLen	=	0;
+	if ((rxLen >= 3) && (strncmp(rxData, "NAK", 3) == 0))
+	{
+		CONSOLE_DEBUG_W_STR("NAK received, last cmd\t=", gLastCmdSent);
+		frameLen	=	-3;
+	}
+	else
+	{
+		iii	=	0;
+		while ((frameLen == 0) && (iii < rxLen))
+		{
+			if (rxData[iii] == terminator)
+			{
+				frameLen	=	iii + 1;
+			}
+			iii++;
+		}
+	}
+	return(frameLen);
+}
+
 //**************************************************************************************
 //*	returns # of bytes written
 //**************************************************************************************
@@ -1147,18 +1254,7 @@ int				bytesWritten;
 	if (moonliteCom->fileDesc >= 0)
 	{
 //		CONSOLE_DEBUG_W_NUM("moonliteCom->model\t=", moonliteCom->model);
-		if (moonliteCom->model != kMoonLite_NiteCrawler)
-		{
-			strcpy(cmdBuffer, ":");
-			strcat(cmdBuffer, theCommand);
-		}
-		else
-		{
-			strcpy(cmdBuffer, theCommand);
-		}
-		strcat(cmdBuffer, "#");
-		strcpy(gLastCmdSent, cmdBuffer);	//*	keep a copy of the last command for debugging
-		sLen			=	strlen(cmdBuffer);
+		sLen			=	MoonLite_FormatCommand(moonliteCom, theCommand, cmdBuffer);
 
 //		CONSOLE_DEBUG_W_STR("sending:", cmdBuffer);
 		bytesWritten	=	write(moonliteCom->fileDesc, cmdBuffer, sLen);
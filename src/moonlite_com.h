@@ -52,6 +52,17 @@ void	MoonLite_InitCom(					TYPE_MOONLITECOM *moonliteCom, int serialPortIndex);
 bool	MoonLite_OpenFocuserConnection(		TYPE_MOONLITECOM *moonliteCom, bool checkForNiteCrawler);
 bool	MoonLite_CloseFocuserConnection(	TYPE_MOONLITECOM *moonliteCom);
 bool	MoonLite_FlushReadBuffer(			TYPE_MOONLITECOM *moonliteCom);
+int		MoonLite_FormatCommand(				TYPE_MOONLITECOM *moonliteCom, const char *theCommand, char *cmdBuffer);
+bool	MoonLite_CheckResponse(				TYPE_MOONLITECOM *moonliteCom, const char *responseString);
+int		MoonLite_Framer(const char *rxData, const int rxLen, const int responseType, const char terminator);
+bool	MoonLite_GetPositionCmd(	TYPE_MOONLITECOM	*moonliteCom,
+									const int			axisNumber,
+									char				*cmdBuffer);
+int32_t	MoonLite_ParsePosition(		TYPE_MOONLITECOM	*moonliteCom,
+									const char			*responseString);
+bool	MoonLite_GetMovingStateCmd(	TYPE_MOONLITECOM	*moonliteCom,
+									const int			axisNumber,
+									char				*cmdBuffer);
 bool	MoonLite_GetPosition(	TYPE_MOONLITECOM	*moonliteCom,
 								const int			axisNumber,
 								int32_t				*valueToUpdate);
@@ -239,45 +239,7 @@ int					mySocket;
 			break;
 	}
 	//*	send the response information
-	JsonResponse_Add_Int32(		mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ClientTransactionID",
-								reqData->ClientTransactionID,
-								INCLUDE_COMMA);
-
-	JsonResponse_Add_Int32(		mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ServerTransactionID",
-								gServerTransactionID,
-								INCLUDE_COMMA);
-
-	JsonResponse_Add_Int32(		mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorNumber",
-								alpacaErrCode,
-								INCLUDE_COMMA);
-
-//	JsonResponse_Add_Int32(		mySocket,
-//								reqData->jsonTextBuffer,
-//								kMaxJsonBuffLen,
-//								"NewState",
-//								domeState,
-//								INCLUDE_COMMA);
-
-	JsonResponse_Add_String(	mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorMessage",
-								alpacaErrMsg,
-								NO_COMMA);
-
-	JsonResponse_Add_Finish(	mySocket,
-								reqData->httpRetCode,
-								reqData->jsonTextBuffer,
-								(cHttpHeaderSent == false));
+	ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -408,33 +370,33 @@ char				myFileNameSuffix[kFileNamePrefixMaxLen];
 //	CONSOLE_DEBUG_W_STR("contentData\t=",	reqData->contentData);
 
 
-	objectNameFound		=	GetKeyWordArgument(	reqData->contentData,
+	objectNameFound		=	GetKeyWordArgument(	reqData,
 												"Object",
 												myObjectName,
 												kObjectNameMaxLen);
 
-	telescopeNameFound	=	GetKeyWordArgument(	reqData->contentData,
+	telescopeNameFound	=	GetKeyWordArgument(	reqData,
 												"Telescope",
 												myTelescopeName,
 												kTelescopeNameMaxLen);
 
-	filenamePrefixFound	=	GetKeyWordArgument(	reqData->contentData,
+	filenamePrefixFound	=	GetKeyWordArgument(	reqData,
 												"Prefix",
 												myFileNamePrefix,
 												kFileNamePrefixMaxLen);
 
-	filenameSuffixFound	=	GetKeyWordArgument(	reqData->contentData,
+	filenameSuffixFound	=	GetKeyWordArgument(	reqData,
 												"Suffix",
 												myFileNameSuffix,
 												kFileNamePrefixMaxLen);
 
-//		imageTypeFound		=	GetKeyWordArgument(	reqData->contentData,
+//		imageTypeFound		=	GetKeyWordArgument(	reqData,
 //													"Imagetype",
 //													myImageType,
 //													30);
 
 	//*	Duration=1000.0&Light=true HTTP/1.1
-	durationFound		=	GetKeyWordArgument(	reqData->contentData,
+	durationFound		=	GetKeyWordArgument(	reqData,
 												"Duration",
 												durationString,
 												100);
@@ -547,7 +509,7 @@ char				durationString[128];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	durationFound		=	GetKeyWordArgument(	reqData->contentData,
+	durationFound		=	GetKeyWordArgument(	reqData,
 												"Duration",
 												durationString,
 												100);
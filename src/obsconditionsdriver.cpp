@@ -306,38 +306,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ClientTransactionID",
-									reqData->ClientTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ServerTransactionID",
-									gServerTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Int32(		mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ErrorNumber",
-									alpacaErrCode,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_String(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ErrorMessage",
-									alpacaErrMsg,
-									NO_COMMA);
-
-		JsonResponse_Add_Finish(	mySocket,
-									reqData->httpRetCode,
-									reqData->jsonTextBuffer,
-									(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -498,7 +467,7 @@ bool					avgPeriodFound;
 char					avgPeriodString[32];
 double					avgPeriodValue;
 //	CONSOLE_DEBUG(__FUNCTION__);
-	avgPeriodFound	=	GetKeyWordArgument(	reqData->contentData,
+	avgPeriodFound	=	GetKeyWordArgument(	reqData,
 											"AveragePeriod",
 											avgPeriodString,
 											(sizeof(avgPeriodString) -1),
@@ -975,7 +944,7 @@ TYPE_ObsConSensorType	mySensorType;
 double					lastUpdateTime;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	sensorNameFound	=	GetKeyWordArgument(	reqData->contentData,
+	sensorNameFound	=	GetKeyWordArgument(	reqData,
 											"SensorName",
 											sensorNameString,
 											(sizeof(sensorNameString) -1));
@@ -1025,7 +994,7 @@ double					lastUpdateTime;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG(reqData->contentData);
-	sensorNameFound	=	GetKeyWordArgument(	reqData->contentData,
+	sensorNameFound	=	GetKeyWordArgument(	reqData,
 											"SensorName",
 											sensorNameString,
 											(sizeof(sensorNameString) -1));
@@ -313,38 +313,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ClientTransactionID",
-										reqData->ClientTransactionID,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ServerTransactionID",
-										gServerTransactionID,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(		mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ErrorNumber",
-										alpacaErrCode,
-										INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(	mySocket,
-										reqData->jsonTextBuffer,
-										kMaxJsonBuffLen,
-										"ErrorMessage",
-										alpacaErrMsg,
-										NO_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -479,7 +448,7 @@ TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_NotImplemented;
 bool				foundKeyWord;
 char				argumentString[32];
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Reverse",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -562,7 +531,7 @@ double				newPositionOffset_deg;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -602,7 +571,7 @@ double	newPosition_degs;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1),
@@ -669,7 +638,7 @@ double				newPositionDelta;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -707,7 +676,7 @@ char				argumentString[32];
 int32_t				newPositionOffset;
 int32_t				newPosition;
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -741,7 +710,7 @@ int32_t				newPosition;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	foundKeyWord	=	GetKeyWordArgument(	reqData->contentData,
+	foundKeyWord	=	GetKeyWordArgument(	reqData,
 											"Position",
 											argumentString,
 											(sizeof(argumentString) -1));
@@ -24,6 +24,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 30,	2020	<MLS> Created sendrequest_lib.c
 //*	May 28,	2020	<MLS> Added timeout to SendPutCommand()
@@ -38,6 +39,12 @@
 //*	Sep  4,	2021	<MLS> Added microsecs arg to SetSocketTimeouts()
 //*	Sep  8,	2021	<MLS> Added "Connection: close" as per suggestion from Patrick Chevalley
 //*	Dec 14,	2021	<MLS> Added imagebytes option to OpenSocketAndSendRequest()
+//*	Oct 18,	2026	<AGT> Added per host keep-alive connection pool
+//*	Oct 18,	2026	<AGT> GetJsonResponse() & SendPutCommand() now re-use pooled connections
+//*	Oct 18,	2026	<AGT> Pooled connections are checked before sending, PUT uses the pool too
+//*	Oct 18,	2026	<AGT> Responses are now read using Content-Length when present
+//*	Oct 18,	2026	<AGT> Added Set_SendRequestLibKeepAlive()
+//*	Oct 18,	2026	<AGT> Only retry when the pooled connection was closed, never after a time out or for PUT
 //*****************************************************************************
 
 #include	<stdio.h>
@@ -51,6 +58,8 @@
 #include	<netinet/in.h>
 #include	<errno.h>
 #include	<ctype.h>
+#include	<time.h>
+#include	<pthread.h>
 
 //#define _DEBUG_TIMING_
 #define _ENABLE_CONSOLE_DEBUG_
@@ -110,6 +119,381 @@ int					setOptRetCode;
 	return(setOptRetCode);
 }
 
+//*****************************************************************************
+//*	Connection pool
+//*		Sockets to devices that answered with "Connection: keep-alive" are kept
+//*		here and re-used by the next request to the same address/port.
+//*		The idle time out must be shorter than the servers (AlpacaPi uses 5 seconds)
+//*****************************************************************************
+#define	kMaxPooledConnections		16
+#define	kPoolIdleTimeOut_Secs		3
+
+typedef struct	//	TYPE_PooledConnection
+{
+	bool			inUse;
+	int				socketFD;
+	in_addr_t		ipAddress;
+	int				port;
+	time_t			lastUsed;
+} TYPE_PooledConnection;
+
+static	TYPE_PooledConnection	gConnectionPool[kMaxPooledConnections];
+static	pthread_mutex_t			gConnectionPoolMutex	=	PTHREAD_MUTEX_INITIALIZER;
+static	bool					gEnableKeepAlive		=	true;
+
+//*****************************************************************************
+void	Set_SendRequestLibKeepAlive(bool enableFlag)
+{
+	gEnableKeepAlive	=	enableFlag;
+}
+
+//*****************************************************************************
+static void	CloseConnection(int socket_desc)
+{
+int		shutDownRetCode;
+int		closeRetCode;
+
+	shutDownRetCode	=	shutdown(socket_desc, SHUT_RDWR);
+	if ((shutDownRetCode != 0) && (errno != ENOTCONN))
+	{
+		CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
+		CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+		CONSOLE_DEBUG(strerror(errno));
+	}
+	closeRetCode	=	close(socket_desc);
+	if (closeRetCode != 0)
+	{
+		CONSOLE_DEBUG("Close error");
+	}
+}
+
+//*****************************************************************************
+//*	returns an open socket to the device or -1 if there is none in the pool
+//*****************************************************************************
+static int	ConnectionPool_Get(struct sockaddr_in *deviceAddress, const int port)
+{
+int		socket_desc;
+time_t	currentTime;
+int		iii;
+
+	socket_desc	=	-1;
+	currentTime	=	time(NULL);
+	pthread_mutex_lock(&gConnectionPoolMutex);
+	for (iii=0; iii<kMaxPooledConnections; iii++)
+	{
+		if (gConnectionPool[iii].inUse &&
+			(gConnectionPool[iii].ipAddress == deviceAddress->sin_addr.s_addr) &&
+			(gConnectionPool[iii].port == port))
+		{
+			gConnectionPool[iii].inUse	=	false;
+			if ((currentTime - gConnectionPool[iii].lastUsed) < kPoolIdleTimeOut_Secs)
+			{
+				socket_desc	=	gConnectionPool[iii].socketFD;
+				break;
+			}
+			//*	the server has probably closed it by now
+			CloseConnection(gConnectionPool[iii].socketFD);
+		}
+	}
+	pthread_mutex_unlock(&gConnectionPoolMutex);
+	return(socket_desc);
+}
+
+//*****************************************************************************
+static void	ConnectionPool_Put(struct sockaddr_in *deviceAddress, const int port, int socket_desc)
+{
+int		iii;
+bool	wasSaved;
+
+	wasSaved	=	false;
+	pthread_mutex_lock(&gConnectionPoolMutex);
+	for (iii=0; iii<kMaxPooledConnections; iii++)
+	{
+		if (gConnectionPool[iii].inUse == false)
+		{
+			gConnectionPool[iii].inUse		=	true;
+			gConnectionPool[iii].socketFD	=	socket_desc;
+			gConnectionPool[iii].ipAddress	=	deviceAddress->sin_addr.s_addr;
+			gConnectionPool[iii].port		=	port;
+			gConnectionPool[iii].lastUsed	=	time(NULL);
+			wasSaved						=	true;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&gConnectionPoolMutex);
+	if (wasSaved == false)
+	{
+		CloseConnection(socket_desc);
+	}
+}
+
+//*****************************************************************************
+//*	true if the server closed the connection while it was in the pool
+//*	(or sent something we did not ask for), nothing has been sent on it yet.
+//*****************************************************************************
+static bool	ConnectionIsStale(int socket_desc)
+{
+char	peekByte;
+int		peekRetCode;
+bool	isStale;
+
+	peekRetCode	=	recv(socket_desc, &peekByte, 1, (MSG_PEEK | MSG_DONTWAIT));
+	isStale		=	true;
+	if ((peekRetCode < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+	{
+		//*	open and nothing waiting
+		isStale	=	false;
+	}
+	return(isStale);
+}
+
+//*****************************************************************************
+//*	returns a connected socket or -1
+//*****************************************************************************
+static int	OpenConnection(struct sockaddr_in *deviceAddress, const int port, const char *sendData)
+{
+int					socket_desc;
+struct sockaddr_in	remoteDev;
+int					connRetCode;
+int					setOptRetCode;
+char				ipString[32];
+
+	inet_ntop(AF_INET, &deviceAddress->sin_addr.s_addr, ipString, INET_ADDRSTRLEN);
+	socket_desc	=	socket(AF_INET , SOCK_STREAM , 0);
+	if (socket_desc >= 0)
+	{
+		gNumSocketOpenOKcnt++;
+		//*	set a timeout
+		setOptRetCode	=	SetSocketTimeouts(socket_desc, kTimeOutLenSeconds, 0);
+		if (setOptRetCode != 0)
+		{
+			CONSOLE_DEBUG("SetSocketTimeouts() failed");
+		}
+		remoteDev.sin_addr.s_addr	=	deviceAddress->sin_addr.s_addr;
+		remoteDev.sin_family		=	AF_INET;
+		remoteDev.sin_port			=	htons(port);
+
+		//*	Connect to remote device
+		connRetCode	=	connect(socket_desc , (struct sockaddr *)&remoteDev , sizeof(remoteDev));
+		if (connRetCode >= 0)
+		{
+			gNumSocketConnOKcnt++;
+		}
+		else
+		{
+			gNumSocketConnErrCnt++;
+			if (errno == ECONNREFUSED)
+			{
+			char	portString[32];
+
+				sprintf(portString, ":%d", port);
+				CONSOLE_DEBUG_W_2STR("connect refused", ipString, portString);
+			}
+			else
+			{
+			char	errorString[64];
+
+				CONSOLE_DEBUG_W_STR("connect error, ipaddress\t=",	ipString);
+				CONSOLE_DEBUG_W_STR("connect error, send data\t=",	sendData);
+
+				GetLinuxErrorString(errno, errorString);
+				CONSOLE_DEBUG_W_STR("Error message\t\t=",	errorString);
+			}
+			close(socket_desc);
+			socket_desc	=	-1;
+		}
+	}
+	else
+	{
+		gNumSocketOpenErrCnt++;
+		if (errno == EMFILE)
+		{
+			CONSOLE_DEBUG("Too many files open!!!!!!!!!!!!!!!!!!!!!!!!!");
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("socket_desc\t=", socket_desc);
+			CONSOLE_DEBUG_W_NUM("errno\t\t=", errno);
+		}
+	}
+	return(socket_desc);
+}
+
+//*****************************************************************************
+//*	returns a pointer to the value of the header field or NULL if not present
+//*****************************************************************************
+static const char	*FindHttpHeaderField(const char *httpHeader, const char *headerEnd, const char *fieldName)
+{
+const char	*linePtr;
+const char	*valuePtr;
+int			fieldNameLen;
+
+	valuePtr		=	NULL;
+	fieldNameLen	=	strlen(fieldName);
+	linePtr			=	strchr(httpHeader, '\n');
+	while ((linePtr != NULL) && (linePtr < headerEnd) && (valuePtr == NULL))
+	{
+		linePtr++;
+		if (strncasecmp(linePtr, fieldName, fieldNameLen) == 0)
+		{
+			valuePtr	=	linePtr + fieldNameLen;
+			while (*valuePtr == ' ')
+			{
+				valuePtr++;
+			}
+		}
+		linePtr	=	strchr(linePtr, '\n');
+	}
+	return(valuePtr);
+}
+
+//*****************************************************************************
+//*	Reads one response, using Content-Length to find the end if it is present,
+//*	otherwise reads until the server closes the connection (or the buffer is full).
+//*	keepAlive is set to true if the socket can be used for another request.
+//*	peerClosed is set to true if the server closed the connection before sending anything,
+//*	a receive time out does NOT count, the server may still be working on the request.
+//*	returns the number of bytes read, the buffer is null terminated
+//*****************************************************************************
+static int	ReadHttpResponse(int socket_desc, char *responseBuff, const int buffLen, bool *keepAlive, bool *peerClosed)
+{
+int			totalBytes;
+int			responseLen;
+int			recvByteCnt;
+const char	*headerEnd;
+const char	*fieldValue;
+
+	*keepAlive		=	false;
+	*peerClosed		=	false;
+	totalBytes		=	0;
+	responseLen		=	-1;
+	headerEnd		=	NULL;
+	responseBuff[0]	=	0;
+	while ((totalBytes < (buffLen - 1)) && ((responseLen < 0) || (totalBytes < responseLen)))
+	{
+		recvByteCnt	=	recv(socket_desc, (responseBuff + totalBytes), (buffLen - 1 - totalBytes), MSG_NOSIGNAL);
+		if (gEnableDebug)
+		{
+			CONSOLE_DEBUG_W_NUM("recvByteCnt\t=",	recvByteCnt);
+		}
+		if (recvByteCnt <= 0)
+		{
+			if ((totalBytes == 0) && ((recvByteCnt == 0) || (errno == ECONNRESET)))
+			{
+				*peerClosed	=	true;
+			}
+			break;
+		}
+		totalBytes					+=	recvByteCnt;
+		responseBuff[totalBytes]	=	0;
+		if (headerEnd == NULL)
+		{
+			headerEnd	=	strstr(responseBuff, "\r\n\r\n");
+			if (headerEnd != NULL)
+			{
+				fieldValue	=	FindHttpHeaderField(responseBuff, headerEnd, "Content-Length:");
+				if (fieldValue != NULL)
+				{
+					responseLen	=	(headerEnd - responseBuff) + 4 + atoi(fieldValue);
+				}
+				fieldValue	=	FindHttpHeaderField(responseBuff, headerEnd, "Connection:");
+				if ((fieldValue != NULL) && (strncasecmp(fieldValue, "keep-alive", 10) == 0))
+				{
+					*keepAlive	=	true;
+				}
+			}
+		}
+	}
+	//*	if we did not get exactly what was promised, the connection cannot be re-used
+	if (totalBytes != responseLen)
+	{
+		*keepAlive	=	false;
+	}
+	return(totalBytes);
+}
+
+//*****************************************************************************
+//*	Sends the request on a pooled connection if there is one, otherwise opens a new one.
+//*	A pooled connection the server has already closed is found before anything
+//*	is sent on it and replaced with a new one, the same if the send fails.
+//*	If the server closes it without sending anything back after the request
+//*	went out, the request is only sent again if canRetry is set.
+//*	A time out is never retried, the server may have already acted on it.
+//*	Requests that must not run twice (PUT) set canRetry to false.
+//*	returns the number of bytes read or -1 if the request could not be sent
+//*****************************************************************************
+static int	SendRequestAndReadResponse(	struct sockaddr_in	*deviceAddress,
+										const int			port,
+										const char			*sendData,
+										const char			*xmitBuffer,
+										char				*responseBuff,
+										const int			buffLen,
+										const bool			canRetry)
+{
+int		socket_desc;
+int		sendRetCode;
+int		recvByteCnt;
+bool	reusedSocket;
+bool	keepAlive;
+bool	peerClosed;
+bool	tryAgain;
+
+	recvByteCnt	=	-1;
+	do
+	{
+		tryAgain		=	false;
+		reusedSocket	=	false;
+		socket_desc		=	-1;
+		if (gEnableKeepAlive)
+		{
+			socket_desc		=	ConnectionPool_Get(deviceAddress, port);
+			if ((socket_desc >= 0) && ConnectionIsStale(socket_desc))
+			{
+				CloseConnection(socket_desc);
+				socket_desc	=	-1;
+			}
+			reusedSocket	=	(socket_desc >= 0);
+		}
+		if (socket_desc < 0)
+		{
+			socket_desc	=	OpenConnection(deviceAddress, port, sendData);
+		}
+		if (socket_desc >= 0)
+		{
+			keepAlive	=	false;
+			peerClosed	=	false;
+			sendRetCode	=	send(socket_desc , xmitBuffer , strlen(xmitBuffer) , MSG_NOSIGNAL);
+			if (sendRetCode >= 0)
+			{
+				recvByteCnt	=	ReadHttpResponse(socket_desc, responseBuff, buffLen, &keepAlive, &peerClosed);
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_NUM("sendRetCode\t=", sendRetCode);
+				//*	nothing went out, it is safe to send it on a new connection
+				tryAgain	=	reusedSocket;
+			}
+
+			if (reusedSocket && peerClosed && canRetry)
+			{
+				//*	stale connection, the server closed it before it saw the request
+				recvByteCnt	=	-1;
+				tryAgain	=	true;
+			}
+			if (keepAlive && gEnableKeepAlive)
+			{
+				ConnectionPool_Put(deviceAddress, port, socket_desc);
+			}
+			else
+			{
+				CloseConnection(socket_desc);
+			}
+		}
+	} while (tryAgain);
+
+	return(recvByteCnt);
+}
+
 //*****************************************************************************
 //*	returns a socket description
 //*****************************************************************************
@@ -250,23 +634,12 @@ bool	GetJsonResponse(	struct sockaddr_in	*deviceAddress,
 							SJP_Parser_t		*jsonParser)
 {
 bool				validData;
-int					socket_desc;
-struct sockaddr_in	remoteDev;
-int					connRetCode;
-int					sendRetCode;
-int					shutDownRetCode;
-int					closeRetCode;
 int					recvByteCnt;
-char				returnedData[kReadBuffLen + 10];
 char				xmitBuffer[kReadBuffLen + 10];
 char				longBuffer[kLargeBufferSize + 10];
 char				linebuf[100];
 int					dataStrLen;
 char				ipString[32];
-bool				keepReading;
-int					setOptRetCode;
-int					readLoopCnt;		//*	for debugging
-int					readSuccessCnt;		//*	for debugging
 int					parseReturnCode;
 
 	if (gEnableDebug)
@@ -274,7 +647,6 @@ int					parseReturnCode;
 		CONSOLE_DEBUG_W_STR(__FUNCTION__, "------start-------");
 		CONSOLE_DEBUG(sendData);
 		CONSOLE_DEBUG_W_SIZE("sizeof(xmitBuffer)  \t=", sizeof(xmitBuffer));
-		CONSOLE_DEBUG_W_SIZE("sizeof(returnedData)\t=", sizeof(returnedData));
 		CONSOLE_DEBUG_W_SIZE("sizeof(longBuffer)  \t=", sizeof(longBuffer));
 	}
 	inet_ntop(AF_INET, &deviceAddress->sin_addr.s_addr, ipString, INET_ADDRSTRLEN);
@@ -282,32 +654,7 @@ int					parseReturnCode;
 	SETUP_TIMING();
 
 	validData	=	false;
-	socket_desc	=	socket(AF_INET , SOCK_STREAM , 0);
-	if (socket_desc >= 0)
-	{
-		if (gEnableDebug)
-		{
-			CONSOLE_DEBUG("Setting Timeout");
-		}
-		//*	set a timeout
-		setOptRetCode	=	SetSocketTimeouts(socket_desc, kTimeOutLenSeconds, 0);
-	//	setOptRetCode	=	SetSocketTimeouts(socket_desc, 0, 25000);
-		if (setOptRetCode != 0)
-		{
-			CONSOLE_DEBUG("SetSocketTimeouts() failed");
-		}
-		gNumSocketOpenOKcnt++;
-		remoteDev.sin_addr.s_addr	=	deviceAddress->sin_addr.s_addr;
-		remoteDev.sin_family		=	AF_INET;
-		remoteDev.sin_port			=	htons(port);
 
-		//*	Connect to remote device
-		connRetCode	=	connect(socket_desc , (struct sockaddr *)&remoteDev , sizeof(remoteDev));
-		if (connRetCode >= 0)
-		{
-//			CONSOLE_DEBUG("Connected");
-
-			gNumSocketConnOKcnt++;
 //	GET /api/v1/camera/0/supportedactions HTTP/1.1
 //	Host: newt16:6800
 //	User-Agent: Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:71.0) Gecko/20100101 Firefox/71.0
@@ -325,167 +672,64 @@ int					parseReturnCode;
 //	Accept-Language: en-US,en;q=0.5
 //	Connection: keep-alive
 
+	if (gEnableDebug)
+	{
+		CONSOLE_DEBUG("Building xmitBuffer");
+	}
+	//*	Still HTTP/1.0 to disable "Transfer-Encoding: chunked",
+	//*	keep-alive is requested explicitly
+	strcpy(xmitBuffer,	"GET ");
+	strcat(xmitBuffer,	sendData);
+	strcat(xmitBuffer,	" HTTP/1.0\r\n");
+	sprintf(linebuf,	"Host: %s:%d\r\n", ipString, port);
+	strcat(xmitBuffer,	linebuf);
+	if (strlen(gUserAgentAlpacaPiStr))
+	{
+		//*	add User-Agent:
+		strcat(xmitBuffer,	gUserAgentAlpacaPiStr);
+	}
+	strcat(xmitBuffer,	"Accept: text/html,application/json\r\n");
 
-			if (gEnableDebug)
-			{
-				CONSOLE_DEBUG("Building xmitBuffer");
-			}
-			strcpy(xmitBuffer,	"GET ");
-			strcat(xmitBuffer,	sendData);
-			strcat(xmitBuffer,	" HTTP/1.0\r\n");
-//			strcat(xmitBuffer,	"Host: ascom:11111\r\n");
-			sprintf(linebuf,	"Host: %s:%d\r\n", ipString, port);
-			strcat(xmitBuffer,	linebuf);
-//			strcat(xmitBuffer,	"User-Agent: AlpacaPi\r\n");
-			if (strlen(gUserAgentAlpacaPiStr))
-			{
-				//*	add User-Agent:
-				strcat(xmitBuffer,	gUserAgentAlpacaPiStr);
-			}
-			strcat(xmitBuffer,	"Accept: text/html,application/json\r\n");
-
-			strcat(xmitBuffer,	"Accept-Language: en-US,en;q=0.5\r\n");
-			strcat(xmitBuffer,	"Connection: close\r\n");
-
-			if (gEnableDebug)
-			{
-				CONSOLE_DEBUG_W_SIZE("length xmitBuffer\t=", strlen(xmitBuffer));
-			}
-
-//			if (strstr(sendData, "switch") !=  NULL)
-//			{
-//				CONSOLE_DEBUG_W_STR("xmitBuffer\t=", xmitBuffer);
-//			}
-
-			if (dataString != NULL)
-			{
-//				CONSOLE_DEBUG_W_STR("dataString\t=", dataString);
-				dataStrLen	=	strlen(dataString);
-				sprintf(linebuf, "Content-Length: %d\r\n", dataStrLen);
-				strcat(xmitBuffer, linebuf);
-				strcat(xmitBuffer, "\r\n");
-
-				strcat(xmitBuffer, dataString);
-				strcat(xmitBuffer, "\r\n");
-			}
-			//*	this EXTRA CR/LF is VERY important for Alpaca Remote Server
-			strcat(xmitBuffer, "\r\n");
-
-			if (gEnableDebug)
-			{
-				CONSOLE_DEBUG_W_SIZE("length xmitBuffer\t=", strlen(xmitBuffer));
-			}
-
-//			CONSOLE_DEBUG(xmitBuffer);
-
-			sendRetCode	=	send(socket_desc , xmitBuffer , strlen(xmitBuffer) , MSG_NOSIGNAL);
-			if (sendRetCode >= 0)
-			{
-				if (gEnableDebug)
-				{
-					CONSOLE_DEBUG("Request sent");
-				}
-				keepReading		=	true;
-				longBuffer[0]	=	0;
-				readLoopCnt		=	0;
-				readSuccessCnt	=	0;
-				while (keepReading && ((strlen(longBuffer) + kReadBuffLen) < kLargeBufferSize))
-				{
-					readLoopCnt++;
-				//	recvByteCnt	=	recv(socket_desc, returnedData, kReadBuffLen, 0);
-					recvByteCnt	=	recv(socket_desc, returnedData, kReadBuffLen, MSG_NOSIGNAL);
-					if (gEnableDebug)
-					{
-						CONSOLE_DEBUG_W_NUM("errno      \t=",	errno);
-						CONSOLE_DEBUG_W_NUM("recvByteCnt\t=",	recvByteCnt);
-					}
-					if (recvByteCnt > 0)
-					{
-						readSuccessCnt++;
-						returnedData[recvByteCnt]	=	0;
-//						CONSOLE_DEBUG_W_NUM("recvByteCnt\t=",	recvByteCnt);
-//						if (strstr(sendData, "switch") !=  NULL)
-//						{
-//							CONSOLE_DEBUG_W_STR("returnedData\t=", returnedData);
-//						}
-						validData	=	true;
-
-//						CONSOLE_DEBUG_W_STR("returnedData\t=",	returnedData);
-
-						strcat(longBuffer, returnedData);
-					}
-					else
-					{
-						keepReading		=	false;
-					}
-				}
-				if (gEnableDebug)
-				{
-					CONSOLE_DEBUG_W_NUM("readLoopCnt   \t=",	readLoopCnt);
-					CONSOLE_DEBUG_W_NUM("readSuccessCnt\t=",	readSuccessCnt);
-					CONSOLE_DEBUG_W_STR("longBuffer    \t=",	longBuffer);
-				}
-				SJP_Init(jsonParser);
-				parseReturnCode	=	SJP_ParseData(jsonParser, longBuffer);
-				if ((parseReturnCode != 0) || gEnableDebug)
-				{
-					CONSOLE_DEBUG_W_NUM("parseReturnCode   \t=",	parseReturnCode);
-				}
-			}
-			else
-			{
-				CONSOLE_DEBUG_W_NUM("sendRetCode\t=", sendRetCode);
-			}
-			if (gEnableDebug)
-			{
-				CONSOLE_DEBUG("Calling shutdown");
-			}
-			shutDownRetCode	=	shutdown(socket_desc, SHUT_RDWR);
-			if (shutDownRetCode != 0)
-			{
-				CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
-				CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-				CONSOLE_DEBUG(strerror(errno));
-
-			}
-//			CONSOLE_DEBUG(__FUNCTION__);
-		}
-		else if (errno == ECONNREFUSED)
-		{
-		char	portString[32];
-
-			sprintf(portString, ":%d", port);
-			CONSOLE_DEBUG_W_2STR("connect refused", ipString, portString);
-		}
-		else
-		{
-		char	errorString[64];
+	strcat(xmitBuffer,	"Accept-Language: en-US,en;q=0.5\r\n");
+	strcat(xmitBuffer,	(gEnableKeepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n"));
 
-			CONSOLE_DEBUG_W_STR("connect error, ipaddress\t=",	ipString);
-			CONSOLE_DEBUG_W_STR("connect error, send data\t=",	sendData);
-		//	CONSOLE_DEBUG_W_NUM("errno\t\t\t=", errno);
+	if (dataString != NULL)
+	{
+		dataStrLen	=	strlen(dataString);
+		sprintf(linebuf, "Content-Length: %d\r\n", dataStrLen);
+		strcat(xmitBuffer, linebuf);
+		strcat(xmitBuffer, "\r\n");
 
-			GetLinuxErrorString(errno, errorString);
+		strcat(xmitBuffer, dataString);
+		strcat(xmitBuffer, "\r\n");
+	}
+	//*	this EXTRA CR/LF is VERY important for Alpaca Remote Server
+	strcat(xmitBuffer, "\r\n");
 
-			CONSOLE_DEBUG_W_STR("Error message\t\t=",	errorString);
-		}
-		closeRetCode	=	close(socket_desc);
-		if (closeRetCode != 0)
-		{
-			CONSOLE_DEBUG("Close error");
-		}
-//		CONSOLE_DEBUG(__FUNCTION__);
+	if (gEnableDebug)
+	{
+		CONSOLE_DEBUG_W_SIZE("length xmitBuffer\t=", strlen(xmitBuffer));
 	}
-	else
+
+	recvByteCnt	=	SendRequestAndReadResponse(	deviceAddress,
+												port,
+												sendData,
+												xmitBuffer,
+												longBuffer,
+												kLargeBufferSize,
+												true);
+	if (recvByteCnt > 0)
 	{
-		if (errno == EMFILE)
+		validData	=	true;
+		if (gEnableDebug)
 		{
-			CONSOLE_DEBUG("Too many files open!!!!!!!!!!!!!!!!!!!!!!!!!");
+			CONSOLE_DEBUG_W_STR("longBuffer    \t=",	longBuffer);
 		}
-		else
+		SJP_Reset(jsonParser);
+		parseReturnCode	=	SJP_ParseData(jsonParser, longBuffer);
+		if ((parseReturnCode != 0) || gEnableDebug)
 		{
-			CONSOLE_DEBUG_W_NUM("socket_desc\t=", socket_desc);
-			CONSOLE_DEBUG_W_NUM("errno\t\t=", errno);
+			CONSOLE_DEBUG_W_NUM("parseReturnCode   \t=",	parseReturnCode);
 		}
 	}
 	if (gEnableDebug)
@@ -512,170 +756,88 @@ bool	SendPutCommand(	struct sockaddr_in	*deviceAddress,
 						SJP_Parser_t		*jsonParser)
 {
 bool				validData;
-int					socket_desc;
-struct sockaddr_in	remoteDev;
-int					connRetCode;
-int					sendRetCode;
-int					shutDownRetCode;
-int					closeRetCode;
 int					recvByteCnt;
 char				returnedData[kReadBuffLen];
 char				xmitBuffer[kReadBuffLen];
 char				linebuf[128];
 int					dataStrLen;
 char				ipString[32];
-int					setOptRetCode;
 
 //	CONSOLE_DEBUG_W_STR("putCommand\t=", putCommand);
 //	CONSOLE_DEBUG_W_STR("dataString\t=", dataString);
-//	CONSOLE_ABORT(__FUNCTION__);
 
 	inet_ntop(AF_INET, &deviceAddress->sin_addr.s_addr, ipString, INET_ADDRSTRLEN);
 
 	validData	=	false;
-	socket_desc	=	socket(AF_INET , SOCK_STREAM , 0);
-	if (socket_desc >= 0)
-	{
-		//*	set a timeout
-		setOptRetCode	=	SetSocketTimeouts(socket_desc, kTimeOutLenSeconds, 0);
-	//	setOptRetCode	=	SetSocketTimeouts(socket_desc, 0, 25000);
-		if (setOptRetCode != 0)
-		{
-			CONSOLE_DEBUG("SetSocketTimeouts() failed");
-		}
 
-		remoteDev.sin_addr.s_addr	=	deviceAddress->sin_addr.s_addr;
-		remoteDev.sin_family		=	AF_INET;
-		remoteDev.sin_port			=	htons(port);
-		//*	Connect to remote device
-		connRetCode	=	connect(socket_desc , (struct sockaddr *)&remoteDev , sizeof(remoteDev));
-		if (connRetCode >= 0)
-		{
-//			CONSOLE_DEBUG_W_STR("connect open", ipString);
-
-			//	PUT /api/v1/dome/0/openshutter HTTP/1.1
-			//	Host: test:6800
-			//	User-Agent: curl/7.47.0
-			//	accept: application/json
-			//	Content-Type: application/x-www-form-urlencoded
-			//	Content-Length: 32
-
-			//	ClientID=2&ClientTransactionID=4
-
-
-			//PUT /api/v1/camera/0/connected HTTP/1.1
-			//Host: newt16:6800
-			//User-Agent: curl/7.58.0
-			//accept: application/json
-			//Content-Length: 14
-			//Content-Type: application/x-www-form-urlencoded
-			//
-			//Connected=true
-
-			//PUT /api/v1/camera/0/connected HTTP/1.0
-			//Host: 127.0.0.1:6800
-			//User-Agent: AlpacaPi
-			//Accept: text/html,application/json
-			//Content-Length: 47
-			//
-			//Connected=true&ClientID=1&ClientTransactionID=1
-
-			//PUT /api/v1/camera/0/connected HTTP/1.0
-			//Host: 127.0.0.1:32323
-			//User-Agent: AlpacaPi
-			//Accept: text/html,application/json
-			//Content-Length: 47
-			//
-			//Connected=true&ClientID=1&ClientTransactionID=1
-
-			strcpy(xmitBuffer,	"PUT ");
-			strcat(xmitBuffer,	putCommand);
-			strcat(xmitBuffer,	" HTTP/1.0\r\n");
-//			strcat(xmitBuffer,	"Host: 192.168.1.156:32323\r\n");
-			sprintf(linebuf,	"Host: %s:%d\r\n", ipString, port);
-			strcat(xmitBuffer,	linebuf);
-//			strcat(xmitBuffer,	"User-Agent: AlpacaPi\r\n");
-			if (strlen(gUserAgentAlpacaPiStr))
-			{
-				//*	add User-Agent:
-				strcat(xmitBuffer,	gUserAgentAlpacaPiStr);
-			}
-			strcat(xmitBuffer,	"Connection: close\r\n");
-			strcat(xmitBuffer,	"Accept: text/html,application/json\r\n");
-			strcat(xmitBuffer,	"Content-Type: application/x-www-form-urlencoded\r\n");
-
-			if (dataString != NULL)
-			{
-				dataStrLen	=	strlen(dataString);
-				sprintf(linebuf, "Content-Length: %d\r\n", dataStrLen);
-				strcat(xmitBuffer, linebuf);
-				strcat(xmitBuffer, "\r\n");
+	//	PUT /api/v1/dome/0/openshutter HTTP/1.1
+	//	Host: test:6800
+	//	User-Agent: curl/7.47.0
+	//	accept: application/json
+	//	Content-Type: application/x-www-form-urlencoded
+	//	Content-Length: 32
+
+	//	ClientID=2&ClientTransactionID=4
+
+	//PUT /api/v1/camera/0/connected HTTP/1.0
+	//Host: 127.0.0.1:6800
+	//User-Agent: AlpacaPi
+	//Accept: text/html,application/json
+	//Content-Length: 47
+	//
+	//Connected=true&ClientID=1&ClientTransactionID=1
+
+	strcpy(xmitBuffer,	"PUT ");
+	strcat(xmitBuffer,	putCommand);
+	strcat(xmitBuffer,	" HTTP/1.0\r\n");
+	sprintf(linebuf,	"Host: %s:%d\r\n", ipString, port);
+	strcat(xmitBuffer,	linebuf);
+	if (strlen(gUserAgentAlpacaPiStr))
+	{
+		//*	add User-Agent:
+		strcat(xmitBuffer,	gUserAgentAlpacaPiStr);
+	}
+	strcat(xmitBuffer,	(gEnableKeepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n"));
+	strcat(xmitBuffer,	"Accept: text/html,application/json\r\n");
+	strcat(xmitBuffer,	"Content-Type: application/x-www-form-urlencoded\r\n");
 
-				strcat(xmitBuffer, dataString);
-				strcat(xmitBuffer, "\r\n");
-			}
-			else
-			{
-				//*	this EXTRA CR/LF is VERY important for Alpaca Remote Server
-				strcat(xmitBuffer, "\r\n");
-			}
-			strcat(xmitBuffer, "\r\n");
-//			CONSOLE_DEBUG_W_STR("Sending:", xmitBuffer);
+	if (dataString != NULL)
+	{
+		dataStrLen	=	strlen(dataString);
+		sprintf(linebuf, "Content-Length: %d\r\n", dataStrLen);
+		strcat(xmitBuffer, linebuf);
+		strcat(xmitBuffer, "\r\n");
 
-			sendRetCode	=	send(socket_desc , xmitBuffer , strlen(xmitBuffer) , MSG_NOSIGNAL);
-			if (sendRetCode >= 0)
-			{
-				recvByteCnt	=	recv(socket_desc, returnedData , kReadBuffLen , MSG_NOSIGNAL);
-				if (recvByteCnt >= 0)
-				{
-//					CONSOLE_DEBUG("Setting validData to true");
-					validData					=	true;
-					returnedData[recvByteCnt]	=	0;
-					SJP_Init(jsonParser);
-					SJP_ParseData(jsonParser, returnedData);
-//					CONSOLE_DEBUG_W_STR("returnedData=\r\n", returnedData);
-				}
-			}
-			shutDownRetCode	=	shutdown(socket_desc, SHUT_RDWR);
-			if (shutDownRetCode != 0)
-			{
-				CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
-				CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-			}
-			closeRetCode	=	close(socket_desc);
-			if (closeRetCode != 0)
-			{
-				CONSOLE_DEBUG("Close error");
-			}
-		}
-		else if (errno == ECONNREFUSED)
-		{
-			CONSOLE_DEBUG_W_STR("connect refused", ipString);
-		}
-		else
-		{
-			CONSOLE_DEBUG("connect error");
-			CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-		}
+		strcat(xmitBuffer, dataString);
+		strcat(xmitBuffer, "\r\n");
 	}
 	else
 	{
-		if (errno == EMFILE)
-		{
-			CONSOLE_DEBUG("Too many files open!!!!!!!!!!!!!!!!!!!!!!!!!");
-		}
-		else
-		{
-			CONSOLE_DEBUG_W_NUM("socket_desc\t=", socket_desc);
-			CONSOLE_DEBUG_W_NUM("errno\t\t=", errno);
-		}
+		//*	this EXTRA CR/LF is VERY important for Alpaca Remote Server
+		strcat(xmitBuffer, "\r\n");
+	}
+	strcat(xmitBuffer, "\r\n");
+//	CONSOLE_DEBUG_W_STR("Sending:", xmitBuffer);
+
+	recvByteCnt	=	SendRequestAndReadResponse(	deviceAddress,
+												port,
+												putCommand,
+												xmitBuffer,
+												returnedData,
+												kReadBuffLen,
+												false);
+	if (recvByteCnt >= 0)
+	{
+//		CONSOLE_DEBUG("Setting validData to true");
+		validData	=	true;
+		SJP_Reset(jsonParser);
+		SJP_ParseData(jsonParser, returnedData);
+//		CONSOLE_DEBUG_W_STR("returnedData=\r\n", returnedData);
 	}
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, (validData ? "Valid Data" : "Not Valid"));
 	return(validData);
 }
 
-
-
 //*****************************************************************************
 void	PrintIPaddressToString(const long ipAddress, char *ipString)
 {
@@ -29,6 +29,7 @@ bool	SendPutCommand(		struct sockaddr_in	*deviceAddress,
 							SJP_Parser_t		*jsonParser);
 
 void	Set_SendRequestLibDebug(bool enableFlag);
+void	Set_SendRequestLibKeepAlive(bool enableFlag);
 #define	READ_BINARY_IMAGE		true
 #define	READ_JSON_IMAGE			false
 int		OpenSocketAndSendRequest(	struct sockaddr_in	*deviceAddress,
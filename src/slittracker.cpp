@@ -264,39 +264,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		JsonResponse_Add_Int32(	mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ClientTransactionID",
-								reqData->ClientTransactionID,
-								INCLUDE_COMMA);
-
-		JsonResponse_Add_Int32(	mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ServerTransactionID",
-								gServerTransactionID,
-								INCLUDE_COMMA);
-
-		JsonResponse_Add_Int32(	mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorNumber",
-								alpacaErrCode,
-								INCLUDE_COMMA);
-
-
-		JsonResponse_Add_String(mySocket,
-								reqData->jsonTextBuffer,
-								kMaxJsonBuffLen,
-								"ErrorMessage",
-								alpacaErrMsg,
-								NO_COMMA);
-
-		JsonResponse_Add_Finish(mySocket,
-								reqData->httpRetCode,
-								reqData->jsonTextBuffer,
-								(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 #ifdef _DEBUG_CONFORM_
 	CONSOLE_DEBUG_W_STR("Output JSON\t=", reqData->jsonTextBuffer);
@@ -442,7 +410,7 @@ bool				trackingFound;
 char				trackingString[32];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-	trackingFound	=	GetKeyWordArgument(	reqData->contentData,
+	trackingFound	=	GetKeyWordArgument(	reqData,
 											"tracking",
 											trackingString,
 											(sizeof(trackingString) -1));
@@ -13,6 +13,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb 14,	2019	<MLS> Created socket_listen.c
 //*	Apr  9,	2019	<MLS> Added SocketListen_SetCallback()
@@ -26,6 +27,17 @@
 //*	Feb 10,	2021	<MLS> Reduced timeout to 2500 (micro-secs)
 //*	Dec  3,	2022	<MLS> Added ipAddressString to SendDataToSocket()
 //*	Jan  8,	2024	<MLS> Added _SHOW_HTTP_DATA_
+//*	Oct 18,	2026	<AGT> Switched SocketListen_Poll() to epoll with a worker thread pool
+//*	Oct 18,	2026	<AGT> Added SocketListen_SetWorkerCount()
+//*	Oct 18,	2026	<AGT> Connections are now queued and served by worker threads
+//*	Oct 18,	2026	<AGT> Added HTTP/1.1 keep-alive (persistent connection) support
+//*	Oct 18,	2026	<AGT> Requests are now framed by header end and Content-Length
+//*	Oct 18,	2026	<AGT> Added pipelined request handling
+//*	Oct 18,	2026	<AGT> Added SocketListen_ClientWantsKeepAlive()
+//*	Oct 18,	2026	<AGT> Added SocketListen_SetResponseFramed()
+//*	Oct 18,	2026	<AGT> Added SocketListen_GetRequestStartTime_us() for request latency
+//*	Oct 18,	2026	<AGT> epoll events carry a generation count, events for a re-used slot are ignored
+//*	Oct 18,	2026	<AGT> Requests too big for the connection buffer get a 413 and are closed
 //*****************************************************************************
 
 #define	_SHOW_HTTP_DATA_
@@ -36,15 +48,21 @@
 
 //*****************************************************************************
 #include	<stdlib.h>
+#include	<stdbool.h>
 #include	<string.h>
 #include	<strings.h>
 #include	<unistd.h>
 #include	<errno.h>
 #include	<stdio.h>
+#include	<time.h>
+#include	<stdint.h>
+#include	<pthread.h>
 #include	<sys/types.h>
 #include	<sys/socket.h>
+#include	<sys/epoll.h>
 #include	<netinet/in.h>
 #include	<arpa/inet.h>
+#include	<fcntl.h>
 
 
 #ifdef _BANDWIDTH_
@@ -58,13 +76,77 @@
 
 #define		kTimeOut_MicroSecs	2500
 
+//*****************************************************************************
+//*	the listen socket is watched with epoll, accepted connections are placed
+//*	in a bounded queue and serviced by a pool of worker threads.
+//*	This keeps a long running request (i.e. imagearray) from holding up
+//*	all of the other clients.
+#define		kMaxEpollEvents			16
+#define		kEpollTimeOut_millisecs	1000
+#define		kMaxPendingConnections	64
+#define		kDefaultWorkerThreadCnt	6
+#define		kMaxWorkerThreadCnt		32
+
+//*****************************************************************************
+//*	HTTP/1.1 persistent connections
+//*	After a response that was framed with a Content-Length, the connection
+//*	is handed back to epoll and waits for the next request.
+//*	Idle connections are closed after kKeepAliveTimeOut_Secs
+#define		kMaxClientConnections		64
+#define		kConnectionBuffLen			4096
+#define		kKeepAliveTimeOut_Secs		5
+#define		kRequestTimeOut_MicroSecs	250000
+
 SocketData_Callback			gSocketCallbackProcPtr		=	NULL;
 
+//*****************************************************************************
+typedef struct	//	TYPE_ClientConnection
+{
+	int		socketFD;			//*	-1 if this slot is not in use
+	bool	busy;				//*	true while owned by a worker thread
+	uint32_t	generation;		//*	changes every time the slot gets a new socket
+	time_t	lastActivity;
+	uint64_t	acceptTime_us;	//*	the first request is timed from the accept, 0 after that
+	char	ipAddrString[INET_ADDRSTRLEN + 2];
+	int		bufferedLen;		//*	bytes received but not yet processed
+	char	readBuffer[kConnectionBuffLen];
+} TYPE_ClientConnection;
+
 //*****************************************************************************
 //*	globals so we can make this code non-blocking
-static	int		gSocketFD;		//*	socket File Descriptor
+static	int						gSocketFD			=	-1;		//*	socket File Descriptor
+static	int						gEpollFD			=	-1;
+static	int						gWorkerThreadCnt	=	kDefaultWorkerThreadCnt;
+static	int						gWorkersRunning		=	0;
+static	pthread_t				gWorkerThreadIDs[kMaxWorkerThreadCnt];
+
+static	TYPE_ClientConnection	gClientConnections[kMaxClientConnections];
+static	pthread_mutex_t			gConnectionMutex	=	PTHREAD_MUTEX_INITIALIZER;
+static	time_t					gLastIdleCheckTime	=	0;
+
+//*	a connection can only be in the queue once, so the queue can never overflow
+static	TYPE_ClientConnection	*gPendingQueue[kMaxClientConnections];
+static	int						gPendingHead		=	0;
+static	int						gPendingCount		=	0;
+static	pthread_mutex_t			gPendingMutex		=	PTHREAD_MUTEX_INITIALIZER;
+static	pthread_cond_t			gPendingCondition	=	PTHREAD_COND_INITIALIZER;
 
-void SendDataToSocket(const int sock, const char *ipAddressString);
+//*	per request state, shared between the worker thread and the callback
+static	__thread	bool		gClientWantsKeepAlive	=	false;
+static	__thread	bool		gResponseFramed			=	false;
+static	__thread	uint64_t	gRequestStartTime_us	=	0;
+
+static bool	SendDataToSocket(TYPE_ClientConnection *connection);
+static uint64_t	GetMonotonicTime_us(void);
+
+//*****************************************************************************
+//*	The epoll event data is the connection slot (+1) and its generation.
+//*	An event that was returned for a connection that has since been closed
+//*	and its slot given to a new socket has the old generation and is ignored.
+//*	0 is the listen socket
+#define	EPOLL_DATA_FROM_SLOT(slotIdx, generation)	((((uint64_t)(slotIdx) + 1) << 32) | (generation))
+#define	EPOLL_DATA_SLOT(eventData)					((int)((eventData) >> 32) - 1)
+#define	EPOLL_DATA_GENERATION(eventData)			((uint32_t)((eventData) & 0x0ffffffff))
 
 
 //*****************************************************************************
@@ -74,16 +156,296 @@ static void error(char *msg)
 	exit(1);
 }
 
+//*****************************************************************************
+static void	CloseClientSocket(const int clientSocketFD)
+{
+int		closeRetCode;
+int		shutDownRetCode;
+
+	shutDownRetCode	=	shutdown(clientSocketFD, SHUT_RDWR);
+	if ((shutDownRetCode != 0) && (errno != ENOTCONN))
+	{
+		CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
+		CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+	}
+	closeRetCode	=	close(clientSocketFD);
+	if (closeRetCode != 0)
+	{
+		CONSOLE_DEBUG_W_NUM("Error closing socket\t=",	closeRetCode);
+		CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+	}
+}
+
+//*****************************************************************************
+//*	returns NULL if all of the connection slots are in use by worker threads
+//*	If the table is full, the connection that has been idle the longest is dropped
+//*****************************************************************************
+static TYPE_ClientConnection	*Connection_Allocate(const int clientSocketFD, const char *ipAddrString)
+{
+TYPE_ClientConnection	*connection;
+int						iii;
+
+	connection	=	NULL;
+	pthread_mutex_lock(&gConnectionMutex);
+	for (iii=0; iii<kMaxClientConnections; iii++)
+	{
+		if (gClientConnections[iii].socketFD < 0)
+		{
+			connection	=	&gClientConnections[iii];
+			break;
+		}
+		else if ((gClientConnections[iii].busy == false) &&
+				((connection == NULL) || (gClientConnections[iii].lastActivity < connection->lastActivity)))
+		{
+			connection	=	&gClientConnections[iii];
+		}
+	}
+	if (connection != NULL)
+	{
+		if (connection->socketFD >= 0)
+		{
+			epoll_ctl(gEpollFD, EPOLL_CTL_DEL, connection->socketFD, NULL);
+			CloseClientSocket(connection->socketFD);
+		}
+		connection->socketFD		=	clientSocketFD;
+		connection->busy			=	false;
+		connection->generation++;
+		connection->lastActivity	=	time(NULL);
+		connection->acceptTime_us	=	GetMonotonicTime_us();
+		connection->bufferedLen		=	0;
+		connection->readBuffer[0]	=	0;
+		strncpy(connection->ipAddrString, ipAddrString, INET_ADDRSTRLEN);
+		connection->ipAddrString[INET_ADDRSTRLEN]	=	0;
+	}
+	pthread_mutex_unlock(&gConnectionMutex);
+	return(connection);
+}
+
+//*****************************************************************************
+static void	Connection_Close(TYPE_ClientConnection *connection)
+{
+	pthread_mutex_lock(&gConnectionMutex);
+	epoll_ctl(gEpollFD, EPOLL_CTL_DEL, connection->socketFD, NULL);
+	CloseClientSocket(connection->socketFD);
+	connection->socketFD	=	-1;
+	connection->busy		=	false;
+	connection->generation++;
+	pthread_mutex_unlock(&gConnectionMutex);
+}
+
+//*****************************************************************************
+//*	Give the connection back to epoll to wait for the next request.
+//*	EPOLLONESHOT guarantees that only one worker owns a connection at a time.
+//*	The connection must not be touched after this call.
+//*****************************************************************************
+static bool	Connection_ArmForRead(TYPE_ClientConnection *connection, const int epollOperation)
+{
+struct	epoll_event	connEvent;
+int					epollRetCode;
+
+	memset(&connEvent, 0, sizeof(connEvent));
+	connEvent.events	=	EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+
+	pthread_mutex_lock(&gConnectionMutex);
+	connEvent.data.u64			=	EPOLL_DATA_FROM_SLOT((connection - gClientConnections), connection->generation);
+	connection->busy			=	false;
+	connection->lastActivity	=	time(NULL);
+	epollRetCode				=	epoll_ctl(gEpollFD, epollOperation, connection->socketFD, &connEvent);
+	pthread_mutex_unlock(&gConnectionMutex);
+	if (epollRetCode != 0)
+	{
+		CONSOLE_DEBUG_W_NUM("epoll_ctl() failed, errno\t=", errno);
+	}
+	return(epollRetCode == 0);
+}
+
+//*****************************************************************************
+//*	close connections that have not sent anything in kKeepAliveTimeOut_Secs
+//*	Only called from the listen thread.
+//*****************************************************************************
+static void	CloseIdleConnections(void)
+{
+time_t	currentTime;
+int		iii;
+
+	currentTime	=	time(NULL);
+	if (currentTime != gLastIdleCheckTime)
+	{
+		gLastIdleCheckTime	=	currentTime;
+		pthread_mutex_lock(&gConnectionMutex);
+		for (iii=0; iii<kMaxClientConnections; iii++)
+		{
+			if ((gClientConnections[iii].socketFD >= 0) &&
+				(gClientConnections[iii].busy == false) &&
+				((currentTime - gClientConnections[iii].lastActivity) >= kKeepAliveTimeOut_Secs))
+			{
+				epoll_ctl(gEpollFD, EPOLL_CTL_DEL, gClientConnections[iii].socketFD, NULL);
+				CloseClientSocket(gClientConnections[iii].socketFD);
+				gClientConnections[iii].socketFD	=	-1;
+				gClientConnections[iii].generation++;
+			}
+		}
+		pthread_mutex_unlock(&gConnectionMutex);
+	}
+}
+
+//*****************************************************************************
+static void	PendingQueue_Push(TYPE_ClientConnection *connection)
+{
+int		tailIdx;
+
+	pthread_mutex_lock(&gPendingMutex);
+	tailIdx					=	(gPendingHead + gPendingCount) % kMaxClientConnections;
+	gPendingQueue[tailIdx]	=	connection;
+	gPendingCount++;
+	pthread_cond_signal(&gPendingCondition);
+	pthread_mutex_unlock(&gPendingMutex);
+}
+
+//*****************************************************************************
+static TYPE_ClientConnection	*PendingQueue_Pop(void)
+{
+TYPE_ClientConnection	*connection;
+
+	pthread_mutex_lock(&gPendingMutex);
+	while (gPendingCount == 0)
+	{
+		pthread_cond_wait(&gPendingCondition, &gPendingMutex);
+	}
+	connection		=	gPendingQueue[gPendingHead];
+	gPendingHead	=	(gPendingHead + 1) % kMaxClientConnections;
+	gPendingCount--;
+	pthread_mutex_unlock(&gPendingMutex);
+	return(connection);
+}
+
+//*****************************************************************************
+//*	Each worker services one connection at a time.
+//*	Serialization of commands to the same device is handled by the driver
+//*****************************************************************************
+static void	*SocketWorkerThread(void *arg)
+{
+TYPE_ClientConnection	*connection;
+bool					keepConnection;
+
+	(void)arg;
+	while (1)
+	{
+		connection		=	PendingQueue_Pop();
+
+		keepConnection	=	SendDataToSocket(connection);
+		if (keepConnection)
+		{
+			keepConnection	=	Connection_ArmForRead(connection, EPOLL_CTL_MOD);
+		}
+		if (keepConnection == false)
+		{
+			Connection_Close(connection);
+		}
+	}
+	return(NULL);
+}
+
+//*****************************************************************************
+//*	must be called before SocketListen_Init()
+//*****************************************************************************
+void	SocketListen_SetWorkerCount(const int workerThreadCnt)
+{
+	if (workerThreadCnt < 1)
+	{
+		gWorkerThreadCnt	=	1;
+	}
+	else if (workerThreadCnt > kMaxWorkerThreadCnt)
+	{
+		gWorkerThreadCnt	=	kMaxWorkerThreadCnt;
+	}
+	else
+	{
+		gWorkerThreadCnt	=	workerThreadCnt;
+	}
+}
+
+//*****************************************************************************
+static uint64_t	GetMonotonicTime_us(void)
+{
+struct timespec	timeNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &timeNow);
+	return(((uint64_t)timeNow.tv_sec * 1000000) + (timeNow.tv_nsec / 1000));
+}
+
+//*****************************************************************************
+//*	called from the data callback (on the worker thread)
+//*	CLOCK_MONOTONIC micro-secs when the request started, that is the accept
+//*	for the first request on a connection, otherwise when the worker started reading it
+//*****************************************************************************
+uint64_t	SocketListen_GetRequestStartTime_us(void)
+{
+	return(gRequestStartTime_us);
+}
+
+//*****************************************************************************
+//*	called from the data callback (on the worker thread)
+//*	true if the request being processed asked for a persistent connection
+//*****************************************************************************
+bool	SocketListen_ClientWantsKeepAlive(void)
+{
+	return(gClientWantsKeepAlive);
+}
+
+//*****************************************************************************
+//*	called from the data callback (on the worker thread)
+//*	The connection can only be kept open if the client can tell where the
+//*	response ends, i.e. it had a Content-Length header and was sent in full
+//*****************************************************************************
+void	SocketListen_SetResponseFramed(const bool responseFramed)
+{
+	gResponseFramed	=	responseFramed;
+}
+
+//*****************************************************************************
+static void	StartWorkerThreads(void)
+{
+int		iii;
+int		threadErr;
+
+	for (iii=gWorkersRunning; iii<gWorkerThreadCnt; iii++)
+	{
+		threadErr	=	pthread_create(&gWorkerThreadIDs[iii], NULL, &SocketWorkerThread, NULL);
+		if (threadErr == 0)
+		{
+			pthread_detach(gWorkerThreadIDs[iii]);
+			gWorkersRunning++;
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_NUM("Failed to create worker thread, threadErr\t=", threadErr);
+		}
+	}
+	CONSOLE_DEBUG_W_NUM("gWorkersRunning\t=", gWorkersRunning);
+}
 
 //*****************************************************************************
 int SocketListen_Init(const int listenPortNum)
 {
 int					bindRetCode;
 int					listenRetCode;
+int					socketFlags;
+int					setOptRetCode;
+int					reuseFlag;
 struct	sockaddr_in serv_addr;
+struct	epoll_event	listenEvent;
+int					iii;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
+	for (iii=0; iii<kMaxClientConnections; iii++)
+	{
+		gClientConnections[iii].socketFD	=	-1;
+		gClientConnections[iii].busy		=	false;
+		gClientConnections[iii].generation	=	0;
+	}
+
 	gSocketFD	=	socket(AF_INET, SOCK_STREAM, 0);
 	if (gSocketFD < 0)
 	{
@@ -92,6 +454,15 @@ struct	sockaddr_in serv_addr;
 	}
 	CONSOLE_DEBUG_W_NUM("gSocketFD\t=", gSocketFD);
 	CONSOLE_DEBUG_W_NUM("listenPortNum\t=", listenPortNum);
+
+	//*	allow a quick restart without waiting for TIME_WAIT to clear
+	reuseFlag		=	1;
+	setOptRetCode	=	setsockopt(gSocketFD, SOL_SOCKET, SO_REUSEADDR, &reuseFlag, sizeof(reuseFlag));
+	if (setOptRetCode != 0)
+	{
+		CONSOLE_DEBUG_W_NUM("setsockopt(SO_REUSEADDR) returned", setOptRetCode);
+	}
+
 	memset((char *) &serv_addr, 0, sizeof(serv_addr));
 	serv_addr.sin_family		=	AF_INET;
 	serv_addr.sin_addr.s_addr	=	INADDR_ANY;
@@ -103,7 +474,26 @@ struct	sockaddr_in serv_addr;
 		CONSOLE_DEBUG(__FUNCTION__);
 		error("ERROR on binding");
 	}
-	listenRetCode	=	listen(gSocketFD, 5);
+	listenRetCode	=	listen(gSocketFD, kMaxPendingConnections);
+
+	//*	the listen socket is non-blocking so that we can drain all pending accepts
+	socketFlags	=	fcntl(gSocketFD, F_GETFL, 0);
+	fcntl(gSocketFD, F_SETFL, socketFlags | O_NONBLOCK);
+
+	gEpollFD	=	epoll_create1(0);
+	if (gEpollFD < 0)
+	{
+		error("ERROR on epoll_create1");
+	}
+	memset(&listenEvent, 0, sizeof(listenEvent));
+	listenEvent.events		=	EPOLLIN;
+	listenEvent.data.u64	=	0;		//*	client connections have their slot and generation
+	if (epoll_ctl(gEpollFD, EPOLL_CTL_ADD, gSocketFD, &listenEvent) != 0)
+	{
+		error("ERROR on epoll_ctl");
+	}
+
+	StartWorkerThreads();
 
 	return(listenRetCode);
 }
@@ -116,56 +506,142 @@ void	SocketListen_SetCallback(SocketData_Callback callBackPtr)
 	gSocketCallbackProcPtr	=	callBackPtr;
 }
 
-
-
+//*****************************************************************************
+static const char	gServiceUnavailable503[]	=
+{
+	"HTTP/1.1 503 Service Unavailable\r\n"
+	"Content-Length: 0\r\n"
+	"Retry-After: 1\r\n"
+	"Connection: close\r\n"
+	"\r\n"
+};
 
 //*****************************************************************************
-int SocketListen_Poll(void)
+//*	accept everything that is pending on the listen socket
+//*****************************************************************************
+static void	AcceptPendingConnections(void)
 {
-int					newsockfd;
-unsigned int		clilen;
-struct	sockaddr_in	client_addr;
-int					closeRetCode;
-int					shutDownRetCode;
-char				ipAddrString[64];
-
-	//*	Started getting EINVAL (Invalid argument) errors on accept
-	//*	fixed the problem by cleared args first
-	memset(&client_addr, 0, sizeof(struct	sockaddr_in));
-
-	clilen		=	sizeof(client_addr);
-	newsockfd	=	accept(gSocketFD, (struct sockaddr *) &client_addr, &clilen);
-
-	inet_ntop(AF_INET, &(client_addr.sin_addr), ipAddrString, INET_ADDRSTRLEN);
-#ifdef _SHOW_HTTP_DATA_
-	CONSOLE_DEBUG_W_STR("Accepted from ", ipAddrString);
-#endif // _SHOW_HTTP_DATA_
-	if (newsockfd >= 0)
+int						newsockfd;
+socklen_t				clilen;
+struct	sockaddr_in		client_addr;
+char					ipAddrString[64];
+bool					keepAccepting;
+ssize_t					bytesWritten;
+TYPE_ClientConnection	*connection;
+struct timeval			timeoutLength;
+
+	keepAccepting	=	true;
+	while (keepAccepting)
 	{
-		SendDataToSocket(newsockfd, ipAddrString);
+		//*	Started getting EINVAL (Invalid argument) errors on accept
+		//*	fixed the problem by cleared args first
+		memset(&client_addr, 0, sizeof(struct	sockaddr_in));
 
-		shutDownRetCode	=	shutdown(newsockfd, SHUT_RDWR);
-		if (shutDownRetCode != 0)
+		clilen		=	sizeof(client_addr);
+		newsockfd	=	accept(gSocketFD, (struct sockaddr *) &client_addr, &clilen);
+		if (newsockfd >= 0)
 		{
-			CONSOLE_DEBUG_W_NUM("shutDownRetCode\t=", shutDownRetCode);
-			CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+			inet_ntop(AF_INET, &(client_addr.sin_addr), ipAddrString, INET_ADDRSTRLEN);
+		#ifdef _SHOW_HTTP_DATA_
+			CONSOLE_DEBUG_W_STR("Accepted from ", ipAddrString);
+		#endif // _SHOW_HTTP_DATA_
+			//*	the timeout only applies while waiting for the rest of a request,
+			//*	epoll tells us when a new request has started to arrive
+			timeoutLength.tv_sec	=	0;
+			timeoutLength.tv_usec	=	kRequestTimeOut_MicroSecs;
+			setsockopt(newsockfd, SOL_SOCKET, SO_RCVTIMEO, &timeoutLength, sizeof(timeoutLength));
+
+			connection	=	Connection_Allocate(newsockfd, ipAddrString);
+			if (connection != NULL)
+			{
+				if (Connection_ArmForRead(connection, EPOLL_CTL_ADD) == false)
+				{
+					Connection_Close(connection);
+				}
+			}
+			else
+			{
+				//*	all of the connection slots are busy, tell the client to try again
+				CONSOLE_DEBUG_W_STR("Connection table full, rejecting", ipAddrString);
+				bytesWritten	=	write(newsockfd, gServiceUnavailable503, strlen(gServiceUnavailable503));
+				if (bytesWritten < 0)
+				{
+					CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+				}
+				CloseClientSocket(newsockfd);
+			}
+		}
+		else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+		{
+			keepAccepting	=	false;
 		}
-		closeRetCode	=	close(newsockfd);
-		if (closeRetCode != 0)
+		else if ((errno == EINTR) || (errno == ECONNABORTED))
 		{
-			CONSOLE_DEBUG_W_NUM("Error closing socket\t=",	closeRetCode);
+			//*	try again
+		}
+		else
+		{
+			CONSOLE_DEBUG(__FUNCTION__);
+			CONSOLE_DEBUG_W_NUM("gSocketFD\t=", gSocketFD);
+			CONSOLE_DEBUG_W_NUM("newsockfd\t=", newsockfd);
 			CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+			//*	running out of file descriptors is not fatal, the workers will free some up
+			if ((errno != EMFILE) && (errno != ENFILE))
+			{
+				error("ERROR on accept");
+			}
+			keepAccepting	=	false;
 		}
 	}
-	else if (newsockfd < 0)
+}
+
+//*****************************************************************************
+int SocketListen_Poll(void)
+{
+struct	epoll_event		events[kMaxEpollEvents];
+int						eventCnt;
+int						iii;
+int						slotIdx;
+bool					isCurrent;
+TYPE_ClientConnection	*connection;
+
+	eventCnt	=	epoll_wait(gEpollFD, events, kMaxEpollEvents, kEpollTimeOut_millisecs);
+	if (eventCnt < 0)
 	{
-		CONSOLE_DEBUG(__FUNCTION__);
-		CONSOLE_DEBUG_W_NUM("gSocketFD\t=", gSocketFD);
-		CONSOLE_DEBUG_W_NUM("newsockfd\t=", newsockfd);
-		CONSOLE_DEBUG_W_NUM("errno\t=", errno);
-		error("ERROR on accept");
+		if (errno != EINTR)
+		{
+			CONSOLE_DEBUG_W_NUM("epoll_wait() errno\t=", errno);
+		}
 	}
-
+	for (iii=0; iii<eventCnt; iii++)
+	{
+		slotIdx	=	EPOLL_DATA_SLOT(events[iii].data.u64);
+		if (slotIdx < 0)
+		{
+			AcceptPendingConnections();
+		}
+		else if (slotIdx < kMaxClientConnections)
+		{
+			//*	data (or a hang up) on a client connection, hand it to a worker.
+			//*	AcceptPendingConnections() may have given the slot to a new socket
+			//*	after this event was returned, the event is then for the old socket
+			connection	=	&gClientConnections[slotIdx];
+			isCurrent	=	false;
+			pthread_mutex_lock(&gConnectionMutex);
+			if ((connection->socketFD >= 0) && (connection->busy == false) &&
+				(connection->generation == EPOLL_DATA_GENERATION(events[iii].data.u64)))
+			{
+				connection->busy	=	true;
+				isCurrent			=	true;
+			}
+			pthread_mutex_unlock(&gConnectionMutex);
+			if (isCurrent)
+			{
+				PendingQueue_Push(connection);
+			}
+		}
+	}
+	CloseIdleConnections();
 	return 0;
 }
 
@@ -279,79 +755,273 @@ int				setOptRetCode;
 	} while (bytesRead > 0);
 
 
-	gMessageCnt++;
+	__sync_fetch_and_add(&gMessageCnt, 1);
 //	CONSOLE_DEBUG("EXIT");
 }
 
 #else
-
 //*****************************************************************************
-//*	SendDataToSocket()
-//*		There is a separate instance of this function
-//*		for each connection.  It handles all communication
-//*		once a connection has been established.
+//*	returns a pointer to the value of the header field or NULL if not present
+//*	the search stops at the end of the header (headerLen)
 //*****************************************************************************
-void SendDataToSocket(const int sock, const char *ipAddressString)
+static const char	*FindHeaderField(const char *httpHeader, const int headerLen, const char *fieldName)
 {
-int				bytesRead;
-//int			bytesWritten;
-//int			resultsMsgLen;
-char			readBuffer[kReadBuffLen];
-char			htmlBuffer[kReadBuffLen];
-struct timeval	timeoutLength;
-int				setOptRetCode;
+const char	*linePtr;
+const char	*headerEnd;
+const char	*valuePtr;
+int			fieldNameLen;
 
-//	CONSOLE_DEBUG(__FUNCTION__);
-
-	memset(readBuffer, 0, kReadBuffLen);
-	//*	3/31/2020, trying to see if we are missing anything
-	memset(htmlBuffer, 0, kReadBuffLen);
-	//*	set a timeout
-	timeoutLength.tv_sec	=	0;
-	timeoutLength.tv_usec	=	kTimeOut_MicroSecs;
-	setOptRetCode			=	setsockopt(	sock,
-											SOL_SOCKET,
-											SO_RCVTIMEO,
-											&timeoutLength,
-											sizeof(timeoutLength));
-	if (setOptRetCode != 0)
+	valuePtr		=	NULL;
+	fieldNameLen	=	strlen(fieldName);
+	headerEnd		=	httpHeader + headerLen;
+	linePtr			=	strchr(httpHeader, '\n');
+	while ((linePtr != NULL) && (linePtr < headerEnd) && (valuePtr == NULL))
 	{
-		CONSOLE_DEBUG_W_NUM("setsockopt() returned", setOptRetCode);
+		linePtr++;
+		if (strncasecmp(linePtr, fieldName, fieldNameLen) == 0)
+		{
+			valuePtr	=	linePtr + fieldNameLen;
+			while ((*valuePtr == ' ') || (*valuePtr == '\t'))
+			{
+				valuePtr++;
+			}
+		}
+		linePtr	=	strchr(linePtr, '\n');
 	}
+	return(valuePtr);
+}
 
-	do
+//*****************************************************************************
+static bool	IsStartOfRequest(const char *buffer)
+{
+	return(	(strncmp(buffer, "GET ",		4) == 0) ||
+			(strncmp(buffer, "PUT ",		4) == 0) ||
+			(strncmp(buffer, "POST ",		5) == 0) ||
+			(strncmp(buffer, "HEAD ",		5) == 0) ||
+			(strncmp(buffer, "DELETE ",		7) == 0) ||
+			(strncmp(buffer, "OPTIONS ",	8) == 0));
+}
+
+//*****************************************************************************
+//*	HTTP/1.1 defaults to keep-alive, HTTP/1.0 has to ask for it
+//*****************************************************************************
+static bool	RequestWantsKeepAlive(const char *httpHeader, const int headerLen)
+{
+const char	*lineEnd;
+const char	*versionPtr;
+const char	*connectionValue;
+bool		keepAlive;
+
+	keepAlive	=	false;
+	lineEnd		=	strchr(httpHeader, '\n');
+	versionPtr	=	strstr(httpHeader, "HTTP/1.1");
+	if ((lineEnd != NULL) && (versionPtr != NULL) && (versionPtr < lineEnd))
 	{
-		bytesRead	=	read(sock, readBuffer, (kReadBuffLen - 2));
-//		CONSOLE_DEBUG_W_NUM("bytesRead=", bytesRead);
-		if (bytesRead > 0)
+		keepAlive	=	true;
+	}
+	connectionValue	=	FindHeaderField(httpHeader, headerLen, "Connection:");
+	if (connectionValue != NULL)
+	{
+		if (strncasecmp(connectionValue, "close", 5) == 0)
 		{
-			readBuffer[bytesRead]	=	0;
-			strcat(htmlBuffer, readBuffer);
+			keepAlive	=	false;
 		}
-		else if (bytesRead < 0)
+		else if (strncasecmp(connectionValue, "keep-alive", 10) == 0)
 		{
-		//	error("ERROR reading from socket");
+			keepAlive	=	true;
 		}
-	} while (bytesRead > 0);
+	}
+	return(keepAlive);
+}
 
-#ifdef _FIX_ESCAPE_CHARS_
-//	CONSOLE_DEBUG_W_NUM("bytesRead=", bytesRead);
-	bytesRead	=	FixEscapedChars(htmlBuffer);
-#endif
-	if (gSocketCallbackProcPtr != NULL)
+//*****************************************************************************
+//*	Reads until there is one complete request at the start of the connection buffer.
+//*	Returns the length of the request, 0 if the client closed the connection.
+//*	requestIsFramed is set to false if the end of the request could not be
+//*	determined, in which case everything that was received is returned
+//*	and the connection cannot be re-used.
+//*	Returns kRequestTooLarge if the request does not fit in the connection buffer.
+//*****************************************************************************
+#define	kRequestNotComplete	(-1)
+#define	kRequestTooLarge	(-2)
+
+static int	ReadCompleteRequest(TYPE_ClientConnection *connection, bool *requestIsFramed)
+{
+char		*headerEnd;
+const char	*contentLenPtr;
+const char	*nextRequest;
+int			headerLen;
+int			requestLen;
+long		contentLen;
+int			bytesRead;
+
+	*requestIsFramed	=	false;
+	requestLen			=	kRequestNotComplete;
+	while (requestLen == kRequestNotComplete)
 	{
-//		CONSOLE_DEBUG("Calling gSocketCallbackProcPtr");
-		gSocketCallbackProcPtr(sock, htmlBuffer, bytesRead, ipAddressString);
+		connection->readBuffer[connection->bufferedLen]	=	0;
+		headerEnd	=	strstr(connection->readBuffer, "\r\n\r\n");
+		if (headerEnd != NULL)
+		{
+			headerLen		=	(headerEnd - connection->readBuffer) + 4;
+			contentLenPtr	=	FindHeaderField(connection->readBuffer, headerLen, "Content-Length:");
+			if (contentLenPtr != NULL)
+			{
+				contentLen	=	atol(contentLenPtr);
+				if ((contentLen < 0) || (contentLen >= (kConnectionBuffLen - headerLen)))
+				{
+					//*	too big to buffer, it is not processed with the body cut off
+					requestLen	=	kRequestTooLarge;
+				}
+				else if ((headerLen + contentLen) <= connection->bufferedLen)
+				{
+					requestLen			=	headerLen + contentLen;
+					*requestIsFramed	=	true;
+				}
+				else
+				{
+					requestLen	=	kRequestNotComplete;		//*	wait for the rest of the body
+				}
+			}
+			else
+			{
+				//*	no Content-Length, older clients sometimes send data after the header anyway,
+				//*	if what follows is not another request, treat it as part of this one
+				nextRequest	=	connection->readBuffer + headerLen;
+				while ((*nextRequest == '\r') || (*nextRequest == '\n'))
+				{
+					nextRequest++;
+				}
+				if ((*nextRequest == 0) || IsStartOfRequest(nextRequest))
+				{
+					requestLen			=	headerLen;
+					*requestIsFramed	=	true;
+				}
+				else
+				{
+					requestLen	=	connection->bufferedLen;
+				}
+			}
+		}
+		else if (connection->bufferedLen >= (kConnectionBuffLen - 1))
+		{
+			//*	the header does not even fit
+			requestLen	=	kRequestTooLarge;
+		}
+
+		if (requestLen == kRequestNotComplete)
+		{
+			bytesRead	=	read(	connection->socketFD,
+									(connection->readBuffer + connection->bufferedLen),
+									(kConnectionBuffLen - 1 - connection->bufferedLen));
+			if (bytesRead > 0)
+			{
+				connection->bufferedLen	+=	bytesRead;
+			}
+			else
+			{
+				//*	closed, error or timed out, process whatever we have
+				requestLen	=	connection->bufferedLen;
+			}
+		}
 	}
+	return(requestLen);
+}
+
+//*****************************************************************************
+static const char	gRequestTooLarge413[]	=
+{
+	"HTTP/1.1 413 Request Entity Too Large\r\n"
+	"Content-Length: 0\r\n"
+	"Connection: close\r\n"
+	"\r\n"
+};
+
+//*****************************************************************************
+//*	SendDataToSocket()
+//*		Handles all of the requests that are currently available on a connection.
+//*		Returns true if the connection should be kept open for more requests
+//*****************************************************************************
+static bool	SendDataToSocket(TYPE_ClientConnection *connection)
+{
+int		bytesRead;
+int		requestLen;
+int		headerLen;
+ssize_t	bytesWritten;
+char	*headerEnd;
+char	*nextRequest;
+bool	requestIsFramed;
+bool	keepConnection;
+char	htmlBuffer[kConnectionBuffLen];
+
+//	CONSOLE_DEBUG(__FUNCTION__);
+	keepConnection	=	false;
+	do
+	{
+		if (connection->acceptTime_us != 0)
+		{
+			gRequestStartTime_us		=	connection->acceptTime_us;
+			connection->acceptTime_us	=	0;
+		}
+		else
+		{
+			gRequestStartTime_us	=	GetMonotonicTime_us();
+		}
+		requestLen	=	ReadCompleteRequest(connection, &requestIsFramed);
+		if (requestLen > 0)
+		{
+			memcpy(htmlBuffer, connection->readBuffer, requestLen);
+			htmlBuffer[requestLen]	=	0;
+			bytesRead				=	requestLen;
 
-//	printf("Here is the message (%d bytes long):\r\n%s\r\n", bytesRead, readBuffer);
-#if 0
-	resultsMsgLen	=	strlen(returnBuffer);
-	bytesWritten	=	write(sock, returnBuffer, resultsMsgLen);
-#endif
+			//*	remove this request from the connection buffer, pipelined requests stay
+			nextRequest	=	connection->readBuffer + requestLen;
+			while ((nextRequest < (connection->readBuffer + connection->bufferedLen)) &&
+					((*nextRequest == '\r') || (*nextRequest == '\n')))
+			{
+				nextRequest++;
+			}
+			connection->bufferedLen	-=	(nextRequest - connection->readBuffer);
+			memmove(connection->readBuffer, nextRequest, connection->bufferedLen);
+			connection->readBuffer[connection->bufferedLen]	=	0;
 
+			gClientWantsKeepAlive	=	false;
+			gResponseFramed			=	false;
+			if (requestIsFramed)
+			{
+				headerEnd	=	strstr(htmlBuffer, "\r\n\r\n");
+				headerLen	=	(headerEnd != NULL) ? (headerEnd - htmlBuffer) : requestLen;
+				gClientWantsKeepAlive	=	RequestWantsKeepAlive(htmlBuffer, headerLen);
+			}
+		#ifdef _FIX_ESCAPE_CHARS_
+			bytesRead	=	FixEscapedChars(htmlBuffer);
+		#endif
+			if (gSocketCallbackProcPtr != NULL)
+			{
+		//		CONSOLE_DEBUG("Calling gSocketCallbackProcPtr");
+				gSocketCallbackProcPtr(connection->socketFD, htmlBuffer, bytesRead, connection->ipAddrString);
+			}
+			//*	the callback tells us if the response had a Content-Length
+			keepConnection	=	(gClientWantsKeepAlive && gResponseFramed);
+			__sync_fetch_and_add(&gMessageCnt, 1);
+		}
+		else if (requestLen == kRequestTooLarge)
+		{
+			CONSOLE_DEBUG_W_STR("Request too large from", connection->ipAddrString);
+			bytesWritten	=	write(connection->socketFD, gRequestTooLarge413, strlen(gRequestTooLarge413));
+			if (bytesWritten < 0)
+			{
+				CONSOLE_DEBUG_W_NUM("errno\t=", errno);
+			}
+			keepConnection	=	false;
+		}
+		else
+		{
+			keepConnection	=	false;
+		}
+	} while (keepConnection && (connection->bufferedLen > 0));
 
-	gMessageCnt++;
 //	CONSOLE_DEBUG("EXIT");
+	return(keepConnection);
 }
 #endif // _BANDWIDTH_
@@ -7,8 +7,12 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb 14,	2019	<MLS> Created socket_listen.h
+//*	Oct 18,	2026	<AGT> Added SocketListen_SetWorkerCount()
+//*	Oct 18,	2026	<AGT> Added SocketListen_ClientWantsKeepAlive() & SocketListen_SetResponseFramed()
+//*	Oct 18,	2026	<AGT> Added SocketListen_GetRequestStartTime_us()
 //*****************************************************************************
 
 
@@ -16,6 +20,14 @@
 #define	_SOCKET_LISTEN_H_
 
 
+#ifndef _STDBOOL_H
+	#include	<stdbool.h>
+#endif
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
 #ifdef __cplusplus
 	extern "C" {
 #endif
@@ -24,6 +36,14 @@ typedef	int (*SocketData_Callback)(int socket, char *htmlData, long bytesRead, c
 int		SocketListen_Init(const int listenPortNum);
 int		SocketListen_Poll(void);
 void	SocketListen_SetCallback(SocketData_Callback callBackPtr);
+void	SocketListen_SetWorkerCount(const int workerThreadCnt);
+
+//*	for use by the callback, HTTP/1.1 keep-alive support
+bool	SocketListen_ClientWantsKeepAlive(void);
+void	SocketListen_SetResponseFramed(const bool responseFramed);
+
+//*	for the request latency statistics
+uint64_t	SocketListen_GetRequestStartTime_us(void);
 
 #ifdef __cplusplus
 }
@@ -271,38 +271,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(mySocket,
-															reqData->jsonTextBuffer,
-															kMaxJsonBuffLen,
-															"ClientTransactionID",
-															reqData->ClientTransactionID,
-															INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Uint32(mySocket,
-															reqData->jsonTextBuffer,
-															kMaxJsonBuffLen,
-															"ServerTransactionID",
-															gServerTransactionID,
-															INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Int32(	mySocket,
-															reqData->jsonTextBuffer,
-															kMaxJsonBuffLen,
-															"ErrorNumber",
-															alpacaErrCode,
-															INCLUDE_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_String(mySocket,
-															reqData->jsonTextBuffer,
-															kMaxJsonBuffLen,
-															"ErrorMessage",
-															alpacaErrMsg,
-															NO_COMMA);
-
-		cBytesWrittenForThisCmd	+=	JsonResponse_Add_Finish(	mySocket,
-																reqData->httpRetCode,
-																reqData->jsonTextBuffer,
-																(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 	}
 	//*	this is for the logging function
 	strcpy(reqData->alpacaErrMsg, alpacaErrMsg);
@@ -320,13 +289,13 @@ char				idString[32];
 int					switchNum;
 
 	switchNum	=	-1;
-	foundId		=	GetKeyWordArgument(	reqData->contentData,
+	foundId		=	GetKeyWordArgument(	reqData,
 										"Id",
 										idString,
 										sizeof(idString)-1);
 	if (foundId == false)
 	{
-		foundId		=	GetKeyWordArgument(	reqData->contentData,
+		foundId		=	GetKeyWordArgument(	reqData,
 											"iD",
 											idString,
 											sizeof(idString)-1);
@@ -636,7 +605,7 @@ bool				newSwitchState;
 #endif
 
 	alpacaErrCode	=	GetSwitchID(reqData, &switchNum, alpacaErrMsg);
-	foundState		=	GetKeyWordArgument(	reqData->contentData,
+	foundState		=	GetKeyWordArgument(	reqData,
 											"State",
 											stateString,
 											sizeof(stateString)-1);
@@ -707,7 +676,7 @@ int					switchNum;
 #endif
 
 	alpacaErrCode	=	GetSwitchID(reqData, &switchNum, alpacaErrMsg);
-	foundName		=	GetKeyWordArgument(	reqData->contentData,
+	foundName		=	GetKeyWordArgument(	reqData,
 											"Name",
 											nameString,
 											(kMaxSwitchNameLen - 1));
@@ -752,7 +721,7 @@ double				newSwitchValue;
 #endif
 
 	alpacaErrCode	=	GetSwitchID(reqData, &switchNum, alpacaErrMsg);
-	foundValue		=	GetKeyWordArgument(	reqData->contentData,
+	foundValue		=	GetKeyWordArgument(	reqData,
 											"Value",
 											valueString,
 											(sizeof(valueString) - 1));
@@ -889,38 +889,7 @@ int					mySocket;
 	if (cSendJSONresponse)	//*	False for setupdialog and camera binary data
 	{
 		//*	send the response information
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ClientTransactionID",
-									reqData->ClientTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Uint32(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ServerTransactionID",
-									gServerTransactionID,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_Int32(		mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ErrorNumber",
-									alpacaErrCode,
-									INCLUDE_COMMA);
-
-		JsonResponse_Add_String(	mySocket,
-									reqData->jsonTextBuffer,
-									kMaxJsonBuffLen,
-									"ErrorMessage",
-									alpacaErrMsg,
-									NO_COMMA);
-
-		JsonResponse_Add_Finish(	mySocket,
-									reqData->httpRetCode,
-									reqData->jsonTextBuffer,
-									(cHttpHeaderSent == false));
+		ProcessCommand_SendResponse(reqData, alpacaErrCode, alpacaErrMsg);
 
 	}
 	//*	this is for the logging function
@@ -1422,7 +1391,7 @@ double					newDecRate;
 
 	if (cTelescopeProp.CanSetDeclinationRate)
 	{
-		decRateFound		=	GetKeyWordArgument(	reqData->contentData,
+		decRateFound		=	GetKeyWordArgument(	reqData,
 													"DeclinationRate",
 													decRateString,
 													sizeof(decRateString),
@@ -1498,7 +1467,7 @@ char					doseRefractionString[64];
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	doseRefractionFound		=	GetKeyWordArgument(	reqData->contentData,
+	doseRefractionFound		=	GetKeyWordArgument(	reqData,
 													"DoesRefraction",
 													doseRefractionString,
 													sizeof(doseRefractionString));
@@ -1637,7 +1606,7 @@ bool				newGuidRateValid;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	guideRateDeclinationFound	=	GetKeyWordArgument(	reqData->contentData,
+	guideRateDeclinationFound	=	GetKeyWordArgument(	reqData,
 														"GuideRateDeclination",
 														guideRateDeclinationStr,
 														sizeof(guideRateDeclinationStr),
@@ -1713,7 +1682,7 @@ double				newGuideRateRightAscension;
 bool				guideRateIsValid;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	guideRateRightAscensionFound	=	GetKeyWordArgument(	reqData->contentData,
+	guideRateRightAscensionFound	=	GetKeyWordArgument(	reqData,
 															"GuideRateRightAscension",
 															guideRateRightAscensionStr,
 															sizeof(guideRateRightAscensionStr),
@@ -1856,7 +1825,7 @@ double				newrightAscenRate;
 bool				rightAscRateValid;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	rightAscenRateFound		=	GetKeyWordArgument(	reqData->contentData,
+	rightAscenRateFound		=	GetKeyWordArgument(	reqData,
 													"RightAscensionRate",
 													rightAscenRateString,
 													sizeof(rightAscenRateString),
@@ -1965,7 +1934,7 @@ char				sideOfPierString[64];
 //int					newSideOfPier;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	sideOfPierFound		=	GetKeyWordArgument(	reqData->contentData,
+	sideOfPierFound		=	GetKeyWordArgument(	reqData,
 												"SideOfPier",
 												sideOfPierString,
 												sizeof(sideOfPierString),
@@ -2048,7 +2017,7 @@ double				newElevation;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
-	siteElevFound		=	GetKeyWordArgument(	reqData->contentData,
+	siteElevFound		=	GetKeyWordArgument(	reqData,
 												"SiteElevation",
 												siteElevString,
 												sizeof(siteElevString),
@@ -2124,7 +2093,7 @@ double				newLatitude;
 	//	-H "Content-Type: application/x-www-form-urlencoded"
 	//	-d "SiteLatitude=51.3&ClientID=1&ClientTransactionID=3"
 
-	siteLatFound		=	GetKeyWordArgument(	reqData->contentData,
+	siteLatFound		=	GetKeyWordArgument(	reqData,
 												"SiteLatitude",
 												siteLatString,
 												sizeof(siteLatString),
@@ -2194,7 +2163,7 @@ double				newLongitude;
 
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	siteLonFound		=	GetKeyWordArgument(	reqData->contentData,
+	siteLonFound		=	GetKeyWordArgument(	reqData,
 												"SiteLongitude",
 												siteLonString,
 												sizeof(siteLonString),
@@ -2297,7 +2266,7 @@ int					newSlewSettleTime;
 bool				slewSettleTimeValid;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	slewSettleTimeFound		=	GetKeyWordArgument(	reqData->contentData,
+	slewSettleTimeFound		=	GetKeyWordArgument(	reqData,
 													"SlewSettleTime",
 													slewSettleTimeString,
 													sizeof(slewSettleTimeString));
@@ -2394,7 +2363,7 @@ double				newTargetDeclination;
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG(reqData->contentData);
 
-	targetDeclinationFound	=	GetKeyWordArgument(	reqData->contentData,
+	targetDeclinationFound	=	GetKeyWordArgument(	reqData,
 													"TargetDeclination",
 													targetDeclinationString,
 													sizeof(targetDeclinationString),
@@ -2481,7 +2450,7 @@ double				newTargetRightAscension;
 	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG(reqData->contentData);
 
-	targetRightAscensionFound	=	GetKeyWordArgument(	reqData->contentData,
+	targetRightAscensionFound	=	GetKeyWordArgument(	reqData,
 														"TargetRightAscension",
 														targetRightAscensionString,
 														sizeof(targetRightAscensionString),
@@ -2554,7 +2523,7 @@ char					trackingString[64];
 
 	if (cTelescopeProp.CanSetTracking)
 	{
-		trackingFound		=	GetKeyWordArgument(	reqData->contentData,
+		trackingFound		=	GetKeyWordArgument(	reqData,
 													"Tracking",
 													trackingString,
 													sizeof(trackingString));
@@ -2658,7 +2627,7 @@ TYPE_DriveRates			newtrackingRate;
 	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG(reqData->contentData);
 
-	trackingRateFound		=	GetKeyWordArgument(	reqData->contentData,
+	trackingRateFound		=	GetKeyWordArgument(	reqData,
 													"TrackingRate",
 													trackingRateString,
 													sizeof(trackingRateString));
@@ -2779,7 +2748,7 @@ char					utcDateString[64];
 //	CONSOLE_DEBUG(reqData->contentData);
 
 
-	utcDateFound	=	GetKeyWordArgument(	reqData->contentData,
+	utcDateFound	=	GetKeyWordArgument(	reqData,
 											"UTCDate",
 											utcDateString,
 											sizeof(utcDateString));
@@ -2862,7 +2831,7 @@ int						axisNumber;
 	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG(reqData->contentData);
 
-	axisFound		=	GetKeyWordArgument(	reqData->contentData,
+	axisFound		=	GetKeyWordArgument(	reqData,
 											"Axis",
 											axisString,
 											sizeof(axisString),
@@ -2949,7 +2918,7 @@ int						axisNumber;
 	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG(reqData->contentData);
 
-	axisFound		=	GetKeyWordArgument(	reqData->contentData,
+	axisFound		=	GetKeyWordArgument(	reqData,
 											"Axis",
 											axisString,
 											sizeof(axisString),
@@ -3010,14 +2979,14 @@ double				newRightAscension;
 double				newDeclination;
 TYPE_ASCOM_STATUS	alpacaErrCode	=	kASCOM_Err_InvalidValue;
 
-	rightAscensionFound		=	GetKeyWordArgument(	reqData->contentData,
+	rightAscensionFound		=	GetKeyWordArgument(	reqData,
 													"RightAscension",
 													rightAscensionStr,
 													sizeof(rightAscensionStr),
 													ingoreCase,
 													kArgumentIsNumeric);
 
-	declinationFound		=	GetKeyWordArgument(	reqData->contentData,
+	declinationFound		=	GetKeyWordArgument(	reqData,
 													"Declination",
 													declinationStr,
 													sizeof(rightAscensionStr),
@@ -3080,14 +3049,14 @@ double				newAlt_degrees;
 double				newAz_degrees;
 
 	CONSOLE_DEBUG(__FUNCTION__);
-	altitudeFound	=	GetKeyWordArgument(	reqData->contentData,
+	altitudeFound	=	GetKeyWordArgument(	reqData,
 											"Altitude",
 											altitudeString,
 											sizeof(altitudeString),
 											kRequireCase,
 											kArgumentIsNumeric);
 
-	azimuthFound	=	GetKeyWordArgument(	reqData->contentData,
+	azimuthFound	=	GetKeyWordArgument(	reqData,
 											"Azimuth",
 											azimuthString,
 											sizeof(azimuthString),
@@ -3216,13 +3185,13 @@ bool					previousTrackingState;
 	}
 	else if (cTelescopeProp.CanMoveAxis)
 	{
-		axisFound		=	GetKeyWordArgument(	reqData->contentData,
+		axisFound		=	GetKeyWordArgument(	reqData,
 												"Axis",
 												axisString,
 												sizeof(axisString),
 												kRequireCase);
 
-		rateFound		=	GetKeyWordArgument(	reqData->contentData,
+		rateFound		=	GetKeyWordArgument(	reqData,
 												"Rate",
 												rateString,
 												sizeof(rateString),
@@ -3341,12 +3310,12 @@ bool					dataIsValid;
 //	CONSOLE_DEBUG_W_BOOL("cTelescopeProp.CanPulseGuide\t=", cTelescopeProp.CanPulseGuide);
 //	CONSOLE_DEBUG(reqData->contentData);
 
-	directionFound	=	GetKeyWordArgument(	reqData->contentData,
+	directionFound	=	GetKeyWordArgument(	reqData,
 													"Direction",
 													directionString,
 													sizeof(directionString));
 
-	durationFound	=	GetKeyWordArgument(	reqData->contentData,
+	durationFound	=	GetKeyWordArgument(	reqData,
 													"Duration",
 													durationString,
 													sizeof(durationString));
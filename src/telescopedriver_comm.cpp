@@ -30,12 +30,16 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb  7,	2021	<MLS> Created telescopedriver_comm.cpp
 //*	Feb  9,	2021	<MLS> Moved device comm variables from main class to comm class
 //*	Mar 31,	2021	<MLS> Moved command queue buffer to comm class
 //*	Sep 21,	2023	<MLS> Switching telescope comm thread to use driver class threads
 //*	Sep 21,	2023	<MLS> Added RunThread_Startup() & RunThread_Loop()
+//*	Oct 18,	2026	<AGT> Added AddCmdToQueue() with response type, time out and cmdID
+//*	Oct 18,	2026	<AGT> Added ProcessCmdResponse() & RunThread_AsyncLoop()
+//*	Oct 18,	2026	<AGT> Pipelined commands no longer wait for the socket time out
 //*****************************************************************************
 
 
@@ -52,6 +56,7 @@
 #include	<errno.h>
 #include	<termios.h>
 #include	<fcntl.h>
+#include	<sys/socket.h>
 
 #define _ENABLE_CONSOLE_DEBUG_
 #include	"ConsoleDebug.h"
@@ -123,7 +128,7 @@ char	*colonPtr;
 
 
 	cQueuedCmdCnt	=	0;
-
+	cAsyncComEnabled	=	false;
 }
 
 //**************************************************************************************
@@ -133,6 +138,10 @@ TelescopeDriverComm::~TelescopeDriverComm(void)
 {
 	CONSOLE_DEBUG(__FUNCTION__);
 	AlpacaDisConnect();
+	if (cAsyncComEnabled)
+	{
+		AsyncCom_Release(&cAsyncCom);
+	}
 }
 
 //**************************************************************************************
@@ -400,6 +409,61 @@ void	TelescopeDriverComm::AddCmdToQueue(const char *cmdString)
 	}
 }
 
+//*****************************************************************************
+//*	the done proc for the async commands, back into the class
+//*****************************************************************************
+static void	TelescopeCmdDoneProc(	void		*userData,
+									const int	cmdID,
+									const char	*cmdString,
+									const char	*responseString,
+									const int	status)
+{
+	((TelescopeDriverComm *)userData)->ProcessCmdResponse(cmdID, cmdString, responseString, status);
+}
+
+//*****************************************************************************
+//*	cmdString is sent exactly as is, the sub-class adds the protocol framing
+//*	returns false if the queue is full or async is not enabled
+//*****************************************************************************
+bool	TelescopeDriverComm::AddCmdToQueue(	const char	*cmdString,
+											const int	cmdID,
+											const int	responseType,
+											const int	timeOut_ms)
+{
+bool	queuedOK;
+
+	queuedOK	=	false;
+	if (cAsyncComEnabled)
+	{
+		queuedOK	=	AsyncCom_QueueCmd(	&cAsyncCom,
+											cmdString,
+											cmdID,
+											responseType,
+											timeOut_ms,
+											TelescopeCmdDoneProc,
+											this);
+	}
+	return(queuedOK);
+}
+
+//*****************************************************************************
+//*	This should be over ridden if async is enabled
+//*****************************************************************************
+void	TelescopeDriverComm::ProcessCmdResponse(	const int	cmdID,
+													const char	*cmdString,
+													const char	*responseString,
+													const int	status)
+{
+	(void)cmdID;
+	(void)responseString;
+
+	if (status != kAsyncStatus_OK)
+	{
+		CONSOLE_DEBUG_W_STR("Command failed\t=", cmdString);
+		CONSOLE_DEBUG_W_NUM("status\t\t=", status);
+	}
+}
+
 //*****************************************************************************
 bool	TelescopeDriverComm::SendCmdsFromQueue(void)
 {
@@ -439,6 +503,10 @@ void	TelescopeDriverComm::RunThread_Startup(void)
 			{
 				CONSOLE_DEBUG("Connection is open");
 				cTelescopeConnectionOpen	=	true;
+				if (cAsyncComEnabled)
+				{
+					AsyncCom_Open(&cAsyncCom, cSocket_desc);
+				}
 			}
 			else
 			{
@@ -459,6 +527,10 @@ void	TelescopeDriverComm::RunThread_Startup(void)
 				Serial_Set_Blocking (cDeviceConnFileDesc, false);
 
 				cTelescopeConnectionOpen	=	true;
+				if (cAsyncComEnabled)
+				{
+					AsyncCom_Open(&cAsyncCom, cDeviceConnFileDesc);
+				}
 			}
 			else
 			{
@@ -501,7 +573,12 @@ bool		sendOK;
 		//*		parse the info coming back from the telescope
 		//*		update as appropriate
 		//*	now we are going to send commands to the telescope
-		if (cQueuedCmdCnt > 0)
+		if (cAsyncComEnabled)
+		{
+			//*	no sleep, this waits for the responses
+			RunThread_AsyncLoop();
+		}
+		else if (cQueuedCmdCnt > 0)
 		{
 			sendOK	=	SendCmdsFromQueue();
 			if (sendOK == false)
@@ -520,12 +597,19 @@ bool		sendOK;
 				cTelescopeCommErrCnt++;
 			}
 		}
-		usleep(cThreadLoopDelay_usec);
+		if (cAsyncComEnabled == false)
+		{
+			usleep(cThreadLoopDelay_usec);
+		}
 
 		//*	if the error count gets too big, shut down and re-open the connection
 		if (cTelescopeCommErrCnt > 20)
 		{
 			CONSOLE_DEBUG("Closing connection due to error count, will try to re-open");
+			if (cAsyncComEnabled)
+			{
+				AsyncCom_Close(&cAsyncCom);
+			}
 			//########################################################
 			//*	close the connection
 			switch(cDeviceConnType)
@@ -549,6 +633,7 @@ bool		sendOK;
 					break;
 
 				case kDevCon_USB:
+				case kDevCon_Serial:
 					CONSOLE_DEBUG_W_STR("Time to close port\t=", cDeviceConnPath);
 					if (cDeviceConnFileDesc >= 0)
 					{
@@ -563,9 +648,6 @@ bool		sendOK;
 					cTelescopeConnectionOpen	=	false;
 					break;
 
-				case kDevCon_Serial:
-					break;
-
 				case kDevCon_Custom:
 					break;
 			}
@@ -579,4 +661,35 @@ bool		sendOK;
 	}
 }
 
+//*****************************************************************************
+//*	The periodic commands are queued as soon as the last ones are answered,
+//*	so the position updates as fast as the mount can answer.
+//*	Commands from AddCmdToQueue() wake up AsyncCom_Process() right away.
+//*****************************************************************************
+void	TelescopeDriverComm::RunThread_AsyncLoop(void)
+{
+int			finishedCnt;
+uint32_t	previousTimeOutCnt;
+
+	if (AsyncCom_PendingCnt(&cAsyncCom) == 0)
+	{
+		SendCmdsPeriodic();
+	}
+	previousTimeOutCnt	=	cAsyncCom.timeOutCnt;
+	finishedCnt			=	AsyncCom_Process(&cAsyncCom, 100);
+	if (finishedCnt < 0)
+	{
+		CONSOLE_DEBUG("Connection failed");
+		cTelescopeCommErrCnt	=	21;		//*	force the re-open
+	}
+	else if (cAsyncCom.timeOutCnt != previousTimeOutCnt)
+	{
+		cTelescopeCommErrCnt++;
+	}
+	else if (finishedCnt > 0)
+	{
+		cTelescopeCommErrCnt	=	0;
+	}
+}
+
 #endif // _ENABLE_TELESCOPE_LX200_
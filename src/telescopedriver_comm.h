@@ -14,9 +14,11 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Feb  7,	2021	<MLS> Created telescopedriver_comm.h
 //*	Mar 31,	2021	<MLS> Moved command queue struct into telescopedriver_comm class
+//*	Oct 18,	2026	<AGT> Added pipelined command queue using async_com
 //*****************************************************************************
 //#include	"telescopedriver_comm.h"
 
@@ -29,6 +31,10 @@
 	#include	"telescopedriver.h"
 #endif
 
+#ifndef _ASYNC_COM_H_
+	#include	"async_com.h"
+#endif
+
 
 
 //*****************************************************************************
@@ -105,6 +111,20 @@ class TelescopeDriverComm: public TelescopeDriver
 				int						cQueuedCmdCnt;
 				int						cThreadLoopDelay_usec;	//*	thread loop delay in micro-seconds
 		//-----------------------------------------------------------------------
+		//*	pipelined communications, the sub-class calls AsyncCom_Init() and sets cAsyncComEnabled
+		//*	the responses come back to ProcessCmdResponse() on the driver thread
+		virtual	bool	AddCmdToQueue(	const char	*cmdString,
+										const int	cmdID,
+										const int	responseType,
+										const int	timeOut_ms = kAsyncDefaultTimeOut_ms);
+		virtual	void	ProcessCmdResponse(	const int	cmdID,
+											const char	*cmdString,
+											const char	*responseString,
+											const int	status);
+				void	RunThread_AsyncLoop(void);
+				TYPE_ASYNCCOM			cAsyncCom;
+				bool					cAsyncComEnabled;
+		//-----------------------------------------------------------------------
 
 };
 
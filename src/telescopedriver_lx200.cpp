@@ -29,6 +29,7 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jan 13,	2021	<MLS> Created telescopedriver_lx200.cpp
 //*	Jan 21,	2021	<MLS> Added  AlpacaConnect() & AlpacaDisConnect() to telescope
@@ -39,6 +40,9 @@
 //*	Feb 15,	2021	<MLS> SUPPORTED: LX200 telescope mount
 //*	Feb  7,	2024	<MLS> Working on LX200 to PiFinder
 //*	Feb  7,	2024	<MLS> Added _DEBUG_LX200_
+//*	Oct 18,	2026	<AGT> Switched to pipelined commands using async_com
+//*	Oct 18,	2026	<AGT> GR/GD no longer wait for the 1/2 second socket time out
+//*	Oct 18,	2026	<AGT> Fixed Process_GD() results going to the old globals
 //*****************************************************************************
 
 
@@ -68,6 +72,8 @@
 
 //#define	_DEBUG_LX200_
 
+static int	LX200_Framer(const char *rxData, const int rxLen, const int responseType, const char terminator);
+
 //**************************************************************************************
 void	CreateTelescopeObjects_LX200(void)
 {
@@ -107,6 +113,10 @@ TelescopeDriverLX200::TelescopeDriverLX200(DeviceConnectionType connectionType,
 	cTelescopeDecl_String[0]				=	0;
 	cQueuedCmdCnt							=	0;
 
+	//*	must be set up before the driver thread starts
+	AsyncCom_Init(&cAsyncCom, LX200_Framer, '#', kAsyncDefaultInFlight);
+	cAsyncComEnabled						=	true;
+
 	AlpacaConnect();
 
 	CONSOLE_DEBUG_W_NUM("cTelescopeProp.CanUnpark\t=", cTelescopeProp.CanUnpark);
@@ -121,129 +131,190 @@ TelescopeDriverLX200::~TelescopeDriverLX200(void)
 	AlpacaDisConnect();
 }
 
-//**************************************************************************************
-bool	TelescopeDriverLX200::SendCmdsFromQueue(void)
+//*****************************************************************************
+typedef struct	//	TYPE_LX200_CMD_INFO
 {
-int		returnByteCNt;
-char	returnBuffer[500];
-int		iii;
+	char	cmdPrefix[4];
+	int		cmdID;
+	int		responseType;
+} TYPE_LX200_CMD_INFO;
 
-	CONSOLE_DEBUG(__FUNCTION__);
-	while (cQueuedCmdCnt > 0)
+//*****************************************************************************
+//*	anything not in this table does not send anything back (Mx, Qx, TQ)
+//*****************************************************************************
+static const TYPE_LX200_CMD_INFO	gLX200CmdTable[]	=
+{
+	{	"GR",	kLX200cmd_GR,	kAsyncResp_Terminated	},
+	{	"GD",	kLX200cmd_GD,	kAsyncResp_Terminated	},
+	{	"GT",	kLX200cmd_GT,	kAsyncResp_Terminated	},
+	{	"Sr",	kLX200cmd_Sr,	kAsyncResp_OneChar		},
+	{	"Sd",	kLX200cmd_Sd,	kAsyncResp_OneChar		},
+	{	"MS",	kLX200cmd_MS,	kLX200Resp_Slew			},
+	{	"CM",	kLX200cmd_CM,	kAsyncResp_Terminated	},
+	{	"",		-1,				-1						}
+};
+
+//*****************************************************************************
+static int	LX200_Framer(const char *rxData, const int rxLen, const int responseType, const char terminator)
+{
+int		frameLen;
+
+	if (responseType == kLX200Resp_Slew)
 	{
-		CONSOLE_DEBUG_W_STR("Sending", cCmdQueue[0].cmdString);
-		returnByteCNt	=	LX200_SendCommand(	cSocket_desc,
-												cCmdQueue[0].cmdString,
-												returnBuffer,
-												400);
-		if (returnByteCNt > 0)
-		{
-			CONSOLE_DEBUG_W_STR("returnBuffer\t=", returnBuffer);
-		}
-		for (iii=0; iii<cQueuedCmdCnt; iii++)
+		frameLen	=	0;
+		if (rxLen > 0)
 		{
-			cCmdQueue[iii]	=	cCmdQueue[iii + 1];
+			if (rxData[0] == '0')
+			{
+				frameLen	=	1;
+			}
+			else
+			{
+				frameLen	=	AsyncCom_DefaultFramer(rxData, rxLen, kAsyncResp_Terminated, terminator);
+			}
 		}
-		cQueuedCmdCnt--;
-		if (cQueuedCmdCnt > 0)
+	}
+	else
+	{
+		frameLen	=	AsyncCom_DefaultFramer(rxData, rxLen, responseType, terminator);
+	}
+	return(frameLen);
+}
+
+//**************************************************************************************
+//*	adds the LX200 framing, i.e. "GR" is sent as ":GR#"
+//**************************************************************************************
+void	TelescopeDriverLX200::AddCmdToQueue(const char *cmdString)
+{
+char	lx200Cmd[kAsyncMaxCmdLen];
+int		cmdID;
+int		responseType;
+int		iii;
+
+#ifdef _DEBUG_LX200_
+	CONSOLE_DEBUG_W_STR("cmdString\t=", cmdString);
+#endif // _DEBUG_LX200_
+	cmdID			=	kLX200cmd_Other;
+	responseType	=	kAsyncResp_None;
+	iii				=	0;
+	while ((cmdID == kLX200cmd_Other) && (gLX200CmdTable[iii].cmdID >= 0))
+	{
+		if (strncmp(cmdString, gLX200CmdTable[iii].cmdPrefix, 2) == 0)
 		{
-			usleep(500);
+			cmdID			=	gLX200CmdTable[iii].cmdID;
+			responseType	=	gLX200CmdTable[iii].responseType;
 		}
+		iii++;
 	}
-	return(false);
+	snprintf(lx200Cmd, sizeof(lx200Cmd), ":%s#", cmdString);
+	AddCmdToQueue(lx200Cmd, cmdID, responseType);
 }
 
-
+//**************************************************************************************
+//*	queues the position requests, the driver thread calls this again
+//*	as soon as they have been answered
 //**************************************************************************************
 bool	TelescopeDriverLX200::SendCmdsPeriodic(void)
 {
-int		returnByteCNt;
-char	returnBuffer[500];
-bool	isValid;
+bool	queuedOK;
 
 #ifdef _DEBUG_LX200_
 	CONSOLE_DEBUG("=============================================================");
 	CONSOLE_DEBUG(__FUNCTION__);
 #endif // _DEBUG_LX200_
-	isValid	=	false;
-	//--------------------------------------------------------------------------
 	//*	Right Ascension
-	returnByteCNt	=	LX200_SendCommand(cSocket_desc, "GR", returnBuffer, 400);
-	if (returnByteCNt > 0)
-	{
+	queuedOK	=	AddCmdToQueue(":GR#", kLX200cmd_GR, kAsyncResp_Terminated);
+
+	//*	Declination
+	queuedOK	&=	AddCmdToQueue(":GD#", kLX200cmd_GD, kAsyncResp_Terminated);
+
+	//*	TrackingRate
+//	queuedOK	&=	AddCmdToQueue(":GT#", kLX200cmd_GT, kAsyncResp_Terminated);
+
+	return(queuedOK);
+}
+
+//**************************************************************************************
+//*	called on the driver thread as each response comes in
+//**************************************************************************************
+void	TelescopeDriverLX200::ProcessCmdResponse(	const int	cmdID,
+													const char	*cmdString,
+													const char	*responseString,
+													const int	status)
+{
+char	dataBuffer[kAsyncMaxResponseLen];
+bool	isValid;
+
 #ifdef _DEBUG_LX200_
-		CONSOLE_DEBUG_W_STR("Right Ascension\t=", returnBuffer);
+	CONSOLE_DEBUG_W_STR(cmdString, responseString);
 #endif // _DEBUG_LX200_
-
-		isValid			=	Process_GR_RtAsc(returnBuffer);
-		if (isValid)
-		{
-			cTelescopeInfoValid	=	true;
-		}
-		else
+	if (status == kAsyncStatus_OK)
+	{
+		strcpy(dataBuffer, responseString);
+		switch(cmdID)
 		{
-			strcpy(cTelescopeRA_String, "RA failed");
-			cLX200_SocketErrCnt++;
-			cTelescopeInfoValid	=	false;
-			CONSOLE_DEBUG_W_NUM("cLX200_SocketErrCnt\t=", cLX200_SocketErrCnt);
+			case kLX200cmd_GR:
+				isValid	=	Process_GR_RtAsc(dataBuffer);
+				if (isValid)
+				{
+					cTelescopeInfoValid	=	true;
+				}
+				else
+				{
+					strcpy(cTelescopeRA_String, "RA failed");
+					cLX200_SocketErrCnt++;
+					cTelescopeInfoValid	=	false;
+					CONSOLE_DEBUG_W_NUM("cLX200_SocketErrCnt\t=", cLX200_SocketErrCnt);
+				}
+				break;
+
+			case kLX200cmd_GD:
+				isValid	=	Process_GD(dataBuffer);
+				if (isValid)
+				{
+					cTelescopeInfoValid	=	true;
+				}
+				else
+				{
+					strcpy(cTelescopeDecl_String, "DEC failed");
+					cLX200_SocketErrCnt++;
+					cTelescopeInfoValid	=	false;
+				}
+				break;
+
+			case kLX200cmd_GT:
+				Process_GT(dataBuffer);
+				break;
+
+			case kLX200cmd_Sr:
+			case kLX200cmd_Sd:
+				if (dataBuffer[0] != '1')
+				{
+					CONSOLE_DEBUG_W_STR("Rejected by mount\t=", cmdString);
+				}
+				break;
+
+			case kLX200cmd_MS:
+				if (dataBuffer[0] != '0')
+				{
+					CONSOLE_DEBUG_W_STR("Slew failed\t=", dataBuffer);
+				}
+				break;
+
+			default:
+				break;
 		}
-		usleep(1000);
 	}
-	else
+	else if (status != kAsyncStatus_Flushed)
 	{
 		cLX200_SocketErrCnt++;
-		CONSOLE_DEBUG_W_NUM("cLX200_SocketErrCnt\t=", cLX200_SocketErrCnt);
-	}
-
-	//--------------------------------------------------------------------------
-	//*	Declination
-	returnByteCNt	=	LX200_SendCommand(cSocket_desc, "GD", returnBuffer, 400);
-	if (returnByteCNt > 0)
-	{
-#ifdef _DEBUG_LX200_
-		CONSOLE_DEBUG_W_STR("Declination    \t=", returnBuffer);
-#endif // _DEBUG_LX200_
-		isValid			=	Process_GD(returnBuffer);
-		if (isValid)
+		if ((cmdID == kLX200cmd_GR) || (cmdID == kLX200cmd_GD))
 		{
-			gTelescopeInfoValid	=	true;
-		}
-		else
-		{
-			strcpy(gTelescopeDecl_String, "DEC failed");
-			cLX200_SocketErrCnt++;
 			cTelescopeInfoValid	=	false;
 		}
-		usleep(1000);
-	}
-	else
-	{
-		cLX200_SocketErrCnt++;
+		CONSOLE_DEBUG_W_STR("No response\t=", cmdString);
 		CONSOLE_DEBUG_W_NUM("cLX200_SocketErrCnt\t=", cLX200_SocketErrCnt);
 	}
-
-	//--------------------------------------------------------------------------
-	//*	TrackingRate
-//	returnByteCNt	=	LX200_SendCommand(cSocket_desc, "GT", returnBuffer, 400);
-//	if (returnByteCNt > 0)
-//	{
-//		isValid			=	Process_GT(returnBuffer);
-//		if (isValid)
-//		{
-//			cTelescopeInfoValid	=	true;
-//		}
-//		else
-//		{
-//		}
-//		usleep(1000);
-//	}
-//	else
-//	{
-//		cLX200_SocketErrCnt++;
-//		CONSOLE_DEBUG_W_NUM("cLX200_SocketErrCnt\t=", cLX200_SocketErrCnt);
-//	}
-
-	return(isValid);
 }
 
 
@@ -254,7 +325,7 @@ TYPE_ASCOM_STATUS		alpacaErrCode	=	kASCOM_Err_Success;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	//*	because this is ABORT, we are going to wipe out all pending commands
-	cQueuedCmdCnt	=	0;
+	AsyncCom_Flush(&cAsyncCom);
 	AddCmdToQueue("Q");
 	cTelescopeProp.Slewing	=	false;
 
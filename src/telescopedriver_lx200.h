@@ -14,8 +14,10 @@
 //*	Edit History
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jan 13,	2021	<MLS> Created telescopedriver_lx200.h
+//*	Oct 18,	2026	<AGT> Switched to pipelined commands, added ProcessCmdResponse()
 //*****************************************************************************
 //#include	"telescopedriver_lx200.h"
 
@@ -37,6 +39,23 @@
 
 void	CreateTelescopeObjects_LX200(void);
 
+//*****************************************************************************
+//*	the cmdID values for the LX200 queue
+enum
+{
+	kLX200cmd_Other	=	0,
+	kLX200cmd_GR,
+	kLX200cmd_GD,
+	kLX200cmd_GT,
+	kLX200cmd_Sr,
+	kLX200cmd_Sd,
+	kLX200cmd_MS,
+	kLX200cmd_CM
+};
+
+//*	MS returns "0" or "1<string>#" or "2<string>#"
+#define	kLX200Resp_Slew		(kAsyncResp_Protocol + 0)
+
 
 //**************************************************************************************
 class TelescopeDriverLX200: public TelescopeDriverComm
@@ -51,8 +70,13 @@ class TelescopeDriverLX200: public TelescopeDriverComm
 		virtual					~TelescopeDriverLX200(void);
 //-		virtual	int32_t			RunStateMachine(void);
 
-		virtual	bool			SendCmdsFromQueue(void);
+		using	TelescopeDriverComm::AddCmdToQueue;
+		virtual	void			AddCmdToQueue(const char *cmdString);
 		virtual	bool			SendCmdsPeriodic(void);
+		virtual	void			ProcessCmdResponse(	const int	cmdID,
+													const char	*cmdString,
+													const char	*responseString,
+													const int	status);
 
 
 //		//--------------------------------------------------------------------------------------------------
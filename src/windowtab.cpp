@@ -3154,7 +3154,7 @@ Controller	*myControllerObj;
 		{
 		SJP_Parser_t	localJsonParser;
 
-			SJP_Init(&localJsonParser);
+			SJP_Reset(&localJsonParser);
 //			CONSOLE_DEBUG("jsonParser is NULL");
 //			validData	=	myControllerObj->AlpacaSendPutCmd(	alpacaDevice,
 //																alpacaCmd,
@@ -263,7 +263,7 @@ int				alpacaErrorCode;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 
-	SJP_Init(&jsonParser);
+	SJP_Reset(&jsonParser);
 	//	http://wo102:6800/api/v1/filterwheel/0/interfaceversion
 	sprintf(getFunctionString, "/api/v1/%s/%d/interfaceversion",	remoteDevice->deviceTypeStr,
 																	remoteDevice->alpacaDeviceNum);
@@ -46,6 +46,7 @@
 //*	Apr 30,	2023	<MLS> Moved all camera cooling stuff to its own window tab
 //*	Jun 18,	2023	<MLS> Added DeviceState to camera
 //*	Jul 14,	2023	<MLS> Added UpdateDownloadOptions()
+//*	Oct 18,	2026	<AGT> Fixed memory leak of downloaded image (C++ openCV)
 //*****************************************************************************
 
 #ifdef _ENABLE_CTRL_CAMERA_
@@ -1308,6 +1309,10 @@ ControllerImage		*imageWindowController;
 				//*	set the image download data
 				imageWindowController->SetDownloadInfo(download_MBytes, download_seconds);
 			}
+	#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+			//*	the image controller shares the pixel data, this only releases our reference
+			delete myDownLoadedImage;
+	#endif
 #else
 			cvReleaseImage(&myDownLoadedImage);
 #endif // _ENABLE_CTRL_IMAGE_
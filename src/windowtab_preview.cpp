@@ -23,6 +23,7 @@
 //*	Jun 25,	2020	<MLS> Downloading image via Alpaca protocol working (rgbarray)
 //*	Jun 29,	2020	<MLS> Added saving the downloaded image locally
 //*	Aug 11,	2020	<MLS> Added autoexposure radio button to preview window
+//*	Oct 18,	2026	<AGT> Preview handles 8 and 16 bit monochrome downloads
 //*****************************************************************************
 
 
@@ -667,12 +668,33 @@ int					openCVerr;
 			{
 //				CONSOLE_DEBUG("Resizing image");
 			#ifdef _USE_OPENCV_CPP_
-				cv::resize(	*originalImage,
-							*cOpenCVdownLoadedImage,
-							cOpenCVdownLoadedImage->size(),
-							0,
-							0,
-							cv::INTER_LINEAR);
+				if (originalImage->channels() == 3)
+				{
+					cv::resize(	*originalImage,
+								*cOpenCVdownLoadedImage,
+								cOpenCVdownLoadedImage->size(),
+								0,
+								0,
+								cv::INTER_LINEAR);
+				}
+				else
+				{
+				cv::Mat	reducedImage;
+
+					//*	monochrome images are downloaded at their native depth,
+					//*	reduce the size first, then convert to 8 bit color for display
+					cv::resize(	*originalImage,
+								reducedImage,
+								cOpenCVdownLoadedImage->size(),
+								0,
+								0,
+								cv::INTER_LINEAR);
+					if (reducedImage.depth() == CV_16U)
+					{
+						reducedImage.convertTo(reducedImage, CV_8U, (1.0 / 256.0));
+					}
+					cv::cvtColor(reducedImage, *cOpenCVdownLoadedImage, cv::COLOR_GRAY2BGR);
+				}
 			#else
 				cvResize(originalImage, cOpenCVdownLoadedImage, CV_INTER_LINEAR);
 			#endif
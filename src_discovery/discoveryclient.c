@@ -275,6 +275,7 @@ int					setOptRetCode;
 //					SJP_DumpJsonData(&jsonParser);
 
 					ExtractDevicesFromJSON(&jsonParser, theDevice);
+					SJP_Release(&jsonParser);
 				}
 			}
 			closeRetCode	=	close(socket_desc);
@@ -442,6 +443,7 @@ int					bytesWritten;
 		exit(EXIT_FAILURE);
 	}
 
+	SJP_Init(&jsonParser);
 	sendtoRetCode	=	0;
 //	while (sendtoRetCode >= 0)
 	{
@@ -469,7 +471,6 @@ int					bytesWritten;
 				buf[rcvCnt]	=	0;
 //				CONSOLE_DEBUG("We have data");
 //				CONSOLE_DEBUG_W_STR("buf=", buf);
-				SJP_Init(&jsonParser);
 				SJP_ParseData(&jsonParser, buf);
 //				SJP_DumpJsonData(&jsonParser);
 
@@ -511,5 +512,6 @@ int					bytesWritten;
 		printf("\r\n");
 		printf("Total alpaca devices found = %d\r\n", gAlpacaUnitCnt);
 	}
+	SJP_Release(&jsonParser);
 	return(0);
 }
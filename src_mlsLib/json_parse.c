@@ -8,8 +8,8 @@
 //*		Limitations:
 //*			Does not differentiate nested constructs
 //*			Limited error handling
-//*			Keyword max length of 31 chars
-//*			Value max length of 63 chars
+//*			Keyword max length of 63 chars
+//*			Value max length of 255 chars
 //*
 //*****************************************************************************
 //*	Nov  8,	2018	<MLS> Started on json_parse library
@@ -33,6 +33,11 @@
 //*	Mar  5,	2020	<MLS> Added _DEBUG_ARRAY_
 //*	Mar  5,	2020	<MLS> Fixed bug when there is only one element in an array
 //*	Mar  5,	2020	<MLS> At start of an array, there was a limit of 32 chars for 1st data element
+//*	Oct 18,	2026	<AGT> Parse in place, tokens point into the parser's copy of the text
+//*	Oct 18,	2026	<AGT> Token lists now grow as needed, no more token count limits
+//*	Oct 18,	2026	<AGT> Added SJP_Release(), SJP_AddToken() and SJP_FindKeyWordIndex()
+//*	Oct 18,	2026	<AGT> Added SJP_GetDouble(), SJP_GetLong() and SJP_GetBool()
+//*	Oct 18,	2026	<AGT> SJP_Init() always starts empty, added SJP_Reset() to re-use the buffers
 //*****************************************************************************
 
 //#include <stdlib.h>
@@ -52,32 +57,88 @@
 
 #include	"json_parse.h"
 
+//*	tokens that do not come from the json text point at these
+static char	gSJP_EmptyString[]		=	"";
+static char	gSJP_ArrayString[]		=	"ARRAY";
+static char	gSJP_ArrayEndString[]	=	"]";
+static char	gSJP_ArrayNextString[]	=	"ARRAY-NEXT";
+
+//**************************************************************************************
+static void	SJP_Private_ClearTokenList(SJP_token_t	*tokenList, const int	tokenCnt)
+{
+int		tknIdx;
+
+	if (tokenList != NULL)
+	{
+		for (tknIdx=0; tknIdx<tokenCnt; tknIdx++)
+		{
+			tokenList[tknIdx].keyword		=	gSJP_EmptyString;
+			tokenList[tknIdx].valueString	=	gSJP_EmptyString;
+			tokenList[tknIdx].keyHash		=	0;
+			tokenList[tknIdx].numberState	=	0;
+			tokenList[tknIdx].numberValue	=	0.0;
+		}
+	}
+}
+
+//**************************************************************************************
+//*	SJP_Init
+//*		the structure is assumed to be uninitialized memory, nothing in it is looked at.
+//*		Calling this on a parser that has been used leaks its buffers, use SJP_Reset()
 //**************************************************************************************
 void	SJP_Init(SJP_Parser_t *theParserDataStruct)
 {
-short		ii;
+	if (theParserDataStruct != NULL)
+	{
+		memset((void *)theParserDataStruct, 0, sizeof(SJP_Parser_t));
+	}
+}
 
+//**************************************************************************************
+//*	SJP_Reset
+//*		empties a parser that has been through SJP_Init(), the buffers are kept for re-use
+//**************************************************************************************
+void	SJP_Reset(SJP_Parser_t *theParserDataStruct)
+{
 	if (theParserDataStruct != NULL)
 	{
+		SJP_Private_ClearTokenList(theParserDataStruct->headerList,	theParserDataStruct->tokenMax_Hdr);
+		SJP_Private_ClearTokenList(theParserDataStruct->dataList,	theParserDataStruct->tokenMax_Data);
+		SJP_Private_ClearTokenList(theParserDataStruct->errorList,	theParserDataStruct->tokenMax_Errs);
 		theParserDataStruct->tokenCount_Hdr		=	0;
 		theParserDataStruct->tokenCount_Data	=	0;
 		theParserDataStruct->tokenCount_Errs	=	0;
+		theParserDataStruct->dataHashValid		=	false;
+	}
+}
 
-		//*	set all the strings to null
-		for (ii=0; ii < kSJP_MaxTokens_Hdr; ii++)
-		{
-			memset(&theParserDataStruct->headerList[ii], 0, sizeof(SJP_token_t));
-		}
-
-		for (ii=0; ii < kSJP_MaxTokens_Data; ii++)
-		{
-			memset(&theParserDataStruct->dataList[ii], 0, sizeof(SJP_token_t));
-		}
-
-		for (ii=0; ii < kSJP_MaxTokens_Errs; ii++)
-		{
-			memset(&theParserDataStruct->errorList[ii], 0, sizeof(SJP_token_t));
-		}
+//**************************************************************************************
+//*	frees everything the parser allocated, it is empty and can be used again
+//**************************************************************************************
+void	SJP_Release(SJP_Parser_t *theParserDataStruct)
+{
+	if (theParserDataStruct != NULL)
+	{
+		free(theParserDataStruct->headerList);
+		free(theParserDataStruct->dataList);
+		free(theParserDataStruct->errorList);
+		free(theParserDataStruct->textBuffer);
+		free(theParserDataStruct->dataHashTable);
+
+		theParserDataStruct->headerList			=	NULL;
+		theParserDataStruct->dataList			=	NULL;
+		theParserDataStruct->errorList			=	NULL;
+		theParserDataStruct->textBuffer			=	NULL;
+		theParserDataStruct->dataHashTable		=	NULL;
+		theParserDataStruct->tokenMax_Hdr		=	0;
+		theParserDataStruct->tokenMax_Data		=	0;
+		theParserDataStruct->tokenMax_Errs		=	0;
+		theParserDataStruct->tokenCount_Hdr		=	0;
+		theParserDataStruct->tokenCount_Data	=	0;
+		theParserDataStruct->tokenCount_Errs	=	0;
+		theParserDataStruct->textBufferSize		=	0;
+		theParserDataStruct->dataHashSize		=	0;
+		theParserDataStruct->dataHashValid		=	false;
 	}
 }
 
@@ -90,37 +151,101 @@ long	SJP_GetVersion(void)
 //**************************************************************************************
 static void	ToUpperStr(char *theString)
 {
-short	sLen;
-short	ii;
+	while (*theString != 0)
+	{
+		*theString	=	toupper(*theString);
+		theString++;
+	}
+}
+
+//**************************************************************************************
+//*	FNV-1a, the keywords are already upper case
+//**************************************************************************************
+static unsigned int	SJP_Private_HashKeyword(const char *theKeyword)
+{
+unsigned int	hashValue;
 
-	sLen	=	strlen(theString);
-	for (ii=0; ii<sLen; ii++)
+	hashValue	=	2166136261u;
+	while (*theKeyword != 0)
 	{
-		theString[ii]	=	toupper(theString[ii]);
+		hashValue	^=	(unsigned char)*theKeyword;
+		hashValue	*=	16777619u;
+		theKeyword++;
+	}
+	return(hashValue);
+}
+
+//**************************************************************************************
+//*	make sure there is room for at least tokensNeeded entries in the list
+//**************************************************************************************
+static bool	SJP_Private_GrowTokenList(SJP_token_t **tokenList, int *tokenMax, const int tokensNeeded)
+{
+SJP_token_t	*newList;
+int			newMax;
+bool		validFlag;
+
+	validFlag	=	true;
+	if (tokensNeeded > *tokenMax)
+	{
+		newMax	=	(*tokenMax > 0) ? *tokenMax : kSJP_InitialTokenCnt;
+		while (newMax < tokensNeeded)
+		{
+			newMax	=	newMax * 2;
+		}
+		newList	=	(SJP_token_t *)realloc(*tokenList, (newMax * sizeof(SJP_token_t)));
+		if (newList != NULL)
+		{
+			SJP_Private_ClearTokenList(&newList[*tokenMax], (newMax - *tokenMax));
+			*tokenList	=	newList;
+			*tokenMax	=	newMax;
+		}
+		else
+		{
+			CONSOLE_DEBUG("Failed to allocate token list");
+			validFlag	=	false;
+		}
 	}
+	return(validFlag);
 }
 
+//**************************************************************************************
+//*	When a value is terminated in place, the terminating char gets overwritten with a NULL.
+//*	It may be a structural char (i.e. ',' or '}') that the parser still has to see,
+//*	so it is saved here.
+typedef struct
+{
+	char	*pendingPtr;
+	char	pendingChar;
+	char	*emptyString;
+
+} SJP_ParseState_t;
+
 //**************************************************************************************
 //*	SJP_Private_GetString
 //*		take in a ptr to a string
 //*		skips any white space
 //*		the first non-white space char determines the string type (quoted vs non-quoted)
+//*		The string is NULL terminated in place (escape chars are processed in place)
 //*		Returns an updated pointer to the data
 //**************************************************************************************
-static char *SJP_Private_GetString(	const char	*jsonDataPtr,
-									char		*parsedString,
-									const int	maxLen)
+static char *SJP_Private_GetString(	char				*jsonDataPtr,
+									char				**parsedString,
+									const int			maxLen,
+									SJP_ParseState_t	*parseState)
 {
 char	*myJsonDataPtr;
+char	*writePtr;
 char	theFirstChar;
 char	theSecondChar;
 char	currChar;
-short	cc;
+char	outputChar;
+bool	outputValid;
+int		cc;
 short	uuCnt;
 short	uuChar;
 
-	parsedString[0]	=	0;
-	myJsonDataPtr	=	(char *)jsonDataPtr;
+	*parsedString	=	parseState->emptyString;
+	myJsonDataPtr	=	jsonDataPtr;
 	if (myJsonDataPtr != NULL)
 	{
 		//*	skip white space and any control chars (i.e. tab, cr, lf)
@@ -140,58 +265,38 @@ short	uuChar;
 		}
 		else if (theFirstChar == '"')
 		{
-	#ifdef _DEBUG_ARRAY_
+		#ifdef _DEBUG_ARRAY_
 			CONSOLE_DEBUG("start of quoted string");
 			CONSOLE_DEBUG_W_NUM("maxLen\t=", maxLen);
-	#endif
+		#endif
 			//*	we have a quoted string, proceed to the terminating quote
 			myJsonDataPtr++;	//*	skip the '"'
-			cc	=	0;
-			while (	(*myJsonDataPtr != '"') &&
-					(*myJsonDataPtr != 0) &&		//*	end of line
-					(cc < (maxLen -1)))
+			*parsedString	=	myJsonDataPtr;
+			writePtr		=	myJsonDataPtr;
+			cc				=	0;
+			while ((*myJsonDataPtr != '"') && (*myJsonDataPtr != 0))		//*	end of line
 			{
-				currChar			=	*myJsonDataPtr;
+				currChar	=	*myJsonDataPtr;
+				outputValid	=	true;
 				if (currChar == '\\')
 				{
 					myJsonDataPtr++;
 					currChar		=	*myJsonDataPtr;
-					myJsonDataPtr++;
+					if (currChar != 0)
+					{
+						myJsonDataPtr++;
+					}
 					switch (currChar)
 					{
 						//*	Allowed escaped symbols
-						case 0x22:							//*	"
-							parsedString[cc++]	=	'"';
-							break;
-
-						case 0x5c:							//*	"\"
-							parsedString[cc++]	=	'\\';
-							break;
-
-						case '/':
-							parsedString[cc++]	=	'/';
-							break;
-
-						case 'b':
-							parsedString[cc++]	=	0x08;	//*	backspace
-							break;
-
-						case 'f':
-							parsedString[cc++]	=	0x0c;	//*	formfeed
-							break;
-
-						case 'r':
-							parsedString[cc++]	=	0x0d;	//*	return
-							break;
-
-						case 'n':
-							parsedString[cc++]	=	0x0a;	//*	new line (linefeed)
-							break;
-
-						case 't':
-							parsedString[cc++]	=	0x09;	//*	tab
-							break;
-
+						case 0x22:	outputChar	=	'"';	break;	//*	"
+						case 0x5c:	outputChar	=	'\\';	break;	//*	"\"
+						case '/':	outputChar	=	'/';	break;
+						case 'b':	outputChar	=	0x08;	break;	//*	backspace
+						case 'f':	outputChar	=	0x0c;	break;	//*	formfeed
+						case 'r':	outputChar	=	0x0d;	break;	//*	return
+						case 'n':	outputChar	=	0x0a;	break;	//*	new line (linefeed)
+						case 't':	outputChar	=	0x09;	break;	//*	tab
 
 						//*	Allows escaped symbol \uXXXX
 						case 'u':
@@ -219,26 +324,36 @@ short	uuChar;
 								uuCnt++;
 							}
 							//*	TODO: Finish the proper uuencode sequence
-							parsedString[cc++]	=	uuChar;	//*	save the char
+							outputChar	=	uuChar;	//*	save the char
 							break;
 
 						//*	Unexpected symbol
 						default:
+							outputChar	=	0;
+							outputValid	=	false;
 							break;
 					}
 				}
 				else
 				{
-					parsedString[cc++]	=	currChar;
+					outputChar	=	currChar;
 					myJsonDataPtr++;
 				}
-				parsedString[cc]	=	0;	//*	null terminate (I know, it does it every time)
+				//*	the output never gets ahead of the input, so this is safe to do in place
+				//*	anything past the max length is dropped but still skipped over
+				if (outputValid && (cc < (maxLen - 1)))
+				{
+					*writePtr++	=	outputChar;
+					cc++;
+				}
 			}
 			if (*myJsonDataPtr == '"')
 			{
 				//*	skip the closing quote
 				myJsonDataPtr++;
 			}
+			//*	the write pointer is at or before the closing quote
+			*writePtr	=	0;
 		}
 		else if (theFirstChar == '[')
 		{
@@ -251,42 +366,65 @@ short	uuChar;
 		else
 		{
 			//*	we have a number or boolean value
-			cc	=	0;
+			*parsedString	=	myJsonDataPtr;
+			cc				=	0;
 			//*	stop on space, control char or coma
 			while (	(*myJsonDataPtr > 0x20) &&
 					(*myJsonDataPtr != ',') &&
 					(*myJsonDataPtr != ']') &&
-					(*myJsonDataPtr != '}') &&
-					(cc < (maxLen -1)))
+					(*myJsonDataPtr != '}'))
 			{
-				parsedString[cc++]	=	*myJsonDataPtr;
-				parsedString[cc]	=	0;	//*	null terminate (I know, it does it every time)
 				myJsonDataPtr++;
+				cc++;
+			}
+			if (cc >= maxLen)
+			{
+				//*	too long, truncate it inside of the value
+				(*parsedString)[maxLen - 1]	=	0;
+			}
+			else if (*myJsonDataPtr != 0)
+			{
+				//*	terminate it on the delimiter and remember what the delimiter was
+				parseState->pendingPtr	=	myJsonDataPtr;
+				parseState->pendingChar	=	*myJsonDataPtr;
+				*myJsonDataPtr			=	0;
 			}
-
 		}
 	}
-	CONSOLE_DEBUG_W_STR("parsedString\t\t=", parsedString);
+	CONSOLE_DEBUG_W_STR("parsedString\t\t=", *parsedString);
 	return(myJsonDataPtr);
 }
 
+//**************************************************************************************
+//*	keywords are limited to kSJP_MaxKeyLen for the callers that copy them
+static void	SJP_Private_LimitKeyword(char *theKeyword)
+{
+int		cc;
 
+	cc	=	0;
+	while ((theKeyword[cc] != 0) && (cc < (kSJP_MaxKeyLen - 1)))
+	{
+		cc++;
+	}
+	if (theKeyword[cc] != 0)
+	{
+		theKeyword[cc]	=	0;
+	}
+}
 
 //**************************************************************************************
-static void	SJP_Private_ClearTokenList(SJP_token_t	*tokenList, const int	maxTokens)
+static void	SJP_Private_HashTokenList(SJP_token_t *tokenList, const int tokenCnt)
 {
-short	tknIdx;
+int		tknIdx;
 
-	if (tokenList != NULL)
+	for (tknIdx=0; tknIdx<tokenCnt; tknIdx++)
 	{
-		for (tknIdx=0; tknIdx<maxTokens; tknIdx++)
-		{
-			memset(tokenList[tknIdx].keyword,		0, kSJP_MaxKeyLen);
-			memset(tokenList[tknIdx].valueString,	0, kSJP_MaxValueLen);
-		}
+		SJP_Private_LimitKeyword(tokenList[tknIdx].keyword);
+		tokenList[tknIdx].keyHash	=	SJP_Private_HashKeyword(tokenList[tknIdx].keyword);
 	}
 }
 
+#define	TOKEN_NOT_EMPTY(theToken)	((theToken.keyword[0] != 0) || (theToken.valueString[0] != 0))
 
 //**************************************************************************************
 //*	this is used as an indicator as to which data block we are currently working on.
@@ -305,103 +443,121 @@ enum
 int	SJP_ParseData(	SJP_Parser_t	*theParser,
 					const char 		*jsonDataPtr)
 {
-int			returnCode;
-int			dataLen;
-int			tokenIdx;
-char		theChar;
-char		*myJsonDataPtr;
-char		myKeywordString[kSJP_MaxValueLen];
-char		myValueString[kSJP_MaxValueLen];
-bool		headerFound;
-SJP_token_t	*myCurrTokenList;
-int			myCurrTokenMax;
-int			myCurrDataBlock;
-bool		arrayInProcess;
-bool		masterArrayFlag;
+int					returnCode;
+int					dataLen;
+int					tokenIdx;
+char				theChar;
+char				*myJsonDataPtr;
+char				*myJsonDataEnd;
+char				*myKeywordString;
+char				*myValueString;
+char				*newBuffer;
+bool				headerFound;
+bool				newBlockFlag;
+SJP_token_t			*myCurrTokenList;
+SJP_token_t			**myCurrTokenListPtr;
+int					*myCurrTokenMaxPtr;
+int					myCurrDataBlock;
+bool				arrayInProcess;
+bool				masterArrayFlag;
+SJP_ParseState_t	parseState;
 
 #if defined(_DEBUG_PARSER_) || defined(_DEBUG_ARRAY_)
-	char	debugString[64];
+	char	debugString[kSJP_MaxValueLen + 64];
 #endif
 
 	CONSOLE_DEBUG(__FUNCTION__);
 	CONSOLE_DEBUG_W_STR("jsonDataPtr\t=", jsonDataPtr);
 
-
-
 	returnCode		=	0;
 	headerFound		=	false;
 	arrayInProcess	=	false;
 	masterArrayFlag	=	false;
 
 	myCurrTokenList	=	NULL;
-	myCurrTokenMax	=	0;
 	myCurrDataBlock	=	kDataBlock_None;
 
 
 	if ((theParser != NULL) && (jsonDataPtr != NULL))
 	{
-//		//*	debug first line of json data
-//		int	iii;
-//		iii	=	0;
-//		while (jsonDataPtr[iii] >= 0x20)
-//		{
-//			fprintf(stderr, "%c", jsonDataPtr[iii]);
-//			iii++;
-//		}
-//		fprintf(stderr, "\r\n");
-
-		memset(myKeywordString,	0,	kSJP_MaxValueLen);
-		memset(myValueString,	0,	kSJP_MaxValueLen);
+		//*	this clears the token lists, the buffers from a previous parse get re-used
+		SJP_Reset(theParser);
 
-		theParser->tokenCount_Hdr	=	0;
-		theParser->tokenCount_Data	=	0;
-		theParser->tokenCount_Errs	=	0;
+		//*	copy the text once, everything after this is done in place
+		dataLen	=	strlen(jsonDataPtr);
+		if ((dataLen + 1) > theParser->textBufferSize)
+		{
+			newBuffer	=	(char *)realloc(theParser->textBuffer, (dataLen + 1));
+			if (newBuffer != NULL)
+			{
+				theParser->textBuffer		=	newBuffer;
+				theParser->textBufferSize	=	dataLen + 1;
+			}
+			else
+			{
+				returnCode	=	SJP_ExceededTokenCnt;
+				dataLen		=	0;
+			}
+		}
+		if (returnCode == 0)
+		{
+			memcpy(theParser->textBuffer, jsonDataPtr, (dataLen + 1));
+		}
 
-		//*	clear the token lists
-		SJP_Private_ClearTokenList(theParser->headerList,	kSJP_MaxTokens_Hdr);
-		SJP_Private_ClearTokenList(theParser->dataList,		kSJP_MaxTokens_Data);
-		SJP_Private_ClearTokenList(theParser->errorList,	kSJP_MaxTokens_Errs);
+		parseState.pendingPtr	=	NULL;
+		parseState.pendingChar	=	0;
+		parseState.emptyString	=	gSJP_EmptyString;
 
-		tokenIdx		=	0;
-		dataLen			=	strlen(jsonDataPtr);
-		myJsonDataPtr	=	(char *)jsonDataPtr;
+		myKeywordString	=	gSJP_EmptyString;
+		myValueString	=	gSJP_EmptyString;
+		myJsonDataPtr	=	theParser->textBuffer;
+		myJsonDataEnd	=	theParser->textBuffer + dataLen;
 
 		//*	set some defaults first
-		myCurrDataBlock	=	kDataBlock_Data;
-		myCurrTokenList	=	theParser->dataList;
-		myCurrTokenMax	=	kSJP_MaxTokens_Data;
-		tokenIdx		=	0;
+		myCurrDataBlock		=	kDataBlock_Data;
+		myCurrTokenListPtr	=	&theParser->dataList;
+		myCurrTokenMaxPtr	=	&theParser->tokenMax_Data;
+		tokenIdx			=	0;
 
 
 		//*	we will be manipulating the data ptr as we go
-		while (myJsonDataPtr < (jsonDataPtr + dataLen))
+		while ((myJsonDataPtr < myJsonDataEnd) && (returnCode == 0))
 		{
-			theChar	=	*myJsonDataPtr;
-
-		#ifdef _DEBUG_PARSER_
-			debugString[0]	=	0x30 + (theChar >> 4);
-			debugString[1]	=	0x30 + (theChar & 0x0f);
-			if (debugString[1] > 0x39)
+			if (myJsonDataPtr == parseState.pendingPtr)
 			{
-				debugString[1]	+=	7;
+				//*	this one got overwritten with the NULL terminator
+				theChar					=	parseState.pendingChar;
+				parseState.pendingPtr	=	NULL;
 			}
-			debugString[2]	=	0x20;
-			if (theChar >= 0x20)
+			else
 			{
-				debugString[3]	=	theChar;
+				theChar	=	*myJsonDataPtr;
 			}
-			else
+
+			//*	no case below uses more than 2 entries past the current index
+			if (SJP_Private_GrowTokenList(myCurrTokenListPtr, myCurrTokenMaxPtr, (tokenIdx + 3)) == false)
 			{
-				debugString[3]	=	'_';
+				returnCode	=	SJP_ExceededTokenCnt;
+				theChar		=	0;
 			}
-			debugString[4]	=	0;
-//			CONSOLE_DEBUG_W_STR("theChar\t\t=", debugString);
-		#endif
+			myCurrTokenList	=	*myCurrTokenListPtr;
 
 			switch(theChar)
 			{
+				case 0:
+					if (returnCode != 0)
+					{
+						//*	out of memory, give up
+						myJsonDataPtr	=	myJsonDataEnd;
+					}
+					else
+					{
+						myJsonDataPtr++;
+					}
+					break;
+
 				case ',':
-					if ((strlen(myCurrTokenList[tokenIdx].keyword) > 0) || (strlen(myCurrTokenList[tokenIdx].valueString) > 0))
+					if (TOKEN_NOT_EMPTY(myCurrTokenList[tokenIdx]))
 					{
 					#ifdef _DEBUG_PARSER_
 						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
@@ -413,19 +569,16 @@ bool		masterArrayFlag;
 					{
 						myJsonDataPtr++;
 						CONSOLE_DEBUG("Array in progress");
-						myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, myKeywordString, kSJP_MaxValueLen);
+						myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, &myKeywordString, kSJP_MaxValueLen, &parseState);
 						CONSOLE_DEBUG_W_STR("myKeywordString\t=", myKeywordString);
-						if (tokenIdx < myCurrTokenMax)
+						myCurrTokenList[tokenIdx].valueString	=	myKeywordString;
+						if (TOKEN_NOT_EMPTY(myCurrTokenList[tokenIdx]))
 						{
-							strcpy(myCurrTokenList[tokenIdx].valueString, myKeywordString);
-							if ((strlen(myCurrTokenList[tokenIdx].keyword) > 0) || (strlen(myCurrTokenList[tokenIdx].valueString) > 0))
-							{
-							#ifdef _DEBUG_PARSER_
-								sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
-								CONSOLE_DEBUG(debugString);
-							#endif
-								tokenIdx++;
-							}
+						#ifdef _DEBUG_PARSER_
+							sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
+							CONSOLE_DEBUG(debugString);
+						#endif
+							tokenIdx++;
 						}
 						break;
 					}
@@ -437,99 +590,78 @@ bool		masterArrayFlag;
 
 				case '{':
 					myJsonDataPtr++;
-					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, myKeywordString, kSJP_MaxValueLen);
+					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, &myKeywordString, kSJP_MaxValueLen, &parseState);
 					ToUpperStr(myKeywordString);
 
-					if ((myCurrTokenList != NULL) && (tokenIdx < myCurrTokenMax))
-					{
-						if (arrayInProcess)
-						{
-							strcpy(myCurrTokenList[tokenIdx].valueString, myKeywordString);
-						}
-						else
-						{
-							strcpy(myCurrTokenList[tokenIdx].keyword, myKeywordString);
-						}
-					}
-					else if ((myCurrTokenList != NULL) && (tokenIdx >= myCurrTokenMax))
+					if (arrayInProcess)
 					{
-						returnCode	=	SJP_ExceededTokenCnt;
+						myCurrTokenList[tokenIdx].valueString	=	myKeywordString;
 					}
 					else
 					{
-						CONSOLE_DEBUG("No data block found yet");
+						myCurrTokenList[tokenIdx].keyword		=	myKeywordString;
 					}
 
-
 					CONSOLE_DEBUG_W_STR("Token\t\t=", myKeywordString);
-//					CONSOLE_DEBUG_W_STR("Next str\t=", myJsonDataPtr);
+					newBlockFlag	=	true;
 					if (strcmp(myKeywordString, "HDR") == 0)
 					{
-						myCurrDataBlock	=	kDataBlock_Header;
-						headerFound		=	true;
-						myCurrTokenList	=	theParser->headerList;
-						myCurrTokenMax	=	kSJP_MaxTokens_Hdr;
-						tokenIdx		=	0;
-						strcpy(myCurrTokenList[tokenIdx].keyword, myKeywordString);
+						myCurrDataBlock		=	kDataBlock_Header;
+						headerFound			=	true;
+						myCurrTokenListPtr	=	&theParser->headerList;
+						myCurrTokenMaxPtr	=	&theParser->tokenMax_Hdr;
 					}
 					else if (strcmp(myKeywordString, "DATA") == 0)
 					{
-						myCurrDataBlock	=	kDataBlock_Data;
-						myCurrTokenList	=	theParser->dataList;
-						myCurrTokenMax	=	kSJP_MaxTokens_Data;
-						tokenIdx		=	0;
-						strcpy(myCurrTokenList[tokenIdx].keyword, myKeywordString);
+						myCurrDataBlock		=	kDataBlock_Data;
+						myCurrTokenListPtr	=	&theParser->dataList;
+						myCurrTokenMaxPtr	=	&theParser->tokenMax_Data;
 					}
 					else if (strcmp(myKeywordString, "ERROR") == 0)
 					{
-						myCurrDataBlock	=	kDataBlock_Errors;
-						myCurrTokenList	=	theParser->errorList;
-						myCurrTokenMax	=	kSJP_MaxTokens_Errs;
-						tokenIdx		=	0;
-						strcpy(myCurrTokenList[tokenIdx].keyword, myKeywordString);
+						myCurrDataBlock		=	kDataBlock_Errors;
+						myCurrTokenListPtr	=	&theParser->errorList;
+						myCurrTokenMaxPtr	=	&theParser->tokenMax_Errs;
 					}
 					else
 					{
+						newBlockFlag	=	false;
 						CONSOLE_DEBUG_W_STR("myKeywordString\t=",	myKeywordString);
 						CONSOLE_DEBUG_W_STR("myValueString\t=",		myValueString);
 					}
+					if (newBlockFlag)
+					{
+						tokenIdx	=	0;
+						if (SJP_Private_GrowTokenList(myCurrTokenListPtr, myCurrTokenMaxPtr, (tokenIdx + 3)))
+						{
+							myCurrTokenList						=	*myCurrTokenListPtr;
+							myCurrTokenList[tokenIdx].keyword	=	myKeywordString;
+						}
+						else
+						{
+							returnCode	=	SJP_ExceededTokenCnt;
+						}
+					}
 					break;
 
 				case ':':
 					myJsonDataPtr++;
 					arrayInProcess	=	false;
-					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, myValueString, kSJP_MaxValueLen);
+					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, &myValueString, kSJP_MaxValueLen, &parseState);
 				#ifdef _DEBUG_PARSER_
 					CONSOLE_DEBUG_W_STR("myKeywordString\t=",	myKeywordString);
 					CONSOLE_DEBUG_W_STR("myValueString\t=",		myValueString);
-				//	CONSOLE_DEBUG_W_STR("myJsonDataPtr\t=",		myJsonDataPtr);
 				#endif
-					if ((myCurrTokenList != NULL) && (tokenIdx < myCurrTokenMax))
-					{
-						strcpy(myCurrTokenList[tokenIdx].keyword,		myKeywordString);
-						strcpy(myCurrTokenList[tokenIdx].valueString,	myValueString);
+					myCurrTokenList[tokenIdx].keyword		=	myKeywordString;
+					myCurrTokenList[tokenIdx].valueString	=	myValueString;
 
-						if ((strlen(myCurrTokenList[tokenIdx].keyword) > 0) || (strlen(myCurrTokenList[tokenIdx].valueString) > 0))
-						{
-						#ifdef _DEBUG_PARSER_
-							sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
-							CONSOLE_DEBUG(debugString);
-						#endif
-							tokenIdx++;
-						}
-					}
-					else if ((myCurrTokenList != NULL) && (tokenIdx >= myCurrTokenMax))
+					if (TOKEN_NOT_EMPTY(myCurrTokenList[tokenIdx]))
 					{
-						returnCode	=	SJP_ExceededTokenCnt;
-					}
-				#ifdef _DEBUG_PARSER_
-					CONSOLE_DEBUG_W_STR("myValueString\t=", myValueString);
-				#endif
-					//*	this checks to see if there is a block for the value of a token
-					if (strcmp(myValueString, "{") == 0)
-					{
-						//*	back up one so that the argument gets parsed on the next round through
-						myJsonDataPtr--;
+					#ifdef _DEBUG_PARSER_
+						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
+						CONSOLE_DEBUG(debugString);
+					#endif
+						tokenIdx++;
 					}
 					break;
 
@@ -538,7 +670,7 @@ bool		masterArrayFlag;
 
 					masterArrayFlag	=	true;
 					arrayInProcess	=	true;
-					if ((strlen(myCurrTokenList[tokenIdx].keyword) > 0) || (strlen(myCurrTokenList[tokenIdx].valueString) > 0))
+					if (TOKEN_NOT_EMPTY(myCurrTokenList[tokenIdx]))
 					{
 					#ifdef _DEBUG_PARSER_
 						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
@@ -547,47 +679,18 @@ bool		masterArrayFlag;
 						tokenIdx++;
 					}
 
-					if ((myCurrTokenList != NULL) && (tokenIdx < myCurrTokenMax))
-					{
-						strcpy(myCurrTokenList[tokenIdx].keyword, "ARRAY");
-					}
-					else if ((myCurrTokenList != NULL) && (tokenIdx >= myCurrTokenMax))
-					{
-						returnCode	=	SJP_ExceededTokenCnt;
-					}
-					if ((strlen(myCurrTokenList[tokenIdx].keyword) > 0) || (strlen(myCurrTokenList[tokenIdx].valueString) > 0))
-					{
-					#ifdef _DEBUG_PARSER_
-						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
-						CONSOLE_DEBUG(debugString);
-					#endif
-						tokenIdx++;
-					}
+					myCurrTokenList[tokenIdx].keyword	=	gSJP_ArrayString;
+					tokenIdx++;
 
-					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, myKeywordString, kSJP_MaxValueLen);
+					myJsonDataPtr	=	SJP_Private_GetString(myJsonDataPtr, &myKeywordString, kSJP_MaxValueLen, &parseState);
 					ToUpperStr(myKeywordString);
 
-
-					if ((myCurrTokenList != NULL) && (tokenIdx < myCurrTokenMax))
-					{
-						CONSOLE_DEBUG_W_STR("myKeywordString\t=", myKeywordString);
-						if (arrayInProcess)
-						{
-							strcpy(myCurrTokenList[tokenIdx].valueString, myKeywordString);
-						}
-						else
-						{
-							strcpy(myCurrTokenList[tokenIdx].keyword, myKeywordString);
-						}
-					#ifdef _DEBUG_ARRAY_
-						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
-						CONSOLE_DEBUG(debugString);
-					#endif
-					}
-					else if ((myCurrTokenList != NULL) && (tokenIdx >= myCurrTokenMax))
-					{
-						returnCode	=	SJP_ExceededTokenCnt;
-					}
+					CONSOLE_DEBUG_W_STR("myKeywordString\t=", myKeywordString);
+					myCurrTokenList[tokenIdx].valueString	=	myKeywordString;
+				#ifdef _DEBUG_ARRAY_
+					sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
+					CONSOLE_DEBUG(debugString);
+				#endif
 					break;
 
 
@@ -597,32 +700,29 @@ bool		masterArrayFlag;
 					masterArrayFlag	=	false;
 					myJsonDataPtr++;
 
-					if ((myCurrTokenList != NULL) && (tokenIdx < myCurrTokenMax))
+				#ifdef _DEBUG_ARRAY_
+					CONSOLE_DEBUG("end of array");
+					CONSOLE_DEBUG_W_STR("myCurrTokenList[tokenIdx].keyword", myCurrTokenList[tokenIdx].keyword);
+					CONSOLE_DEBUG_W_STR("myCurrTokenList[tokenIdx].valueString", myCurrTokenList[tokenIdx].valueString);
+				#endif
+					if (myCurrTokenList[tokenIdx].valueString[0] != 0)
 					{
-					#ifdef _DEBUG_ARRAY_
-						CONSOLE_DEBUG("end of array");
-						CONSOLE_DEBUG_W_STR("myCurrTokenList[tokenIdx].keyword", myCurrTokenList[tokenIdx].keyword);
-						CONSOLE_DEBUG_W_STR("myCurrTokenList[tokenIdx].valueString", myCurrTokenList[tokenIdx].valueString);
-					#endif
-						if (strlen(myCurrTokenList[tokenIdx].valueString) > 0)
-						{
-							tokenIdx++;
-						}
-						strcpy(myCurrTokenList[tokenIdx].keyword, "]");
-					#ifdef _DEBUG_PARSER_
-						sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
-						CONSOLE_DEBUG(debugString);
-					#endif
 						tokenIdx++;
 					}
+					myCurrTokenList[tokenIdx].keyword	=	gSJP_ArrayEndString;
+				#ifdef _DEBUG_PARSER_
+					sprintf(debugString, "New entry: kw=%-10s\tval=%s", myCurrTokenList[tokenIdx].keyword, myCurrTokenList[tokenIdx].valueString);
+					CONSOLE_DEBUG(debugString);
+				#endif
+					tokenIdx++;
 					break;
 
 				case '}':
 					myJsonDataPtr++;
 					if (masterArrayFlag)
 					{
-						strcpy(myCurrTokenList[tokenIdx].keyword, "ARRAY-NEXT");
-						strcpy(myCurrTokenList[tokenIdx].valueString, "");
+						myCurrTokenList[tokenIdx].keyword		=	gSJP_ArrayNextString;
+						myCurrTokenList[tokenIdx].valueString	=	gSJP_EmptyString;
 						tokenIdx++;
 					}
 					break;
@@ -657,6 +757,11 @@ bool		masterArrayFlag;
 			}
 		}
 
+		//*	the hash values make the keyword lookups cheaper
+		SJP_Private_HashTokenList(theParser->headerList,	theParser->tokenCount_Hdr);
+		SJP_Private_HashTokenList(theParser->dataList,		theParser->tokenCount_Data);
+		SJP_Private_HashTokenList(theParser->errorList,		theParser->tokenCount_Errs);
+
 		//*	skytravel does not use the HDR value
 		//*	did we fine a header?
 		if (headerFound == false)
@@ -715,6 +820,14 @@ char	myLowerCaseKeyWord[kSJP_MaxKeyLen + 1];
 
 }
 
+//**************************************************************************************
+static unsigned int	SJP_Private_UpperCaseKeyword(const char *keyWord, char *upperCaseKeword)
+{
+	strncpy(upperCaseKeword, keyWord, (kSJP_MaxKeyLen - 1));
+	upperCaseKeword[kSJP_MaxKeyLen - 1]	=	0;
+	ToUpperStr(upperCaseKeword);
+	return(SJP_Private_HashKeyword(upperCaseKeword));
+}
 
 //**************************************************************************************
 bool	SJP_FindKeyWordString(	const char	*keyWord,
@@ -722,22 +835,20 @@ bool	SJP_FindKeyWordString(	const char	*keyWord,
 								const short	tokenCnt,
 								char		*valueString)
 {
-bool	foundIt;
-short	ii;
-char	upperCaseKeword[kSJP_MaxKeyLen];
-
+bool			foundIt;
+short			ii;
+char			upperCaseKeword[kSJP_MaxKeyLen];
+unsigned int	keyHash;
 
 	foundIt	=	false;
 	if ((keyWord != NULL) && (tokenList != NULL))
 	{
-		strncpy(upperCaseKeword, keyWord, (kSJP_MaxKeyLen - 1));
-		upperCaseKeword[kSJP_MaxKeyLen - 1]	=	0;
-		ToUpperStr(upperCaseKeword);
+		keyHash	=	SJP_Private_UpperCaseKeyword(keyWord, upperCaseKeword);
 
 		ii	=	0;
 		while ((ii < tokenCnt) && (foundIt == false))
 		{
-			if (strcmp(upperCaseKeword, tokenList[ii].keyword) == 0)
+			if ((tokenList[ii].keyHash == keyHash) && (strcmp(upperCaseKeword, tokenList[ii].keyword) == 0))
 			{
 				strcpy(valueString, tokenList[ii].valueString);
 				foundIt	=	true;
@@ -748,10 +859,229 @@ char	upperCaseKeword[kSJP_MaxKeyLen];
 	return(foundIt);
 }
 
+//**************************************************************************************
+//*	open addressing table of token indexes, sized to keep it at most half full
+//*	only the first occurrence of a keyword gets entered
+//**************************************************************************************
+static bool	SJP_Private_BuildHashTable(SJP_Parser_t *theParser)
+{
+int		tableSize;
+int		*newTable;
+int		tknIdx;
+int		slotIdx;
+bool	duplicate;
+
+	tableSize	=	64;
+	while (tableSize < (theParser->tokenCount_Data * 2))
+	{
+		tableSize	=	tableSize * 2;
+	}
+	if (tableSize > theParser->dataHashSize)
+	{
+		newTable	=	(int *)realloc(theParser->dataHashTable, (tableSize * sizeof(int)));
+		if (newTable != NULL)
+		{
+			theParser->dataHashTable	=	newTable;
+			theParser->dataHashSize		=	tableSize;
+		}
+	}
+	if ((theParser->dataHashTable != NULL) && (theParser->dataHashSize >= tableSize))
+	{
+		tableSize	=	theParser->dataHashSize;
+		memset(theParser->dataHashTable, 0xff, (tableSize * sizeof(int)));	//*	all -1
+		for (tknIdx=0; tknIdx < theParser->tokenCount_Data; tknIdx++)
+		{
+			slotIdx		=	theParser->dataList[tknIdx].keyHash & (tableSize - 1);
+			duplicate	=	false;
+			while ((theParser->dataHashTable[slotIdx] >= 0) && (duplicate == false))
+			{
+				duplicate	=	(strcmp(theParser->dataList[theParser->dataHashTable[slotIdx]].keyword,
+										theParser->dataList[tknIdx].keyword) == 0);
+				slotIdx		=	(slotIdx + 1) & (tableSize - 1);
+			}
+			if (duplicate == false)
+			{
+				theParser->dataHashTable[slotIdx]	=	tknIdx;
+			}
+		}
+		theParser->dataHashValid	=	true;
+	}
+	return(theParser->dataHashValid);
+}
+
+//**************************************************************************************
+//*	returns the index into dataList or -1 if not found
+//*	the keyword is not case sensitive
+//**************************************************************************************
+int	SJP_FindKeyWordIndex(SJP_Parser_t *theParser, const char *keyWord)
+{
+int				tokenIndex;
+int				slotIdx;
+int				tknIdx;
+char			upperCaseKeword[kSJP_MaxKeyLen];
+unsigned int	keyHash;
+
+	tokenIndex	=	-1;
+	if ((theParser != NULL) && (keyWord != NULL) && (theParser->tokenCount_Data > 0))
+	{
+		keyHash	=	SJP_Private_UpperCaseKeyword(keyWord, upperCaseKeword);
+		if (theParser->dataHashValid || SJP_Private_BuildHashTable(theParser))
+		{
+			slotIdx	=	keyHash & (theParser->dataHashSize - 1);
+			while ((tokenIndex < 0) && (theParser->dataHashTable[slotIdx] >= 0))
+			{
+				tknIdx	=	theParser->dataHashTable[slotIdx];
+				if ((theParser->dataList[tknIdx].keyHash == keyHash) &&
+					(strcmp(theParser->dataList[tknIdx].keyword, upperCaseKeword) == 0))
+				{
+					tokenIndex	=	tknIdx;
+				}
+				slotIdx	=	(slotIdx + 1) & (theParser->dataHashSize - 1);
+			}
+		}
+		else
+		{
+			//*	could not get memory for the table, do it the slow way
+			for (tknIdx=0; (tknIdx < theParser->tokenCount_Data) && (tokenIndex < 0); tknIdx++)
+			{
+				if ((theParser->dataList[tknIdx].keyHash == keyHash) &&
+					(strcmp(theParser->dataList[tknIdx].keyword, upperCaseKeword) == 0))
+				{
+					tokenIndex	=	tknIdx;
+				}
+			}
+		}
+	}
+	return(tokenIndex);
+}
+
+//**************************************************************************************
+//*	returns NULL if not found
+//**************************************************************************************
+const char	*SJP_GetValueString(SJP_Parser_t *theParser, const char *keyWord)
+{
+int			tokenIndex;
+const char	*valueString;
+
+	valueString	=	NULL;
+	tokenIndex	=	SJP_FindKeyWordIndex(theParser, keyWord);
+	if (tokenIndex >= 0)
+	{
+		valueString	=	theParser->dataList[tokenIndex].valueString;
+	}
+	return(valueString);
+}
+
+//**************************************************************************************
+//*	the conversion is only done the first time, the result is kept in the token
+//**************************************************************************************
+bool	SJP_GetTokenDouble(SJP_token_t *theToken, double *returnValue)
+{
+char	*endPtr;
+
+	if (theToken->numberState == 0)
+	{
+		theToken->numberState	=	-1;
+		if (theToken->valueString[0] != 0)
+		{
+			theToken->numberValue	=	strtod(theToken->valueString, &endPtr);
+			if ((endPtr != theToken->valueString) && (*endPtr == 0))
+			{
+				theToken->numberState	=	1;
+			}
+		}
+	}
+	if (theToken->numberState > 0)
+	{
+		*returnValue	=	theToken->numberValue;
+	}
+	return(theToken->numberState > 0);
+}
+
+//**************************************************************************************
+bool	SJP_GetDouble(SJP_Parser_t *theParser, const char *keyWord, double *returnValue)
+{
+int		tokenIndex;
+bool	validFlag;
+
+	validFlag	=	false;
+	tokenIndex	=	SJP_FindKeyWordIndex(theParser, keyWord);
+	if (tokenIndex >= 0)
+	{
+		validFlag	=	SJP_GetTokenDouble(&theParser->dataList[tokenIndex], returnValue);
+	}
+	return(validFlag);
+}
+
+//**************************************************************************************
+bool	SJP_GetLong(SJP_Parser_t *theParser, const char *keyWord, long *returnValue)
+{
+double	doubleValue;
+bool	validFlag;
+
+	validFlag	=	SJP_GetDouble(theParser, keyWord, &doubleValue);
+	if (validFlag)
+	{
+		*returnValue	=	(long)doubleValue;
+	}
+	return(validFlag);
+}
+
+//**************************************************************************************
+bool	SJP_GetBool(SJP_Parser_t *theParser, const char *keyWord, bool *returnValue)
+{
+const char	*valueString;
+bool		validFlag;
+
+	validFlag	=	false;
+	valueString	=	SJP_GetValueString(theParser, keyWord);
+	if (valueString != NULL)
+	{
+		if (strcasecmp(valueString, "true") == 0)
+		{
+			*returnValue	=	true;
+			validFlag		=	true;
+		}
+		else if (strcasecmp(valueString, "false") == 0)
+		{
+			*returnValue	=	false;
+			validFlag		=	true;
+		}
+	}
+	return(validFlag);
+}
+
+//**************************************************************************************
+//*	adds a token to the end of the data list
+//*	the strings are NOT copied, they must stay valid as long as the parser data is used
+//**************************************************************************************
+bool	SJP_AddToken(SJP_Parser_t *theParser, const char *keyword, const char *valueString)
+{
+bool		validFlag;
+SJP_token_t	*theToken;
+
+	validFlag	=	false;
+	if ((theParser != NULL) && (keyword != NULL) && (valueString != NULL))
+	{
+		validFlag	=	SJP_Private_GrowTokenList(&theParser->dataList, &theParser->tokenMax_Data, (theParser->tokenCount_Data + 1));
+		if (validFlag)
+		{
+			theToken				=	&theParser->dataList[theParser->tokenCount_Data];
+			theToken->keyword		=	(char *)keyword;
+			theToken->valueString	=	(char *)valueString;
+			theToken->keyHash		=	SJP_Private_HashKeyword(keyword);
+			theToken->numberState	=	0;
+			theParser->tokenCount_Data++;
+			theParser->dataHashValid	=	false;
+		}
+	}
+	return(validFlag);
+}
+
 //**************************************************************************************
 void	SJP_DumpJsonData(SJP_Parser_t *theParser, const char *callingFunctionName)
 {
-short		ii;
+int		ii;
 
 	if (theParser != NULL)
 	{
@@ -759,7 +1089,7 @@ short		ii;
 		printf("Dumping JSON parser data, called from %s\r\n", callingFunctionName);
 		for (ii=0; ii<theParser->tokenCount_Data; ii++)
 		{
-			if ((strlen(theParser->dataList[ii].keyword) > 0) || (strlen(theParser->dataList[ii].valueString) > 0))
+			if ((theParser->dataList[ii].keyword[0] != 0) || (theParser->dataList[ii].valueString[0] != 0))
 			{
 				printf("%2d=%-20s\t%-20s\t\r\n",	ii,	theParser->dataList[ii].keyword,
 														theParser->dataList[ii].valueString);
@@ -789,6 +1119,7 @@ int				ii;
 		byteCount	=	fread(fileBuffer, 1, 9000, inputFilePointer);
 		if (byteCount> 0)
 		{
+			fileBuffer[byteCount]	=	0;
 			SJP_ParseData(&jsonParser, fileBuffer);
 		}
 		else
@@ -819,6 +1150,8 @@ int				ii;
 	printf("tokenCount_Hdr=%d\r\n",		jsonParser.tokenCount_Hdr);
 	printf("tokenCount_Data=%d\r\n",	jsonParser.tokenCount_Data);
 
+	SJP_Release(&jsonParser);
+
 }
 
 
@@ -7,6 +7,8 @@
 //*
 //*****************************************************************************
 //*	Oct 16,	2019	<MLS> Changed some int's to short's to save memory
+//*	Oct 18,	2026	<AGT> Tokens are now pointers into an in place tokenized copy of the text
+//*	Oct 18,	2026	<AGT> Removed the token count limits, added hashed lookup
 //*****************************************************************************
 //#include	"json_parse.h"
 
@@ -23,19 +25,20 @@
 #endif
 
 
-#define	kJSONparse_Ver_String		"JSONparse V1.0.0"
-#define	kJSONparse_Ver_NumberString	"1.0.0"
-#define	kJSONparse_Ver_long			100
+#define	kJSONparse_Ver_String		"JSONparse V2.0.0"
+#define	kJSONparse_Ver_NumberString	"2.0.0"
+#define	kJSONparse_Ver_long			200
 
 
+//*	keywords and values are still limited to these lengths so that callers
+//*	can continue to strcpy() them into fixed size buffers
 #define	kSJP_MaxKeyLen		64
 #define	kSJP_MaxValueLen	256
 
 
-//*	these number can be adjusted as needed
-#define	kSJP_MaxTokens_Hdr	15
-#define	kSJP_MaxTokens_Data	200
-#define	kSJP_MaxTokens_Errs	5
+//*	there is no limit on the number of tokens, the lists grow as needed
+//*	this is the initial allocation for each list
+#define	kSJP_InitialTokenCnt	64
 
 
 
@@ -47,34 +50,64 @@
 enum
 {
 	SJP_InvalidParameter	=	-100,
-	SJP_ExceededTokenCnt,
+	SJP_ExceededTokenCnt,			//*	now only returned if memory allocation fails
 	SJP_NoHeader,
 };
 
 //*****************************************************************************
 //*	token list
+//*	keyword and valueString point into the parser's own copy of the json text,
+//*	they are valid until the next SJP_ParseData() or SJP_Release()
+//*	they are NULL terminated and MUST be treated as read only
 typedef struct
 {
-	char	keyword[kSJP_MaxKeyLen];
-	char	valueString[kSJP_MaxValueLen];
+	char			*keyword;
+	char			*valueString;
+	unsigned int	keyHash;			//*	hash of the (upper case) keyword
+	short			numberState;		//*	lazy number conversion, 0=not done, 1=valid, -1=not a number
+	double			numberValue;
 
 } SJP_token_t;
 
+//*	SJP_Init() once before the parser is used (the C++ constructor does it),
+//*	SJP_Reset() to empty it and keep the buffers, SJP_Release() when done with it
+struct	SJP_Parser_t;
+void	SJP_Init(struct SJP_Parser_t *theParserDataStruct);
+void	SJP_Reset(struct SJP_Parser_t *theParserDataStruct);
+void	SJP_Release(struct SJP_Parser_t *theParserDataStruct);
 
 //*****************************************************************************
 //*	parser data structure, so that we don't have to use globals
-typedef struct
+typedef struct SJP_Parser_t
 {
-	SJP_token_t		headerList[kSJP_MaxTokens_Hdr];
-	short			tokenCount_Hdr;
+	SJP_token_t		*headerList;
+	int				tokenCount_Hdr;
+	int				tokenMax_Hdr;
 
-	SJP_token_t		dataList[kSJP_MaxTokens_Data];
-	short			tokenCount_Data;
+	SJP_token_t		*dataList;
+	int				tokenCount_Data;
+	int				tokenMax_Data;
 
+	SJP_token_t		*errorList;
+	int				tokenCount_Errs;
+	int				tokenMax_Errs;
 
-	SJP_token_t		errorList[kSJP_MaxTokens_Errs];
-	short			tokenCount_Errs;
+	//*	private, the json text gets copied here once and is tokenized in place
+	char			*textBuffer;
+	int				textBufferSize;
 
+	//*	private, key index into dataList, built on the first keyword lookup
+	int				*dataHashTable;
+	int				dataHashSize;
+	bool			dataHashValid;
+
+#ifdef __cplusplus
+	//*	C++ gets automatic clean up, C code has to call SJP_Release()
+	SJP_Parser_t()									{	SJP_Init(this);		}
+	~SJP_Parser_t()									{	SJP_Release(this);	}
+	SJP_Parser_t(const SJP_Parser_t &)				=	delete;
+	SJP_Parser_t &operator=(const SJP_Parser_t &)	=	delete;
+#endif
 
 } SJP_Parser_t;
 
@@ -95,11 +128,21 @@ typedef struct
 
 
 //*	routines for parsing the data
-void	SJP_Init(SJP_Parser_t *theParserDataStruct);
 long	SJP_GetVersion(void);
 int		SJP_ParseData(SJP_Parser_t *theParser, const char  *jsonDataPtr);
 bool	SJP_FindKeyWordString(const char *keyWord, SJP_token_t *tokenList, const short tokenCnt, char *valueString);
 void	SJP_DumpJsonData(SJP_Parser_t *theParser, const char *callingFunctionName);
+bool	SJP_AddToken(SJP_Parser_t *theParser, const char *keyword, const char *valueString);
+
+//*	hashed lookup in the data list, returns the token index or -1
+int		SJP_FindKeyWordIndex(SJP_Parser_t *theParser, const char *keyWord);
+const char	*SJP_GetValueString(SJP_Parser_t *theParser, const char *keyWord);
+
+//*	numbers are converted on first use and remembered in the token
+bool	SJP_GetTokenDouble(SJP_token_t *theToken, double *returnValue);
+bool	SJP_GetDouble(SJP_Parser_t *theParser, const char *keyWord, double *returnValue);
+bool	SJP_GetLong(SJP_Parser_t *theParser, const char *keyWord, long *returnValue);
+bool	SJP_GetBool(SJP_Parser_t *theParser, const char *keyWord, bool *returnValue);
 
 
 //*	routines for processing the data
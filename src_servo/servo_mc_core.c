@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr  5,	2022	<RNS> Created initial version from LM62x_comm.c
 //*	Apr  6,	2022	<RNS> Started on the endian stuff needed for Roboclaw
@@ -38,6 +39,9 @@
 //*	May 31,	2022	<RNS> Removed the old hand coded RC messages and strings, obsolete
 //*	Jul  2,	2022	<RNS> Adding support for boolean types
 //*	Jul  3,	2022	<RNS> changed prefix on static global to gs*
+//*	Oct 18,	2026	<AGT> Added an I/O thread that owns the port, batches notes into one write
+//*	Oct 18,	2026	<AGT> Receipts are poll()ed straight into the callers buffer and CRC checked
+//*	Oct 18,	2026	<AGT> Added MC_wait_status() so waiters are woken by the I/O thread
 //*****************************************************************************
 
 #include <stdio.h>
@@ -50,6 +54,9 @@
 #include <stdbool.h>
 #include <endian.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <pthread.h>
 #include "servo_std_defs.h"
 #include "servo_mc_core.h"
 
@@ -72,10 +79,47 @@
 
 #define kMAX_RETRY 3
 
+#define kMC_MAX_BATCHES		8	// callers that can be queued on the I/O thread at once
+#define kMC_MAX_WAITERS		8
+#define kMC_MAX_CHUNK		16	// notes sent in one write()
+
+// A callers set of xfers, done is set by the I/O thread
+typedef struct
+{
+	TYPE_MC_XFER	*xfers;
+	int				count;
+	bool			done;
+} TYPE_MC_BATCH;
+
+// A caller sleeping in MC_wait_status()
+typedef struct
+{
+	uint8_t			*txBuf;
+	size_t			txLen;
+	size_t			rxLen;
+	MC_STATUS_PROC	statusProc;
+	void			*arg;
+	long			deadline_ms;
+	bool			done;
+	int				status;
+} TYPE_MC_WAITER;
+
 // Internal global variables visibel for this file only
 static int gsCommPort;
 static int gsCommRetries;
 
+// I/O thread globals, everything below gsIOMutex is protected by it
+static pthread_t		gsIOThread;
+static int				gsWakePipe[2]	=	{-1, -1};
+static pthread_mutex_t	gsIOMutex		=	PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	gsIODoneCond	=	PTHREAD_COND_INITIALIZER;
+static bool				gsIOThreadRunning	=	false;
+static TYPE_MC_BATCH	*gsBatchQueue[kMC_MAX_BATCHES];
+static int				gsBatchCnt		=	0;
+static TYPE_MC_WAITER	*gsWaiters[kMC_MAX_WAITERS];
+static int				gsWaiterCnt		=	0;
+static bool				gsStatusPollDue	=	false;
+
 //*****************************************************************************
 // Resets to the top of buffer, and add MC target/cmd and updates rover
 //*****************************************************************************
@@ -368,9 +412,498 @@ int MC_write_comm(uint8_t *buf, size_t len)
 	return(returnCode);
 } // of MC_write_comm()
 
+//**********************************************************************
+// Monotonic milliseconds for the I/O thread time outs
+//**********************************************************************
+static long MC_get_millisecs(void)
+{
+struct timespec	timeNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &timeNow);
+	return((timeNow.tv_sec * 1000) + (timeNow.tv_nsec / 1000000));
+}
+
+//**********************************************************************
+// Wakes up the I/O thread, the pipe is drained by the thread
+//**********************************************************************
+static void MC_wake_io_thread(void)
+{
+ssize_t	count;
+
+	count	=	write(gsWakePipe[1], "w", 1);
+	if (count < 0)
+	{
+		perror("Error in MC_wake_io_thread: ");
+	}
+}
+
+//**********************************************************************
+// Writes the entire buffer, returns kERROR if the port fails
+//**********************************************************************
+static int MC_write_all(uint8_t *buf, size_t len)
+{
+ssize_t	count;
+size_t	total	=	0;
+
+	while (total < len)
+	{
+		count	=	write(gsCommPort, buf + total, len - total);
+		if (count <= 0)
+		{
+			perror("Error in MC_write_all: ");
+			return(kERROR);
+		}
+		total	+=	count;
+	}
+	return(kSTATUS_OK);
+} // of MC_write_all()
+
+//**********************************************************************
+// Reads exactly xfer->rxLen bytes directly into xfer->rxBuf, the receipt
+// length is known from the note so nothing is staged or copied.
+// Returns kERROR if the receipt did not arrive before the time out
+//**********************************************************************
+static int MC_read_receipt(TYPE_MC_XFER *xfer)
+{
+struct pollfd	pollFd;
+ssize_t			count;
+size_t			total	=	0;
+long			deadline_ms;
+int				wait_ms;
+
+	deadline_ms	=	MC_get_millisecs() + kMC_RESPONSE_TIMEOUT_ms;
+	while (total < xfer->rxLen)
+	{
+		wait_ms	=	deadline_ms - MC_get_millisecs();
+		if (wait_ms <= 0)
+		{
+			printf("MC_read_receipt: timed out, len = %d  got = %d\n", (int)xfer->rxLen, (int)total);
+			return(kERROR);
+		}
+		pollFd.fd		=	gsCommPort;
+		pollFd.events	=	POLLIN;
+		pollFd.revents	=	0;
+		if (poll(&pollFd, 1, wait_ms) > 0)
+		{
+			count	=	read(gsCommPort, xfer->rxBuf + total, xfer->rxLen - total);
+			if (count < 0)
+			{
+				perror("Error in MC_read_receipt: ");
+				return(kERROR);
+			}
+			total	+=	count;
+		}
+	}
+	return(kSTATUS_OK);
+} // of MC_read_receipt()
+
+//**********************************************************************
+// Checks the trailing CRC16 of a receipt in place, the CRC covers the
+// addr and cmd from the note followed by the receipt data
+//**********************************************************************
+static bool MC_receipt_crc_ok(TYPE_MC_XFER *xfer)
+{
+uint16_t	crc;
+uint16_t	receiptCrc;
+size_t		dataLen;
+
+	if ((xfer->txLen < 2) || (xfer->rxLen < 3))
+	{
+		return(false);
+	}
+	dataLen		=	xfer->rxLen - 2;
+	crc			=	MC_calc_crc16(xfer->txBuf, 2, kCLEAR_CRC);
+	crc			=	MC_calc_crc16(xfer->rxBuf, dataLen, crc);
+	receiptCrc	=	(xfer->rxBuf[dataLen] << 8) | xfer->rxBuf[dataLen + 1];
+	return(receiptCrc == crc);
+}
+
+//**********************************************************************
+// Hands a good receipt to every waiter that is waiting on the same note,
+// so a status read by anybody also serves the MC_wait_status() callers
+//**********************************************************************
+static void MC_notify_waiters(TYPE_MC_XFER *xfer)
+{
+TYPE_MC_WAITER	*waiter;
+bool			wakeUp	=	false;
+int				iii;
+
+	pthread_mutex_lock(&gsIOMutex);
+	for (iii = 0; iii < gsWaiterCnt; iii++)
+	{
+		waiter	=	gsWaiters[iii];
+		if ((waiter->done == false) &&
+			(waiter->txLen == xfer->txLen) &&
+			(waiter->rxLen == xfer->rxLen) &&
+			(memcmp(waiter->txBuf, xfer->txBuf, xfer->txLen) == 0) &&
+			waiter->statusProc(xfer->rxBuf, waiter->arg))
+		{
+			waiter->status	=	kSTATUS_OK;
+			waiter->done	=	true;
+			wakeUp			=	true;
+		}
+	}
+	if (wakeUp)
+	{
+		pthread_cond_broadcast(&gsIODoneCond);
+	}
+	pthread_mutex_unlock(&gsIOMutex);
+} // of MC_notify_waiters()
+
+//**********************************************************************
+// Sends the notes as a single write() and then reads the receipts in order.
+// If a receipt times out the rest can not be framed, so they all fail and
+// the input is flushed to get back in sync
+//**********************************************************************
+static void MC_transfer_chunk(TYPE_MC_XFER **xferList, int count)
+{
+uint8_t	txAll[kMAX_STR_LEN];
+size_t	txLen	=	0;
+int		status;
+int		iii;
+
+	for (iii = 0; iii < count; iii++)
+	{
+		memcpy(txAll + txLen, xferList[iii]->txBuf, xferList[iii]->txLen);
+		txLen	+=	xferList[iii]->txLen;
+	}
+	status	=	MC_write_all(txAll, txLen);
+
+	for (iii = 0; iii < count; iii++)
+	{
+		if (status == kSTATUS_OK)
+		{
+			status	=	MC_read_receipt(xferList[iii]);
+		}
+		xferList[iii]->status	=	status;
+		if ((status == kSTATUS_OK) && xferList[iii]->checkCrc && (MC_receipt_crc_ok(xferList[iii]) == false))
+		{
+			printf("MC_transfer_chunk: receipt CRC error, cmd = %d\n", xferList[iii]->txBuf[1]);
+			xferList[iii]->status	=	kERROR;
+		}
+		if (xferList[iii]->status == kSTATUS_OK)
+		{
+			MC_notify_waiters(xferList[iii]);
+		}
+	}
+	if (status != kSTATUS_OK)
+	{
+		tcflush(gsCommPort, TCIFLUSH);
+	}
+} // of MC_transfer_chunk()
+
+//**********************************************************************
+// Runs every xfer of the batches, packing as many notes into each write()
+// as will fit, then marks the batches done and wakes up the callers
+//**********************************************************************
+static void MC_run_batches(TYPE_MC_BATCH **batchList, int batchCnt)
+{
+TYPE_MC_XFER	*chunk[kMC_MAX_CHUNK];
+int				chunkCnt	=	0;
+size_t			chunkLen	=	0;
+TYPE_MC_XFER	*xfer;
+int				iii, jjj;
+
+	for (iii = 0; iii < batchCnt; iii++)
+	{
+		for (jjj = 0; jjj < batchList[iii]->count; jjj++)
+		{
+			xfer	=	&batchList[iii]->xfers[jjj];
+			if ((chunkCnt == kMC_MAX_CHUNK) || (chunkLen + xfer->txLen > kMAX_STR_LEN))
+			{
+				MC_transfer_chunk(chunk, chunkCnt);
+				chunkCnt	=	0;
+				chunkLen	=	0;
+			}
+			chunk[chunkCnt++]	=	xfer;
+			chunkLen			+=	xfer->txLen;
+		}
+	}
+	if (chunkCnt > 0)
+	{
+		MC_transfer_chunk(chunk, chunkCnt);
+	}
+
+	pthread_mutex_lock(&gsIOMutex);
+	for (iii = 0; iii < batchCnt; iii++)
+	{
+		batchList[iii]->done	=	true;
+	}
+	pthread_cond_broadcast(&gsIODoneCond);
+	pthread_mutex_unlock(&gsIOMutex);
+} // of MC_run_batches()
+
+//**********************************************************************
+// Reads the status once for each different note the waiters are using,
+// MC_transfer_chunk() hands the receipt to the waiters
+//**********************************************************************
+static void MC_poll_waiters(void)
+{
+uint8_t			noteBufs[kMC_MAX_WAITERS][kSMALL_STR_LEN];
+uint8_t			receiptBufs[kMC_MAX_WAITERS][kSMALL_STR_LEN];
+TYPE_MC_XFER	xfers[kMC_MAX_WAITERS];
+TYPE_MC_XFER	*xferPtr;
+TYPE_MC_WAITER	*waiter;
+int				noteCnt	=	0;
+bool			found;
+int				iii, jjj;
+
+	pthread_mutex_lock(&gsIOMutex);
+	for (iii = 0; iii < gsWaiterCnt; iii++)
+	{
+		waiter	=	gsWaiters[iii];
+		found	=	waiter->done;
+		for (jjj = 0; (jjj < noteCnt) && (found == false); jjj++)
+		{
+			found	=	(xfers[jjj].txLen == waiter->txLen) &&
+						(xfers[jjj].rxLen == waiter->rxLen) &&
+						(memcmp(noteBufs[jjj], waiter->txBuf, waiter->txLen) == 0);
+		}
+		if (found == false)
+		{
+			memcpy(noteBufs[noteCnt], waiter->txBuf, waiter->txLen);
+			xfers[noteCnt].txBuf	=	noteBufs[noteCnt];
+			xfers[noteCnt].txLen	=	waiter->txLen;
+			xfers[noteCnt].rxBuf	=	receiptBufs[noteCnt];
+			xfers[noteCnt].rxLen	=	waiter->rxLen;
+			xfers[noteCnt].checkCrc	=	true;
+			noteCnt++;
+		}
+	}
+	pthread_mutex_unlock(&gsIOMutex);
+
+	for (iii = 0; iii < noteCnt; iii++)
+	{
+		xferPtr	=	&xfers[iii];
+		MC_transfer_chunk(&xferPtr, 1);
+	}
+} // of MC_poll_waiters()
+
+//**********************************************************************
+// Fails the waiters that are past their time out, or all of them if the
+// thread is stopping
+//**********************************************************************
+static void MC_expire_waiters(bool expireAll)
+{
+TYPE_MC_WAITER	*waiter;
+bool			wakeUp	=	false;
+long			now_ms;
+int				iii;
+
+	now_ms	=	MC_get_millisecs();
+	pthread_mutex_lock(&gsIOMutex);
+	for (iii = 0; iii < gsWaiterCnt; iii++)
+	{
+		waiter	=	gsWaiters[iii];
+		if ((waiter->done == false) && (expireAll || (now_ms >= waiter->deadline_ms)))
+		{
+			waiter->status	=	kERROR;
+			waiter->done	=	true;
+			wakeUp			=	true;
+		}
+	}
+	if (wakeUp)
+	{
+		pthread_cond_broadcast(&gsIODoneCond);
+	}
+	pthread_mutex_unlock(&gsIOMutex);
+} // of MC_expire_waiters()
+
+//**********************************************************************
+// The I/O thread owns the comm port. It sleeps on the wake up pipe until a
+// batch is queued, or for the status poll interval while there are waiters.
+//**********************************************************************
+static void *MC_io_thread(void *arg)
+{
+struct pollfd	pollFd;
+TYPE_MC_BATCH	*batchList[kMC_MAX_BATCHES];
+uint8_t			drainBuf[32];
+ssize_t			count;
+int				batchCnt;
+int				timeout_ms;
+bool			keepRunning	=	true;
+bool			pollStatus;
+long			lastStatusPoll_ms	=	0;
+long			now_ms;
+
+	(void)arg;
+	while (keepRunning)
+	{
+		now_ms	=	MC_get_millisecs();
+		pthread_mutex_lock(&gsIOMutex);
+		if ((gsBatchCnt > 0) || gsStatusPollDue || (gsIOThreadRunning == false))
+		{
+			timeout_ms	=	0;
+		}
+		else if (gsWaiterCnt > 0)
+		{
+			timeout_ms	=	kMC_STATUS_POLL_ms - (now_ms - lastStatusPoll_ms);
+			timeout_ms	=	(timeout_ms < 0) ? 0 : timeout_ms;
+		}
+		else
+		{
+			timeout_ms	=	-1;
+		}
+		pthread_mutex_unlock(&gsIOMutex);
+
+		pollFd.fd		=	gsWakePipe[0];
+		pollFd.events	=	POLLIN;
+		pollFd.revents	=	0;
+		if (poll(&pollFd, 1, timeout_ms) > 0)
+		{
+			count	=	read(gsWakePipe[0], drainBuf, sizeof(drainBuf));
+			(void)count;
+		}
+
+		// Take everything that is queued, new callers can queue while we work
+		now_ms	=	MC_get_millisecs();
+		pthread_mutex_lock(&gsIOMutex);
+		keepRunning	=	gsIOThreadRunning;
+		batchCnt	=	gsBatchCnt;
+		memcpy(batchList, gsBatchQueue, batchCnt * sizeof(TYPE_MC_BATCH *));
+		gsBatchCnt	=	0;
+		pollStatus	=	(gsWaiterCnt > 0) && (gsStatusPollDue || ((now_ms - lastStatusPoll_ms) >= kMC_STATUS_POLL_ms));
+		gsStatusPollDue	=	false;
+		// Let callers blocked on a full queue back in
+		pthread_cond_broadcast(&gsIODoneCond);
+		pthread_mutex_unlock(&gsIOMutex);
+
+		if (batchCnt > 0)
+		{
+			MC_run_batches(batchList, batchCnt);
+		}
+		if (pollStatus && keepRunning)
+		{
+			MC_poll_waiters();
+			lastStatusPoll_ms	=	MC_get_millisecs();
+		}
+		MC_expire_waiters(keepRunning == false);
+	}
+	return(NULL);
+} // of MC_io_thread()
+
+//**********************************************************************
+// Queues a set of note/receipt xfers on the I/O thread and sleeps until
+// they are all done. Notes from the same or different callers that are
+// queued together go out in one write(). Returns kERROR if any xfer failed
+//**********************************************************************
+int MC_converse_batch(TYPE_MC_XFER *xfers, int count)
+{
+TYPE_MC_BATCH	batch;
+int				status;
+int				iii;
+
+	batch.xfers	=	xfers;
+	batch.count	=	count;
+	batch.done	=	false;
+	for (iii = 0; iii < count; iii++)
+	{
+		xfers[iii].status	=	kERROR;
+	}
+
+	pthread_mutex_lock(&gsIOMutex);
+	while (gsIOThreadRunning && (gsBatchCnt >= kMC_MAX_BATCHES))
+	{
+		pthread_cond_wait(&gsIODoneCond, &gsIOMutex);
+	}
+	if (gsIOThreadRunning == false)
+	{
+		pthread_mutex_unlock(&gsIOMutex);
+		CONSOLE_DEBUG("I/O thread is not running, MC_init_comm() not called?");
+		return(kERROR);
+	}
+	gsBatchQueue[gsBatchCnt++]	=	&batch;
+	MC_wake_io_thread();
+	while (batch.done == false)
+	{
+		pthread_cond_wait(&gsIODoneCond, &gsIOMutex);
+	}
+	pthread_mutex_unlock(&gsIOMutex);
+
+	status	=	kSTATUS_OK;
+	for (iii = 0; iii < count; iii++)
+	{
+		if (xfers[iii].status != kSTATUS_OK)
+		{
+			status	=	kERROR;
+		}
+	}
+	return(status);
+} // of MC_converse_batch()
+
+//**********************************************************************
+// Sends one note and reads its receipt through the I/O thread
+//**********************************************************************
+int MC_converse(uint8_t *txBuf, size_t txLen, uint8_t *rxBuf, size_t rxLen, bool checkCrc)
+{
+TYPE_MC_XFER	xfer;
+
+	xfer.txBuf		=	txBuf;
+	xfer.txLen		=	txLen;
+	xfer.rxBuf		=	rxBuf;
+	xfer.rxLen		=	rxLen;
+	xfer.checkCrc	=	checkCrc;
+	return(MC_converse_batch(&xfer, 1));
+} // of MC_converse()
+
+//**********************************************************************
+// Sleeps until statusProc() returns true for the receipt of the status note
+// or the time out expires. The I/O thread reads the status every
+// kMC_STATUS_POLL_ms for all the waiters at once and also checks any
+// matching receipt other callers get, the caller does no polling.
+// The receipt must end with a CRC16. Returns kERROR on time out
+//**********************************************************************
+int MC_wait_status(uint8_t *txBuf, size_t txLen, size_t rxLen, MC_STATUS_PROC statusProc, void *arg, int timeout_ms)
+{
+TYPE_MC_WAITER	waiter;
+int				iii;
+
+	if ((txLen > kSMALL_STR_LEN) || (rxLen > kSMALL_STR_LEN))
+	{
+		return(kERROR);
+	}
+	waiter.txBuf		=	txBuf;
+	waiter.txLen		=	txLen;
+	waiter.rxLen		=	rxLen;
+	waiter.statusProc	=	statusProc;
+	waiter.arg			=	arg;
+	waiter.deadline_ms	=	MC_get_millisecs() + timeout_ms;
+	waiter.done			=	false;
+	waiter.status		=	kERROR;
+
+	pthread_mutex_lock(&gsIOMutex);
+	if ((gsIOThreadRunning == false) || (gsWaiterCnt >= kMC_MAX_WAITERS))
+	{
+		pthread_mutex_unlock(&gsIOMutex);
+		CONSOLE_DEBUG("I/O thread not running or too many waiters");
+		return(kERROR);
+	}
+	gsWaiters[gsWaiterCnt++]	=	&waiter;
+	// Check right away, the condition may already be met
+	gsStatusPollDue				=	true;
+	MC_wake_io_thread();
+	while (waiter.done == false)
+	{
+		pthread_cond_wait(&gsIODoneCond, &gsIOMutex);
+	}
+	// Remove this waiter, keep the list packed
+	for (iii = 0; iii < gsWaiterCnt; iii++)
+	{
+		if (gsWaiters[iii] == &waiter)
+		{
+			gsWaiters[iii]	=	gsWaiters[gsWaiterCnt - 1];
+			gsWaiterCnt--;
+		}
+	}
+	pthread_mutex_unlock(&gsIOMutex);
+
+	return(waiter.status);
+} // of MC_wait_status()
+
 //**********************************************************************
 //  Open() the comm port, pause because it's likely a USB device and
 //  call attr function and returns kERROR if unsuccessful
+//  then starts the I/O thread that owns the port from now on
 // in[];   input data to be written
 // len;     length on input data
 //**********************************************************************
@@ -396,6 +929,22 @@ int MC_init_comm(char *pathName, int baud)
 	// set the globe SIO retires
 	gsCommRetries	=	kMAX_RETRY;
 
+	if ((status == kSTATUS_OK) && (gsIOThreadRunning == false))
+	{
+		if (pipe(gsWakePipe) != 0)
+		{
+			perror("Error in MC_init_comm: ");
+			return(kERROR);
+		}
+		gsIOThreadRunning	=	true;
+		if (pthread_create(&gsIOThread, NULL, MC_io_thread, NULL) != 0)
+		{
+			perror("Error in MC_init_comm: ");
+			gsIOThreadRunning	=	false;
+			status				=	kERROR;
+		}
+	}
+
 	return(status);
 } // of MC_init_comm()
 
@@ -405,9 +954,18 @@ int MC_init_comm(char *pathName, int baud)
 int MC_shutdown(void)
 {
 
-	// Add command stuff here when it exists
-	// Add command stuff here when it exists
-	// Add command stuff here when it exists
+	// Stop the I/O thread, it fails anybody still waiting
+	if (gsIOThreadRunning)
+	{
+		pthread_mutex_lock(&gsIOMutex);
+		gsIOThreadRunning	=	false;
+		MC_wake_io_thread();
+		pthread_cond_broadcast(&gsIODoneCond);
+		pthread_mutex_unlock(&gsIOMutex);
+		pthread_join(gsIOThread, NULL);
+		close(gsWakePipe[0]);
+		close(gsWakePipe[1]);
+	}
 
 	// release the port
 	close(gsCommPort);
@@ -20,16 +20,37 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //  Apr 12, 2022    <RNS> Initial creation via cproto
 //  Apr 20, 2022    <RNS> Cleaned up global variables declarations
 //  May 06, 2022    <RNS> renamed file to servo_mc_core.h and fixed #defines
+//  Oct 18, 2026    <AGT> Added the I/O thread xfer struct, MC_converse*() and MC_wait_status()
 //*****************************************************************************
 #ifndef _SERVO_MC_CORE_H_
 #define _SERVO_MC_CORE_H_
 
 #define kCLEAR_CRC 0
 
+#define kMC_RESPONSE_TIMEOUT_ms	100		// max time for one complete receipt
+#define kMC_STATUS_POLL_ms		5		// status poll interval while MC_wait_status() waiters exist
+
+// One note / receipt pair handled by the I/O thread, the receipt is read
+// directly into rxBuf and status is set to kSTATUS_OK or kERROR
+typedef struct
+{
+	uint8_t	*txBuf;
+	size_t	txLen;
+	uint8_t	*rxBuf;
+	size_t	rxLen;
+	bool	checkCrc;	// receipt ends with a CRC16 over addr, cmd and the receipt data
+	int		status;
+} TYPE_MC_XFER;
+
+// Called by the I/O thread with each new status receipt, return true when
+// the condition being waited for is met
+typedef bool (*MC_STATUS_PROC)(const uint8_t *receipt, void *arg);
+
 void		Note_init(uint8_t *buf, uint8_t addr, uint8_t cmd, uint8_t **rover);
 void		Note_add_byte(uint8_t *buf, uint8_t arg, uint8_t **rover);
 void		Note_add_word(uint8_t *buf, uint16_t arg, uint8_t **rover);
@@ -44,5 +65,8 @@ int			MC_read_comm(uint8_t *buf, size_t len);
 int			MC_write_comm(uint8_t *buf, size_t len);
 int			MC_init_comm(char *com, int baud);
 int			MC_shutdown(void);
+int			MC_converse(uint8_t *txBuf, size_t txLen, uint8_t *rxBuf, size_t rxLen, bool checkCrc);
+int			MC_converse_batch(TYPE_MC_XFER *xfers, int count);
+int			MC_wait_status(uint8_t *txBuf, size_t txLen, size_t rxLen, MC_STATUS_PROC statusProc, void *arg, int timeout_ms);
 
 #endif
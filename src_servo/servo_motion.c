@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jun 29,	2022	<RNS> Created initial version of this file
 //*	Jul  1,	2022	<RNS> changes globals to static, added access routines
@@ -38,6 +39,8 @@
 //*	Nov  9,	2022	<RNS> Added a routine to check all moves for buffer write timing
 //*	Nov 12,	2022	<RNS> Corrected unitialized status in _wait_axis_buffer_clear
 //*	Nov 12,	2022	<RNS> Added Motion_write_settings() to config RC HW EEPROM
+//*	Oct 18,	2026	<AGT> _wait_axis_buffer_clear now sleeps on the MC I/O thread, no 10ms polling
+//*	Oct 18,	2026	<AGT> Added Motion_stop_axes() to stop both motors with one write
 //*****************************************************************************
 
 #include <stdio.h>
@@ -402,7 +405,6 @@ TYPE_MOTION_MOTOR	*motor;
 int Motion_wait_axis_buffer_clear(uint8_t axis)
 {
 TYPE_MOTION_MOTOR 	*motor;
-uint8_t 			raState, decState, motorState;
 int 				status = kSTATUS_OK;
 
 	motor = Motion_get_motor_ptr(axis);
@@ -415,16 +417,12 @@ int 				status = kSTATUS_OK;
 	if (motor->buffered == false)
 	{
 		// Wait to see the unbuffered cmd (which clears buffer) is executing (0x0) or executed (0x80)
-		// Roboclaw only supports up to a 127 deep buffer, so use lower 7bit mask of 0x7F
-		do
+		// The MC I/O thread wakes us up as soon as it sees the buffer clear
+		status = RC_wait_buffer_clear(motor->addr, axis, kMOTION_BUFFER_CLEAR_TIMEOUT_ms);
+		if (status != kSTATUS_OK)
 		{
-			// printf("(Motion_wait_axis_buffer_clear): SLEEPING....\n");
-			// wait for 1/100th of second then read both motor buffers
-			usleep(10000);
-			status = Motion_get_pending_cmds(&raState, &decState);
-			// if the input axis is RA return the RA buffer length, otherwise use Dec
-			motorState = (axis == SERVO_RA_AXIS) ? raState : decState;
-		} while ((motorState & 0x7F) != 0);
+			printf("ERROR!!!  Motion_wait_axis_buffer_clear() timed out on axis %d\n", axis);
+		}
 	} // of if unbuffered
 
 	return (status == kSTATUS_OK) ? kSTATUS_OK : kERROR;
@@ -543,6 +541,21 @@ TYPE_MOTION_MOTOR	*motor;
 	return kSTATUS_OK;
 }
 
+//*************************************************************************
+// Stop the motors on both axes, the two stop cmds are sent together
+//*************************************************************************
+int Motion_stop_axes(void)
+{
+int		status;
+
+	// Update the motor states and stop the motors
+	gMotionConfig.motor0.state	=	COMPLETED;
+	gMotionConfig.motor1.state	=	COMPLETED;
+	status	=	RC_stop_both(gMotionConfig.motor0.addr, gMotionConfig.motor1.addr);
+
+	return (status == kSTATUS_OK) ? kSTATUS_OK : kERROR;
+}
+
 //*************************************************************************
 // Sets the axis zero position, formerly known as 'home'
 //*************************************************************************
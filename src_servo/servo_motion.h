@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Jul  2,	2022	<RNS> Initial version of this file via cproto
 //*	Jul  3,	2022	<RNS> Updated via cproto
@@ -28,6 +29,7 @@
 //*	Nov  1,	2022	<RNS> Updated via cproto
 //*	Nov  9,	2022	<RNS> Updated via cproto
 //*	Nov 12,	2022	<RNS> Updated via cproto
+//*	Oct 18,	2026	<AGT> Added Motion_stop_axes() and the buffer clear time out
 //****************************************************************************
 //#include	"servo_motion.h"
 
@@ -43,6 +45,9 @@
 	#include	"servo_motion_cfg.h"
 #endif
 
+// Max wait for an unbuffered cmd to clear the RC cmd buffer
+#define	kMOTION_BUFFER_CLEAR_TIMEOUT_ms	2000
+
 
 #ifdef __cplusplus
 	extern "C" {
@@ -71,6 +76,7 @@ int Motion_move_axis_by_step(uint8_t axis, int32_t step);
 int Motion_move_axis_by_vel(uint8_t axis, int32_t vel);
 int Motion_move_axis_by_time(uint8_t axis, int32_t vel, double seconds);
 int Motion_stop_axis(uint8_t axis);
+int Motion_stop_axes(void);
 int Motion_set_axis_zero(uint8_t axis);
 int Motion_reset_axis(uint8_t axis);
 int Motion_init(const char *motionCfgFile);
@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 26,	2022	<RNS> Initial port of the ServoStar code
 //*	Apr 27,	2022	<RNS> still porting to the new RC and MC libs
@@ -99,6 +100,7 @@
 //*	Nov 13,	2022	<RNS> Modified _optimal_path to check for RA wrap on FORK mounts
 //*	Nov 15,	2022	<RNS> Rewrote _calc_optimal_path to separate path calc from mount type
 //*	Nov 16,	2022	<RNS> Added Servo_check_german_for_upside_down() + COP check for it;
+//*	Oct 18,	2026	<AGT> Servo_stop_axes() stops both axes with Motion_stop_axes()
 //*****************************************************************************
 
 //*****************************************************************************
@@ -612,11 +614,9 @@ int		status;
 	switch (motor)
 	{
 		case SERVO_BOTH_AXES:
-			// for both axes, do RA first and fall thru the case switch to get Dec too
-			// Stop the RA motor
-			status	=	Motion_stop_axis(SERVO_RA_AXIS);
-			[[fallthrough]];
-			// NO BREAK
+			// Stop both motors, the RA and Dec stop cmds go out together
+			status	=	Motion_stop_axes();
+			break;
 
 		case SERVO_DEC_AXIS:
 			// Stop the Dec motor
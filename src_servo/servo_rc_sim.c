@@ -0,0 +1,433 @@
+//******************************************************************************
+//*	Name:			servo_rc_sim.c
+//*
+//*	Author:			agent (C) 2026
+//*
+//*	Description: Roboclaw packet serial simulator on a pseudo terminal so the
+//*				servo code can be tested without the hardware
+//*
+//*****************************************************************************
+//*	AlpacaPi is an open source project written in C/C++ and led by Mark Sproul
+//*
+//*	Use of this source code for private or individual use is granted
+//*	Use of this source code, in whole or in part for commercial purpose requires
+//*	written agreement in advance.
+//*
+//*	You may use or modify this source code in any way you find useful, provided
+//*	that you agree that the author(s) have no warranty, obligations or liability.
+//*	You must determine the suitability of this source code for your use.
+//*
+//*	Redistributions of this source code must retain this copyright notice.
+//*****************************************************************************
+//*	<AGT>	=	agent
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created the Roboclaw simulator
+//*****************************************************************************
+// Usage:	rc_sim [-l link] [-d delay_us] [-m move_ms]
+//			-l	also make a symlink to the pty, i.e. /tmp/roboclaw, for the motion cfg port
+//			-d	delay before each receipt, the real RC takes about 1ms
+//			-m	how long each simulated move takes to execute, default 50ms
+//
+// Notes:	Every cmd in gRC[] is answered with the right length. Reads return
+//			zeros except for the encoders and the cmd buffers, writes return 0xFF.
+//			Moves with a buffer arg are queued per motor and drain one per move
+//			time, so GETBUFFERS (cmd 47) reports depth, 0x0 executing, 0x80 done.
+//			Writes with the wrong CRC get no receipt, same as the real RC.
+//*****************************************************************************
+#define _XOPEN_SOURCE	600
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "servo_std_defs.h"
+#include "servo_mc_core.h"
+#include "servo_rc_utils.h"
+#include "servo_rc_cmds.h"
+
+#define kSIM_MAX_EXTRA		8	// extra note bytes allowed for the RC workarounds
+#define kSIM_STALE_ms		50	// drop a byte if a partial note sits this long
+
+typedef struct
+{
+	int32_t	pos;
+	int		depth;			// buffered moves waiting
+	bool	executing;
+	long	doneTime_ms;	// when the executing move finishes
+} TYPE_SIM_MOTOR;
+
+// Cmds that change the motion state, motor 0 is M1 (RA) and 1 is M2 (Dec)
+typedef struct
+{
+	int		cmd;
+	int		motor;
+	bool	hasBufferArg;
+} TYPE_SIM_MOTION_CMD;
+
+static TYPE_SIM_MOTION_CMD	gsMotionCmds[]	=
+{
+	{	M1SPEEDPOS,				0,	true	},
+	{	M2SPEEDPOS,				1,	true	},
+	{	M1SPEEDACCELDECELPOS,	0,	true	},
+	{	M2SPEEDACCELDECELPOS,	1,	true	},
+	{	M1SPEED,				0,	false	},
+	{	M2SPEED,				1,	false	},
+	{	M1DUTY,					0,	false	},
+	{	M2DUTY,					1,	false	},
+	{	-1,						0,	false	}
+};
+
+static TYPE_SIM_MOTOR	gsMotor[2];
+static volatile bool	gsKeepRunning	=	true;
+static int				gsMove_ms		=	50;
+static int				gsDelay_us		=	0;
+
+// Statistics
+static long	gsNoteCnt;
+static long	gsReadCnt;
+static long	gsBytesIn;
+static long	gsBytesOut;
+static long	gsCrcErrCnt;
+static long	gsDroppedCnt;
+
+//*****************************************************************************
+static long Sim_get_millisecs(void)
+{
+struct timespec	timeNow;
+
+	clock_gettime(CLOCK_MONOTONIC, &timeNow);
+	return((timeNow.tv_sec * 1000) + (timeNow.tv_nsec / 1000000));
+}
+
+//*****************************************************************************
+static void Sim_signal_handler(int signum)
+{
+	(void)signum;
+	gsKeepRunning	=	false;
+}
+
+//*****************************************************************************
+// Drains the executing moves that are done into the next buffered one
+//*****************************************************************************
+static void Sim_update_motors(void)
+{
+long	now_ms;
+int		iii;
+
+	now_ms	=	Sim_get_millisecs();
+	for (iii = 0; iii < 2; iii++)
+	{
+		while (gsMotor[iii].executing && (now_ms >= gsMotor[iii].doneTime_ms))
+		{
+			if (gsMotor[iii].depth > 0)
+			{
+				gsMotor[iii].depth--;
+				gsMotor[iii].doneTime_ms	+=	gsMove_ms;
+			}
+			else
+			{
+				gsMotor[iii].executing	=	false;
+			}
+		}
+	}
+}
+
+//*****************************************************************************
+// Returns the gRC[] index for the Roboclaw cmd number, -1 if not supported
+//*****************************************************************************
+static int Sim_find_cmd(uint8_t rcCmd)
+{
+int	iii;
+
+	for (iii = 0; iii < RC_NUM_CMDS; iii++)
+	{
+		if (gRC[iii].cmd == rcCmd)
+		{
+			return(iii);
+		}
+	}
+	return(-1);
+}
+
+//*****************************************************************************
+// Updates the motor model for a write cmd
+//*****************************************************************************
+static void Sim_do_motion(int cmd, uint8_t *note, int noteLen)
+{
+TYPE_SIM_MOTOR	*motor;
+bool			now;
+int				iii;
+
+	for (iii = 0; gsMotionCmds[iii].cmd >= 0; iii++)
+	{
+		motor	=	&gsMotor[gsMotionCmds[iii].motor];
+		if (gsMotionCmds[iii].cmd != cmd)
+		{
+			// not this one
+		}
+		else if (gsMotionCmds[iii].hasBufferArg)
+		{
+			// The buffer arg is just before the CRC, 1 = execute now
+			now	=	(note[noteLen - 3] != 0);
+			if (now || (motor->executing == false))
+			{
+				motor->depth		=	0;
+				motor->executing	=	true;
+				motor->doneTime_ms	=	Sim_get_millisecs() + gsMove_ms;
+			}
+			else
+			{
+				motor->depth++;
+			}
+		}
+		else
+		{
+			// Speed and duty cmds replace everything and do not buffer
+			motor->depth		=	0;
+			motor->executing	=	false;
+		}
+	}
+	if ((cmd == SETM1ENCCOUNT) || (cmd == SETM2ENCCOUNT))
+	{
+		gsMotor[(cmd == SETM1ENCCOUNT) ? 0 : 1].pos	=	0;
+	}
+}
+
+//*****************************************************************************
+// Builds the receipt for a read cmd: data then CRC over addr, cmd and data
+//*****************************************************************************
+static int Sim_make_receipt(int cmd, uint8_t *note, uint8_t *receipt)
+{
+uint8_t		*ptrA, *ptrB;
+uint16_t	crc;
+int			dataLen;
+int			motor;
+
+	dataLen	=	gRC[cmd].out - 2;
+	memset(receipt, 0, dataLen);
+	switch (cmd)
+	{
+		case GETBUFFERS:
+			Sim_update_motors();
+			for (motor = 0; motor < 2; motor++)
+			{
+				if (gsMotor[motor].depth > 0)
+				{
+					receipt[motor]	=	gsMotor[motor].depth;
+				}
+				else
+				{
+					receipt[motor]	=	gsMotor[motor].executing ? 0x0 : kRC_CMD_QUEUE_EMPTY;
+				}
+			}
+			break;
+
+		case GETM1ENCVALUE:
+		case GETM2ENCVALUE:
+			Note_add_dword(receipt, gsMotor[(cmd == GETM1ENCVALUE) ? 0 : 1].pos, &ptrA);
+			break;
+
+		default:
+			break;
+	}
+	crc	=	MC_calc_crc16(note, 2, kCLEAR_CRC);
+	crc	=	MC_calc_crc16(receipt, dataLen, crc);
+	Note_add_word(receipt + dataLen, crc, &ptrB);
+	return(gRC[cmd].out);
+}
+
+//*****************************************************************************
+// Handles every complete note at the start of rxBuf and returns the number
+// of bytes used. Read notes are [addr, cmd], write notes end in a CRC which
+// also frames the RC workarounds that send extra bytes
+//*****************************************************************************
+static int Sim_process_notes(int masterFd, uint8_t *rxBuf, int rxLen, bool stale)
+{
+uint8_t		txBuf[kMAX_STR_LEN];
+int			txLen	=	0;
+int			used	=	0;
+int			cmd;
+int			noteLen;
+int			tryLen;
+uint16_t	crc;
+bool		waitForMore	=	false;
+ssize_t		count;
+
+	while (((rxLen - used) >= 2) && (waitForMore == false))
+	{
+		noteLen	=	0;
+		cmd		=	-1;
+		if ((rxBuf[used] >= 0x80) && (rxBuf[used] <= 0x87))
+		{
+			cmd	=	Sim_find_cmd(rxBuf[used + 1]);
+		}
+		if ((cmd >= 0) && (gRC[cmd].in <= 2))
+		{
+			noteLen	=	2;
+		}
+		else if (cmd >= 0)
+		{
+			// Find the length where the trailing CRC is good
+			for (tryLen = gRC[cmd].in; (tryLen <= gRC[cmd].in + kSIM_MAX_EXTRA) && (tryLen <= (rxLen - used)) && (noteLen == 0); tryLen++)
+			{
+				crc	=	MC_calc_crc16(&rxBuf[used], tryLen - 2, kCLEAR_CRC);
+				if ((rxBuf[used + tryLen - 2] == (crc >> 8)) && (rxBuf[used + tryLen - 1] == (crc & 0xFF)))
+				{
+					noteLen	=	tryLen;
+				}
+			}
+			if ((noteLen == 0) && ((rxLen - used) < (gRC[cmd].in + kSIM_MAX_EXTRA)) && (stale == false))
+			{
+				waitForMore	=	true;
+			}
+			else if (noteLen == 0)
+			{
+				gsCrcErrCnt++;
+			}
+		}
+
+		if (waitForMore)
+		{
+			// the rest of the note has not arrived yet
+		}
+		else if (noteLen == 0)
+		{
+			gsDroppedCnt++;
+			used++;
+		}
+		else
+		{
+			gsNoteCnt++;
+			if (gRC[cmd].in <= 2)
+			{
+				txLen	+=	Sim_make_receipt(cmd, &rxBuf[used], &txBuf[txLen]);
+			}
+			else
+			{
+				Sim_do_motion(cmd, &rxBuf[used], noteLen);
+				txBuf[txLen++]	=	0xFF;
+			}
+			used	+=	noteLen;
+		}
+	}
+
+	if (txLen > 0)
+	{
+		if (gsDelay_us > 0)
+		{
+			usleep(gsDelay_us);
+		}
+		count	=	write(masterFd, txBuf, txLen);
+		if (count > 0)
+		{
+			gsBytesOut	+=	count;
+		}
+	}
+	return(used);
+}
+
+//*****************************************************************************
+int main(int argc, char **argv)
+{
+struct termios	settings;
+struct pollfd	pollFd;
+uint8_t			rxBuf[kMAX_STR_LEN * 2];
+int				rxLen	=	0;
+int				masterFd;
+int				slaveFd;
+int				used;
+int				option;
+char			*slavePath;
+char			*linkPath	=	NULL;
+ssize_t			count;
+bool			stale;
+
+	while ((option = getopt(argc, argv, "l:d:m:")) != -1)
+	{
+		switch (option)
+		{
+			case 'l':	linkPath	=	optarg;			break;
+			case 'd':	gsDelay_us	=	atoi(optarg);	break;
+			case 'm':	gsMove_ms	=	atoi(optarg);	break;
+			default:
+				fprintf(stderr, "Usage: %s [-l link] [-d delay_us] [-m move_ms]\n", argv[0]);
+				return(kERROR);
+		}
+	}
+
+	masterFd	=	posix_openpt(O_RDWR | O_NOCTTY);
+	if ((masterFd < 0) || (grantpt(masterFd) != 0) || (unlockpt(masterFd) != 0))
+	{
+		perror("Error opening the pty: ");
+		return(kERROR);
+	}
+	slavePath	=	ptsname(masterFd);
+
+	// Keep the slave open so the pty stays up between test runs, and raw so
+	// nothing gets echoed before the servo code sets its own attributes
+	slaveFd		=	open(slavePath, O_RDWR | O_NOCTTY);
+	if ((slaveFd < 0) || (tcgetattr(slaveFd, &settings) != 0))
+	{
+		perror("Error opening the pty slave: ");
+		return(kERROR);
+	}
+	cfmakeraw(&settings);
+	tcsetattr(slaveFd, TCSANOW, &settings);
+
+	if (linkPath != NULL)
+	{
+		unlink(linkPath);
+		if (symlink(slavePath, linkPath) != 0)
+		{
+			perror("Error making the link: ");
+		}
+	}
+	printf("Roboclaw simulator on %s  (move time %d ms, receipt delay %d us)\n", slavePath, gsMove_ms, gsDelay_us);
+	fflush(stdout);
+
+	signal(SIGINT,	Sim_signal_handler);
+	signal(SIGTERM,	Sim_signal_handler);
+
+	while (gsKeepRunning)
+	{
+		pollFd.fd		=	masterFd;
+		pollFd.events	=	POLLIN;
+		pollFd.revents	=	0;
+		stale			=	(poll(&pollFd, 1, kSIM_STALE_ms) == 0);
+		if (pollFd.revents & POLLIN)
+		{
+			count	=	read(masterFd, &rxBuf[rxLen], sizeof(rxBuf) - rxLen);
+			if (count > 0)
+			{
+				gsReadCnt++;
+				gsBytesIn	+=	count;
+				rxLen		+=	count;
+			}
+		}
+		if (rxLen > 0)
+		{
+			used	=	Sim_process_notes(masterFd, rxBuf, rxLen, stale);
+			memmove(rxBuf, &rxBuf[used], rxLen - used);
+			rxLen	-=	used;
+		}
+	}
+
+	printf("\nnotes = %ld  reads = %ld  bytes in = %ld  bytes out = %ld  CRC errors = %ld  dropped = %ld\n",
+			gsNoteCnt, gsReadCnt, gsBytesIn, gsBytesOut, gsCrcErrCnt, gsDroppedCnt);
+	if (linkPath != NULL)
+	{
+		unlink(linkPath);
+	}
+	close(slaveFd);
+	close(masterFd);
+	return(kSTATUS_OK);
+}
@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 11,	2022	<RNS> Created RC_utils.c from LMx_utils.c
 //*	Apr 20,	2022	<RNS> Cleaned up globals to reduce variable's scope
@@ -60,6 +61,8 @@
 //*	Jul  7,	2022	<RNS> Fixed move_by_pos* bugs with negative vel/acc/decel
 //*	Nov  7,	2022	<RNS> Fixed a duplicate local #define vs include file
 //*	Nov  7,	2022	<RNS> Simplifed move_by_vela routine while debug RC wierdness
+//*	Oct 18,	2026	<AGT> RC_converse() now goes through the MC I/O thread, receipts CRC checked there
+//*	Oct 18,	2026	<AGT> Added RC_wait_buffer_clear() and RC_stop_both()
 //*****************************************************************************
 // Notes:   M1 *MUST BE* connected to RA or Azimuth axis, M2 to Dec or Altitude
 //*****************************************************************************
@@ -93,37 +96,17 @@ static uint8_t gReceiptBuf[64];
 //*****************************************************************************
 int RC_converse(uint8_t *cmdBuf, size_t cmdLen, uint8_t *retBuf, size_t retLen)
 {
-size_t	len;
 int		status;
-int		writeStatus;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_LONG("cmdLen\t=", cmdLen);
 //	CONSOLE_DEBUG_W_LONG("retLen\t=", retLen);
-	writeStatus	=	MC_write_comm(cmdBuf, cmdLen);
-//	CONSOLE_DEBUG_W_NUM("MC_write_comm -> writeStatus\t=", writeStatus);
-	if (writeStatus == kSTATUS_OK)
+	// Anything longer than the one byte 0xFF ack ends with a CRC16
+	status	=	MC_converse(cmdBuf, cmdLen, retBuf, retLen, (retLen > 2));
+	if (status != kSTATUS_OK)
 	{
-		len	=	MC_read_comm(retBuf, retLen);
-//		CONSOLE_DEBUG_W_NUM("MC_read_comm -> len\t=", (int)len);
-//		CONSOLE_DEBUG_W_LONG("retLen \t\t=", retLen);
-
-		if (len == retLen)
-		{
-			status	=	kSTATUS_OK;
-		}
-		else
-		{
-			printf("RC_converse: got error - len = %ld   retLen = %ld\n", len, retLen);
-			status	=	kERROR;
-		}
+		printf("RC_converse: got error - cmd = %d   retLen = %ld\n", cmdBuf[1], retLen);
 	}
-	else
-	{
-		CONSOLE_DEBUG("MC_write_comm() failed");
-		status	=	kERROR;
-	}
-	// If we got here, everything worked
 	return(status);
 } // of RC_converse()
 
@@ -469,6 +452,41 @@ int			retState;
 	return(kSTATUS_OK);
 } // of RC_check_queue()
 
+//******************************************************************
+// Status proc for RC_wait_buffer_clear(), the receipt is from cmd 47 and
+// the buffer is clear once it is executing the last cmd (0x0) or done (0x80)
+//******************************************************************
+static bool RC_buffer_clear_proc(const uint8_t *receipt, void *arg)
+{
+uint8_t	motor	=	*(uint8_t *)arg;
+uint8_t	depth;
+
+	depth	=	(motor == SERVO_RA_AXIS) ? receipt[0] : receipt[1];
+	// Roboclaw only supports up to a 127 deep buffer, so use lower 7bit mask of 0x7F
+	return((depth & 0x7F) == 0);
+}
+
+//******************************************************************
+// Sleeps until the motor's cmd buffer is clear or timeout_ms has passed.
+// The MC I/O thread reads the buffers for all waiters, nobody polls here
+// Send: [Address, 47]
+// Receive: [BufferM1, BufferM2, CRC(2 bytes)]
+//******************************************************************
+int RC_wait_buffer_clear(uint8_t addr, uint8_t motor, int timeout_ms)
+{
+uint8_t		noteBuf[kSMALL_STR_LEN];
+uint8_t		*ptrA;
+int			cmd	=	GETBUFFERS;
+
+	if ((motor != SERVO_RA_AXIS) && (motor != SERVO_DEC_AXIS))
+	{
+		return(kERROR);
+	}
+	Note_init(noteBuf, addr, gRC[cmd].cmd, &ptrA);
+
+	return(MC_wait_status(noteBuf, gRC[cmd].in, gRC[cmd].out, RC_buffer_clear_proc, &motor, timeout_ms));
+} // of RC_wait_buffer_clear()
+
 //*************************************************************************
 // Set the max acceleration from the config file to the RC default speed
 // Send: [Address, 68, Accel(4 bytes), CRC(2 bytes)]
@@ -1015,6 +1033,58 @@ int			zero	=	0;
 	return(kSTATUS_OK);
 } // of RC_stop()
 
+//******************************************************************
+// Stops both motors with zero duty, the two notes are handed to the
+// I/O thread together so they go out in a single write
+// Send: [Address, 32, Duty(2 Bytes), CRC(2 bytes)] and the same with 33
+// Receive: [0xFF] for each
+//******************************************************************
+int RC_stop_both(uint8_t raAddr, uint8_t decAddr)
+{
+uint8_t			noteBufs[2][kSMALL_STR_LEN];
+uint8_t			receiptBufs[2][kSMALL_STR_LEN];
+TYPE_MC_XFER	xfers[2];
+uint8_t			*ptrA, *ptrB;
+uint16_t		crc;
+int				cmd[2]	=	{M1DUTY, M2DUTY};
+uint8_t			addr[2];
+int				zero	=	0;
+int				len;
+int				status;
+int				iii;
+
+	addr[0]	=	raAddr;
+	addr[1]	=	decAddr;
+	for (iii = 0; iii < 2; iii++)
+	{
+		Note_init(noteBufs[iii], addr[iii], gRC[cmd[iii]].cmd, &ptrA);
+		Note_add_word(ptrA, zero, &ptrB);
+		// Get length and calc CRC then add it the note
+		len	=	(int)(ptrB - noteBufs[iii]);
+		crc	=	MC_calc_crc16(noteBufs[iii], len, kCLEAR_CRC);
+		Note_add_word(ptrB, crc, &ptrA);
+
+		xfers[iii].txBuf	=	noteBufs[iii];
+		xfers[iii].txLen	=	gRC[cmd[iii]].in;
+		xfers[iii].rxBuf	=	receiptBufs[iii];
+		xfers[iii].rxLen	=	gRC[cmd[iii]].out;
+		xfers[iii].checkCrc	=	false;
+	}
+
+	status	=	MC_converse_batch(xfers, 2);
+	if (status != kSTATUS_OK)
+	{
+		return(kERROR);
+	}
+	// Check the one byte return status for each
+	if ((receiptBufs[0][0] != kRC_OK) || (receiptBufs[1][0] != kRC_OK))
+	{
+		return(kERROR);
+	}
+
+	return(kSTATUS_OK);
+} // of RC_stop_both()
+
 //******************************************************************
 // calcs the time it will take to move from pos1 from pos0 with given vel & acc
 // returns the value in decimal seconds
@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	<MLS>	=	Mark L Sproul
 //*	<RNS>	=	Ron N Story
+//*	<AGT>	=	agent
 //*****************************************************************************
 //*	Apr 27,	2022	<RNS> Created servo_rc_utils.h using cproto
 //*	Apr 27,	2022	<RNS> add defines for RC return status
@@ -37,6 +38,7 @@
 //*	Jul  2,	2022	<RNS> Changed POS_FOREVER to kSTEP_FOREVER and moved here
 //*	Jul  5,	2022	<RNS> Regenerated all headers with cproto
 //*	Jul  7,	2022	<RNS> Changed to signed vel/acc/decel in move_by_pos*
+//*	Oct 18,	2026	<AGT> Added RC_wait_buffer_clear() and RC_stop_both()
 //****************************************************************************
 //#include "servo_rc_utils.h"
 
@@ -90,6 +92,7 @@ int RC_get_curr_vel(uint8_t addr, uint8_t motor, int32_t *vel);
 int RC_set_home(uint8_t addr, uint8_t motor);
 int RC_get_status(uint8_t addr, uint32_t *rcStatus);
 int RC_check_queue(uint8_t addr, uint8_t *raDepth, uint8_t *decDepth);
+int RC_wait_buffer_clear(uint8_t addr, uint8_t motor, int timeout_ms);
 int RC_set_default_acc(uint8_t addr, uint8_t motor, uint32_t acc);
 int RC_write_settings(uint8_t addr);
 int RC_read_settings(uint8_t addr, uint32_t *rcStatus);
@@ -99,6 +102,7 @@ int RC_get_vel_pid(uint8_t addr, uint8_t motor, double *propo, double *integ, do
 int RC_set_vel_pid(uint8_t addr, uint8_t motor, double propo, double integ, double deriv, uint32_t qpps);
 int RC_restore_defaults(uint8_t addr);
 int RC_stop(uint8_t addr, uint8_t motor);
+int RC_stop_both(uint8_t raAddr, uint8_t decAddr);
 double RC_calc_move_time(int32_t pos0, int32_t pos1, uint32_t vel, uint32_t acc);
 int32_t RC_calc_move_distance(int32_t startVel, int32_t endVel, int32_t acc, double seconds);
 int RC_move_by_posv(uint8_t addr, uint8_t motor, int32_t pos, int32_t vel, bool buffered);
@@ -18,6 +18,8 @@
 //*	Jan  1,	2022	<MLS> Added support for Minor Planet Center asteroid data
 //*	Jan  3,	2022	<MLS> Tested asteroid display on Raspberry-Pi, works, but slow
 //*	Jan 24,	2022	<MLS> Asteroids without magnitude now default to 10
+//*	Oct 18,	2026	<AGT> UpdateAsteroidEphemeris() now uses AsteroidEphemeris.c
+//*	Oct 18,	2026	<AGT> Epoch of osculation is now 0h UT, Julian_CalcFromDate() uses local time
 //*****************************************************************************
 
 #ifdef _ENABLE_ASTEROIDS_
@@ -44,6 +46,7 @@
 #include	"ConsoleDebug.h"
 
 #include	"AsteroidData.h"
+#include	"AsteroidEphemeris.h"
 
 //************************************************************************
 static void	StripLeadingSpaces(char *theString)
@@ -226,6 +229,18 @@ double	deltaEEE;
 }
 
 
+//**************************************************************************
+//*	julian date at 0h UT, same math as Gregorian() in SkyTravelTimeRoutines.c
+//*	which returns the julian day number at noon
+//**************************************************************************
+static double	GetJulianDate_0hUT(const int month, const int day, const int year)
+{
+long	jd;
+
+	jd	=	367 * year - (7*(year + (month + 9)/12)/4) - (3*((year + (month-9)/7)/100 + 1)/4) + ((275*month)/9) + day + 1721029;
+	return(jd - 0.5);
+}
+
 //**************************************************************************
 //*	this calculates the data that does not change and only needs to be called once
 //**************************************************************************
@@ -331,7 +346,8 @@ int		epochYear;
 //	CONSOLE_DEBUG_W_NUM("epochMonth\t\t=",			epochMonth);
 //	CONSOLE_DEBUG_W_NUM("epochDay\t\t=",			epochDay);
 
-	asteroidData->epochJulian	=	Julian_CalcFromDate(epochMonth, epochDay, epochYear);
+	//*	SkyTravel time (fJulianDay) is UT, the epoch has to be as well
+	asteroidData->epochJulian	=	GetJulianDate_0hUT(epochMonth, epochDay, epochYear);
 
 	asteroidData->StarData.realMagnitude	=	asteroidData->AbsoluteMagnitude;
 
@@ -705,19 +721,16 @@ void			UpdateAsteroidEphemeris(	TYPE_Asteroid	*asteroidData,
 											const double	sun_decl,			//*	radians
 											const double	sun_dist)			//*	AU
 {
-int				iii;
-
 //	CONSOLE_DEBUG_W_LONG("asteriodCnt\t=",	asteriodCnt);
 
-	for (iii=0; iii<asteriodCnt; iii++)
-	{
-		ComputeAsteroidData_Dynamic(&asteroidData[iii],
-									targetJulianDate,
-									true,
-									sun_rtAscen,	//*	radians
-									sun_decl,		//*	radians
-									sun_dist);		//*	AU
-	}
+	//*	all of them, no culling
+	AsteroidEphemeris_Update(	asteroidData,
+								asteriodCnt,
+								targetJulianDate,
+								sun_rtAscen,	//*	radians
+								sun_decl,		//*	radians
+								sun_dist,		//*	AU
+								NULL);
 }
 
 #ifdef _INCLUDE_ASTEROID_MAIN_
@@ -3,7 +3,8 @@
 
 //#include	"AsteroidData.h"
 
-
+#ifndef _ASTEROID_DATA_H_
+#define	_ASTEROID_DATA_H_
 
 #ifndef _SKY_STRUCTS_H_
 	#include	"SkyStruc.h"
@@ -85,3 +86,5 @@ extern	char				gAsteroidDatbase[];
 #ifdef __cplusplus
 }
 #endif
+
+#endif // _ASTEROID_DATA_H_
@@ -0,0 +1,957 @@
+//*****************************************************************************
+//*	AsteroidEphemeris.c
+//*
+//*	Batch asteroid positions for SkyTravel.
+//*
+//*	UpdateAsteroidEphemeris() used to solve Kepler's equation for every asteroid
+//*	(over a million with the MPC file) every time the sky was redrawn, using a
+//*	fixed point iteration that can take 50 passes for the higher eccentricities.
+//*
+//*	This does the following instead
+//*		Objects too faint to be drawn are skipped first, the drawing magnitude is
+//*			the absolute magnitude so this is known before doing any work. It is kept
+//*			in its own array so skipped objects never touch the TYPE_Asteroid array.
+//*		The heliocentric position and velocity are cached at time knots kAsteroidKnotDays apart.
+//*			In between, the position is a cubic Hermite interpolation, so animating
+//*			time only solves Kepler's equation when a knot is crossed. When time moves
+//*			one knot, the knot that is still in range is kept.
+//*		The knots cost two solves per object, that is only worth it once time is moving.
+//*			The first update for a new time (start up, or time jumped) solves once at
+//*			that exact time and keeps the result, the knots are set up on the next
+//*			update if it is less than kAsteroidKnotDays away.
+//*		Kepler's equation is solved with Newton's method for a block of objects at
+//*			a time, a fixed number of steps on every object with no branches,
+//*			then the few that have not converged get more steps.
+//*		Objects outside of the view are skipped before the RA/DEC trig.
+//*		The objects that pass are returned as a list of indices so drawing does not
+//*			have to look at the whole array.
+//*		Large lists are split across threads.
+//*
+//*	To build the benchmark
+//*		make asteroidbench
+//*		./asteroidbench [object count]
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created AsteroidEphemeris.c
+//*	Oct 18,	2026	<AGT> Added _INCLUDE_ASTEROID_EPHEM_MAIN_ benchmark
+//*	Oct 18,	2026	<AGT> First update for a new time is one exact solve, knots are set up after that
+//*****************************************************************************
+
+#ifdef _ENABLE_ASTEROIDS_
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+#include	<math.h>
+#include	<unistd.h>
+#include	<pthread.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"AsteroidData.h"
+#include	"AsteroidEphemeris.h"
+
+#define	RADIANS(degrees)	((degrees) * (M_PI / 180.0))
+#define	DEGREES(radians)	((radians) * (180.0 / M_PI))
+
+#define	kKnotValues			6		//*	x, y, z, vx, vy, vz	(AU, AU/day)
+#define	kKeplerTolerance	1.0e-12	//*	radians
+#define	kNeverDrawn			1.0e30
+
+//*****************************************************************************
+typedef struct
+{
+	TYPE_Asteroid	*asteroidData;
+	long			asteroidCnt;
+	double			*knotJulian;		//*	time of the lower knot for each object, 0 = no knots
+	double			*exactJulian;		//*	time of the exact position in knot0 when there are no knots, 0 = none
+	double			*knot0;				//*	[asteroidCnt * kKnotValues] heliocentric, at knotJulian
+	double			*knot1;				//*	[asteroidCnt * kKnotValues] heliocentric, at knotJulian + kAsteroidKnotDays
+	float			*magnitude;			//*	drawing magnitude, kNeverDrawn if the orbit is not an ellipse
+	long			*inViewList;		//*	indices of the objects that passed the cull
+	long			inViewCnt;
+
+	//*	from the last update
+	double			targetJulian;
+	double			sunXXX;
+	double			sunYYY;
+	double			sunZZZ;
+} TYPE_AsteroidEphemeris;
+
+//*****************************************************************************
+typedef struct
+{
+	TYPE_AsteroidEphemeris	*ephemeris;
+	long					startIdx;
+	long					stopIdx;
+	double					lowerKnot;
+	double					viewXXX;
+	double					viewYYY;
+	double					viewZZZ;
+	double					cosViewRadius;
+	double					magnitudeLimit;
+	bool					cullRegion;
+	long					inViewCnt;			//*	the list for this thread starts at inViewList[startIdx]
+} TYPE_AsteroidThreadArgs;
+
+static	TYPE_AsteroidEphemeris	gAsteroidEphemeris;
+
+
+//*****************************************************************************
+//*	solves E - e sin(E) = M for a block of objects
+//*
+//*	sin(E) and cos(E) are only evaluated at the start and the end, each Newton
+//*	step rotates them by the correction using the Taylor series for sin and cos,
+//*	so the steps are straight arithmetic that the compiler can vectorize.
+//*****************************************************************************
+static void	SolveKepler(const int		count,
+						const double	*meanAnomaly,		//*	radians, -PI to PI
+						const double	*eccentricity,
+						double			*sinE,
+						double			*cosE)
+{
+int		iii;
+int		stepCnt;
+double	eccAnomaly[2 * kAsteroidBlockSize];
+double	delta;
+double	deltaSqrd;
+double	sinDelta;
+double	cosDelta;
+double	newSinE;
+
+	//*	Danby's starting value, Newton converges from here for any e < 1
+	for (iii=0; iii<count; iii++)
+	{
+		eccAnomaly[iii]	=	meanAnomaly[iii] + copysign(0.85 * eccentricity[iii], sin(meanAnomaly[iii]));
+		sincos(eccAnomaly[iii], &sinE[iii], &cosE[iii]);
+	}
+
+	//*	the same number of steps on every object, enough for the normal asteroids
+	for (stepCnt=0; stepCnt<kAsteroidNewtonSteps; stepCnt++)
+	{
+		for (iii=0; iii<count; iii++)
+		{
+			delta			=	(eccAnomaly[iii] - (eccentricity[iii] * sinE[iii]) - meanAnomaly[iii]) /
+								(1.0 - (eccentricity[iii] * cosE[iii]));
+			deltaSqrd		=	delta * delta;
+			sinDelta		=	delta * (1.0 - ((deltaSqrd / 6.0) * (1.0 - ((deltaSqrd / 20.0) * (1.0 - (deltaSqrd / 42.0))))));
+			cosDelta		=	1.0 - ((deltaSqrd / 2.0) * (1.0 - ((deltaSqrd / 12.0) * (1.0 - (deltaSqrd / 30.0)))));
+			eccAnomaly[iii]	-=	delta;
+			newSinE			=	(sinE[iii] * cosDelta) - (cosE[iii] * sinDelta);
+			cosE[iii]		=	(cosE[iii] * cosDelta) + (sinE[iii] * sinDelta);
+			sinE[iii]		=	newSinE;
+		}
+	}
+
+	//*	the exact values, and finish the ones that are not there yet (the high eccentricities)
+	for (iii=0; iii<count; iii++)
+	{
+		sincos(eccAnomaly[iii], &sinE[iii], &cosE[iii]);
+		delta		=	(eccAnomaly[iii] - (eccentricity[iii] * sinE[iii]) - meanAnomaly[iii]) /
+						(1.0 - (eccentricity[iii] * cosE[iii]));
+		stepCnt		=	kAsteroidNewtonSteps;
+		while ((fabs(delta) > kKeplerTolerance) && (stepCnt < kAsteroidNewtonMaxSteps))
+		{
+			eccAnomaly[iii]	-=	delta;
+			sincos(eccAnomaly[iii], &sinE[iii], &cosE[iii]);
+			delta			=	(eccAnomaly[iii] - (eccentricity[iii] * sinE[iii]) - meanAnomaly[iii]) /
+								(1.0 - (eccentricity[iii] * cosE[iii]));
+			stepCnt++;
+		}
+	}
+}
+
+//*****************************************************************************
+//*	[MAA] Equation (7.10) page 33, reduced to -PI to PI
+//*****************************************************************************
+static double	GetMeanAnomaly(const TYPE_Asteroid *asteroid, const double julianDate)
+{
+double	meanAnomaly_deg;
+
+	meanAnomaly_deg	=	asteroid->MeanAnomaly + (asteroid->n0_dailyMotion_deg * (julianDate - asteroid->epochJulian));
+	meanAnomaly_deg	-=	360.0 * floor((meanAnomaly_deg + 180.0) / 360.0);
+	return(RADIANS(meanAnomaly_deg));
+}
+
+//*****************************************************************************
+//*	[MAA] Equation (7.11) page 33, plus the velocity (d/dt of the same thing)
+//*****************************************************************************
+static void	GetHeliocentric(const TYPE_Asteroid	*asteroid,
+							const double		sinE,
+							const double		cosE,
+							double				knot[kKnotValues])
+{
+double	aaa;
+double	bbb;
+double	eee;
+double	xTerm;
+double	yTerm;
+double	eccAnomalyRate;
+
+	aaa				=	asteroid->SemimajorAxis;
+	eee				=	asteroid->Eccentricity;
+	bbb				=	aaa * sqrt(1.0 - (eee * eee));
+	eccAnomalyRate	=	RADIANS(asteroid->n0_dailyMotion_deg) / (1.0 - (eee * cosE));
+
+	xTerm			=	aaa * (cosE - eee);
+	yTerm			=	bbb * sinE;
+	knot[0]			=	(xTerm * asteroid->Px) + (yTerm * asteroid->Qx);
+	knot[1]			=	(xTerm * asteroid->Py) + (yTerm * asteroid->Qy);
+	knot[2]			=	(xTerm * asteroid->Pz) + (yTerm * asteroid->Qz);
+
+	xTerm			=	-aaa * sinE * eccAnomalyRate;
+	yTerm			=	bbb * cosE * eccAnomalyRate;
+	knot[3]			=	(xTerm * asteroid->Px) + (yTerm * asteroid->Qx);
+	knot[4]			=	(xTerm * asteroid->Py) + (yTerm * asteroid->Qy);
+	knot[5]			=	(xTerm * asteroid->Pz) + (yTerm * asteroid->Qz);
+}
+
+//*****************************************************************************
+//*	[MAA] Equations (7.18) to (7.22) page 34, same results as ComputeAsteroidData_Dynamic()
+//*****************************************************************************
+static void	SetGeocentric(	TYPE_Asteroid	*asteroid,
+							const double	xi,
+							const double	eta,
+							const double	zeta,
+							const double	deltaEarth,
+							const double	targetJulian,
+							const double	sunXXX,
+							const double	sunYYY,
+							const double	sunZZZ)
+{
+	asteroid->targetJulian			=	targetJulian;
+	asteroid->StarData.decl			=	asin(zeta / deltaEarth);
+	asteroid->StarData.ra			=	atan2(eta, xi);
+	asteroid->StarData.org_ra		=	asteroid->StarData.ra;
+	asteroid->StarData.org_decl		=	asteroid->StarData.decl;
+	asteroid->sunXXX				=	sunXXX;
+	asteroid->sunYYY				=	sunYYY;
+	asteroid->sunZZZ				=	sunZZZ;
+	asteroid->delta_AUfromEarth		=	deltaEarth;
+}
+
+//*****************************************************************************
+static void	AsteroidEphemeris_UpdateRows(TYPE_AsteroidThreadArgs *threadArgs)
+{
+TYPE_AsteroidEphemeris	*ephemeris;
+TYPE_Asteroid			*asteroid;
+long					*inViewList;
+long					blockStart;
+long					blockCnt;
+long					objIdx;
+int						iii;
+int						jobCnt;
+bool					wanted[kAsteroidBlockSize];
+bool					useExact[kAsteroidBlockSize];
+long					jobIdx[2 * kAsteroidBlockSize];
+double					*jobKnot[2 * kAsteroidBlockSize];
+double					jobMeanAnomaly[2 * kAsteroidBlockSize];
+double					jobEccentricity[2 * kAsteroidBlockSize];
+double					jobSinE[2 * kAsteroidBlockSize];
+double					jobCosE[2 * kAsteroidBlockSize];
+double					lowerKnot;
+double					upperKnot;
+double					fff;
+double					h00, h10, h01, h11;
+double					*knot0;
+double					*knot1;
+double					xi;
+double					eta;
+double					zeta;
+double					deltaEarth;
+
+	ephemeris	=	threadArgs->ephemeris;
+	inViewList	=	&ephemeris->inViewList[threadArgs->startIdx];
+	lowerKnot	=	threadArgs->lowerKnot;
+	upperKnot	=	lowerKnot + kAsteroidKnotDays;
+
+	//*	the Hermite basis is the same for every object
+	fff			=	(ephemeris->targetJulian - lowerKnot) / kAsteroidKnotDays;
+	h00			=	(1.0 + (2.0 * fff)) * (1.0 - fff) * (1.0 - fff);
+	h10			=	fff * (1.0 - fff) * (1.0 - fff) * kAsteroidKnotDays;
+	h01			=	fff * fff * (3.0 - (2.0 * fff));
+	h11			=	fff * fff * (fff - 1.0) * kAsteroidKnotDays;
+
+	threadArgs->inViewCnt	=	0;
+	for (blockStart=threadArgs->startIdx; blockStart<threadArgs->stopIdx; blockStart+=kAsteroidBlockSize)
+	{
+		blockCnt	=	threadArgs->stopIdx - blockStart;
+		if (blockCnt > kAsteroidBlockSize)
+		{
+			blockCnt	=	kAsteroidBlockSize;
+		}
+
+		//*	stage 1: magnitude cull and figure out which positions are missing
+		jobCnt	=	0;
+		for (iii=0; iii<blockCnt; iii++)
+		{
+			objIdx			=	blockStart + iii;
+			wanted[iii]		=	(ephemeris->magnitude[objIdx] <= threadArgs->magnitudeLimit);
+			useExact[iii]	=	false;
+			if (wanted[iii] && (ephemeris->knotJulian[objIdx] != lowerKnot))
+			{
+				asteroid	=	&ephemeris->asteroidData[objIdx];
+				knot0		=	&ephemeris->knot0[objIdx * kKnotValues];
+				knot1		=	&ephemeris->knot1[objIdx * kKnotValues];
+				if (ephemeris->knotJulian[objIdx] == (lowerKnot - kAsteroidKnotDays))
+				{
+					//*	time moved forward one knot, the old upper knot is still good
+					memcpy(knot0, knot1, kKnotValues * sizeof(double));
+					jobIdx[jobCnt]			=	objIdx;
+					jobKnot[jobCnt]			=	knot1;
+					jobMeanAnomaly[jobCnt]	=	GetMeanAnomaly(asteroid, upperKnot);
+					jobEccentricity[jobCnt]	=	asteroid->Eccentricity;
+					jobCnt++;
+					ephemeris->knotJulian[objIdx]	=	lowerKnot;
+				}
+				else if (ephemeris->knotJulian[objIdx] == upperKnot)
+				{
+					//*	time moved back one knot, the old lower knot is still good
+					memcpy(knot1, knot0, kKnotValues * sizeof(double));
+					jobIdx[jobCnt]			=	objIdx;
+					jobKnot[jobCnt]			=	knot0;
+					jobMeanAnomaly[jobCnt]	=	GetMeanAnomaly(asteroid, lowerKnot);
+					jobEccentricity[jobCnt]	=	asteroid->Eccentricity;
+					jobCnt++;
+					ephemeris->knotJulian[objIdx]	=	lowerKnot;
+				}
+				else if (ephemeris->exactJulian[objIdx] == ephemeris->targetJulian)
+				{
+					//*	redraw at the same time, already have it
+					useExact[iii]	=	true;
+				}
+				else if ((ephemeris->exactJulian[objIdx] != 0.0) &&
+						(fabs(ephemeris->targetJulian - ephemeris->exactJulian[objIdx]) < kAsteroidKnotDays))
+				{
+					//*	time is moving in small steps, set up the knots
+					jobIdx[jobCnt]			=	objIdx;
+					jobKnot[jobCnt]			=	knot0;
+					jobMeanAnomaly[jobCnt]	=	GetMeanAnomaly(asteroid, lowerKnot);
+					jobEccentricity[jobCnt]	=	asteroid->Eccentricity;
+					jobCnt++;
+					jobIdx[jobCnt]			=	objIdx;
+					jobKnot[jobCnt]			=	knot1;
+					jobMeanAnomaly[jobCnt]	=	GetMeanAnomaly(asteroid, upperKnot);
+					jobEccentricity[jobCnt]	=	asteroid->Eccentricity;
+					jobCnt++;
+					ephemeris->knotJulian[objIdx]	=	lowerKnot;
+					ephemeris->exactJulian[objIdx]	=	0.0;
+				}
+				else
+				{
+					//*	first time or time jumped, one solve at the exact time
+					jobIdx[jobCnt]			=	objIdx;
+					jobKnot[jobCnt]			=	knot0;
+					jobMeanAnomaly[jobCnt]	=	GetMeanAnomaly(asteroid, ephemeris->targetJulian);
+					jobEccentricity[jobCnt]	=	asteroid->Eccentricity;
+					jobCnt++;
+					ephemeris->knotJulian[objIdx]	=	0.0;
+					ephemeris->exactJulian[objIdx]	=	ephemeris->targetJulian;
+					useExact[iii]					=	true;
+				}
+			}
+		}
+
+		//*	stage 2: solve Kepler's equation for the missing knots
+		if (jobCnt > 0)
+		{
+			SolveKepler(jobCnt, jobMeanAnomaly, jobEccentricity, jobSinE, jobCosE);
+			for (iii=0; iii<jobCnt; iii++)
+			{
+				GetHeliocentric(&ephemeris->asteroidData[jobIdx[iii]], jobSinE[iii], jobCosE[iii], jobKnot[iii]);
+			}
+		}
+
+		//*	stage 3: interpolate, region cull, then RA/DEC
+		for (iii=0; iii<blockCnt; iii++)
+		{
+			if (wanted[iii])
+			{
+				objIdx		=	blockStart + iii;
+				knot0		=	&ephemeris->knot0[objIdx * kKnotValues];
+				knot1		=	&ephemeris->knot1[objIdx * kKnotValues];
+				if (useExact[iii])
+				{
+					xi		=	knot0[0] + ephemeris->sunXXX;
+					eta		=	knot0[1] + ephemeris->sunYYY;
+					zeta	=	knot0[2] + ephemeris->sunZZZ;
+				}
+				else
+				{
+					xi		=	(h00 * knot0[0]) + (h10 * knot0[3]) + (h01 * knot1[0]) + (h11 * knot1[3]) + ephemeris->sunXXX;
+					eta		=	(h00 * knot0[1]) + (h10 * knot0[4]) + (h01 * knot1[1]) + (h11 * knot1[4]) + ephemeris->sunYYY;
+					zeta	=	(h00 * knot0[2]) + (h10 * knot0[5]) + (h01 * knot1[2]) + (h11 * knot1[5]) + ephemeris->sunZZZ;
+				}
+				deltaEarth	=	sqrt((xi * xi) + (eta * eta) + (zeta * zeta));
+				if ((threadArgs->cullRegion == false) ||
+					(((xi * threadArgs->viewXXX) + (eta * threadArgs->viewYYY) + (zeta * threadArgs->viewZZZ)) >=
+																		(threadArgs->cosViewRadius * deltaEarth)))
+				{
+					SetGeocentric(	&ephemeris->asteroidData[objIdx],
+									xi,
+									eta,
+									zeta,
+									deltaEarth,
+									ephemeris->targetJulian,
+									ephemeris->sunXXX,
+									ephemeris->sunYYY,
+									ephemeris->sunZZZ);
+					inViewList[threadArgs->inViewCnt]	=	objIdx;
+					threadArgs->inViewCnt++;
+				}
+			}
+		}
+	}
+}
+
+//*****************************************************************************
+static void	*AsteroidEphemeris_Thread(void *arg)
+{
+	AsteroidEphemeris_UpdateRows((TYPE_AsteroidThreadArgs *)arg);
+	return(NULL);
+}
+
+//*****************************************************************************
+void	AsteroidEphemeris_Free(void)
+{
+	if (gAsteroidEphemeris.knotJulian != NULL)
+	{
+		free(gAsteroidEphemeris.knotJulian);
+	}
+	if (gAsteroidEphemeris.exactJulian != NULL)
+	{
+		free(gAsteroidEphemeris.exactJulian);
+	}
+	if (gAsteroidEphemeris.knot0 != NULL)
+	{
+		free(gAsteroidEphemeris.knot0);
+	}
+	if (gAsteroidEphemeris.knot1 != NULL)
+	{
+		free(gAsteroidEphemeris.knot1);
+	}
+	if (gAsteroidEphemeris.magnitude != NULL)
+	{
+		free(gAsteroidEphemeris.magnitude);
+	}
+	if (gAsteroidEphemeris.inViewList != NULL)
+	{
+		free(gAsteroidEphemeris.inViewList);
+	}
+	memset((void *)&gAsteroidEphemeris, 0, sizeof(TYPE_AsteroidEphemeris));
+}
+
+//*****************************************************************************
+static bool	AsteroidEphemeris_Setup(TYPE_Asteroid *asteroidData, const long asteroidCnt)
+{
+long	iii;
+
+	if ((gAsteroidEphemeris.asteroidData != asteroidData) || (gAsteroidEphemeris.asteroidCnt != asteroidCnt))
+	{
+		AsteroidEphemeris_Free();
+		gAsteroidEphemeris.knotJulian	=	(double *)calloc(asteroidCnt, sizeof(double));
+		gAsteroidEphemeris.exactJulian	=	(double *)calloc(asteroidCnt, sizeof(double));
+		gAsteroidEphemeris.knot0		=	(double *)malloc(asteroidCnt * kKnotValues * sizeof(double));
+		gAsteroidEphemeris.knot1		=	(double *)malloc(asteroidCnt * kKnotValues * sizeof(double));
+		gAsteroidEphemeris.magnitude	=	(float *)malloc(asteroidCnt * sizeof(float));
+		gAsteroidEphemeris.inViewList	=	(long *)malloc(asteroidCnt * sizeof(long));
+		if ((gAsteroidEphemeris.knotJulian != NULL) && (gAsteroidEphemeris.exactJulian != NULL) &&
+			(gAsteroidEphemeris.knot0 != NULL) &&
+			(gAsteroidEphemeris.knot1 != NULL) && (gAsteroidEphemeris.magnitude != NULL) &&
+			(gAsteroidEphemeris.inViewList != NULL))
+		{
+			for (iii=0; iii<asteroidCnt; iii++)
+			{
+				gAsteroidEphemeris.magnitude[iii]	=	asteroidData[iii].StarData.realMagnitude;
+				if (asteroidData[iii].Eccentricity >= 1.0)
+				{
+					gAsteroidEphemeris.magnitude[iii]	=	kNeverDrawn;
+				}
+			}
+			gAsteroidEphemeris.asteroidData	=	asteroidData;
+			gAsteroidEphemeris.asteroidCnt	=	asteroidCnt;
+		}
+		else
+		{
+			CONSOLE_DEBUG("Failed to allocate asteroid knot cache");
+			AsteroidEphemeris_Free();
+		}
+	}
+	return(gAsteroidEphemeris.asteroidData != NULL);
+}
+
+//*****************************************************************************
+//*	returns the number of asteroids that passed the cull,
+//*	AsteroidEphemeris_GetInViewList() returns their indices
+//*****************************************************************************
+long	AsteroidEphemeris_Update(	TYPE_Asteroid			*asteroidData,
+									const long				asteroidCnt,
+									const double			targetJulianDate,	//*	julian Date
+									const double			sun_rtAscen,		//*	radians
+									const double			sun_decl,			//*	radians
+									const double			sun_dist,			//*	AU
+									const TYPE_AsteroidCull	*cullParams)		//*	NULL for everything
+{
+TYPE_AsteroidThreadArgs	threadArgs[kAsteroidMaxThreads];
+pthread_t				threadIDs[kAsteroidMaxThreads];
+bool					threadStarted[kAsteroidMaxThreads];
+int						threadCnt;
+int						cpuCount;
+int						iii;
+long					rowsPerThread;
+long					inViewCnt;
+
+	inViewCnt	=	0;
+	if ((asteroidData != NULL) && (asteroidCnt > 0) && AsteroidEphemeris_Setup(asteroidData, asteroidCnt))
+	{
+		//*	[MAA] Equation (7.20) page 34
+		gAsteroidEphemeris.targetJulian	=	targetJulianDate;
+		gAsteroidEphemeris.sunXXX		=	sun_dist * cos(sun_rtAscen) * cos(sun_decl);
+		gAsteroidEphemeris.sunYYY		=	sun_dist * sin(sun_rtAscen) * cos(sun_decl);
+		gAsteroidEphemeris.sunZZZ		=	sun_dist * sin(sun_decl);
+
+		threadCnt	=	asteroidCnt / kAsteroidThreadMinObjects;
+		cpuCount	=	sysconf(_SC_NPROCESSORS_ONLN);
+		if (threadCnt > cpuCount)
+		{
+			threadCnt	=	cpuCount;
+		}
+		if (threadCnt > kAsteroidMaxThreads)
+		{
+			threadCnt	=	kAsteroidMaxThreads;
+		}
+		if (threadCnt < 1)
+		{
+			threadCnt	=	1;
+		}
+
+		rowsPerThread	=	(asteroidCnt + threadCnt - 1) / threadCnt;
+		for (iii=0; iii<threadCnt; iii++)
+		{
+			threadArgs[iii].ephemeris		=	&gAsteroidEphemeris;
+			threadArgs[iii].startIdx		=	iii * rowsPerThread;
+			threadArgs[iii].stopIdx			=	threadArgs[iii].startIdx + rowsPerThread;
+			threadArgs[iii].lowerKnot		=	floor(targetJulianDate / kAsteroidKnotDays) * kAsteroidKnotDays;
+			threadArgs[iii].magnitudeLimit	=	(kNeverDrawn / 2.0);
+			threadArgs[iii].cullRegion		=	((cullParams != NULL) && (cullParams->viewRadius < M_PI));
+			threadArgs[iii].viewXXX			=	0.0;
+			threadArgs[iii].viewYYY			=	0.0;
+			threadArgs[iii].viewZZZ			=	0.0;
+			threadArgs[iii].cosViewRadius	=	-1.0;
+			if (cullParams != NULL)
+			{
+				threadArgs[iii].magnitudeLimit	=	cullParams->magnitudeLimit;
+			}
+			if (threadArgs[iii].cullRegion)
+			{
+				threadArgs[iii].viewXXX			=	cos(cullParams->viewRA) * cos(cullParams->viewDecl);
+				threadArgs[iii].viewYYY			=	sin(cullParams->viewRA) * cos(cullParams->viewDecl);
+				threadArgs[iii].viewZZZ			=	sin(cullParams->viewDecl);
+				threadArgs[iii].cosViewRadius	=	cos(cullParams->viewRadius);
+			}
+			if (threadArgs[iii].stopIdx > asteroidCnt)
+			{
+				threadArgs[iii].stopIdx	=	asteroidCnt;
+			}
+			threadStarted[iii]				=	false;
+		}
+
+		//*	the last block is done on this thread
+		for (iii=0; iii<(threadCnt - 1); iii++)
+		{
+			if (pthread_create(&threadIDs[iii], NULL, &AsteroidEphemeris_Thread, &threadArgs[iii]) == 0)
+			{
+				threadStarted[iii]	=	true;
+			}
+			else
+			{
+				CONSOLE_DEBUG("pthread_create failed");
+				AsteroidEphemeris_Thread(&threadArgs[iii]);
+			}
+		}
+		AsteroidEphemeris_Thread(&threadArgs[threadCnt - 1]);
+
+		//*	pack the lists from each thread together
+		for (iii=0; iii<threadCnt; iii++)
+		{
+			if ((iii < (threadCnt - 1)) && threadStarted[iii])
+			{
+				pthread_join(threadIDs[iii], NULL);
+			}
+			if ((inViewCnt != threadArgs[iii].startIdx) && (threadArgs[iii].inViewCnt > 0))
+			{
+				memmove(&gAsteroidEphemeris.inViewList[inViewCnt],
+						&gAsteroidEphemeris.inViewList[threadArgs[iii].startIdx],
+						threadArgs[iii].inViewCnt * sizeof(long));
+			}
+			inViewCnt	+=	threadArgs[iii].inViewCnt;
+		}
+		gAsteroidEphemeris.inViewCnt	=	inViewCnt;
+	}
+	return(inViewCnt);
+}
+
+//*****************************************************************************
+//*	the indices of the asteroids that passed the cull in the last update
+//*****************************************************************************
+long	*AsteroidEphemeris_GetInViewList(long *inViewCnt)
+{
+	*inViewCnt	=	gAsteroidEphemeris.inViewCnt;
+	return(gAsteroidEphemeris.inViewList);
+}
+
+//*****************************************************************************
+//*	exact position of one asteroid without the knot cache,
+//*	for objects that may have been culled (i.e. search)
+//*****************************************************************************
+void	AsteroidEphemeris_UpdateOne(TYPE_Asteroid	*asteroid,
+									const double	targetJulianDate,	//*	julian Date
+									const double	sun_rtAscen,		//*	radians
+									const double	sun_decl,			//*	radians
+									const double	sun_dist)			//*	AU
+{
+double	meanAnomaly;
+double	eccentricity;
+double	sinE;
+double	cosE;
+double	knot[kKnotValues];
+double	sunXXX;
+double	sunYYY;
+double	sunZZZ;
+double	xi;
+double	eta;
+double	zeta;
+
+	if (asteroid->Eccentricity < 1.0)
+	{
+		meanAnomaly		=	GetMeanAnomaly(asteroid, targetJulianDate);
+		eccentricity	=	asteroid->Eccentricity;
+		SolveKepler(1, &meanAnomaly, &eccentricity, &sinE, &cosE);
+		GetHeliocentric(asteroid, sinE, cosE, knot);
+
+		sunXXX	=	sun_dist * cos(sun_rtAscen) * cos(sun_decl);
+		sunYYY	=	sun_dist * sin(sun_rtAscen) * cos(sun_decl);
+		sunZZZ	=	sun_dist * sin(sun_decl);
+		xi		=	knot[0] + sunXXX;
+		eta		=	knot[1] + sunYYY;
+		zeta	=	knot[2] + sunZZZ;
+		SetGeocentric(	asteroid,
+						xi,
+						eta,
+						zeta,
+						sqrt((xi * xi) + (eta * eta) + (zeta * zeta)),
+						targetJulianDate,
+						sunXXX,
+						sunYYY,
+						sunZZZ);
+	}
+}
+
+#ifdef _INCLUDE_ASTEROID_EPHEM_MAIN_
+#include	<sys/time.h>
+
+//*****************************************************************************
+static double	GetElapsedMilliSecs(struct timeval *startTime)
+{
+struct timeval	endTime;
+
+	gettimeofday(&endTime, NULL);
+	return(((endTime.tv_sec - startTime->tv_sec) * 1000.0) + ((endTime.tv_usec - startTime->tv_usec) / 1000.0));
+}
+
+//*****************************************************************************
+//*	copy of KeplersEquations_CalcE() from AsteroidData.c
+//*****************************************************************************
+static double	OriginalKeplersEquations_CalcE(int loopMax, double MMM_radians, double eccentricity)
+{
+double	myEEE;
+int		loopCnt;
+double	previousEEE;
+double	deltaEEE;
+
+	loopCnt		=	0;
+	myEEE		=	MMM_radians;	//*	initial value
+	deltaEEE	=	1;
+	while ((loopCnt < loopMax) && (deltaEEE > 0.00000001))
+	{
+		previousEEE	=	myEEE;
+		myEEE		=	MMM_radians + (eccentricity * sin(myEEE));
+		deltaEEE	=	fabs(myEEE - previousEEE);
+		loopCnt++;
+	}
+	return(myEEE);
+}
+
+//*****************************************************************************
+//*	the math from ComputeAsteroidData_Dynamic() in AsteroidData.c
+//*****************************************************************************
+static void	OriginalUpdate(	TYPE_Asteroid	*asteroidData,
+							const long		asteroidCnt,
+							const double	targetJulianDate,
+							const double	sunXXX,
+							const double	sunYYY,
+							const double	sunZZZ)
+{
+long	iii;
+double	actualAnomaly_M;
+double	eccentricAnomaly_E;
+double	a_cosE_minus_e;
+double	a_sqrt_1_minus_e_sqrd;
+double	sinE;
+double	xi;
+double	eta;
+double	zeta;
+double	deltaEarth;
+
+	for (iii=0; iii<asteroidCnt; iii++)
+	{
+		actualAnomaly_M			=	asteroidData[iii].MeanAnomaly +
+									(asteroidData[iii].n0_dailyMotion_deg * (targetJulianDate - asteroidData[iii].epochJulian));
+		eccentricAnomaly_E		=	OriginalKeplersEquations_CalcE(50, RADIANS(actualAnomaly_M), asteroidData[iii].Eccentricity);
+		a_cosE_minus_e			=	asteroidData[iii].SemimajorAxis * (cos(eccentricAnomaly_E) - asteroidData[iii].Eccentricity);
+		a_sqrt_1_minus_e_sqrd	=	asteroidData[iii].SemimajorAxis *
+									sqrt(1.0 - (asteroidData[iii].Eccentricity * asteroidData[iii].Eccentricity));
+		sinE					=	sin(eccentricAnomaly_E);
+
+		xi			=	(a_cosE_minus_e * asteroidData[iii].Px) + (a_sqrt_1_minus_e_sqrd * asteroidData[iii].Qx * sinE) + sunXXX;
+		eta			=	(a_cosE_minus_e * asteroidData[iii].Py) + (a_sqrt_1_minus_e_sqrd * asteroidData[iii].Qy * sinE) + sunYYY;
+		zeta		=	(a_cosE_minus_e * asteroidData[iii].Pz) + (a_sqrt_1_minus_e_sqrd * asteroidData[iii].Qz * sinE) + sunZZZ;
+		deltaEarth	=	sqrt((xi * xi) + (eta * eta) + (zeta * zeta));
+
+		asteroidData[iii].StarData.decl	=	asin(zeta / deltaEarth);
+		asteroidData[iii].StarData.ra	=	atan2(eta, xi);
+	}
+}
+
+//*****************************************************************************
+//*	the P and Q vectors, same as ComputeAsteroidData_Static() in AsteroidData.c
+//*****************************************************************************
+static void	SetupOrbit(TYPE_Asteroid *asteroid)
+{
+double	omegaL;
+double	omegaU;
+double	inclination;
+double	ecliptic;
+double	alpha1, alpha2, beta1, beta2, gama1, gama2;
+
+	omegaL		=	RADIANS(asteroid->ArgOfPerihelion);
+	omegaU		=	RADIANS(asteroid->Longitude);
+	inclination	=	RADIANS(asteroid->Inclination);
+	ecliptic	=	RADIANS(23.0 + (26.0 / 60.0) + (21.45 / 3600.0));
+
+	alpha1		=	sin(omegaU) * sin(omegaL);
+	alpha2		=	sin(omegaU) * cos(omegaL);
+	beta1		=	cos(omegaU) * sin(omegaL);
+	beta2		=	cos(omegaU) * cos(omegaL);
+	gama1		=	sin(inclination) * sin(omegaL);
+	gama2		=	sin(inclination) * cos(omegaL);
+
+	asteroid->Px	=	beta2 - (alpha1 * cos(inclination));
+	asteroid->Py	=	((alpha2 + (beta1 * cos(inclination))) * cos(ecliptic)) - (gama1 * sin(ecliptic));
+	asteroid->Pz	=	((alpha2 + (beta1 * cos(inclination))) * sin(ecliptic)) + (gama1 * cos(ecliptic));
+	asteroid->Qx	=	-beta1 - (alpha2 * cos(inclination));
+	asteroid->Qy	=	((-alpha1 + (beta2 * cos(inclination))) * cos(ecliptic)) - (gama2 * sin(ecliptic));
+	asteroid->Qz	=	((-alpha1 + (beta2 * cos(inclination))) * sin(ecliptic)) + (gama2 * cos(ecliptic));
+
+	asteroid->n0_dailyMotion_deg			=	360.0 / (sqrt(pow(asteroid->SemimajorAxis, 3.0)) * 365.256);
+	asteroid->StarData.realMagnitude		=	asteroid->AbsoluteMagnitude;
+}
+
+//*****************************************************************************
+//*	angle between two positions in arc-seconds
+//*****************************************************************************
+static double	AngularSeparation(double ra1, double decl1, double ra2, double decl2)
+{
+double	cosAngle;
+
+	cosAngle	=	(sin(decl1) * sin(decl2)) + (cos(decl1) * cos(decl2) * cos(ra1 - ra2));
+	if (cosAngle > 1.0)
+	{
+		cosAngle	=	1.0;
+	}
+	return(DEGREES(acos(cosAngle)) * 3600.0);
+}
+
+//*****************************************************************************
+static double	RandomValue(const double minValue, const double maxValue)
+{
+	return(minValue + ((maxValue - minValue) * random() / RAND_MAX));
+}
+
+//*****************************************************************************
+int	main(int argc, char *argv[])
+{
+long				asteroidCnt;
+long				iii;
+int					frameCnt;
+TYPE_Asteroid		*originalData;
+TYPE_Asteroid		*engineData;
+TYPE_AsteroidCull	cullParams;
+struct timeval		startTime;
+double				targetJulian;
+double				sun_rtAscen;
+double				sun_decl;
+double				sun_dist;
+double				sunXXX, sunYYY, sunZZZ;
+double				milliSecs_Original;
+double				milliSecs_FirstUpdate;
+double				milliSecs_Redraw;
+double				milliSecs_FirstStep;
+double				milliSecs_Animate;
+double				milliSecs_AnimateOriginal;
+double				milliSecs_Culled;
+double				separation;
+double				maxSeparation;
+double				maxSeparationNEO;
+double				maxExact;
+long				inViewCnt;
+
+	asteroidCnt	=	1161751;	//*	size of the MPC file
+	if (argc > 1)
+	{
+		asteroidCnt	=	atol(argv[1]);
+	}
+	printf("Asteroid ephemeris benchmark, %ld objects, %ld cpus\r\n", asteroidCnt, sysconf(_SC_NPROCESSORS_ONLN));
+
+	originalData	=	(TYPE_Asteroid *)calloc(asteroidCnt, sizeof(TYPE_Asteroid));
+	engineData		=	(TYPE_Asteroid *)calloc(asteroidCnt, sizeof(TYPE_Asteroid));
+	if ((originalData == NULL) || (engineData == NULL))
+	{
+		printf("Failed to allocate memory\r\n");
+		return(1);
+	}
+
+	//*	main belt orbits, with 2% near earth objects up to e = 0.9
+	srandom(1234);
+	for (iii=0; iii<asteroidCnt; iii++)
+	{
+		if ((iii % 50) == 0)
+		{
+			originalData[iii].SemimajorAxis	=	RandomValue(0.8, 3.0);
+			originalData[iii].Eccentricity	=	RandomValue(0.3, 0.9);
+		}
+		else
+		{
+			originalData[iii].SemimajorAxis	=	RandomValue(2.1, 3.3);
+			originalData[iii].Eccentricity	=	RandomValue(0.0, 0.3);
+		}
+		originalData[iii].Inclination		=	RandomValue(0.0, 30.0);
+		originalData[iii].ArgOfPerihelion	=	RandomValue(0.0, 360.0);
+		originalData[iii].Longitude			=	RandomValue(0.0, 360.0);
+		originalData[iii].MeanAnomaly		=	RandomValue(0.0, 360.0);
+		originalData[iii].AbsoluteMagnitude	=	RandomValue(3.0, 20.0);
+		originalData[iii].epochJulian		=	2460600.5;
+		SetupOrbit(&originalData[iii]);
+	}
+	memcpy(engineData, originalData, asteroidCnt * sizeof(TYPE_Asteroid));
+
+	//*	a fixed sun position, the benchmark does not care where the earth is
+	targetJulian	=	2461000.3;
+	sun_rtAscen		=	RADIANS(200.0);
+	sun_decl		=	RADIANS(-10.0);
+	sun_dist		=	0.99;
+	sunXXX			=	sun_dist * cos(sun_rtAscen) * cos(sun_decl);
+	sunYYY			=	sun_dist * sin(sun_rtAscen) * cos(sun_decl);
+	sunZZZ			=	sun_dist * sin(sun_decl);
+
+	//*	one redraw with the original code
+	gettimeofday(&startTime, NULL);
+	OriginalUpdate(originalData, asteroidCnt, targetJulian, sunXXX, sunYYY, sunZZZ);
+	milliSecs_Original	=	GetElapsedMilliSecs(&startTime);
+
+	//*	the first update solves once at the exact time
+	gettimeofday(&startTime, NULL);
+	AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian, sun_rtAscen, sun_decl, sun_dist, NULL);
+	milliSecs_FirstUpdate	=	GetElapsedMilliSecs(&startTime);
+
+	//*	only the orbits where the original iteration converges
+	maxExact	=	0.0;
+	for (iii=0; iii<asteroidCnt; iii++)
+	{
+		separation	=	AngularSeparation(	originalData[iii].StarData.ra,	originalData[iii].StarData.decl,
+											engineData[iii].StarData.ra,	engineData[iii].StarData.decl);
+		if ((originalData[iii].Eccentricity < 0.6) && (separation > maxExact))
+		{
+			maxExact	=	separation;
+		}
+	}
+
+	//*	redraw without changing the time (i.e. panning)
+	gettimeofday(&startTime, NULL);
+	AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian, sun_rtAscen, sun_decl, sun_dist, NULL);
+	milliSecs_Redraw	=	GetElapsedMilliSecs(&startTime);
+
+	//*	animate one day in 10 minute steps, the first step sets up the knots, one knot gets crossed
+	gettimeofday(&startTime, NULL);
+	AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian + (1 / 144.0), sun_rtAscen, sun_decl, sun_dist, NULL);
+	milliSecs_FirstStep	=	GetElapsedMilliSecs(&startTime);
+
+	frameCnt	=	143;
+	gettimeofday(&startTime, NULL);
+	for (iii=2; iii<=(frameCnt + 1); iii++)
+	{
+		AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian + (iii / 144.0), sun_rtAscen, sun_decl, sun_dist, NULL);
+	}
+	milliSecs_Animate	=	GetElapsedMilliSecs(&startTime) / frameCnt;
+
+	//*	accuracy of the interpolation, the last frame is part way between two knots
+	OriginalUpdate(originalData, asteroidCnt, targetJulian + ((frameCnt + 1) / 144.0), sunXXX, sunYYY, sunZZZ);
+	maxSeparation		=	0.0;
+	maxSeparationNEO	=	0.0;
+	for (iii=0; iii<asteroidCnt; iii++)
+	{
+		separation	=	AngularSeparation(	originalData[iii].StarData.ra,	originalData[iii].StarData.decl,
+											engineData[iii].StarData.ra,	engineData[iii].StarData.decl);
+		if ((iii % 50) != 0)
+		{
+			if (separation > maxSeparation)
+			{
+				maxSeparation	=	separation;
+			}
+		}
+		else if ((originalData[iii].Eccentricity < 0.6) && (separation > maxSeparationNEO))
+		{
+			maxSeparationNEO	=	separation;
+		}
+	}
+
+	gettimeofday(&startTime, NULL);
+	for (iii=1; iii<=10; iii++)
+	{
+		OriginalUpdate(originalData, asteroidCnt, targetJulian + (iii / 144.0), sunXXX, sunYYY, sunZZZ);
+	}
+	milliSecs_AnimateOriginal	=	GetElapsedMilliSecs(&startTime) / 10;
+
+	//*	zoomed in, 10 degree field and magnitude 14 limit
+	cullParams.viewRA			=	RADIANS(30.0);
+	cullParams.viewDecl			=	RADIANS(10.0);
+	cullParams.viewRadius		=	RADIANS(7.1);
+	cullParams.magnitudeLimit	=	14.0;
+	AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian, sun_rtAscen, sun_decl, sun_dist, &cullParams);
+	gettimeofday(&startTime, NULL);
+	inViewCnt	=	AsteroidEphemeris_Update(engineData, asteroidCnt, targetJulian + 0.01, sun_rtAscen, sun_decl, sun_dist, &cullParams);
+	milliSecs_Culled	=	GetElapsedMilliSecs(&startTime);
+
+	printf("Original, one redraw          \t%10.2f ms\r\n",	milliSecs_Original);
+	printf("Engine, first update          \t%10.2f ms\r\n",	milliSecs_FirstUpdate);
+	printf("Engine, redraw at same time   \t%10.2f ms\r\n",	milliSecs_Redraw);
+	printf("Engine, first step (knots)    \t%10.2f ms\r\n",	milliSecs_FirstStep);
+	printf("Engine, animating (per frame) \t%10.2f ms\r\n",	milliSecs_Animate);
+	printf("Original, animating (per frame)\t%10.2f ms\r\n",	milliSecs_AnimateOriginal);
+	printf("Engine, 10 deg field, mag 14  \t%10.2f ms (%ld in view)\r\n",	milliSecs_Culled, inViewCnt);
+	printf("Max difference, exact, e < 0.6\t%10.4f arc-seconds\r\n",	maxExact);
+	printf("Max difference, main belt     \t%10.4f arc-seconds\r\n",	maxSeparation);
+	printf("Max difference, e < 0.6 NEOs  \t%10.4f arc-seconds\r\n",	maxSeparationNEO);
+
+	AsteroidEphemeris_Free();
+	free(originalData);
+	free(engineData);
+	return(0);
+}
+#endif // _INCLUDE_ASTEROID_EPHEM_MAIN_
+
+#endif // _ENABLE_ASTEROIDS_
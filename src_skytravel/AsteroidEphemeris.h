@@ -0,0 +1,56 @@
+//*****************************************************************************
+//*	AsteroidEphemeris.h
+//*****************************************************************************
+//#include	"AsteroidEphemeris.h"
+
+#ifndef _ASTEROID_EPHEMERIS_H_
+#define	_ASTEROID_EPHEMERIS_H_
+
+#ifndef _ASTEROID_DATA_H_
+	#include	"AsteroidData.h"
+#endif
+
+#define	kAsteroidKnotDays			2.0		//*	spacing of the cached positions
+#define	kAsteroidBlockSize			256		//*	objects per pass through the Kepler solver
+#define	kAsteroidNewtonSteps		4		//*	done on every object in the block, more if needed
+#define	kAsteroidNewtonMaxSteps		50
+#define	kAsteroidThreadMinObjects	20000	//*	don't start a thread for less than this
+#define	kAsteroidMaxThreads			8
+
+//*****************************************************************************
+//*	anything fainter than magnitudeLimit or farther than viewRadius from the
+//*	center of the view is skipped and left out of the in view list
+//*****************************************************************************
+typedef struct
+{
+	double	viewRA;				//*	radians
+	double	viewDecl;			//*	radians
+	double	viewRadius;			//*	radians, >= PI means the whole sky
+	double	magnitudeLimit;
+} TYPE_AsteroidCull;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+long	AsteroidEphemeris_Update(	TYPE_Asteroid			*asteroidData,
+									const long				asteroidCnt,
+									const double			targetJulianDate,	//*	julian Date
+									const double			sun_rtAscen,		//*	radians
+									const double			sun_decl,			//*	radians
+									const double			sun_dist,			//*	AU
+									const TYPE_AsteroidCull	*cullParams);		//*	NULL for everything
+long	*AsteroidEphemeris_GetInViewList(long *inViewCnt);
+void	AsteroidEphemeris_UpdateOne(TYPE_Asteroid	*asteroid,
+									const double	targetJulianDate,	//*	julian Date
+									const double	sun_rtAscen,		//*	radians
+									const double	sun_decl,			//*	radians
+									const double	sun_dist);			//*	AU
+void	AsteroidEphemeris_Free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _ASTEROID_EPHEMERIS_H_
@@ -0,0 +1,244 @@
+//*****************************************************************************
+//*	CatalogCache.c
+//*
+//*	Binary cache of the parsed star catalogs.
+//*	The first time a catalog is read, the parsed TYPE_CelestData array is saved
+//*	next to the source file as <source>.stcache. After that the cache file is
+//*	mmap'ed instead of parsing megabytes of text.
+//*	The cache is only used if the size and modification time of the source file
+//*	match what was saved, and the record size matches this build.
+//*
+//*	The mapping is MAP_PRIVATE, the pages come from the OS page cache and are
+//*	only copied if the data is modified (i.e. precession).
+//*	Arrays returned by CatalogCache_Read() must be released with CatalogCache_Free().
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created CatalogCache.c
+//*****************************************************************************
+
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+#include	<stdint.h>
+#include	<unistd.h>
+#include	<fcntl.h>
+#include	<errno.h>
+#include	<sys/stat.h>
+#include	<sys/mman.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"SkyStruc.h"
+#include	"CatalogCache.h"
+
+//*****************************************************************************
+typedef struct
+{
+	void			*mapAddress;
+	size_t			mapLength;
+	TYPE_CelestData	*objects;
+} TYPE_CatalogCacheMap;
+
+static	TYPE_CatalogCacheMap	gCatalogCacheMaps[kMaxCatalogCacheMaps];
+
+//*****************************************************************************
+static void	GetCacheFilePath(const char *sourceFilePath, char *cacheFilePath, size_t maxLen)
+{
+	snprintf(cacheFilePath, maxLen, "%s%s", sourceFilePath, kCatalogCacheExtension);
+}
+
+//*****************************************************************************
+//*	same order as CelestObjDeclinationQsortProc() in windowtab_skytravel.cpp,
+//*	north to south, but on the J2000 declination
+//*****************************************************************************
+static int	CatalogCacheDeclinationQsortProc(const void *e1, const void *e2)
+{
+TYPE_CelestData	*obj1	=	(TYPE_CelestData *)e1;
+TYPE_CelestData	*obj2	=	(TYPE_CelestData *)e2;
+int				returnValue;
+
+	returnValue	=	0;
+	if (obj1->org_decl < obj2->org_decl)
+	{
+		returnValue	=	1;
+	}
+	else if (obj1->org_decl > obj2->org_decl)
+	{
+		returnValue	=	-1;
+	}
+	return(returnValue);
+}
+
+//*****************************************************************************
+//*	returns NULL if there is no cache or it is out of date
+//*****************************************************************************
+TYPE_CelestData	*CatalogCache_Read(const char *sourceFilePath, long *objectCount)
+{
+TYPE_CelestData			*objects;
+TYPE_CatalogCacheHeader	cacheHeader;
+char					cacheFilePath[512];
+struct stat				sourceStatus;
+struct stat				cacheStatus;
+int						cacheFD;
+int						mapIdx;
+ssize_t					bytesRead;
+size_t					expectedSize;
+void					*mapAddress;
+
+	objects	=	NULL;
+	GetCacheFilePath(sourceFilePath, cacheFilePath, sizeof(cacheFilePath));
+	if (stat(sourceFilePath, &sourceStatus) == 0)
+	{
+		cacheFD	=	open(cacheFilePath, O_RDONLY);
+		if (cacheFD >= 0)
+		{
+			memset(&cacheHeader, 0, sizeof(TYPE_CatalogCacheHeader));
+			bytesRead	=	pread(cacheFD, &cacheHeader, sizeof(TYPE_CatalogCacheHeader), 0);
+			fstat(cacheFD, &cacheStatus);
+			expectedSize	=	kCatalogCacheHeaderSize + (cacheHeader.objectCount * sizeof(TYPE_CelestData));
+			if ((bytesRead == sizeof(TYPE_CatalogCacheHeader)) &&
+				(strncmp(cacheHeader.magic, kCatalogCacheMagic, sizeof(cacheHeader.magic)) == 0) &&
+				(cacheHeader.version == kCatalogCacheVersion) &&
+				(cacheHeader.recordSize == sizeof(TYPE_CelestData)) &&
+				(cacheHeader.headerSize == kCatalogCacheHeaderSize) &&
+				(cacheHeader.sourceSize == sourceStatus.st_size) &&
+				(cacheHeader.sourceMtime_sec == sourceStatus.st_mtim.tv_sec) &&
+				(cacheHeader.sourceMtime_nsec == sourceStatus.st_mtim.tv_nsec) &&
+				(cacheHeader.objectCount > 0) &&
+				((size_t)cacheStatus.st_size == expectedSize))
+			{
+				//*	find a slot to remember the mapping in
+				mapIdx	=	0;
+				while ((mapIdx < kMaxCatalogCacheMaps) && (gCatalogCacheMaps[mapIdx].mapAddress != NULL))
+				{
+					mapIdx++;
+				}
+				if (mapIdx < kMaxCatalogCacheMaps)
+				{
+					mapAddress	=	mmap(NULL, expectedSize, (PROT_READ | PROT_WRITE), MAP_PRIVATE, cacheFD, 0);
+					if (mapAddress != MAP_FAILED)
+					{
+						objects									=	(TYPE_CelestData *)((char *)mapAddress + kCatalogCacheHeaderSize);
+						gCatalogCacheMaps[mapIdx].mapAddress	=	mapAddress;
+						gCatalogCacheMaps[mapIdx].mapLength		=	expectedSize;
+						gCatalogCacheMaps[mapIdx].objects		=	objects;
+						*objectCount							=	cacheHeader.objectCount;
+					}
+					else
+					{
+						CONSOLE_DEBUG_W_STR("mmap failed:", cacheFilePath);
+					}
+				}
+				else
+				{
+					CONSOLE_DEBUG("Out of cache map entries");
+				}
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_STR("Cache is out of date:", cacheFilePath);
+			}
+			close(cacheFD);
+		}
+	}
+	return(objects);
+}
+
+//*****************************************************************************
+//*	the objects are sorted by declination before they are saved
+//*	so that the cached and parsed data come back in the same order.
+//*	Failing to save is not an error, it just means parsing again next time
+//*****************************************************************************
+bool	CatalogCache_Save(const char *sourceFilePath, TYPE_CelestData *objects, const long objectCount)
+{
+TYPE_CatalogCacheHeader	cacheHeader;
+char					cacheFilePath[512];
+char					tempFilePath[540];
+char					headerBuffer[kCatalogCacheHeaderSize];
+struct stat				sourceStatus;
+FILE					*filePointer;
+size_t					recordsWritten;
+bool					cacheSaved;
+
+	cacheSaved	=	false;
+	if ((objects != NULL) && (objectCount > 0) && (stat(sourceFilePath, &sourceStatus) == 0))
+	{
+		qsort(objects, objectCount, sizeof(TYPE_CelestData), CatalogCacheDeclinationQsortProc);
+
+		memset(&cacheHeader, 0, sizeof(TYPE_CatalogCacheHeader));
+		strcpy(cacheHeader.magic, kCatalogCacheMagic);
+		cacheHeader.version				=	kCatalogCacheVersion;
+		cacheHeader.recordSize			=	sizeof(TYPE_CelestData);
+		cacheHeader.headerSize			=	kCatalogCacheHeaderSize;
+		cacheHeader.sourceSize			=	sourceStatus.st_size;
+		cacheHeader.sourceMtime_sec		=	sourceStatus.st_mtim.tv_sec;
+		cacheHeader.sourceMtime_nsec	=	sourceStatus.st_mtim.tv_nsec;
+		cacheHeader.objectCount			=	objectCount;
+
+		memset(headerBuffer, 0, kCatalogCacheHeaderSize);
+		memcpy(headerBuffer, &cacheHeader, sizeof(TYPE_CatalogCacheHeader));
+
+		//*	write to a temp file and rename it so nobody ever maps a partial file
+		GetCacheFilePath(sourceFilePath, cacheFilePath, sizeof(cacheFilePath));
+		snprintf(tempFilePath, sizeof(tempFilePath), "%s.%d", cacheFilePath, getpid());
+		filePointer	=	fopen(tempFilePath, "w");
+		if (filePointer != NULL)
+		{
+			recordsWritten	=	0;
+			if (fwrite(headerBuffer, kCatalogCacheHeaderSize, 1, filePointer) == 1)
+			{
+				recordsWritten	=	fwrite(objects, sizeof(TYPE_CelestData), objectCount, filePointer);
+			}
+			if ((fclose(filePointer) == 0) && (recordsWritten == (size_t)objectCount))
+			{
+				if (rename(tempFilePath, cacheFilePath) == 0)
+				{
+					cacheSaved	=	true;
+				}
+			}
+			if (cacheSaved == false)
+			{
+				CONSOLE_DEBUG_W_STR("Failed to save:", cacheFilePath);
+				unlink(tempFilePath);
+			}
+		}
+		else
+		{
+			CONSOLE_DEBUG_W_STR("Unable to create:", tempFilePath);
+		}
+	}
+	return(cacheSaved);
+}
+
+//*****************************************************************************
+//*	releases a catalog array from CatalogCache_Read() or one that was malloc'ed
+//*****************************************************************************
+void	CatalogCache_Free(TYPE_CelestData *objects)
+{
+int		mapIdx;
+bool	wasMapped;
+
+	if (objects != NULL)
+	{
+		wasMapped	=	false;
+		for (mapIdx=0; mapIdx<kMaxCatalogCacheMaps; mapIdx++)
+		{
+			if (gCatalogCacheMaps[mapIdx].objects == objects)
+			{
+				munmap(gCatalogCacheMaps[mapIdx].mapAddress, gCatalogCacheMaps[mapIdx].mapLength);
+				memset(&gCatalogCacheMaps[mapIdx], 0, sizeof(TYPE_CatalogCacheMap));
+				wasMapped	=	true;
+				break;
+			}
+		}
+		if (wasMapped == false)
+		{
+			free(objects);
+		}
+	}
+}
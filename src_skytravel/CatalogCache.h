@@ -0,0 +1,53 @@
+//*****************************************************************************
+//*	CatalogCache.h
+//*****************************************************************************
+//#include	"CatalogCache.h"
+
+#ifndef _CATALOG_CACHE_H_
+#define	_CATALOG_CACHE_H_
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
+#ifndef _SKY_STRUCTS_H_
+	#include	"SkyStruc.h"
+#endif
+
+#define	kCatalogCacheMagic			"STCACHE"
+#define	kCatalogCacheVersion		1
+#define	kCatalogCacheExtension		".stcache"
+#define	kCatalogCacheHeaderSize		4096	//*	keeps the records page aligned
+#define	kMaxCatalogCacheMaps		16
+
+//*****************************************************************************
+//*	the cache file is this header, padded to kCatalogCacheHeaderSize,
+//*	followed by objectCount TYPE_CelestData records sorted by declination
+//*****************************************************************************
+typedef struct
+{
+	char		magic[8];
+	uint32_t	version;
+	uint32_t	recordSize;				//*	sizeof(TYPE_CelestData), the cache is rebuilt if it changes
+	uint32_t	headerSize;
+	uint32_t	spare;
+	int64_t		sourceSize;				//*	the cache is rebuilt if the source file changes
+	int64_t		sourceMtime_sec;
+	int64_t		sourceMtime_nsec;
+	int64_t		objectCount;
+} TYPE_CatalogCacheHeader;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+TYPE_CelestData	*CatalogCache_Read(const char *sourceFilePath, long *objectCount);
+bool			CatalogCache_Save(const char *sourceFilePath, TYPE_CelestData *objects, const long objectCount);
+void			CatalogCache_Free(TYPE_CelestData *objects);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CATALOG_CACHE_H_
@@ -11,6 +11,7 @@
 //*	Feb 18,	2021	<MLS> Constellation vectors now using proper Precessed RA/DEC values
 //*	Apr  3,	2021	<MLS> Fixed handling of spaces in ParseConstOutlineLongName()
 //*	Oct 27,	2021	<MLS> Fixed bug in constellation center calcs caused by negative RA values
+//*	Oct 18,	2026	<AGT> Hipparcos data is released with CatalogCache_Free()
 //*****************************************************************************
 
 
@@ -32,6 +33,7 @@
 
 #include	"ConstellationData.h"
 #include	"HipparcosCatalog.h"
+#include	"CatalogCache.h"
 
 TYPE_ConstVector	*gConstVecotrPtr	=	NULL;
 int					gConstVectorCnt		=	0;
@@ -149,7 +151,7 @@ bool	freeNeededFlag	=	false;
 			}
 			if (freeNeededFlag)
 			{
-				free(gHippData);
+				CatalogCache_Free(gHippData);
 			}
 		}
 //		CONSOLE_DEBUG_W_NUM("gFailedToFindCnt\t=", gFailedToFindCnt);
@@ -47,6 +47,11 @@
 //*	Dec 14,	2023	<MLS> OpenMysql() works for Keith but not from my house
 //*	Dec 14,	2023	<MLS> Keith turned off firewall at his house and it works fine.
 //*	Dec 14,	2023	<MLS> My IP address had changed back in June and we did not realize it
+//*	Oct 18,	2026	<AGT> Blocks are now fetched by the worker pool in GaiaTileCache.c
+//*	Oct 18,	2026	<AGT> Each worker keeps its SQL connection open between requests
+//*	Oct 18,	2026	<AGT> mysql_library_init() is called once, mysql_library_end() removed
+//*	Oct 18,	2026	<AGT> Added PrefetchSkyTravelView()
+//*	Oct 18,	2026	<AGT> Added "workers" keyword to sqlserver.txt
 //*****************************************************************************
 //*	sudo apt-get install libmysqlclient-dev		<<<< Use this one
 //*	sudo apt-get install libmariadb-dev			<<<< Use this for Raspberry-Pi
@@ -89,6 +94,7 @@
 #include	"readconfigfile.h"
 
 #include	"GaiaSQL.h"
+#include	"GaiaTileCache.h"
 #include	"RemoteGaia.h"
 
 
@@ -106,16 +112,10 @@ char			gSQLsever_StatusMsg[128]=	"";
 bool			gSQLsever_MsgUpdated	=	false;
 
 bool			gEnableSQLlogging		=	true;
+int				gSQLworkerCount			=	kGaiaTileDefaultWorkers;
 
 
-static			pthread_t	gSQL_ThreadID			=	-1;
-static			bool		gSQL_ThreadIsRunning	=	false;
-static			bool		gSQL_KeepRunning		=	false;
-
-TYPE_GAIA_REMOTE_DATA		gGaiaDataList[kMaxGaiaDataSets];
 static			bool		gGaiaDataListNeedsInit		=	true;
-static			bool		gSkyTravelUpdateOccured		=	false;
-static			int			gGaiaSQLsequenceNum			=	0;
 static			int			gGaiaStartThreadCnt			=	0;
 
 TYPE_DATABASE_NAME			gDataBaseNames[kMaxDataBaseNames];
@@ -146,6 +146,11 @@ static void	ProcessSQLConfig(const char *keyword, const char *valueString, void
 	{
 		strcpy(gSQLsever_Password, valueString);
 	}
+	else if (strcasecmp(keyword, "workers") == 0)
+	{
+		//*	number of simultaneous requests to the server
+		gSQLworkerCount	=	atoi(valueString);
+	}
 	else if (strcasecmp(keyword, "database") == 0)
 	{
 		//*	this is an entry to the list of possible data bases
@@ -247,18 +252,17 @@ int		linesRead;
 //*	returns true if valid config file
 bool	GaiaSQLinit(void)
 {
-int		iii;
 bool	configOK;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 	configOK	=	ReadSQLconfigFile();
-	//*	set the Gaia data list to all zeros
-	for (iii=0; iii<kMaxGaiaDataSets; iii++)
-	{
-		memset((void *)&gGaiaDataList[iii], 0, sizeof(TYPE_GAIA_REMOTE_DATA));
-	}
+	//*	the Gaia data list (gGaiaDataList) belongs to GaiaTileCache.c now
 	gGaiaDataListNeedsInit	=	false;
 
+	//*	has to be done before any threads use the library,
+	//*	mysql_init() would do it but it is not thread safe
+	mysql_library_init(0, NULL, NULL);
+
 #if defined(MYSQL_BASE_VERSION)
 	strcpy(gSQLclientVersion, MYSQL_BASE_VERSION);
 #elif defined(MARIADB_BASE_VERSION)
@@ -276,19 +280,8 @@ bool	configOK;
 //*****************************************************************************
 void	ClearAllSQLdata(void)
 {
-int		iii;
-
-	if (gGaiaDataListNeedsInit == false)
-	{
-		for (iii=0; iii<kMaxGaiaDataSets; iii++)
-		{
-			if (gGaiaDataList[iii].gaiaData != NULL)
-			{
-				free(gGaiaDataList[iii].gaiaData);
-			}
-			memset(&gGaiaDataList[iii], 0, sizeof(TYPE_GAIA_REMOTE_DATA));
-		}
-	}
+	//*	the tile store on disk is kept
+	GaiaTileCache_Clear();
 	gSQLerror_Count	=	0;
 }
 
@@ -490,7 +483,6 @@ char			userString[128];
 		LogSqlTransaction(gSQLsever_Database, "mysql_init() failed", __FUNCTION__, mysql_error(mySQLConnection));
 	}
 	mysql_close(mySQLConnection);
-	mysql_library_end();
 
 	return(returnCode);
 }
@@ -646,16 +638,20 @@ bool	foundIt;
 
 
 //*****************************************************************************
-static	TYPE_CelestData	*GetGAIAdataFromSQL(	double	ra_Degrees,
-												double	dec_Degrees,
-												long	*totalRecords,
-												bool	*successFlag)
+//*	the connection is opened and closed by the caller so that it can be kept
+//*	open between requests
+//*****************************************************************************
+static	TYPE_CelestData	*GetGAIAdataFromSQL(	MYSQL		*mySQLConnection,
+												const char	*dataBaseName,
+												double		ra_Degrees,
+												double		dec_Degrees,
+												long		*totalRecords,
+												bool		*successFlag)
 {
 TYPE_CelestData	*gaiaData;
 int				recNum;
 TYPE_CelestData	localStarData;
 //*	mySWQL Variables
-MYSQL 			*mySQLConnection = NULL;
 char			mySQLCmd[256];
 MYSQL_ROW		row;
 MYSQL_RES		*mySQLresult;
@@ -676,7 +672,6 @@ unsigned int	endMilliSecs;
 	*successFlag	=	false;
 	startMilliSecs	=	millis();
 
-	mySQLConnection	=	OpenMysql(gSQLsever_Database);
 	if (mySQLConnection != NULL)
 	{
 #ifdef _VERBOSE_SQL_DEBUG_
@@ -701,7 +696,7 @@ unsigned int	endMilliSecs;
 		mySQLresult	=	NULL;
 		num_fields	=	Querry_mySQL_cmd(	mySQLConnection,
 											&mySQLresult,
-											gSQLsever_Database,
+											dataBaseName,
 											mySQLCmd);
 #ifdef _VERBOSE_SQL_DEBUG_
 		CONSOLE_DEBUG_W_NUM("num_fields", num_fields);
@@ -800,12 +795,12 @@ unsigned int	endMilliSecs;
 			char	textBuff[128];
 
 				sprintf(textBuff, "Records rcvd=%d\tQuery time=%d", recNum, (endMilliSecs - startMilliSecs));
-				LogSqlTransaction(gSQLsever_Database, mySQLCmd, textBuff, "");
+				LogSqlTransaction(dataBaseName, mySQLCmd, textBuff, "");
 			}
 		}
 		else
 		{
-			LogSqlTransaction(gSQLsever_Database, mySQLCmd, "num_fields <= 0", mysql_error(mySQLConnection));
+			LogSqlTransaction(dataBaseName, mySQLCmd, "num_fields <= 0", mysql_error(mySQLConnection));
 		}
 		//	SQL-Error	2022-11-13	Keith says this goes here
 		mysql_free_result(mySQLresult);
@@ -815,10 +810,8 @@ unsigned int	endMilliSecs;
 	}
 	else
 	{
-		LogSqlTransaction(gSQLsever_Database, "mysql_init() failed", __FUNCTION__, mysql_error(mySQLConnection));
+		LogSqlTransaction(dataBaseName, "No connection", __FUNCTION__, "");
 	}
-	mysql_close(mySQLConnection);
-	mysql_library_end();
 
 	*totalRecords	=	recNum;
 	return(gaiaData);
@@ -970,7 +963,6 @@ bool			foundIt;
 		strcat(rtnErrorMessage,	mysql_error(mySQLConnection));
 	}
 	mysql_close(mySQLConnection);
-	mysql_library_end();
 
 	*gaiaData	=	localStarData;
 //	CONSOLE_DEBUG(__FUNCTION__);
@@ -1104,7 +1096,6 @@ unsigned int	endMilliSecs;
 		sprintf(errorString, "OpenMysql() failed: %s", mysql_error(mySQLConnection));
 	}
 	mysql_close(mySQLConnection);
-	mysql_library_end();
 
 	CONSOLE_DEBUG_W_NUM("Number of databases found\t=", dbaseCount);
 	return(dbaseCount);
@@ -1213,52 +1204,6 @@ double	tempValue_DEC;
 	return(distance_Deg);
 }
 
-//*****************************************************************************
-static int	PurgeFartherestEntry(double ra_Degrees, double dec_Degrees)
-{
-int		iii;
-int		freeSlot;
-double	distance_Deg;
-double	maxDist_Deg;
-
-//	CONSOLE_DEBUG(__FUNCTION__);
-	freeSlot	=	-1;
-	maxDist_Deg	=	0;
-
-	for (iii=0; iii<kMaxGaiaDataSets; iii++)
-	{
-		if (gGaiaDataList[iii].validData)
-		{
-			//*	compute the distance from the CURRENT RA/DEC to the ones in the table
-			distance_Deg	=	CalcRA_DEC_Distance_Deg(ra_Degrees,
-													dec_Degrees,
-													gGaiaDataList[iii].centerRA_deg,
-													gGaiaDataList[iii].centerDEC_deg);
-			gGaiaDataList[iii].distanceCtrScrn	=	distance_Deg;
-			if (distance_Deg > maxDist_Deg)
-			{
-				maxDist_Deg	=	distance_Deg;
-				freeSlot	=	iii;
-			}
-		}
-	}
-
-	if ((freeSlot >= 0) && (freeSlot < kMaxGaiaDataSets))
-	{
-		if (gGaiaDataList[freeSlot].gaiaData != NULL)
-		{
-			free(gGaiaDataList[freeSlot].gaiaData);
-		}
-		else
-		{
-			CONSOLE_DEBUG_W_NUM("No data to FREE() !!!!!!!!!!!!!!!!!!!! Slot#", freeSlot);
-		}
-		//*	set everything to NULL
-		memset(&gGaiaDataList[freeSlot], 0, sizeof(TYPE_GAIA_REMOTE_DATA));
-	}
-	return(freeSlot);
-}
-
 #if 0
 //*****************************************************************************
 static void	DumpGaiaRemoteTable(const char *functionName)
@@ -1286,258 +1231,150 @@ int		iii;
 //*****************************************************************************
 //*	returns 1 if new request was started, 0 if not
 //*		using int so the calling routine can count how many
+//*	The block is fetched by the GaiaTileCache.c workers, from the tile store
+//*	if it has been fetched before
 //*****************************************************************************
 int	UpdateSkyTravelView(double ra_Degrees, double dec_Degrees, double viewAngle_Degrees)
 {
-int		ra_deg_int;
-int		dec_deg_int;
-int		slotIdx;
-bool	dataNeesToBeLoaded;
-int		iii;
 int		requestStarted;
 
 	requestStarted		=	0;
 
 	if ((viewAngle_Degrees < 5.0) && (dec_Degrees < 90.0) && (dec_Degrees >= -90.0))
 	{
-		if (gST_DispOptions.RemoteGAIAenabled && (gSQL_ThreadIsRunning == false))
+		if (gST_DispOptions.RemoteGAIAenabled && (GaiaTileCache_WorkersRunning() == false))
 		{
 			CONSOLE_DEBUG("**************************************************************");
 			CONSOLE_DEBUG("Calling StartGaiaSQLthread()");
 			StartGaiaSQLthread();
 		}
 
-		if (ra_Degrees < 0.0)
-		{
-			ra_Degrees	+=	360.0;
-		}
-		dataNeesToBeLoaded	=	true;
-		ra_deg_int	=	floor(ra_Degrees);
-		dec_deg_int	=	floor(dec_Degrees);
-
-		//*	first check to see if this block is already loaded
-		//*	SPECIAL CASE for Dec value near the poles
-		if (fabs(dec_Degrees) >= kPolarDeclinationLimit)
-		{
-			for (iii=0; iii<kMaxGaiaDataSets; iii++)
-			{
-				if (gGaiaDataList[iii].validData)
-				{
-					if (dec_deg_int == gGaiaDataList[iii].block_DEC_deg)
-					{
-					//	CONSOLE_DEBUG("GAIA section all ready loaded");
-						dataNeesToBeLoaded	=	false;
-						break;
-					}
-				}
-			}
-		}
-		else
-		{
-			for (iii=0; iii<kMaxGaiaDataSets; iii++)
-			{
-				if (gGaiaDataList[iii].validData)
-				{
-					if ((ra_deg_int == gGaiaDataList[iii].block_RA_deg) &&
-						(dec_deg_int == gGaiaDataList[iii].block_DEC_deg))
-					{
-					//	CONSOLE_DEBUG("GAIA section all ready loaded");
-						dataNeesToBeLoaded	=	false;
-						break;
-					}
-				}
-			}
-		}
+		//*	the blocks in memory are dropped if a different database was selected
+		GaiaTileCache_SetDataBase(gSQLsever_Database);
 
-		if (dataNeesToBeLoaded)
+		requestStarted	=	GaiaTileCache_Request(ra_Degrees, dec_Degrees);
+		if (requestStarted > 0)
 		{
 			CONSOLE_DEBUG("dataNeesToBeLoaded");
 			CONSOLE_DEBUG_W_DBL("ra_Degrees \t=", ra_Degrees);
-			CONSOLE_DEBUG_W_NUM("ra_deg_int \t=", ra_deg_int);
-
 			CONSOLE_DEBUG_W_DBL("dec_Degrees\t=", dec_Degrees);
-			CONSOLE_DEBUG_W_NUM("dec_deg_int\t=", dec_deg_int);
-
-			//*	go through the list and find an empty slot
-			slotIdx	=	-1;
-			for (iii=0; iii<kMaxGaiaDataSets; iii++)
-			{
-				if (gGaiaDataList[iii].validData == false)
-				{
-					//*	we have an empty slot
-					slotIdx	=	iii;
-					break;
-				}
-			}
-
-			if (slotIdx < 0)
-			{
-				//*	no empty slot, delete one of them.
-				slotIdx	=	PurgeFartherestEntry(ra_Degrees, dec_Degrees);
-			}
-
-			if (slotIdx >= 0)
-			{
-				CONSOLE_DEBUG_W_NUM("slotIdx\t=", slotIdx);
-				gGaiaDataList[slotIdx].centerRA_deg		=	ra_Degrees;
-				gGaiaDataList[slotIdx].centerDEC_deg	=	dec_Degrees;
-				gGaiaDataList[slotIdx].block_RA_deg		=	ra_deg_int;
-				gGaiaDataList[slotIdx].block_DEC_deg	=	dec_deg_int;
-
-				gGaiaDataList[slotIdx].validData		=	true;				//*	do this LAST
-
-				requestStarted	=	1;
-			}
-			else
-			{
-				CONSOLE_DEBUG("Not able to find an available slot");
-			}
-			gSkyTravelUpdateOccured	=	true;
-
-//			DumpGaiaRemoteTable(__FUNCTION__);
 		}
 	}
 	return(requestStarted);
 }
 
-
-#ifndef _INCLUDE_GAIA_MAIN_
-//						(gGaiaDataList[iii].serverReqCount < 5))
 //*****************************************************************************
-static int	GetOneSQLdataBlock(TYPE_GAIA_REMOTE_DATA *gaiaRemoteData)
+//*	call once per update with the center of the screen, after UpdateSkyTravelView().
+//*	Requests the blocks ahead of the view if it is moving.
+//*	returns the number of new requests
+//*****************************************************************************
+int	PrefetchSkyTravelView(double ra_Degrees, double dec_Degrees, double viewAngle_Degrees)
 {
-TYPE_CelestData	*gaiaData;
-long			gaiaDataCount;
-unsigned int	startMilliSecs;
-unsigned int	endMilliSecs;
-int				requestOccured;
-bool			successFlag;
+int		requestCount;
 
-	requestOccured	=	0;
-	if (gaiaRemoteData->serverReqCount < 5)
+	requestCount	=	0;
+	if ((viewAngle_Degrees < 5.0) && (dec_Degrees < 90.0) && (dec_Degrees >= -90.0))
 	{
-		requestOccured	=	1;
-		CONSOLE_DEBUG("GAIA_Thread, going to get data");
-		CONSOLE_DEBUG_W_DBL("centerRA_deg\t =", gaiaRemoteData->centerRA_deg);
-		CONSOLE_DEBUG_W_DBL("centerDEC_deg\t=", gaiaRemoteData->centerDEC_deg);
-
-		gettimeofday(&gaiaRemoteData->timeStamp, NULL);	//*	save the time we started the request
-
-		//*	increment the number of times we have requested this
-		gaiaRemoteData->serverReqCount	+=	1;
-		startMilliSecs	=	millis();
-		gaiaData		=	GetGAIAdataFromSQL(	gaiaRemoteData->centerRA_deg,
-												gaiaRemoteData->centerDEC_deg,
-												&gaiaDataCount,
-												&successFlag);
-
-		endMilliSecs	=	millis();
-		CONSOLE_DEBUG_W_LONG("gaiaDataCount\t=", gaiaDataCount);
-
-		//*	make sure we got some valid data
-	//						if ((gaiaData != NULL) && (gaiaDataCount > 0))
-		if (successFlag)
-		{
-			//*	sort the data to speed up drawing
-			if (gaiaDataCount > 1)
-			{
-				CONSOLE_DEBUG("Sorting");
-				qsort(gaiaData, gaiaDataCount, sizeof(TYPE_CelestData), CelestObjDeclinationQsortProc);
-			}
-
-			gaiaRemoteData->gaiaData			=	gaiaData;
-			gaiaRemoteData->gaiaDataCnt			=	gaiaDataCount;
-			gaiaRemoteData->elapsedMilliSecs	=	endMilliSecs - startMilliSecs;
-			gaiaRemoteData->sequenceNum			=	gGaiaSQLsequenceNum;
-			gGaiaSQLsequenceNum++;
-
-			sprintf(gSQLsever_StatusMsg, "SQL success, record count=%ld", gaiaDataCount);
-			gSQLsever_MsgUpdated	=	true;
-		}
-		else
-		{
-			CONSOLE_DEBUG("Failed to get GAIA data!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
-			strcpy(gSQLsever_StatusMsg, "SQL failed!!!");
-			gSQLsever_MsgUpdated	=	true;
-
-			gaiaRemoteData->validData	=	false;
-			memset(gaiaRemoteData, 0, sizeof(TYPE_GAIA_REMOTE_DATA));
-
-			gSQLerror_Count++;
-			if (gSQLerror_Count > 10)
-			{
-				strcpy(gSQLsever_StatusMsg, "Too many SQL errors, sleeping for 1 minute");
-				gSQLsever_MsgUpdated	=	true;
-				CONSOLE_DEBUG(gSQLsever_StatusMsg);
-				sleep(1 * 60);
-			}
-		}
-	//	CONSOLE_DEBUG("Quick nap between requests");
+		requestCount	=	GaiaTileCache_Prefetch(ra_Degrees, dec_Degrees, viewAngle_Degrees);
+	}
+	return(requestCount);
+}
 
-		//*	sleep for 100 millseconds
-		usleep(100 * 1000);
-	//	CONSOLE_DEBUG("Awake");
 
-	//	DumpGaiaRemoteTable(__FUNCTION__);
+#ifndef _INCLUDE_GAIA_MAIN_
+//*****************************************************************************
+static void	CloseGaiaTileConnection(void **workerConnection)
+{
+	if (*workerConnection != NULL)
+	{
+		mysql_close((MYSQL *)*workerConnection);
+		*workerConnection	=	NULL;
 	}
-	return(requestOccured);
 }
 
 //*****************************************************************************
-static void	*GaiaSQL_Thead(void *arg)
+//*	called by each GaiaTileCache.c worker thread when it exits
+//*****************************************************************************
+static void	EndGaiaTileWorker(void **workerConnection)
+{
+	CloseGaiaTileConnection(workerConnection);
+	mysql_thread_end();
+}
+
+//*****************************************************************************
+//*	called by the GaiaTileCache.c worker threads, each worker has its own
+//*	connection that stays open as long as the requests are successful
+//*****************************************************************************
+static TYPE_CelestData	*FetchGaiaTileFromSQL(	void		**workerConnection,
+												const char	*dataBaseName,
+												const int	block_RA_deg,
+												const int	block_DEC_deg,
+												long		*starCount,
+												bool		*successFlag)
 {
-int				iii;
-bool			requestCount;
+TYPE_CelestData	*gaiaData;
+MYSQL			*mySQLConnection;
+char			myDataBaseName[32];
 
-	gSQL_ThreadIsRunning	=	true;
-	while (gSQL_KeepRunning)
+	CONSOLE_DEBUG("GAIA worker, going to get data");
+	CONSOLE_DEBUG_W_NUM("block_RA_deg\t =", block_RA_deg);
+	CONSOLE_DEBUG_W_NUM("block_DEC_deg\t=", block_DEC_deg);
+
+	strcpy(myDataBaseName, dataBaseName);
+	mySQLConnection	=	(MYSQL *)*workerConnection;
+	if (mySQLConnection == NULL)
 	{
-		//*
-		if (gST_DispOptions.RemoteGAIAenabled && gSkyTravelUpdateOccured)
-		{
-			CONSOLE_DEBUG(__FUNCTION__);
-			requestCount	=	1;
-			while (requestCount > 0)
-			{
-				requestCount	=	0;
-				//*	lets see if we have any work to do
-				for (iii=0; iii<kMaxGaiaDataSets; iii++)
-				{
-					if (gGaiaDataList[iii].validData &&
-						(gGaiaDataList[iii].gaiaData == NULL))
-					{
-						requestCount	+=	GetOneSQLdataBlock(&gGaiaDataList[iii]);
-					}
-				}
-			}
-			gSkyTravelUpdateOccured	=	false;
+		mySQLConnection		=	OpenMysql(myDataBaseName);
+		*workerConnection	=	mySQLConnection;
+	}
+
+	//*	ask for the center of the block, GetGAIAdataFromSQL() works out the rest
+	gaiaData	=	GetGAIAdataFromSQL(	mySQLConnection,
+										myDataBaseName,
+										(block_RA_deg + 0.5),
+										(block_DEC_deg + 0.5),
+										starCount,
+										successFlag);
+	CONSOLE_DEBUG_W_LONG("gaiaDataCount\t=", *starCount);
+	if (*successFlag)
+	{
+		sprintf(gSQLsever_StatusMsg, "SQL success, record count=%ld", *starCount);
+		gSQLsever_MsgUpdated	=	true;
+	}
+	else
+	{
+		CONSOLE_DEBUG("Failed to get GAIA data!!!!!!!!!!!!!!!!!!!!!!!!!!!!!");
+		strcpy(gSQLsever_StatusMsg, "SQL failed!!!");
+		gSQLsever_MsgUpdated	=	true;
 
+		//*	start over with a new connection next time
+		CloseGaiaTileConnection(workerConnection);
 
+		gSQLerror_Count++;
+		if (gSQLerror_Count > 10)
+		{
+			strcpy(gSQLsever_StatusMsg, "Too many SQL errors, sleeping for 1 minute");
+			gSQLsever_MsgUpdated	=	true;
+			CONSOLE_DEBUG(gSQLsever_StatusMsg);
+			sleep(1 * 60);
 		}
 		else
 		{
-		//	CONSOLE_DEBUG("Nothing to do... Sleeping");
-			sleep(5);
-		//	CONSOLE_DEBUG("Awake");
+			//*	sleep for 100 millseconds
+			usleep(100 * 1000);
 		}
 	}
-	gSQL_ThreadIsRunning	=	false;
-	return(NULL);
+	return(gaiaData);
 }
 
-
-
 //*****************************************************************************
 //*	returns 0=OK, -1, failed to create, +1 busy
 //*****************************************************************************
-//*	inputs:
-//*		arcSecondsPerPixel or fieldOfView_deg, use only one.
+//*	starts the GaiaTileCache.c workers, "workers" in sqlserver.txt sets how many
 //*****************************************************************************
 int	StartGaiaSQLthread(void)
 {
 int		threadStatus;
-int		threadErr;
-int		loopCnt;
 bool	configOK;
 
 
@@ -1554,36 +1391,18 @@ bool	configOK;
 	configOK	=	CheckSQLconfiguration();
 	if (configOK)
 	{
-		if (gSQL_ThreadIsRunning == false)
+		if (GaiaTileCache_WorkersRunning() == false)
 		{
 			LogSQLuser();
 
-			CONSOLE_DEBUG("Staring Gaia SQL Thread");
-			gSQL_KeepRunning	=	true;
-			threadErr	=	pthread_create(	&gSQL_ThreadID,
-											NULL,
-											&GaiaSQL_Thead,
-											NULL);
-			if (threadErr == 0)
-			{
-				CONSOLE_DEBUG("GAIA SQL thread created successfully");
-				threadStatus	=	0;
-
-				//*	sleep a little so the thread has a chance to get running
-				loopCnt	=	0;
-				while ((gSQL_ThreadIsRunning == false) && (loopCnt < 200))
-				{
-					usleep(5000);
-					loopCnt++;
-				}
-				CONSOLE_DEBUG_W_NUM("gSQL_ThreadIsRunning\t=", gSQL_ThreadIsRunning);
-				CONSOLE_DEBUG_W_NUM("loopCnt\t\t\t=", loopCnt);
-
-			}
-			else
+			CONSOLE_DEBUG("Staring Gaia SQL workers");
+			GaiaTileCache_SetDataBase(gSQLsever_Database);
+			threadStatus	=	GaiaTileCache_StartWorkers(	&FetchGaiaTileFromSQL,
+															&EndGaiaTileWorker,
+															gSQLworkerCount);
+			if (threadStatus == 0)
 			{
-				CONSOLE_DEBUG_W_NUM("Error on thread creation, Error number:", threadErr);
-				threadStatus	=	-1;
+				CONSOLE_DEBUG("GAIA SQL workers created successfully");
 			}
 		}
 		else
@@ -1605,7 +1424,7 @@ bool	configOK;
 //*****************************************************************************
 void	StopGaiaSQLthread(void)
 {
-	gSQL_KeepRunning	=	false;
+	GaiaTileCache_StopWorkers();
 }
 #endif // _INCLUDE_GAIA_MAIN_
 
@@ -1654,9 +1473,14 @@ unsigned int	elapsedMilliSecs;
 unsigned int	totalMilliSecs;
 int				requestCount;
 double			avgTime;
+MYSQL			*mySQLConnection;
+bool			successFlag;
 
 	CONSOLE_DEBUG(__FUNCTION__);
 
+	GaiaSQLinit();
+	mySQLConnection	=	OpenMysql(gSQLsever_Database);
+
 	ra_Degrees		=	0.0;
 	dec_Degrees		=	10.0;
 	requestCount	=	0;
@@ -1670,9 +1494,16 @@ double			avgTime;
 			CONSOLE_DEBUG("----------------------------------");
 			CONSOLE_DEBUG_W_DBL("ra_Degrees  \t=", ra_Degrees);
 			CONSOLE_DEBUG_W_DBL("dec_Degrees \t=", dec_Degrees);
-			gaiaData		=	GetGAIAdataFromSQL(	ra_Degrees,
+			gaiaData		=	GetGAIAdataFromSQL(	mySQLConnection,
+													gSQLsever_Database,
+													ra_Degrees,
 													dec_Degrees,
-													&gaiaDataCount);
+													&gaiaDataCount,
+													&successFlag);
+			if (gaiaData != NULL)
+			{
+				free(gaiaData);
+			}
 			endMilliSecs		=	millis();
 			elapsedMilliSecs	=	endMilliSecs - startMilliSecs;
 			totalMilliSecs		+=	elapsedMilliSecs;
@@ -1690,6 +1521,10 @@ double			avgTime;
 	}
 
 	CONSOLE_DEBUG_W_LONG("gaiaDataCount", gaiaDataCount);
+	if (mySQLConnection != NULL)
+	{
+		mysql_close(mySQLConnection);
+	}
 }
 #endif // _INCLUDE_GAIA_MAIN_
 
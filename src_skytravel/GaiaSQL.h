@@ -1,6 +1,13 @@
 //*****************************************************************************
 //#include	"GaiaSQL.h"
 
+#ifndef _GAIA_SQL_H_
+#define	_GAIA_SQL_H_
+
+#ifndef _STDINT_H
+	#include	<stdint.h>
+#endif
+
 #ifndef _SKY_STRUCTS_H_
 	#include	"SkyStruc.h"
 #endif
@@ -18,7 +25,9 @@ int		StartGaiaSQLthread(void);
 
 //*	returns 1 if new request was started, 0 if not
 int		UpdateSkyTravelView(double ra_Degrees, double dec_Degrees, double viewAngle_Degrees);
+int		PrefetchSkyTravelView(double ra_Degrees, double dec_Degrees, double viewAngle_Degrees);
 void	ClearAllSQLdata(void);
+void	StopGaiaSQLthread(void);
 double	CalcRA_DEC_Distance_Deg(const double	ra1_Deg,
 								const double	dec1_Deg,
 								const double	ra2_Deg,
@@ -42,10 +51,18 @@ typedef struct
 	int				sequenceNum;
 	struct timeval	timeStamp;
 	double			distanceCtrScrn;	//*	the distance to the center of the screen
+
+	//*	maintained by GaiaTileCache.c
+	int				tileState;			//*	see GaiaTileCache.h
+	int				generation;			//*	bumped when the slot is reused or cleared
+	bool			isPrefetch;			//*	requested ahead of the view, not in it
+	bool			fromTileStore;		//*	loaded from disk instead of the server
+	uint32_t		lastUsedMilliSecs;
+	long			memoryBytes;
 } TYPE_GAIA_REMOTE_DATA;
 
 
-#define	kMaxGaiaDataSets	30
+#define	kMaxGaiaDataSets	256
 #define	JD2016				(2457388.5)
 
 extern TYPE_GAIA_REMOTE_DATA	gGaiaDataList[];
@@ -67,3 +84,4 @@ extern int					gDataBaseNameCnt;
 }
 #endif
 
+#endif // _GAIA_SQL_H_
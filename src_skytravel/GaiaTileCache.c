@@ -0,0 +1,1222 @@
+//*****************************************************************************
+//*	GaiaTileCache.c
+//*
+//*	Tile cache for the remote Gaia SQL data.
+//*	The sky is divided into the same 1x1 degree blocks that the SQL server
+//*	procedures return (one ring per degree above kPolarDeclinationLimit).
+//*	Each block is a slot in gGaiaDataList[] so the drawing code and the
+//*	Gaia remote list window see the same table they always have.
+//*
+//*	Blocks are fetched by a small pool of worker threads, the ones in view
+//*	first, then the ones ahead of the direction the view is moving.
+//*	Every block that comes from the server is sorted and saved in the tile
+//*	store on disk, later sessions load it from there instead of the server.
+//*	The blocks kept in memory are limited by size, least recently used go first,
+//*	even if they are in view. Prefetched blocks that would go over the limit are
+//*	left in the tile store and not kept in memory.
+//*
+//*	Only the UI thread frees tile data (the drawing is done on the same thread),
+//*	the workers only fill in slots that are in the kGaiaTile_Fetching state.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created GaiaTileCache.c
+//*	Oct 18,	2026	<AGT> The memory limit is now enforced, the benchmark removes its tile stores
+//*****************************************************************************
+
+#ifdef _ENABLE_REMOTE_GAIA_
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+#include	<stdint.h>
+#include	<math.h>
+#include	<unistd.h>
+#include	<errno.h>
+#include	<pthread.h>
+#include	<sys/stat.h>
+#include	<sys/time.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"helper_functions.h"
+#include	"SkyStruc.h"
+#include	"GaiaSQL.h"
+#include	"GaiaTileCache.h"
+
+#ifndef RADIANS
+	#define	RADIANS(degrees)	((degrees) * (M_PI / 180.0))
+#endif
+
+TYPE_GAIA_REMOTE_DATA	gGaiaDataList[kMaxGaiaDataSets];
+int						gGaiaTilePrefetchDepth	=	kGaiaTilePrefetchDepth;
+
+//*****************************************************************************
+//*	a tile store file is this header followed by starCount TYPE_CelestData records
+//*****************************************************************************
+typedef struct
+{
+	char		magic[8];
+	uint32_t	version;
+	uint32_t	recordSize;				//*	sizeof(TYPE_CelestData), the tile is fetched again if it changes
+	int32_t		block_RA_deg;
+	int32_t		block_DEC_deg;
+	int64_t		starCount;
+	char		dataBaseName[32];
+} TYPE_GaiaTileHeader;
+
+//*****************************************************************************
+typedef struct
+{
+	pthread_t	threadID;
+	int			workerIdx;
+	void		*connection;			//*	owned by the fetch proc
+} TYPE_GaiaTileWorker;
+
+static	pthread_mutex_t		gGaiaTileMutex			=	PTHREAD_MUTEX_INITIALIZER;
+static	pthread_cond_t		gGaiaTileCondition		=	PTHREAD_COND_INITIALIZER;
+static	TYPE_GaiaTileWorker	gGaiaTileWorkers[kGaiaTileMaxWorkers];
+static	int					gGaiaTileWorkerCnt		=	0;
+static	bool				gGaiaTileKeepRunning	=	false;
+static	GaiaTileFetchProc	gGaiaTileFetchProc		=	NULL;
+static	GaiaTileCloseProc	gGaiaTileCloseProc		=	NULL;
+static	char				gGaiaTileStoreDir[256]	=	kGaiaTileStoreDir;
+static	char				gGaiaTileDataBase[32]	=	"";
+static	long				gGaiaTileMaxBytes		=	kGaiaTileDefaultMaxBytes;
+static	long				gGaiaTileMemoryUsed		=	0;
+static	int					gGaiaTileSequenceNum	=	0;
+
+//*	where the view was the last time it moved far enough to count
+static	bool				gGaiaTileLastViewValid	=	false;
+static	double				gGaiaTileLastRA_deg		=	0.0;
+static	double				gGaiaTileLastDEC_deg	=	0.0;
+
+//*****************************************************************************
+//*	same test GetGAIAdataFromSQL() uses on the center of the block
+//*****************************************************************************
+static bool	IsPolarBlock(const int block_DEC_deg)
+{
+	return(fabs(block_DEC_deg + 0.5) >= kPolarDeclinationLimit);
+}
+
+//*****************************************************************************
+void	GaiaTileCache_GetBlock(	const double	ra_Degrees,
+								const double	dec_Degrees,
+								int				*block_RA_deg,
+								int				*block_DEC_deg)
+{
+double	myRA_Degrees;
+
+	myRA_Degrees	=	fmod(ra_Degrees, 360.0);
+	if (myRA_Degrees < 0.0)
+	{
+		myRA_Degrees	+=	360.0;
+	}
+	*block_DEC_deg	=	floor(dec_Degrees);
+	if (IsPolarBlock(*block_DEC_deg))
+	{
+		//*	the whole ring is one block
+		*block_RA_deg	=	0;
+	}
+	else
+	{
+		*block_RA_deg	=	floor(myRA_Degrees);
+		if (*block_RA_deg >= 360)
+		{
+			*block_RA_deg	=	0;
+		}
+	}
+}
+
+//*****************************************************************************
+static void	GetTileStorePath(	const char	*dataBaseName,
+								const int	block_RA_deg,
+								const int	block_DEC_deg,
+								char		*tileFilePath,
+								const int	maxLen)
+{
+	snprintf(tileFilePath, maxLen, "%s/%s/D%+03d_R%03d%s",	gGaiaTileStoreDir,
+															dataBaseName,
+															block_DEC_deg,
+															block_RA_deg,
+															kGaiaTileStoreExtension);
+}
+
+//*****************************************************************************
+//*	same order as CelestObjDeclinationQsortProc() in windowtab_skytravel.cpp
+//*****************************************************************************
+static int	GaiaTileDeclinationQsortProc(const void *e1, const void *e2)
+{
+TYPE_CelestData	*obj1	=	(TYPE_CelestData *)e1;
+TYPE_CelestData	*obj2	=	(TYPE_CelestData *)e2;
+int				returnValue;
+
+	returnValue	=	0;
+	if (obj1->decl < obj2->decl)
+	{
+		returnValue	=	1;
+	}
+	else if (obj1->decl > obj2->decl)
+	{
+		returnValue	=	-1;
+	}
+	return(returnValue);
+}
+
+//*****************************************************************************
+//*	successFlag is false if the tile is not in the store or can't be used
+//*****************************************************************************
+static TYPE_CelestData	*ReadTileStore(	const char	*dataBaseName,
+										const int	block_RA_deg,
+										const int	block_DEC_deg,
+										long		*starCount,
+										bool		*successFlag)
+{
+TYPE_CelestData		*gaiaData;
+TYPE_GaiaTileHeader	tileHeader;
+char				tileFilePath[512];
+FILE				*filePointer;
+struct stat			fileStatus;
+size_t				expectedSize;
+
+	gaiaData		=	NULL;
+	*starCount		=	0;
+	*successFlag	=	false;
+	GetTileStorePath(dataBaseName, block_RA_deg, block_DEC_deg, tileFilePath, sizeof(tileFilePath));
+	filePointer		=	fopen(tileFilePath, "r");
+	if (filePointer != NULL)
+	{
+		memset(&tileHeader, 0, sizeof(TYPE_GaiaTileHeader));
+		fstat(fileno(filePointer), &fileStatus);
+		if (fread(&tileHeader, sizeof(TYPE_GaiaTileHeader), 1, filePointer) == 1)
+		{
+			expectedSize	=	sizeof(TYPE_GaiaTileHeader) + (tileHeader.starCount * sizeof(TYPE_CelestData));
+			if ((strncmp(tileHeader.magic, kGaiaTileStoreMagic, sizeof(tileHeader.magic)) == 0) &&
+				(tileHeader.version == kGaiaTileStoreVersion) &&
+				(tileHeader.recordSize == sizeof(TYPE_CelestData)) &&
+				(tileHeader.block_RA_deg == block_RA_deg) &&
+				(tileHeader.block_DEC_deg == block_DEC_deg) &&
+				(strncmp(tileHeader.dataBaseName, dataBaseName, sizeof(tileHeader.dataBaseName)) == 0) &&
+				(tileHeader.starCount >= 0) &&
+				((size_t)fileStatus.st_size == expectedSize))
+			{
+				if (tileHeader.starCount > 0)
+				{
+					gaiaData	=	(TYPE_CelestData *)malloc(tileHeader.starCount * sizeof(TYPE_CelestData));
+					if (gaiaData != NULL)
+					{
+						if (fread(gaiaData, sizeof(TYPE_CelestData), tileHeader.starCount, filePointer) == (size_t)tileHeader.starCount)
+						{
+							*starCount		=	tileHeader.starCount;
+							*successFlag	=	true;
+						}
+						else
+						{
+							free(gaiaData);
+							gaiaData	=	NULL;
+						}
+					}
+				}
+				else
+				{
+					//*	the server had nothing for this block
+					*successFlag	=	true;
+				}
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_STR("Tile is out of date:", tileFilePath);
+			}
+		}
+		fclose(filePointer);
+	}
+	return(gaiaData);
+}
+
+//*****************************************************************************
+//*	write to a temp file and rename it so nobody ever reads a partial tile.
+//*	Failing to save is not an error, it just means asking the server next time
+//*****************************************************************************
+static bool	WriteTileStore(	const char				*dataBaseName,
+							const int				block_RA_deg,
+							const int				block_DEC_deg,
+							const TYPE_CelestData	*gaiaData,
+							const long				starCount)
+{
+TYPE_GaiaTileHeader	tileHeader;
+char				tileDirPath[320];
+char				tileFilePath[512];
+char				tempFilePath[560];
+FILE				*filePointer;
+size_t				recordsWritten;
+bool				tileSaved;
+
+	tileSaved	=	false;
+	//*	make sure the directories are there
+	mkdir(gGaiaTileStoreDir, 0755);
+	snprintf(tileDirPath, sizeof(tileDirPath), "%s/%s", gGaiaTileStoreDir, dataBaseName);
+	mkdir(tileDirPath, 0755);
+
+	memset(&tileHeader, 0, sizeof(TYPE_GaiaTileHeader));
+	strcpy(tileHeader.magic, kGaiaTileStoreMagic);
+	tileHeader.version			=	kGaiaTileStoreVersion;
+	tileHeader.recordSize		=	sizeof(TYPE_CelestData);
+	tileHeader.block_RA_deg		=	block_RA_deg;
+	tileHeader.block_DEC_deg	=	block_DEC_deg;
+	tileHeader.starCount		=	starCount;
+	strncpy(tileHeader.dataBaseName, dataBaseName, sizeof(tileHeader.dataBaseName) - 1);
+
+	GetTileStorePath(dataBaseName, block_RA_deg, block_DEC_deg, tileFilePath, sizeof(tileFilePath));
+	snprintf(tempFilePath, sizeof(tempFilePath), "%s.%d.%lx", tileFilePath, getpid(), (unsigned long)pthread_self());
+	filePointer	=	fopen(tempFilePath, "w");
+	if (filePointer != NULL)
+	{
+		recordsWritten	=	0;
+		if (fwrite(&tileHeader, sizeof(TYPE_GaiaTileHeader), 1, filePointer) == 1)
+		{
+			if (starCount > 0)
+			{
+				recordsWritten	=	fwrite(gaiaData, sizeof(TYPE_CelestData), starCount, filePointer);
+			}
+		}
+		if ((fclose(filePointer) == 0) && (recordsWritten == (size_t)starCount))
+		{
+			if (rename(tempFilePath, tileFilePath) == 0)
+			{
+				tileSaved	=	true;
+			}
+		}
+		if (tileSaved == false)
+		{
+			CONSOLE_DEBUG_W_STR("Failed to save:", tileFilePath);
+			unlink(tempFilePath);
+		}
+	}
+	else
+	{
+		CONSOLE_DEBUG_W_STR("Unable to create:", tempFilePath);
+	}
+	return(tileSaved);
+}
+
+//*****************************************************************************
+//*	the mutex must be held, the slot is ready for reuse when this returns
+//*****************************************************************************
+static void	ReleaseTileSlot(TYPE_GAIA_REMOTE_DATA *tileSlot)
+{
+int		generation;
+
+	if (tileSlot->tileState == kGaiaTile_Ready)
+	{
+		if (tileSlot->gaiaData != NULL)
+		{
+			free(tileSlot->gaiaData);
+		}
+		gGaiaTileMemoryUsed	-=	tileSlot->memoryBytes;
+	}
+	//*	a worker that is still fetching this slot will see the new generation and discard its data
+	generation	=	tileSlot->generation;
+	memset(tileSlot, 0, sizeof(TYPE_GAIA_REMOTE_DATA));
+	tileSlot->generation	=	generation + 1;
+}
+
+//*****************************************************************************
+//*	the mutex must be held
+//*****************************************************************************
+static int	FindTileSlot(const int block_RA_deg, const int block_DEC_deg)
+{
+int		iii;
+int		slotIdx;
+
+	slotIdx	=	-1;
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		if ((gGaiaDataList[iii].tileState != kGaiaTile_Empty) &&
+			(gGaiaDataList[iii].block_RA_deg == block_RA_deg) &&
+			(gGaiaDataList[iii].block_DEC_deg == block_DEC_deg))
+		{
+			slotIdx	=	iii;
+			break;
+		}
+	}
+	return(slotIdx);
+}
+
+//*****************************************************************************
+//*	the mutex must be held.
+//*	Takes an empty slot if there is one, otherwise the least recently used
+//*	tile that is in memory, otherwise the least recently used queued request
+//*****************************************************************************
+static int	GetFreeTileSlot(void)
+{
+int			iii;
+int			slotIdx;
+int			oldestReadyIdx;
+int			oldestQueuedIdx;
+uint32_t	currentMilliSecs;
+uint32_t	oldestReadyAge;
+uint32_t	oldestQueuedAge;
+uint32_t	slotAge;
+
+	slotIdx			=	-1;
+	oldestReadyIdx	=	-1;
+	oldestQueuedIdx	=	-1;
+	oldestReadyAge	=	0;
+	oldestQueuedAge	=	0;
+	currentMilliSecs	=	millis();
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		slotAge	=	currentMilliSecs - gGaiaDataList[iii].lastUsedMilliSecs;
+		switch(gGaiaDataList[iii].tileState)
+		{
+			case kGaiaTile_Empty:
+				slotIdx	=	iii;
+				break;
+
+			case kGaiaTile_Ready:
+				if ((oldestReadyIdx < 0) || (slotAge > oldestReadyAge))
+				{
+					oldestReadyIdx	=	iii;
+					oldestReadyAge	=	slotAge;
+				}
+				break;
+
+			case kGaiaTile_Queued:
+				if ((oldestQueuedIdx < 0) || (slotAge > oldestQueuedAge))
+				{
+					oldestQueuedIdx	=	iii;
+					oldestQueuedAge	=	slotAge;
+				}
+				break;
+		}
+		if (slotIdx >= 0)
+		{
+			break;
+		}
+	}
+	if (slotIdx < 0)
+	{
+		if (oldestReadyIdx >= 0)
+		{
+			slotIdx	=	oldestReadyIdx;
+		}
+		else
+		{
+			slotIdx	=	oldestQueuedIdx;
+		}
+		if (slotIdx >= 0)
+		{
+			ReleaseTileSlot(&gGaiaDataList[slotIdx]);
+		}
+	}
+	return(slotIdx);
+}
+
+//*****************************************************************************
+//*	the mutex must be held.
+//*	Drops the least recently used tiles until the memory limit is met.
+//*	If the limit is smaller than the tiles in view, those go too and get
+//*	loaded again from the tile store the next time they are drawn,
+//*	so the limit needs to be bigger than a screen full of tiles.
+//*	Queued requests that nobody has asked for in a while are dropped as well
+//*****************************************************************************
+static void	TrimTileCache(void)
+{
+int			iii;
+int			oldestIdx;
+uint32_t	currentMilliSecs;
+uint32_t	oldestAge;
+uint32_t	slotAge;
+
+	currentMilliSecs	=	millis();
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		slotAge	=	currentMilliSecs - gGaiaDataList[iii].lastUsedMilliSecs;
+		if ((gGaiaDataList[iii].tileState == kGaiaTile_Queued) && (slotAge > kGaiaTileQueueTimeout))
+		{
+			ReleaseTileSlot(&gGaiaDataList[iii]);
+		}
+	}
+
+	oldestIdx	=	0;
+	while ((gGaiaTileMemoryUsed > gGaiaTileMaxBytes) && (oldestIdx >= 0))
+	{
+		oldestIdx	=	-1;
+		oldestAge	=	0;
+		for (iii=0; iii<kMaxGaiaDataSets; iii++)
+		{
+			slotAge	=	currentMilliSecs - gGaiaDataList[iii].lastUsedMilliSecs;
+			if ((gGaiaDataList[iii].tileState == kGaiaTile_Ready) && ((oldestIdx < 0) || (slotAge > oldestAge)))
+			{
+				oldestIdx	=	iii;
+				oldestAge	=	slotAge;
+			}
+		}
+		if (oldestIdx >= 0)
+		{
+			ReleaseTileSlot(&gGaiaDataList[oldestIdx]);
+		}
+	}
+}
+
+//*****************************************************************************
+//*	the mutex must be held.
+//*	Blocks in view go first, newest request first, the view has most likely
+//*	moved on from the older ones
+//*****************************************************************************
+static int	GetNextTileJob(void)
+{
+int			iii;
+int			slotIdx;
+uint32_t	currentMilliSecs;
+uint32_t	slotAge;
+uint32_t	bestAge;
+bool		bestIsPrefetch;
+
+	slotIdx				=	-1;
+	bestAge				=	0;
+	bestIsPrefetch		=	true;
+	currentMilliSecs	=	millis();
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		if (gGaiaDataList[iii].tileState == kGaiaTile_Queued)
+		{
+			slotAge	=	currentMilliSecs - gGaiaDataList[iii].lastUsedMilliSecs;
+			if ((slotIdx < 0) ||
+				(bestIsPrefetch && (gGaiaDataList[iii].isPrefetch == false)) ||
+				((bestIsPrefetch == gGaiaDataList[iii].isPrefetch) && (slotAge < bestAge)))
+			{
+				slotIdx			=	iii;
+				bestAge			=	slotAge;
+				bestIsPrefetch	=	gGaiaDataList[iii].isPrefetch;
+			}
+		}
+	}
+	return(slotIdx);
+}
+
+//*****************************************************************************
+static void	*GaiaTileWorkerThread(void *arg)
+{
+TYPE_GaiaTileWorker		*tileWorker;
+TYPE_GAIA_REMOTE_DATA	*tileSlot;
+TYPE_CelestData			*gaiaData;
+long					starCount;
+int						slotIdx;
+int						generation;
+int						block_RA_deg;
+int						block_DEC_deg;
+char					dataBaseName[32];
+bool					successFlag;
+bool					fromTileStore;
+uint32_t				startMilliSecs;
+uint32_t				endMilliSecs;
+
+	tileWorker	=	(TYPE_GaiaTileWorker *)arg;
+	pthread_mutex_lock(&gGaiaTileMutex);
+	while (gGaiaTileKeepRunning)
+	{
+		slotIdx	=	GetNextTileJob();
+		if (slotIdx >= 0)
+		{
+			tileSlot				=	&gGaiaDataList[slotIdx];
+			tileSlot->tileState		=	kGaiaTile_Fetching;
+			tileSlot->serverReqCount	+=	1;
+			gettimeofday(&tileSlot->timeStamp, NULL);	//*	save the time we started the request
+			generation				=	tileSlot->generation;
+			block_RA_deg			=	tileSlot->block_RA_deg;
+			block_DEC_deg			=	tileSlot->block_DEC_deg;
+			strcpy(dataBaseName, gGaiaTileDataBase);
+			pthread_mutex_unlock(&gGaiaTileMutex);
+
+			//*	the tile store first, the server if it is not there
+			startMilliSecs	=	millis();
+			fromTileStore	=	true;
+			gaiaData		=	ReadTileStore(dataBaseName, block_RA_deg, block_DEC_deg, &starCount, &successFlag);
+			if (successFlag == false)
+			{
+				fromTileStore	=	false;
+				gaiaData		=	gGaiaTileFetchProc(	&tileWorker->connection,
+														dataBaseName,
+														block_RA_deg,
+														block_DEC_deg,
+														&starCount,
+														&successFlag);
+				if (successFlag)
+				{
+					//*	sort the data to speed up drawing, the store keeps it sorted
+					if ((gaiaData != NULL) && (starCount > 1))
+					{
+						qsort(gaiaData, starCount, sizeof(TYPE_CelestData), GaiaTileDeclinationQsortProc);
+					}
+					WriteTileStore(dataBaseName, block_RA_deg, block_DEC_deg, gaiaData, starCount);
+				}
+			}
+			endMilliSecs	=	millis();
+
+			pthread_mutex_lock(&gGaiaTileMutex);
+			tileSlot	=	&gGaiaDataList[slotIdx];
+			if ((tileSlot->generation == generation) && (tileSlot->tileState == kGaiaTile_Fetching))
+			{
+				if (successFlag && tileSlot->isPrefetch &&
+					((gGaiaTileMemoryUsed + (starCount * (long)sizeof(TYPE_CelestData))) > gGaiaTileMaxBytes))
+				{
+					//*	no room for it, it is in the tile store if the view gets there
+					if (gaiaData != NULL)
+					{
+						free(gaiaData);
+					}
+					ReleaseTileSlot(tileSlot);
+				}
+				else if (successFlag)
+				{
+					tileSlot->gaiaData			=	gaiaData;
+					tileSlot->memoryBytes		=	starCount * sizeof(TYPE_CelestData);
+					tileSlot->elapsedMilliSecs	=	endMilliSecs - startMilliSecs;
+					tileSlot->fromTileStore		=	fromTileStore;
+					tileSlot->sequenceNum		=	gGaiaTileSequenceNum;
+					gGaiaTileSequenceNum++;
+					gGaiaTileMemoryUsed			+=	tileSlot->memoryBytes;
+					//*	the drawing code does not lock, make sure it sees the data before the count
+					__sync_synchronize();
+					tileSlot->gaiaDataCnt		=	starCount;
+					tileSlot->tileState			=	kGaiaTile_Ready;
+				}
+				else
+				{
+					//*	same as before, the block gets requested again the next time it is in view
+					ReleaseTileSlot(tileSlot);
+				}
+			}
+			else if (gaiaData != NULL)
+			{
+				//*	the slot was cleared while we were working on it
+				free(gaiaData);
+			}
+		}
+		else
+		{
+			pthread_cond_wait(&gGaiaTileCondition, &gGaiaTileMutex);
+		}
+	}
+	pthread_mutex_unlock(&gGaiaTileMutex);
+
+	if (gGaiaTileCloseProc != NULL)
+	{
+		gGaiaTileCloseProc(&tileWorker->connection);
+	}
+	return(NULL);
+}
+
+//*****************************************************************************
+//*	the workers must not be running, maxMemoryBytes <= 0 keeps the default
+//*****************************************************************************
+void	GaiaTileCache_Init(const char *tileStoreDir, const long maxMemoryBytes)
+{
+	if (gGaiaTileWorkerCnt == 0)
+	{
+		if (tileStoreDir != NULL)
+		{
+			strncpy(gGaiaTileStoreDir, tileStoreDir, sizeof(gGaiaTileStoreDir) - 1);
+		}
+		if (maxMemoryBytes > 0)
+		{
+			gGaiaTileMaxBytes	=	maxMemoryBytes;
+		}
+	}
+}
+
+//*****************************************************************************
+//*	returns 0=OK, -1, failed to create, +1 already running
+//*****************************************************************************
+int	GaiaTileCache_StartWorkers(	GaiaTileFetchProc	fetchProc,
+								GaiaTileCloseProc	closeProc,
+								const int			workerCount)
+{
+int		threadStatus;
+int		threadErr;
+int		myWorkerCount;
+int		iii;
+
+	if (gGaiaTileWorkerCnt == 0)
+	{
+		myWorkerCount	=	workerCount;
+		if (myWorkerCount < 1)
+		{
+			myWorkerCount	=	1;
+		}
+		if (myWorkerCount > kGaiaTileMaxWorkers)
+		{
+			myWorkerCount	=	kGaiaTileMaxWorkers;
+		}
+		gGaiaTileFetchProc		=	fetchProc;
+		gGaiaTileCloseProc		=	closeProc;
+		gGaiaTileKeepRunning	=	true;
+		for (iii=0; iii<myWorkerCount; iii++)
+		{
+			memset(&gGaiaTileWorkers[gGaiaTileWorkerCnt], 0, sizeof(TYPE_GaiaTileWorker));
+			gGaiaTileWorkers[gGaiaTileWorkerCnt].workerIdx	=	gGaiaTileWorkerCnt;
+			threadErr	=	pthread_create(	&gGaiaTileWorkers[gGaiaTileWorkerCnt].threadID,
+											NULL,
+											&GaiaTileWorkerThread,
+											&gGaiaTileWorkers[gGaiaTileWorkerCnt]);
+			if (threadErr == 0)
+			{
+				gGaiaTileWorkerCnt++;
+			}
+			else
+			{
+				CONSOLE_DEBUG_W_NUM("Error on thread creation, Error number:", threadErr);
+			}
+		}
+		CONSOLE_DEBUG_W_NUM("Gaia tile workers started\t=", gGaiaTileWorkerCnt);
+		threadStatus	=	(gGaiaTileWorkerCnt > 0) ? 0 : -1;
+	}
+	else
+	{
+		threadStatus	=	1;
+	}
+	return(threadStatus);
+}
+
+//*****************************************************************************
+//*	waits for any request in progress to finish
+//*****************************************************************************
+void	GaiaTileCache_StopWorkers(void)
+{
+int		iii;
+
+	pthread_mutex_lock(&gGaiaTileMutex);
+	gGaiaTileKeepRunning	=	false;
+	pthread_cond_broadcast(&gGaiaTileCondition);
+	pthread_mutex_unlock(&gGaiaTileMutex);
+
+	for (iii=0; iii<gGaiaTileWorkerCnt; iii++)
+	{
+		pthread_join(gGaiaTileWorkers[iii].threadID, NULL);
+	}
+	gGaiaTileWorkerCnt	=	0;
+}
+
+//*****************************************************************************
+bool	GaiaTileCache_WorkersRunning(void)
+{
+	return(gGaiaTileWorkerCnt > 0);
+}
+
+//*****************************************************************************
+//*	the tiles in memory are dropped if the database changes
+//*****************************************************************************
+void	GaiaTileCache_SetDataBase(const char *dataBaseName)
+{
+	if (strncmp(gGaiaTileDataBase, dataBaseName, sizeof(gGaiaTileDataBase) - 1) != 0)
+	{
+		GaiaTileCache_Clear();
+		pthread_mutex_lock(&gGaiaTileMutex);
+		strncpy(gGaiaTileDataBase, dataBaseName, sizeof(gGaiaTileDataBase) - 1);
+		pthread_mutex_unlock(&gGaiaTileMutex);
+	}
+}
+
+//*****************************************************************************
+//*	the mutex must be held
+//*****************************************************************************
+static int	QueueTile(	const double	ra_Degrees,
+						const double	dec_Degrees,
+						const bool		isPrefetch,
+						const uint32_t	useMilliSecs)
+{
+TYPE_GAIA_REMOTE_DATA	*tileSlot;
+int						block_RA_deg;
+int						block_DEC_deg;
+int						slotIdx;
+int						requestQueued;
+
+	requestQueued	=	0;
+	GaiaTileCache_GetBlock(ra_Degrees, dec_Degrees, &block_RA_deg, &block_DEC_deg);
+	slotIdx			=	FindTileSlot(block_RA_deg, block_DEC_deg);
+	if (slotIdx >= 0)
+	{
+		tileSlot	=	&gGaiaDataList[slotIdx];
+		if ((int32_t)(useMilliSecs - tileSlot->lastUsedMilliSecs) > 0)
+		{
+			tileSlot->lastUsedMilliSecs	=	useMilliSecs;
+		}
+		if (isPrefetch == false)
+		{
+			//*	it is in view now, move it up the queue
+			tileSlot->isPrefetch	=	false;
+		}
+	}
+	else
+	{
+		slotIdx	=	GetFreeTileSlot();
+		if (slotIdx >= 0)
+		{
+			tileSlot						=	&gGaiaDataList[slotIdx];
+			tileSlot->block_RA_deg			=	block_RA_deg;
+			tileSlot->block_DEC_deg			=	block_DEC_deg;
+			tileSlot->centerRA_deg			=	block_RA_deg + 0.5;
+			tileSlot->centerDEC_deg			=	block_DEC_deg + 0.5;
+			tileSlot->isPrefetch			=	isPrefetch;
+			tileSlot->lastUsedMilliSecs		=	useMilliSecs;
+			tileSlot->tileState				=	kGaiaTile_Queued;
+			tileSlot->validData				=	true;				//*	do this LAST
+
+			pthread_cond_signal(&gGaiaTileCondition);
+			requestQueued	=	1;
+		}
+		else
+		{
+			CONSOLE_DEBUG("Not able to find an available slot");
+		}
+	}
+	return(requestQueued);
+}
+
+//*****************************************************************************
+//*	returns 1 if a new request was queued, 0 if not
+//*****************************************************************************
+int	GaiaTileCache_Request(const double ra_Degrees, const double dec_Degrees)
+{
+int		requestQueued;
+
+	pthread_mutex_lock(&gGaiaTileMutex);
+	requestQueued	=	QueueTile(ra_Degrees, dec_Degrees, false, millis());
+	TrimTileCache();
+	pthread_mutex_unlock(&gGaiaTileMutex);
+	return(requestQueued);
+}
+
+//*****************************************************************************
+//*	queues the blocks just past the edge of the view in the direction it is moving,
+//*	kGaiaTilePrefetchDepth rows deep and 3 blocks wide.
+//*	The first call only remembers where the view is.
+//*	returns the number of new requests
+//*****************************************************************************
+int	GaiaTileCache_Prefetch(	const double	ra_Degrees,
+							const double	dec_Degrees,
+							const double	viewAngle_Degrees)
+{
+double		deltaRA_Deg;
+double		deltaDEC_Deg;
+double		motion_Deg;
+double		direction_RA;
+double		direction_DEC;
+double		cosDecl;
+double		distance_Deg;
+double		prefetch_RA;
+double		prefetch_DEC;
+int			depth;
+int			lateral;
+int			requestCount;
+uint32_t	currentMilliSecs;
+
+	requestCount		=	0;
+	currentMilliSecs	=	millis();
+	pthread_mutex_lock(&gGaiaTileMutex);
+	if (gGaiaTileLastViewValid)
+	{
+		//*	RA is scaled by cos(decl) so the direction is a real direction on the sky
+		cosDecl		=	cos(RADIANS(dec_Degrees));
+		if (cosDecl < 0.1)
+		{
+			cosDecl	=	0.1;
+		}
+		deltaRA_Deg	=	ra_Degrees - gGaiaTileLastRA_deg;
+		if (deltaRA_Deg > 180.0)
+		{
+			deltaRA_Deg	-=	360.0;
+		}
+		else if (deltaRA_Deg < -180.0)
+		{
+			deltaRA_Deg	+=	360.0;
+		}
+		deltaRA_Deg		=	deltaRA_Deg * cosDecl;
+		deltaDEC_Deg	=	dec_Degrees - gGaiaTileLastDEC_deg;
+		motion_Deg		=	sqrt((deltaRA_Deg * deltaRA_Deg) + (deltaDEC_Deg * deltaDEC_Deg));
+		if (motion_Deg >= kGaiaTileMinMotion_Deg)
+		{
+			direction_RA	=	deltaRA_Deg / motion_Deg;
+			direction_DEC	=	deltaDEC_Deg / motion_Deg;
+			for (depth=1; depth<=gGaiaTilePrefetchDepth; depth++)
+			{
+				distance_Deg	=	(viewAngle_Degrees / 2.0) + depth;
+				for (lateral=-1; lateral<=1; lateral++)
+				{
+					//*	(-direction_DEC, direction_RA) is perpendicular to the motion
+					prefetch_DEC	=	dec_Degrees + (direction_DEC * distance_Deg) + (direction_RA * lateral);
+					prefetch_RA		=	ra_Degrees + (((direction_RA * distance_Deg) - (direction_DEC * lateral)) / cosDecl);
+					if ((prefetch_DEC < 90.0) && (prefetch_DEC >= -90.0))
+					{
+						//*	the closer rows get fetched first
+						requestCount	+=	QueueTile(prefetch_RA, prefetch_DEC, true, (currentMilliSecs - depth));
+					}
+				}
+			}
+			gGaiaTileLastRA_deg		=	ra_Degrees;
+			gGaiaTileLastDEC_deg	=	dec_Degrees;
+		}
+	}
+	else
+	{
+		gGaiaTileLastRA_deg		=	ra_Degrees;
+		gGaiaTileLastDEC_deg	=	dec_Degrees;
+		gGaiaTileLastViewValid	=	true;
+	}
+	TrimTileCache();
+	pthread_mutex_unlock(&gGaiaTileMutex);
+	return(requestCount);
+}
+
+//*****************************************************************************
+bool	GaiaTileCache_IsReady(const double ra_Degrees, const double dec_Degrees)
+{
+int		block_RA_deg;
+int		block_DEC_deg;
+int		slotIdx;
+bool	tileIsReady;
+
+	tileIsReady	=	false;
+	GaiaTileCache_GetBlock(ra_Degrees, dec_Degrees, &block_RA_deg, &block_DEC_deg);
+	pthread_mutex_lock(&gGaiaTileMutex);
+	slotIdx		=	FindTileSlot(block_RA_deg, block_DEC_deg);
+	if ((slotIdx >= 0) && (gGaiaDataList[slotIdx].tileState == kGaiaTile_Ready))
+	{
+		tileIsReady	=	true;
+	}
+	pthread_mutex_unlock(&gGaiaTileMutex);
+	return(tileIsReady);
+}
+
+//*****************************************************************************
+//*	empties the memory cache, the tile store on disk is left alone
+//*****************************************************************************
+void	GaiaTileCache_Clear(void)
+{
+int		iii;
+
+	pthread_mutex_lock(&gGaiaTileMutex);
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		ReleaseTileSlot(&gGaiaDataList[iii]);
+	}
+	gGaiaTileMemoryUsed		=	0;
+	gGaiaTileLastViewValid	=	false;
+	pthread_mutex_unlock(&gGaiaTileMutex);
+}
+
+//*****************************************************************************
+//*	Request() and Prefetch() do this, the tiles that came in since then can put
+//*	the cache over the limit until the next time one of them is called
+//*****************************************************************************
+void	GaiaTileCache_Trim(void)
+{
+	pthread_mutex_lock(&gGaiaTileMutex);
+	TrimTileCache();
+	pthread_mutex_unlock(&gGaiaTileMutex);
+}
+
+//*****************************************************************************
+long	GaiaTileCache_GetMemoryUsed(void)
+{
+	return(gGaiaTileMemoryUsed);
+}
+
+
+#ifdef _INCLUDE_GAIA_TILE_MAIN_
+#include	<dirent.h>
+
+//*****************************************************************************
+//*	Benchmark, uses a stand in for the SQL server so it can be run anywhere.
+//*	The stand in answers from a CSV file of stars, same columns the SQL
+//*	procedures return (name,ra,dec,magnitude,bp_rp) in degrees, or makes up
+//*	stars if no file is given. Every query waits kStandInLatency_ms like a
+//*	remote server would.
+//*
+//*		gaiatilebench [stars.csv]
+//*****************************************************************************
+#define	kStandInLatency_ms		250
+#define	kStandInMaxStars		2000000
+#define	kBenchFrameCount		80
+#define	kBenchFrame_ms			100		//*	panning at 0.3 degrees per frame = 3 degrees per second
+#define	kBenchStep_Deg			0.3
+#define	kBenchViewAngle_Deg		3.0
+
+static	TYPE_CelestData	*gStandInStars		=	NULL;
+static	long			gStandInStarCnt		=	0;
+static	int				gStandInQueryCnt	=	0;
+
+//*****************************************************************************
+static void	LoadStandInFile(const char *filePath)
+{
+FILE			*filePointer;
+char			lineBuff[256];
+char			starName[kLongNameMax];
+double			ra_Degrees;
+double			dec_Degrees;
+double			magnitude;
+double			bp_rp;
+
+	filePointer	=	fopen(filePath, "r");
+	if (filePointer != NULL)
+	{
+		gStandInStars	=	(TYPE_CelestData *)calloc(kStandInMaxStars, sizeof(TYPE_CelestData));
+		while ((gStandInStars != NULL) && (gStandInStarCnt < kStandInMaxStars) &&
+				(fgets(lineBuff, sizeof(lineBuff), filePointer) != NULL))
+		{
+			if (sscanf(lineBuff, "%31[^,],%lf,%lf,%lf,%lf", starName, &ra_Degrees, &dec_Degrees, &magnitude, &bp_rp) == 5)
+			{
+				strcpy(gStandInStars[gStandInStarCnt].longName, starName);
+				gStandInStars[gStandInStarCnt].org_ra			=	RADIANS(ra_Degrees);
+				gStandInStars[gStandInStarCnt].org_decl			=	RADIANS(dec_Degrees);
+				gStandInStars[gStandInStarCnt].realMagnitude	=	magnitude;
+				gStandInStarCnt++;
+			}
+		}
+		fclose(filePointer);
+		printf("Stand in server has %ld stars from %s\n", gStandInStarCnt, filePath);
+	}
+	else
+	{
+		printf("Unable to open %s\n", filePath);
+	}
+}
+
+//*****************************************************************************
+static TYPE_CelestData	*StandInFetchProc(	void		**workerConnection,
+											const char	*dataBaseName,
+											const int	block_RA_deg,
+											const int	block_DEC_deg,
+											long		*starCount,
+											bool		*successFlag)
+{
+TYPE_CelestData	*gaiaData;
+long			recNum;
+long			maxRecords;
+long			iii;
+unsigned int	randomSeed;
+double			ra_Degrees;
+double			dec_Degrees;
+bool			polarBlock;
+
+	__sync_fetch_and_add(&gStandInQueryCnt, 1);
+	usleep(kStandInLatency_ms * 1000);
+
+	recNum		=	0;
+	polarBlock	=	IsPolarBlock(block_DEC_deg);
+	if (gStandInStars != NULL)
+	{
+		//*	scan the whole file, a server would use an index
+		maxRecords	=	1000;
+		gaiaData	=	(TYPE_CelestData *)malloc(maxRecords * sizeof(TYPE_CelestData));
+		for (iii=0; (gaiaData != NULL) && (iii<gStandInStarCnt); iii++)
+		{
+			ra_Degrees	=	gStandInStars[iii].org_ra * 180.0 / M_PI;
+			dec_Degrees	=	gStandInStars[iii].org_decl * 180.0 / M_PI;
+			if ((floor(dec_Degrees) == block_DEC_deg) && (polarBlock || (floor(ra_Degrees) == block_RA_deg)))
+			{
+				if (recNum >= maxRecords)
+				{
+					maxRecords	=	maxRecords * 2;
+					gaiaData	=	(TYPE_CelestData *)realloc(gaiaData, maxRecords * sizeof(TYPE_CelestData));
+				}
+				if (gaiaData != NULL)
+				{
+					gaiaData[recNum]	=	gStandInStars[iii];
+					recNum++;
+				}
+			}
+		}
+	}
+	else
+	{
+		//*	the same made up stars every time for a given block
+		randomSeed	=	((block_DEC_deg + 90) * 360) + block_RA_deg;
+		maxRecords	=	500 + (rand_r(&randomSeed) % 2500);
+		gaiaData	=	(TYPE_CelestData *)calloc(maxRecords, sizeof(TYPE_CelestData));
+		for (iii=0; (gaiaData != NULL) && (iii<maxRecords); iii++)
+		{
+			ra_Degrees		=	(polarBlock ? 0.0 : block_RA_deg) + ((polarBlock ? 360.0 : 1.0) * rand_r(&randomSeed) / RAND_MAX);
+			dec_Degrees		=	block_DEC_deg + (1.0 * rand_r(&randomSeed) / RAND_MAX);
+			sprintf(gaiaData[recNum].longName, "%d%07ld", block_RA_deg, iii);
+			gaiaData[recNum].realMagnitude	=	12.0 + (9.0 * rand_r(&randomSeed) / RAND_MAX);
+			gaiaData[recNum].org_ra			=	RADIANS(ra_Degrees);
+			gaiaData[recNum].org_decl		=	RADIANS(dec_Degrees);
+			recNum++;
+		}
+	}
+	for (iii=0; (gaiaData != NULL) && (iii<recNum); iii++)
+	{
+		gaiaData[iii].ra		=	gaiaData[iii].org_ra;
+		gaiaData[iii].decl		=	gaiaData[iii].org_decl;
+		gaiaData[iii].dataSrc	=	kDataSrc_GAIA_SQL;
+	}
+	*starCount		=	recNum;
+	*successFlag	=	true;
+	return(gaiaData);
+}
+
+//*****************************************************************************
+//*	pans across the sky the way SkyTravel asks for blocks (the one in the center
+//*	and one on each side) and measures how long the view waits for its blocks
+//*****************************************************************************
+static void	RunPanBenchmark(const char *testName, const int workerCount, const int prefetchDepth)
+{
+int			frameNum;
+int			iii;
+double		ra_Degrees;
+double		dec_Degrees;
+uint32_t	startMilliSecs;
+uint32_t	waitMilliSecs;
+uint32_t	totalWait;
+uint32_t	maxWait;
+int			stalledFrames;
+int			queryCntStart;
+bool		allReady;
+
+	gGaiaTilePrefetchDepth	=	prefetchDepth;
+	GaiaTileCache_StartWorkers(&StandInFetchProc, NULL, workerCount);
+	queryCntStart	=	gStandInQueryCnt;
+	totalWait		=	0;
+	maxWait			=	0;
+	stalledFrames	=	0;
+	ra_Degrees		=	100.0;
+	dec_Degrees		=	20.0;
+	for (frameNum=0; frameNum<kBenchFrameCount; frameNum++)
+	{
+		for (iii=-1; iii<=1; iii++)
+		{
+			GaiaTileCache_Request(ra_Degrees + iii, dec_Degrees);
+		}
+		GaiaTileCache_Prefetch(ra_Degrees, dec_Degrees, kBenchViewAngle_Deg);
+
+		//*	wait for the blocks in view
+		startMilliSecs	=	millis();
+		allReady		=	false;
+		while (allReady == false)
+		{
+			allReady	=	true;
+			for (iii=-1; iii<=1; iii++)
+			{
+				allReady	=	allReady && GaiaTileCache_IsReady(ra_Degrees + iii, dec_Degrees);
+			}
+			if (allReady == false)
+			{
+				usleep(2000);
+			}
+		}
+		waitMilliSecs	=	millis() - startMilliSecs;
+		totalWait		+=	waitMilliSecs;
+		if (waitMilliSecs > maxWait)
+		{
+			maxWait	=	waitMilliSecs;
+		}
+		if (waitMilliSecs > 20)
+		{
+			stalledFrames++;
+		}
+		usleep(kBenchFrame_ms * 1000);
+		ra_Degrees	+=	kBenchStep_Deg;
+	}
+	GaiaTileCache_StopWorkers();
+	GaiaTileCache_Trim();
+	printf("%-34s\tstalled frames=%2d/%d\ttotal wait=%5u ms\tmax wait=%4u ms\tserver queries=%3d\tmemory=%ld KB\n",
+			testName,
+			stalledFrames,
+			kBenchFrameCount,
+			totalWait,
+			maxWait,
+			(gStandInQueryCnt - queryCntStart),
+			(GaiaTileCache_GetMemoryUsed() / 1024));
+}
+
+//*****************************************************************************
+//*	the tile store is <storeDir>/<database>/*.gtile
+//*****************************************************************************
+static void	RemoveBenchTileStore(const char *storeDir)
+{
+DIR				*storeDirectory;
+DIR				*dataBaseDirectory;
+struct dirent	*storeEntry;
+struct dirent	*tileEntry;
+char			dataBasePath[512];
+char			tileFilePath[1024];
+
+	storeDirectory	=	opendir(storeDir);
+	if (storeDirectory != NULL)
+	{
+		while ((storeEntry = readdir(storeDirectory)) != NULL)
+		{
+			if (storeEntry->d_name[0] != '.')
+			{
+				snprintf(dataBasePath, sizeof(dataBasePath), "%s/%s", storeDir, storeEntry->d_name);
+				dataBaseDirectory	=	opendir(dataBasePath);
+				if (dataBaseDirectory != NULL)
+				{
+					while ((tileEntry = readdir(dataBaseDirectory)) != NULL)
+					{
+						if (tileEntry->d_name[0] != '.')
+						{
+							snprintf(tileFilePath, sizeof(tileFilePath), "%s/%s", dataBasePath, tileEntry->d_name);
+							unlink(tileFilePath);
+						}
+					}
+					closedir(dataBaseDirectory);
+				}
+				rmdir(dataBasePath);
+			}
+		}
+		closedir(storeDirectory);
+	}
+	rmdir(storeDir);
+}
+
+//*****************************************************************************
+int main(int argc, char *argv[])
+{
+char	storeDir1[]	=	"/tmp/gaiatilebench_XXXXXX";
+char	storeDir2[]	=	"/tmp/gaiatilebench_XXXXXX";
+
+	if (argc > 1)
+	{
+		LoadStandInFile(argv[1]);
+	}
+	if ((mkdtemp(storeDir1) == NULL) || (mkdtemp(storeDir2) == NULL))
+	{
+		printf("Unable to create the tile store directories\n");
+		return(1);
+	}
+	printf("Gaia tile cache benchmark, %d frames, %1.1f deg/frame, server latency %d ms\n",
+					kBenchFrameCount, kBenchStep_Deg, kStandInLatency_ms);
+
+	GaiaTileCache_SetDataBase("gaia");
+
+	//*	the way it used to be, one thread and nothing saved between sessions
+	GaiaTileCache_Init(storeDir1, 0);
+	RunPanBenchmark("1 worker, no prefetch (original)", 1, 0);
+	GaiaTileCache_Clear();
+
+	GaiaTileCache_Init(storeDir2, 0);
+	RunPanBenchmark("3 workers + prefetch, cold store", kGaiaTileDefaultWorkers, kGaiaTilePrefetchDepth);
+	GaiaTileCache_Clear();
+
+	//*	a new session over the same part of the sky
+	RunPanBenchmark("3 workers + prefetch, warm store", kGaiaTileDefaultWorkers, kGaiaTilePrefetchDepth);
+	GaiaTileCache_Clear();
+
+	//*	memory limit smaller than the pan, the older blocks have to go
+	GaiaTileCache_Init(storeDir2, 4 * 1024 * 1024);
+	RunPanBenchmark("warm store, 4 MB memory limit", kGaiaTileDefaultWorkers, kGaiaTilePrefetchDepth);
+	GaiaTileCache_Clear();
+
+	RemoveBenchTileStore(storeDir1);
+	RemoveBenchTileStore(storeDir2);
+	return(0);
+}
+#endif // _INCLUDE_GAIA_TILE_MAIN_
+
+#endif // _ENABLE_REMOTE_GAIA_
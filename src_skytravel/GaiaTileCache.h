@@ -0,0 +1,85 @@
+//*****************************************************************************
+//*	GaiaTileCache.h
+//*****************************************************************************
+//#include	"GaiaTileCache.h"
+
+#ifndef _GAIA_TILE_CACHE_H_
+#define	_GAIA_TILE_CACHE_H_
+
+#ifndef _GAIA_SQL_H_
+	#include	"GaiaSQL.h"
+#endif
+
+#define	kGaiaTileStoreDir			"GaiaTileStore"
+#define	kGaiaTileStoreMagic			"GTILE01"
+#define	kGaiaTileStoreVersion		1
+#define	kGaiaTileStoreExtension		".gtile"
+
+#define	kGaiaTileDefaultWorkers		3
+#define	kGaiaTileMaxWorkers			8
+#define	kGaiaTileDefaultMaxBytes	(256L * 1024L * 1024L)	//*	in memory tiles, not the disk store
+#define	kGaiaTilePrefetchDepth		2		//*	tiles ahead of the view in the direction of motion
+#define	kGaiaTileMinMotion_Deg		0.25	//*	less than this is not considered moving
+#define	kGaiaTileQueueTimeout		30000	//*	queued tiles not asked for in this long are dropped
+
+//*****************************************************************************
+//*	tileState values in TYPE_GAIA_REMOTE_DATA
+//*****************************************************************************
+enum
+{
+	kGaiaTile_Empty	=	0,
+	kGaiaTile_Queued,
+	kGaiaTile_Fetching,
+	kGaiaTile_Ready
+
+};
+
+//*****************************************************************************
+//*	fetches one 1x1 degree block (the whole ring above kPolarDeclinationLimit)
+//*	from the server, called from the worker threads.
+//*	workerConnection belongs to the calling worker, it starts out NULL and is
+//*	passed to the close proc when the worker exits.
+//*	returns NULL with successFlag true if the block has no stars
+//*****************************************************************************
+typedef TYPE_CelestData	*(*GaiaTileFetchProc)(	void		**workerConnection,
+												const char	*dataBaseName,
+												const int	block_RA_deg,
+												const int	block_DEC_deg,
+												long		*starCount,
+												bool		*successFlag);
+typedef void			(*GaiaTileCloseProc)(void **workerConnection);
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+void	GaiaTileCache_Init(const char *tileStoreDir, const long maxMemoryBytes);
+int		GaiaTileCache_StartWorkers(	GaiaTileFetchProc	fetchProc,
+									GaiaTileCloseProc	closeProc,
+									const int			workerCount);
+void	GaiaTileCache_StopWorkers(void);
+bool	GaiaTileCache_WorkersRunning(void);
+void	GaiaTileCache_SetDataBase(const char *dataBaseName);
+
+//*	returns 1 if a new request was queued, 0 if not
+int		GaiaTileCache_Request(const double ra_Degrees, const double dec_Degrees);
+int		GaiaTileCache_Prefetch(	const double	ra_Degrees,
+								const double	dec_Degrees,
+								const double	viewAngle_Degrees);
+bool	GaiaTileCache_IsReady(const double ra_Degrees, const double dec_Degrees);
+void	GaiaTileCache_Clear(void);
+void	GaiaTileCache_Trim(void);
+long	GaiaTileCache_GetMemoryUsed(void);
+void	GaiaTileCache_GetBlock(	const double	ra_Degrees,
+								const double	dec_Degrees,
+								int				*block_RA_deg,
+								int				*block_DEC_deg);
+
+extern	int		gGaiaTilePrefetchDepth;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _GAIA_TILE_CACHE_H_
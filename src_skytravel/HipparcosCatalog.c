@@ -9,6 +9,7 @@
 //*	Feb 18,	2021	<MLS> Added support for common star names
 //*	Feb 18,	2021	<MLS> Added ReadCommonStarNames()
 //*	Jun  3,	2023	<MLS> Added parsing of parallax to Hipparcos
+//*	Oct 18,	2026	<AGT> Hipparcos catalog is now loaded from the binary cache if up to date
 //*****************************************************************************
 //--------------------------------------------------------------------------------
 //Byte-by-byte Description of file: hip_main.dat
@@ -205,6 +206,7 @@
 #include	"controller_startup.h"
 
 #include	"StarCatalogHelper.h"
+#include	"CatalogCache.h"
 
 
 #include	"HipparcosCatalog.h"
@@ -347,12 +349,16 @@ int				startupWidgetIdx;
 
 	startupWidgetIdx	=	SetStartupText("Hipparcos catalog:");
 
-	hipStarData	=	NULL;
-
 	strcpy(filePath, kSkyTravelDataDirectory);
 	strcat(filePath, "/hip_main.dat");
 
-	filePointer	=	fopen(filePath, "r");
+	//*	use the binary cache if it is up to date
+	filePointer	=	NULL;
+	hipStarData	=	CatalogCache_Read(filePath, starCount);
+	if (hipStarData == NULL)
+	{
+		filePointer	=	fopen(filePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 		//*	get the file size
@@ -381,10 +387,15 @@ int				startupWidgetIdx;
 				}
 			}
 			*starCount	=	recordCount;
+			CatalogCache_Save(filePath, hipStarData, recordCount);
 		}
 		fclose(filePointer);
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (hipStarData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		SetStartupTextStatus(startupWidgetIdx, "Failed");
@@ -24,6 +24,7 @@
 //*	Jun 17,	2022	<MLS> Added error checking to ParseOneLine_OpenNGC()
 //*	Aug 22,	2023	<MLS> Added axis and angle parsing
 //*	Sep 27,	2023	<MLS> The latest version of OpenNGC changed file location
+//*	Oct 18,	2026	<AGT> OpenNGC catalog uses the binary cache (CatalogCache.c)
 //*****************************************************************************
 //*	https://github.com/mattiaverga/OpenNGC
 //*	git clone https://github.com/mattiaverga/OpenNGC.git
@@ -45,6 +46,7 @@
 #include	"controller_startup.h"
 
 #include	"OpenNGC.h"
+#include	"CatalogCache.h"
 
 #define _ENABLE_CONSOLE_DEBUG_
 #include	"ConsoleDebug.h"
@@ -399,7 +401,13 @@ int				returnCode;
 //		CONSOLE_DEBUG_W_STR("NGC File found at", filePath);
 //	}
 
-	filePointer	=	fopen(filePath, "r");
+	//*	use the binary cache if it is up to date
+	filePointer	=	NULL;
+	ngcStarData	=	CatalogCache_Read(filePath, starCount);
+	if (ngcStarData == NULL)
+	{
+		filePointer	=	fopen(filePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 		ngcLineCount	=	13969;
@@ -426,6 +434,7 @@ int				returnCode;
 			}
 
 			*starCount	=	recordCount;
+			CatalogCache_Save(filePath, ngcStarData, recordCount);
 
 			//*	make note that we are using OpenNGC
 			strcpy(gNGCDatbase, "OpenNGC");
@@ -433,6 +442,12 @@ int				returnCode;
 		fclose(filePointer);
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (ngcStarData != NULL)
+	{
+		//*	make note that we are using OpenNGC
+		strcpy(gNGCDatbase, "OpenNGC");
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("File not found\t=", filePath);
@@ -0,0 +1,835 @@
+//*****************************************************************************
+//*	PrecessEngine.c
+//*
+//*	Batch precession, nutation and proper motion for the star catalogs.
+//*
+//*	The original SkyTravel precession code did the spherical trig for each object,
+//*	about 9 sin/cos/asin/acos calls per star. Here the precession angles and nutation
+//*	are combined into one rotation matrix, the J2000 positions of the large catalogs
+//*	are kept here as unit vectors so each object is 9 multiply/adds plus 2 atan2 calls.
+//*	The vectors are extra memory, 24 bytes per object (48 with proper motion).
+//*	The multiply/add stage runs over a block of objects at a time with no branches
+//*	so the compiler can use the SIMD registers for it.
+//*	Large catalogs are split across threads.
+//*
+//*	The result is always written back to the same index, the order of the catalog
+//*	does not change.
+//*
+//*	To build the benchmark
+//*		make precessbench
+//*		./precessbench [object count]
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created PrecessEngine.c
+//*	Oct 18,	2026	<AGT> Added nutation (IAU 1980 leading terms)
+//*	Oct 18,	2026	<AGT> Added proper motion for Hipparcos data
+//*	Oct 18,	2026	<AGT> Added _INCLUDE_PRECESS_MAIN_ benchmark
+//*	Oct 18,	2026	<AGT> The unit vectors are now kept here, CelestCatalog.c removed
+//*****************************************************************************
+
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+#include	<stdint.h>
+#include	<math.h>
+#include	<unistd.h>
+#include	<pthread.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"SkyStruc.h"
+#include	"SkyTravelConstants.h"
+#include	"StarData.h"
+#include	"PrecessEngine.h"
+
+#define	kArcSecToRadians	(kTWOPI / (360.0 * 3600.0))
+#define	kMasToRadians		(kArcSecToRadians / 1000.0)
+
+//*****************************************************************************
+//*	J2000 position (and proper motion) of each object as a unit vector,
+//*	row N is objects[N], so the catalog must not be re-ordered once these exist
+//*****************************************************************************
+typedef struct
+{
+	TYPE_CelestData	*objects;			//*	the catalog itself, not owned by this
+	long			count;
+	double			*org_x;
+	double			*org_y;
+	double			*org_z;
+	double			*pm_x;				//*	radians/year, NULL if nothing in this catalog moves
+	double			*pm_y;
+	double			*pm_z;
+	double			pmEpoch_JD;			//*	epoch of the catalog positions for proper motion
+} TYPE_PrecessVectors;
+
+static	TYPE_PrecessVectors	gPrecessVectorList[kPrecessMaxCatalogs];
+
+//*****************************************************************************
+typedef struct
+{
+	const TYPE_PrecessMatrix	*precMatrix;
+	TYPE_PrecessVectors			*vectors;
+	long						startIdx;
+	long						stopIdx;
+	double						pmYears;
+} TYPE_PrecessThreadArgs;
+
+//*****************************************************************************
+static void	MatrixMultiply(double result[3][3], double left[3][3], double right[3][3])
+{
+int		iii;
+int		jjj;
+double	product[3][3];
+
+	for (iii=0; iii<3; iii++)
+	{
+		for (jjj=0; jjj<3; jjj++)
+		{
+			product[iii][jjj]	=	(left[iii][0] * right[0][jjj]) +
+									(left[iii][1] * right[1][jjj]) +
+									(left[iii][2] * right[2][jjj]);
+		}
+	}
+	memcpy(result, product, sizeof(product));
+}
+
+//*****************************************************************************
+//*	rotates a vector about the X axis
+//*****************************************************************************
+static void	MatrixRotateX(double matrix[3][3], const double angle)
+{
+	memset(matrix, 0, 9 * sizeof(double));
+	matrix[0][0]	=	1.0;
+	matrix[1][1]	=	cos(angle);
+	matrix[1][2]	=	-sin(angle);
+	matrix[2][1]	=	sin(angle);
+	matrix[2][2]	=	cos(angle);
+}
+
+//*****************************************************************************
+//*	rotates a vector about the Z axis, i.e. adds angle to the RA
+//*****************************************************************************
+static void	MatrixRotateZ(double matrix[3][3], const double angle)
+{
+	memset(matrix, 0, 9 * sizeof(double));
+	matrix[0][0]	=	cos(angle);
+	matrix[0][1]	=	-sin(angle);
+	matrix[1][0]	=	sin(angle);
+	matrix[1][1]	=	cos(angle);
+	matrix[2][2]	=	1.0;
+}
+
+//*****************************************************************************
+//*	Nutation in longitude and obliquity (radians)
+//*	This is the low accuracy version from Meeus, Astronomical Algorithms chapter 22,
+//*	good to 0.5 arc-seconds, which is far below anything we can see on the screen
+//*****************************************************************************
+void	PrecessEngine_Nutation(	const double	julianDay,
+								double			*deltaPsi,
+								double			*deltaEps,
+								double			*meanObliquity)
+{
+double	centuries;
+double	omega;
+double	sunLong;
+double	moonLong;
+double	arcSeconds;
+
+	centuries	=	(julianDay - F2000) / FCENT;
+	omega		=	RADIANS(125.04452 - (1934.136261 * centuries));
+	sunLong		=	RADIANS(280.4665 + (36000.7698 * centuries));
+	moonLong	=	RADIANS(218.3165 + (481267.8813 * centuries));
+
+	*deltaPsi	=	((-17.20 * sin(omega))
+					- (1.32 * sin(2.0 * sunLong))
+					- (0.23 * sin(2.0 * moonLong))
+					+ (0.21 * sin(2.0 * omega))) * kArcSecToRadians;
+
+	*deltaEps	=	((9.20 * cos(omega))
+					+ (0.57 * cos(2.0 * sunLong))
+					+ (0.10 * cos(2.0 * moonLong))
+					- (0.09 * cos(2.0 * omega))) * kArcSecToRadians;
+
+	//*	23 26' 21.448"
+	arcSeconds		=	84381.448 - (centuries * (46.8150 + (centuries * (0.00059 - (centuries * 0.001813)))));
+	*meanObliquity	=	arcSeconds * kArcSecToRadians;
+}
+
+//*****************************************************************************
+//*	Builds the matrix from the precession angles that Precess() has always used
+//*		zeta	rotation about the J2000 pole
+//*		theta	tilt of the pole
+//*		z		rotation about the pole of date
+//*	and optionally nutation
+//*****************************************************************************
+void	PrecessEngine_SetupMatrix(	TYPE_PrecessMatrix	*precMatrix,
+									const double		pzeta,
+									const double		zee,
+									const double		ptheta,
+									const double		julianDay,
+									const bool			includeNutation)
+{
+double	rotation[3][3];
+double	deltaPsi;
+double	deltaEps;
+double	meanObliquity;
+
+	//*	P = Rz(z) * Ry(theta) * Rz(zeta)
+	MatrixRotateZ(precMatrix->matrix, pzeta);
+
+	memset(rotation, 0, sizeof(rotation));
+	rotation[0][0]	=	cos(ptheta);
+	rotation[0][2]	=	-sin(ptheta);
+	rotation[1][1]	=	1.0;
+	rotation[2][0]	=	sin(ptheta);
+	rotation[2][2]	=	cos(ptheta);
+	MatrixMultiply(precMatrix->matrix, rotation, precMatrix->matrix);
+
+	MatrixRotateZ(rotation, zee);
+	MatrixMultiply(precMatrix->matrix, rotation, precMatrix->matrix);
+
+	if (includeNutation)
+	{
+		//*	N = Rx(eps + deltaEps) * Rz(deltaPsi) * Rx(-eps)
+		//*	i.e. to the ecliptic, add deltaPsi to the longitude, back to the true equator
+		PrecessEngine_Nutation(julianDay, &deltaPsi, &deltaEps, &meanObliquity);
+
+		MatrixRotateX(rotation, -meanObliquity);
+		MatrixMultiply(precMatrix->matrix, rotation, precMatrix->matrix);
+
+		MatrixRotateZ(rotation, deltaPsi);
+		MatrixMultiply(precMatrix->matrix, rotation, precMatrix->matrix);
+
+		MatrixRotateX(rotation, meanObliquity + deltaEps);
+		MatrixMultiply(precMatrix->matrix, rotation, precMatrix->matrix);
+	}
+	precMatrix->julianDay			=	julianDay;
+	precMatrix->includesNutation	=	includeNutation;
+}
+
+//*****************************************************************************
+//*	Converts the J2000 position to a unit vector.
+//*	If proper motion is going to be applied, returns true and the motion vector
+//*	(radians/year) in the same frame.
+//*
+//*	Only Hipparcos has documented proper motion units (mu_alpha.cos(delta), mas/yr),
+//*	the other catalogs that have proper motion fields are not consistent.
+//*****************************************************************************
+bool	PrecessEngine_GetVectors(	const TYPE_CelestData	*theObject,
+									double					posVector[3],
+									double					pmVector[3],
+									double					*pmEpoch_JD)
+{
+bool	hasProperMotion;
+double	sinRA, cosRA;
+double	sinDecl, cosDecl;
+double	pmRA;
+double	pmDecl;
+
+	sinRA			=	sin(theObject->org_ra);
+	cosRA			=	cos(theObject->org_ra);
+	sinDecl			=	sin(theObject->org_decl);
+	cosDecl			=	cos(theObject->org_decl);
+
+	posVector[0]	=	cosDecl * cosRA;
+	posVector[1]	=	cosDecl * sinRA;
+	posVector[2]	=	sinDecl;
+
+	hasProperMotion	=	false;
+	pmVector[0]		=	0.0;
+	pmVector[1]		=	0.0;
+	pmVector[2]		=	0.0;
+	*pmEpoch_JD		=	JD2000;
+	if (theObject->propMotionValid && (theObject->dataSrc == kDataSrc_Hipparcos))
+	{
+		pmRA			=	theObject->propMotion_RA_mas_yr * kMasToRadians;
+		pmDecl			=	theObject->propMotion_DEC_mas_yr * kMasToRadians;
+
+		//*	pmRA is along the unit vector to the east, pmDecl is along the one to the north
+		pmVector[0]		=	(-pmRA * sinRA) - (pmDecl * sinDecl * cosRA);
+		pmVector[1]		=	(pmRA * cosRA) - (pmDecl * sinDecl * sinRA);
+		pmVector[2]		=	pmDecl * cosDecl;
+		*pmEpoch_JD		=	kHipparcosEpoch_JD;
+		hasProperMotion	=	true;
+	}
+	return(hasProperMotion);
+}
+
+//*****************************************************************************
+//*	for the small lists, the vectors are calculated for each object
+//*****************************************************************************
+void	PrecessEngine_TransformObjects(	const TYPE_PrecessMatrix	*precMatrix,
+										TYPE_CelestData				*objects,
+										const long					startIdx,
+										const long					stopIdx)
+{
+long	iii;
+int		jjj;
+double	posVector[3];
+double	pmVector[3];
+double	newVector[3];
+double	pmEpoch_JD;
+double	pmYears;
+double	newRA;
+
+	for (iii=startIdx; iii<stopIdx; iii++)
+	{
+		if (PrecessEngine_GetVectors(&objects[iii], posVector, pmVector, &pmEpoch_JD))
+		{
+			pmYears		=	(precMatrix->julianDay - pmEpoch_JD) / 365.25;
+			for (jjj=0; jjj<3; jjj++)
+			{
+				posVector[jjj]	+=	pmYears * pmVector[jjj];
+			}
+		}
+		for (jjj=0; jjj<3; jjj++)
+		{
+			newVector[jjj]	=	(precMatrix->matrix[jjj][0] * posVector[0]) +
+								(precMatrix->matrix[jjj][1] * posVector[1]) +
+								(precMatrix->matrix[jjj][2] * posVector[2]);
+		}
+		newRA	=	atan2(newVector[1], newVector[0]);
+		if (newRA < 0.0)
+		{
+			newRA	+=	kTWOPI;
+		}
+		objects[iii].ra		=	newRA;
+		objects[iii].decl	=	atan2(newVector[2], sqrt((newVector[0] * newVector[0]) + (newVector[1] * newVector[1])));
+	}
+}
+
+//*****************************************************************************
+static void	PrecessEngine_FreeVectors(TYPE_PrecessVectors *vectors)
+{
+	if (vectors->org_x != NULL)
+	{
+		free(vectors->org_x);
+	}
+	if (vectors->org_y != NULL)
+	{
+		free(vectors->org_y);
+	}
+	if (vectors->org_z != NULL)
+	{
+		free(vectors->org_z);
+	}
+	if (vectors->pm_x != NULL)
+	{
+		free(vectors->pm_x);
+	}
+	if (vectors->pm_y != NULL)
+	{
+		free(vectors->pm_y);
+	}
+	if (vectors->pm_z != NULL)
+	{
+		free(vectors->pm_z);
+	}
+	memset((void *)vectors, 0, sizeof(TYPE_PrecessVectors));
+}
+
+//*****************************************************************************
+//*	the proper motion vectors are only created if something in the catalog moves
+//*****************************************************************************
+static bool	PrecessEngine_BuildVectors(TYPE_PrecessVectors *vectors)
+{
+long			iii;
+TYPE_CelestData	*objects;
+double			posVector[3];
+double			pmVector[3];
+double			pmEpoch_JD;
+bool			hasProperMotion;
+bool			allocOK;
+
+	objects			=	vectors->objects;
+	vectors->org_x	=	(double *)malloc(vectors->count * sizeof(double));
+	vectors->org_y	=	(double *)malloc(vectors->count * sizeof(double));
+	vectors->org_z	=	(double *)malloc(vectors->count * sizeof(double));
+	allocOK			=	((vectors->org_x != NULL) && (vectors->org_y != NULL) && (vectors->org_z != NULL));
+	iii				=	0;
+	while (allocOK && (iii < vectors->count))
+	{
+		hasProperMotion		=	PrecessEngine_GetVectors(&objects[iii], posVector, pmVector, &pmEpoch_JD);
+		vectors->org_x[iii]	=	posVector[0];
+		vectors->org_y[iii]	=	posVector[1];
+		vectors->org_z[iii]	=	posVector[2];
+		if (hasProperMotion && (vectors->pm_x == NULL))
+		{
+			vectors->pm_x		=	(double *)calloc(vectors->count, sizeof(double));
+			vectors->pm_y		=	(double *)calloc(vectors->count, sizeof(double));
+			vectors->pm_z		=	(double *)calloc(vectors->count, sizeof(double));
+			vectors->pmEpoch_JD	=	pmEpoch_JD;
+			allocOK				=	((vectors->pm_x != NULL) && (vectors->pm_y != NULL) && (vectors->pm_z != NULL));
+		}
+		if (hasProperMotion && allocOK)
+		{
+			vectors->pm_x[iii]	=	pmVector[0];
+			vectors->pm_y[iii]	=	pmVector[1];
+			vectors->pm_z[iii]	=	pmVector[2];
+		}
+		iii++;
+	}
+	if (allocOK == false)
+	{
+		CONSOLE_DEBUG("Failed to allocate precession vectors");
+		PrecessEngine_FreeVectors(vectors);
+	}
+	return(allocOK);
+}
+
+//*****************************************************************************
+//*	returns the vectors for this catalog, creating them the first time,
+//*	NULL if the catalog is too small to bother or we are out of memory
+//*****************************************************************************
+static TYPE_PrecessVectors	*PrecessEngine_GetCatalogVectors(TYPE_CelestData *objects, const long count)
+{
+TYPE_PrecessVectors	*vectors;
+int					iii;
+
+	vectors	=	NULL;
+	if ((objects != NULL) && (count >= kPrecessVectorMinObjects))
+	{
+		for (iii=0; iii<kPrecessMaxCatalogs; iii++)
+		{
+			if (gPrecessVectorList[iii].objects == objects)
+			{
+				vectors	=	&gPrecessVectorList[iii];
+				break;
+			}
+		}
+		if (vectors == NULL)
+		{
+			for (iii=0; iii<kPrecessMaxCatalogs; iii++)
+			{
+				if (gPrecessVectorList[iii].objects == NULL)
+				{
+					vectors	=	&gPrecessVectorList[iii];
+					break;
+				}
+			}
+		}
+
+		if (vectors == NULL)
+		{
+			CONSOLE_DEBUG("Out of precession vector entries");
+		}
+		else if (vectors->count != count)
+		{
+			//*	new or re-loaded catalog
+			PrecessEngine_FreeVectors(vectors);
+			vectors->objects	=	objects;
+			vectors->count		=	count;
+			if (PrecessEngine_BuildVectors(vectors) == false)
+			{
+				vectors	=	NULL;
+			}
+		}
+	}
+	return(vectors);
+}
+
+//*****************************************************************************
+static void	PrecessEngine_TransformRows(const TYPE_PrecessMatrix	*precMatrix,
+										TYPE_PrecessVectors			*vectors,
+										const long					startIdx,
+										const long					stopIdx,
+										const double				pmYears)
+{
+long			blockStart;
+long			blockCnt;
+long			iii;
+TYPE_CelestData	*objects;
+const double	*org_x;
+const double	*org_y;
+const double	*org_z;
+double			newRA;
+double			xx[kPrecessBlockSize];
+double			yy[kPrecessBlockSize];
+double			zz[kPrecessBlockSize];
+double			m00, m01, m02;
+double			m10, m11, m12;
+double			m20, m21, m22;
+
+	m00	=	precMatrix->matrix[0][0];	m01	=	precMatrix->matrix[0][1];	m02	=	precMatrix->matrix[0][2];
+	m10	=	precMatrix->matrix[1][0];	m11	=	precMatrix->matrix[1][1];	m12	=	precMatrix->matrix[1][2];
+	m20	=	precMatrix->matrix[2][0];	m21	=	precMatrix->matrix[2][1];	m22	=	precMatrix->matrix[2][2];
+
+	objects	=	vectors->objects;
+	for (blockStart=startIdx; blockStart<stopIdx; blockStart+=kPrecessBlockSize)
+	{
+		blockCnt	=	stopIdx - blockStart;
+		if (blockCnt > kPrecessBlockSize)
+		{
+			blockCnt	=	kPrecessBlockSize;
+		}
+		org_x	=	&vectors->org_x[blockStart];
+		org_y	=	&vectors->org_y[blockStart];
+		org_z	=	&vectors->org_z[blockStart];
+
+		//*	stage 1: proper motion and rotation, straight arithmetic on the vectors
+		if (vectors->pm_x != NULL)
+		{
+			for (iii=0; iii<blockCnt; iii++)
+			{
+				xx[iii]	=	org_x[iii] + (pmYears * vectors->pm_x[blockStart + iii]);
+				yy[iii]	=	org_y[iii] + (pmYears * vectors->pm_y[blockStart + iii]);
+				zz[iii]	=	org_z[iii] + (pmYears * vectors->pm_z[blockStart + iii]);
+			}
+			org_x	=	xx;
+			org_y	=	yy;
+			org_z	=	zz;
+		}
+		for (iii=0; iii<blockCnt; iii++)
+		{
+		double	posX, posY, posZ;
+
+			posX	=	org_x[iii];
+			posY	=	org_y[iii];
+			posZ	=	org_z[iii];
+			xx[iii]	=	(m00 * posX) + (m01 * posY) + (m02 * posZ);
+			yy[iii]	=	(m10 * posX) + (m11 * posY) + (m12 * posZ);
+			zz[iii]	=	(m20 * posX) + (m21 * posY) + (m22 * posZ);
+		}
+
+		//*	stage 2: back to RA/DEC
+		for (iii=0; iii<blockCnt; iii++)
+		{
+			newRA	=	atan2(yy[iii], xx[iii]);
+			if (newRA < 0.0)
+			{
+				newRA	+=	kTWOPI;
+			}
+			objects[blockStart + iii].ra	=	newRA;
+			objects[blockStart + iii].decl	=	atan2(zz[iii], sqrt((xx[iii] * xx[iii]) + (yy[iii] * yy[iii])));
+		}
+	}
+}
+
+//*****************************************************************************
+static void	*PrecessEngine_Thread(void *arg)
+{
+TYPE_PrecessThreadArgs	*threadArgs;
+
+	threadArgs	=	(TYPE_PrecessThreadArgs *)arg;
+	PrecessEngine_TransformRows(threadArgs->precMatrix,
+								threadArgs->vectors,
+								threadArgs->startIdx,
+								threadArgs->stopIdx,
+								threadArgs->pmYears);
+	return(NULL);
+}
+
+//*****************************************************************************
+//*	precesses objects startIdx to stopIdx-1 of a large catalog, in place.
+//*	The first call for a catalog saves its J2000 positions as unit vectors,
+//*	so the catalog must not be re-ordered after that.
+//*	returns the number of threads used
+//*****************************************************************************
+int	PrecessEngine_TransformCatalog(	const TYPE_PrecessMatrix	*precMatrix,
+									TYPE_CelestData				*objects,
+									const long					objectCount,
+									const long					startIdx,
+									const long					stopIdx)
+{
+TYPE_PrecessVectors		*vectors;
+TYPE_PrecessThreadArgs	threadArgs[kPrecessMaxThreads];
+pthread_t				threadIDs[kPrecessMaxThreads];
+bool					threadStarted[kPrecessMaxThreads];
+int						threadCnt;
+int						cpuCount;
+int						iii;
+long					rowCount;
+long					rowsPerThread;
+double					pmYears;
+
+	vectors		=	PrecessEngine_GetCatalogVectors(objects, objectCount);
+	if (vectors == NULL)
+	{
+		PrecessEngine_TransformObjects(precMatrix, objects, startIdx, stopIdx);
+		return(1);
+	}
+
+	rowCount	=	stopIdx - startIdx;
+	threadCnt	=	rowCount / kPrecessThreadMinObjects;
+	cpuCount	=	sysconf(_SC_NPROCESSORS_ONLN);
+	if (threadCnt > cpuCount)
+	{
+		threadCnt	=	cpuCount;
+	}
+	if (threadCnt > kPrecessMaxThreads)
+	{
+		threadCnt	=	kPrecessMaxThreads;
+	}
+	if (threadCnt < 1)
+	{
+		threadCnt	=	1;
+	}
+
+	pmYears			=	0.0;
+	if (vectors->pm_x != NULL)
+	{
+		pmYears		=	(precMatrix->julianDay - vectors->pmEpoch_JD) / 365.25;
+	}
+
+	rowsPerThread	=	(rowCount + threadCnt - 1) / threadCnt;
+	for (iii=0; iii<threadCnt; iii++)
+	{
+		threadArgs[iii].precMatrix	=	precMatrix;
+		threadArgs[iii].vectors		=	vectors;
+		threadArgs[iii].startIdx	=	startIdx + (iii * rowsPerThread);
+		threadArgs[iii].stopIdx		=	threadArgs[iii].startIdx + rowsPerThread;
+		threadArgs[iii].pmYears		=	pmYears;
+		if (threadArgs[iii].stopIdx > stopIdx)
+		{
+			threadArgs[iii].stopIdx	=	stopIdx;
+		}
+		threadStarted[iii]			=	false;
+	}
+
+	//*	the last block is done on this thread
+	for (iii=0; iii<(threadCnt - 1); iii++)
+	{
+		if (pthread_create(&threadIDs[iii], NULL, &PrecessEngine_Thread, &threadArgs[iii]) == 0)
+		{
+			threadStarted[iii]	=	true;
+		}
+		else
+		{
+			CONSOLE_DEBUG("pthread_create failed");
+			PrecessEngine_Thread(&threadArgs[iii]);
+		}
+	}
+	PrecessEngine_Thread(&threadArgs[threadCnt - 1]);
+
+	for (iii=0; iii<(threadCnt - 1); iii++)
+	{
+		if (threadStarted[iii])
+		{
+			pthread_join(threadIDs[iii], NULL);
+		}
+	}
+	return(threadCnt);
+}
+
+
+#ifdef _INCLUDE_PRECESS_MAIN_
+#include	<sys/time.h>
+
+//*****************************************************************************
+static double	GetElapsedMilliSecs(struct timeval *startTime)
+{
+struct timeval	endTime;
+
+	gettimeofday(&endTime, NULL);
+	return(((endTime.tv_sec - startTime->tv_sec) * 1000.0) + ((endTime.tv_usec - startTime->tv_usec) / 1000.0));
+}
+
+//*****************************************************************************
+static int CelestObjDeclinationQsortProc(const void *e1, const void *e2)
+{
+TYPE_CelestData	*obj1	=	(TYPE_CelestData *)e1;
+TYPE_CelestData	*obj2	=	(TYPE_CelestData *)e2;
+int				returnValue;
+
+	returnValue	=	0;
+	if (obj1->decl < obj2->decl)
+	{
+		returnValue	=	1;
+	}
+	else if (obj1->decl > obj2->decl)
+	{
+		returnValue	=	-1;
+	}
+	return(returnValue);
+}
+
+//*****************************************************************************
+//*	this is the per object loop and sort from WindowTabSkyTravel::Precess()
+//*	before PrecessEngine.c, kept here to compare against
+//*****************************************************************************
+static void	OriginalPrecess(TYPE_CelestData	*celestObjPtr,
+							long			celestObjCount,
+							const double	epoch,
+							const double	pzeta,
+							const double	zee,
+							const double	ptheta,
+							const bool		sortFlag)
+{
+long	ii;
+double	alpha,aside,cside,gamma;
+double	sin_bside,cos_bside;
+
+	cos_bside	=	cos(ptheta);
+	sin_bside	=	sin(ptheta);
+	for (ii=0; ii < celestObjCount; ii++)
+	{
+		cside	=	kHALFPI - celestObjPtr[ii].org_decl;
+		alpha	=	pzeta + celestObjPtr[ii].org_ra;
+		aside	=	acos((cos_bside * cos(cside)) + (sin_bside * sin(cside) * cos(alpha)));
+		celestObjPtr[ii].decl	=	kHALFPI - aside;
+		if (aside > kEPSILON)
+		{
+			gamma	=	asin(sin(cside)*sin(alpha)/sin(aside));
+		}
+		else
+		{
+			gamma	=	0.0;
+		}
+		if (cos(cside)<(cos_bside*cos(aside)))
+		{
+			gamma	=	PI - gamma;
+		}
+		if (epoch > 0.)
+		{
+			gamma	=	PI - gamma;
+		}
+		celestObjPtr[ii].ra	=	zee + gamma;
+	}
+	if (sortFlag)
+	{
+		qsort(celestObjPtr, celestObjCount, sizeof(TYPE_CelestData), CelestObjDeclinationQsortProc);
+	}
+}
+
+//*****************************************************************************
+//*	angle between two positions in arc-seconds
+//*****************************************************************************
+static double	AngularSeparation(double ra1, double decl1, double ra2, double decl2)
+{
+double	cosAngle;
+
+	cosAngle	=	(sin(decl1) * sin(decl2)) + (cos(decl1) * cos(decl2) * cos(ra1 - ra2));
+	if (cosAngle > 1.0)
+	{
+		cosAngle	=	1.0;
+	}
+	return(DEGREES(acos(cosAngle)) * 3600.0);
+}
+
+//*****************************************************************************
+int	main(int argc, char *argv[])
+{
+long				objectCount;
+long				iii;
+TYPE_CelestData		*originalData;
+TYPE_CelestData		*engineData;
+TYPE_PrecessMatrix	precMatrix;
+struct timeval		startTime;
+double				ipart;
+double				epoch, pzeta, zee, ptheta;
+double				julianDay;
+double				milliSecs_Original;
+double				milliSecs_OriginalNoSort;
+double				milliSecs_Engine;
+double				milliSecs_Objects;
+double				milliSecs_FirstCall;
+double				separation;
+double				maxSeparation;
+double				maxNutation;
+int					threadCnt;
+
+	objectCount	=	259000;		//*	about the size of SAO
+	if (argc > 1)
+	{
+		objectCount	=	atol(argv[1]);
+	}
+	printf("Precession benchmark, %ld objects, %ld cpus\r\n", objectCount, sysconf(_SC_NPROCESSORS_ONLN));
+
+	originalData	=	(TYPE_CelestData *)calloc(objectCount, sizeof(TYPE_CelestData));
+	engineData		=	(TYPE_CelestData *)calloc(objectCount, sizeof(TYPE_CelestData));
+	if ((originalData == NULL) || (engineData == NULL))
+	{
+		printf("Failed to allocate memory\r\n");
+		return(1);
+	}
+	srandom(1234);
+	for (iii=0; iii<objectCount; iii++)
+	{
+		originalData[iii].dataSrc		=	kDataSrc_SAO;
+		originalData[iii].org_ra		=	kTWOPI * random() / RAND_MAX;
+		originalData[iii].org_decl		=	asin((2.0 * random() / RAND_MAX) - 1.0);
+		originalData[iii].realMagnitude	=	10.0 * random() / RAND_MAX;
+	}
+	memcpy(engineData, originalData, objectCount * sizeof(TYPE_CelestData));
+
+	//*	Jan 1, 2050, same angle math as Precess()
+	julianDay	=	JD2000 + (50 * 365.25);
+	epoch		=	(julianDay - JD2000) / FCENT;
+	pzeta		=	epoch*(PRECA + (epoch*((PRECB + (PRECC*epoch)))));
+	zee			=	pzeta + (epoch*epoch*PRECZ);
+	ptheta		=	epoch*(PRECD + (epoch*(PRECE + (PRECF*epoch))));
+	ptheta		=	kTWOPI * modf(ptheta,	&ipart);
+	zee			=	kTWOPI * modf(zee,		&ipart);
+	pzeta		=	kTWOPI * modf(pzeta,	&ipart);
+
+	//*	the original routine, including the sort it did every time
+	gettimeofday(&startTime, NULL);
+	OriginalPrecess(originalData, objectCount, epoch, pzeta, zee, ptheta, true);
+	milliSecs_Original	=	GetElapsedMilliSecs(&startTime);
+
+	//*	again without the sort, this leaves originalData[] in the same order as engineData[]
+	memcpy(originalData, engineData, objectCount * sizeof(TYPE_CelestData));
+	gettimeofday(&startTime, NULL);
+	OriginalPrecess(originalData, objectCount, epoch, pzeta, zee, ptheta, false);
+	milliSecs_OriginalNoSort	=	GetElapsedMilliSecs(&startTime);
+
+	//*	the engine without saved vectors
+	PrecessEngine_SetupMatrix(&precMatrix, pzeta, zee, ptheta, julianDay, false);
+	gettimeofday(&startTime, NULL);
+	PrecessEngine_TransformObjects(&precMatrix, engineData, 0, objectCount);
+	milliSecs_Objects	=	GetElapsedMilliSecs(&startTime);
+
+	//*	the engine with saved vectors, this is what SkyTravel uses for the big catalogs,
+	//*	the first call for a catalog also creates the vectors
+	gettimeofday(&startTime, NULL);
+	PrecessEngine_TransformCatalog(&precMatrix, engineData, objectCount, 0, objectCount);
+	milliSecs_FirstCall	=	GetElapsedMilliSecs(&startTime);
+
+	gettimeofday(&startTime, NULL);
+	threadCnt			=	PrecessEngine_TransformCatalog(&precMatrix, engineData, objectCount, 0, objectCount);
+	milliSecs_Engine	=	GetElapsedMilliSecs(&startTime);
+
+	maxSeparation	=	0.0;
+	for (iii=0; iii<objectCount; iii++)
+	{
+		separation	=	AngularSeparation(	originalData[iii].ra,	originalData[iii].decl,
+											engineData[iii].ra,		engineData[iii].decl);
+		if (separation > maxSeparation)
+		{
+			maxSeparation	=	separation;
+		}
+	}
+
+	//*	how much does nutation move things
+	memcpy(originalData, engineData, objectCount * sizeof(TYPE_CelestData));
+	PrecessEngine_SetupMatrix(&precMatrix, pzeta, zee, ptheta, julianDay, true);
+	PrecessEngine_TransformCatalog(&precMatrix, engineData, objectCount, 0, objectCount);
+	maxNutation	=	0.0;
+	for (iii=0; iii<objectCount; iii++)
+	{
+		separation	=	AngularSeparation(	originalData[iii].ra,	originalData[iii].decl,
+											engineData[iii].ra,		engineData[iii].decl);
+		if (separation > maxNutation)
+		{
+			maxNutation	=	separation;
+		}
+	}
+
+	printf("Original (with qsort)   \t%10.2f ms\r\n",	milliSecs_Original);
+	printf("Original (without qsort)\t%10.2f ms\r\n",	milliSecs_OriginalNoSort);
+	printf("Engine, object array    \t%10.2f ms\r\n",	milliSecs_Objects);
+	printf("Engine, saved vectors   \t%10.2f ms (%d threads)\r\n",	milliSecs_Engine, threadCnt);
+	printf("Engine, first call      \t%10.2f ms (creates the vectors)\r\n",	milliSecs_FirstCall);
+	printf("Max difference from original\t%10.6f arc-seconds\r\n",	maxSeparation);
+	printf("Max nutation correction     \t%10.3f arc-seconds\r\n",	maxNutation);
+
+	free(originalData);
+	free(engineData);
+	return(0);
+}
+#endif // _INCLUDE_PRECESS_MAIN_
@@ -0,0 +1,62 @@
+//*****************************************************************************
+//*	PrecessEngine.h
+//*****************************************************************************
+//#include	"PrecessEngine.h"
+
+#ifndef _PRECESS_ENGINE_H_
+#define	_PRECESS_ENGINE_H_
+
+#ifndef _SKY_STRUCTS_H_
+	#include	"SkyStruc.h"
+#endif
+
+#define	kPrecessBlockSize			256		//*	objects per pass through the rotation stage
+#define	kPrecessThreadMinObjects	25000	//*	don't start a thread for less than this
+#define	kPrecessMaxThreads			8
+#define	kPrecessVectorMinObjects	1000	//*	smaller lists are not worth saving the vectors for
+#define	kPrecessMaxCatalogs			16
+
+#define	kHipparcosEpoch_JD			2448349.0625	//*	J1991.25, epoch of the Hipparcos positions
+
+//*****************************************************************************
+typedef struct
+{
+	double	matrix[3][3];			//*	J2000 mean equator -> true equator of date
+	double	julianDay;
+	bool	includesNutation;
+} TYPE_PrecessMatrix;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+void	PrecessEngine_Nutation(	const double	julianDay,
+								double			*deltaPsi,
+								double			*deltaEps,
+								double			*meanObliquity);
+void	PrecessEngine_SetupMatrix(	TYPE_PrecessMatrix	*precMatrix,
+									const double		pzeta,
+									const double		zee,
+									const double		ptheta,
+									const double		julianDay,
+									const bool			includeNutation);
+bool	PrecessEngine_GetVectors(	const TYPE_CelestData	*theObject,
+									double					posVector[3],
+									double					pmVector[3],
+									double					*pmEpoch_JD);
+void	PrecessEngine_TransformObjects(	const TYPE_PrecessMatrix	*precMatrix,
+										TYPE_CelestData				*objects,
+										const long					startIdx,
+										const long					stopIdx);
+int		PrecessEngine_TransformCatalog(	const TYPE_PrecessMatrix	*precMatrix,
+										TYPE_CelestData				*objects,
+										const long					objectCount,
+										const long					startIdx,
+										const long					stopIdx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PRECESS_ENGINE_H_
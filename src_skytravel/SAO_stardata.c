@@ -8,6 +8,7 @@
 //*	Dec 27,	2022	<MLS> https://cdsarc.cds.unistra.fr/ftp/cats/I/131A/
 //*	Dec 29,	2022	<MLS> Renamed SAO_ReadFile() to SAO_ReadFile_heasarc()
 //*	Dec 29,	2022	<MLS> Added SAO_ReadFile_sao_dat()
+//*	Oct 18,	2026	<AGT> Both SAO readers use the binary cache (CatalogCache.c)
 //*****************************************************************************
 //*	http://tdc-www.harvard.edu/catalogs/sao.html
 //*	http://www.stargazing.net/kepler/b1950.html
@@ -30,6 +31,7 @@
 
 #include	"SkyStruc.h"
 #include	"SAO_stardata.h"
+#include	"CatalogCache.h"
 #include	"helper_functions.h"
 #include	"controller_startup.h"
 
@@ -315,7 +317,14 @@ int				startupWidgetIdx;
 	CONSOLE_DEBUG(filePath);
 
 	maxLineLen	=	0;
-	filePointer	=	fopen(filePath, "r");
+
+	//*	use the binary cache if it is up to date
+	filePointer	=	NULL;
+	saoStarData	=	CatalogCache_Read(filePath, starCount);
+	if (saoStarData == NULL)
+	{
+		filePointer	=	fopen(filePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 		readHeader	=	true;
@@ -363,11 +372,16 @@ int				startupWidgetIdx;
 				}
 			}
 			*starCount	=	recordCount;
+			CatalogCache_Save(filePath, saoStarData, recordCount);
 		}
 
 		fclose(filePointer);
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (saoStarData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("Failed to read star data:", filePath);
@@ -833,7 +847,14 @@ int				startupWidgetIdx;
 
 	deletedCount	=	0;
 	linesRead		=	0;
-	filePointer		=	fopen(filePath, "r");
+
+	//*	use the binary cache if it is up to date
+	filePointer		=	NULL;
+	saoStarData		=	CatalogCache_Read(filePath, starCount);
+	if (saoStarData == NULL)
+	{
+		filePointer	=	fopen(filePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 
@@ -870,11 +891,16 @@ int				startupWidgetIdx;
 				}
 			}
 			*starCount	=	recordCount;
+			CatalogCache_Save(filePath, saoStarData, recordCount);
 		}
 
 		fclose(filePointer);
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (saoStarData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("Failed to read star data:", filePath);
@@ -0,0 +1,237 @@
+//*****************************************************************************
+//*	SkyHitGrid.c
+//*
+//*	Screen space grid of the objects that were plotted, used to find the object
+//*	the cursor is pointing at.
+//*	The grid is emptied at the start of each redraw and filled in as objects are
+//*	drawn, so finding the closest object only looks at the few cells around the
+//*	cursor instead of every object in every catalog.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created SkyHitGrid.c
+//*****************************************************************************
+
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"SkyStruc.h"
+#include	"SkyHitGrid.h"
+
+//*****************************************************************************
+static int	GetCellIndex(TYPE_SkyHitGrid *hitGrid, const int xx, const int yy)
+{
+int		cellX;
+int		cellY;
+
+	cellX	=	(xx - hitGrid->originX) / kSkyHitCellSize;
+	cellY	=	(yy - hitGrid->originY) / kSkyHitCellSize;
+	if (cellX < 0)
+	{
+		cellX	=	0;
+	}
+	else if (cellX >= hitGrid->cellsX)
+	{
+		cellX	=	hitGrid->cellsX - 1;
+	}
+	if (cellY < 0)
+	{
+		cellY	=	0;
+	}
+	else if (cellY >= hitGrid->cellsY)
+	{
+		cellY	=	hitGrid->cellsY - 1;
+	}
+	return((cellY * hitGrid->cellsX) + cellX);
+}
+
+//*****************************************************************************
+//*	call at the start of each redraw, the cells are only re-allocated if the
+//*	window size changed
+//*****************************************************************************
+void	SkyHitGrid_Reset(	TYPE_SkyHitGrid	*hitGrid,
+							const int		originX,
+							const int		originY,
+							const int		width,
+							const int		height)
+{
+int		cellsX;
+int		cellsY;
+int		iii;
+
+	//*	+1 because objects exactly on the right/bottom edge are considered on screen
+	cellsX	=	(width / kSkyHitCellSize) + 1;
+	cellsY	=	(height / kSkyHitCellSize) + 1;
+	if ((hitGrid->cellHead == NULL) || (cellsX != hitGrid->cellsX) || (cellsY != hitGrid->cellsY))
+	{
+		if (hitGrid->cellHead != NULL)
+		{
+			free(hitGrid->cellHead);
+		}
+		hitGrid->cellHead	=	(int *)malloc(cellsX * cellsY * sizeof(int));
+		hitGrid->cellsX		=	cellsX;
+		hitGrid->cellsY		=	cellsY;
+	}
+	hitGrid->originX	=	originX;
+	hitGrid->originY	=	originY;
+	hitGrid->listCnt	=	0;
+	hitGrid->entryCnt	=	0;
+	if (hitGrid->cellHead != NULL)
+	{
+		for (iii=0; iii < (cellsX * cellsY); iii++)
+		{
+			hitGrid->cellHead[iii]	=	-1;
+		}
+	}
+	else
+	{
+		CONSOLE_DEBUG("Failed to allocate hit grid cells");
+		hitGrid->cellsX	=	0;
+		hitGrid->cellsY	=	0;
+	}
+}
+
+//*****************************************************************************
+//*	returns the list index to pass to SkyHitGrid_Add(), -1 if out of lists
+//*****************************************************************************
+int	SkyHitGrid_AddList(TYPE_SkyHitGrid *hitGrid, TYPE_CelestData *objectPtr, const long objectCount)
+{
+int		listIdx;
+
+	listIdx	=	-1;
+	if ((hitGrid->cellHead != NULL) && (hitGrid->listCnt < kSkyHitMaxLists))
+	{
+		listIdx								=	hitGrid->listCnt;
+		hitGrid->lists[listIdx].objectPtr	=	objectPtr;
+		hitGrid->lists[listIdx].objectCount	=	objectCount;
+		hitGrid->listCnt++;
+	}
+	return(listIdx);
+}
+
+//*****************************************************************************
+void	SkyHitGrid_Add(	TYPE_SkyHitGrid	*hitGrid,
+						const int		listIdx,
+						const long		objectIdx,
+						const int		xx,
+						const int		yy)
+{
+TYPE_SkyHitEntry	*newEntries;
+int					newMax;
+int					cellIdx;
+int					entryIdx;
+
+	if ((listIdx >= 0) && (listIdx < hitGrid->listCnt))
+	{
+		if (hitGrid->entryCnt >= hitGrid->entryMax)
+		{
+			newMax		=	(hitGrid->entryMax > 0) ? (hitGrid->entryMax * 2) : kSkyHitInitialEntries;
+			newEntries	=	(TYPE_SkyHitEntry *)realloc(hitGrid->entries, newMax * sizeof(TYPE_SkyHitEntry));
+			if (newEntries != NULL)
+			{
+				hitGrid->entries	=	newEntries;
+				hitGrid->entryMax	=	newMax;
+			}
+		}
+		if (hitGrid->entryCnt < hitGrid->entryMax)
+		{
+			//*	newest first in each cell
+			cellIdx									=	GetCellIndex(hitGrid, xx, yy);
+			entryIdx								=	hitGrid->entryCnt;
+			hitGrid->entries[entryIdx].nextEntry	=	hitGrid->cellHead[cellIdx];
+			hitGrid->entries[entryIdx].listIdx		=	listIdx;
+			hitGrid->entries[entryIdx].xx			=	xx;
+			hitGrid->entries[entryIdx].yy			=	yy;
+			hitGrid->entries[entryIdx].objectIdx	=	objectIdx;
+			hitGrid->cellHead[cellIdx]				=	entryIdx;
+			hitGrid->entryCnt++;
+		}
+	}
+}
+
+//*****************************************************************************
+//*	if two objects are the same distance away, the one drawn last (on top) wins
+//*****************************************************************************
+int	SkyHitGrid_FindNearest(	TYPE_SkyHitGrid	*hitGrid,
+							const int		xx,
+							const int		yy,
+							const int		maxDistance,
+							const bool		*listOK,
+							long			*distanceSQRD)
+{
+int					firstCell;
+int					lastCell;
+int					firstCellX;
+int					lastCellX;
+int					firstCellY;
+int					lastCellY;
+int					cellX;
+int					cellY;
+int					entryIdx;
+int					foundIdx;
+long				foundDistSQRD;
+long				deltaXX;
+long				deltaYY;
+long				entryDistSQRD;
+TYPE_SkyHitEntry	*theEntry;
+
+	foundIdx		=	-1;
+	foundDistSQRD	=	(long)maxDistance * maxDistance;
+	if ((hitGrid->cellHead != NULL) && (hitGrid->entryCnt > 0))
+	{
+		//*	the cells that cover the square around the cursor
+		firstCell	=	GetCellIndex(hitGrid, xx - maxDistance, yy - maxDistance);
+		lastCell	=	GetCellIndex(hitGrid, xx + maxDistance, yy + maxDistance);
+		firstCellX	=	firstCell % hitGrid->cellsX;
+		firstCellY	=	firstCell / hitGrid->cellsX;
+		lastCellX	=	lastCell % hitGrid->cellsX;
+		lastCellY	=	lastCell / hitGrid->cellsX;
+		for (cellY=firstCellY; cellY <= lastCellY; cellY++)
+		{
+			for (cellX=firstCellX; cellX <= lastCellX; cellX++)
+			{
+				entryIdx	=	hitGrid->cellHead[(cellY * hitGrid->cellsX) + cellX];
+				while (entryIdx >= 0)
+				{
+					theEntry	=	&hitGrid->entries[entryIdx];
+					if ((listOK == NULL) || listOK[theEntry->listIdx])
+					{
+						deltaXX			=	xx - theEntry->xx;
+						deltaYY			=	yy - theEntry->yy;
+						entryDistSQRD	=	(deltaXX * deltaXX) + (deltaYY * deltaYY);
+						if ((entryDistSQRD < foundDistSQRD) ||
+							((entryDistSQRD == foundDistSQRD) && (entryIdx > foundIdx)))
+						{
+							foundIdx		=	entryIdx;
+							foundDistSQRD	=	entryDistSQRD;
+						}
+					}
+					entryIdx	=	theEntry->nextEntry;
+				}
+			}
+		}
+	}
+	*distanceSQRD	=	foundDistSQRD;
+	return(foundIdx);
+}
+
+//*****************************************************************************
+void	SkyHitGrid_Free(TYPE_SkyHitGrid *hitGrid)
+{
+	if (hitGrid->cellHead != NULL)
+	{
+		free(hitGrid->cellHead);
+	}
+	if (hitGrid->entries != NULL)
+	{
+		free(hitGrid->entries);
+	}
+	memset((void *)hitGrid, 0, sizeof(TYPE_SkyHitGrid));
+}
@@ -0,0 +1,87 @@
+//*****************************************************************************
+//*	SkyHitGrid.h
+//*****************************************************************************
+//#include	"SkyHitGrid.h"
+
+#ifndef _SKY_HIT_GRID_H_
+#define	_SKY_HIT_GRID_H_
+
+#ifndef _SKY_STRUCTS_H_
+	#include	"SkyStruc.h"
+#endif
+
+#define	kSkyHitCellSize			16		//*	pixels
+#define	kSkyHitMaxLists			32		//*	catalogs per redraw
+#define	kSkyHitInitialEntries	4096	//*	grows as needed
+
+//*****************************************************************************
+//*	one entry for each object that was plotted on the screen
+//*****************************************************************************
+typedef struct
+{
+	int				nextEntry;			//*	next entry in the same cell, -1 for end
+	short			listIdx;
+	short			xx;
+	short			yy;
+	long			objectIdx;			//*	index into the catalog
+} TYPE_SkyHitEntry;
+
+//*****************************************************************************
+//*	the catalogs are remembered by pointer and count, it is up to the caller to
+//*	make sure the catalog is still the same before using the object index
+//*****************************************************************************
+typedef struct
+{
+	TYPE_CelestData	*objectPtr;
+	long			objectCount;
+} TYPE_SkyHitList;
+
+//*****************************************************************************
+typedef struct
+{
+	int					originX;
+	int					originY;
+	int					cellsX;
+	int					cellsY;
+	int					*cellHead;			//*	[cellsX * cellsY], first entry in each cell
+
+	TYPE_SkyHitList		lists[kSkyHitMaxLists];
+	int					listCnt;
+
+	TYPE_SkyHitEntry	*entries;
+	int					entryCnt;
+	int					entryMax;
+} TYPE_SkyHitGrid;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+void	SkyHitGrid_Reset(	TYPE_SkyHitGrid	*hitGrid,
+							const int		originX,
+							const int		originY,
+							const int		width,
+							const int		height);
+int		SkyHitGrid_AddList(TYPE_SkyHitGrid *hitGrid, TYPE_CelestData *objectPtr, const long objectCount);
+void	SkyHitGrid_Add(		TYPE_SkyHitGrid	*hitGrid,
+							const int		listIdx,
+							const long		objectIdx,
+							const int		xx,
+							const int		yy);
+
+//*	returns the index of the closest entry within maxDistance, -1 if none
+//*	listOK[] can be NULL, otherwise only the lists that are true are looked at
+int		SkyHitGrid_FindNearest(	TYPE_SkyHitGrid	*hitGrid,
+								const int		xx,
+								const int		yy,
+								const int		maxDistance,
+								const bool		*listOK,
+								long			*distanceSQRD);
+void	SkyHitGrid_Free(TYPE_SkyHitGrid *hitGrid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SKY_HIT_GRID_H_
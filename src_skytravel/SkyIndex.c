@@ -0,0 +1,373 @@
+//*****************************************************************************
+//*	SkyIndex.c
+//*
+//*	Spatial index for the TYPE_CelestData catalogs.
+//*	The sky is cut into rings of constant declination, the rings are cut in RA into
+//*	tiles of about the same area. Each index lists the objects in each tile,
+//*	sorted by magnitude, so that drawing only has to look at the tiles that are
+//*	on the screen and can stop at the magnitude limit.
+//*****************************************************************************
+//*	Edit History
+//*****************************************************************************
+//*	Oct 18,	2026	<AGT> Created SkyIndex.c
+//*	Oct 18,	2026	<AGT> Removed visible object counts, the cursor uses SkyHitGrid.c now
+//*****************************************************************************
+
+
+#include	<string.h>
+#include	<stdlib.h>
+#include	<stdio.h>
+#include	<stdbool.h>
+#include	<math.h>
+
+//*	MLS Libraries
+#define _ENABLE_CONSOLE_DEBUG_
+#include	"ConsoleDebug.h"
+
+#include	"SkyStruc.h"
+#include	"SkyIndex.h"
+
+#define	kTwoPI		(2.0 * M_PI)
+#define	kRingHeight	((M_PI / 180.0) * kSkyIndexRingHeight_Deg)
+
+static	bool			gSkyIndexRingsInitialized	=	false;
+static	int				gRingFirstTile[kSkyIndexRingCount];
+static	int				gRingTileCnt[kSkyIndexRingCount];
+static	double			gRingTileWidth[kSkyIndexRingCount];	//*	radians of RA
+static	int				gTotalTileCnt				=	0;
+
+static	TYPE_SkyIndex	gSkyIndexList[kMaxSkyIndexes];
+
+//*	used by the qsort compare routine
+static	TYPE_CelestData	*gSortObjectPtr				=	NULL;
+
+//*****************************************************************************
+static void	SkyIndex_InitRings(void)
+{
+int		ringNum;
+int		tileCnt;
+double	ringCenter_Rad;
+
+	if (gSkyIndexRingsInitialized == false)
+	{
+		gTotalTileCnt	=	0;
+		for (ringNum=0; ringNum < kSkyIndexRingCount; ringNum++)
+		{
+			//*	the number of tiles in a ring is proportional to the cos of the declination
+			ringCenter_Rad	=	-(M_PI / 2.0) + ((ringNum + 0.5) * kRingHeight);
+			tileCnt			=	(360.0 / kSkyIndexRingHeight_Deg) * cos(ringCenter_Rad) + 0.5;
+			if (tileCnt < 1)
+			{
+				tileCnt	=	1;
+			}
+			gRingFirstTile[ringNum]	=	gTotalTileCnt;
+			gRingTileCnt[ringNum]	=	tileCnt;
+			gRingTileWidth[ringNum]	=	kTwoPI / tileCnt;
+			gTotalTileCnt			+=	tileCnt;
+		}
+		memset((void *)gSkyIndexList, 0, sizeof(gSkyIndexList));
+		gSkyIndexRingsInitialized	=	true;
+	}
+}
+
+//*****************************************************************************
+static int	GetRingNumber(const double decl)
+{
+int		ringNum;
+
+	ringNum	=	(decl + (M_PI / 2.0)) / kRingHeight;
+	if (ringNum < 0)
+	{
+		ringNum	=	0;
+	}
+	else if (ringNum >= kSkyIndexRingCount)
+	{
+		ringNum	=	kSkyIndexRingCount - 1;
+	}
+	return(ringNum);
+}
+
+//*****************************************************************************
+int	SkyIndex_GetTileCount(void)
+{
+	SkyIndex_InitRings();
+	return(gTotalTileCnt);
+}
+
+//*****************************************************************************
+int	SkyIndex_GetTile(const double ra, const double decl)
+{
+int		ringNum;
+int		tileNum;
+double	raNormalized;
+
+	SkyIndex_InitRings();
+
+	ringNum			=	GetRingNumber(decl);
+	raNormalized	=	fmod(ra, kTwoPI);
+	if (raNormalized < 0.0)
+	{
+		raNormalized	+=	kTwoPI;
+	}
+	tileNum	=	raNormalized / gRingTileWidth[ringNum];
+	if (tileNum >= gRingTileCnt[ringNum])
+	{
+		tileNum	=	gRingTileCnt[ringNum] - 1;
+	}
+	return(gRingFirstTile[ringNum] + tileNum);
+}
+
+//*****************************************************************************
+//*	returns the list of tiles that overlap the declination band and are within
+//*	raHalfWidth of ra0. raHalfWidth == 0.0 means all RA values (i.e. a pole is in view)
+//*****************************************************************************
+int	SkyIndex_GetTilesInView(const double	ra0,
+							const double	raHalfWidth,
+							const double	declMin,
+							const double	declMax,
+							int				*tileList,
+							const int		maxTiles)
+{
+int		tileCnt;
+int		ringNum;
+int		firstRing;
+int		lastRing;
+int		firstTile;
+int		lastTile;
+int		tileNum;
+int		ringTileCnt;
+double	raStart;
+
+	SkyIndex_InitRings();
+
+	tileCnt		=	0;
+	firstRing	=	GetRingNumber(declMin);
+	lastRing	=	GetRingNumber(declMax);
+	for (ringNum = firstRing; ringNum <= lastRing; ringNum++)
+	{
+		ringTileCnt	=	gRingTileCnt[ringNum];
+		firstTile	=	0;
+		lastTile	=	ringTileCnt - 1;
+		if ((raHalfWidth > 0.0) && (raHalfWidth < M_PI))
+		{
+			raStart		=	fmod(ra0 - raHalfWidth, kTwoPI);
+			if (raStart < 0.0)
+			{
+				raStart	+=	kTwoPI;
+			}
+			firstTile	=	raStart / gRingTileWidth[ringNum];
+			lastTile	=	(raStart + (2.0 * raHalfWidth)) / gRingTileWidth[ringNum];
+			if ((lastTile - firstTile + 1) >= ringTileCnt)
+			{
+				firstTile	=	0;
+				lastTile	=	ringTileCnt - 1;
+			}
+		}
+		for (tileNum = firstTile; tileNum <= lastTile; tileNum++)
+		{
+			if (tileCnt < maxTiles)
+			{
+				tileList[tileCnt++]	=	gRingFirstTile[ringNum] + (tileNum % ringTileCnt);
+			}
+		}
+	}
+	return(tileCnt);
+}
+
+//*****************************************************************************
+static int	MagnitudeQsortProc(const void *e1, const void *e2)
+{
+double	mag1;
+double	mag2;
+int		returnValue;
+
+	mag1	=	gSortObjectPtr[*((long *)e1)].realMagnitude;
+	mag2	=	gSortObjectPtr[*((long *)e2)].realMagnitude;
+	if (mag1 < mag2)
+	{
+		returnValue	=	-1;
+	}
+	else if (mag1 > mag2)
+	{
+		returnValue	=	1;
+	}
+	else
+	{
+		returnValue	=	0;
+	}
+	return(returnValue);
+}
+
+//*****************************************************************************
+static void	SkyIndex_FreeBuffers(TYPE_SkyIndex *skyIndex)
+{
+	if (skyIndex->tileStart != NULL)
+	{
+		free(skyIndex->tileStart);
+	}
+	if (skyIndex->objectIdx != NULL)
+	{
+		free(skyIndex->objectIdx);
+	}
+	if (skyIndex->visibleTiles != NULL)
+	{
+		free(skyIndex->visibleTiles);
+	}
+	memset((void *)skyIndex, 0, sizeof(TYPE_SkyIndex));
+}
+
+//*****************************************************************************
+//*	builds the index for a catalog, if it is already built and valid, nothing is done.
+//*	This has to be called again after the catalog is precessed or sorted
+//*****************************************************************************
+TYPE_SkyIndex	*SkyIndex_Build(TYPE_CelestData *objectPtr, const long objectCount)
+{
+TYPE_SkyIndex	*skyIndex;
+int				*objectTile;
+long			*fillPosition;
+long			iii;
+int				tileNum;
+
+	SkyIndex_InitRings();
+	skyIndex	=	NULL;
+	if ((objectPtr != NULL) && (objectCount >= kSkyIndexMinObjects))
+	{
+		//*	look for an existing entry for this catalog, or an empty one
+		for (iii=0; iii<kMaxSkyIndexes; iii++)
+		{
+			if (gSkyIndexList[iii].objectPtr == objectPtr)
+			{
+				skyIndex	=	&gSkyIndexList[iii];
+				break;
+			}
+		}
+		if (skyIndex == NULL)
+		{
+			for (iii=0; iii<kMaxSkyIndexes; iii++)
+			{
+				if (gSkyIndexList[iii].objectPtr == NULL)
+				{
+					skyIndex	=	&gSkyIndexList[iii];
+					break;
+				}
+			}
+		}
+
+		if (skyIndex == NULL)
+		{
+			CONSOLE_DEBUG("Out of sky index entries");
+		}
+		else if (skyIndex->valid && (skyIndex->objectCount == objectCount))
+		{
+			//*	already up to date
+		}
+		else
+		{
+			SkyIndex_FreeBuffers(skyIndex);
+			skyIndex->tileStart			=	(long *)calloc(gTotalTileCnt + 1,	sizeof(long));
+			skyIndex->objectIdx			=	(long *)malloc(objectCount *		sizeof(long));
+			skyIndex->visibleTiles		=	(int *)malloc(gTotalTileCnt *		sizeof(int));
+			objectTile					=	(int *)malloc(objectCount *			sizeof(int));
+			fillPosition				=	(long *)malloc(gTotalTileCnt *		sizeof(long));
+
+			if ((skyIndex->tileStart != NULL) && (skyIndex->objectIdx != NULL) &&
+				(skyIndex->visibleTiles != NULL) &&
+				(objectTile != NULL) && (fillPosition != NULL))
+			{
+				//*	count the objects in each tile
+				for (iii=0; iii<objectCount; iii++)
+				{
+					tileNum				=	SkyIndex_GetTile(objectPtr[iii].ra, objectPtr[iii].decl);
+					objectTile[iii]		=	tileNum;
+					skyIndex->tileStart[tileNum + 1]++;
+				}
+				for (tileNum=0; tileNum < gTotalTileCnt; tileNum++)
+				{
+					skyIndex->tileStart[tileNum + 1]	+=	skyIndex->tileStart[tileNum];
+					fillPosition[tileNum]				=	skyIndex->tileStart[tileNum];
+				}
+				//*	fill in the object numbers
+				for (iii=0; iii<objectCount; iii++)
+				{
+					skyIndex->objectIdx[fillPosition[objectTile[iii]]++]	=	iii;
+				}
+				//*	sort each tile brightest first
+				gSortObjectPtr	=	objectPtr;
+				for (tileNum=0; tileNum < gTotalTileCnt; tileNum++)
+				{
+					if ((skyIndex->tileStart[tileNum + 1] - skyIndex->tileStart[tileNum]) > 1)
+					{
+						qsort(	&skyIndex->objectIdx[skyIndex->tileStart[tileNum]],
+								(skyIndex->tileStart[tileNum + 1] - skyIndex->tileStart[tileNum]),
+								sizeof(long),
+								MagnitudeQsortProc);
+					}
+				}
+				gSortObjectPtr				=	NULL;
+				skyIndex->objectPtr			=	objectPtr;
+				skyIndex->objectCount		=	objectCount;
+				skyIndex->visibleTileCnt	=	0;
+				skyIndex->valid				=	true;
+			}
+			else
+			{
+				CONSOLE_DEBUG("Failed to allocate memory for sky index");
+				SkyIndex_FreeBuffers(skyIndex);
+				skyIndex	=	NULL;
+			}
+			if (objectTile != NULL)
+			{
+				free(objectTile);
+			}
+			if (fillPosition != NULL)
+			{
+				free(fillPosition);
+			}
+		}
+	}
+	return(skyIndex);
+}
+
+//*****************************************************************************
+//*	returns NULL if there is no valid index for this catalog
+//*****************************************************************************
+TYPE_SkyIndex	*SkyIndex_Find(TYPE_CelestData *objectPtr, const long objectCount)
+{
+TYPE_SkyIndex	*skyIndex;
+int				iii;
+
+	skyIndex	=	NULL;
+	if (gSkyIndexRingsInitialized && (objectPtr != NULL))
+	{
+		for (iii=0; iii<kMaxSkyIndexes; iii++)
+		{
+			if ((gSkyIndexList[iii].objectPtr == objectPtr) &&
+				(gSkyIndexList[iii].objectCount == objectCount) &&
+				gSkyIndexList[iii].valid)
+			{
+				skyIndex	=	&gSkyIndexList[iii];
+				break;
+			}
+		}
+	}
+	return(skyIndex);
+}
+
+//*****************************************************************************
+//*	call this whenever the ra/decl values of the catalog change or it is re-sorted
+//*****************************************************************************
+void	SkyIndex_Invalidate(TYPE_CelestData *objectPtr)
+{
+int		iii;
+
+	if (gSkyIndexRingsInitialized && (objectPtr != NULL))
+	{
+		for (iii=0; iii<kMaxSkyIndexes; iii++)
+		{
+			if (gSkyIndexList[iii].objectPtr == objectPtr)
+			{
+				gSkyIndexList[iii].valid	=	false;
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+//*****************************************************************************
+//*	SkyIndex.h
+//*****************************************************************************
+//#include	"SkyIndex.h"
+
+#ifndef _SKY_INDEX_H_
+#define	_SKY_INDEX_H_
+
+#ifndef _SKY_STRUCTS_H_
+	#include	"SkyStruc.h"
+#endif
+
+//*	the sky is divided into rings of constant declination (like HEALPix),
+//*	each ring is divided in RA into tiles of approximately equal area
+#define	kSkyIndexRingHeight_Deg		2.0
+#define	kSkyIndexRingCount			90		//*	180 / kSkyIndexRingHeight_Deg
+#define	kSkyIndexMinObjects			1000	//*	smaller lists are faster to just walk
+#define	kMaxSkyIndexes				16
+
+//*****************************************************************************
+typedef struct
+{
+	TYPE_CelestData	*objectPtr;			//*	the catalog this index was built from
+	long			objectCount;
+	bool			valid;				//*	false if the catalog has been precessed/sorted
+	long			*tileStart;			//*	[tileCount + 1], offsets into objectIdx
+	long			*objectIdx;			//*	object indices grouped by tile, brightest first in each tile
+
+	//*	the tiles that were in view the last time this catalog was drawn
+	int				*visibleTiles;
+	int				visibleTileCnt;
+} TYPE_SkyIndex;
+
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+int				SkyIndex_GetTileCount(void);
+int				SkyIndex_GetTile(const double ra, const double decl);
+int				SkyIndex_GetTilesInView(const double	ra0,
+										const double	raHalfWidth,
+										const double	declMin,
+										const double	declMax,
+										int				*tileList,
+										const int		maxTiles);
+
+TYPE_SkyIndex	*SkyIndex_Build(TYPE_CelestData *objectPtr, const long objectCount);
+TYPE_SkyIndex	*SkyIndex_Find(TYPE_CelestData *objectPtr, const long objectCount);
+void			SkyIndex_Invalidate(TYPE_CelestData *objectPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _SKY_INDEX_H_
@@ -18,6 +18,7 @@
 //*	Oct 24,	2021	<MLS> Added parsing of spectral class to Henry Draper catalog
 //*	Aug  1,	2022	<MLS> Added magnitude to special.txt parsing
 //*	Jul 23,	2023	<MLS> Moved Messier code to MessierData.c
+//*	Oct 18,	2026	<AGT> HYG and Henry Draper catalogs use the binary cache (CatalogCache.c)
 //*****************************************************************************
 //	https://github.com/astronexus/HYG-Database
 //
@@ -45,6 +46,7 @@
 #include	"SkyTravelConstants.h"
 #include	"StarData.h"
 #include	"ConstellationData.h"
+#include	"CatalogCache.h"
 
 
 
@@ -536,7 +538,13 @@ int				startupWidgetIdx;
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, myFilePath);
 //	CONSOLE_DEBUG_W_NUM("kHYG_Last\t=", kHYG_Last);
 
-	filePointer	=	fopen(myFilePath, "r");
+	//*	use the binary cache if it is up to date
+	filePointer	=	NULL;
+	hygData		=	CatalogCache_Read(myFilePath, objectCount);
+	if (hygData == NULL)
+	{
+		filePointer	=	fopen(myFilePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 //		CONSOLE_DEBUG("File Opened OK");
@@ -595,10 +603,15 @@ int				startupWidgetIdx;
 				}
 			}
 			*objectCount	=	recordCount;
+			CatalogCache_Save(myFilePath, hygData, recordCount);
 		}
 		fclose(filePointer);
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (hygData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("Failed to read:", myFilePath);
@@ -784,7 +797,13 @@ int				startupWidgetIdx;
 
 //	CONSOLE_DEBUG_W_STR(__FUNCTION__, myFilePath);
 
-	filePointer	=	fopen(myFilePath, "r");
+	//*	use the binary cache if it is up to date
+	filePointer	=	NULL;
+	draperData	=	CatalogCache_Read(myFilePath, objectCount);
+	if (draperData == NULL)
+	{
+		filePointer	=	fopen(myFilePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 		specifiedLnCnt	=	CountLinesInFile(filePointer);
@@ -828,11 +847,16 @@ int				startupWidgetIdx;
 			}
 
 			*objectCount	=	recordCount;
+			CatalogCache_Save(myFilePath, draperData, recordCount);
 		}
 		fclose(filePointer);
 
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (draperData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("Failed to read:", myFilePath);
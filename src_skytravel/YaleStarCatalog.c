@@ -3,6 +3,7 @@
 //************************************************************************
 //*	Oct 24,	2021	<MLS> Now parsing spectral class from Yale Catalog
 //*	Jan 22,	2022	<MLS> Getting rid of leading digits in Yale star name
+//*	Oct 18,	2026	<AGT> Yale catalog uses the binary cache (CatalogCache.c)
 //************************************************************************
 
 //************************************************************************
@@ -238,6 +239,7 @@
 #include	"StarCatalogHelper.h"
 
 #include	"YaleStarCatalog.h"
+#include	"CatalogCache.h"
 
 ////************************************************************************
 //static void	StripLeadingSpaces(char *theString)
@@ -425,7 +427,13 @@ int				startupWidgetIdx;
 	strcpy(filePath, kSkyTravelDataDirectory);
 	strcat(filePath, "/YALEcatalog.dat");
 
-	filePointer	=	fopen(filePath, "r");
+	//*	use the binary cache if it is up to date
+	filePointer		=	NULL;
+	yaleStarData	=	CatalogCache_Read(filePath, starCount);
+	if (yaleStarData == NULL)
+	{
+		filePointer	=	fopen(filePath, "r");
+	}
 	if (filePointer != NULL)
 	{
 		yaleLineCount	=	9200;
@@ -448,11 +456,16 @@ int				startupWidgetIdx;
 			}
 
 			*starCount	=	recordCount;
+			CatalogCache_Save(filePath, yaleStarData, recordCount);
 		}
 		fclose(filePointer);
 
 		SetStartupTextStatus(startupWidgetIdx, "OK");
 	}
+	else if (yaleStarData != NULL)
+	{
+		SetStartupTextStatus(startupWidgetIdx, "OK (cached)");
+	}
 	else
 	{
 		CONSOLE_DEBUG_W_STR("Failed to read:", filePath);
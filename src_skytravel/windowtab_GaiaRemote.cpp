@@ -20,6 +20,7 @@
 //*****************************************************************************
 //*	Jan  9,	2022	<MLS> Created windowtab_GaiaRemote.cpp
 //*	Jan 10,	2022	<MLS> Gaia remote list window fully working
+//*	Oct 18,	2026	<AGT> Double click ignores blocks that are still being fetched
 //*****************************************************************************
 #ifdef _ENABLE_REMOTE_SQL_
 
@@ -259,7 +260,9 @@ int		starDataIdx;
 		screenLineNum	=	widgetIdx - kGaiaRemoteList_Obj_01;
 		starDataIdx		=	screenLineNum + cFirstLineIdx;
 		CONSOLE_DEBUG_W_NUM("starDataIdx\t=", starDataIdx);
-		if ((starDataIdx >= 0) && (starDataIdx < kMaxGaiaDataSets))
+		//*	the block may still be loading
+		if ((starDataIdx >= 0) && (starDataIdx < kMaxGaiaDataSets) &&
+			(gGaiaDataList[starDataIdx].gaiaData != NULL) && (gGaiaDataList[starDataIdx].gaiaDataCnt > 0))
 		{
 			Center_CelestralObject(&gGaiaDataList[starDataIdx].gaiaData[0]);
 		}
@@ -128,6 +128,25 @@
 //*	Jun  9,	2024	<MLS> Added planet size drawing in PlotSkyObjects()
 //*	Jun 11,	2024	<MLS> Changed cAutoAdvanceTime to global, gAutoAdvanceTime
 //*	Dec  2,	2024	<MLS> Fixed bug: cTrack was not initialized
+//*	Oct 18,	2026	<AGT> Large catalogs are now drawn through a sky index (SkyIndex.c)
+//*	Oct 18,	2026	<AGT> Added Search_and_plot_Object() & Search_and_plot_Indexed()
+//*	Oct 18,	2026	<AGT> FindObjectNearCursor() only looks at the objects that were drawn
+//*	Oct 18,	2026	<AGT> Large catalogs now have a column cache of the values used to draw (CelestCatalog.c)
+//*	Oct 18,	2026	<AGT> Search_and_plot_Indexed() and Precess() use the catalog hot columns
+//*	Oct 18,	2026	<AGT> Precess() now uses PrecessEngine.c, adds nutation and Hipparcos proper motion
+//*	Oct 18,	2026	<AGT> Catalogs with hot columns are no longer re-sorted after precession
+//*	Oct 18,	2026	<AGT> Star catalogs are loaded from the binary cache if up to date (CatalogCache.c)
+//*	Oct 18,	2026	<AGT> Asteroids are now updated in DrawAsteroids() with AsteroidEphemeris.c
+//*	Oct 18,	2026	<AGT> DrawAsteroids() only computes the ones in view and bright enough to draw
+//*	Oct 18,	2026	<AGT> Removed CelestCatalog.c, Search_and_plot_Indexed() reads the catalog records again
+//*	Oct 18,	2026	<AGT> Catalogs with a sky index are the ones that are not re-sorted after precession
+//*	Oct 18,	2026	<AGT> Gaia blocks ahead of the direction of motion are prefetched
+//*	Oct 18,	2026	<AGT> FindObjectNearCursor() now uses the screen hit grid (SkyHitGrid.c)
+//*	Oct 18,	2026	<AGT> Plotting no longer writes curXX/curYY into the catalogs
+//*	Oct 18,	2026	<AGT> The sky is cached as an image, only the telescope/dome are drawn every time
+//*	Oct 18,	2026	<AGT> Split DrawSkyAll() into UpdateSkyState() and DrawSkyAll()
+//*	Oct 18,	2026	<AGT> Telescope FOV and dome slit moved to DrawDynamicOverlays()
+//*	Oct 18,	2026	<AGT> Sky layer stats only go to the console with _DEBUG_SKY_LAYER_
 //*****************************************************************************
 //*	TODO
 //*			star catalog lists
@@ -147,6 +166,7 @@
 
 //#define	_DISPLAY_MAP_TOKENS_
 //#define	_ENBABLE_WHITE_CHART_
+//#define	_DEBUG_SKY_LAYER_
 
 #include	<sys/time.h>
 #include	<unistd.h>
@@ -169,6 +189,9 @@
 #include	"SkyStruc.h"
 #include	"StarData.h"
 #include	"SAO_stardata.h"
+#include	"SkyIndex.h"
+#include	"PrecessEngine.h"
+#include	"CatalogCache.h"
 #include	"SkyTravelConstants.h"
 #include	"SkyTravelTimeRoutines.h"
 #include	"NGCcatalog.h"
@@ -188,6 +211,7 @@
 #include	"polaralign.h"
 
 #include	"AsteroidData.h"
+#include	"AsteroidEphemeris.h"
 #include	"OpenNGC.h"
 
 #ifdef _ENABLE_REMOTE_GAIA_
@@ -419,6 +443,15 @@ int		startupWidgetIdx;
 	cCsry					=	0;
 	cTrack					=	false;
 	cMouseDragInProgress	=	false;
+	cHitListIdx				=	-1;
+	memset((void *)&cHitGrid, 0, sizeof(TYPE_SkyHitGrid));
+
+	memset((void *)&cSkyLayerKey, 0, sizeof(TYPE_SkyLayerKey));
+	cSkyLayerFrames			=	0;
+	cSkyLayerHits			=	0;
+	cSkyLayerRebuild_ms		=	0.0;
+	cSkyLayerCached_ms		=	0.0;
+	cSkyLayerLastReport_ms	=	millis();
 
 	if (gObseratorySettings.ValidLatLon)
 	{
@@ -618,6 +651,7 @@ int		startupWidgetIdx;
 #endif // _ENABLE_ASTEROIDS_
 
 	Precess();		//*	make sure all of the data bases are sorted properly
+	BuildSkyIndexes();
 
 	//********************************************************************************
 	//*	NOTE: It is IMPORTANT that the precess is called
@@ -660,6 +694,8 @@ WindowTabSkyTravel::~WindowTabSkyTravel(void)
 //	CONSOLE_DEBUG(__FUNCTION__);
 	gSkyTravelWindow		=	NULL;
 
+	SkyHitGrid_Free(&cHitGrid);
+
 	if (gStarDataPtr != NULL)
 	{
 		free(gStarDataPtr);
@@ -667,7 +703,7 @@ WindowTabSkyTravel::~WindowTabSkyTravel(void)
 	}
 	if (gYaleStarDataPtr != NULL)
 	{
-		free(gYaleStarDataPtr);
+		CatalogCache_Free(gYaleStarDataPtr);
 		gYaleStarDataPtr	=	NULL;
 	}
 	if (gMessierObjectPtr != NULL)
@@ -677,14 +713,14 @@ WindowTabSkyTravel::~WindowTabSkyTravel(void)
 	}
 	if (gDraperObjectPtr != NULL)
 	{
-		free(gDraperObjectPtr);
+		CatalogCache_Free(gDraperObjectPtr);
 		gDraperObjectPtr	=	NULL;
 	}
 
 #ifdef _ENABLE_HYG_
 	if (gHYGObjectPtr != NULL)
 	{
-		free(gHYGObjectPtr);
+		CatalogCache_Free(gHYGObjectPtr);
 		gHYGObjectPtr	=	NULL;
 	}
 #endif // _ENABLE_HYG_
@@ -1132,6 +1168,9 @@ struct tm			siderealTime;
 					request_RA_Degrees	=	0.0;
 				}
 			}
+			//*	get the blocks ahead of us if we are moving, they are not reported
+			PrefetchSkyTravelView(DEGREES(cRa0), DEGREES(cDecl0), viewAngle_Degrees);
+
 			if (requestStarted > 0)
 			{
 				sprintf(textBuff, "GAIA SQL request started for RA=%1.0fD(%1.1fH) DEC=%1.0f",
@@ -2171,6 +2210,7 @@ void	WindowTabSkyTravel::ForceReDrawSky(void)
 Controller	*myControllerObj;
 
 	UpdateButtonStatus();
+	InvalidateSkyLayer();
 
 	if (cMouseDragInProgress == false)
 	{
@@ -2744,14 +2784,13 @@ TYPE_SpherTrig	sphptr;
 
 
 //*********************************************************************
-void	WindowTabSkyTravel::DrawSkyAll(void)
+//*	time, planet positions, sky color and the view center.
+//*	Has to be done every update, even if the sky does not get redrawn
+//*********************************************************************
+void	WindowTabSkyTravel::UpdateSkyState(void)
 {
 short		iii;
 
-//	CONSOLE_DEBUG_W_NUM(__FUNCTION__, cDebugCounter++);
-
-	cDisplayedStarCount	=	0;
-
 	CalanendarTime(&gCurrentSkyTime);
 	Local_Time(&gCurrentSkyTime);		//* compute local time from gmt and timezone
 
@@ -2847,6 +2886,20 @@ short		iii;
 
 
 	ConvertLatLonToRaDec(&cCurrLatLon, &gCurrentSkyTime);
+}
+
+//*********************************************************************
+//*	UpdateSkyState() has to be called first
+//*********************************************************************
+void	WindowTabSkyTravel::DrawSkyAll(void)
+{
+//	CONSOLE_DEBUG_W_NUM(__FUNCTION__, cDebugCounter++);
+
+	cDisplayedStarCount	=	0;
+
+	//*	the objects get added to the hit grid as they are plotted
+	SkyHitGrid_Reset(&cHitGrid, wind_ulx, wind_uly, cWind_width, cWind_height);
+	cHitListIdx			=	-1;
 
 //	DRAW HERE
 
@@ -2884,6 +2937,7 @@ short		iii;
 	#ifdef _ENABLE_REMOTE_GAIA_
 		if (cDispOptions.dispGaia)
 		{
+		short		iii;
 		double		distance_Deg;
 		int			drawnCnt;
 		int			notDrawnCnt;
@@ -3064,6 +3118,243 @@ short		iii;
 	}
 }
 
+//*****************************************************************************
+static uint32_t	SkyLayerHash(uint32_t hashValue, const void *data, const size_t dataLen)
+{
+const unsigned char	*bytePtr;
+size_t				iii;
+
+	//*	FNV-1a
+	bytePtr	=	(const unsigned char *)data;
+	for (iii=0; iii<dataLen; iii++)
+	{
+		hashValue	^=	bytePtr[iii];
+		hashValue	*=	16777619;
+	}
+	return(hashValue);
+}
+
+//*****************************************************************************
+static uint32_t	SkyLayerHashList(uint32_t hashValue, const void *listPtr, const long listCount)
+{
+	hashValue	=	SkyLayerHash(hashValue, &listPtr,	sizeof(listPtr));
+	hashValue	=	SkyLayerHash(hashValue, &listCount,	sizeof(listCount));
+	return(hashValue);
+}
+
+//*****************************************************************************
+static double	GetSkyLayerMilliSecs(void)
+{
+struct timeval	currentTimeVal;
+
+	gettimeofday(&currentTimeVal, NULL);
+	return((currentTimeVal.tv_sec * 1000.0) + (currentTimeVal.tv_usec / 1000.0));
+}
+
+//*****************************************************************************
+void	WindowTabSkyTravel::GetSkyLayerKey(TYPE_SkyLayerKey *layerKey, const int width, const int height)
+{
+uint32_t	hashValue;
+bool		dragState;
+#ifdef _ENABLE_REMOTE_GAIA_
+	int		iii;
+#endif
+
+	memset((void *)layerKey, 0, sizeof(TYPE_SkyLayerKey));
+	layerKey->width			=	width;
+	layerKey->height		=	height;
+	layerKey->viewAngle		=	cView_angle_Rads;
+	layerKey->ra0			=	cRa0;
+	layerKey->decl0			=	cDecl0;
+	layerKey->gamang		=	cGamang;
+	layerKey->az0			=	cAz0;
+	layerKey->elev0			=	cElev0;
+	layerKey->julianDay		=	gCurrentSkyTime.fJulianDay;
+
+	//*	the first group of catalogs is not drawn while dragging
+	dragState	=	(cMouseDragInProgress || cLeftButtonDown);
+	hashValue	=	2166136261U;
+	hashValue	=	SkyLayerHash(hashValue, &cDispOptions,		sizeof(cDispOptions));
+	hashValue	=	SkyLayerHash(hashValue, &gST_DispOptions,	sizeof(gST_DispOptions));
+	hashValue	=	SkyLayerHash(hashValue, &cSkyRGBvalue,		sizeof(cSkyRGBvalue));
+	hashValue	=	SkyLayerHash(hashValue, &cCurrentSkyColor,	sizeof(cCurrentSkyColor));
+	hashValue	=	SkyLayerHash(hashValue, &cChartMode,		sizeof(cChartMode));
+	hashValue	=	SkyLayerHash(hashValue, &cNightMode,		sizeof(cNightMode));
+	hashValue	=	SkyLayerHash(hashValue, &dragState,			sizeof(dragState));
+	layerKey->optionsSignature	=	hashValue;
+
+	//*	if any of the catalogs is loaded, reloaded or freed, the pointer or count changes
+	hashValue	=	2166136261U;
+	hashValue	=	SkyLayerHashList(hashValue, gStarDataPtr,			gStarCount);
+	hashValue	=	SkyLayerHashList(hashValue, gYaleStarDataPtr,		gYaleStarCount);
+	hashValue	=	SkyLayerHashList(hashValue, gMessierObjectPtr,		gMessierObjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gNGCobjectPtr,			gNGCobjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gHipObjectPtr,			gHipObjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gDraperObjectPtr,		gDraperObjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gSAOobjectPtr,			gSAOobjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gSpecialObjectPtr,		gSpecialObjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gPolarAlignObjectPtr,	gPolarAlignObjectCount);
+	hashValue	=	SkyLayerHashList(hashValue, gAAVSOalertsPtr,		gAAVSOalertsCnt);
+	hashValue	=	SkyLayerHashList(hashValue, gConstStarPtr,			gConstStarCount);
+	hashValue	=	SkyLayerHashList(hashValue, gMilkyWay_outlines,		gMilkyWay_outlineCnt);
+	hashValue	=	SkyLayerHashList(hashValue, gOpenNGC_outlines,		gOpenNGC_outlineCnt);
+#ifdef _ENABLE_HYG_
+	hashValue	=	SkyLayerHashList(hashValue, gHYGObjectPtr,			gHYGObjectCount);
+#endif
+#ifdef _ENABLE_ASTEROIDS_
+	hashValue	=	SkyLayerHashList(hashValue, gAsteroidPtr,			gAsteroidCnt);
+#endif
+#ifdef _ENABLE_REMOTE_GAIA_
+	//*	the Gaia blocks arrive in the background
+	for (iii=0; iii<kMaxGaiaDataSets; iii++)
+	{
+		if (gGaiaDataList[iii].validData)
+		{
+			hashValue	=	SkyLayerHashList(hashValue, gGaiaDataList[iii].gaiaData, gGaiaDataList[iii].gaiaDataCnt);
+		}
+	}
+#endif
+	layerKey->dataSignature	=	hashValue;
+}
+
+//*****************************************************************************
+//*	returns true if the cached sky image can be used for this key
+//*****************************************************************************
+bool	WindowTabSkyTravel::SkyLayerIsCurrent(TYPE_SkyLayerKey *layerKey)
+{
+bool	isCurrent;
+double	pixelsPerRadian;
+double	halfDiagonal;
+double	cosDistance;
+double	deltaGamma;
+double	drift_Pixels;
+
+	isCurrent	=	false;
+	if (cSkyLayerKey.valid &&
+		(layerKey->width == cSkyLayerKey.width) &&
+		(layerKey->height == cSkyLayerKey.height) &&
+		(layerKey->viewAngle == cSkyLayerKey.viewAngle) &&
+		(layerKey->optionsSignature == cSkyLayerKey.optionsSignature) &&
+		(layerKey->dataSignature == cSkyLayerKey.dataSignature))
+	{
+		pixelsPerRadian	=	layerKey->width / layerKey->viewAngle;
+		halfDiagonal	=	sqrt((layerKey->width * layerKey->width) + (layerKey->height * layerKey->height)) / 2.0;
+
+		//*	how far has the center moved
+		cosDistance		=	(sin(layerKey->decl0) * sin(cSkyLayerKey.decl0)) +
+							(cos(layerKey->decl0) * cos(cSkyLayerKey.decl0) * cos(layerKey->ra0 - cSkyLayerKey.ra0));
+		drift_Pixels	=	acos((cosDistance > 1.0) ? 1.0 : cosDistance) * pixelsPerRadian;
+
+		//*	the horizon is drawn in alt/az
+		cosDistance		=	(sin(layerKey->elev0) * sin(cSkyLayerKey.elev0)) +
+							(cos(layerKey->elev0) * cos(cSkyLayerKey.elev0) * cos(layerKey->az0 - cSkyLayerKey.az0));
+		drift_Pixels	+=	acos((cosDistance > 1.0) ? 1.0 : cosDistance) * pixelsPerRadian;
+
+		//*	rotation moves the corners the most
+		deltaGamma		=	fabs(layerKey->gamang - cSkyLayerKey.gamang);
+		if (deltaGamma > PI)
+		{
+			deltaGamma	=	kTWOPI - deltaGamma;
+		}
+		drift_Pixels	+=	deltaGamma * halfDiagonal;
+
+		//*	the moon is the fastest moving object, about 0.55 degrees per hour
+		drift_Pixels	+=	fabs(layerKey->julianDay - cSkyLayerKey.julianDay) * 24.0 * RADIANS(0.55) * pixelsPerRadian;
+
+		isCurrent		=	(drift_Pixels < kSkyLayerMaxDrift_Pixels);
+	}
+	return(isCurrent);
+}
+
+//*****************************************************************************
+//*	call this if something that is drawn changed and is not in the layer key
+//*****************************************************************************
+void	WindowTabSkyTravel::InvalidateSkyLayer(void)
+{
+	cSkyLayerKey.valid	=	false;
+}
+
+//*****************************************************************************
+//*	the stats only go to the console with _DEBUG_SKY_LAYER_
+//*****************************************************************************
+void	WindowTabSkyTravel::ReportSkyLayerStats(void)
+{
+uint32_t	currentMilliSecs;
+#ifdef _DEBUG_SKY_LAYER_
+uint32_t	rebuildCnt;
+#endif
+
+	currentMilliSecs	=	millis();
+	if ((currentMilliSecs - cSkyLayerLastReport_ms) >= kSkyLayerStatsInterval_ms)
+	{
+	#ifdef _DEBUG_SKY_LAYER_
+		if (cSkyLayerFrames > 0)
+		{
+			rebuildCnt	=	cSkyLayerFrames - cSkyLayerHits;
+			CONSOLE_DEBUG_W_NUM("Sky layer frames      \t=",	cSkyLayerFrames);
+			CONSOLE_DEBUG_W_NUM("Sky layer cache hits  \t=",	cSkyLayerHits);
+			CONSOLE_DEBUG_W_DBL("Sky layer hit rate %  \t=",	((100.0 * cSkyLayerHits) / cSkyLayerFrames));
+			if (rebuildCnt > 0)
+			{
+				CONSOLE_DEBUG_W_DBL("Redraw avg ms         \t=",	(cSkyLayerRebuild_ms / rebuildCnt));
+			}
+			if (cSkyLayerHits > 0)
+			{
+				CONSOLE_DEBUG_W_DBL("Cached avg ms         \t=",	(cSkyLayerCached_ms / cSkyLayerHits));
+			}
+		}
+	#endif
+		cSkyLayerFrames			=	0;
+		cSkyLayerHits			=	0;
+		cSkyLayerRebuild_ms		=	0.0;
+		cSkyLayerCached_ms		=	0.0;
+		cSkyLayerLastReport_ms	=	currentMilliSecs;
+	}
+}
+
+#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+//*****************************************************************************
+//*	draws the sky and the static overlays (grid, horizon, compass...) into
+//*	skyRect, from the cached image if nothing has changed.
+//*	UpdateSkyState() has to be called first
+//*****************************************************************************
+void	WindowTabSkyTravel::DrawSkyLayered(cv::Mat *openCV_Image, cv::Rect &skyRect)
+{
+TYPE_SkyLayerKey	layerKey;
+cv::Mat				image_roi;
+double				startMilliSecs;
+
+	startMilliSecs	=	GetSkyLayerMilliSecs();
+	GetSkyLayerKey(&layerKey, skyRect.width, skyRect.height);
+	image_roi		=	cv::Mat(*openCV_Image, skyRect);
+	if (SkyLayerIsCurrent(&layerKey))
+	{
+		cSkyLayerImage.copyTo(image_roi);
+		cSkyLayerHits++;
+		cSkyLayerCached_ms	+=	GetSkyLayerMilliSecs() - startMilliSecs;
+	}
+	else
+	{
+		cCurrentColor	=	CV_RGB(	cSkyRGBvalue.red,
+									cSkyRGBvalue.grn,
+									cSkyRGBvalue.blu);
+		LLG_FillRect(skyRect.x, skyRect.y, skyRect.width, skyRect.height);
+
+		cOpenCV_Image	=	&image_roi;
+		DrawSkyAll();
+		DrawWindowOverlays();
+		cOpenCV_Image	=	openCV_Image;
+
+		image_roi.copyTo(cSkyLayerImage);
+		cSkyLayerKey		=	layerKey;
+		cSkyLayerKey.valid	=	true;
+		cSkyLayerRebuild_ms	+=	GetSkyLayerMilliSecs() - startMilliSecs;
+	}
+	cSkyLayerFrames++;
+	ReportSkyLayerStats();
+}
+#endif // _USE_OPENCV_CPP_
+
 //*****************************************************************************
 void	WindowTabSkyTravel::SetView_Angle(const double newViewAngle_radians)
 {
@@ -3960,24 +4251,26 @@ TYPE_WIDGET	*theWidget;
 		case kSkyTravel_NightSky:
 			if (cOpenCV_Image != NULL)
 			{
-				cCurrentColor	=	CV_RGB(	cSkyRGBvalue.red,
-											cSkyRGBvalue.grn,
-											cSkyRGBvalue.blu);
-//				CONSOLE_DEBUG_W_NUM("cSkyRGBvalue.red\t=", cSkyRGBvalue.red);
-//				CONSOLE_DEBUG_W_NUM("cSkyRGBvalue.grn\t=", cSkyRGBvalue.grn);
-//				CONSOLE_DEBUG_W_NUM("cSkyRGBvalue.blu\t=", cSkyRGBvalue.blu);
-				LLG_FillRect(theWidget->left, theWidget->top, theWidget->width, theWidget->height);
+				UpdateSkyState();
 
 			#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+				//*	the sky comes from the cache if nothing has changed
+				DrawSkyLayered(openCV_Image, myCVrect);
+
 				image_roi		=	cv::Mat(*cOpenCV_Image, myCVrect);
 				cOpenCV_Image	=	&image_roi;
-				DrawSkyAll();
-				DrawWindowOverlays();
+				DrawDynamicOverlays();
 				cOpenCV_Image	=	openCV_Image;
 			#elif (CV_MAJOR_VERSION <= 3)
+				cCurrentColor	=	CV_RGB(	cSkyRGBvalue.red,
+											cSkyRGBvalue.grn,
+											cSkyRGBvalue.blu);
+				LLG_FillRect(theWidget->left, theWidget->top, theWidget->width, theWidget->height);
+
 				cvSetImageROI(cOpenCV_Image,  myCVrect);
 				DrawSkyAll();
 				DrawWindowOverlays();
+				DrawDynamicOverlays();
 				cvResetImageROI(cOpenCV_Image);
 			#else
 				#error "Not able to complete this operation"
@@ -4043,13 +4336,12 @@ bool	WindowTabSkyTravel::Precess(TYPE_CelestData	*celestObjPtr,
 									bool			sortFlag,
 									bool			forcePrecession)
 {
-long			ii;
-double			ipart;
-double			epoch,zee,pzeta,ptheta;
-double			alpha,aside,cside,gamma;
-double			sin_bside,cos_bside;
-long			startIndex, stopIndex;
-bool			pressesOccurred;
+double				ipart;
+double				epoch,zee,pzeta,ptheta;
+long				startIndex, stopIndex;
+bool				pressesOccurred;
+bool				keepOrder;
+TYPE_PrecessMatrix	precMatrix;
 
 //	CONSOLE_DEBUG(__FUNCTION__);
 //	CONSOLE_DEBUG_W_LONG("celestObjCount\t=",	celestObjCount);
@@ -4096,10 +4388,6 @@ bool			pressesOccurred;
 		zee			=	kTWOPI * modf(zee,		&ipart);
 		pzeta		=	kTWOPI * modf(pzeta,		&ipart);
 
-		//* for fast sphsas
-		cos_bside	=	cos(ptheta);
-		sin_bside	=	sin(ptheta);
-
 //		CONSOLE_DEBUG_W_NUM("celestObjCount\t=",	celestObjCount);
 		if ((celestObjCount == 3885) && (sortFlag == true))
 		{
@@ -4112,40 +4400,24 @@ bool			pressesOccurred;
 			startIndex	=	0;
 			stopIndex	=	celestObjCount;
 		}
-		for (ii=startIndex; ii < stopIndex; ii++)
+		//*	the precession angles and nutation are applied as one rotation matrix,
+		//*	the catalogs with a sky index are done in blocks/threads (PrecessEngine.c).
+		//*	They are drawn through the index so their order does not matter,
+		//*	they are not re-sorted and PrecessEngine can keep their J2000 vectors
+		PrecessEngine_SetupMatrix(&precMatrix, pzeta, zee, ptheta, gCurrentSkyTime.fJulianDay, true);
+		keepOrder	=	(SkyIndex_Find(celestObjPtr, celestObjCount) != NULL);
+		if (keepOrder)
 		{
-			cside	=	kHALFPI - celestObjPtr[ii].org_decl;
-			alpha	=	pzeta + celestObjPtr[ii].org_ra;
-
-			//* here we use inline code for sphsas and sphsss because bside is constant
-			//* so we avoid repeated invocations of sin(bside) and cos(bside)
-
-			aside	=	acos((cos_bside * cos(cside)) + (sin_bside * sin(cside) * cos(alpha)));
-
-			celestObjPtr[ii].decl	=	kHALFPI - aside;
-
-			//* sphsss
-
-			if (aside > kEPSILON)
-			{
-				gamma	=	asin(sin(cside)*sin(alpha)/sin(aside));
-			}
-			else
-			{
-				gamma	=	0.0;
-			}
-			if (cos(cside)<(cos_bside*cos(aside)))
-			{
-				gamma	=	PI - gamma;		//* supplement gamma if cos(c)<cos(b)*cos(a)
-			}
-			if (epoch > 0.)
-			{
-				gamma	=	PI - gamma;				//* supplement gamma when epoch > 0
-			}
-			celestObjPtr[ii].ra	=	zee + gamma;
+			PrecessEngine_TransformCatalog(&precMatrix, celestObjPtr, celestObjCount, startIndex, stopIndex);
+		}
+		else
+		{
+			PrecessEngine_TransformObjects(&precMatrix, celestObjPtr, startIndex, stopIndex);
 		}
 		pressesOccurred	=	true;
-		if (sortFlag)
+		SkyIndex_Invalidate(celestObjPtr);
+		InvalidateSkyLayer();
+		if (sortFlag && (keepOrder == false))
 		{
 //			DisplayHelpMessage("Sorting (qsort)");
 //			CONSOLE_DEBUG("Sorting (qsort)");
@@ -4251,50 +4523,11 @@ bool			pressesOccurred;
 //		DisplayHelpMessage(ticksMsg);
 
 
-#ifdef _ENABLE_ASTEROIDS_
-		//----------------------------------------------------------
-		//*	now do the asteroids
-		if (gAsteroidPtr != NULL)
-		{
-		double	targetJulian;
-//		double	degrees;
-		double	solar_RA;
-		double	solar_DEC;
-		double	solar_Distance;
-//		int		iii;
+		//*	the asteroids are no longer done here, DrawAsteroids() updates the
+		//*	ones that are going to be drawn for the current time and view
 
-
-//			//*	do the precession on each asteroid
-//			for (iii=0; iii<gAsteroidCnt; iii++)
-//			{
-//
-//			}
-			targetJulian	=	Julian_CalcFromDate(	gCurrentSkyTime.month,
-														gCurrentSkyTime.day,
-														gCurrentSkyTime.year);
-			//http://astropixels.com/ephemeris/sun/sun2022.html
-			//http://people.tamu.edu/~kevinkrisciunas/ra_dec_sun_2022.html
-			solar_RA		=	cPlanets[SUN].ra;
-			solar_DEC		=	cPlanets[SUN].decl;
-			solar_Distance	=	cPlanetStruct[SUN].dist;
-//					cPlanetStruct[SUN].ra,		//*	radians
-//					cPlanetStruct[SUN].decl,	//*	radians
-//					cPlanetStruct[SUN].dist);	//*	AU
-
-
-			UpdateAsteroidEphemeris(	gAsteroidPtr,
-										gAsteroidCnt,
-										targetJulian,
-										solar_RA,			//*	radians
-										solar_DEC,			//*	radians
-										solar_Distance);	//*	AU
-//			PrintAsteroidEphemeris(		gAsteroidPtr,
-//										targetJulian,
-//										solar_RA,			//*	radians
-//										solar_DEC,			//*	radians
-//										solar_Distance);	//*	AU
-		}
-#endif // _ENABLE_ASTEROIDS_
+		//*	the catalogs have moved and been re-sorted
+		BuildSkyIndexes();
 	}
 	else
 	{
@@ -4305,6 +4538,32 @@ bool			pressesOccurred;
 	return(pressesOccurred);
 }
 
+//*****************************************************************************
+//*	the large catalogs are drawn using a sky index,
+//*	the small ones (Messier, special, AAVSO etc) are faster to just walk
+//*****************************************************************************
+void	WindowTabSkyTravel::BuildSkyIndexes(void)
+{
+	BuildSkyIndex(gStarDataPtr,		gStarCount);
+	BuildSkyIndex(gNGCobjectPtr,		gNGCobjectCount);
+	BuildSkyIndex(gYaleStarDataPtr,	gYaleStarCount);
+	BuildSkyIndex(gHipObjectPtr,		gHipObjectCount);
+	BuildSkyIndex(gDraperObjectPtr,	gDraperObjectCount);
+#ifdef _ENABLE_HYG_
+	BuildSkyIndex(gHYGObjectPtr,		gHYGObjectCount);
+#endif
+	BuildSkyIndex(gSAOobjectPtr,		gSAOobjectCount);
+}
+
+//*****************************************************************************
+void	WindowTabSkyTravel::BuildSkyIndex(TYPE_CelestData *objectPtr, const long objectCount)
+{
+	if ((objectPtr != NULL) && (objectCount >= kSkyIndexMinObjects))
+	{
+		SkyIndex_Build(objectPtr, objectCount);
+	}
+}
+
 //*****************************************************************************
 void	WindowTabSkyTravel::DrawObjectByShape(int xcoord, int ycoord, int shape, int magn)
 {
@@ -5242,26 +5501,68 @@ int		textColor;
 }
 
 
+//*****************************************************************************
+//*	returns the faintest magnitude that will be drawn for this data source,
+//*	objects fainter than this do not need to be looked at.
+//*	Returns kNoMagnitudeLimit if everything gets drawn
+//*****************************************************************************
+double	WindowTabSkyTravel::GetFaintestDrawnMagnitude(const short dataSource)
+{
+double	faintestMag;
+
+	faintestMag	=	kNoMagnitudeLimit;
+	switch(dataSource)
+	{
+		//*	these all use the default star size calculation in DrawStarFancy()
+		case kDataSrc_YaleBrightStar:
+		case kDataSrc_HubbleGSC:
+		case kDataSrc_Hipparcos:
+		case kDataSrc_Draper:
+		case kDataSrc_HYG:
+		case kDataSrc_SAO:
+			if ((gST_DispOptions.MagnitudeMode != kMagnitudeMode_All) && (cMaxRadius_D > 0.0))
+			{
+				//*	the star radius is truncated to an int, the star gets drawn as long as
+				//*	D * (A * LN(field) + B - mag) / (B - C) > -1
+				faintestMag	=	(kSlope_A * cLN_view_angle) + cFaintLimit_B +
+								((cFaintLimit_B - kBrightLimit_C) / cMaxRadius_D);
+				if ((gST_DispOptions.MagnitudeMode == kMagnitudeMode_Specified) &&
+					(gST_DispOptions.DisplayedMagnitudeLimit > faintestMag))
+				{
+					faintestMag	=	gST_DispOptions.DisplayedMagnitudeLimit;
+				}
+			}
+			break;
+
+		//*	same numbers as DrawAsteroidFancy()
+		case kDataSrc_Asteroids:
+			if (gST_DispOptions.MagnitudeMode != kMagnitudeMode_All)
+			{
+				faintestMag	=	(-1.93 * cLN_view_angle) + 4.5224 + (8.1993 / 20.0);
+				if ((gST_DispOptions.MagnitudeMode == kMagnitudeMode_Specified) &&
+					(gST_DispOptions.DisplayedMagnitudeLimit > faintestMag))
+				{
+					faintestMag	=	gST_DispOptions.DisplayedMagnitudeLimit;
+				}
+			}
+			break;
+	}
+	return(faintestMag);
+}
+
 //*****************************************************************************
 long	WindowTabSkyTravel::Search_and_plot(TYPE_CelestData	*objectptr,
 											long			maxObjects,
 											bool			dataIsSorted)
 {
-bool				goflag;
 int					iii;
-int					magn;
-int					shape;
-int					xcoord;
-int					ycoord;
-double				temp,angle;
-double				alpha,aside,cside,gamma;
+double				temp;
 double				sin_bside,cos_bside;
 double				xangle,yangle,rangle;
 unsigned int		myCount;
 short				dataSource;
-int					myFontIdx;
 int					textColor;
-int					myColor;
+TYPE_SkyIndex		*skyIndex;
 
 
 //	CONSOLE_DEBUG(__FUNCTION__);
@@ -5312,27 +5613,6 @@ int					myColor;
 	cXfactor	=	cWind_width / cView_angle_Rads;
 	cYfactor	=	cXfactor;	//* 1:1 aspect ratio
 
-	//*	the database is sorted by declination, from high value (north pole) to low
-	//*	value (south pole)
-	//*	skip quickly until we find the first star within our current display
-
-	//* continue scan until decl < decmin
-	iii		=	0;
-	if (dataIsSorted)
-	{
-		while ((objectptr[iii].decl > cDecmax) && (iii < maxObjects))	//* skip down to where decl < cDecmax
-		{
-			objectptr[iii].curXX	=	-100;
-			objectptr[iii].curYY	=	-100;
-			iii++;
-		}
-	}
-	//*	debuging code
-	if (iii > maxObjects)
-	{
-		CONSOLE_DEBUG_W_LONG("maxObjects\t=", maxObjects);
-	}
-
 	//-----------------------------------------------------
 	//*	we have the data source, do this one time so we dont have to do it for each star
 	//*		determine:
@@ -5340,200 +5620,351 @@ int					myColor;
 	//*			view angle limit for name display
 	textColor	=	SetStarTextColorAndViewAngle(dataSource);
 
+	//*	only the catalogs FindObjectNearCursor() looks at go in the hit grid
+	cHitListIdx	=	-1;
+	if (IsCursorSearchList(objectptr, maxObjects))
+	{
+		cHitListIdx	=	SkyHitGrid_AddList(&cHitGrid, objectptr, maxObjects);
+	}
 
-	//-------------------------------------------------------------------------
-	//-------------------------------------------------------------------------
-	//-------------------------------------------------------------------------
-	//*	main loop through the stars
-	while (iii < maxObjects)
+	//*	if the catalog has a sky index, only look at the tiles that are on the screen
+	skyIndex	=	SkyIndex_Find(objectptr, maxObjects);
+	if (skyIndex != NULL)
 	{
-		goflag	=	true;
-		objectptr[iii].curXX	=	-100;
-		objectptr[iii].curYY	=	-100;
+		myCount	=	Search_and_plot_Indexed(skyIndex, dataSource, textColor, sin_bside, cos_bside);
+	}
+	else
+	{
+		//*	the database is sorted by declination, from high value (north pole) to low
+		//*	value (south pole)
+		//*	skip quickly until we find the first star within our current display
 
-		magn		=	0;
-		shape		=	ST_ALWAYS;
-		if (dataSource == kDataSrc_Orginal)
+		//* continue scan until decl < decmin
+		iii		=	0;
+		if (dataIsSorted)
 		{
-			magn	=	objectptr[iii].magn & 0x00ff;
-
-			//*	this is part of the original database processing
-			if (magn < 0x0010)
-			{
-				shape	=	ST_STAR;
-			}
-			else if (magn < 0x0073)
-			{
-				shape	=	ST_DEEP;
-			}
-			else if (magn < 0x00db)
+			while ((objectptr[iii].decl > cDecmax) && (iii < maxObjects))	//* skip down to where decl < cDecmax
 			{
-				shape	=	ST_NAME;
+				iii++;
 			}
-			else
+		}
+		//*	debuging code
+		if (iii > maxObjects)
+		{
+			CONSOLE_DEBUG_W_LONG("maxObjects\t=", maxObjects);
+		}
+
+		//-------------------------------------------------------------------------
+		//*	main loop through the stars
+		while (iii < maxObjects)
+		{
+			if (Search_and_plot_Object(&objectptr[iii], dataSource, textColor, sin_bside, cos_bside))
 			{
-				shape	=	ST_ALWAYS;
+				myCount++;
 			}
+			iii++;
 
-			switch(shape)
+			if (dataIsSorted && (objectptr[iii].decl < cDecmin))
 			{
-				case ST_NAME: if (!cDispOptions.dispNames)	goflag	=	false; break;
-				case ST_DEEP: if (!cDispOptions.dispDeep)	goflag	=	false; break;
-	//?			case ST_STAR: if (magn < cMagmin)			goflag	=	false; break;
+				break;
 			}
 		}
+	}
+	cHitListIdx	=	-1;
 
-		//*	check for displayed magnitude limits
-//		if ((gST_DispOptions.MagnitudeMode != kMagnitudeMode_All) &&
-//			(objectptr[iii].realMagnitude > gST_DispOptions.DisplayedMagnitudeLimit))
-//		{
-//			goflag	=	false;
-//		}
-
+//	CONSOLE_DEBUG_W_NUM("myCount\t\t=",		myCount);
+	return(myCount);
+}
 
-		if (goflag)	//* try to plot it
-		{
-			//*	calculate the screen coordinates
-			alpha	=	cRa0 - objectptr[iii].ra;
-			if (alpha > PI)
+//*****************************************************************************
+//*	draws the objects in the sky index tiles that are in view, brightest first,
+//*	stopping at the magnitude limit.
+//*	Search_and_plot() has already set up the view parameters
+//*****************************************************************************
+long	WindowTabSkyTravel::Search_and_plot_Indexed(TYPE_SkyIndex	*skyIndex,
+													const short		dataSource,
+													const int		textColor,
+													const double	sin_bside,
+													const double	cos_bside)
+{
+TYPE_CelestData		*objectptr;
+TYPE_CelestData		*theObject;
+unsigned int		myCount;
+int					tileIdx;
+int					tileNum;
+long				jjj;
+long				firstObj;
+long				lastObj;
+double				faintestMag;
+
+	myCount		=	0;
+	objectptr	=	skyIndex->objectPtr;
+
+	faintestMag					=	GetFaintestDrawnMagnitude(dataSource);
+	skyIndex->visibleTileCnt	=	SkyIndex_GetTilesInView(cRa0,
+														cRamax,
+														cDecmin,
+														cDecmax,
+														skyIndex->visibleTiles,
+														SkyIndex_GetTileCount());
+	for (tileIdx=0; tileIdx < skyIndex->visibleTileCnt; tileIdx++)
+	{
+		tileNum		=	skyIndex->visibleTiles[tileIdx];
+		firstObj	=	skyIndex->tileStart[tileNum];
+		lastObj		=	skyIndex->tileStart[tileNum + 1];
+		for (jjj=firstObj; jjj<lastObj; jjj++)
+		{
+			theObject	=	&objectptr[skyIndex->objectIdx[jjj]];
+			//*	the tile is sorted by magnitude, nothing after this will get drawn
+			if (theObject->realMagnitude > faintestMag)
 			{
-				alpha	-=	kTWOPI;
+				break;
 			}
-			else if (alpha < -PI)
+			if (Search_and_plot_Object(theObject, dataSource, textColor, sin_bside, cos_bside))
 			{
-				alpha	+=	kTWOPI;
+				myCount++;
 			}
-			if ((cRamax == 0.0) || (fabs(alpha) <= cRamax))		//* in bounds for ra?
-			{
-				cside	=	kHALFPI - objectptr[iii].decl;
-
-				//* here we use inline code for sphsas and sphsss because bside is constant
-				//* so we avoid repeated invocations of sin(bside) and cos(bside)
-
-				aside	=	acos((cos_bside * cos(cside)) + (sin_bside * sin(cside) * cos(alpha)));
-				if (aside < cRadmax)	//* within bounding circle?
-				{
-					if (aside > kEPSILON)
-					{
-						gamma	=	asin(sin(cside) * sin(alpha) / sin(aside));
-					}
-					else
-					{
-						gamma	=	0.0;
-					}
-					if (cos(cside) < (cos_bside * cos(aside)))
-					{
-						gamma	=	PI-gamma;	//* supplement gamma if cos(c)<cos(b)*cos(a)
-					}
-					angle	=	gamma + cGamang;
+		}
+	}
 
-					//*compute x and y coordinates
-					//* x	=	x0 + cXfactor * aside * cos(angle)
-					//* y	=	y0 - cYfactor * aside * sin(angle) (minus sign is because plus y is down)
+	return(myCount);
+}
 
-					xcoord	=	cWind_x0 + (cXfactor * aside * sin(angle));
+//*****************************************************************************
+//*	this is part of the original database processing,
+//*	returns false if this shape is not being displayed
+//*****************************************************************************
+bool	WindowTabSkyTravel::Search_and_plot_GetShape(const int magnCode, int *shape, int *magn)
+{
+bool	goflag;
 
-					//* are they both within window?
+	goflag	=	true;
+	*magn	=	magnCode & 0x00ff;
+	if (*magn < 0x0010)
+	{
+		*shape	=	ST_STAR;
+	}
+	else if (*magn < 0x0073)
+	{
+		*shape	=	ST_DEEP;
+	}
+	else if (*magn < 0x00db)
+	{
+		*shape	=	ST_NAME;
+	}
+	else
+	{
+		*shape	=	ST_ALWAYS;
+	}
 
-					if ((xcoord >= wind_ulx) && (xcoord <= wind_ulx + cWind_width))
-					{
-						objectptr[iii].curXX	=	xcoord;
-						ycoord					=	cWind_y0 - (cYfactor * aside * cos(angle));
-						if ((ycoord >= wind_uly) && (ycoord <= wind_uly + cWind_height))
-						{
-							objectptr[iii].curYY	=	ycoord;
+	switch(*shape)
+	{
+		case ST_NAME: if (!cDispOptions.dispNames)	goflag	=	false; break;
+		case ST_DEEP: if (!cDispOptions.dispDeep)	goflag	=	false; break;
+//?		case ST_STAR: if (*magn < cMagmin)			goflag	=	false; break;
+	}
+	return(goflag);
+}
 
-							if (dataSource == kDataSrc_Orginal)
-							{
-								DrawObjectByShape(xcoord, ycoord, shape, magn);
+//*****************************************************************************
+//*	calculate the screen coordinates
+//*	returns true if the position is within the window
+//*****************************************************************************
+bool	WindowTabSkyTravel::Search_and_plot_GetXY(	const double	ra,
+													const double	decl,
+													const double	sin_bside,
+													const double	cos_bside,
+													int				*xcoord,
+													int				*ycoord)
+{
+bool				isOnScreen;
+double				angle;
+double				alpha,aside,cside,gamma;
 
-//								char		idNameString[64];
-//								sprintf(idNameString, "#%d", objectptr[iii].id);
-//								LLG_DrawCString(xcoord + 3, ycoord + 10, idNameString, 1);
+	isOnScreen	=	false;
+	alpha		=	cRa0 - ra;
+	if (alpha > PI)
+	{
+		alpha	-=	kTWOPI;
+	}
+	else if (alpha < -PI)
+	{
+		alpha	+=	kTWOPI;
+	}
+	if ((cRamax == 0.0) || (fabs(alpha) <= cRamax))		//* in bounds for ra?
+	{
+		cside	=	kHALFPI - decl;
 
-							}
-							else
-							{
-								DrawStarFancy(	xcoord,
-												ycoord,
-												&objectptr[iii],
-												textColor,
-												cViewAngle_LabelDisplay,
-												cViewAngle_InfoDisplay);
-							}
+		//* here we use inline code for sphsas and sphsss because bside is constant
+		//* so we avoid repeated invocations of sin(bside) and cos(bside)
 
-							switch(dataSource)
-							{
-								case kDataSrc_Special:
-									if (cView_angle_Rads < 0.2)
-									{
-										myFontIdx	=	kFont_Large;
-									}
-									else if (cView_angle_Rads < 0.7)
-									{
-										myFontIdx	=	kFont_Medium;
-									}
-									else
-									{
-										myFontIdx	=	1;
-									}
-									switch(cDispOptions.dispSpecialObjects)
-									{
-										case kSpecialDisp_All:
-											LLG_DrawCString(xcoord + 3, ycoord + 10, objectptr[iii].longName, myFontIdx);
-											break;
-									}
-									break;
+		aside	=	acos((cos_bside * cos(cside)) + (sin_bside * sin(cside) * cos(alpha)));
+		if (aside < cRadmax)	//* within bounding circle?
+		{
+			if (aside > kEPSILON)
+			{
+				gamma	=	asin(sin(cside) * sin(alpha) / sin(aside));
+			}
+			else
+			{
+				gamma	=	0.0;
+			}
+			if (cos(cside) < (cos_bside * cos(aside)))
+			{
+				gamma	=	PI-gamma;	//* supplement gamma if cos(c)<cos(b)*cos(a)
+			}
+			angle	=	gamma + cGamang;
 
-								case kDataSrc_PolarAlignCenter:
-									myColor	=	GetColorFromChar(objectptr[iii].longName[0]);
-									LLG_SetColor(myColor);
-									if (cView_angle_Rads < 0.1)
-									{
-										myFontIdx	=	kFont_Large;
-									}
-									else if (cView_angle_Rads < 0.4)
-									{
-										myFontIdx	=	kFont_Medium;
-									}
-									else
-									{
-										myFontIdx	=	1;
-									}
-									switch(cDispOptions.dispSpecialObjects)
-									{
-										case kSpecialDisp_All:
-										case kSpecialDisp_Arcs_w_CentVect:
-											LLG_DrawCString(xcoord + 3, ycoord + 10, objectptr[iii].longName, myFontIdx);
-											break;
-									}
-									break;
+			//*compute x and y coordinates
+			//* x	=	x0 + cXfactor * aside * cos(angle)
+			//* y	=	y0 - cYfactor * aside * sin(angle) (minus sign is because plus y is down)
 
-							}
-							myCount++;
-						}
-					}
-				}
+			*xcoord	=	cWind_x0 + (cXfactor * aside * sin(angle));
+			*ycoord	=	cWind_y0 - (cYfactor * aside * cos(angle));
+
+			//* are they both within window?
+			if ((*xcoord >= wind_ulx) && (*xcoord <= wind_ulx + cWind_width) &&
+				(*ycoord >= wind_uly) && (*ycoord <= wind_uly + cWind_height))
+			{
+				isOnScreen	=	true;
 			}
 		}
-		iii++;
+	}
+	return(isOnScreen);
+}
+
+//*****************************************************************************
+//*	returns true if the object is on the screen
+//*****************************************************************************
+bool	WindowTabSkyTravel::Search_and_plot_Object(	TYPE_CelestData	*theObject,
+													const short		dataSource,
+													const int		textColor,
+													const double	sin_bside,
+													const double	cos_bside)
+{
+bool				goflag;
+bool				isOnScreen;
+int					magn;
+int					shape;
+int					xcoord;
+int					ycoord;
+
+	isOnScreen			=	false;
+	goflag				=	true;
+
+	magn		=	0;
+	shape		=	ST_ALWAYS;
+	if (dataSource == kDataSrc_Orginal)
+	{
+		goflag	=	Search_and_plot_GetShape(theObject->magn, &shape, &magn);
+	}
+
+	//*	check for displayed magnitude limits
+//	if ((gST_DispOptions.MagnitudeMode != kMagnitudeMode_All) &&
+//		(theObject->realMagnitude > gST_DispOptions.DisplayedMagnitudeLimit))
+//	{
+//		goflag	=	false;
+//	}
+
 
-		if (dataIsSorted && (objectptr[iii].decl < cDecmin))
+	if (goflag)	//* try to plot it
+	{
+		if (Search_and_plot_GetXY(theObject->ra, theObject->decl, sin_bside, cos_bside, &xcoord, &ycoord))
 		{
-			break;
+			if (cHitListIdx >= 0)
+			{
+				SkyHitGrid_Add(	&cHitGrid,
+								cHitListIdx,
+								(theObject - cHitGrid.lists[cHitListIdx].objectPtr),
+								xcoord,
+								ycoord);
+			}
+			Search_and_plot_Draw(theObject, dataSource, textColor, xcoord, ycoord, shape, magn);
+			isOnScreen	=	true;
 		}
 	}
+	return(isOnScreen);
+}
+
+//*****************************************************************************
+void	WindowTabSkyTravel::Search_and_plot_Draw(	TYPE_CelestData	*theObject,
+													const short		dataSource,
+													const int		textColor,
+													const int		xcoord,
+													const int		ycoord,
+													const int		shape,
+													const int		magn)
+{
+int					myFontIdx;
+int					myColor;
 
-	//*	make sure any remaining stars are set back to not on screen
-	while (iii < maxObjects)
+	if (dataSource == kDataSrc_Orginal)
 	{
-		objectptr[iii].curXX	=	-100;
-		objectptr[iii].curYY	=	-100;
-		iii++;
+		DrawObjectByShape(xcoord, ycoord, shape, magn);
+
+//		char		idNameString[64];
+//		sprintf(idNameString, "#%d", theObject->id);
+//		LLG_DrawCString(xcoord + 3, ycoord + 10, idNameString, 1);
+
+	}
+	else
+	{
+		DrawStarFancy(	xcoord,
+						ycoord,
+						theObject,
+						textColor,
+						cViewAngle_LabelDisplay,
+						cViewAngle_InfoDisplay);
 	}
 
-//	CONSOLE_DEBUG_W_NUM("myCount\t\t=",		myCount);
-	return(myCount);
+	switch(dataSource)
+	{
+		case kDataSrc_Special:
+			if (cView_angle_Rads < 0.2)
+			{
+				myFontIdx	=	kFont_Large;
+			}
+			else if (cView_angle_Rads < 0.7)
+			{
+				myFontIdx	=	kFont_Medium;
+			}
+			else
+			{
+				myFontIdx	=	1;
+			}
+			switch(cDispOptions.dispSpecialObjects)
+			{
+				case kSpecialDisp_All:
+					LLG_DrawCString(xcoord + 3, ycoord + 10, theObject->longName, myFontIdx);
+					break;
+			}
+			break;
+
+		case kDataSrc_PolarAlignCenter:
+			myColor	=	GetColorFromChar(theObject->longName[0]);
+			LLG_SetColor(myColor);
+			if (cView_angle_Rads < 0.1)
+			{
+				myFontIdx	=	kFont_Large;
+			}
+			else if (cView_angle_Rads < 0.4)
+			{
+				myFontIdx	=	kFont_Medium;
+			}
+			else
+			{
+				myFontIdx	=	1;
+			}
+			switch(cDispOptions.dispSpecialObjects)
+			{
+				case kSpecialDisp_All:
+				case kSpecialDisp_Arcs_w_CentVect:
+					LLG_DrawCString(xcoord + 3, ycoord + 10, theObject->longName, myFontIdx);
+					break;
+			}
+			break;
+
+	}
 }
 //magn
 
@@ -5759,6 +6190,40 @@ void	WindowTabSkyTravel::DrawWindowOverlays(void)
 		}
 	}
 
+	if (cDispOptions.dispGrid)
+	{
+		DrawGrid(cCurrentSkyColor);
+	}
+
+	//*	draw the equator AFTER the grid
+	if (cDispOptions.dispEquator_line)	//* equator line
+	{
+		if (fabs(cDecl0) < cView_angle_Rads)
+		{
+			LLG_SetColor(W_MAGENTA);
+			DrawGreatCircle(0.0, gST_DispOptions.DashedLines, kEnableGreatCircleNumbers, false);
+		}
+	}
+	if (cDispOptions.dispEarth && ((cElev0 - (-kHALFPI)) < cRadmax))
+	{
+		//*	we are looking down at our feet, draw them
+		DrawFeet();		//* -90 degrees
+	}
+
+	DrawCompass();
+
+//	DrawDisplayInfo();
+
+}
+
+//*********************************************************************
+//*	the things that move all the time, drawn on top of the sky every update
+//*********************************************************************
+void	WindowTabSkyTravel::DrawDynamicOverlays(void)
+{
+	//*	not sure what state the color is in, clear it
+	currentForeColor	=	-1;
+
 	//*	are we supposed to draw the telescope F.O.V. information
 	if (cDispOptions.dispTelescope)
 	{
@@ -5828,31 +6293,6 @@ void	WindowTabSkyTravel::DrawWindowOverlays(void)
 	{
 		DrawDomeSlit();
 	}
-
-	if (cDispOptions.dispGrid)
-	{
-		DrawGrid(cCurrentSkyColor);
-	}
-
-	//*	draw the equator AFTER the grid
-	if (cDispOptions.dispEquator_line)	//* equator line
-	{
-		if (fabs(cDecl0) < cView_angle_Rads)
-		{
-			LLG_SetColor(W_MAGENTA);
-			DrawGreatCircle(0.0, gST_DispOptions.DashedLines, kEnableGreatCircleNumbers, false);
-		}
-	}
-	if (cDispOptions.dispEarth && ((cElev0 - (-kHALFPI)) < cRadmax))
-	{
-		//*	we are looking down at our feet, draw them
-		DrawFeet();		//* -90 degrees
-	}
-
-	DrawCompass();
-
-//	DrawDisplayInfo();
-
 }
 
 //*****************************************************************************
@@ -7879,11 +8319,15 @@ int				myColor;
 		default:			myColor	=	W_WHITE;		break;
 	}
 
+	cHitListIdx	=	-1;
+	if (IsCursorSearchList(objectptr, objCnt))
+	{
+		cHitListIdx	=	SkyHitGrid_AddList(&cHitGrid, objectptr, objCnt);
+	}
+
 	for (iii=objCnt-1; iii>=0; iii--)
 	{
 		LLG_SetColor(myColor);
-		objectptr[iii].curXX	=	-100;
-		objectptr[iii].curYY	=	-100;
 
 		//*	do all of the spherical trip stuff
 		sphptr.alpha	=	cRa0 - objectptr[iii].ra;
@@ -7915,12 +8359,10 @@ int				myColor;
 				//* are they both within window?
 				if ((xcoord >= wind_ulx) && (xcoord <= wind_ulx + cWind_width))
 				{
-					objectptr[iii].curXX	=	xcoord;
-
 					ycoord	=	cWind_y0 - (cYfactor * sphptr.aside * cos(angle));
 					if ((ycoord >= wind_uly) && (ycoord <= wind_uly + cWind_height))
 					{
-						objectptr[iii].curYY	=	ycoord;
+						SkyHitGrid_Add(&cHitGrid, cHitListIdx, iii, xcoord, ycoord);
 
 						if ((objCnt == kPlanetObjectCnt) && (iii > 1) && !cDispOptions.dispSymbols && !cDispOptions.dispNames)
 						{
@@ -8029,6 +8471,7 @@ int				myColor;
 		}
 //	next1:;
 	}
+	cHitListIdx	=	-1;
 }
 
 
@@ -8153,205 +8596,93 @@ int		informStrLen;
 
 
 //*********************************************************************
-static long		FindXX_YYinObjectList(	TYPE_CelestData	*objectDataBase,
-										long			objectCount,
-										short			findXX,
-										short			findYY,
-										TYPE_CelestData	*closestObject)
-{
-long	ii;
-long	curFoundIndex;
-long	curFoundDistSQRD;
-long	distanceSQRD;	//*	no reason to take sqrt, just compare squares
-long	distanceInPixels;
-long	deltaXX;
-long	deltaYY;
-
-//	CONSOLE_DEBUG(__FUNCTION__);
-	curFoundDistSQRD	=	999999;
-	curFoundIndex		=	-1;
+//*	returns true if the list is one that FindObjectNearCursor() looks at.
+//*	Also used to make sure a list in the hit grid is still valid
+//*********************************************************************
+bool	WindowTabSkyTravel::IsCursorSearchList(TYPE_CelestData *objectPtr, const long objectCount)
+{
+bool	isSearchList;
 
-	//*	go thru the list and find the closest object
-	if (objectDataBase != NULL)
+	isSearchList	=	false;
+	if ((objectPtr != NULL) && (objectCount > 0))
 	{
-
-		for (ii=0; ii<objectCount; ii++)
+		if (objectPtr == cPlanets)
 		{
-			if ((objectDataBase[ii].curXX >= 0) && (objectDataBase[ii].curYY >= 0))
-			{
-				deltaXX			=	abs(findXX - objectDataBase[ii].curXX);
-				deltaYY			=	abs(findYY - objectDataBase[ii].curYY);
-				distanceSQRD	=	(deltaXX * deltaXX) + (deltaYY * deltaYY);
-				if (distanceSQRD < curFoundDistSQRD)
-				{
-					curFoundIndex		=	ii;
-					curFoundDistSQRD	=	distanceSQRD;
-				}
-			}
+			isSearchList	=	(objectCount == kPlanetObjectCnt);
 		}
-		if (curFoundIndex >= 0)
+		else if (objectPtr == gZodiacPtr)
 		{
-			*closestObject	=	objectDataBase[curFoundIndex];
+			isSearchList	=	(objectCount == kZodiacCount);
+		}
+		else if (objectPtr == gMessierObjectPtr)
+		{
+			isSearchList	=	cDispOptions.dispMessier && (objectCount == gMessierObjectCount);
+		}
+		else if (objectPtr == gStarDataPtr)
+		{
+			isSearchList	=	cDispOptions.dispDefaultData && (objectCount == gStarCount);
+		}
+		else if (objectPtr == gNGCobjectPtr)
+		{
+			isSearchList	=	cDispOptions.dispNGC && (objectCount == gNGCobjectCount);
+		}
+		else if (objectPtr == gYaleStarDataPtr)
+		{
+			isSearchList	=	cDispOptions.dispYale && (objectCount == gYaleStarCount);
+		}
+		else if (objectPtr == gHipObjectPtr)
+		{
+			isSearchList	=	cDispOptions.dispHipparcos && (objectCount == gHipObjectCount);
+		}
+		else if (objectPtr == gAAVSOalertsPtr)
+		{
+			isSearchList	=	cDispOptions.dispAAVSOalerts && (objectCount == gAAVSOalertsCnt);
 		}
 	}
-	distanceInPixels	=	sqrt(curFoundDistSQRD);
-	return(distanceInPixels);
+	return(isSearchList);
 }
 
-//aavso
+//*********************************************************************
+//*	the hit grid has everything that was plotted on the last redraw
 //*********************************************************************
 void	WindowTabSkyTravel::FindObjectNearCursor(TYPE_CelestData *returnObject)
 {
-TYPE_CelestData	foundObject;
 TYPE_CelestData	closestObject;
 long			closestDistance;
-long			pixDist;
-char			closestObjSrc[32];
+long			distanceSQRD;
+int				entryIdx;
+int				listIdx;
+long			objectIdx;
+bool			listOK[kSkyHitMaxLists];
 
 //	CONSOLE_DEBUG(__FUNCTION__);
-//	CONSOLE_ABORT(__FUNCTION__);
 //	CONSOLE_DEBUG_W_LHEX("this        \t=", this);
 //	CONSOLE_DEBUG_W_LHEX("returnObject\t=", returnObject);
 
-	memset(&foundObject,	0,	sizeof(TYPE_CelestData));
 	memset(&closestObject,	0,	sizeof(TYPE_CelestData));
 
 	closestDistance	=	9999;
 
-	//--------------------------------------------------------------------------
-	//*	kDataSrc_Messier
-	if (cDispOptions.dispMessier && (gMessierObjectPtr != NULL) && (gMessierObjectCount > 0))
-	{
-//		CONSOLE_DEBUG("gMessierObjectPtr");
-		pixDist	=	FindXX_YYinObjectList(	gMessierObjectPtr,
-											gMessierObjectCount,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
-		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "Messier");
-		}
-	}
-
-	//--------------------------------------------------------------------------
-	if (cDispOptions.dispDefaultData && (gStarDataPtr != NULL) && (gStarCount > 0))
-	{
-//		CONSOLE_DEBUG("gStarDataPtr");
-		pixDist	=	FindXX_YYinObjectList(	gStarDataPtr,
-											gStarCount,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		//*	since this is the first one, it will always be true
-		if (pixDist < closestDistance)
-		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "Default");
-		}
-	}
-	pixDist	=	FindXX_YYinObjectList(	cPlanets,
-										kPlanetObjectCnt,
-										cCsrx,				//*	current x location of cursor,
-										cCsry,				//*	current y location of cursor,
-										&foundObject);		//*	closestObject
-	if (pixDist < closestDistance)
-	{
-		closestDistance	=	pixDist;
-		closestObject	=	foundObject;
-		strcpy(closestObjSrc, "Planets");
-	}
-
-	//--------------------------------------------------------------------------
-	if (cDispOptions.dispNGC && (gNGCobjectPtr != NULL) && (gNGCobjectCount > 0))
-	{
-//		CONSOLE_DEBUG("gNGCobjectPtr");
-		pixDist	=	FindXX_YYinObjectList(	gNGCobjectPtr,
-											gNGCobjectCount,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
-		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "NGC");
-
-		}
-	}
-
-	//--------------------------------------------------------------------------
-	if (gZodiacPtr != NULL)
-	{
-//		CONSOLE_DEBUG("gZodiacPtr");
-		pixDist	=	FindXX_YYinObjectList(	gZodiacPtr,
-											kZodiacCount,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
-		{
-//			CONSOLE_DEBUG("Zodiac");
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "Zodiac");
-		}
-	}
-
-	//--------------------------------------------------------------------------
-	//*	kDataSrc_YaleBrightStar
-	if (cDispOptions.dispYale && (gYaleStarDataPtr != NULL) && (gYaleStarCount > 0))
+	//*	the catalogs may have been turned off or reloaded since the last redraw
+	for (listIdx=0; listIdx < cHitGrid.listCnt; listIdx++)
 	{
-//		CONSOLE_DEBUG("gYaleStarDataPtr");
-		pixDist	=	FindXX_YYinObjectList(	gYaleStarDataPtr,
-											gYaleStarCount,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
-		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "Yale");
-		}
+		listOK[listIdx]	=	IsCursorSearchList(	cHitGrid.lists[listIdx].objectPtr,
+												cHitGrid.lists[listIdx].objectCount);
 	}
-
-
-	//--------------------------------------------------------------------------
-	//*	kDataSrc_Hipparcos
-	if (cDispOptions.dispHipparcos && (gHipObjectPtr != NULL) && (gHipObjectCount > 0))
-	{
-//		CONSOLE_DEBUG("gHipObjectPtr");
-		pixDist	=	FindXX_YYinObjectList(	gHipObjectPtr,
-											gHipObjectCount,
+	entryIdx	=	SkyHitGrid_FindNearest(	&cHitGrid,
 											cCsrx,				//*	current x location of cursor,
 											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
-		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "Hipparcos");
-		}
-	}
-
-	//--------------------------------------------------------------------------
-	//*	kDataSrc_AAVSOalert
-	if (cDispOptions.dispAAVSOalerts && (gAAVSOalertsPtr != NULL) && (gAAVSOalertsCnt > 0))
+											kMinInformDist,
+											listOK,
+											&distanceSQRD);
+	if (entryIdx >= 0)
 	{
-		pixDist	=	FindXX_YYinObjectList(	gAAVSOalertsPtr,
-											gAAVSOalertsCnt,
-											cCsrx,				//*	current x location of cursor,
-											cCsry,				//*	current y location of cursor,
-											&foundObject);		//*	closestObject
-		if (pixDist < closestDistance)
+		listIdx		=	cHitGrid.entries[entryIdx].listIdx;
+		objectIdx	=	cHitGrid.entries[entryIdx].objectIdx;
+		if ((objectIdx >= 0) && (objectIdx < cHitGrid.lists[listIdx].objectCount))
 		{
-			closestDistance	=	pixDist;
-			closestObject	=	foundObject;
-			strcpy(closestObjSrc, "AAVSO");
+			closestObject	=	cHitGrid.lists[listIdx].objectPtr[objectIdx];
+			closestDistance	=	sqrt(distanceSQRD);
 		}
 	}
 
@@ -8765,6 +9096,14 @@ char	*stringPtr;
 			if (stringPtr != NULL)
 			{
 				CONSOLE_DEBUG_W_STR("Found", gAsteroidPtr[iii].AsteroidName);
+			#ifdef _ENABLE_ASTEROIDS_
+				//*	it may not have been drawn, bring it up to the current time
+				AsteroidEphemeris_UpdateOne(	&gAsteroidPtr[iii],
+												gCurrentSkyTime.fJulianDay,
+												cPlanets[SUN].ra,			//*	radians
+												cPlanets[SUN].decl,			//*	radians
+												cPlanetStruct[SUN].dist);	//*	AU
+			#endif // _ENABLE_ASTEROIDS_
 				cFound_newRA	=	gAsteroidPtr[iii].StarData.ra;
 				cFound_newDec	=	gAsteroidPtr[iii].StarData.decl;
 				cFoundMagnitude	=	gAsteroidPtr[iii].AbsoluteMagnitude;
@@ -9676,21 +10015,45 @@ bool	pt1Valid;
 //********************************************************************
 int	WindowTabSkyTravel::DrawAsteroids(void)
 {
-int		numDrawn;
-int		iii;
-short	pt_XX, pt_YY;
-bool	ptInView;
-int		theAsteroidColor;
+int					numDrawn;
+int					iii;
+short				pt_XX, pt_YY;
+bool				ptInView;
+int					theAsteroidColor;
+TYPE_AsteroidCull	cullParams;
+double				xangle;
+double				yangle;
+long				*inViewList;
+long				inViewCnt;
+long				listIdx;
 
 //	SETUP_TIMING();
 
 	numDrawn	=	0;
 
 	theAsteroidColor	=	W_GREEN;
+#ifdef _ENABLE_ASTEROIDS_
 	if (gAsteroidPtr != NULL)
 	{
-		for (iii=0; iii<gAsteroidCnt; iii++)
-		{
+		//*	only the asteroids that can be seen get their position computed
+		xangle						=	cView_angle_Rads / 2.0;
+		yangle						=	(xangle * cWind_height) / cWind_width;
+		cullParams.viewRA			=	cRa0;
+		cullParams.viewDecl			=	cDecl0;
+		cullParams.viewRadius		=	1.05 * sqrt((xangle * xangle) + (yangle * yangle));
+		cullParams.magnitudeLimit	=	GetFaintestDrawnMagnitude(kDataSrc_Asteroids);
+
+		AsteroidEphemeris_Update(	gAsteroidPtr,
+									gAsteroidCnt,
+									gCurrentSkyTime.fJulianDay,
+									cPlanets[SUN].ra,			//*	radians
+									cPlanets[SUN].decl,			//*	radians
+									cPlanetStruct[SUN].dist,	//*	AU
+									&cullParams);
+		inViewList	=	AsteroidEphemeris_GetInViewList(&inViewCnt);
+		for (listIdx=0; listIdx<inViewCnt; listIdx++)
+		{
+			iii				=	inViewList[listIdx];
 			ptInView		=	GetXYfromRA_Decl(	gAsteroidPtr[iii].StarData.ra,
 													gAsteroidPtr[iii].StarData.decl,
 													&pt_XX,
@@ -9707,6 +10070,7 @@ int		theAsteroidColor;
 			}
 		}
 	}
+#endif // _ENABLE_ASTEROIDS_
 //	DEBUG_TIMING("Time to draw asteroids");
 	return(numDrawn);
 }
@@ -2,6 +2,9 @@
 //*	Edit History
 //*****************************************************************************
 //*	Mar 20,	2023	<MLS> Moved cCurrentSkyTime to skytravel_main.cpp and renamed it gCurrentSkyTime
+//*	Oct 18,	2026	<AGT> Added sky index support, Search_and_plot_Indexed()
+//*	Oct 18,	2026	<AGT> Search_and_plot_Indexed() now uses the catalog hot columns
+//*	Oct 18,	2026	<AGT> Removed CelestCatalog.h
 //*****************************************************************************
 //#include	"windowtab_skytravel.h"
 
@@ -31,6 +34,16 @@
 
 #include	"SkyDisplayStruct.h"
 
+#ifndef _SKY_INDEX_H_
+	#include	"SkyIndex.h"
+#endif
+
+#ifndef _SKY_HIT_GRID_H_
+	#include	"SkyHitGrid.h"
+#endif
+
+#define	kNoMagnitudeLimit	99.0
+
 #define	_ENABLE_HYG_
 
 
@@ -116,6 +129,30 @@ enum
 	kSkyTravel_last
 };
 
+#define	kSkyLayerMaxDrift_Pixels	0.75	//*	how far the cached sky can be off before it is redrawn
+#define	kSkyLayerStatsInterval_ms	60000
+
+//**************************************************************************************
+//*	everything the cached sky layer depends on.
+//*	The view and time are allowed to drift by less than kSkyLayerMaxDrift_Pixels,
+//*	anything else has to match exactly
+//**************************************************************************************
+typedef struct
+{
+	bool		valid;
+	int			width;
+	int			height;
+	double		viewAngle;
+	double		ra0;
+	double		decl0;
+	double		gamang;
+	double		az0;
+	double		elev0;
+	double		julianDay;
+	uint32_t	optionsSignature;	//*	display options, sky color, drag state
+	uint32_t	dataSignature;		//*	catalogs and Gaia blocks loaded
+} TYPE_SkyLayerKey;
+
 
 //**************************************************************************************
 class WindowTabSkyTravel: public WindowTab
@@ -186,7 +223,16 @@ class WindowTabSkyTravel: public WindowTab
 								long			celestObjCount,
 								bool			sortFlag,
 								bool			forcePrecession);
+				void	UpdateSkyState(void);
 				void	DrawSkyAll(void);
+				void	DrawDynamicOverlays(void);
+				void	GetSkyLayerKey(TYPE_SkyLayerKey *layerKey, const int width, const int height);
+				bool	SkyLayerIsCurrent(TYPE_SkyLayerKey *layerKey);
+				void	InvalidateSkyLayer(void);
+				void	ReportSkyLayerStats(void);
+#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+				void	DrawSkyLayered(cv::Mat *openCV_Image, cv::Rect &skyRect);
+#endif
 
 				void	SetView_Angle(const double newViewAngle_radians);
 
@@ -204,6 +250,33 @@ class WindowTabSkyTravel: public WindowTab
 
 				int		SetStarTextColorAndViewAngle(int dataSource);
 				long	Search_and_plot(TYPE_CelestData	*objectptr, long maxObjects, bool dataIsSorted=true);
+				long	Search_and_plot_Indexed(TYPE_SkyIndex	*skyIndex,
+												const short		dataSource,
+												const int		textColor,
+												const double	sin_bside,
+												const double	cos_bside);
+				bool	Search_and_plot_Object(	TYPE_CelestData	*theObject,
+												const short		dataSource,
+												const int		textColor,
+												const double	sin_bside,
+												const double	cos_bside);
+				bool	Search_and_plot_GetShape(const int magnCode, int *shape, int *magn);
+				bool	Search_and_plot_GetXY(	const double	ra,
+												const double	decl,
+												const double	sin_bside,
+												const double	cos_bside,
+												int				*xcoord,
+												int				*ycoord);
+				void	Search_and_plot_Draw(	TYPE_CelestData	*theObject,
+												const short		dataSource,
+												const int		textColor,
+												const int		xcoord,
+												const int		ycoord,
+												const int		shape,
+												const int		magn);
+				double	GetFaintestDrawnMagnitude(const short dataSource);
+				void	BuildSkyIndexes(void);
+				void	BuildSkyIndex(TYPE_CelestData *objectPtr, const long objectCount);
 				void	DrawObjectByShape(int xcoord, int ycoord, int shape, int magn);
 
 				void	AdjustFaintLimit(const double adjustmentAmount);
@@ -290,6 +363,7 @@ class WindowTabSkyTravel: public WindowTab
 				void	Compute_cursor(	TYPE_SkyTime	*timeptr, TYPE_LatLon	*locptr);
 				void	DrawCursorLocationInfo(void);
 				void	FindObjectNearCursor(TYPE_CelestData *returnObject=NULL);
+				bool	IsCursorSearchList(TYPE_CelestData *objectPtr, const long objectCount);
 				bool	GetXYfromRA_Decl(double argRA_radians, double argDecl_radians, short *xx, short *yy);
 				bool	GetXYfromAz_Elev(double azimuth_radians, double elev_radians, short *xx, short *yy);
 				void	ConvertAzEl_to_RaDec(const double azimuth_deg, const double elevation_deg, double *output_RA_deg, double *output_DEC_deg);
@@ -406,6 +480,10 @@ class WindowTabSkyTravel: public WindowTab
 			int					cSavedMouseClick_Y;
 			bool				cMouseDragInProgress;
 
+			//*	the objects that were plotted on the last redraw, for FindObjectNearCursor()
+			TYPE_SkyHitGrid		cHitGrid;
+			int					cHitListIdx;		//*	list being plotted, -1 if not searchable
+
 			long				cInform_dist;
 			long				cInform_id;
 			char				cInform_name[256];
@@ -434,6 +512,17 @@ class WindowTabSkyTravel: public WindowTab
 			short				cCurrentSkyColor;
 			RGBcolor			cSkyRGBvalue;
 
+			//*	the sky without the telescope and dome, redrawn only when something changes
+		#if defined(_USE_OPENCV_CPP_) || (CV_MAJOR_VERSION >= 4)
+			cv::Mat				cSkyLayerImage;
+		#endif
+			TYPE_SkyLayerKey	cSkyLayerKey;
+			uint32_t			cSkyLayerFrames;
+			uint32_t			cSkyLayerHits;
+			double				cSkyLayerRebuild_ms;	//*	totals since the last report
+			double				cSkyLayerCached_ms;
+			uint32_t			cSkyLayerLastReport_ms;
+
 
 
 			short				currentForeColor;